@@ -0,0 +1,143 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file DecompressStreamBuf.cpp
+ * Base class for stream buffers that decompress another stream buffer.
+ */
+
+#include "DecompressStreamBuf.hpp"
+#include "FFStreamError.hpp"
+
+namespace gnsstk
+{
+   DecompressStreamBuf ::
+   DecompressStreamBuf(std::streambuf* src)
+         : source(src), outStart(0), atEnd(false)
+   {
+   }
+
+
+   DecompressStreamBuf ::
+   ~DecompressStreamBuf()
+   {
+   }
+
+
+   std::string DecompressStreamBuf ::
+   peek(std::size_t n)
+   {
+      if ((gptr() == egptr()) && (underflow() == traits_type::eof()))
+      {
+         if (!error.empty())
+         {
+            FFStreamError exc(error);
+            GNSSTK_THROW(exc);
+         }
+         return std::string();
+      }
+      std::size_t avail = egptr() - gptr();
+      return std::string(gptr(), n < avail ? n : avail);
+   }
+
+
+   DecompressStreamBuf::int_type DecompressStreamBuf ::
+   underflow()
+   {
+      if (gptr() < egptr())
+         return traits_type::to_int_type(*gptr());
+      if (atEnd || !error.empty())
+         return traits_type::eof();
+      outStart += outBuf.size();
+      try
+      {
+         fill(outBuf);
+      }
+      catch (Exception& exc)
+      {
+         error = exc.getText();
+         outBuf.clear();
+         setg(nullptr, nullptr, nullptr);
+         throw;
+      }
+      if (outBuf.empty())
+      {
+         atEnd = true;
+         setg(nullptr, nullptr, nullptr);
+         return traits_type::eof();
+      }
+      char *buf = &outBuf[0];
+      setg(buf, buf, buf + outBuf.size());
+      return traits_type::to_int_type(*gptr());
+   }
+
+
+   DecompressStreamBuf::pos_type DecompressStreamBuf ::
+   seekoff(off_type off, std::ios_base::seekdir dir,
+           std::ios_base::openmode which)
+   {
+      if (dir == std::ios_base::cur)
+      {
+         return seekpos(outStart + (gptr() - eback()) + off, which);
+      }
+      if (dir == std::ios_base::beg)
+      {
+         return seekpos(off, which);
+      }
+      return pos_type(off_type(-1));
+   }
+
+
+   DecompressStreamBuf::pos_type DecompressStreamBuf ::
+   seekpos(pos_type pos, std::ios_base::openmode which)
+   {
+      std::streamoff off = pos;
+      if (!(which & std::ios_base::in) || (off < outStart) ||
+          (off > outStart + (std::streamoff)outBuf.size()))
+      {
+         return pos_type(off_type(-1));
+      }
+      if (!outBuf.empty())
+      {
+         char *buf = &outBuf[0];
+         setg(buf, buf + (off - outStart), buf + outBuf.size());
+      }
+      return pos;
+   }
+
+}  // End of namespace gnsstk
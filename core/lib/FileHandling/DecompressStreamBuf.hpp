@@ -0,0 +1,126 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file DecompressStreamBuf.hpp
+ * Base class for stream buffers that decompress another stream buffer.
+ */
+
+#ifndef GNSSTK_DECOMPRESSSTREAMBUF_HPP
+#define GNSSTK_DECOMPRESSSTREAMBUF_HPP
+
+#include <streambuf>
+#include <string>
+
+namespace gnsstk
+{
+      /// @ingroup FileHandling
+      //@{
+
+      /**
+       * A read-only std::streambuf that produces the decompressed
+       * contents of another stream buffer (the source) a block at a
+       * time.  Derived classes implement fill() for a particular
+       * compression format.
+       *
+       * The buffer is not seekable except within the most recently
+       * decompressed block, which is enough for FFStream to report
+       * and recover from errors in the record just read.  Errors in
+       * the compressed data are thrown from underflow(), which
+       * causes std::istream to set badbit; the text of the error is
+       * kept and can be retrieved with getError().
+       */
+   class DecompressStreamBuf : public std::streambuf
+   {
+   public:
+         /** Set up to decompress the contents of src.
+          * @param[in] src The compressed data, which must remain
+          *   valid for the life of this object. */
+      DecompressStreamBuf(std::streambuf* src);
+
+         /// Nothing to do here.
+      virtual ~DecompressStreamBuf();
+
+         /** Return up to n bytes of decompressed data without
+          * consuming them.  Fewer bytes are returned if the data
+          * end or the current block is shorter than n.
+          * @throw FFStreamError if the compressed data are bad. */
+      std::string peek(std::size_t n);
+
+         /// Return the text of the first decompression error, if any.
+      const std::string& getError() const
+      { return error; }
+
+   protected:
+         /** Decompress the next block of data.
+          * @param[out] out Cleared and then filled with at least one
+          *   byte of decompressed data, or left empty at the end of
+          *   the data.
+          * @throw FFStreamError if the compressed data are bad. */
+      virtual void fill(std::string& out) = 0;
+
+         /// Get the next block of decompressed data.
+      int_type underflow() override;
+
+         /// Support tellg() and seeks within the current block.
+      pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                       std::ios_base::openmode which) override;
+
+         /// Support seeks within the current block.
+      pos_type seekpos(pos_type pos, std::ios_base::openmode which)
+         override;
+
+         /// Where the compressed data come from.
+      std::streambuf *source;
+
+   private:
+         /// The current block of decompressed data.
+      std::string outBuf;
+         /// Offset in the decompressed data of the start of outBuf.
+      std::streamoff outStart;
+         /// Set once fill() has returned no data.
+      bool atEnd;
+         /// Text of the first exception thrown by fill().
+      std::string error;
+   }; // End of class 'DecompressStreamBuf'
+
+      //@}
+
+}  // End of namespace gnsstk
+
+#endif   // GNSSTK_DECOMPRESSSTREAMBUF_HPP
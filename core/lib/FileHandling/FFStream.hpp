@@ -108,6 +108,15 @@ namespace gnsstk
        * RinexObsData::reallyGetRecord()
        * for an example of this.
        *
+       * Any state carried from one record to the next belongs in
+       * the stream, not in static data, so that separate streams can
+       * be read concurrently from different threads.  The RINEX 2
+       * and 3 observation, navigation and meteorological readers
+       * follow this rule.  A single stream must still only be used
+       * by one thread at a time, and process-wide settings such as
+       * RegisterExtendedRinexObsType() must be made before any
+       * threads start reading.
+       *
        * \sa FFData for more information
        * \sa RinexObsData::reallyGetRecord() and
        *     RinexObsHeader::reallyGetRecord() for more information for files
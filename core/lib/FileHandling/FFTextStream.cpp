@@ -42,6 +42,9 @@
  */
 
 #include "FFTextStream.hpp"
+#include "GzipStreamBuf.hpp"
+#include "LZWStreamBuf.hpp"
+#include "HatanakaStreamBuf.hpp"
 
 namespace gnsstk
 {
@@ -55,6 +58,7 @@ namespace gnsstk
    FFTextStream ::
    ~FFTextStream()
    {
+      closeDecompress();
    }
 
 
@@ -64,6 +68,7 @@ namespace gnsstk
          : FFStream(fn, mode)
    {
       init();
+      openDecompress(mode);
    }
 
 
@@ -73,6 +78,7 @@ namespace gnsstk
          : FFStream( fn.c_str(), mode )
    {
       init();
+      openDecompress(mode);
    }
 
 
@@ -80,8 +86,10 @@ namespace gnsstk
    open( const char* fn,
          std::ios::openmode mode )
    {
+      closeDecompress();
       FFStream::open(fn, mode);
       init();
+      openDecompress(mode);
    }
 
 
@@ -93,6 +101,14 @@ namespace gnsstk
    }
 
 
+   void FFTextStream ::
+   close()
+   {
+      closeDecompress();
+      FFStream::close();
+   }
+
+
    void FFTextStream ::
    init()
    {
@@ -100,6 +116,63 @@ namespace gnsstk
    }
 
 
+   void FFTextStream ::
+   openDecompress(std::ios::openmode mode)
+   {
+      if (!is_open() || !(mode & std::ios::in) || (mode & std::ios::out))
+         return;
+         // Look at the start of the file, then put it back.
+      std::filebuf *fb = std::fstream::rdbuf();
+      std::string head(80, ' ');
+      head.resize(fb->sgetn(&head[0], head.size()));
+      fb->pubseekpos(0, std::ios::in);
+      try
+      {
+         if (GzipStreamBuf::isGzip(head) || LZWStreamBuf::isLZW(head))
+         {
+               // Make sure the compressed data aren't altered by
+               // text mode line ending translation.
+            std::fstream::close();
+            std::fstream::open(filename.c_str(), mode | std::ios::binary);
+            fb = std::fstream::rdbuf();
+            if (GzipStreamBuf::isGzip(head))
+               decompress.emplace_back(new GzipStreamBuf(fb));
+            else
+               decompress.emplace_back(new LZWStreamBuf(fb));
+            head = decompress.back()->peek(head.size());
+         }
+         if (HatanakaStreamBuf::isCRX(head))
+         {
+            std::streambuf *src = fb;
+            if (!decompress.empty())
+               src = decompress.back().get();
+            decompress.emplace_back(new HatanakaStreamBuf(src));
+         }
+      }
+      catch (Exception& e)
+      {
+         mostRecentException = FFStreamError(e);
+         mostRecentException.addText("In file " + filename);
+         setstate(std::ios::failbit);
+         closeDecompress();
+         return;
+      }
+      if (!decompress.empty())
+         std::ios::rdbuf(decompress.back().get());
+   }
+
+
+   void FFTextStream ::
+   closeDecompress()
+   {
+      if (decompress.empty())
+         return;
+         // Reading goes straight to the file again.
+      std::ios::rdbuf(std::fstream::rdbuf());
+      decompress.clear();
+   }
+
+
    void FFTextStream ::
    tryFFStreamGet(FFData& rec)
    {
@@ -152,6 +225,14 @@ namespace gnsstk
       try
       {
          std::getline(*this, line);
+         if (bad() && !decompress.empty())
+         {
+               // Report the error at the line that couldn't be read.
+            lineNumber++;
+            FFStreamError err("Decompression failed: " +
+                              decompress.back()->getError());
+            GNSSTK_THROW(err);
+         }
             // Remove CR characters left over in the buffer from windows files
          size_t crpos = line.find_last_not_of('\r');
          if ((crpos+1) < line.length())
@@ -188,6 +269,14 @@ namespace gnsstk
       }
       catch(std::exception &e)
       {
+         if (bad() && !decompress.empty())
+         {
+               // Report the error at the line that couldn't be read.
+            lineNumber++;
+            FFStreamError err("Decompression failed: " +
+                              decompress.back()->getError());
+            GNSSTK_THROW(err);
+         }
             // catch EOF when exceptions are enabled
          if ( (line.size() == 0) && eof())
          {
@@ -44,7 +44,10 @@
 #ifndef GNSSTK_FFTEXTSTREAM_HPP
 #define GNSSTK_FFTEXTSTREAM_HPP
 
+#include <memory>
+#include <vector>
 #include "FFStream.hpp"
+#include "DecompressStreamBuf.hpp"
 
 namespace gnsstk
 {
@@ -59,6 +62,15 @@ namespace gnsstk
        * update the line number - the derived class or programmer
        * needs to make sure that the reader or writer increments
        * lineNumber in these cases.
+       *
+       * Files opened for input that are compressed with gzip or
+       * Unix compress, or are Hatanaka compact RINEX (in any
+       * combination, e.g. .crx.gz), are decompressed as they are
+       * read, with no temporary files.  The format is detected from
+       * the contents of the file, not its name.  Line numbers then
+       * refer to the decompressed text.  Decompressed streams can't
+       * seek, other than the small amount that FFStream does to
+       * recover from errors in a record.
        */
    class FFTextStream : public FFStream
    {
@@ -93,10 +105,21 @@ namespace gnsstk
       virtual void open( const std::string& fn,
                          std::ios::openmode mode );
 
+         /** Overrides close to remove any decompression layers first.
+          * @warning std::fstream::close() is not virtual, so closing
+          *   through an FFStream or std::fstream pointer or reference
+          *   leaves the decompression layers in place until the
+          *   stream is reopened or destroyed. */
+      void close();
+
          /// The internal line count. When writing, make sure
          /// to increment this.
       unsigned int lineNumber;
 
+         /// Return true if the file is being decompressed as it is read.
+      bool isCompressed() const
+      { return !decompress.empty(); }
+
 
          /**
           * Like std::istream::getline but checks for EOF and removes '/r'.
@@ -137,6 +160,18 @@ namespace gnsstk
          /// Initialize internal data structures
       void init();
 
+         /** If the file just opened for input is compressed, put
+          * the stream buffers that decompress it between the file
+          * and this stream.
+          * @param[in] mode The mode the file was opened with. */
+      void openDecompress(std::ios::openmode mode);
+
+         /// Remove any decompression stream buffers.
+      void closeDecompress();
+
+         /// Decompression layers, the one this stream reads last.
+      std::vector<std::unique_ptr<DecompressStreamBuf> > decompress;
+
    }; // End of class 'FFTextStream'
 
       //@}
@@ -0,0 +1,169 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file GzipStreamBuf.cpp
+ * Stream buffer that decompresses gzip data.
+ */
+
+#include "GzipStreamBuf.hpp"
+#include "FFStreamError.hpp"
+#ifdef GNSSTK_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+   /// Size of the compressed and decompressed blocks.
+static const unsigned gzipBlockSize = 65536;
+
+namespace gnsstk
+{
+#ifdef GNSSTK_HAVE_ZLIB
+   GzipStreamBuf ::
+   GzipStreamBuf(std::streambuf* src)
+         : DecompressStreamBuf(src),
+           zs(new z_stream),
+           inBuf(gzipBlockSize),
+           memberEnd(false)
+   {
+      zs->zalloc = Z_NULL;
+      zs->zfree = Z_NULL;
+      zs->opaque = Z_NULL;
+      zs->next_in = Z_NULL;
+      zs->avail_in = 0;
+         // 16 added to the window bits selects gzip decoding.
+      if (inflateInit2(zs, 16 + MAX_WBITS) != Z_OK)
+      {
+         delete zs;
+         FFStreamError exc("Unable to initialize zlib");
+         GNSSTK_THROW(exc);
+      }
+   }
+
+
+   GzipStreamBuf ::
+   ~GzipStreamBuf()
+   {
+      inflateEnd(zs);
+      delete zs;
+   }
+
+
+   bool GzipStreamBuf ::
+   available()
+   {
+      return true;
+   }
+
+
+   void GzipStreamBuf ::
+   fill(std::string& out)
+   {
+      out.resize(gzipBlockSize);
+      zs->next_out = reinterpret_cast<Bytef*>(&out[0]);
+      zs->avail_out = out.size();
+      while (zs->avail_out == out.size())
+      {
+         if (zs->avail_in == 0)
+         {
+            std::streamsize n = source->sgetn(&inBuf[0], inBuf.size());
+            if (n <= 0)
+            {
+               if (!memberEnd)
+               {
+                  FFStreamError exc("Truncated gzip data");
+                  GNSSTK_THROW(exc);
+               }
+               break;
+            }
+            zs->next_in = reinterpret_cast<Bytef*>(&inBuf[0]);
+            zs->avail_in = n;
+         }
+         if (memberEnd)
+         {
+               // Another gzip member follows the one just finished.
+            inflateReset(zs);
+            memberEnd = false;
+         }
+         int rc = inflate(zs, Z_NO_FLUSH);
+         if (rc == Z_STREAM_END)
+         {
+            memberEnd = true;
+         }
+         else if (rc != Z_OK)
+         {
+            FFStreamError exc(std::string("Invalid gzip data: ") +
+                              (zs->msg ? zs->msg : "zlib error"));
+            GNSSTK_THROW(exc);
+         }
+      }
+      out.resize(out.size() - zs->avail_out);
+   }
+#else
+   GzipStreamBuf ::
+   GzipStreamBuf(std::streambuf* src)
+         : DecompressStreamBuf(src),
+           zs(nullptr),
+           memberEnd(false)
+   {
+      FFStreamError exc("gzip compressed input is not supported because"
+                        " GNSSTk was built without zlib");
+      GNSSTK_THROW(exc);
+   }
+
+
+   GzipStreamBuf ::
+   ~GzipStreamBuf()
+   {
+   }
+
+
+   bool GzipStreamBuf ::
+   available()
+   {
+      return false;
+   }
+
+
+   void GzipStreamBuf ::
+   fill(std::string& out)
+   {
+      out.clear();
+   }
+#endif
+
+}  // End of namespace gnsstk
@@ -0,0 +1,102 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file GzipStreamBuf.hpp
+ * Stream buffer that decompresses gzip data.
+ */
+
+#ifndef GNSSTK_GZIPSTREAMBUF_HPP
+#define GNSSTK_GZIPSTREAMBUF_HPP
+
+#include <vector>
+#include "DecompressStreamBuf.hpp"
+
+   // Defined by zlib.  Declared here to keep zlib.h out of our headers.
+struct z_stream_s;
+
+namespace gnsstk
+{
+      /// @ingroup FileHandling
+      //@{
+
+      /**
+       * Decompress gzip (RFC 1952) data, including files made of
+       * several concatenated gzip members.  This uses zlib, which
+       * is optional; when GNSSTk is built without it, available()
+       * returns false and the constructor throws.
+       */
+   class GzipStreamBuf : public DecompressStreamBuf
+   {
+   public:
+         /** Set up to decompress the contents of src.
+          * @param[in] src The compressed data.
+          * @throw FFStreamError if zlib is not available. */
+      GzipStreamBuf(std::streambuf* src);
+
+         /// Release zlib's state.
+      ~GzipStreamBuf();
+
+         /// Return true if GNSSTk was built with gzip support.
+      static bool available();
+
+         /// Return true if data starts with the gzip magic number.
+      static bool isGzip(const std::string& data)
+      {
+         return ((data.size() >= 2) && (data[0] == '\x1f') &&
+                 (data[1] == '\x8b'));
+      }
+
+   protected:
+         /// Decompress the next block of data.
+      void fill(std::string& out) override;
+
+   private:
+         /// zlib's decompression state.
+      z_stream_s *zs;
+         /// Compressed data read from the source.
+      std::vector<char> inBuf;
+         /// True when zlib has reached the end of a gzip member.
+      bool memberEnd;
+   }; // End of class 'GzipStreamBuf'
+
+      //@}
+
+}  // End of namespace gnsstk
+
+#endif   // GNSSTK_GZIPSTREAMBUF_HPP
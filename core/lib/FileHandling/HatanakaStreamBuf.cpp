@@ -0,0 +1,466 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file HatanakaStreamBuf.cpp
+ * Stream buffer that expands Hatanaka compact RINEX observation data.
+ */
+
+#include <cstdlib>
+#include "HatanakaStreamBuf.hpp"
+#include "FFStreamError.hpp"
+#include "StringUtils.hpp"
+
+   /// Expand at least this much RINEX text in each fill().
+static const std::size_t crxBlockSize = 65536;
+
+namespace gnsstk
+{
+   std::int64_t HatanakaStreamBuf::Arc ::
+   apply(const std::string& field)
+   {
+      const char *str = field.c_str();
+      bool init = (field.size() > 1) && (field[1] == '&');
+      if (init)
+      {
+         if ((field[0] < '0') || (field[0] > '9'))
+         {
+            FFStreamError exc("Invalid compact RINEX arc order: " + field);
+            GNSSTK_THROW(exc);
+         }
+         str += 2;
+      }
+      else if (order < 0)
+      {
+         FFStreamError exc("Compact RINEX difference without an"
+                           " initialized arc: " + field);
+         GNSSTK_THROW(exc);
+      }
+      char *end;
+      std::int64_t value = std::strtoll(str, &end, 10);
+      if ((end == str) || (*end != 0))
+      {
+         FFStreamError exc("Invalid compact RINEX data: " + field);
+         GNSSTK_THROW(exc);
+      }
+      if (init)
+      {
+         order = field[0] - '0';
+         nDiff = 0;
+         u[0] = value;
+      }
+      else
+      {
+         if (nDiff < order)
+         {
+            nDiff++;
+         }
+         u[nDiff] = value;
+         for (int j = nDiff-1; j >= 0; j--)
+         {
+            u[j] += u[j+1];
+         }
+      }
+      return u[0];
+   }
+
+
+   HatanakaStreamBuf ::
+   HatanakaStreamBuf(std::streambuf* src)
+         : DecompressStreamBuf(src),
+           crxVersion(0),
+           headerDone(false)
+   {
+   }
+
+
+   bool HatanakaStreamBuf ::
+   isCRX(const std::string& data)
+   {
+      std::string::size_type eol = data.find('\n');
+      return (data.substr(0, eol).find("CRINEX VERS") != std::string::npos);
+   }
+
+
+   bool HatanakaStreamBuf ::
+   getLine(std::string& line)
+   {
+      line.clear();
+      int_type c = source->sbumpc();
+      if (traits_type::eq_int_type(c, traits_type::eof()))
+      {
+         return false;
+      }
+      while (!traits_type::eq_int_type(c, traits_type::eof()) &&
+             (c != '\n'))
+      {
+         line += traits_type::to_char_type(c);
+         c = source->sbumpc();
+      }
+      if (!line.empty() && (line.back() == '\r'))
+      {
+         line.pop_back();
+      }
+      return true;
+   }
+
+
+   void HatanakaStreamBuf ::
+   needLine(std::string& line)
+   {
+      if (!getLine(line))
+      {
+         FFStreamError exc("Unexpected end of compact RINEX data");
+         GNSSTK_THROW(exc);
+      }
+   }
+
+
+   void HatanakaStreamBuf ::
+   readHeader(std::string& out)
+   {
+      needLine(line);
+      if (!isCRX(line))
+      {
+         FFStreamError exc("Not compact RINEX data");
+         GNSSTK_THROW(exc);
+      }
+      std::string vers = StringUtils::strip(line.substr(0, 20));
+      if (vers == "1.0")
+      {
+         crxVersion = 1;
+      }
+      else if (vers == "3.0")
+      {
+         crxVersion = 3;
+      }
+      else
+      {
+         FFStreamError exc("Unsupported compact RINEX version " + vers);
+         GNSSTK_THROW(exc);
+      }
+         // CRINEX PROG / DATE
+      needLine(line);
+      do
+      {
+         needLine(line);
+         out += line;
+         out += '\n';
+         std::string label = line.size() > 60 ? line.substr(60) : "";
+         StringUtils::stripTrailing(label);
+         if ((crxVersion == 1) && (label == "# / TYPES OF OBSERV") &&
+             (line.substr(0, 6) != "      "))
+         {
+            numObs[' '] = StringUtils::asInt(line.substr(0, 6));
+         }
+         else if ((crxVersion == 3) && (label == "SYS / # / OBS TYPES") &&
+                  (line[0] != ' '))
+         {
+            numObs[line[0]] = StringUtils::asInt(line.substr(3, 3));
+         }
+         if (label == "END OF HEADER")
+         {
+            break;
+         }
+      }
+      while (true);
+      headerDone = true;
+   }
+
+
+   bool HatanakaStreamBuf ::
+   readEpoch(std::string& out)
+   {
+         // Skip any blank lines between epochs.
+      do
+      {
+         if (!getLine(line))
+         {
+            return false;
+         }
+      }
+      while (line.empty());
+         // A line starting with this character is given in full
+         // rather than as differences from the previous one.
+      char initChar = (crxVersion == 1) ? '&' : '>';
+      if (line[0] == initChar)
+      {
+         epochLine.clear();
+      }
+      repair(epochLine, line);
+      std::string::size_type flagCol = (crxVersion == 1) ? 28 : 31;
+      std::string::size_type satCol = (crxVersion == 1) ? 32 : 41;
+      if (epochLine.size() < flagCol+4)
+      {
+         FFStreamError exc("Invalid compact RINEX epoch line: " + epochLine);
+         GNSSTK_THROW(exc);
+      }
+      char flag = epochLine[flagCol];
+      unsigned numSats = StringUtils::asInt(epochLine.substr(flagCol+1, 3));
+      if ((flag >= '2') && (flag <= '5'))
+      {
+            // Special events are followed by header lines, which are
+            // copied as they are.
+         std::string event(epochLine);
+         StringUtils::stripTrailing(event);
+         out += event;
+         out += '\n';
+         for (unsigned i = 0; i < numSats; i++)
+         {
+            needLine(line);
+            out += line;
+            out += '\n';
+         }
+         return true;
+      }
+      if (epochLine.size() < satCol + 3*numSats)
+      {
+         FFStreamError exc("Missing satellites in compact RINEX epoch line: "
+                           + epochLine);
+         GNSSTK_THROW(exc);
+      }
+         // receiver clock offset
+      needLine(line);
+      bool haveClock = !line.empty();
+      std::int64_t clk = 0;
+      if (haveClock)
+      {
+         clk = clock.apply(line);
+      }
+      else
+      {
+         clock.reset();
+      }
+      std::string rec;
+      if (crxVersion == 1)
+      {
+         for (unsigned i = 0; (i == 0) || (i < numSats); i += 12)
+         {
+            rec = (i == 0) ? epochLine.substr(0, 32) : std::string(32, ' ');
+            unsigned n = (numSats - i) < 12 ? numSats - i : 12;
+            rec += epochLine.substr(satCol + 3*i, 3*n);
+            if ((i == 0) && haveClock)
+            {
+               rec.resize(68, ' ');
+               appendFixed(rec, clk, 9, 12);
+            }
+            out += rec;
+            out += '\n';
+         }
+      }
+      else
+      {
+         rec = epochLine.substr(0, 35);
+         if (haveClock)
+         {
+            rec.resize(41, ' ');
+            appendFixed(rec, clk, 12, 15);
+         }
+         out += rec;
+         out += '\n';
+      }
+         // One line of differenced data and flags for each satellite.
+      std::map<std::string,SatState> newSats;
+      std::vector<bool> have;
+      std::vector<std::int64_t> value;
+      for (unsigned s = 0; s < numSats; s++)
+      {
+         std::string id(epochLine.substr(satCol + 3*s, 3));
+         char sys = (crxVersion == 1) ? ' ' : id[0];
+         std::map<char,unsigned>::const_iterator noi = numObs.find(sys);
+         if (noi == numObs.end())
+         {
+            FFStreamError exc("No observation types for satellite " + id);
+            GNSSTK_THROW(exc);
+         }
+         unsigned nObs = noi->second;
+         SatState& state(newSats[id]);
+         std::map<std::string,SatState>::iterator oldi = sats.find(id);
+         if (oldi != sats.end())
+         {
+            state.arcs.swap(oldi->second.arcs);
+            state.flags.swap(oldi->second.flags);
+         }
+         state.arcs.resize(nObs);
+         needLine(line);
+         have.assign(nObs, false);
+         value.assign(nObs, 0);
+         std::string::size_type pos = 0;
+         for (unsigned i = 0; i < nObs; i++)
+         {
+            if (pos >= line.size())
+            {
+               state.arcs[i].reset();
+               pos = line.size() + 1;
+               continue;
+            }
+            std::string::size_type end = line.find(' ', pos);
+            if (end == std::string::npos)
+            {
+               end = line.size();
+            }
+            if (end == pos)
+            {
+               state.arcs[i].reset();
+            }
+            else
+            {
+               value[i] = state.arcs[i].apply(line.substr(pos, end-pos));
+               have[i] = true;
+            }
+            pos = end + 1;
+         }
+         repair(state.flags,
+                pos < line.size() ? line.substr(pos) : std::string());
+         state.flags.resize(2*nObs, ' ');
+            // Write the restored observations, five to a line for
+            // RINEX 2 and all on one line for RINEX 3.
+         rec = (crxVersion == 1) ? "" : id;
+         for (unsigned i = 0; i < nObs; i++)
+         {
+            if (have[i])
+            {
+               appendFixed(rec, value[i], 3, 14);
+               rec += state.flags[2*i];
+               rec += state.flags[2*i+1];
+            }
+            else
+            {
+               rec.append(16, ' ');
+            }
+            if ((crxVersion == 1) && (((i % 5) == 4) || (i+1 == nObs)))
+            {
+               StringUtils::stripTrailing(rec);
+               out += rec;
+               out += '\n';
+               rec.clear();
+            }
+         }
+         if (crxVersion != 1)
+         {
+            StringUtils::stripTrailing(rec);
+            out += rec;
+            out += '\n';
+         }
+      }
+      sats.swap(newSats);
+      return true;
+   }
+
+
+   void HatanakaStreamBuf ::
+   repair(std::string& old, const std::string& diff)
+   {
+      if (old.size() < diff.size())
+      {
+         old.resize(diff.size(), ' ');
+      }
+      for (std::string::size_type i = 0; i < diff.size(); i++)
+      {
+         if (diff[i] == '&')
+         {
+            old[i] = ' ';
+         }
+         else if (diff[i] != ' ')
+         {
+            old[i] = diff[i];
+         }
+      }
+   }
+
+
+   void HatanakaStreamBuf ::
+   appendFixed(std::string& out, std::int64_t value, int decimals,
+               std::size_t width)
+   {
+      std::uint64_t mag = (value < 0) ? -(std::uint64_t)value : value;
+      std::uint64_t scale = 1;
+      for (int i = 0; i < decimals; i++)
+      {
+         scale *= 10;
+      }
+      std::string frac = std::to_string(mag % scale);
+      std::string str = (value < 0) ? "-" : "";
+      str += std::to_string(mag / scale);
+      str += '.';
+      str.append(decimals - frac.size(), '0');
+      str += frac;
+      if (str.size() < width)
+      {
+         out.append(width - str.size(), ' ');
+      }
+      out += str;
+   }
+
+
+   void HatanakaStreamBuf ::
+   fill(std::string& out)
+   {
+      out.clear();
+      if (!pendingError.empty())
+      {
+         FFStreamError exc(pendingError);
+         pendingError.clear();
+         GNSSTK_THROW(exc);
+      }
+      if (!headerDone)
+      {
+         readHeader(out);
+      }
+         // Keep the epochs expanded before an error, so that the
+         // error is reported near the line where it happened.
+      std::string::size_type good = out.size();
+      try
+      {
+         while ((out.size() < crxBlockSize) && readEpoch(out))
+         {
+            good = out.size();
+         }
+      }
+      catch (Exception& exc)
+      {
+         if (good == 0)
+         {
+            GNSSTK_RETHROW(exc);
+         }
+         out.resize(good);
+         pendingError = exc.getText();
+      }
+   }
+
+}  // End of namespace gnsstk
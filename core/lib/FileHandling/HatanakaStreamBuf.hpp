@@ -0,0 +1,157 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file HatanakaStreamBuf.hpp
+ * Stream buffer that expands Hatanaka compact RINEX observation data.
+ */
+
+#ifndef GNSSTK_HATANAKASTREAMBUF_HPP
+#define GNSSTK_HATANAKASTREAMBUF_HPP
+
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "DecompressStreamBuf.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup FileHandling
+      //@{
+
+      /**
+       * Expand Hatanaka compact RINEX (CRINEX 1.0 for RINEX 2, and
+       * CRINEX 3.0 for RINEX 3) observation data to plain RINEX
+       * text, as the crx2rnx utility does.  The source is usually a
+       * file, but may also be one of the other DecompressStreamBuf
+       * classes for .crx.gz or .d.Z files.
+       *
+       * Observations are written in the standard F14.3 fields with
+       * trailing blanks removed, so the output is the same as that
+       * of crx2rnx, and line numbers in error messages refer to the
+       * expanded RINEX file.
+       */
+   class HatanakaStreamBuf : public DecompressStreamBuf
+   {
+   public:
+         /** Set up to expand the contents of src.
+          * @param[in] src The compact RINEX data. */
+      HatanakaStreamBuf(std::streambuf* src);
+
+         /** Return true if data starts with a compact RINEX header
+          * line. */
+      static bool isCRX(const std::string& data);
+
+   protected:
+         /// Expand the next block of epochs.
+      void fill(std::string& out) override;
+
+   private:
+         /// One quantity being differenced from epoch to epoch.
+      class Arc
+      {
+      public:
+         Arc() : order(-1), nDiff(0)
+         {}
+            /** Apply one data field, which is either "n&value" to
+             * start a new arc of order n, or the next n-th order
+             * difference.
+             * @return The restored (undifferenced) value.
+             * @throw FFStreamError on bad data. */
+         std::int64_t apply(const std::string& field);
+            /// Break the arc, e.g. when data are missing.
+         void reset()
+         { order = -1; }
+            /// Order of the differences, -1 if not initialized.
+         int order;
+            /// Number of differences applied so far, up to order.
+         int nDiff;
+            /// The value and its differences.
+         std::int64_t u[10];
+      };
+
+         /// What is remembered about each satellite.
+      class SatState
+      {
+      public:
+            /// One arc for each observation type.
+         std::vector<Arc> arcs;
+            /// LLI and SSI flags from the previous epoch.
+         std::string flags;
+      };
+
+         /** Read a line of compact RINEX.
+          * @return false at the end of the data. */
+      bool getLine(std::string& line);
+         /** Read a line that must be present.
+          * @throw FFStreamError at the end of the data. */
+      void needLine(std::string& line);
+         /// Read the CRINEX header and copy out the RINEX header.
+      void readHeader(std::string& out);
+         /** Expand one epoch.
+          * @return false at the end of the data. */
+      bool readEpoch(std::string& out);
+         /// Apply the text differences in diff to old.
+      static void repair(std::string& old, const std::string& diff);
+         /// Append value/10^decimals, right justified in width.
+      static void appendFixed(std::string& out, std::int64_t value,
+                              int decimals, std::size_t width);
+
+         /// 1 for CRINEX 1.0 (RINEX 2), 3 for CRINEX 3.0.
+      int crxVersion;
+         /// Set once the header has been copied out.
+      bool headerDone;
+         /// Number of observation types by system, ' ' for RINEX 2.
+      std::map<char,unsigned> numObs;
+         /// The previous epoch line, in compact RINEX form.
+      std::string epochLine;
+         /// Receiver clock offset.
+      Arc clock;
+         /// State for each satellite in the previous epoch.
+      std::map<std::string,SatState> sats;
+         /// An error found after the epochs returned by fill().
+      std::string pendingError;
+         /// Work space.
+      std::string line;
+   }; // End of class 'HatanakaStreamBuf'
+
+      //@}
+
+}  // End of namespace gnsstk
+
+#endif   // GNSSTK_HATANAKASTREAMBUF_HPP
@@ -56,6 +56,25 @@ namespace gnsstk
       // 2nd edition, Walter de Gruyter, p.52-54.
    static const double C2_FACT   = 40.3e+16;
 
+
+      /** Throw InvalidRequest if the time system of \a t can't be
+       * compared with the keys next to it in \a tmap.  PackedTime
+       * comparisons don't check the time system, where the
+       * CommonTime keys used to. */
+   template <class TimeMap>
+   static void checkTimeSystem(const TimeMap& tmap, const CommonTime& t)
+   {
+      PackedTime key(t);
+      typename TimeMap::const_iterator i = tmap.lower_bound(key);
+      if ((i != tmap.end() && !key.compatible(i->first)) ||
+          (i != tmap.begin() && !key.compatible((--i)->first)))
+      {
+         InvalidRequest ir("IonexStore time system mismatch: " +
+                           asString(t.getTimeSystem()));
+         GNSSTK_THROW(ir);
+      }
+   }
+
    IonexStore ::
    IonexStore()
          : initialTime(CommonTime::END_OF_TIME),
@@ -102,6 +121,7 @@ namespace gnsstk
          addFile(filename,header);
 
             // this map is useful in finding DCB value
+         checkTimeSystem(inxDCBMap, header.firstEpoch);
          inxDCBMap[header.firstEpoch] = header.svsmap;
 
             // object data. If valid, add to the map
@@ -128,6 +148,7 @@ namespace gnsstk
 
       if (type != IonexData::UN)
       {
+         checkTimeSystem(inxMaps, t);
          inxMaps[t][type] = iod;
       }
 
@@ -185,7 +206,7 @@ namespace gnsstk
 
          for (it=inxMaps.begin(); it != inxMaps.end(); it++)
          {
-            s << it->first << "   ";
+            s << it->first.toCommonTime() << "   ";
 
             if ( it->second.count(IonexData::TEC) )
             {
@@ -283,6 +304,7 @@ namespace gnsstk
       }
 
          // let's look for valid Ionex maps
+      checkTimeSystem(inxMaps, t);
       CommonTime T[2];
          // iterator
       IonexMap::const_iterator itm = inxMaps.find(t);
@@ -293,16 +315,16 @@ namespace gnsstk
                // get the current map
             itm = inxMaps.lower_bound(t);
                // store current and next epoch
-            T[0] = itm->first;
-            T[1] = (++itm)->first;
+            T[0] = itm->first.toCommonTime();
+            T[1] = (++itm)->first.toCommonTime();
          }
          else                                   // t is between two maps
          {
                // get the next valid map
             itm = inxMaps.lower_bound(t);
                // store the next and previous epoch
-            T[1] = itm->first;
-            T[0] = (--itm)->first;
+            T[1] = itm->first.toCommonTime();
+            T[0] = (--itm)->first.toCommonTime();
          }  // end of 'if( itm != inxMaps.end() ) ... else ... ''
       }
       catch (...)
@@ -512,6 +534,7 @@ namespace gnsstk
          GNSSTK_THROW(e);
       }
 
+      checkTimeSystem(inxDCBMap, time);
       double dt(0.0);
       IonexDCBMap::const_iterator itm = inxDCBMap.begin();
 
@@ -519,7 +542,7 @@ namespace gnsstk
       while ( itm != inxDCBMap.end() )
       {
             // let's get the relative reference
-         dt = time - itm->first;
+         dt = time - itm->first.toCommonTime();
 
             // this means we don't have maps for this day and there is a gap
          if( dt < 0.0 )
@@ -55,6 +55,7 @@
 #include "GNSSconstants.hpp"                   // DEG_TO_RAD
 #include "GNSSconstants.hpp"          // LX_FREQ, with X = 1,2,5,6,7,8
 #include "Triple.hpp"
+#include "PackedTime.hpp"
 
 namespace gnsstk
 {
@@ -311,14 +312,15 @@ namespace gnsstk
          /// The key to this map is IonexValType
       typedef std::map<IonexData::IonexValType, IonexData> IonexValTypeMap;
 
-         /// The key to this map is the time
-      typedef std::map<CommonTime, IonexValTypeMap> IonexMap;
+         /// The key to this map is the time (PackedTime, which is
+         /// much cheaper to compare than CommonTime)
+      typedef std::map<PackedTime, IonexValTypeMap> IonexMap;
 
          /// Map of IONEX maps
       IonexMap inxMaps;
 
          /// The key of this map is the time (first epoch as in IonexHeader)
-      typedef std::map<CommonTime, IonexHeader::SatDCBMap> IonexDCBMap;
+      typedef std::map<PackedTime, IonexHeader::SatDCBMap> IonexDCBMap;
 
          /// Map of DCB values (IonexHeader.firstEpoch, IonexHeader.svsmap)
       IonexDCBMap inxDCBMap;
@@ -0,0 +1,224 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file LZWStreamBuf.cpp
+ * Stream buffer that decompresses Unix compress (.Z) data.
+ */
+
+#include <algorithm>
+#include "LZWStreamBuf.hpp"
+#include "FFStreamError.hpp"
+
+   /// Size of the compressed and decompressed blocks.
+static const unsigned lzwBlockSize = 65536;
+   /// Initial code width.
+static const int lzwInitBits = 9;
+   /// Code that clears the string table in block mode.
+static const int lzwClear = 256;
+
+namespace gnsstk
+{
+   LZWStreamBuf ::
+   LZWStreamBuf(std::streambuf* src)
+         : DecompressStreamBuf(src),
+           inBuf(lzwBlockSize),
+           inPos(0),
+           inEnd(0),
+           bitBuf(0),
+           bitCount(0),
+           haveHeader(false),
+           done(false),
+           blockMode(false),
+           maxBits(0),
+           nBits(lzwInitBits),
+           codesAtWidth(0),
+           maxCode((1 << lzwInitBits) - 1),
+           maxMaxCode(0),
+           freeEnt(0),
+           oldCode(-1),
+           finChar(0)
+   {
+   }
+
+
+   void LZWStreamBuf ::
+   readHeader()
+   {
+      char hdr[3];
+      if ((source->sgetn(hdr, 3) != 3) || !isLZW(std::string(hdr, 2)))
+      {
+         FFStreamError exc("Not compressed (.Z) data");
+         GNSSTK_THROW(exc);
+      }
+      maxBits = hdr[2] & 0x1f;
+      blockMode = (hdr[2] & 0x80) != 0;
+      if ((maxBits < lzwInitBits) || (maxBits > 16))
+      {
+         FFStreamError exc("Unsupported .Z code width " +
+                           std::to_string(maxBits));
+         GNSSTK_THROW(exc);
+      }
+      maxMaxCode = 1 << maxBits;
+      freeEnt = blockMode ? lzwClear + 1 : lzwClear;
+      prefix.assign(maxMaxCode, 0);
+      suffix.resize(maxMaxCode);
+      for (int i = 0; i < 256; i++)
+      {
+         suffix[i] = i;
+      }
+      haveHeader = true;
+   }
+
+
+   bool LZWStreamBuf ::
+   readCode(int& code)
+   {
+      while (bitCount < nBits)
+      {
+         if (inPos == inEnd)
+         {
+            std::streamsize n = source->sgetn(&inBuf[0], inBuf.size());
+            if (n <= 0)
+            {
+               return false;
+            }
+            inPos = 0;
+            inEnd = n;
+         }
+         bitBuf |= (std::uint32_t)(unsigned char)inBuf[inPos++] << bitCount;
+         bitCount += 8;
+      }
+      code = bitBuf & ((1u << nBits) - 1);
+      bitBuf >>= nBits;
+      bitCount -= nBits;
+      codesAtWidth++;
+      return true;
+   }
+
+
+   void LZWStreamBuf ::
+   skipGroup()
+   {
+      int code;
+      while ((codesAtWidth % 8) != 0)
+      {
+         if (!readCode(code))
+         {
+            break;
+         }
+      }
+      codesAtWidth = 0;
+   }
+
+
+   void LZWStreamBuf ::
+   fill(std::string& out)
+   {
+      out.clear();
+      if (!haveHeader)
+      {
+         readHeader();
+      }
+      int code;
+      while (!done && (out.size() < lzwBlockSize))
+      {
+         if (freeEnt > maxCode)
+         {
+            skipGroup();
+            nBits++;
+            maxCode = (nBits == maxBits) ? maxMaxCode : (1 << nBits) - 1;
+         }
+         if (!readCode(code))
+         {
+            done = true;
+            break;
+         }
+         if (oldCode == -1)
+         {
+            if (code >= 256)
+            {
+               FFStreamError exc("Invalid .Z data: bad first code");
+               GNSSTK_THROW(exc);
+            }
+            finChar = oldCode = code;
+            out += (char)finChar;
+            continue;
+         }
+         if ((code == lzwClear) && blockMode)
+         {
+            std::fill(prefix.begin(), prefix.end(), 0);
+            freeEnt = lzwClear;
+            skipGroup();
+            nBits = lzwInitBits;
+            maxCode = (1 << nBits) - 1;
+            continue;
+         }
+         int inCode = code;
+         stack.clear();
+         if (code >= freeEnt)
+         {
+               // The special case of a string that was defined by
+               // the code being decoded.
+            if (code > freeEnt)
+            {
+               FFStreamError exc("Invalid .Z data: code out of range");
+               GNSSTK_THROW(exc);
+            }
+            stack += (char)finChar;
+            code = oldCode;
+         }
+         while (code >= 256)
+         {
+            stack += (char)suffix[code];
+            code = prefix[code];
+         }
+         finChar = suffix[code];
+         stack += (char)finChar;
+         out.append(stack.rbegin(), stack.rend());
+         if (freeEnt < maxMaxCode)
+         {
+            prefix[freeEnt] = oldCode;
+            suffix[freeEnt] = finChar;
+            freeEnt++;
+         }
+         oldCode = inCode;
+      }
+   }
+
+}  // End of namespace gnsstk
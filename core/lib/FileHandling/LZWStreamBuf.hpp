@@ -0,0 +1,133 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file LZWStreamBuf.hpp
+ * Stream buffer that decompresses Unix compress (.Z) data.
+ */
+
+#ifndef GNSSTK_LZWSTREAMBUF_HPP
+#define GNSSTK_LZWSTREAMBUF_HPP
+
+#include <cstdint>
+#include <vector>
+#include "DecompressStreamBuf.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup FileHandling
+      //@{
+
+      /**
+       * Decompress the LZW data written by the Unix compress
+       * utility, which is still used for much of the RINEX data in
+       * the IGS archives.
+       */
+   class LZWStreamBuf : public DecompressStreamBuf
+   {
+   public:
+         /** Set up to decompress the contents of src.
+          * @param[in] src The compressed data. */
+      LZWStreamBuf(std::streambuf* src);
+
+         /// Return true if data starts with the compress magic number.
+      static bool isLZW(const std::string& data)
+      {
+         return ((data.size() >= 2) && (data[0] == '\x1f') &&
+                 (data[1] == '\x9d'));
+      }
+
+   protected:
+         /// Decompress the next block of data.
+      void fill(std::string& out) override;
+
+   private:
+         /// Read the three byte header.
+      void readHeader();
+         /** Get the next code from the source.
+          * @return false at the end of the data. */
+      bool readCode(int& code);
+         /** Skip to the end of the current group of eight codes, as
+          * compress does whenever the code width changes. */
+      void skipGroup();
+
+         /// Compressed data read from the source.
+      std::vector<char> inBuf;
+         /// Index of the next unused byte in inBuf.
+      std::size_t inPos;
+         /// Number of valid bytes in inBuf.
+      std::size_t inEnd;
+         /// Bits read from inBuf but not yet used.
+      std::uint32_t bitBuf;
+         /// Number of valid bits in bitBuf.
+      int bitCount;
+         /// Set once the header has been read.
+      bool haveHeader;
+         /// Set at the end of the compressed data.
+      bool done;
+         /// True if code 256 clears the table.
+      bool blockMode;
+         /// Largest code width in bits.
+      int maxBits;
+         /// Current code width in bits.
+      int nBits;
+         /// Number of codes read at the current width.
+      unsigned codesAtWidth;
+         /// Largest code at the current width.
+      int maxCode;
+         /// One more than the largest possible code.
+      int maxMaxCode;
+         /// Next unused table entry.
+      int freeEnt;
+         /// Previous code, -1 before the first code.
+      int oldCode;
+         /// First byte of the previous string.
+      int finChar;
+         /// Table of string prefixes, indexed by code.
+      std::vector<std::uint16_t> prefix;
+         /// Table of string final bytes, indexed by code.
+      std::vector<unsigned char> suffix;
+         /// Work space for reversing strings.
+      std::string stack;
+   }; // End of class 'LZWStreamBuf'
+
+      //@}
+
+}  // End of namespace gnsstk
+
+#endif   // GNSSTK_LZWSTREAMBUF_HPP
@@ -143,10 +143,6 @@ namespace gnsstk
       virtual void reallyGetRecord(FFStream& s);
 
    private:
-         /// Time corresponding to previous set of oberservations
-         /// Used in cases where epoch time of a epoch flag==0
-      static gnsstk::CommonTime previousTime;
-
          /// Writes the CommonTime object into RINEX format. If it's a bad time,
          /// it will return blanks.
       std::string writeTime(const CommonTime& dt) const;
@@ -111,6 +111,12 @@ namespace gnsstk
          /// The header for this file.
       RinexObsHeader header;
 
+         /** Time of the most recent record read that had an epoch
+          * time, used for event records (epoch flags 2-4) that don't
+          * have one.  Kept per stream so that separate streams can
+          * be read concurrently. */
+      CommonTime previousTime;
+
          /// Check if the input stream is the kind of RinexObsStream
       static bool isRinexObsStream(std::istream& i);
 
@@ -389,8 +389,6 @@ namespace gnsstk
 
    void reallyGetRecordVer2(Rinex3ObsStream& strm, Rinex3ObsData& rod)
    {
-      static CommonTime previousTime(CommonTime::BEGINNING_OF_TIME);
-
          // get the epoch line and check
       string line;
       while(line.empty())        // ignore blank lines in place of epoch lines
@@ -426,7 +424,7 @@ namespace gnsstk
          GNSSTK_THROW(e);
       }
       else if(noEpochTime)
-         rod.time = previousTime;
+         rod.time = strm.previousTime;
       else
       {
          try
@@ -487,7 +485,7 @@ namespace gnsstk
             // end rod.time = parseTime(line, strm.header);
 
             // save for next call
-         previousTime = rod.time;
+         strm.previousTime = rod.time;
       }
 
          // number of satellites
@@ -609,6 +607,11 @@ namespace gnsstk
       if(!strm.headerRead) strm >> strm.header;
 
       Rinex3ObsData rod;
+         // In fastRead mode, hang on to the old observation map so
+         // its nodes and vectors can be reused for this record.
+      DataMap prevObs;
+      if(strm.fastRead)
+         prevObs.swap(obs);
 
          // clear out this ObsData
       *this = rod;
@@ -658,7 +661,21 @@ namespace gnsstk
          clockOffset = 0.0;
 
          // Read the observations: SV ID and data ----------------------------
-      if(epochFlag == 0 || epochFlag == 1 || epochFlag == 6)
+      if((epochFlag == 0 || epochFlag == 1 || epochFlag == 6) &&
+         strm.fastRead)
+      {
+         obs.swap(prevObs);
+         try
+         {
+            getObsFast(strm, line);
+         }
+         catch(...)
+         {
+            obs.clear();
+            throw;
+         }
+      }
+      else if(epochFlag == 0 || epochFlag == 1 || epochFlag == 6)
       {
          vector<RinexSatID> satIndex(numSVs);
          map<RinexSatID, vector<RinexDatum> > tempDataMap;
@@ -739,6 +756,66 @@ namespace gnsstk
    } // end of reallyGetRecord()
 
 
+   void Rinex3ObsData::getObsFast(Rinex3ObsStream& strm, string& line)
+   {
+      vector<RinexSatID>& satIndex(strm.epochSats);
+      satIndex.resize(numSVs);
+      for(int isv = 0; isv < numSVs; isv++)
+      {
+         strm.formattedGetLine(line);
+         StringUtils::stripTrailing(line, " ");
+
+            // get the SV ID
+         try
+         {
+            satIndex[isv] = RinexSatID(line.substr(0,3));
+         }
+         catch (Exception& e)
+         {
+            FFStreamError ffse(e);
+            GNSSTK_THROW(ffse);
+         }
+
+            // get the # data items (# entries in ObsType map of
+            // maps from header)
+         string gnss(1, satIndex[isv].systemChar());
+         size_t size = strm.header.mapObsTypes[gnss].size();
+
+            // Pad missing trailing obs with blanks, as in
+            // reallyGetRecord().
+         size_t minSize = 3 + 16*size;
+         if(line.size() < minSize)
+            line.resize(minSize, ' ');
+
+            // Parse the fields in place, overwriting whatever was
+            // left in the vector from the previous record.
+         vector<RinexDatum>& data(obs[satIndex[isv]]);
+         data.resize(size);
+         const char *field = line.c_str() + 3;
+         for(size_t i = 0; i < size; i++, field += 16)
+         {
+            data[i].fromChars(field);
+         }
+      }
+
+         // Remove satellites left over from the previous record.
+         // Both obs and the sorted satIndex are in SatID order, so
+         // this is a single merge pass.
+      sort(satIndex.begin(), satIndex.end());
+      vector<RinexSatID>::const_iterator si = satIndex.begin();
+      DataMap::iterator oi = obs.begin();
+      while(oi != obs.end())
+      {
+         while(si != satIndex.end() && *si < oi->first)
+            si++;
+         if(si != satIndex.end() && *si == oi->first)
+            oi++;
+         else
+            oi = obs.erase(oi);
+      }
+   }
+
+
    CommonTime Rinex3ObsData::parseTime(const string& line,
                                        const Rinex3ObsHeader& hdr,
                                        const TimeSystem& ts) const
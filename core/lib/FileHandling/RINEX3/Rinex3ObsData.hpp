@@ -57,6 +57,8 @@
 
 namespace gnsstk
 {
+   class Rinex3ObsStream;
+
 
       /// @ingroup FileHandling
       //@{
@@ -221,6 +223,16 @@ namespace gnsstk
       std::string writeTime(const CommonTime& dt) const;
 
 
+         /** Read the satellite observation lines of an epoch for the
+          * Rinex3ObsStream::fastRead mode, reusing the existing
+          * contents of obs.
+          * @pre numSVs has been set from the epoch line.
+          * @param[in,out] strm The stream to read from.
+          * @param[in,out] line Line buffer, reused for each line read.
+          * @throw FFStreamError */
+      void getObsFast(Rinex3ObsStream& strm, std::string& line);
+
+
          /** This function constructs a CommonTime object from the given
           *  parameters.
           *
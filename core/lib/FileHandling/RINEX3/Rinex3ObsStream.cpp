@@ -47,6 +47,7 @@ namespace gnsstk
 {
    Rinex3ObsStream ::
    Rinex3ObsStream()
+         : fastRead(false)
    {
       init();
    }
@@ -55,7 +56,8 @@ namespace gnsstk
    Rinex3ObsStream ::
    Rinex3ObsStream( const char* fn,
                     std::ios::openmode mode )
-         : FFTextStream(fn, mode)
+         : FFTextStream(fn, mode),
+           fastRead(false)
    {
       init();
    }
@@ -64,7 +66,8 @@ namespace gnsstk
    Rinex3ObsStream ::
    Rinex3ObsStream( const std::string fn,
                     std::ios::openmode mode )
-         : FFTextStream(fn.c_str(), mode)
+         : FFTextStream(fn.c_str(), mode),
+           fastRead(false)
    {
       init();
    }
@@ -91,6 +94,7 @@ namespace gnsstk
       headerRead = false;
       header = Rinex3ObsHeader();
       timesystem = TimeSystem::GPS;
+      previousTime = CommonTime::BEGINNING_OF_TIME;
    }
 
 
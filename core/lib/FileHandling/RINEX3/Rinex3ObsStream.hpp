@@ -112,6 +112,27 @@ namespace gnsstk
          /// Time system for epochs in this file
       TimeSystem timesystem;
 
+         /** Time of the most recent RINEX 2 record read that had an
+          * epoch time, used for event records (epoch flags 2-4) that
+          * don't have one.  Kept per stream so that separate streams
+          * can be read concurrently. */
+      CommonTime previousTime;
+
+         /** Use the high-throughput reader for RINEX 3 observation
+          * records (default false).  Observation fields are parsed
+          * in place in the line buffer using RinexDatum::fromChars(),
+          * and the map and vectors in Rinex3ObsData::obs are reused
+          * when reading successive records into the same
+          * Rinex3ObsData object.  The resulting Rinex3ObsData are
+          * identical to those from the default reader.  RINEX 2
+          * files are not affected. */
+      bool fastRead;
+
+         /** Satellites in the epoch currently being read.  Kept here
+          * so that the fastRead mode doesn't need to allocate a new
+          * list for every record. */
+      std::vector<RinexSatID> epochSats;
+
          /// Check if the input stream is the kind of Rinex3ObsStream
       static bool isRinex3ObsStream(std::istream& i);
 
@@ -40,12 +40,73 @@
  * Defines class methods for a single RINEX datum.
  */
 
+#include <cstdint>
 #include "RinexDatum.hpp"
 #include "Exception.hpp"
 #include "StringUtils.hpp"
 
 namespace gnsstk
 {
+      /** Convert a blank-padded fixed-point decimal number, such as
+       * the F14.3 data field of a RINEX OBS datum.  A mantissa of at
+       * most 15 digits and a power of ten up to 1e15 are both exact
+       * doubles, so the single division is correctly rounded and
+       * gives the same result as strtod().
+       * @param[in] str The start of the field.
+       * @param[in] len The width of the field.
+       * @param[out] val The converted value.
+       * @return false if the field is not a plain fixed-point
+       *   number (e.g. it uses an exponent or has too many digits),
+       *   in which case val is unchanged. */
+   static bool parseFixed(const char *str, unsigned len, double& val)
+   {
+      static const double pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6,
+                                      1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
+                                      1e13, 1e14, 1e15 };
+      unsigned i = 0, digits = 0, frac = 0;
+      bool neg = false, point = false;
+      uint64_t mant = 0;
+      while ((i < len) && (str[i] == ' '))
+         i++;
+      if ((i < len) && ((str[i] == '-') || (str[i] == '+')))
+      {
+         neg = (str[i] == '-');
+         i++;
+      }
+      for (; i < len; i++)
+      {
+         char c = str[i];
+         if ((c >= '0') && (c <= '9'))
+         {
+            mant = mant * 10 + (c - '0');
+            digits++;
+            if (point)
+               frac++;
+         }
+         else if ((c == '.') && !point)
+         {
+            point = true;
+         }
+         else
+         {
+            break;
+         }
+      }
+         // only trailing blanks may follow the number
+      for (; i < len; i++)
+      {
+         if (str[i] != ' ')
+            return false;
+      }
+      if ((digits == 0) || (digits > 15))
+         return false;
+      val = static_cast<double>(mant) / pow10[frac];
+      if (neg)
+         val = -val;
+      return true;
+   }
+
+
    RinexDatum ::
    RinexDatum()
          : data(0), lli(0), ssi(0),
@@ -103,6 +164,52 @@ namespace gnsstk
    }
 
 
+   void RinexDatum ::
+   fromChars(const char *str)
+   {
+      unsigned i;
+      for (i = 0; (i < 14) && (str[i] == ' '); i++)
+         ;
+      if (i == 14)
+      {
+         data = 0.;
+         dataBlank = true;
+      }
+      else
+      {
+         if (!parseFixed(str, 14, data))
+            data = StringUtils::asDouble(std::string(str, 14));
+         dataBlank = false;
+      }
+      if (str[14] == ' ')
+      {
+         lli = 0;
+         lliBlank = true;
+      }
+      else
+      {
+         if ((str[14] >= '0') && (str[14] <= '9'))
+            lli = str[14] - '0';
+         else
+            lli = StringUtils::asInt(std::string(1, str[14]));
+         lliBlank = false;
+      }
+      if (str[15] == ' ')
+      {
+         ssi = 0;
+         ssiBlank = true;
+      }
+      else
+      {
+         if ((str[15] >= '0') && (str[15] <= '9'))
+            ssi = str[15] - '0';
+         else
+            ssi = StringUtils::asInt(std::string(1, str[15]));
+         ssiBlank = false;
+      }
+   }
+
+
    std::string RinexDatum ::
    asString() const
    {
@@ -70,6 +70,15 @@ namespace gnsstk
           * @throw AssertionFailure if str.length() != 16 */
       void fromString(const std::string& str);
 
+         /** Parse a RINEX OBS datum in place, without making
+          * temporary strings.  Plain fixed-point values are
+          * converted with an exact, locale-independent parser; any
+          * other text falls back to the same conversion as
+          * fromString(), so the results are identical.
+          * @param[in] str A RINEX-formatted datum, at least 16
+          *   characters long (i.e. a line padded with spaces). */
+      void fromChars(const char *str);
+
          /// Turn this datum into a RINEX OBS formatted string
       std::string asString() const;
 
@@ -285,12 +285,11 @@ namespace gnsstk
    const double GlobalTropModel::HEIGHT_LIMIT = 44243.;
 
    GlobalTropModel :: GlobalTropModel()
-         : validCoeff(false), validHeight(false), validLat(false),
-           validLon(false), validDay(false), height(0.0), latitude(0.0),
-           longitude(0.0), dayfactor(0.0), undul(0.0)
+         : height(0.0), latitude(0.0), longitude(0.0), dayfactor(0.0),
+           undul(0.0), validHeight(false), validLat(false), validLon(false),
+           validDay(false), validCoeff(false), validGPT(false)
    {
          // yes setting everything to 0 is the same as IEEE 0.0
-      memset(P, 0, sizeof(P));
       memset(aP, 0, sizeof(aP));
       memset(bP, 0, sizeof(bP));
       TropModel::humid = 50.0;
@@ -532,20 +531,22 @@ namespace gnsstk
    }
 
 
+   // Only what depends on a changed parameter is recomputed: the spherical
+   // harmonics on latitude and longitude, the GPT on those, height and time.
    void GlobalTropModel::setReceiverHeight(const double& ht)
    {
-      if(height != ht) {
+      if(!validHeight || height != ht) {
          height = ht;
          validHeight = true;
-         validCoeff = false;
-         setValid();          // calls updateGTMCoeff()
+         validGPT = false;
+         setValid();          // calls getGPT()
       }
    }
 
 
    void GlobalTropModel::setReceiverLatitude(const double& lat)
    {
-      if(latitude != lat) {
+      if(!validLat || latitude != lat) {
          latitude = lat;
          validLat = true;
          validCoeff = false;
@@ -556,7 +557,7 @@ namespace gnsstk
 
    void GlobalTropModel::setReceiverLongitude(const double& lon)
    {
-      if(longitude != lon) {
+      if(!validLon || longitude != lon) {
          longitude = lon;
          validLon = true;
          validCoeff = false;
@@ -568,11 +569,11 @@ namespace gnsstk
    void GlobalTropModel::setTime(const double& mjd)
    {
       double df(TWO_PI*(mjd - 44266.0)/365.25);       // -44239 + 1 - 28
-      if(df != dayfactor) {
+      if(!validDay || df != dayfactor) {
          dayfactor = df;
          validDay = true;
-         validCoeff = false;
-         setValid();
+         validGPT = false;
+         setValid();          // calls getGPT()
       }
    }
 
@@ -593,7 +594,6 @@ namespace gnsstk
 
    void GlobalTropModel::setParameters(const CommonTime& time, const Position& rxPos)
    {
-      validDay = validHeight = validLat = validLon = validCoeff = false;
       setTime(time);
       setReceiverHeight(rxPos.getHeight());
       setReceiverLatitude(rxPos.getGeodeticLatitude());
@@ -606,10 +606,17 @@ namespace gnsstk
    void GlobalTropModel::updateGTMCoeff()
    {
       if(!validLon || !validLat) return;
+      harmonics(latitude, longitude, aP, bP);
+   }
 
+
+   void GlobalTropModel::harmonics(double lat, double lon, double aP[55],
+                                   double bP[55])
+   {
       // compute Legendre functions and spherical harmonics
       int i,j,k;
-      double sinlat(::sin(latitude*DEG_TO_RAD));
+      double P[10][10];
+      double sinlat(::sin(lat*DEG_TO_RAD));
       for(i=0; i<=9; i++) {
          for(j=0; j<=i; j++) {
             int ir((i-j)/2);
@@ -626,7 +633,7 @@ namespace gnsstk
       }
 
       // spherical harmonics
-      double rlon(longitude*DEG_TO_RAD);
+      double rlon(lon*DEG_TO_RAD);
       i = 0;
       for(j=0; j<=9; j++) {
          for(k=0; k<=j; k++) {
@@ -653,4 +660,210 @@ namespace gnsstk
       }
    }
 
+
+   // GMF constants of the dry and wet mapping functions and the height
+   // correction, as in dry_mapping_function() and wet_mapping_function()
+   const double GlobalTropModel::SiteContext::DRY_B = 0.0029;
+   const double GlobalTropModel::SiteContext::WET_B = 0.00146;
+   const double GlobalTropModel::SiteContext::WET_C = 0.04391;
+   const double GlobalTropModel::SiteContext::HT_A = 2.53e-5;
+   const double GlobalTropModel::SiteContext::HT_B = 5.49e-3;
+   const double GlobalTropModel::SiteContext::HT_C = 1.14e-3;
+
+
+   GlobalTropModel::SiteContext::SiteContext(const double& ht,
+                                             const double& lat,
+                                             const double& lon)
+         : height(ht), latitude(lat), heightKm(ht/1000.0), humid(50.0),
+           validDay(false), dayfactor(0.0)
+   {
+      int i;
+      double aP[55], bP[55];
+      harmonics(lat, lon, aP, bP);
+
+      // the sums, in the same order as GlobalTropModel
+      undul = 0.0;
+      for(i=0; i<55; i++) undul += (Ageoid[i]*aP[i] + Bgeoid[i]*bP[i]);
+      orthoht = height - undul;
+      if(orthoht > HEIGHT_LIMIT)
+      {
+         InvalidTropModel exc("Invalid Global trop model: Rx Height exceeds limit");
+         GNSSTK_THROW(exc);
+      }
+
+      dryMean = dryAmp = wetMean = wetAmp = 0.0;
+      pressMean = pressAmp = tempMean = tempAmp = 0.0;
+      for(i=0; i<55; i++) {
+         dryMean += (ADryMean[i]*aP[i] + BDryMean[i]*bP[i]) * 1.0e-5;
+         dryAmp += (ADryAmp[i]*aP[i] + BDryAmp[i]*bP[i]) * 1.0e-5;
+         wetMean += (AWetMean[i]*aP[i] + BWetMean[i]*bP[i]) * 1.0e-5;
+         wetAmp += (AWetAmp[i]*aP[i] + BWetAmp[i]*bP[i]) * 1.0e-5;
+         pressMean += (APressMean[i]*aP[i] + BPressMean[i]*bP[i]);
+         pressAmp += (APressAmp[i]*aP[i] + BPressAmp[i]*bP[i]);
+         tempMean += (ATempMean[i]*aP[i] + BTempMean[i]*bP[i]);
+         tempAmp += (ATempAmp[i]*aP[i] + BTempAmp[i]*bP[i]);
+      }
+
+      clat = ::cos(latitude*DEG_TO_RAD);
+      if(latitude < 0) {
+         phh = PI;
+         c11h = 0.007;
+         c10h = 0.002;
+      }
+      else {
+         phh = 0.0;
+         c11h = 0.005;
+         c10h = 0.001;
+      }
+      heightNum = 1.0 + HT_A/(1.0 + HT_B/(1.0 + HT_C));
+   }
+
+
+   GlobalTropModel::SiteContext::SiteContext(const Position& RX)
+         : SiteContext(RX.getAltitude(), RX.getGeodeticLatitude(),
+                       RX.getLongitude())
+   {
+   }
+
+
+   void GlobalTropModel::SiteContext::setTime(const double& mjd)
+   {
+      dayfactor = TWO_PI*(mjd - 44266.0)/365.25;
+      validDay = true;
+      update();
+   }
+
+
+   void GlobalTropModel::SiteContext::setTime(const CommonTime& time)
+   {
+      setTime(static_cast<MJD>(time).mjd);
+   }
+
+
+   void GlobalTropModel::SiteContext::setDayOfYear(const int& doy)
+   {
+      setTime(44266.0 + (double)doy);
+   }
+
+
+   void GlobalTropModel::SiteContext::setHumidity(const double& rh)
+   {
+      if(rh < 0.0 || rh > 100.)
+         GNSSTK_THROW(InvalidParameter("Invalid humidity (%)"));
+      humid = rh;
+      if(validDay) update();
+   }
+
+
+   void GlobalTropModel::SiteContext::update()
+   {
+      double cosday(::cos(dayfactor));
+
+      // GPT, as getGPT()
+      press = (pressMean + pressAmp * cosday)
+            * ::pow(1.0-2.26e-5*orthoht,5.225);
+      temp = (tempMean + tempAmp * cosday) - 6.5e-3 * orthoht;
+
+      // zenith delays, as dry_zenith_delay() and wet_zenith_delay()
+      dryZenith = (0.0022768*press / (1-0.00266*::cos(2*latitude*DEG_TO_RAD)
+                                       -0.00028*height/1000.));
+      double T = temp + CELSIUS_TO_KELVIN;
+      double pwv = 0.01 * humid * ::exp(-37.2465 + (0.213166-0.000256908*T)*T);
+      wetZenith = (0.0122 + 0.00943 * pwv);
+
+      // mapping function coefficients
+      static const double c0h = 0.062;
+      ch = c0h + ((::cos(dayfactor + phh)+1.0)*c11h/2.0 + c10h)*(1.0-clat);
+      ah = dryMean + dryAmp*cosday;
+      aw = wetMean + wetAmp*cosday;
+      dryNum = 1.0 + ah/(1.0 + DRY_B/(1.0 + ch));
+      wetNum = 1.0 + aw/(1.0 + WET_B/(1.0 + WET_C));
+   }
+
+
+   void GlobalTropModel::SiteContext::testValidity() const
+   {
+      if(!validDay)
+         GNSSTK_THROW(InvalidTropModel("Invalid Global trop model: day of year"));
+   }
+
+
+   double GlobalTropModel::SiteContext::correction(double elevation) const
+   {
+      try { testValidity(); }
+      catch(InvalidTropModel& e) { GNSSTK_RETHROW(e); }
+
+      // Global mapping functions good down to 3 degrees of elevation
+      if(elevation < 3.0) { return 0.0; }
+
+      double map_dry, map_wet;
+      mapping(::sin(elevation*DEG_TO_RAD), map_dry, map_wet);
+      return (dryZenith * map_dry) + (wetZenith * map_wet);
+   }
+
+
+   void GlobalTropModel::SiteContext::correction(
+      const std::vector<double>& elevation, std::vector<double>& delay) const
+   {
+      try { testValidity(); }
+      catch(InvalidTropModel& e) { GNSSTK_RETHROW(e); }
+
+      // the same arithmetic for every satellite, so the loop has no
+      // branch other than the final selection
+      delay.resize(elevation.size());
+      for(size_t i=0; i<elevation.size(); i++) {
+         double map_dry, map_wet;
+         mapping(::sin(elevation[i]*DEG_TO_RAD), map_dry, map_wet);
+         double d = (dryZenith * map_dry) + (wetZenith * map_wet);
+         delay[i] = (elevation[i] < 3.0 ? 0.0 : d);
+      }
+   }
+
+
+   double GlobalTropModel::SiteContext::dry_zenith_delay() const
+   {
+      try { testValidity(); } catch(InvalidTropModel& e) { GNSSTK_RETHROW(e); }
+      return dryZenith;
+   }
+
+
+   double GlobalTropModel::SiteContext::wet_zenith_delay() const
+   {
+      try { testValidity(); } catch(InvalidTropModel& e) { GNSSTK_RETHROW(e); }
+      return wetZenith;
+   }
+
+
+   double GlobalTropModel::SiteContext::dry_mapping_function(double elevation)
+      const
+   {
+      try { testValidity(); } catch(InvalidTropModel& e) { GNSSTK_RETHROW(e); }
+      if(elevation < 3.0) { return 0.0; }
+      double map_dry, map_wet;
+      mapping(::sin(elevation*DEG_TO_RAD), map_dry, map_wet);
+      return map_dry;
+   }
+
+
+   double GlobalTropModel::SiteContext::wet_mapping_function(double elevation)
+      const
+   {
+      try { testValidity(); } catch(InvalidTropModel& e) { GNSSTK_RETHROW(e); }
+      if(elevation < 3.0) { return 0.0; }
+      double map_dry, map_wet;
+      mapping(::sin(elevation*DEG_TO_RAD), map_dry, map_wet);
+      return map_wet;
+   }
+
+
+   void GlobalTropModel::SiteContext::getGPT(double& P, double& T, double& U)
+      const
+   {
+      try { testValidity(); } catch(InvalidTropModel& e) { GNSSTK_RETHROW(e); }
+      P = press;
+      T = temp;
+      U = undul;
+   }
+
+
 } // end namespace gnsstk
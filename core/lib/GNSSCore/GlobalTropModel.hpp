@@ -45,6 +45,7 @@
 #ifndef GLOBAL_TROP_MODEL_HPP
 #define GLOBAL_TROP_MODEL_HPP
 
+#include <vector>
 #include "CommonTime.hpp"
 #include "TropModel.hpp"
 
@@ -73,7 +74,7 @@ namespace gnsstk
        * <pre>
        *  depedency cheat sheet:
        *   User provides:    Model computes/stores:           Output of model:
-       *     lat,lon,ht ---> coeffs  [in updateGTMCoeff()]
+       *     lat,lon    ---> coeffs  [in updateGTMCoeff()]
        *     time (doy) ---> dayfactor [ setTime(mjd) ]
        *     humidity%  ---> humid
        *
@@ -84,7 +85,7 @@ namespace gnsstk
        *                     dayfactor,coeffs --------------> dry_mapping_function(elev)
        *  So, change lat   => coeffs => P,T => wet/dry zen/map
        *             lon   => coeffs => P,T => wet/dry zen/map
-       *             ht    => coeffs => P,T => wet/dry zen/map
+       *             ht    => P,T => wet/dry zen/map
        *             time  => dayfactor => P,T => wet/dry zen/map
        *             humid => wet zen
        *
@@ -112,12 +113,158 @@ namespace gnsstk
        *   trop = globalTM.correction(elevation);
        * @endcode
        *
+       * To correct many satellites at one or more receivers, use a
+       * SiteContext for each receiver, which keeps the terms that
+       * depend on the position and the day.
+       *
        * @warning The Global mapping functions are defined for elevation
        *   angles down to 3 degrees, below that the correction is set to zero.
        */
    class GlobalTropModel : public TropModel
    {
    public:
+         /** The state of the Global model for one receiver, for
+          * correcting all the satellites in view at many epochs.
+          *
+          * The spherical harmonic expansions (to degree and order 9)
+          * of the GPT and GMF coefficients depend only on the
+          * receiver position; the constructor evaluates them once and
+          * keeps the 55-term sums.  setTime() then evaluates the
+          * day-dependent pressure, temperature, zenith delays and
+          * mapping function coefficients, which leaves only the
+          * continued fractions in elevation to correction().  The
+          * results are those of a GlobalTropModel with the same
+          * position, time and humidity.
+          *
+          * @code
+          *   GlobalTropModel::SiteContext site(rxPos);   // once per receiver
+          *   for(each epoch) {
+          *      site.setTime(time);
+          *      site.correction(elevations, delays);
+          *   }
+          * @endcode
+          */
+      class SiteContext
+      {
+      public:
+            /** Evaluate the site-dependent terms.
+             * @param ht Height of the receiver above the ellipsoid, in meters.
+             * @param lat Geodetic latitude of the receiver, in degrees.
+             * @param lon Longitude of the receiver, in degrees.
+             * @throw InvalidTropModel if the height is beyond the model.
+             */
+         SiteContext(const double& ht, const double& lat, const double& lon);
+
+            /** Evaluate the site-dependent terms, as GlobalTropModel
+             * does in correction(RX,SV).
+             * @param RX Receiver position.
+             * @throw InvalidTropModel if the height is beyond the model.
+             */
+         explicit SiteContext(const Position& RX);
+
+            /** Define the time of interest, and evaluate the
+             * day-dependent terms; this is required before calling
+             * correction() or any of the zenith delay and mapping
+             * functions.
+             * @param mjd  MJD (double)
+             */
+         void setTime(const double& mjd);
+
+            /// @copydoc setTime(const double&)
+         void setTime(const CommonTime& time);
+
+            /// @copydoc GlobalTropModel::setDayOfYear
+         void setDayOfYear(const int& doy);
+
+            /** @copydoc GlobalTropModel::setHumidity
+             * @throw InvalidParameter
+             */
+         void setHumidity(const double& rh);
+
+            /** Compute the tropospheric delay, in meters, at one
+             * elevation angle; zero below 3 degrees.
+             * @param elevation Elevation of the satellite, in degrees.
+             * @throw InvalidTropModel if the time has not been set.
+             */
+         double correction(double elevation) const;
+
+            /** Compute the tropospheric delay, in meters, for many
+             * satellites at once; cf. correction(double).
+             * @param elevation Elevations of the satellites, in degrees.
+             * @param delay Output delays, resized to match elevation.
+             * @throw InvalidTropModel if the time has not been set.
+             */
+         void correction(const std::vector<double>& elevation,
+                         std::vector<double>& delay) const;
+
+            /// @copydoc GlobalTropModel::dry_zenith_delay
+         double dry_zenith_delay() const;
+
+            /// @copydoc GlobalTropModel::wet_zenith_delay
+         double wet_zenith_delay() const;
+
+            /// @copydoc GlobalTropModel::dry_mapping_function
+         double dry_mapping_function(double elevation) const;
+
+            /// @copydoc GlobalTropModel::wet_mapping_function
+         double wet_mapping_function(double elevation) const;
+
+            /** Get the GPT pressure (mbar), temperature (deg C) and
+             * geoid undulation (m), cf. GlobalTropModel::getGPT().
+             * @throw InvalidTropModel if the time has not been set.
+             */
+         void getGPT(double& P, double& T, double& U) const;
+
+      private:
+            /// Evaluate the day-dependent terms.
+         void update();
+
+            /** Throw if the time has not been set.
+             * @throw InvalidTropModel
+             */
+         void testValidity() const;
+
+            /// Dry and wet mapping functions at sin(elevation).
+         void mapping(double sine, double& dry, double& wet) const
+         {
+            dry = dryNum / (sine + ah/(sine + DRY_B/(sine + ch)))
+                + ( (1.0/sine) - heightNum
+                                 / (sine + HT_A/(sine + HT_B/(sine + HT_C)))
+                  ) * heightKm;
+            wet = wetNum / (sine + aw/(sine + WET_B/(sine + WET_C)));
+         }
+
+            /// GMF constants b and c, and the height correction a, b, c
+         static const double DRY_B, WET_B, WET_C, HT_A, HT_B, HT_C;
+
+            /// receiver height (m), latitude (deg) and height in km
+         double height, latitude, heightKm;
+            /// geoid undulation and orthometric height, m
+         double undul, orthoht;
+            /// mean and amplitude of the annual variation of the
+            /// coefficient a of the dry and wet mapping functions
+         double dryMean, dryAmp, wetMean, wetAmp;
+            /// mean and amplitude of pressure and temperature on the geoid
+         double pressMean, pressAmp, tempMean, tempAmp;
+            /// latitude-dependent terms of the dry coefficient c
+         double phh, c11h, c10h, clat;
+            /// relative humidity in percent
+         double humid;
+
+            /// true once the time has been set
+         bool validDay;
+            /// day of the year, as an angle
+         double dayfactor;
+            /// GPT pressure (mbar) and temperature (deg C)
+         double press, temp;
+            /// zenith delays, m
+         double dryZenith, wetZenith;
+            /// GMF coefficients a and c
+         double ah, ch, aw;
+            /// numerators of the dry, height and wet mapping functions
+         double dryNum, heightNum, wetNum;
+      };
+
          /// Default constructor
       GlobalTropModel();
 
@@ -132,8 +279,8 @@ namespace gnsstk
       GlobalTropModel(const double& ht, const double& lat, const double& lon,
                       const double& mjd)
       {
-         validCoeff = validHeight = validLat = validLon = validDay = valid =
-            false;
+         validCoeff = validGPT = validHeight = validLat = validLon =
+            validDay = valid = false;
          setReceiverHeight(ht);
          setReceiverLatitude(lat);
          setReceiverLongitude(lon);
@@ -147,7 +294,8 @@ namespace gnsstk
           */
       GlobalTropModel(const Position& RX, const CommonTime& time)
       {
-         validCoeff = validHeight = validLat = validLon = validDay = valid = false;
+         validCoeff = validGPT = validHeight = validLat = validLon =
+            validDay = valid = false;
          setReceiverHeight(RX.getAltitude());
          setReceiverLatitude(RX.getGeodeticLatitude());
          setReceiverLongitude(RX.getLongitude());
@@ -309,8 +457,17 @@ namespace gnsstk
       static const double HEIGHT_LIMIT;
 
       double height, latitude, longitude, dayfactor, undul;
-      double P[10][10], aP[55], bP[55];
-      bool validHeight, validLat, validLon, validDay, validCoeff;
+      double aP[55], bP[55];
+      bool validHeight, validLat, validLon, validDay, validCoeff, validGPT;
+
+      /** Compute the spherical harmonics of the model at a position.
+       * @param lat latitude in degrees
+       * @param lon longitude in degrees
+       * @param aP output cosine terms
+       * @param bP output sine terms
+       */
+      static void harmonics(double lat, double lon, double aP[55],
+                            double bP[55]);
 
       /// Update coefficients when latitude and/or longitude changes
       void updateGTMCoeff();
@@ -331,7 +488,11 @@ namespace gnsstk
             if(valid && !validCoeff) {
                updateGTMCoeff();
                validCoeff = true;
+               validGPT = false;
+            }
+            if(valid && !validGPT) {
                getGPT(press,temp,undul);
+               validGPT = true;
             }
          } catch(Exception& e) { GNSSTK_RETHROW(e); }
       }
@@ -64,10 +64,18 @@ namespace gnsstk
                                         double svaz,
                                         CarrierBand band) const
    {
-      IonoModelMap::const_iterator i = ims.upper_bound(time);
+      PackedTime key(time);
+      IonoModelMap::const_iterator i = ims.upper_bound(key);
       if (!ims.empty() && i != ims.begin())
       {
          i--;
+            // PackedTime comparisons don't check the time system
+         if (!key.compatible(i->first))
+         {
+            InvalidRequest ir("IonoModelStore time system mismatch: " +
+                              StringUtils::asString(time.getTimeSystem()));
+            GNSSTK_THROW(ir);
+         }
          return i->second.getCorrection(time, rxgeo, svel, svaz, band);
       }
       else
@@ -91,18 +99,25 @@ namespace gnsstk
       if (!im.isValid())
          return false;
 
-      IonoModelMap::const_iterator i = ims.upper_bound(mt);
+      PackedTime key(mt);
+      IonoModelMap::const_iterator i = ims.upper_bound(key);
+         // PackedTime comparisons don't check the time system, so
+         // check the neighbors, as CommonTime keys would have.
+      if (i != ims.end() && !key.compatible(i->first))
+      {
+         return false;
+      }
       if (!ims.empty() && i != ims.begin())
       {
             // Compare to previous stored model and, if they have the
             // the same alpha and beta parameters, don't store it.
          i--;
-         if (im == i->second)
+         if (!key.compatible(i->first) || (im == i->second))
          {
             return false;
          }
       }
-      ims[mt] = im;
+      ims[key] = im;
 
       return true;
 
@@ -144,13 +159,15 @@ namespace gnsstk
 
    gnsstk::CommonTime IonoModelStore::getInitialTime() const
    {
-      return (ims.empty() ? CommonTime::END_OF_TIME : ims.begin()->first);
+      return (ims.empty() ? CommonTime::END_OF_TIME
+              : ims.begin()->first.toCommonTime());
    }
 
 
    gnsstk::CommonTime IonoModelStore::getFinalTime() const
    {
-      return (ims.empty() ? CommonTime::BEGINNING_OF_TIME : ims.rbegin()->first);
+      return (ims.empty() ? CommonTime::BEGINNING_OF_TIME
+              : ims.rbegin()->first.toCommonTime());
    }
 
 
@@ -160,7 +177,8 @@ namespace gnsstk
       IonoModelMap::const_iterator i = ims.begin();
       for ( ; i != ims.end(); ++i, ++n)
       {
-         s << std::setw(3) << n << gnsstk::printTime(i->first, " : %04Y %03j %08.2s  ");
+         s << std::setw(3) << n << gnsstk::printTime(i->first.toCommonTime(),
+                                        " : %04Y %03j %08.2s  ");
          i->second.dump(s);
       }
    }
@@ -47,6 +47,7 @@
 
 #include <map>
 #include "CommonTime.hpp"
+#include "PackedTime.hpp"
 #include "CarrierBand.hpp"
 #include "IonoModel.hpp"
 
@@ -95,7 +96,9 @@ namespace gnsstk
           *
           * @param[in] mt Time the model is valid from
           * @param[in] im IonoModel to add
-          * @return true if the model was added, false otherwise
+          * @return true if the model was added, false otherwise,
+          *   including when the time system of \a mt can't be
+          *   compared with that of the stored models.
           */
       bool addIonoModel(const CommonTime& mt,
                         const IonoModel& im) noexcept;
@@ -144,8 +147,8 @@ namespace gnsstk
 
    private:
 
-
-      typedef std::map<CommonTime, IonoModel> IonoModelMap;
+         /// Keyed by PackedTime, which is much cheaper to compare.
+      typedef std::map<PackedTime, IonoModel> IonoModelMap;
 
       IonoModelMap ims;
 
@@ -43,6 +43,7 @@
 #include <math.h>
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 
 #include "PackedNavBits.hpp"
 #include "GPSWeekSecond.hpp"
@@ -55,11 +56,12 @@ namespace gnsstk
 {
    using namespace std;
    PackedNavBits::PackedNavBits()
-                 : transmitTime(CommonTime::BEGINNING_OF_TIME),
-                   parityStatus(psUnknown),
-                   bits(900),
-                   bits_used(0),
+                 : parityStatus(psUnknown),
                    rxID(""),
+                   transmitTime(CommonTime::BEGINNING_OF_TIME),
+                   words(((900 + 63) >> 6) + 1, 0),
+                   bits_size(900),
+                   bits_used(0),
                    xMitCoerced(false)
    {
       transmitTime.setTimeSystem(TimeSystem::GPS);
@@ -67,10 +69,11 @@ namespace gnsstk
    PackedNavBits::PackedNavBits(const SatID& satSysArg,
                                 const ObsID& obsIDArg,
                                 const CommonTime& transmitTimeArg)
-                                : bits(900),
-                                  parityStatus(psUnknown),
-                                  bits_used(0),
+                                : parityStatus(psUnknown),
                                   rxID(""),
+                                  words(((900 + 63) >> 6) + 1, 0),
+                                  bits_size(900),
+                                  bits_used(0),
                                   xMitCoerced(false)
    {
       satSys = satSysArg;
@@ -83,10 +86,11 @@ namespace gnsstk
                                 const ObsID& obsIDArg,
                                 const std::string rxString,
                                 const CommonTime& transmitTimeArg)
-                                : bits(900),
-                                  parityStatus(psUnknown),
-                                  bits_used(0),
+                                : parityStatus(psUnknown),
                                   rxID(""),
+                                  words(((900 + 63) >> 6) + 1, 0),
+                                  bits_size(900),
+                                  bits_used(0),
                                   xMitCoerced(false)
    {
       satSys = satSysArg;
@@ -101,10 +105,11 @@ namespace gnsstk
                                 const NavID& navIDArg,
                                 const std::string rxString,
                                 const CommonTime& transmitTimeArg)
-                                : bits(900),
-                                  parityStatus(psUnknown),
-                                  bits_used(0),
+                                : parityStatus(psUnknown),
                                   rxID(""),
+                                  words(((900 + 63) >> 6) + 1, 0),
+                                  bits_size(900),
+                                  bits_used(0),
                                   xMitCoerced(false)
    {
       satSys = satSysArg;
@@ -129,10 +134,12 @@ namespace gnsstk
            navID(navIDArg),
            rxID(rxString),
            transmitTime(transmitTimeArg),
-           bits(numBits, fillValue),
+           words(((numBits + 63) >> 6) + 1, fillValue ? ~((uint64_t)0) : 0),
+           bits_size(numBits),
            bits_used(numBits),
            xMitCoerced(false)
    {
+      resizeBits(numBits);
    }
 
 
@@ -145,12 +152,10 @@ namespace gnsstk
       rxID   = right.rxID;
       transmitTime = right.transmitTime;
       bits_used = right.bits_used;
-      bits.resize(bits_used);
+      words = right.words;
+      bits_size = right.bits_size;
+      resizeBits(bits_used);
       parityStatus = right.parityStatus;
-      for (int i=0;i<bits_used;i++)
-      {
-         bits[i] = right.bits[i];
-      }
       xMitCoerced = right.xMitCoerced;
    }
 
@@ -208,7 +213,8 @@ namespace gnsstk
 
    void PackedNavBits::clearBits()
    {
-      bits.clear();
+      words.assign(1, 0);     // no data words, only the guard word
+      bits_size = 0;
       bits_used = 0;
    }
 
@@ -246,20 +252,13 @@ namespace gnsstk
    uint64_t PackedNavBits::asUint64_t(const int startBit,
                                       const int numBits ) const
    {
-      uint64_t temp = 0L;       // Set up a temporary variable with a known size
-                                // It needs to be AT LEAST 33 bits.
       size_t stop = startBit + numBits;
-      if (stop>bits.size())
+      if (stop>bits_size)
       {
          InvalidParameter exc("Requested bits not present.");
          GNSSTK_THROW(exc);
       }
-      for (size_t i=startBit; i<stop; ++i)
-      {
-         temp <<= 1;
-         if (bits[i]) temp++;
-      }
-      return( temp );
+      return extract(startBit, numBits);
    }
 
    unsigned long PackedNavBits::asUnsignedLong(const int startBit,
@@ -605,7 +604,7 @@ namespace gnsstk
 
    bool PackedNavBits::asBool( const unsigned bitNum) const
    {
-      return bits[bitNum];
+      return (words[bitNum >> 6] >> (63 - (bitNum & 63))) & 1;
    }
 
 
@@ -772,34 +771,68 @@ namespace gnsstk
    {
       int old_bits_used = bits_used;
       bits_used += right.bits_used;
-      bits.resize(bits_used);
+      resizeBits(bits_used);
 
-      for (int i=0;i<right.bits_used;i++)
+      for (int i=0;i<right.bits_used;i+=64)
       {
-         bits[i+old_bits_used] = right.bits[i];
+         unsigned num = std::min(64, right.bits_used-i);
+         deposit(old_bits_used+i, num, right.extract(i, num));
       }
    }
 
    void PackedNavBits::addUint64_t( const uint64_t value, const int numBits )
    {
-      size_t ndx = bits_used;
-      uint64_t mask = 0x0000000000000001L;
-      mask <<= (numBits-1);
-
-      for (int i=0; i<numBits; ++i)
+      if (size_t(bits_used + numBits) > bits_size)
       {
-         bits[ndx] = false;
-         if (value & mask)
-         {
-             //set the bits to true
-            bits[ndx] = true;
-         }
-         mask>>= 1;
-         ndx++;
+         resizeBits(bits_used + numBits);
       }
+      deposit(bits_used, numBits, value);
       bits_used += numBits;
    }
 
+   void PackedNavBits::deposit(size_t startBit, unsigned numBits,
+                               uint64_t value)
+   {
+      if (numBits == 0)
+         return;
+      size_t w = startBit >> 6;
+      unsigned off = startBit & 63;
+         // Left-justify the value and the mask of bits being replaced.
+      uint64_t mask = ~((uint64_t)0) << (64 - numBits);
+      value <<= (64 - numBits);
+      words[w] = (words[w] & ~(mask >> off)) | (value >> off);
+      if (off + numBits > 64)
+      {
+            // The field straddles two words (so off > 0).
+         words[w+1] = ((words[w+1] & ~(mask << (64 - off))) |
+                       (value << (64 - off)));
+      }
+   }
+
+   void PackedNavBits::resizeBits(size_t numBits)
+   {
+      size_t dataWords = (numBits + 63) >> 6;
+      words.resize(dataWords + 1, 0);
+      bits_size = numBits;
+         // Clear the unused part of the last data word, and the guard word.
+      unsigned rem = numBits & 63;
+      if (rem != 0)
+      {
+         words[dataWords - 1] &= ~((uint64_t)0) << (64 - rem);
+      }
+      words[dataWords] = 0;
+   }
+
+   std::vector<bool> PackedNavBits::getBits() const
+   {
+      std::vector<bool> rv(bits_size);
+      for (size_t i = 0; i < bits_size; i++)
+      {
+         rv[i] = asBool(i);
+      }
+      return rv;
+   }
+
    //--------------------------------------------------------------------------
    // Used in NavFilter implementations.   This method ASSUMES the meta-date
    // matches have already been done.  It is simply comparing contents of the
@@ -807,9 +840,9 @@ namespace gnsstk
    // in which left has a FALSE whereas right has a TRUE starting at the
    // lowest index and scanning to the maximum index.
    //
-   // NOTE: This is one of the cases in which the PackedNavBits implementation
-   // is probably not the fastest.  Since we are scanning a bit array rather
-   // than testing a series of unsigned ints.
+   // Since the bits are stored MSB first and the unused bits are always
+   // zero, this is the same as comparing the storage words as unsigned
+   // integers.
    bool PackedNavBits::operator<(const PackedNavBits& right) const
    {
          // If the two objects don't have the same number of bits,
@@ -817,22 +850,17 @@ namespace gnsstk
          // happen.  In the context of NavFilter, data SHOULD be
          // from the same system, therefore, the same length should
          // always be true.
-      if (bits.size()!=right.bits.size())
+      if (bits_size!=right.bits_size)
       {
-         if (bits.size()<right.bits.size()) return true;
+         if (bits_size<right.bits_size) return true;
          return false;
       }
 
-      for (int i=0;i<bits.size();i++)
+      for (size_t i=0;i<words.size();i++)
       {
-         if (bits[i]==false && right.bits[i]==true)
-         //if (bits[i]<right.bits[i])
+         if (words[i]!=right.words[i])
          {
-            return true;
-         }
-         if (bits[i]==true && right.bits[i]==false)
-         {
-            return false;
+            return words[i]<right.words[i];
          }
       }
       return false;
@@ -840,20 +868,12 @@ namespace gnsstk
 
    void PackedNavBits::invert( )
    {
-         // Each bit is either 1 or 0.
-         // Starting with 1 and subtracting the
-         // current value will yield the inverse
-         //
-         //  Input    Equation     Result
-         //    1       1 - 1          0
-         //    0       1 - 0          1
-         //
-         // This accomplishes the purpose without incurring
-         // the cost of a conditional statement.
-      for (int i=0;i<bits.size();i++)
+      for (size_t i=0;i<words.size();i++)
       {
-         bits[i] = 1 - bits[i];
+         words[i] = ~words[i];
       }
+         // Restore the zero bits past the end of the data.
+      resizeBits(bits_size);
    }
 
       /**
@@ -877,9 +897,10 @@ namespace gnsstk
       short finalBit = endBit;
       if (finalBit==-1) finalBit = bits_used - 1;
 
-      for (short i=startBit; i<=finalBit; i++)
+      for (int i=startBit; i<=finalBit; i+=64)
       {
-         bits[i] = src.bits[i];
+         unsigned num = std::min(64, finalBit-i+1);
+         deposit(i, num, src.extract(i, num));
       }
    }
 
@@ -909,20 +930,7 @@ namespace gnsstk
          GNSSTK_THROW(exc);
       }
 
-      size_t ndx = startBit;
-      uint64_t mask = 0x0000000000000001L;
-
-      mask <<= (numBits-1);
-      for (int i=0; i<numBits; i++)
-      {
-         bits[ndx] = false;
-         if (out & mask)
-         {
-            bits[ndx] = true;
-         }
-         mask >>= 1;
-         ndx++;
-      }
+      deposit(startBit, numBits, out);
    }
 
 
@@ -937,7 +945,7 @@ namespace gnsstk
    //--------------------------------------------------------------------------
    void PackedNavBits::trimsize()
    {
-      bits.resize(bits_used);
+      resizeBits(bits_used);
    }
 
    //--------------------------------------------------------------------------
@@ -1000,10 +1008,10 @@ namespace gnsstk
       int numBitInWord = 0;
       int word_count   = 0;
       uint32_t word    = 0;
-      for(size_t i = 0; i < bits.size(); ++i)
+      for(size_t i = 0; i < bits_size; ++i)
       {
          word <<= 1;
-         if (bits[i]) word++;
+         if (asBool(i)) word++;
 
          numBitInWord++;
          if (numBitInWord >= 32)
@@ -1039,10 +1047,10 @@ namespace gnsstk
       int bit_count    = 0;
       int word_count   = 0;
       uint32_t word    = 0;
-      for(size_t i = 0; i < bits.size(); ++i)
+      for(size_t i = 0; i < bits_size; ++i)
       {
          word <<= 1;
-         if (bits[i]) word++;
+         if (asBool(i)) word++;
 
          numBitInWord++;
          if (numBitInWord >= numBitsPerWord)
@@ -1056,7 +1064,7 @@ namespace gnsstk
             //but ONLY if there are more bits left to put on the next line.
             if (word_count>0 &&
                 word_count % rollover == 0 &&
-                (i+1) < bits.size()) s << endl;
+                (i+1) < bits_size) s << endl;
          }
       }
          // Need to check if there is a partial word in the buffer
@@ -1066,7 +1074,7 @@ namespace gnsstk
          s << delimiter << " 0x" << setw(8) << setfill('0') << hex << word << dec << setfill(' ');
       }
       s.flags(oldFlags);      // Reset whatever conditions pertained on entry
-      return(bits.size());
+      return(bits_size);
    }
 
    bool PackedNavBits::operator==(const PackedNavBits& right) const
@@ -1119,19 +1127,21 @@ namespace gnsstk
    {
          // If the two objects don't have the same number of bits,
          // don't even try to compare them.
-      if (bits.size()!=right.bits.size()) return false;
+      if (bits_size!=right.bits_size) return false;
+      if (bits_size==0) return true;
 
-      short startBit = startBitA;
-      short endBit = endBitA;
+      int startBit = startBitA;
+      int endBit = endBitA;
          // Check for nonsense arguments
       if (endBit==-1 ||
-          endBit>=int(bits.size())) endBit = bits.size()-1;
+          endBit>=int(bits_size)) endBit = bits_size-1;
       if (startBit<0) startBit=0;
-      if (startBit>=int(bits.size())) startBit = bits.size()-1;
+      if (startBit>=int(bits_size)) startBit = bits_size-1;
 
-      for (int i=startBit;i<=endBit;i++)
+      for (int i=startBit;i<=endBit;i+=64)
       {
-         if (bits[i]!=right.bits[i])
+         unsigned num = std::min(64, endBit-i+1);
+         if (extract(i, num)!=right.extract(i, num))
          {
             return false;
          }
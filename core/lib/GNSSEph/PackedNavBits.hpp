@@ -45,6 +45,7 @@
 #define GNSSTK_PACKEDNAVBITS_HPP
 
 #include <bitset>
+#include <cmath>
 #include <memory>
 #include <vector>
 #include <cstddef>
@@ -56,6 +57,7 @@
 #include "SatID.hpp"
 #include "CommonTime.hpp"
 #include "Exception.hpp"
+#include "GNSSconstants.hpp"
 
 namespace gnsstk
 {
@@ -67,6 +69,32 @@ namespace gnsstk
       /// Managed pointer for passing PackedNavBits around.
    typedef std::shared_ptr<PackedNavBits> PackedNavBitsPtr;
 
+      /** Compile-time description of a contiguous field in a
+       * PackedNavBits object.  Because the position of the field is
+       * known at compile time, the word index and shift counts are
+       * constants and the templated unpacking methods of
+       * PackedNavBits reduce to a couple of loads, shifts and an
+       * or, e.g.
+       * @code
+       * typedef PNBField<240,16> FieldToe;
+       * double toe = pnb.asUnsignedDouble<FieldToe>(4);
+       * @endcode
+       * @param START The 0-indexed first bit of the field.
+       * @param NUM The number of bits in the field (1-64). */
+   template <unsigned START, unsigned NUM>
+   struct PNBField
+   {
+      static_assert(NUM > 0 && NUM <= 64, "PNBField must be 1-64 bits wide");
+         /// The 0-indexed first bit of the field.
+      static const unsigned startBit = START;
+         /// The number of bits in the field.
+      static const unsigned numBits = NUM;
+         /// Index of the storage word holding the field's MSB.
+      static const unsigned word = START >> 6;
+         /// Bit offset of the field's MSB within word.
+      static const unsigned offset = START & 63;
+   };
+
    class PackedNavBits
    {
    public:
@@ -371,6 +399,34 @@ namespace gnsstk
 
       bool asBool( const unsigned bitNum) const;
 
+         /** @defgroup pnbfield Unpack a field described by a PNBField.
+          * These are equivalent to the methods of the same name
+          * taking a start bit and number of bits, but the field
+          * position is resolved at compile time.
+          * @throw InvalidParameter if the field extends past the
+          *   end of the data. */
+         //@{
+      template <class Field>
+      unsigned long asUnsignedLong(const int scale) const
+      { return ((unsigned long)fieldBits<Field>()) * scale; }
+
+      template <class Field>
+      long asLong(const int scale) const
+      { return (long)(fieldSignExtend<Field>() * scale); }
+
+      template <class Field>
+      double asUnsignedDouble(const int power2) const
+      { return std::ldexp((double)fieldBits<Field>(), power2); }
+
+      template <class Field>
+      double asSignedDouble(const int power2) const
+      { return std::ldexp((double)fieldSignExtend<Field>(), power2); }
+
+      template <class Field>
+      double asDoubleSemiCircles(const int power2) const
+      { return asSignedDouble<Field>(power2) * PI; }
+         //@}
+
          /***    PACKING FUNCTIONS *********************************/
          /** Pack an unsigned long integer
           * @throw InvalidParameter
@@ -436,18 +492,23 @@ namespace gnsstk
           */
       void addDataVec(const std::vector<uint8_t>& data, unsigned numBits);
 
-         /** Pack a bitset.  This is done by converting it first to a
-          * string of 0 and 1 characters which are then treated as an
-          * array that is appended to the end of the bits vector.  Not
-          * entirely sure if this is faster than iterating.
+         /** Pack a bitset.  The bits are appended MSB (newbits[N-1])
+          * first, up to 64 at a time.
           * @param[in] newbits The bitset containing the data to
           *   append to the PackedNavBits data. */
       template <size_t N>
       void addBitset(const std::bitset<N>& newbits)
       {
-         std::string binbits(newbits.to_string((char)0,(char)1));
-         bits.insert(bits.end(), &binbits[0], &binbits[binbits.length()]);
-         bits_used += binbits.length();
+         for (size_t i = 0; i < N; i += 64)
+         {
+            unsigned num = (N-i < 64 ? N-i : 64);
+            uint64_t value = 0;
+            for (unsigned j = 0; j < num; j++)
+            {
+               value = (value << 1) | (newbits[N-1-i-j] ? 1 : 0);
+            }
+            addUint64_t(value, num);
+         }
       }
 
          /**
@@ -619,8 +680,13 @@ namespace gnsstk
       void setXmitCoerced(bool tf=true) {xMitCoerced=tf;}
       bool isXmitCoerced() const {return xMitCoerced;}
 
-      const std::vector<bool>& getBits() const
-      { return bits; }
+         /** Get a copy of the packed data, one element per bit.
+          * The storage is word-packed internally, so this is
+          * intended for debugging and tests rather than decoding.
+          * @return a vector the size of the allocated bit storage
+          *   (which may exceed getNumBits() until trimsize() is
+          *   called). */
+      std::vector<bool> getBits() const;
 
          /** Indicate the status of parity/CRC checking.  Must be
           * explicitly set after construction, no parity checking is
@@ -633,7 +699,12 @@ namespace gnsstk
       NavID navID;             /**< Defines the navigation message tracked */
       std::string rxID;        /**< Defines the receiver that collected the data */
       CommonTime transmitTime; /**< Time nav message is transmitted */
-      std::vector<bool> bits;  /**< Holds the packed data */
+         /** Holds the packed data, MSB first within each word.
+          * There is always one word more than needed for bits_size
+          * bits so that a field can be read from two adjacent words
+          * without checking, and all bits past bits_size are zero. */
+      std::vector<uint64_t> words;
+      size_t bits_size;        /**< Number of bits allocated in words */
       int bits_used;
 
       bool xMitCoerced;        /**< Used to indicate that the transmit
@@ -645,6 +716,51 @@ namespace gnsstk
           */
       uint64_t asUint64_t(const int startBit, const int numBits ) const;
 
+         /** Unpack the bits without checking the range.
+          * @pre startBit+numBits <= bits_size, numBits <= 64. */
+      uint64_t extract(size_t startBit, unsigned numBits) const
+      {
+         if (numBits == 0)
+            return 0;
+         size_t w = startBit >> 6;
+         unsigned off = startBit & 63;
+            // The double shift avoids an undefined shift by 64 when
+            // off is zero.
+         uint64_t v = (words[w] << off) | ((words[w+1] >> 1) >> (63 - off));
+         return v >> (64 - numBits);
+      }
+
+         /** Overwrite numBits bits starting at startBit with the
+          * numBits LSBs of value, without checking the range. */
+      void deposit(size_t startBit, unsigned numBits, uint64_t value);
+
+         /** Change the number of bits allocated in words, clearing
+          * any bits past the new size. */
+      void resizeBits(size_t numBits);
+
+         /// Unpack a field described by a PNBField.
+      template <class Field>
+      uint64_t fieldBits() const
+      {
+         if (Field::startBit + Field::numBits > bits_size)
+         {
+            InvalidParameter exc("Requested bits not present.");
+            GNSSTK_THROW(exc);
+         }
+         const uint64_t *w = &words[Field::word];
+         uint64_t v = (w[0] << Field::offset) |
+            ((w[1] >> 1) >> (63 - Field::offset));
+         return v >> (64 - Field::numBits);
+      }
+
+         /// Unpack a two's complement field described by a PNBField.
+      template <class Field>
+      int64_t fieldSignExtend() const
+      {
+         uint64_t u = fieldBits<Field>() << (64 - Field::numBits);
+         return ((int64_t)u) >> (64 - Field::numBits);
+      }
+
          /** Pack the bits */
       void addUint64_t( const uint64_t value, const int numBits );
 
@@ -46,6 +46,7 @@
 #include "Matrix.hpp"
 #include "Position.hpp"
 #include "SolarPosition.hpp"
+#include "StringUtils.hpp"
 #include "SunEarthSatGeometry.hpp"
 
 using namespace std;
@@ -74,6 +75,13 @@ namespace gnsstk
 
          // add the new data
       antennaMap[name] = antdata;
+
+         // recompile it if a handle has been issued
+      map<string, int>::const_iterator jt = compiledIndex.find(name);
+      if (jt != compiledIndex.end())
+      {
+         compiled[jt->second] = CompiledAntenna(antdata);
+      }
    }
 
       /* Get the antenna data for the given name from the store.
@@ -197,7 +205,92 @@ namespace gnsstk
          }
       }
       for (j = 0; j < rejects.size(); j++)
+      {
          antennaMap.erase(rejects[j]);
+         compiledIndex.erase(rejects[j]);
+      }
+   }
+
+      // Get a handle to the compiled antenna with the given name, compiling it
+      // on the first call; return -1 if the name is not in the store.
+   int AntennaStore::getAntennaHandle(const string& name)
+   {
+      map<string, int>::const_iterator jt = compiledIndex.find(name);
+      if (jt != compiledIndex.end())
+      {
+         return jt->second;
+      }
+
+      map<string, AntexData>::const_iterator it = antennaMap.find(name);
+      if (it == antennaMap.end())
+      {
+         return -1;
+      }
+      compiled.push_back(CompiledAntenna(it->second));
+      int handle = int(compiled.size()) - 1;
+      compiledIndex[name] = handle;
+      return handle;
+   }
+
+      // Get a handle to the compiled antenna for the given satellite; return
+      // -1 if the satellite is not in the store.
+   int AntennaStore::getSatelliteAntennaHandle(const char sys, const int n,
+                                               bool inputPRN)
+   {
+      map<string, AntexData>::const_iterator it;
+      for (it = antennaMap.begin(); it != antennaMap.end(); it++)
+      {
+         if (it->second.isRxAntenna || it->second.systemChar != sys)
+         {
+            continue;
+         }
+         if ((inputPRN && it->second.PRN == n) ||
+             (!inputPRN && it->second.SVN == n))
+         {
+            return getAntennaHandle(it->first);
+         }
+      }
+      return -1;
+   }
+
+      // Get the compiled antenna for a handle; throw if it is invalid.
+   const CompiledAntenna& AntennaStore::getCompiledAntenna(int handle) const
+   {
+      if (handle < 0 || handle >= int(compiled.size()))
+      {
+         Exception e("Invalid antenna handle " +
+                     StringUtils::asString(handle));
+         GNSSTK_THROW(e);
+      }
+      return compiled[handle];
+   }
+
+      // Compute the PCVs of many (antenna, frequency, azimuth, elev/nadir).
+   void AntennaStore::getPhaseCenterVariations(
+      const vector<int>& handles, const vector<int>& freqCodes,
+      const vector<double>& azimuth, const vector<double>& elev_nadir,
+      vector<double>& pcv) const
+   {
+      try
+      {
+         if (freqCodes.size() != handles.size() ||
+             azimuth.size() != handles.size() ||
+             elev_nadir.size() != handles.size())
+         {
+            Exception e("Input lengths differ");
+            GNSSTK_THROW(e);
+         }
+         pcv.resize(handles.size());
+         for (size_t i = 0; i < handles.size(); i++)
+         {
+            pcv[i] = getCompiledAntenna(handles[i]).getPhaseCenterVariation(
+               freqCodes[i], azimuth[i], elev_nadir[i]);
+         }
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
    }
 
       /* Open and read an ANTEX format file with the given name, and read it.
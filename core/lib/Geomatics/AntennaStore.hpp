@@ -55,6 +55,7 @@
 #include "AntexHeader.hpp"
 #include "AntexStream.hpp"
 #include "CommonTime.hpp"
+#include "CompiledAntenna.hpp"
 #include "SatID.hpp"
 #include "Triple.hpp"
 
@@ -146,7 +147,65 @@ namespace gnsstk
       unsigned int size() const { return antennaMap.size(); }
 
       /// clear the store of all information
-      void clear() { antennaMap.clear(); }
+      void clear()
+      {
+         antennaMap.clear();
+         compiled.clear();
+         compiledIndex.clear();
+      }
+
+         /**
+          Get an integer handle to the compiled form (CompiledAntenna) of the
+          antenna with the given name, compiling it on the first call. Handles
+          remain valid, and are not reused, until clear() is called; if the
+          antenna is replaced by addAntenna() the handle refers to the new
+          data. Get handles once, outside the processing loop, and use
+          getCompiledAntenna() or getPhaseCenterVariations() within it.
+          @param name  Antenna (ANTEX) name
+          @return the handle, or -1 if the name was not found in the store
+         */
+      int getAntennaHandle(const std::string& name);
+
+         /**
+          Get an integer handle to the compiled antenna for the given
+          satellite; cf. getSatelliteAntenna() and getAntennaHandle().
+          @param sys  System character for the satellite: G,R,E or M
+          @param n  PRN (or SVN) of the satellite
+          @param inputPRN  If false, parameter n is SVN not PRN (default true).
+          @return the handle, or -1 if the satellite was not found in the store
+         */
+      int getSatelliteAntennaHandle(const char sys, const int n,
+                                    bool inputPRN = true);
+
+         /**
+          Get the compiled antenna for a handle from getAntennaHandle().
+          @throw Exception if the handle is invalid
+         */
+      const CompiledAntenna& getCompiledAntenna(int handle) const;
+
+         /**
+          Compute the phase center variations (mm) of many antennas at once,
+          e.g. of all the satellites in view at one epoch, with the nadir
+          angle of each toward the receiver; cf.
+          CompiledAntenna::getPhaseCenterVariation(). All inputs are
+          parallel.
+          @param handles  antenna handles, from getAntennaHandle() or
+                          getSatelliteAntennaHandle()
+          @param freqCodes  frequency codes, from
+                            CompiledAntenna::frequencyCode()
+          @param azimuth  azimuth angles in degrees
+          @param elev_nadir  elevation (receivers) or nadir (satellites)
+                             angles in degrees
+          @param pcv  output PCVs, resized to match handles
+          @throw Exception if the inputs differ in length, a handle is
+          invalid, a frequency does not exist for its antenna, or an angle is
+          out of range.
+         */
+      void getPhaseCenterVariations(const std::vector<int>& handles,
+                                    const std::vector<int>& freqCodes,
+                                    const std::vector<double>& azimuth,
+                                    const std::vector<double>& elev_nadir,
+                                    std::vector<double>& pcv) const;
 
          /**
           call to have satellite antennas included in store
@@ -231,6 +290,12 @@ namespace gnsstk
       /// map from name of antenna to AntexData object
       std::map<std::string, AntexData> antennaMap;
 
+      /// compiled antennas, indexed by handle
+      std::vector<CompiledAntenna> compiled;
+
+      /// map from name of antenna to handle in compiled
+      std::map<std::string, int> compiledIndex;
+
    }; // end class AntennaStore
 
 } // namespace gnsstk
@@ -0,0 +1,436 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file BatchTides.cpp
+    class gnsstk::BatchTides computes the site displacements due to solid
+    Earth tides, ocean loading and the pole tide for many sites at many
+    epochs, computing the quantities shared by all sites once per epoch. */
+
+//------------------------------------------------------------------------------------
+#include "BatchTides.hpp"
+// system
+#include <cmath>
+#include <thread>
+// GNSSTk
+#include "GNSSconstants.hpp"
+#include "SolidEarthTidesData.hpp"
+#include "ThreadGroup.hpp"
+
+//------------------------------------------------------------------------------------
+using namespace std;
+
+namespace gnsstk
+{
+   using SolidEarthTidesData::REarth;
+   using SolidEarthTidesData::step2diurnalData;
+   using SolidEarthTidesData::step2longData;
+
+   //---------------------------------------------------------------------------------
+   BatchTides::BatchTides(const IERSConvention& conv, double emrat,
+                          double serat, unsigned nThreads)
+         : doSolid(true), doOcean(true), doPolar(true), iers(conv),
+           EMRAT(emrat), SERAT(serat), numThreads(nThreads), oceanStore(0)
+   {
+      if (numThreads == 0)
+         numThreads = thread::hardware_concurrency();
+      if (numThreads == 0)
+         numThreads = 1;
+   }
+
+   //---------------------------------------------------------------------------------
+   void BatchTides::setOceanLoadTides(const OceanLoadTides *olt)
+   {
+      oceanStore = olt;
+         // handles from another object are meaningless
+      for (size_t i = 0; i < sites.size(); i++)
+         sites[i].ocean = -1;
+   }
+
+   //---------------------------------------------------------------------------------
+   int BatchTides::addSite(const Position& site, const string& oceanSite)
+   {
+      try
+      {
+         Site s;
+
+         s.ocean = -1;
+         if (!oceanSite.empty())
+         {
+            if (!oceanStore)
+            {
+               Exception e("No ocean loading coefficients for site " +
+                           oceanSite);
+               GNSSTK_THROW(e);
+            }
+            s.ocean = oceanStore->siteHandle(oceanSite);
+         }
+
+            // radial unit vector
+         double Rx(site.radius());
+         s.rx[0] = site.X() / Rx;
+         s.rx[1] = site.Y() / Rx;
+         s.rx[2] = site.Z() / Rx;
+
+            // geocentric latitude and longitude, as in computeSolidEarthTides()
+         double lat(site.getGeocentricLatitude() * DEG_TO_RAD);
+         double lon(site.getLongitude() * DEG_TO_RAD);
+         s.sinlat  = ::sin(lat);
+         s.coslat  = ::cos(lat);
+         s.sinlon  = ::sin(lon);
+         s.coslon  = ::cos(lon);
+         s.sin2lat = ::sin(2 * lat);
+         s.cos2lat = ::cos(2 * lat);
+
+            // transform X=(x,y,z) into (R*X)(north,east,up)
+         s.north[0] = -s.sinlat * s.coslon;
+         s.north[1] = -s.sinlat * s.sinlon;
+         s.north[2] = s.coslat;
+         s.east[0]  = -s.sinlon;
+         s.east[1]  = s.coslon;
+         s.east[2]  = 0.0;
+         s.up[0]    = s.coslat * s.coslon;
+         s.up[1]    = s.coslat * s.sinlon;
+         s.up[2]    = s.sinlat;
+
+            // nominal degree 2 Love and Shida numbers, IERS(1996) pg 60
+         SolidEarthTidesData::nominalLoveShida(s.sinlat, iers, s.Love,
+                                               s.Shida);
+
+            // colatitude, as in computePolarTides()
+         double theta((90.0 - site.getGeocentricLatitude()) * DEG_TO_RAD);
+         s.cos2theta = ::cos(2 * theta);
+         s.costheta  = ::cos(theta);
+         s.sin2theta = ::sin(2 * theta);
+
+            // geodetic north, east and up, for ocean loading
+         lat = site.getGeodeticLatitude() * DEG_TO_RAD;
+         double sa(::sin(lat)), ca(::cos(lat));
+         double so(::sin(lon)), co(::cos(lon));
+         s.northGD[0] = -sa * co;
+         s.northGD[1] = -sa * so;
+         s.northGD[2] = ca;
+         s.eastGD[0]  = -so;
+         s.eastGD[1]  = co;
+         s.eastGD[2]  = 0.0;
+         s.upGD[0]    = ca * co;
+         s.upGD[1]    = ca * so;
+         s.upGD[2]    = sa;
+
+         sites.push_back(s);
+         return int(sites.size()) - 1;
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   BatchTides::EpochState BatchTides::epochState(const EphTime& ttag,
+                                                 const Position& Sun,
+                                                 const Position& Moon,
+                                                 double xp, double yp) const
+   {
+      try
+      {
+         int i;
+         EpochState st;
+         st.time = ttag;
+
+            // Sun and Moon; cf. computeSolidEarthTides()
+         double RSun(Sun.radius()), RMoon(Moon.radius());
+         st.sunUnit[0]  = Sun.X() / RSun;
+         st.sunUnit[1]  = Sun.Y() / RSun;
+         st.sunUnit[2]  = Sun.Z() / RSun;
+         st.moonUnit[0] = Moon.X() / RMoon;
+         st.moonUnit[1] = Moon.Y() / RMoon;
+         st.moonUnit[2] = Moon.Z() / RMoon;
+
+         st.REoRS      = REarth / RSun;
+         st.sunFactor  = REarth * st.REoRS * st.REoRS * st.REoRS * SERAT;
+         st.REoRM      = REarth / RMoon;
+         st.moonFactor = REarth * st.REoRM * st.REoRM * st.REoRM / EMRAT;
+
+            // The latitude dependent terms (steps 1c-1f) involve
+            // sin(lon-lonSun) etc.; expand those so that the parts that
+            // depend on the Sun and Moon are summed here, once.
+         double latSun(Sun.getGeocentricLatitude() * DEG_TO_RAD);
+         double lonSun(Sun.getLongitude() * DEG_TO_RAD);
+         double latMoon(Moon.getGeocentricLatitude() * DEG_TO_RAD);
+         double lonMoon(Moon.getLongitude() * DEG_TO_RAD);
+         double fs, fm;
+
+         fs = st.sunFactor * ::sin(2 * latSun);
+         fm = st.moonFactor * ::sin(2 * latMoon);
+         st.diurnal[0] = fs * ::cos(lonSun) + fm * ::cos(lonMoon);
+         st.diurnal[1] = fs * ::sin(lonSun) + fm * ::sin(lonMoon);
+
+         fs = st.sunFactor * ::cos(latSun) * ::cos(latSun);
+         fm = st.moonFactor * ::cos(latMoon) * ::cos(latMoon);
+         st.semiDiurnal[0] = fs * ::cos(2 * lonSun) + fm * ::cos(2 * lonMoon);
+         st.semiDiurnal[1] = fs * ::sin(2 * lonSun) + fm * ::sin(2 * lonMoon);
+
+         fs = st.sunFactor * ::cos(latSun) * ::sin(latSun);
+         fm = st.moonFactor * ::cos(latMoon) * ::sin(latMoon);
+         st.latDiurnal[0] = fs * ::cos(lonSun) + fm * ::cos(lonMoon);
+         st.latDiurnal[1] = fs * ::sin(lonSun) + fm * ::sin(lonMoon);
+
+            // compute standard arguments
+         double s, tau, h, p, zns, ps;
+         SolidEarthTidesData::tideArguments(ttag, tau, s, h, p, zns, ps);
+
+            // Step 2a: the corrections depend on cos,sin(thetaf+lon); expand
+            // those and sum over the table here, leaving only lon to the site.
+         double thetaf, ctf, stf;
+         const double *d;
+         for (i = 0; i < 4; i++)
+            st.step2Diurnal[i] = 0.0;
+         for (i = 0; i < 31; i++)
+         {
+            d = &step2diurnalData[9 * i];
+            thetaf = (tau + d[0] * s + d[1] * h + d[2] * p + d[3] * zns +
+                      d[4] * ps) *
+                     DEG_TO_RAD;
+            ctf = ::cos(thetaf);
+            stf = ::sin(thetaf);
+            st.step2Diurnal[0] += d[5] * stf + d[6] * ctf;
+            st.step2Diurnal[1] += d[5] * ctf - d[6] * stf;
+            st.step2Diurnal[2] += d[7] * stf + d[8] * ctf;
+            st.step2Diurnal[3] += d[7] * ctf - d[8] * stf;
+         }
+
+            // Step 2b: independent of the site but for the latitude factors
+         st.step2Long[0] = st.step2Long[1] = 0.0;
+         for (i = 0; i < 5; i++)
+         {
+            d = &step2longData[9 * i];
+            thetaf = (d[0] * s + d[1] * h + d[2] * p + d[3] * zns + d[4] * ps) *
+                     DEG_TO_RAD;
+            ctf = ::cos(thetaf);
+            stf = ::sin(thetaf);
+            st.step2Long[0] += d[5] * ctf + d[7] * stf;
+            st.step2Long[1] += d[6] * ctf + d[8] * stf;
+         }
+
+            // pole tide wobble; cf. computePolarTides()
+         SolidEarthTidesData::poleWobble(ttag, xp, yp, iers, st.m1, st.m2,
+                                         st.upcoef);
+
+            // ocean loading
+         st.ocean = OceanLoadTides::epochArguments(ttag);
+
+         return st;
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   void BatchTides::accumulate(const EpochState& st, const Site& S, bool solid,
+                               bool ocean, bool polar, double disp[3]) const
+   {
+      int i;
+
+      if (solid)
+      {
+         double sunDOTrx(0.0), moonDOTrx(0.0);
+         for (i = 0; i < 3; i++)
+         {
+            sunDOTrx += st.sunUnit[i] * S.rx[i];
+            moonDOTrx += st.moonUnit[i] * S.rx[i];
+         }
+
+            // Steps 1a and 1b, IERS(1996) eqs. (8) and (9) pg 61, as
+            // coefficients of rx, the Sun and the Moon; the transverse
+            // vectors tSun = sunUnit - sunDOTrx*rx etc. are expanded.
+         using SolidEarthTidesData::Love3;
+         using SolidEarthTidesData::Shida3;
+         double ds2(sunDOTrx * sunDOTrx), dm2(moonDOTrx * moonDOTrx);
+         double fs3(st.sunFactor * st.REoRS), fm3(st.moonFactor * st.REoRM);
+         double cSun = st.sunFactor * 3.0 * S.Shida * sunDOTrx +
+                       fs3 * Shida3 * (7.5 * ds2 - 1.5);
+         double cMoon = st.moonFactor * 3.0 * S.Shida * moonDOTrx +
+                        fm3 * Shida3 * (7.5 * dm2 - 1.5);
+         double cR = st.sunFactor * S.Love * (1.5 * ds2 - 0.5) +
+                     st.moonFactor * S.Love * (1.5 * dm2 - 0.5) +
+                     fs3 * Love3 * (2.5 * ds2 - 1.5) * sunDOTrx +
+                     fm3 * Love3 * (2.5 * dm2 - 1.5) * moonDOTrx -
+                     cSun * sunDOTrx - cMoon * moonDOTrx;
+
+            // Steps 1c-1f, IERS(1996) eqs. (11)-(14) pg 62-63; the sums over
+            // the Sun and Moon of e.g. factor*sin(2lat)*sin(lon-lonSun)
+         double sin2lon(2.0 * S.sinlon * S.coslon);
+         double cos2lon(S.coslon * S.coslon - S.sinlon * S.sinlon);
+         double A = S.sinlon * st.diurnal[0] - S.coslon * st.diurnal[1];
+         double B = S.coslon * st.diurnal[0] + S.sinlon * st.diurnal[1];
+         double C = sin2lon * st.semiDiurnal[0] - cos2lon * st.semiDiurnal[1];
+         double D = cos2lon * st.semiDiurnal[0] + sin2lon * st.semiDiurnal[1];
+         double E = S.coslon * st.latDiurnal[0] + S.sinlon * st.latDiurnal[1];
+         double G = S.sinlon * st.latDiurnal[0] - S.coslon * st.latDiurnal[1];
+         double sl2(S.sinlat * S.sinlat), cl2(S.coslat * S.coslat);
+
+         cR += -0.75 * (-0.0025) * S.sin2lat * A          // 1c radial
+               - 0.75 * (-0.0022) * cl2 * C;              // 1d radial
+         double cN = -1.5 * (-0.0007) * S.cos2lat * A     // 1c north
+                     + 0.75 * (-0.0007) * S.sin2lat * C   // 1d north
+                     - 3.0 * 0.0012 * sl2 * E             // 1e
+                     - 1.5 * 0.0024 * S.sinlat * S.coslat * D; // 1f
+         double cE = -1.5 * (-0.0007) * S.sinlat * B      // 1c east
+                     - 1.50 * (-0.0007) * S.coslat * D    // 1d east
+                     + 3.0 * 0.0012 * S.sinlat * S.cos2lat * G // 1e
+                     - 1.5 * 0.0024 * sl2 * S.coslat * C; // 1f
+
+            // Step 2, IERS(1996) eqs. (15) and (16) pg 63-64, mm -> m
+         double cU = (2 * S.sinlat * S.coslat *
+                         (S.coslon * st.step2Diurnal[0] +
+                          S.sinlon * st.step2Diurnal[1]) +
+                      st.step2Long[0] * (3 * sl2 - 1) / 2) /
+                     1000.0;
+         cN += ((cl2 - sl2) * (S.coslon * st.step2Diurnal[2] +
+                               S.sinlon * st.step2Diurnal[3]) +
+                st.step2Long[1] * 2 * S.sinlat * S.coslat) /
+               1000.0;
+         cE += S.sinlat *
+               (S.coslon * st.step2Diurnal[3] - S.sinlon * st.step2Diurnal[2]) /
+               1000.0;
+
+         for (i = 0; i < 3; i++)
+         {
+            disp[i] += cR * S.rx[i] + cSun * st.sunUnit[i] +
+                       cMoon * st.moonUnit[i] + cN * S.north[i] +
+                       cE * S.east[i] + cU * S.up[i];
+         }
+      }
+
+      if (polar)
+      {
+            // NEU components, cf. computePolarTides()
+         double dn, de, du;
+         dn = 0.009 * S.cos2theta * (st.m1 * S.coslon + st.m2 * S.sinlon);
+         de = 0.009 * S.costheta * (st.m1 * S.sinlon - st.m2 * S.coslon);
+         du = -st.upcoef * S.sin2theta * (st.m1 * S.coslon + st.m2 * S.sinlon);
+         for (i = 0; i < 3; i++)
+            disp[i] += dn * S.north[i] + de * S.east[i] + du * S.up[i];
+      }
+
+      if (ocean && S.ocean >= 0 && oceanStore)
+      {
+         Triple neu(oceanStore->computeDisplacement(S.ocean, st.ocean));
+         for (i = 0; i < 3; i++)
+         {
+            disp[i] += neu[0] * S.northGD[i] + neu[1] * S.eastGD[i] +
+                       neu[2] * S.upGD[i];
+         }
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   void BatchTides::compute(const EpochState& state, vector<Triple>& disp) const
+   {
+      try
+      {
+         disp.resize(sites.size());
+         double d[3];
+         for (size_t j = 0; j < sites.size(); j++)
+         {
+            d[0] = d[1] = d[2] = 0.0;
+            accumulate(state, sites[j], doSolid, doOcean, doPolar, d);
+            disp[j] = Triple(d[0], d[1], d[2]);
+         }
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   void BatchTides::compute(const vector<EpochState>& states,
+                            vector<vector<Triple>>& disp) const
+   {
+      try
+      {
+         disp.resize(states.size());
+         parallelFor(states.size(), numThreads,
+                     [&](size_t i, unsigned) { compute(states[i], disp[i]); });
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+      catch (std::exception& exc)
+      {
+         Exception e(exc.what());
+         GNSSTK_THROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   Triple BatchTides::solidTide(const EpochState& state, int handle) const
+   {
+      double d[3] = {0.0, 0.0, 0.0};
+      accumulate(state, sites.at(handle), true, false, false, d);
+      return Triple(d[0], d[1], d[2]);
+   }
+
+   //---------------------------------------------------------------------------------
+   Triple BatchTides::polarTide(const EpochState& state, int handle) const
+   {
+      double d[3] = {0.0, 0.0, 0.0};
+      accumulate(state, sites.at(handle), false, false, true, d);
+      return Triple(d[0], d[1], d[2]);
+   }
+
+   //---------------------------------------------------------------------------------
+   Triple BatchTides::oceanLoad(const EpochState& state, int handle) const
+   {
+      try
+      {
+         double d[3] = {0.0, 0.0, 0.0};
+         accumulate(state, sites.at(handle), false, true, false, d);
+         return Triple(d[0], d[1], d[2]);
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+} // end namespace gnsstk
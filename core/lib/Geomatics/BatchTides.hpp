@@ -0,0 +1,307 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file BatchTides.hpp
+    class gnsstk::BatchTides computes the site displacements due to solid
+    Earth tides, ocean loading and the pole tide for many sites at many
+    epochs, computing the quantities shared by all sites once per epoch. */
+
+#ifndef CLASS_BATCHTIDES_INCLUDE
+#define CLASS_BATCHTIDES_INCLUDE
+
+//------------------------------------------------------------------------------------
+// system includes
+#include <vector>
+// GNSSTk
+#include "Exception.hpp"
+#include "Position.hpp"
+#include "Triple.hpp"
+// geomatics
+#include "EphTime.hpp"
+#include "IERSConvention.hpp"
+#include "OceanLoadTides.hpp"
+
+//------------------------------------------------------------------------------------
+namespace gnsstk
+{
+
+      /**
+       class BatchTides computes the same site displacements as
+       computeSolidEarthTides(), computePolarTides() and
+       OceanLoadTides::computeDisplacement(), for a network of sites at many
+       epochs, e.g. 500 stations at 30 second intervals.
+
+       The single-site functions recompute at every call everything that
+       depends only on time: the geometry of the Sun and Moon, the
+       astronomical arguments of the frequency dependent corrections, the
+       mean pole and the Doodson arguments of ocean loading. Here those are
+       computed once per epoch, by epochState(), and the terms of each site
+       that depend only on its position are computed once, by addSite(). The
+       solid Earth and pole tides of a site at an epoch then need no
+       trigonometric functions at all; the sums over the 31 diurnal and 5 long
+       period corrections of the solid tide, in particular, reduce to a few
+       products. Ocean loading still derives the 342 tides at each site and
+       epoch, but uses the shared arguments and a site handle, with no look up
+       by name.
+
+       Sites are identified by handles, the integer returned by addSite(),
+       which are the indexes of the sites in the output of compute().
+       Displacements are ECEF XYZ in meters, and agree with the single-site
+       functions to rounding error; the ocean loading displacement, which
+       OceanLoadTides returns as North-East-Up, is rotated to ECEF using the
+       geodetic latitude and longitude of the site.
+
+       compute() evaluates all the sites at one epoch; the overload taking a
+       vector of epochs distributes the epochs over several threads. The
+       states of the epochs may be computed in any thread, since epochState()
+       is const, but the positions of the Sun and Moon come from the caller,
+       typically SolarSystem, which is not thread safe.
+
+       @code
+       BatchTides tides(IERSConvention::IERS2010);
+       tides.setOceanLoadTides(&oceanStore);
+       for(i=0; i<positions.size(); i++)
+          tides.addSite(positions[i], oceanNames[i]);
+       vector<BatchTides::EpochState> states;
+       for(i=0; i<times.size(); i++)
+          states.push_back(tides.epochState(times[i],
+                                            SolSys.solarPosition(times[i]),
+                                            SolSys.lunarPosition(times[i]),
+                                            xp[i], yp[i]));
+       vector< vector<Triple> > disp;      // disp[epoch][site]
+       tides.compute(states, disp);
+       @endcode
+      */
+   class BatchTides
+   {
+   public:
+         /**
+          Quantities shared by all sites at one epoch, computed by
+          epochState().
+         */
+      struct EpochState
+      {
+            /// time of the state
+         EphTime time;
+            /// unit vectors (ECEF) toward the Sun and Moon
+         double sunUnit[3], moonUnit[3];
+            /// (GM/GME)*RE^4/R^3 of the Sun and Moon, m
+         double sunFactor, moonFactor;
+            /// ratio of the Earth radius to the distance of the Sun, Moon
+         double REoRS, REoRM;
+            /// sum over Sun and Moon of factor*sin(2lat)*(cos,sin)(lon)
+         double diurnal[2];
+            /// sum over Sun and Moon of factor*cos^2(lat)*(cos,sin)(2lon)
+         double semiDiurnal[2];
+            /// sum over Sun and Moon of factor*cos(lat)*sin(lat)*(cos,sin)(lon)
+         double latDiurnal[2];
+            /// sums over the diurnal band corrections (step 2a), mm
+         double step2Diurnal[4];
+            /// sums over the long period band corrections (step 2b), mm
+         double step2Long[2];
+            /// pole tide: wobble m1, m2 (arcsec) and coefficient of Up
+         double m1, m2, upcoef;
+            /// Doodson arguments for ocean loading
+         OceanLoadTides::EpochArguments ocean;
+      };
+
+         /**
+          Constructor.
+          @param iers IERS convention to use
+          @param EMRAT Earth-to-Moon mass ratio (default to DE405 value)
+          @param SERAT Sun-to-Earth mass ratio (default to DE405 value)
+          @param numThreads number of worker threads used by
+                      compute(const std::vector<EpochState>&, ...); if 0, use
+                      std::thread::hardware_concurrency().
+         */
+      BatchTides(const IERSConvention& iers = IERSConvention::IERS2010,
+                 double EMRAT = 81.30056,
+                 double SERAT = 332946.050894783285912,
+                 unsigned numThreads = 0);
+
+         /**
+          Set the source of ocean loading coefficients; ocean loading is
+          computed only for sites that are given an ocean loading site name
+          in addSite(), so call this first. Changing it removes the ocean
+          loading of the sites already added. The object is not copied, and
+          must not be destroyed while this object uses it.
+          @param olt initialized OceanLoadTides, or null for no ocean loading.
+         */
+      void setOceanLoadTides(const OceanLoadTides *olt);
+
+         /**
+          Add a site to the network.
+          @param site nominal position of the site, fixed to the solid Earth.
+          @param oceanSite name of the site in the ocean loading object set
+                 by setOceanLoadTides(); if empty, ocean loading is not
+                 computed for this site.
+          @return handle of the site, its index in the output of compute().
+          @throw Exception if oceanSite is not empty and either no ocean
+                 loading object has been set or the site is not initialized
+                 in it.
+         */
+      int addSite(const Position& site,
+                  const std::string& oceanSite = std::string());
+
+         /// Return the number of sites.
+      size_t size() const { return sites.size(); }
+
+         /// Remove all the sites.
+      void clear() { sites.clear(); }
+
+         /**
+          Compute the quantities shared by all sites at the given time.
+          @param ttag time of interest; its system must not be Unknown.
+          @param Sun position of the Sun at time (cf. SolarSystem)
+          @param Moon position of the Moon at time
+          @param xp,yp polar motion angles at time in arcsec
+                 (cf. EarthOrientation)
+          @return the state at time
+          @throw Exception if the time system conversion fails.
+         */
+      EpochState epochState(const EphTime& ttag, const Position& Sun,
+                            const Position& Moon, double xp, double yp) const;
+
+         /**
+          Compute the total displacement, solid Earth tide plus ocean loading
+          plus pole tide, of every site at one epoch.
+          @param state state at the time of interest, from epochState().
+          @param disp output, displacements indexed by site handle, ECEF XYZ
+                 in meters.
+          @throw Exception if the ocean loading computation fails.
+         */
+      void compute(const EpochState& state, std::vector<Triple>& disp) const;
+
+         /**
+          Compute the total displacement of every site at many epochs,
+          distributing the epochs over the worker threads.
+          @param states states at the times of interest.
+          @param disp output, disp[i][j] is the displacement (ECEF XYZ, m) of
+                 site j at states[i].
+          @throw Exception if any computation throws; the first such exception
+                 is rethrown after all the threads have finished.
+         */
+      void compute(const std::vector<EpochState>& states,
+                   std::vector<std::vector<Triple>>& disp) const;
+
+         /**
+          Compute the solid Earth tide displacement of one site, as
+          computeSolidEarthTides().
+          @param state state at the time of interest.
+          @param handle handle of the site.
+          @return displacement, ECEF XYZ in meters.
+         */
+      Triple solidTide(const EpochState& state, int handle) const;
+
+         /**
+          Compute the pole tide displacement of one site, as
+          computePolarTides().
+          @param state state at the time of interest.
+          @param handle handle of the site.
+          @return displacement, ECEF XYZ in meters.
+         */
+      Triple polarTide(const EpochState& state, int handle) const;
+
+         /**
+          Compute the ocean loading displacement of one site, as
+          OceanLoadTides::computeDisplacement() but rotated to ECEF.
+          @param state state at the time of interest.
+          @param handle handle of the site.
+          @return displacement, ECEF XYZ in meters; zero if the site has no
+                  ocean loading.
+          @throw Exception if the ocean loading computation fails.
+         */
+      Triple oceanLoad(const EpochState& state, int handle) const;
+
+         /// Return the IERS convention.
+      IERSConvention getConvention() const { return iers; }
+
+         /// Return the number of worker threads.
+      unsigned getNumThreads() const { return numThreads; }
+
+         /// if false, omit the solid Earth tide from compute() (default true)
+      bool doSolid;
+
+         /// if false, omit ocean loading from compute() (default true)
+      bool doOcean;
+
+         /// if false, omit the pole tide from compute() (default true)
+      bool doPolar;
+
+   private:
+         /// Terms that depend only on the position of a site.
+      struct Site
+      {
+            /// unit vectors (ECEF) radial, and geocentric north, east and up
+         double rx[3], north[3], east[3], up[3];
+            /// trig functions of geocentric latitude and longitude
+         double sinlat, coslat, sinlon, coslon, sin2lat, cos2lat;
+            /// nominal degree 2 Love and Shida numbers at the latitude
+         double Love, Shida;
+            /// trig functions of the geocentric colatitude for the pole tide
+         double cos2theta, costheta, sin2theta;
+            /// geodetic north, east and up unit vectors for ocean loading
+         double northGD[3], eastGD[3], upGD[3];
+            /// handle of the site in oceanStore, or -1 for none
+         int ocean;
+      };
+
+         /// Add the displacements of site s at state to disp.
+      void accumulate(const EpochState& state, const Site& s, bool solid,
+                      bool ocean, bool polar, double disp[3]) const;
+
+         /// IERS convention
+      IERSConvention iers;
+
+         /// Earth-to-Moon and Sun-to-Earth mass ratios
+      double EMRAT, SERAT;
+
+         /// number of worker threads
+      unsigned numThreads;
+
+         /// ocean loading coefficients, not owned; may be null
+      const OceanLoadTides *oceanStore;
+
+         /// all the sites, indexed by handle
+      std::vector<Site> sites;
+
+   }; // end class BatchTides
+
+} // end namespace gnsstk
+
+#endif // CLASS_BATCHTIDES_INCLUDE
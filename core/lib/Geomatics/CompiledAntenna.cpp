@@ -0,0 +1,329 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file CompiledAntenna.cpp
+ * Phase center offsets and variations of one antenna, compiled from an
+ * AntexData object into dense grids for fast repeated evaluation. */
+
+#include "CompiledAntenna.hpp"
+#include <cmath>
+#include "GNSSconstants.hpp"
+#include "StringUtils.hpp"
+
+using namespace std;
+
+namespace gnsstk
+{
+      // ----------------------------------------------------------------------------
+   int CompiledAntenna::frequencyCode(const string& freq)
+   {
+         // system characters in the order of the codes
+      static const string systems("GRECJSI");
+      if (freq.size() < 2)
+      {
+         return -1;
+      }
+      size_t sys = systems.find(freq[0] == ' ' ? 'G' : freq[0]);
+      if (sys == string::npos)
+      {
+         return -1;
+      }
+      int n = 0;
+      for (size_t i = 1; i < freq.size(); i++)
+      {
+         if (freq[i] < '0' || freq[i] > '9')
+         {
+            return -1;
+         }
+         n = 10 * n + (freq[i] - '0');
+         if (n > 15)
+         {
+            return -1;
+         }
+      }
+      return int(sys) * 16 + n;
+   }
+
+      // ----------------------------------------------------------------------------
+   CompiledAntenna::CompiledAntenna()
+         : isRx(true), dAzim(360.0), zen0(0.0), dZen(1.0), nAzim(1), nZen(2)
+   {
+      for (int i = 0; i < NUM_FREQ_CODES; i++)
+         slot[i] = -1;
+   }
+
+      // ----------------------------------------------------------------------------
+   CompiledAntenna::CompiledAntenna(const AntexData& ant)
+         : CompiledAntenna()
+   {
+      if (!ant.isValid())
+      {
+         Exception e("Invalid AntexData object");
+         GNSSTK_THROW(e);
+      }
+      if (ant.zenRange[2] <= 0.0 || ant.zenRange[1] < ant.zenRange[0])
+      {
+         Exception e("Empty zenith grid for antenna " + ant.name());
+         GNSSTK_THROW(e);
+      }
+
+      antName = ant.name();
+      isRx = ant.isRxAntenna;
+      zen0 = ant.zenRange[0];
+      dZen = ant.zenRange[2];
+         // same count as the parser; at least two so that the
+         // interpolation always has a pair of zenith angles
+      int nZenData = 1 + int((ant.zenRange[1] - ant.zenRange[0]) / dZen);
+      nZen = (nZenData < 2 ? 2 : nZenData);
+
+      bool hasAzim = (ant.azimDelta > 0.0);
+      if (hasAzim)
+      {
+         dAzim = ant.azimDelta;
+         nAzim = int(360.0 / dAzim + 0.5);
+         if (::fabs(nAzim * dAzim - 360.0) > 1.e-9)
+         {
+            Exception e("Azimuth spacing does not divide 360 degrees for " +
+                        antName);
+            GNSSTK_THROW(e);
+         }
+      }
+
+      map<string, AntexData::antennaPCOandPCVData>::const_iterator it;
+      for (it = ant.freqPCVmap.begin(); it != ant.freqPCVmap.end(); it++)
+      {
+         int code = frequencyCode(it->first);
+         if (code < 0)
+         {
+            continue; // cannot be addressed
+         }
+
+         Grid g;
+         for (int i = 0; i < 3; i++)
+            g.PCO[i] = it->second.PCOvalue[i];
+         int nRows = (hasAzim ? nAzim + 1 : 1);
+         g.rowStride = (hasAzim ? nZen : 0);
+         g.PCV.resize(nRows * nZen);
+
+         const AntexData::azimZenMap& azzen = it->second.PCVvalue;
+         for (int r = 0; r < nRows; r++)
+         {
+               // the row in the record, if there is one exactly on the grid
+            double az = (hasAzim ? r * dAzim : -1.0);
+            AntexData::azimZenMap::const_iterator jt;
+            jt = (hasAzim ? azzen.find(az) : azzen.begin());
+            for (int z = 0; z < nZen; z++)
+            {
+               int zd = (z < nZenData ? z : nZenData - 1);
+               double zen = zen0 + zd * dZen;
+               AntexData::zenOffsetMap::const_iterator kt;
+               double& value = g.PCV[r * nZen + z];
+               if (jt != azzen.end() &&
+                   (kt = jt->second.find(zen)) != jt->second.end())
+               {
+                  value = kt->second;
+               }
+               else
+               {
+                     // not on the grid of the record; interpolate it
+                  value = ant.getPhaseCenterVariation(
+                     it->first, (az < 360.0 ? az : 0.0),
+                     (isRx ? 90.0 - zen : zen));
+               }
+            }
+         }
+
+         slot[code] = int(grids.size());
+         grids.push_back(g);
+      }
+   }
+
+      // ----------------------------------------------------------------------------
+   const CompiledAntenna::Grid& CompiledAntenna::grid(int freqCode) const
+   {
+      if (!hasFrequency(freqCode))
+      {
+         Exception e("Frequency code " + StringUtils::asString(freqCode) +
+                     " not found for antenna " + antName);
+         GNSSTK_THROW(e);
+      }
+      return grids[slot[freqCode]];
+   }
+
+      // ----------------------------------------------------------------------------
+   void CompiledAntenna::checkElevation(double elev_nadir)
+   {
+      if (elev_nadir < 0.0 || elev_nadir > 90.0)
+      {
+         Exception e("Invalid elevation/nadir angle");
+         GNSSTK_THROW(e);
+      }
+   }
+
+      // ----------------------------------------------------------------------------
+   double CompiledAntenna::interpolate(const Grid& g, double azimuth,
+                                       double elev_nadir) const
+   {
+         // fractional index in zenith, clamped to the grid
+      double z = ((isRx ? 90.0 - elev_nadir : elev_nadir) - zen0) / dZen;
+      z = (z < 0.0 ? 0.0 : (z > nZen - 1 ? nZen - 1 : z));
+      int iz = int(z);
+      iz = (iz > nZen - 2 ? nZen - 2 : iz);
+      double fz = z - iz;
+
+         // fractional index in azimuth, which is periodic
+      double x = (azimuth - 360.0 * ::floor(azimuth / 360.0)) / dAzim;
+      int ia = int(x);
+      ia = (ia > nAzim - 1 ? nAzim - 1 : ia);
+      double fa = x - ia;
+
+      const double *p = &g.PCV[ia * g.rowStride + iz];
+      const double *q = p + g.rowStride;
+      return ((1.0 - fa) * ((1.0 - fz) * p[0] + fz * p[1]) +
+              fa * ((1.0 - fz) * q[0] + fz * q[1]));
+   }
+
+      // ----------------------------------------------------------------------------
+   Triple CompiledAntenna::getPhaseCenterOffset(int freqCode) const
+   {
+      try
+      {
+         const Grid& g = grid(freqCode);
+         return Triple(g.PCO[0], g.PCO[1], g.PCO[2]);
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+      // ----------------------------------------------------------------------------
+   double CompiledAntenna::getPhaseCenterVariation(int freqCode,
+                                                   double azimuth,
+                                                   double elev_nadir) const
+   {
+      try
+      {
+         checkElevation(elev_nadir);
+         return interpolate(grid(freqCode), azimuth, elev_nadir);
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+      // ----------------------------------------------------------------------------
+   double CompiledAntenna::getTotalPhaseCenterOffset(int freqCode,
+                                                     double azimuth,
+                                                     double elev_nadir) const
+   {
+      try
+      {
+         checkElevation(elev_nadir);
+         const Grid& g = grid(freqCode);
+         double pcv = interpolate(g, azimuth, elev_nadir);
+
+            // see doc for class AntexData for signs, etc
+         double elev = (isRx ? elev_nadir : 90. - elev_nadir);
+         double cosel = ::cos(elev * DEG_TO_RAD);
+         double sinel = ::sin(elev * DEG_TO_RAD);
+         double cosaz = ::cos(azimuth * DEG_TO_RAD);
+         double sinaz = ::sin(azimuth * DEG_TO_RAD);
+         return (-pcv + g.PCO[0] * cosel * cosaz + g.PCO[1] * cosel * sinaz +
+                 g.PCO[2] * sinel);
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+      // ----------------------------------------------------------------------------
+   void CompiledAntenna::getPhaseCenterVariations(
+      int freqCode, const vector<double>& azimuth,
+      const vector<double>& elev_nadir, vector<double>& pcv) const
+   {
+      try
+      {
+         if (azimuth.size() != elev_nadir.size())
+         {
+            Exception e("Azimuth and elevation/nadir lengths differ");
+            GNSSTK_THROW(e);
+         }
+         const Grid& g = grid(freqCode);
+         for (size_t i = 0; i < elev_nadir.size(); i++)
+            checkElevation(elev_nadir[i]);
+
+         pcv.resize(azimuth.size());
+         for (size_t i = 0; i < azimuth.size(); i++)
+            pcv[i] = interpolate(g, azimuth[i], elev_nadir[i]);
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+      // ----------------------------------------------------------------------------
+   void CompiledAntenna::getTotalPhaseCenterOffsets(
+      int freqCode, const vector<double>& azimuth,
+      const vector<double>& elev_nadir, vector<double>& total) const
+   {
+      try
+      {
+         getPhaseCenterVariations(freqCode, azimuth, elev_nadir, total);
+         const Grid& g = grid(freqCode);
+         for (size_t i = 0; i < total.size(); i++)
+         {
+            double elev = (isRx ? elev_nadir[i] : 90. - elev_nadir[i]);
+            double cosel = ::cos(elev * DEG_TO_RAD);
+            double sinel = ::sin(elev * DEG_TO_RAD);
+            double cosaz = ::cos(azimuth[i] * DEG_TO_RAD);
+            double sinaz = ::sin(azimuth[i] * DEG_TO_RAD);
+            total[i] = -total[i] + g.PCO[0] * cosel * cosaz +
+                       g.PCO[1] * cosel * sinaz + g.PCO[2] * sinel;
+         }
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+} // namespace gnsstk
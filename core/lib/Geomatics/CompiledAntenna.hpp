@@ -0,0 +1,232 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file CompiledAntenna.hpp
+ * Phase center offsets and variations of one antenna, compiled from an
+ * AntexData object into dense grids for fast repeated evaluation. */
+
+#ifndef COMPILED_ANTENNA_HPP
+#define COMPILED_ANTENNA_HPP
+
+#include <string>
+#include <vector>
+
+#include "AntexData.hpp"
+#include "Triple.hpp"
+
+namespace gnsstk
+{
+   /// @ingroup FileHandling
+   //@{
+
+   /** The phase center offsets and variations of one antenna, taken from
+    * an AntexData object and stored for evaluation in the inner loop of
+    * a PPP or orbit determination program, where each observation needs
+    * the PCV of both the receiver and the satellite antenna.
+    *
+    * AntexData keeps the PCVs in nested std::maps keyed by a frequency
+    * string, azimuth and zenith angle, and finds the four bracketing
+    * points of each evaluation by searching them. Here the PCVs of each
+    * frequency are a single row-major array over the regular
+    * (azimuth, zenith) grid of the ANTEX record, so that the bracketing
+    * points are found by index arithmetic and the interpolation is a
+    * bilinear formula without special cases. Frequencies are identified
+    * by an integer code from frequencyCode(), which indexes a small table
+    * in each antenna.
+    *
+    * The results are those of the AntexData functions of the same names,
+    * to within rounding: the PCVs are interpolated bilinearly in azimuth
+    * and zenith (linearly in zenith if the antenna has no azimuth
+    * dependence), zenith angles beyond the grid take the value at the
+    * edge of the grid, and azimuth is periodic. Angles are in degrees and
+    * the sign conventions and coordinates are those documented in
+    * AntexData; in particular elev_nadir is an elevation angle for
+    * receiver antennas and a nadir angle for satellite antennas.
+    *
+    * @code
+    * AntexData ant;      // e.g. from AntexStream
+    * CompiledAntenna cant(ant);
+    * int L1 = CompiledAntenna::frequencyCode("G01");
+    * double pcv = cant.getPhaseCenterVariation(L1, azim, elev);
+    * @endcode
+    */
+   class CompiledAntenna
+   {
+   public:
+         /// Number of distinct frequency codes; codes are 0 to this - 1.
+      static const int NUM_FREQ_CODES = 7 * 16;
+
+         /** Return the integer code of an ANTEX frequency string,
+          * e.g. "G01", "E05" or "C07"; a blank system character means
+          * GPS.
+          * @return the code, or -1 if the system character is not one of
+          *   G, R, E, C, J, S, I or the number is not 0 to 15. */
+      static int frequencyCode(const std::string& freq);
+
+         /// Default constructor, an antenna with no frequencies.
+      CompiledAntenna();
+
+         /** Compile the given antenna.
+          * @throw Exception if the antenna is invalid, or its zenith grid
+          *   is empty. */
+      explicit CompiledAntenna(const AntexData& ant);
+
+         /// Return the name of the antenna, cf. AntexData::name().
+      const std::string& name() const { return antName; }
+
+         /// Return true for a receiver antenna, false for a satellite.
+      bool isReceiver() const { return isRx; }
+
+         /** Return true if the antenna has data for the given frequency
+          * code. */
+      bool hasFrequency(int freqCode) const
+      {
+         return (freqCode >= 0 && freqCode < NUM_FREQ_CODES &&
+                 slot[freqCode] >= 0);
+      }
+
+         /** Get the PC offset in mm; cf. AntexData::getPhaseCenterOffset().
+          * @param freqCode frequency code, from frequencyCode().
+          * @throw Exception if the frequency does not exist for this
+          *   antenna. */
+      Triple getPhaseCenterOffset(int freqCode) const;
+
+         /** Compute the phase center variation in mm; cf.
+          * AntexData::getPhaseCenterVariation().
+          * @param freqCode frequency code, from frequencyCode().
+          * @param azimuth azimuth angle in degrees
+          * @param elev_nadir elevation (receivers) or nadir (satellites)
+          *   angle in degrees
+          * @throw Exception if the frequency does not exist for this
+          *   antenna, or elev_nadir is not within 0 to 90 degrees. */
+      double getPhaseCenterVariation(int freqCode, double azimuth,
+                                     double elev_nadir) const;
+
+         /** Compute the total phase center offset in mm, PCO and PCV; cf.
+          * AntexData::getTotalPhaseCenterOffset().
+          * @param freqCode frequency code, from frequencyCode().
+          * @param azimuth azimuth angle in degrees
+          * @param elev_nadir elevation (receivers) or nadir (satellites)
+          *   angle in degrees
+          * @throw Exception if the frequency does not exist for this
+          *   antenna, or elev_nadir is not within 0 to 90 degrees. */
+      double getTotalPhaseCenterOffset(int freqCode, double azimuth,
+                                       double elev_nadir) const;
+
+         /** Compute the phase center variation (mm) of one frequency at
+          * many angles, e.g. toward all the satellites in view at one
+          * epoch.
+          * @param freqCode frequency code, from frequencyCode().
+          * @param azimuth azimuth angles in degrees
+          * @param elev_nadir elevation or nadir angles in degrees,
+          *   parallel to azimuth
+          * @param pcv output, resized to match azimuth
+          * @throw Exception if the frequency does not exist for this
+          *   antenna, the inputs differ in length, or any elev_nadir is
+          *   not within 0 to 90 degrees. */
+      void getPhaseCenterVariations(int freqCode,
+                                    const std::vector<double>& azimuth,
+                                    const std::vector<double>& elev_nadir,
+                                    std::vector<double>& pcv) const;
+
+         /** Compute the total phase center offset (mm) of one frequency
+          * at many angles; cf. getTotalPhaseCenterOffset().
+          * @param freqCode frequency code, from frequencyCode().
+          * @param azimuth azimuth angles in degrees
+          * @param elev_nadir elevation or nadir angles in degrees,
+          *   parallel to azimuth
+          * @param total output, resized to match azimuth
+          * @throw Exception as getPhaseCenterVariations(). */
+      void getTotalPhaseCenterOffsets(int freqCode,
+                                      const std::vector<double>& azimuth,
+                                      const std::vector<double>& elev_nadir,
+                                      std::vector<double>& total) const;
+
+   private:
+         /// Grid of PCVs and the PCO for one frequency.
+      class Grid
+      {
+      public:
+            /// nominal phase center offset in mm, cf. AntexData
+         double PCO[3];
+            /** PCVs in mm, row-major, nAzim+1 rows (the last repeats the
+             * first, at 360 degrees) of nZen values; one row if the
+             * antenna has no azimuth dependence. */
+         std::vector<double> PCV;
+            /// distance between rows in PCV; 0 if there is one row
+         int rowStride;
+      };
+
+         /// Return the grid of a frequency code, or throw.
+      const Grid& grid(int freqCode) const;
+
+         /// Interpolate g at the given angles, which are not checked.
+      double interpolate(const Grid& g, double azimuth,
+                         double elev_nadir) const;
+
+         /// Throw if elev_nadir is not within 0 to 90 degrees.
+      static void checkElevation(double elev_nadir);
+
+         /// name of the antenna
+      std::string antName;
+
+         /// true for a receiver antenna
+      bool isRx;
+
+         /// azimuth spacing in degrees; 360 if no azimuth dependence
+      double dAzim;
+
+         /// first zenith angle and zenith spacing, degrees
+      double zen0, dZen;
+
+         /// number of azimuth intervals and of zenith angles in the grids
+      int nAzim, nZen;
+
+         /// index in grids of each frequency code, or -1
+      int slot[NUM_FREQ_CODES];
+
+         /// grids of all the frequencies of the antenna
+      std::vector<Grid> grids;
+
+   }; // class CompiledAntenna
+
+   //@}
+
+} // namespace gnsstk
+
+#endif
@@ -115,6 +115,9 @@ namespace gnsstk
       friend std::ostream& operator<<(std::ostream& s,
                                       const EarthOrientation& );
 
+         /// EarthOrientationCache uses the private IERS model functions
+      friend class EarthOrientationCache;
+
       //------------------------------------------------------------------------------
       // constants
 
@@ -0,0 +1,275 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file EarthOrientationCache.cpp
+    class gnsstk::EarthOrientationCache computes the ECEF-to-inertial rotation
+    of class EarthOrientation at many epochs, interpolating its slowly varying
+    precession-nutation part from a time grid. */
+
+//------------------------------------------------------------------------------------
+#include "EarthOrientationCache.hpp"
+// system
+#include <cmath>
+// GNSSTk
+#include "StringUtils.hpp"
+
+//------------------------------------------------------------------------------------
+using namespace std;
+
+namespace gnsstk
+{
+      /// Seconds per century, the unit of the coordinate transformation time.
+   static const double SEC_PER_CENTURY = 86400.0 * 36525.0;
+
+      /** Return the rotation through angle radians about axis (1, 2 or
+       * 3); the same as rotation() of MatrixOperators, but without
+       * allocating. */
+   static FixedMatrix<double, 3, 3> fixedRotation(double angle, int axis)
+   {
+      FixedMatrix<double, 3, 3> R(0.0);
+      int i1 = axis - 1;
+      int i2 = (i1 + 1) % 3;
+      int i3 = (i2 + 1) % 3;
+      R(i1, i1) = 1.0;
+      R(i2, i2) = R(i3, i3) = ::cos(angle);
+      R(i3, i2) = -(R(i2, i3) = ::sin(angle));
+      return R;
+   }
+
+   //---------------------------------------------------------------------------------
+   EarthOrientationCache::EarthOrientationCache(IERSConvention conv,
+                                                double spacing_, int order_)
+         : convention(conv), spacing(spacing_), order(order_)
+   {
+      if (convention != IERSConvention::IERS1996 &&
+          convention != IERSConvention::IERS2003 &&
+          convention != IERSConvention::IERS2010)
+      {
+         InvalidRequest e("IERS convention is not defined");
+         GNSSTK_THROW(e);
+      }
+      if (!(spacing > 0.0))
+      {
+         InvalidRequest e("Grid spacing must be positive");
+         GNSSTK_THROW(e);
+      }
+      if (order < 2 || order > MAX_ORDER)
+      {
+         InvalidRequest e("Interpolation order must be 2 to " +
+                          StringUtils::asString(MAX_ORDER));
+         GNSSTK_THROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   FixedMatrix<double, 3, 3> EarthOrientationCache::ECEFtoInertial(
+      const EphTime& t, const EarthOrientation& eo, bool reduced)
+   {
+      try
+      {
+         if (eo.convention != convention)
+         {
+            InvalidRequest e("EOPs do not use the IERS convention of the cache");
+            GNSSTK_THROW(e);
+         }
+
+         double T(EarthOrientation::coordTransTime(t));
+         double xp(eo.xp * EarthOrientation::ARCSEC_TO_RAD);
+         double yp(eo.yp * EarthOrientation::ARCSEC_TO_RAD);
+         double UT1mUTC(eo.UT1mUTC);
+         double theta;
+         FixedMatrix<double, 3, 3> W;
+
+         if (convention == IERSConvention::IERS1996)
+         {
+               // GAST = GMST + equation of equinoxes; the latter is in Q
+            if (reduced)
+            {
+               double UT1mUT1R, dlodR, domegaR;
+               EarthOrientation::UT1mUTCTidalCorrections(T, UT1mUT1R, dlodR,
+                                                         domegaR);
+               UT1mUTC = UT1mUT1R - UT1mUTC;
+            }
+            theta = EarthOrientation::GMST1996(t, UT1mUTC, false);
+            W     = fixedRotation(-xp, 2) * fixedRotation(-yp, 1);
+         }
+         else
+         {
+               // 2003 and 2010 both use ERA and the same polar motion
+            theta = EarthOrientation::EarthRotationAngle(t, UT1mUTC);
+            W     = fixedRotation(-yp, 1) * fixedRotation(-xp, 2) *
+                fixedRotation(EarthOrientation::Sprime(T), 3);
+         }
+
+         return transpose(W * fixedRotation(theta, 3) * interpolate(T));
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   FixedMatrix<double, 3, 3> EarthOrientationCache::ECEFtoJ2000(
+      const EphTime& t, const EarthOrientation& eo, bool reduced)
+   {
+      try
+      {
+         if (convention != IERSConvention::IERS2010)
+         {
+            InvalidRequest e("ECEFtoJ2000 implemented only for IERS2010");
+            GNSSTK_THROW(e);
+         }
+
+            // IAU 2000 frame bias: offsets in longitude and obliquity of
+            // the CIP at J2000, and the equinox offset; see SOFA bi00.c
+         static const FixedMatrix<double, 3, 3> B(
+            fixedRotation(0.0068192 * EarthOrientation::ARCSEC_TO_RAD, 1) *
+            fixedRotation(-0.041775 * EarthOrientation::ARCSEC_TO_RAD *
+                          ::sin(84381.448 * EarthOrientation::ARCSEC_TO_RAD),
+                          2) *
+            fixedRotation(-0.0146 * EarthOrientation::ARCSEC_TO_RAD, 3));
+
+         return B * ECEFtoInertial(t, eo, reduced);
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   FixedMatrix<double, 3, 3> EarthOrientationCache::precessionNutation(
+      const EphTime& t)
+   {
+      try
+      {
+         return interpolate(EarthOrientation::coordTransTime(t));
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+      // private
+   FixedMatrix<double, 3, 3> EarthOrientationCache::interpolate(double T)
+   {
+         // position on the grid, and the first of the points to use
+      double x  = T * SEC_PER_CENTURY / spacing;
+      double fx = ::floor(x);
+      long k0   = long(fx) - (order - 1) / 2;
+      double p  = x - fx + double((order - 1) / 2); // x - k0
+
+         // Lagrange weights
+      double w[MAX_ORDER];
+      int i, j;
+      for (i = 0; i < order; i++)
+      {
+         w[i] = 1.0;
+         for (j = 0; j < order; j++)
+         {
+            if (j != i)
+            {
+               w[i] *= (p - j) / double(i - j);
+            }
+         }
+      }
+
+      FixedMatrix<double, 3, 3> Q(0.0);
+      for (i = 0; i < order; i++)
+      {
+         const FixedMatrix<double, 3, 3>& N(node(k0 + i));
+         for (j = 0; j < 9; j++)
+         {
+            Q.begin()[j] += w[i] * N.begin()[j];
+         }
+      }
+
+      return Q;
+   }
+
+   //---------------------------------------------------------------------------------
+      // private
+   const FixedMatrix<double, 3, 3>& EarthOrientationCache::node(long k)
+   {
+      map<long, FixedMatrix<double, 3, 3>>::iterator it = grid.find(k);
+      if (it != grid.end())
+      {
+         return it->second;
+      }
+
+         // compute Q as EarthOrientation::ECEFtoInertialYYYY() does
+      double T = double(k) * spacing / SEC_PER_CENTURY;
+      FixedMatrix<double, 3, 3>& Q(grid[k]);
+      if (convention == IERSConvention::IERS1996)
+      {
+         double eps, deps, dpsi, om;
+         eps = EarthOrientation::obliquity1996(T);
+         EarthOrientation::nutationAngles1996(T, deps, dpsi, om);
+            // equation of the equinoxes, cf. EarthOrientation::gast1996()
+         double ee = dpsi * ::cos(eps) +
+                     (0.00264 * ::sin(om) + 0.000063 * ::sin(2.0 * om)) *
+                        EarthOrientation::ARCSEC_TO_RAD;
+         Q = fixedRotation(ee, 3) *
+             FixedMatrix<double, 3, 3>(
+                EarthOrientation::nutationMatrix(eps, dpsi, deps) *
+                EarthOrientation::precessionMatrix1996(T));
+      }
+      else if (convention == IERSConvention::IERS2003)
+      {
+         Q = EarthOrientation::preciseEarthRotation2003(T);
+      }
+      else
+      {
+            // GCRS-to-CIRS from the CIO coordinates and s
+         double X, Y, s;
+         EarthOrientation::XYCIO(T, X, Y);
+         s = EarthOrientation::S(T, X, Y, IERSConvention::IERS2010);
+         double r2(X * X + Y * Y);
+         double e(r2 != 0.0 ? ::atan2(Y, X) : 0.0);
+         double d(::atan(::sqrt(r2 / (1.0 - r2))));
+         Q = fixedRotation(-(e + s), 3) * fixedRotation(d, 2) *
+             fixedRotation(e, 3);
+      }
+
+      return Q;
+   }
+
+} // end namespace gnsstk
@@ -0,0 +1,199 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file EarthOrientationCache.hpp
+    class gnsstk::EarthOrientationCache computes the ECEF-to-inertial rotation
+    of class EarthOrientation at many epochs, interpolating its slowly varying
+    precession-nutation part from a time grid. */
+
+#ifndef CLASS_EARTHORIENTCACHE_INCLUDE
+#define CLASS_EARTHORIENTCACHE_INCLUDE
+
+//------------------------------------------------------------------------------------
+// system includes
+#include <map>
+// GNSSTk
+#include "Exception.hpp"
+#include "FixedMatrix.hpp"
+// geomatics
+#include "EarthOrientation.hpp"
+#include "EphTime.hpp"
+#include "IERSConvention.hpp"
+
+//------------------------------------------------------------------------------------
+namespace gnsstk
+{
+
+      /**
+       class EarthOrientationCache computes the same ECEF-to-inertial rotation
+       as EarthOrientation::ECEFtoInertial(), but much faster when it is needed
+       at many epochs, e.g. at every step of an orbit integration. That
+       rotation is transpose(W * R(theta) * Q), where W is the polar motion
+       matrix, R(theta) the rotation of the Earth through the Earth rotation
+       angle (ERA, or GAST for IERS1996) and Q the precession-nutation matrix,
+       including the frame bias (and, for IERS1996, the equation of the
+       equinoxes). Q is the expensive part, requiring the IERS nutation or CIO
+       series with thousands of terms, but it varies slowly: its shortest
+       significant period is several days. So the cache computes Q exactly
+       only on a uniform grid in TT, and interpolates its elements between the
+       grid points with a Lagrange polynomial; theta and W, which carry all
+       the fast variation, are computed exactly at each epoch. Grid points are
+       computed the first time they are needed and kept until clear().
+
+       The accuracy is set by the grid spacing and the number of points used
+       in the interpolation. The defaults, a six hour grid and six points,
+       reproduce the exact rotation to about 2.e-14 rad; six points on a one
+       day grid give about 1.e-10 rad (20 micro arcsec), and four points on a
+       six hour grid about 4.e-12 rad, all well below the accuracy of the
+       EOPs. Each grid point costs about as much as one exact rotation.
+
+       The cache is not thread safe; use one in each thread.
+      */
+   class EarthOrientationCache
+   {
+   public:
+         /// The largest number of points in the interpolation.
+      static const int MAX_ORDER = 10;
+
+         /**
+          Constructor.
+          @param conv IERS convention of the rotation; the EarthOrientation
+                      objects passed to ECEFtoInertial() must use the same.
+          @param spacing the spacing of the grid, in seconds.
+          @param order the number of grid points used in the interpolation,
+                       2 (linear) to MAX_ORDER.
+          @throw InvalidRequest if the convention is not defined, the spacing
+                 is not positive or the order is out of range.
+         */
+      EarthOrientationCache(IERSConvention conv = IERSConvention::IERS2010,
+                            double spacing = 21600.0, int order = 6);
+
+         /**
+          Generate the transformation matrix (3x3 rotation) relating the ECEF
+          frame to the conventional inertial frame, using the EOPs in eo; this
+          is eo.ECEFtoInertial(t, reduced) to within the accuracy of the
+          interpolation.
+          @param t epoch of the rotation.
+          @param eo the EOPs (xp, yp and UT1-UTC) at t.
+          @param reduced true when UT1mUTC is 'reduced', meaning assumes
+                          'no tides', as is the case with the NGA EOPs
+                          (default=F). Used only by IERS1996, as in
+                          EarthOrientation.
+          @return 3x3 rotation matrix
+          @throw InvalidRequest if eo.convention is not the convention of the
+                 cache.
+          @throw Exception if the TimeSystem conversion fails (if TimeSystem
+                 is Unknown)
+         */
+      FixedMatrix<double, 3, 3> ECEFtoInertial(const EphTime& t,
+                                               const EarthOrientation& eo,
+                                               bool reduced = false);
+
+         /**
+          Generate the transformation matrix (3x3 rotation) relating the ECEF
+          frame to the J2000 dynamical (inertial) frame, using the EOPs in eo.
+          This is the frame bias matrix B times ECEFtoInertial(t, eo, reduced);
+          B is the IAU 2000 frame bias of the IERS Conventions (2010).
+          Only available in IERS2010.
+          @param t epoch of the rotation.
+          @param eo the EOPs (xp, yp and UT1-UTC) at t.
+          @param reduced see ECEFtoInertial().
+          @return 3x3 rotation matrix
+          @throw InvalidRequest if the convention of the cache is not
+                 IERS2010, or eo.convention is not the convention of the
+                 cache.
+          @throw Exception if the TimeSystem conversion fails (if TimeSystem
+                 is Unknown)
+         */
+      FixedMatrix<double, 3, 3> ECEFtoJ2000(const EphTime& t,
+                                            const EarthOrientation& eo,
+                                            bool reduced = false);
+
+         /**
+          Interpolate the precession-nutation matrix Q (celestial to
+          intermediate frame, see the class description) at the given time.
+          @param t epoch of interest.
+          @return 3x3 rotation matrix
+          @throw Exception if the TimeSystem conversion fails (if TimeSystem
+                 is Unknown)
+         */
+      FixedMatrix<double, 3, 3> precessionNutation(const EphTime& t);
+
+         /// Return the IERS convention of the cache.
+      IERSConvention getConvention() const { return convention; }
+
+         /// Return the grid spacing in seconds.
+      double getSpacing() const { return spacing; }
+
+         /// Return the number of points in the interpolation.
+      int getOrder() const { return order; }
+
+         /// Return the number of grid points computed so far.
+      size_t size() const { return grid.size(); }
+
+         /// Discard all the grid points.
+      void clear() { grid.clear(); }
+
+   private:
+         /**
+          Interpolate Q at coordinate transformation time T.
+          @param T the coordinate transformation time at the time of interest
+         */
+      FixedMatrix<double, 3, 3> interpolate(double T);
+
+         /// Return Q at grid point k, computing it if necessary.
+      const FixedMatrix<double, 3, 3>& node(long k);
+
+         /// IERS convention of all the matrices
+      IERSConvention convention;
+
+         /// grid spacing in seconds
+      double spacing;
+
+         /// number of grid points in the interpolation
+      int order;
+
+         /// Q at the grid points; key is the index of the point, time
+         /// spacing*key seconds (TT) since J2000
+      std::map<long, FixedMatrix<double, 3, 3>> grid;
+
+   }; // end class EarthOrientationCache
+
+} // end namespace gnsstk
+
+#endif // CLASS_EARTHORIENTCACHE_INCLUDE
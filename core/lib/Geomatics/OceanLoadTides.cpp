@@ -210,8 +210,19 @@ namespace gnsstk
                         // LOG(VERBOSE) << "  Found site " << site << " with
                         // coefficients:"; LOG(VERBOSE) << oss.str();
 
-                        // update coeff map
-                     coefficientMap[site] = coeff;
+                        // update coefficients, keeping the handle of a
+                        // site that was already initialized
+                     map<string, int>::const_iterator it;
+                     it = siteIndex.find(site);
+                     if (it == siteIndex.end())
+                     {
+                        siteIndex[site] = coefficients.size();
+                        coefficients.push_back(coeff);
+                     }
+                     else
+                     {
+                        coefficients[it->second] = coeff;
+                     }
                      n++;
                         // update position map
                      coeff.clear();
@@ -281,7 +292,7 @@ namespace gnsstk
          }
 
             // get the coefficients for this site
-         vector<double> coeff = coefficientMap[site];
+         const vector<double>& coeff = coefficients[siteIndex[site]];
 
             // get the astronomical arguments in radians
          double angles[11];
@@ -417,44 +428,63 @@ namespace gnsstk
    {
       try
       {
-         ostringstream oss; // TEMP
-         int i;
-
          if (!isValid(site))
          {
             Exception e("Site " + site + " has not been initialized.");
             GNSSTK_THROW(e);
          }
 
-            // get the coefficients for this site
-         vector<double> coeff = coefficientMap[site];
-
-            // Cartwright-Tayler numbers of Scherneck tides
-            // ordering is: M2, S2, N2, K2, K1, O1, P1, Q1, Mf, Mm, Ssa
+         return displacement(coefficients[siteIndex[site]],
+                             epochArguments(time));
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
 
-            // standard 11 Scherneck tides:
-         static const NVector SchInd[] = {
-            {2, 0, 0, 0, 0, 0},  // M2
-            {2, 2, -2, 0, 0, 0}, // S2
-            {2, -1, 0, 1, 0, 0}, // N2
-            {2, 2, 0, 0, 0, 0},  // K2
-            {1, 1, 0, 0, 0, 0},  // K1
-            {1, -1, 0, 0, 0, 0}, // O1
-            {1, 1, -2, 0, 0, 0}, // P1
-            {1, -2, 0, 1, 0, 0}, // Q1
-            {0, 2, 0, 0, 0, 0},  // Mf
-            {0, 1, 0, -1, 0, 0}, // Mm
-            {0, 0, 2, 0, 0, 0},  // Ssa
-         };
+   } // end Triple OceanLoadTides::computeDisplacement
 
-            // NB there must be 11 std tides in SchInd[]
-         if ((int)(sizeof(SchInd) / sizeof(NVector)) != NSTD)
+   //---------------------------------------------------------------------------------
+   Triple OceanLoadTides::computeDisplacement(int handle,
+                                              const EpochArguments& args) const
+   {
+      try
+      {
+         if (handle < 0 || handle >= (int)coefficients.size())
          {
-            Exception e("Static SchInd array is corrupted");
+            Exception e("Invalid site handle " + asString(handle));
             GNSSTK_THROW(e);
          }
 
+         return displacement(coefficients[handle], args);
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+
+   } // end Triple OceanLoadTides::computeDisplacement
+
+   //---------------------------------------------------------------------------------
+   int OceanLoadTides::siteHandle(const string& site) const
+   {
+      map<string, int>::const_iterator it = siteIndex.find(site);
+      if (it == siteIndex.end())
+      {
+         Exception e("Site " + site + " has not been initialized.");
+         GNSSTK_THROW(e);
+      }
+      return it->second;
+   }
+
+   //---------------------------------------------------------------------------------
+   OceanLoadTides::EpochArguments
+   OceanLoadTides::epochArguments(const EphTime& time)
+   {
+      try
+      {
             // compute time argument
+         int i;
          EphTime ttag(time);
          ttag.convertSystemTo(TimeSystem::UTC);
          double dayfr(ttag.secOfDay() / 86400.0);
@@ -496,7 +526,8 @@ namespace gnsstk
          freqDel[4] = -0.0001470938 + 0.0000000003 * T;
 
             // convert to Doodson (Darwin) variables
-         double Dood[6], freqDood[6];
+         EpochArguments args;
+         double *Dood(args.Dood), *freqDood(args.freqDood);
          Dood[0] = 360.0 * dayfr - Del[3];
          Dood[1] = Del[2] + Del[4];
          Dood[2] = Dood[1] - Del[3];
@@ -513,6 +544,49 @@ namespace gnsstk
          freqDood[4] = -freqDel[4];
          freqDood[5] = freqDood[2] - freqDel[1];
 
+         return args;
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+
+   } // end OceanLoadTides::epochArguments
+
+   //---------------------------------------------------------------------------------
+   Triple OceanLoadTides::displacement(const vector<double>& coeff,
+                                       const EpochArguments& args) const
+   {
+      try
+      {
+         int i;
+         const double *Dood(args.Dood), *freqDood(args.freqDood);
+
+            // Cartwright-Tayler numbers of Scherneck tides
+            // ordering is: M2, S2, N2, K2, K1, O1, P1, Q1, Mf, Mm, Ssa
+
+            // standard 11 Scherneck tides:
+         static const NVector SchInd[] = {
+            {2, 0, 0, 0, 0, 0},  // M2
+            {2, 2, -2, 0, 0, 0}, // S2
+            {2, -1, 0, 1, 0, 0}, // N2
+            {2, 2, 0, 0, 0, 0},  // K2
+            {1, 1, 0, 0, 0, 0},  // K1
+            {1, -1, 0, 0, 0, 0}, // O1
+            {1, 1, -2, 0, 0, 0}, // P1
+            {1, -2, 0, 1, 0, 0}, // Q1
+            {0, 2, 0, 0, 0, 0},  // Mf
+            {0, 1, 0, -1, 0, 0}, // Mm
+            {0, 0, 2, 0, 0, 0},  // Ssa
+         };
+
+            // NB there must be 11 std tides in SchInd[]
+         if ((int)(sizeof(SchInd) / sizeof(NVector)) != NSTD)
+         {
+            Exception e("Static SchInd array is corrupted");
+            GNSSTK_THROW(e);
+         }
+
             // find amplitudes and phases for vertical, west and south components,
             // for all 342 derived tides, from standard tides
          double amp[NSTD], phs[NSTD];
@@ -652,14 +726,14 @@ namespace gnsstk
          GNSSTK_THROW(e);
       }
 
-   } // end Triple OceanLoadTides::computeDisplacement
+   } // end Triple OceanLoadTides::displacement
 
    //---------------------------------------------------------------------------------
    int OceanLoadTides::deriveTides(const NVector SchInd[], const double amp[],
                                    const double phs[], const double Dood[],
                                    const double freqDood[], double ampDer[],
                                    double phsDer[], double freqDer[],
-                                   const int Nin)
+                                   const int Nin) const
    {
          // indexes for std tides: M2, S2, N2, K2, K1,  O1,  P1,  Q1,  Mf,  Mm, Ssa
       static const int stdindex[] = {0,   1,   2,   3,   109, 110,
@@ -78,10 +78,25 @@ namespace gnsstk
        The function computeDisplacement() will compute the site displacement
        vector at any time for any initialized site.
 
+       When many sites are processed at each epoch, look up each site once with
+       siteHandle(), compute the astronomical arguments once per epoch with
+       epochArguments(), and pass both to computeDisplacement(); the result is
+       identical to that of computeDisplacement(site,t). These functions are
+       const and may be called from several threads at once.
+
       */
    class OceanLoadTides
    {
    public:
+         /// Doodson arguments at one epoch, shared by all sites.
+      struct EpochArguments
+      {
+            /// Doodson arguments in degrees
+         double Dood[6];
+            /// Doodson frequencies in cycles/day
+         double freqDood[6];
+      };
+
          /// Constructor
       OceanLoadTides(){};
 
@@ -111,11 +126,33 @@ namespace gnsstk
           Return true if the given site name has been initialized, otherwise
           false.
          */
-      bool isValid(std::string site)
+      bool isValid(std::string site) const
       {
-         return (coefficientMap.find(site) != coefficientMap.end());
+         return (siteIndex.find(site) != siteIndex.end());
       }
 
+         /**
+          Return a handle for the given site, for use with
+          computeDisplacement(int, const EpochArguments&). The handle remains
+          valid, and refers to the same site, for the life of this object, even
+          if initializeSites() is called again.
+          @param site  string Input name of the site; must be the same as
+                       previously successfully passed to initializeSites().
+          @return handle of the site, a non-negative integer.
+          @throw Exception if the site has not been initialized.
+         */
+      int siteHandle(const std::string& site) const;
+
+         /**
+          Compute the astronomical (Doodson) arguments used by
+          computeDisplacement() at the given time; these are the same for all
+          sites.
+          @param t     EphTime Input time of interest.
+          @return arguments for computeDisplacement(int, const EpochArguments&)
+          @throw Exception if the time system is unknown.
+         */
+      static EpochArguments epochArguments(const EphTime& t);
+
          /**
           Compute the site displacement vector at the given time for the given
           site. Use the 11-tide (simple) model. The site must have been
@@ -145,6 +182,19 @@ namespace gnsstk
          */
       Triple computeDisplacement(std::string site, EphTime t);
 
+         /**
+          Compute the site displacement vector for the given site at the epoch
+          of the given arguments, as computeDisplacement(std::string, EphTime).
+          @param handle  handle of the site, from siteHandle().
+          @param args    arguments at the time of interest, from
+                         epochArguments().
+          @return Triple containing the North, East and Up components of the
+                         site displacement in meters.
+          @throw Exception if the handle is invalid, or if there is corruption
+                         in the static arrays.
+         */
+      Triple computeDisplacement(int handle, const EpochArguments& args) const;
+
          /**
           Return the recorded latitude, longitude and ht(=0) for the given site.
           Return value of (0.0,0.0,0.0) probably means the position was not
@@ -170,10 +220,13 @@ namespace gnsstk
       //;
 
          /**
-          map of (site name, coefficient array), created by call to
-          initializeSites()
+          map of (site name, index of the site in coefficients), created by
+          call to initializeSites(); the index is the site handle.
          */
-      std::map<std::string, std::vector<double>> coefficientMap;
+      std::map<std::string, int> siteIndex;
+
+         /// coefficient arrays, one per site, created by initializeSites()
+      std::vector<std::vector<double>> coefficients;
 
          /**
           map of (site name,2-element array lat,lon), created by
@@ -187,6 +240,15 @@ namespace gnsstk
          int n[6];
       } NVector;
 
+         /**
+          Compute the displacement (NEU, meters) given the coefficient array
+          of a site and the arguments at the time of interest. Called by
+          both forms of computeDisplacement().
+          @throw Exception if static arrays are corrupted.
+         */
+      Triple displacement(const std::vector<double>& coeff,
+                          const EpochArguments& args) const;
+
          /// Number of standard (Schwiderski) tides read from BLQ file
       static const int NSTD;
 
@@ -211,7 +273,7 @@ namespace gnsstk
       int deriveTides(const NVector SchTides[], const double amp[],
                       const double phs[], const double Dood[],
                       const double freqDood[], double ampDer[], double phsDer[],
-                      double freq[], const int Nin);
+                      double freq[], const int Nin) const;
 
    }; // end class OceanLoadTides
 
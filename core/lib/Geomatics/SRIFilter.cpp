@@ -945,8 +945,9 @@ namespace gnsstk
          C = F * X - G * Zw;
          X = Phinv * C;
             // update P
-         P = F * P * transpose(F) + G * transpose(G);
-         P = Phinv * P * transpose(Phinv);
+         P = ABAt(F, P);
+         P += AAt(G);
+         P = ABAt(Phinv, P);
       }
       catch (Exception& e)
       {
@@ -992,8 +993,9 @@ namespace gnsstk
          C = F * X - G * Zw - U;
          X = Phinv * C;
             // update P
-         P = F * P * transpose(F) + G * transpose(G);
-         P = Phinv * P * transpose(Phinv);
+         P = ABAt(F, P);
+         P += AAt(G);
+         P = ABAt(Phinv, P);
          P += outer(U, U);
       }
       catch (Exception& e)
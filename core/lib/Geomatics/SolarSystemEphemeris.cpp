@@ -54,6 +54,19 @@
 #include "StringUtils.hpp"
 #include "TimeConverters.hpp"
 #include "logstream.hpp"
+// system
+#include <cmath>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 //------------------------------------------------------------------------------------
 using namespace std;
@@ -61,6 +74,82 @@ using namespace gnsstk::StringUtils;
 
 namespace gnsstk
 {
+      /// Largest number of Chebyshev coefficients per component in any body.
+   static const int MAX_CHEBYSHEV = 64;
+
+      /** Map a whole file read-only into memory.
+       * @param[in] filename name of the file to map.
+       * @param[out] length length of the file (and the mapping) in bytes.
+       * @return the start of the mapping.
+       * @throw Exception if the file cannot be opened or mapped. */
+   static void *mapFileReadOnly(const string& filename, size_t& length)
+   {
+      void *base = nullptr;
+#ifdef _WIN32
+      HANDLE hfile = CreateFileA(filename.c_str(), GENERIC_READ,
+                                 FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                                 FILE_ATTRIBUTE_NORMAL, NULL);
+      if (hfile == INVALID_HANDLE_VALUE)
+      {
+         Exception e("Failed to open input binary file " + filename +
+                     ". Abort.");
+         GNSSTK_THROW(e);
+      }
+      LARGE_INTEGER size;
+      HANDLE hmap = NULL;
+      if (GetFileSizeEx(hfile, &size) && size.QuadPart > 0)
+      {
+         hmap = CreateFileMappingA(hfile, NULL, PAGE_READONLY, 0, 0, NULL);
+      }
+         // the view keeps the file and the mapping open
+      CloseHandle(hfile);
+      if (hmap != NULL)
+      {
+         base = MapViewOfFile(hmap, FILE_MAP_READ, 0, 0, 0);
+         CloseHandle(hmap);
+      }
+      length = (base == nullptr ? 0 : size_t(size.QuadPart));
+#else
+      int fd = ::open(filename.c_str(), O_RDONLY);
+      if (fd < 0)
+      {
+         Exception e("Failed to open input binary file " + filename +
+                     ". Abort.");
+         GNSSTK_THROW(e);
+      }
+      struct stat st;
+      if (::fstat(fd, &st) == 0 && st.st_size > 0)
+      {
+         base = ::mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_SHARED,
+                       fd, 0);
+         if (base == MAP_FAILED)
+         {
+            base = nullptr;
+         }
+      }
+         // the mapping keeps the file open
+      ::close(fd);
+      length = (base == nullptr ? 0 : size_t(st.st_size));
+#endif
+      if (base == nullptr)
+      {
+         Exception e("Failed to map input binary file " + filename +
+                     ". Abort.");
+         GNSSTK_THROW(e);
+      }
+      return base;
+   }
+
+      /// Release a mapping made by mapFileReadOnly().
+   static void unmapFileView(void *base, size_t length)
+   {
+#ifdef _WIN32
+      UnmapViewOfFile(base);
+#else
+      ::munmap(base, length);
+#endif
+   }
+
    /// Class for the format used in this code.
    class SSEDouble : public FormattedDouble
    {
@@ -100,6 +189,7 @@ namespace gnsstk
          }
 
             // clear existing data
+         unmapFile();
          constants.clear();
 
             /* read the file one line at a time, process depending on the value of
@@ -911,6 +1001,95 @@ namespace gnsstk
       }
    }
 
+   //---------------------------------------------------------------------------------
+   SolarSystemEphemeris::~SolarSystemEphemeris()
+   {
+      unmapFile();
+   }
+
+   //---------------------------------------------------------------------------------
+   int SolarSystemEphemeris::initializeWithMappedFile(const string& filename)
+   {
+      try
+      {
+            // read the header with the stream, then let the mapping take over
+         readBinaryHeader(filename);
+         long offset = istrm.tellg();
+         istrm.clear();
+         istrm.close();
+         fileposMap.clear();
+         coefficients.clear();
+         if (EphemerisNumber == -1)
+         {
+            return retEphN;
+         }
+
+         mapBase = mapFileReadOnly(filename, mapLength);
+
+            // the data must be whole records, evenly spaced at the interval
+         size_t recLength = Ncoeff * sizeof(double);
+         if (offset <= 0 || size_t(offset) >= mapLength ||
+             (mapLength - offset) % recLength != 0)
+         {
+            unmapFile();
+            Exception e("Binary file " + filename +
+                        " does not hold a whole number of records");
+            GNSSTK_THROW(e);
+         }
+         mapData = reinterpret_cast<const double *>(
+            static_cast<const char *>(mapBase) + offset);
+         mapNrec = long((mapLength - offset) / recLength);
+
+         const double *last = mapData + (mapNrec - 1) * Ncoeff;
+         const double tol   = 1.e-6; // days
+         if (::fabs(mapData[1] - mapData[0] - interval) > tol ||
+             ::fabs(last[1] - last[0] - interval) > tol ||
+             ::fabs(last[0] - mapData[0] - (mapNrec - 1) * interval) > tol)
+         {
+            unmapFile();
+            Exception e("Records in binary file " + filename +
+                        " are not evenly spaced; use initializeWithBinaryFile");
+            GNSSTK_THROW(e);
+         }
+
+         record          = mapData;
+         EphemerisNumber = int(constants["DENUM"]);
+         LOG(DEBUG) << "initialize mapped sets EphemerisNumber "
+                    << EphemerisNumber << " with " << mapNrec << " records";
+
+         return 0;
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+      catch (exception& e)
+      {
+         Exception E("std except: " + string(e.what()));
+         GNSSTK_THROW(E);
+      }
+      catch (...)
+      {
+         Exception e("Unknown exception");
+         GNSSTK_THROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+      // private
+   void SolarSystemEphemeris::unmapFile()
+   {
+      if (mapBase != nullptr)
+      {
+         unmapFileView(mapBase, mapLength);
+         mapBase   = nullptr;
+         mapLength = 0;
+         mapData   = nullptr;
+         mapNrec   = 0;
+         record    = nullptr;
+      }
+   }
+
    //---------------------------------------------------------------------------------
       // get an inertial position of one body relative to another.
    void SolarSystemEphemeris::relativeInertialPositionVelocity(
@@ -1167,6 +1346,7 @@ namespace gnsstk
          string word;
 
             // open the input binary file
+         unmapFile();
          istrm.open(filename.c_str(), ios::in | ios::binary);
          if (!istrm.is_open())
          {
@@ -1375,6 +1555,7 @@ namespace gnsstk
             if (nrec == 1)
             {
                coefficients = dataVector;
+               record       = &coefficients[0];
             }
 
                // build the positions map
@@ -1490,6 +1671,43 @@ namespace gnsstk
    {
       try
       {
+            // mapped file: the record index follows from the fixed interval
+         if (mapData != nullptr)
+         {
+            if (EphemerisNumber != int(constants["DENUM"]))
+            {
+               return retEphN;
+            }
+            if (record[0] <= JD && JD <= record[1])
+            {
+               return 0;
+            }
+            if (JD < mapData[0])
+            {
+               return retEarly;
+            }
+            double dk = ::floor((JD - mapData[0]) / interval);
+            long k    = (dk < double(mapNrec) ? long(dk) : mapNrec - 1);
+            const double *rec = mapData + k * Ncoeff;
+               // the division may round across a record boundary
+            if (JD < rec[0] && k > 0)
+            {
+               rec -= Ncoeff;
+            }
+            else if (JD > rec[1] && k + 1 < mapNrec)
+            {
+               rec += Ncoeff;
+            }
+               // only the ends of the file are checked when it is mapped,
+               // so a record in the middle may still not contain JD
+            if (JD < rec[0] || JD > rec[1])
+            {
+               return retLate;
+            }
+            record = rec;
+            return 0;
+         }
+
          if (!istrm)
          {
             return retStrm;
@@ -1503,6 +1721,7 @@ namespace gnsstk
             return retEphN;
          }
 
+         record = &coefficients[0];
          if (coefficients[0] <= JD && JD <= coefficients[1])
          {
             return 0;
@@ -1526,6 +1745,7 @@ namespace gnsstk
 
          istrm.seekg(it->second, ios_base::beg); // get the record
          int iret = readBinaryRecord(coefficients);
+         record   = &coefficients[0];
          if (iret == retLate)
          {
             iret = retStrm; // this means EOF during data read
@@ -1576,12 +1796,12 @@ namespace gnsstk
             return;
          }
 
-            /* coefficients[0,1] give span of JD's in which coefficients[2,...] are
-               applicable coefficients[0,1] are even days JDs - 2452xxx.5 =>
+            /* record[0,1] give span of JD's in which record[2,...] are
+               applicable record[0,1] are even days JDs - 2452xxx.5 =>
                secOfDay() for these == 0. */
          double T, Tbeg, Tspan, Tspan0;
-         Tbeg   = coefficients[0];
-         Tspan0 = Tspan = coefficients[1] - coefficients[0];
+         Tbeg   = record[0];
+         Tspan0 = Tspan = record[1] - record[0];
          i0    = c_offset[which] - 1; // index of first coefficient in array
          ncomp = (which == NUTATIONS ? 2 : 3); // number of components returned
 
@@ -1591,7 +1811,7 @@ namespace gnsstk
             Tspan /= double(c_nsets[which]);
             for (j = c_nsets[which]; j > 0; j--)
             {
-               Tbeg = coefficients[0] + double(j - 1) * Tspan;
+               Tbeg = record[0] + double(j - 1) * Tspan;
                if (MJD > Tbeg - MJD_TO_JD)
                { // == with j==1 is the default
                   i0 += (j - 1) * ncomp * c_ncoeff[which];
@@ -1605,8 +1825,13 @@ namespace gnsstk
 
             // interpolate
          int N = c_ncoeff[which];
-         vector<double> C(N, 0.0); // Chebyshev
-         vector<double> U(N, 0.0); // derivative of Chebyshev
+         if (N < 2 || N > MAX_CHEBYSHEV)
+         {
+            Exception e("Invalid number of coefficients " + asString(N));
+            GNSSTK_THROW(e);
+         }
+         double C[MAX_CHEBYSHEV]; // Chebyshev
+         double U[MAX_CHEBYSHEV]; // derivative of Chebyshev
          for (i = 0; i < ncomp; i++)
          { // loop over components
 
@@ -1627,11 +1852,11 @@ namespace gnsstk
                // done above PV[i] = PV[i+3] = 0.0;
             for (j = N - 1; j > -1; j--) // POS
             {
-               PV[i] += coefficients[i0 + j + i * N] * C[j];
+               PV[i] += record[i0 + j + i * N] * C[j];
             }
             for (j = N - 1; j > 0; j--) // j>0 b/c U[0]=0             // VEL
             {
-               PV[i + ncomp] += coefficients[i0 + j + i * N] * U[j];
+               PV[i + ncomp] += record[i0 + j + i * N] * U[j];
             }
 
                // convert velocity to 'per day'
@@ -133,7 +133,13 @@ namespace gnsstk
           Constructor. Set EphemerisNumber to -1 to indicate that nothing has
           been read yet.
          */
-      SolarSystemEphemeris() : EphemerisNumber(-1){};
+      SolarSystemEphemeris()
+            : EphemerisNumber(-1), record(nullptr), mapBase(nullptr),
+              mapLength(0), mapData(nullptr), mapNrec(0)
+      {}
+
+         /// Destructor; releases the mapping made by initializeWithMappedFile().
+      ~SolarSystemEphemeris();
 
       //------------------------------------------------------------------
       // reading and writing ASCII (JPL) files
@@ -240,6 +246,30 @@ namespace gnsstk
          */
       int initializeWithBinaryFile(const std::string& filename);
 
+         /**
+          Map the given binary file read-only into memory, read the header and
+          prepare for computing positions and velocities, exactly as
+          initializeWithBinaryFile() does, but without reading the data
+          records. Records are then located by their index, computed from the
+          start time and the (fixed) interval of the file, and used in place,
+          so that a lookup never reads or copies a record and costs the same
+          anywhere in the file. Pages of the file are loaded on first use and
+          are shared by all objects and processes that map the same file.
+          The file must have been written by writeBinaryFile() on this
+          platform and must not contain gaps; use initializeWithBinaryFile()
+          otherwise. Only the first and last records are checked here, so
+          that no other page is loaded; a time that is not found in the
+          record at its computed index, or a neighbor of it, is out of
+          range (seekToJD() returns -2).
+          @param filename  name of binary file to be mapped.
+          @return 0 success,
+                 -4 header could not be read.
+          @throw Exception if the file cannot be opened or mapped, or if its
+                     first and last records are not evenly spaced at the
+                     header interval.
+         */
+      int initializeWithMappedFile(const std::string& filename);
+
       //------------------------------------------------------------------
       // utilizing the ephemeris
 
@@ -387,10 +417,15 @@ namespace gnsstk
          */
       int readBinaryRecord(std::vector<double>& data_vector);
 
+         /// Release the mapping made by initializeWithMappedFile(), if any.
+      void unmapFile();
+
          /**
           Search the data records of the file opened by
           initializeWithBinaryFile() and read the one whose time limits include
-          the given time. May be called only after initializeWithBinaryFile().
+          the given time; or, for a file opened by initializeWithMappedFile(),
+          compute the index of that record and point to it in the mapping.
+          May be called only after one of the initialize functions.
           @param JD the time (Julian Date) of interest
           @return 0 success, or
                  -1 given time is before the first record in the file,
@@ -533,6 +568,18 @@ namespace gnsstk
          */
       std::vector<double> coefficients;
 
+         /**
+          The current record, used by inertialPositionVelocity(); seekToJD()
+          points it either at coefficients or into the mapped file.
+         */
+      const double *record;
+
+         /// Start and length of the mapping made by initializeWithMappedFile().
+      void *mapBase;
+      size_t mapLength; ///< length in bytes of the mapping
+      const double *mapData; ///< first data record in the mapping
+      long mapNrec;          ///< number of data records in the mapping
+
    }; // end class SolarSystemEphemeris
 
 } // end namespace gnsstk
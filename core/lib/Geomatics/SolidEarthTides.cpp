@@ -51,12 +51,167 @@
 // GNSSTk
 // geomatics
 #include "SolidEarthTides.hpp"
+#include "SolidEarthTidesData.hpp"
 #include "logstream.hpp"
 
 using namespace std;
 
 namespace gnsstk
 {
+   namespace SolidEarthTidesData
+   {
+      const double REarth = 6378136.55;
+
+      const double Love3 = 0.292, Shida3 = 0.015;
+
+      const double step2diurnalData[9 * 31] = {
+         -3., 0.,  2.,  0.,  0.,  -0.01, -0.01, 0.0,   0.0,
+         -3., 2.,  0.,  0.,  0.,  -0.01, -0.01, 0.0,   0.0,
+         -2., 0.,  1.,  -1., 0.,  -0.02, -0.01, 0.0,   0.0,
+         -2., 0.,  1.,  0.,  0.,  -0.08, 0.00,  0.01,  0.01,
+         -2., 2.,  -1., 0.,  0.,  -0.02, -0.01, 0.0,   0.0,
+         -1., 0.,  0.,  -1., 0.,  -0.10, 0.00,  0.00,  0.00,
+         -1., 0.,  0.,  0.,  0.,  -0.51, 0.00,  -0.02, 0.03,
+         -1., 2.,  0.,  0.,  0.,  0.01,  0.0,   0.0,   0.0,
+         0.,  -2., 1.,  0.,  0.,  0.01,  0.0,   0.0,   0.0,
+         0.,  0.,  -1., 0.,  0.,  0.02,  0.01,  0.0,   0.0,
+         0.,  0.,  1.,  0.,  0.,  0.06,  0.00,  0.00,  0.00,
+         0.,  0.,  1.,  1.,  0.,  0.01,  0.0,   0.0,   0.0,
+         0.,  2.,  -1., 0.,  0.,  0.01,  0.0,   0.0,   0.0,
+         1.,  -3., 0.,  0.,  1.,  -0.06, 0.00,  0.00,  0.00,
+         1.,  -2., 0.,  1.,  0.,  0.01,  0.0,   0.0,   0.0,
+         1.,  -2., 0.,  0.,  0.,  -1.23, -0.07, 0.06,  0.01,
+         1.,  -1., 0.,  0.,  -1., 0.02,  0.0,   0.0,   0.0,
+         1.,  -1., 0.,  0.,  1.,  0.04,  0.0,   0.0,   0.0,
+         1.,  0.,  0.,  -1., 0.,  -0.22, 0.01,  0.01,  0.00,
+         1.,  0.,  0.,  0.,  0.,  12.00, -0.78, -0.67, -0.03,
+         1.,  0.,  0.,  1.,  0.,  1.73,  -0.12, -0.10, 0.00,
+         1.,  0.,  0.,  2.,  0.,  -0.04, 0.0,   0.0,   0.0,
+         1.,  1.,  0.,  0.,  -1., -0.50, -0.01, 0.03,  0.00,
+         1.,  1.,  0.,  0.,  1.,  0.01,  0.0,   0.0,   0.0,
+         1.,  1.,  0.,  1.,  -1., -0.01, 0.0,   0.0,   0.0,
+         1.,  2.,  -2., 0.,  0.,  -0.01, 0.0,   0.0,   0.0,
+         1.,  2.,  0.,  0.,  0.,  -0.11, 0.01,  0.01,  0.00,
+         2.,  -2., 1.,  0.,  0.,  -0.01, 0.0,   0.0,   0.0,
+         2.,  0.,  -1., 0.,  0.,  -0.02, 0.02,  0.0,   0.01,
+         3.,  0.,  0.,  0.,  0.,  0.0,   0.01,  0.0,   0.01,
+         3.,  0.,  0.,  1.,  0.,  0.0,   0.01,  0.0,   0.0};
+
+      const double step2longData[9 * 5] = {
+         0, 0, 0,  1, 0, 0.47,  0.23,  0.16,  0.07,
+         0, 2, 0,  0, 0, -0.20, -0.12, -0.11, -0.05,
+         1, 0, -1, 0, 0, -0.11, -0.08, -0.09, -0.04,
+         2, 0, 0,  0, 0, -0.13, -0.11, -0.15, -0.07,
+         2, 0, 0,  1, 0, -0.05, -0.05, -0.06, -0.03};
+
+      //------------------------------------------------------------------------------
+      void nominalLoveShida(double sinlat, const IERSConvention& iers,
+                            double& Love, double& Shida)
+      {
+         double poly = (3.0 * sinlat * sinlat - 1.0) / 2.0;
+
+            // here is the only difference between 1996 and 2003/10
+         if (iers == IERSConvention::IERS1996)
+         {
+            Love  = 0.6026 - 0.0006 * poly;
+            Shida = 0.0831 + 0.0002 * poly;
+         }
+         else
+         { // 2003 or 2010
+            Love  = 0.6078 - 0.0006 * poly;
+            Shida = 0.0847 + 0.0002 * poly;
+         }
+      }
+
+      //------------------------------------------------------------------------------
+      void tideArguments(const EphTime& ttag, double& tau, double& s,
+                         double& h, double& p, double& zns, double& ps)
+      {
+         EphTime TT(ttag);
+         TT.convertSystemTo(TimeSystem::TT);
+         double T, fhr, fmjd = TT.dMJD();
+         T   = (fmjd - 51544.0) / 36525.0; // MJD of J2000 is 51544.0
+         fhr = (fmjd - int(fmjd)) * 24.0;
+
+         double T2 = T * T;
+         double T3 = T2 * T;
+         double T4 = T3 * T;
+         double pr;
+         s = 218.31664563 + 481267.88194 * T - 0.0014663889 * T2 +
+             0.00000185139 * T3;
+         tau = fhr * 15. + 280.4606184 + 36000.7700536 * T +
+               0.00038793 * T2 - 0.0000000258 * T3;
+         tau = tau - s;
+         pr  = 1.396971278 * T + 0.000308889 * T2 + 0.000000021 * T3 +
+              0.000000007 * T4;
+         s = s + pr;
+         h = 280.46645 + 36000.7697489 * T + 0.00030322222 * T2 +
+             0.000000020 * T3 - 0.00000000654 * T4;
+         p = 83.35324312 + 4069.01363525 * T - 0.01032172222 * T2 -
+             0.0000124991 * T3 + 0.00000005263 * T4;
+         zns = 234.95544499 + 1934.13626197 * T - 0.00207561111 * T2 -
+               0.00000213944 * T3 + 0.00000001650 * T4;
+         ps = 282.93734098 + 1.71945766667 * T + 0.00045688889 * T2 -
+              0.00000001778 * T3 - 0.00000000334 * T4;
+         s   = fmod(s, 360.0);
+         tau = fmod(tau, 360.0);
+         h   = fmod(h, 360.0);
+         p   = fmod(p, 360.0);
+         zns = fmod(zns, 360.0);
+         ps  = fmod(ps, 360.0);
+      }
+
+      //------------------------------------------------------------------------------
+      void poleWobble(const EphTime& ttag, double xp, double yp,
+                      const IERSConvention& iers, double& m1, double& m2,
+                      double& upcoef)
+      {
+         if (iers == IERSConvention::IERS1996)
+         {               // 1996
+            m1     = xp; // arcsec
+            m2     = yp; // arcsec
+            upcoef = 0.032;
+            return;
+         }
+
+            // 2003 and 2010
+            // compute time since J2000 in years and mean pole wander
+         double dt((ttag.dMJD() - 51544.5) / 365.25);
+         double xmean, ymean;
+            // mean sums in milliarcsec
+         if (iers == IERSConvention::IERS2003)
+         {
+            xmean  = (0.054 + 0.00083 * dt) / 1000.0; // convert to arcsec
+            ymean  = (0.357 + 0.00395 * dt) / 1000.0; // convert to arcsec
+            upcoef = 0.032;
+         }
+         else
+         { // 2010
+               // mean sums are different until 2010 and after 2010 (in
+               // milliarcsec)
+            if (ttag.year() > 2010)
+            {
+               xmean = 23.513 + 7.6141 * dt;
+               ymean = 358.891 - 0.6287 * dt;
+            }
+            else
+            {
+               xmean =
+                  55.974 + (1.8243 + (0.18413 + 0.007024 * dt) * dt) * dt;
+               ymean =
+                  346.346 + (1.7896 - (0.10729 + 0.000908 * dt) * dt) * dt;
+            }
+            xmean /= 1000.0; // convert to arcsec
+            ymean /= 1000.0; // convert to arcsec
+               //  is this 33 a typo in Tech Note 36? other years are 32
+            upcoef = 0.033;
+         }
+         m1 = (xp - xmean);  // arcsec
+         m2 = -(yp - ymean); // arcsec
+      }
+
+   } // end namespace SolidEarthTidesData
+
    //---------------------------------------------------------------------------------
       /* Compute the site displacement due to solid Earth tides for the given
          Position (assumed to be fixed to the solid Earth) at the given time, given
@@ -89,8 +244,9 @@ namespace gnsstk
                  GNSSTK_THROW(e);
            } */
 
-            // Use REarth from solid.f example program
-         static const double REarth = 6378136.55;
+         using SolidEarthTidesData::REarth;
+         using SolidEarthTidesData::step2diurnalData;
+         using SolidEarthTidesData::step2longData;
          static bool debug    = (LOGlevel >= DEBUG7);
             // NB icount is a dummy used in test vs solid.f
          int i, icount(-1);
@@ -184,20 +340,8 @@ namespace gnsstk
 
             // Step 1a IERS(1996) eq. (8) pg 61.
             // nominal degree 2 Love and Shida numbers pg 60
-         double poly = sinlat;
-         poly        = (3.0 * poly * poly - 1.0) / 2.0;
-
-            // here is the only difference between 1996 and 2003/10
-         if (iers == IERSConvention::IERS1996)
-         {
-            Love  = 0.6026 - 0.0006 * poly;
-            Shida = 0.0831 + 0.0002 * poly;
-         }
-         else
-         { // 2003 or 2010
-            Love  = 0.6078 - 0.0006 * poly;
-            Shida = 0.0847 + 0.0002 * poly;
-         }
+         double poly = (3.0 * sinlat * sinlat - 1.0) / 2.0;
+         SolidEarthTidesData::nominalLoveShida(sinlat, iers, Love, Shida);
          LOG(DEBUG6) << "H2L2 " << setw(4) << icount << fixed
                      << setprecision(15) << " " << setw(18) << Love << " "
                      << setw(18) << Shida << " " << setw(18) << poly;
@@ -222,8 +366,8 @@ namespace gnsstk
             // Step 1b IERS(1996) eq. (9) pg 61.
             // nominal degree 3 Love and Shida numbers pg 60
          double Shida2 = Shida;
-         Love          = 0.292;
-         Shida         = 0.015;
+         Love          = SolidEarthTidesData::Love3;
+         Shida         = SolidEarthTidesData::Shida3;
          tmp           = sunFactor * REoRS *
                (Love * (2.5 * sunDOTrx * sunDOTrx - 1.5) * sunDOTrx * rx +
                 Shida * (7.5 * sunDOTrx * sunDOTrx - 1.5) * tSun);
@@ -449,76 +593,10 @@ namespace gnsstk
          }
 
             // Step 2a IERS(1996) eq. (15) pg 63.
-            // frequency dependence of Love and Shida from diurnal band
-         static double step2diurnalData[9 * 31] = {
-            -3., 0.,  2.,  0.,  0.,  -0.01, -0.01, 0.0,   0.0,
-            -3., 2.,  0.,  0.,  0.,  -0.01, -0.01, 0.0,   0.0,
-            -2., 0.,  1.,  -1., 0.,  -0.02, -0.01, 0.0,   0.0,
-            -2., 0.,  1.,  0.,  0.,  -0.08, 0.00,  0.01,  0.01,
-            -2., 2.,  -1., 0.,  0.,  -0.02, -0.01, 0.0,   0.0,
-            -1., 0.,  0.,  -1., 0.,  -0.10, 0.00,  0.00,  0.00,
-            -1., 0.,  0.,  0.,  0.,  -0.51, 0.00,  -0.02, 0.03,
-            -1., 2.,  0.,  0.,  0.,  0.01,  0.0,   0.0,   0.0,
-            0.,  -2., 1.,  0.,  0.,  0.01,  0.0,   0.0,   0.0,
-            0.,  0.,  -1., 0.,  0.,  0.02,  0.01,  0.0,   0.0,
-            0.,  0.,  1.,  0.,  0.,  0.06,  0.00,  0.00,  0.00,
-            0.,  0.,  1.,  1.,  0.,  0.01,  0.0,   0.0,   0.0,
-            0.,  2.,  -1., 0.,  0.,  0.01,  0.0,   0.0,   0.0,
-            1.,  -3., 0.,  0.,  1.,  -0.06, 0.00,  0.00,  0.00,
-            1.,  -2., 0.,  1.,  0.,  0.01,  0.0,   0.0,   0.0,
-            1.,  -2., 0.,  0.,  0.,  -1.23, -0.07, 0.06,  0.01,
-            1.,  -1., 0.,  0.,  -1., 0.02,  0.0,   0.0,   0.0,
-            1.,  -1., 0.,  0.,  1.,  0.04,  0.0,   0.0,   0.0,
-            1.,  0.,  0.,  -1., 0.,  -0.22, 0.01,  0.01,  0.00,
-            1.,  0.,  0.,  0.,  0.,  12.00, -0.78, -0.67, -0.03,
-            1.,  0.,  0.,  1.,  0.,  1.73,  -0.12, -0.10, 0.00,
-            1.,  0.,  0.,  2.,  0.,  -0.04, 0.0,   0.0,   0.0,
-            1.,  1.,  0.,  0.,  -1., -0.50, -0.01, 0.03,  0.00,
-            1.,  1.,  0.,  0.,  1.,  0.01,  0.0,   0.0,   0.0,
-            1.,  1.,  0.,  1.,  -1., -0.01, 0.0,   0.0,   0.0,
-            1.,  2.,  -2., 0.,  0.,  -0.01, 0.0,   0.0,   0.0,
-            1.,  2.,  0.,  0.,  0.,  -0.11, 0.01,  0.01,  0.00,
-            2.,  -2., 1.,  0.,  0.,  -0.01, 0.0,   0.0,   0.0,
-            2.,  0.,  -1., 0.,  0.,  -0.02, 0.02,  0.0,   0.01,
-            3.,  0.,  0.,  0.,  0.,  0.0,   0.01,  0.0,   0.01,
-            3.,  0.,  0.,  1.,  0.,  0.0,   0.01,  0.0,   0.0};
-
-            // times
-         EphTime TT(ttag);
-         TT.convertSystemTo(TimeSystem::TT);
-         double T, fhr, fmjd = TT.dMJD();
-         T   = (fmjd - 51544.0) / 36525.0; // MJD of J2000 is 51544.0
-         fhr = (fmjd - int(fmjd)) * 24.0;
-
-            // compute standard arguments
-         double s, tau, pr, h, p, zns, ps;
-         {
-            double T2 = T * T;
-            double T3 = T2 * T;
-            double T4 = T3 * T;
-            s         = 218.31664563 + 481267.88194 * T - 0.0014663889 * T2 +
-                0.00000185139 * T3;
-            tau = fhr * 15. + 280.4606184 + 36000.7700536 * T +
-                  0.00038793 * T2 - 0.0000000258 * T3;
-            tau = tau - s;
-            pr  = 1.396971278 * T + 0.000308889 * T2 + 0.000000021 * T3 +
-                 0.000000007 * T4;
-            s = s + pr;
-            h = 280.46645 + 36000.7697489 * T + 0.00030322222 * T2 +
-                0.000000020 * T3 - 0.00000000654 * T4;
-            p = 83.35324312 + 4069.01363525 * T - 0.01032172222 * T2 -
-                0.0000124991 * T3 + 0.00000005263 * T4;
-            zns = 234.95544499 + 1934.13626197 * T - 0.00207561111 * T2 -
-                  0.00000213944 * T3 + 0.00000001650 * T4;
-            ps = 282.93734098 + 1.71945766667 * T + 0.00045688889 * T2 -
-                 0.00000001778 * T3 - 0.00000000334 * T4;
-            s   = fmod(s, 360.0);
-            tau = fmod(tau, 360.0);
-            h   = fmod(h, 360.0);
-            p   = fmod(p, 360.0);
-            zns = fmod(zns, 360.0);
-            ps  = fmod(ps, 360.0);
-         }
+            // frequency dependence of Love and Shida from diurnal band,
+            // table step2diurnalData; compute standard arguments
+         double s, tau, h, p, zns, ps;
+         SolidEarthTidesData::tideArguments(ttag, tau, s, h, p, zns, ps);
 
          double thetaf, ctl, stl, dr, dn, de;
          tmp = Triple(0, 0, 0);
@@ -588,14 +666,8 @@ namespace gnsstk
                for(i=0; i<3; i++) tmp[i] -= dr*up[i];
 
                Step 2b IERS(1996) eq. (16) pg 64.
-               frequency dependence of Love and Shida from the long period band */
-         static double step2longData[9 * 5] = {
-            0, 0, 0,  1, 0, 0.47,  0.23,  0.16,  0.07,
-            0, 2, 0,  0, 0, -0.20, -0.12, -0.11, -0.05,
-            1, 0, -1, 0, 0, -0.11, -0.08, -0.09, -0.04,
-            2, 0, 0,  0, 0, -0.13, -0.11, -0.15, -0.07,
-            2, 0, 0,  1, 0, -0.05, -0.05, -0.06, -0.03};
-
+               frequency dependence of Love and Shida from the long period band,
+               table step2longData */
          tmp = Triple(0, 0, 0);
          for (i = 0; i < 5; i++)
          {
@@ -715,49 +787,7 @@ namespace gnsstk
       try
       {
          double m1, m2, upcoef;
-
-         if (iers == IERSConvention::IERS1996)
-         {               // 1996
-            m1     = xp; // arcsec
-            m2     = yp; // arcsec
-            upcoef = 0.032;
-         }
-         else
-         { // 2003 and 2010
-               // compute time since J2000 in years and mean pole wander
-            double dt((ttag.dMJD() - 51544.5) / 365.25);
-            double xmean, ymean;
-               // mean sums in milliarcsec
-            if (iers == IERSConvention::IERS2003)
-            {
-               xmean  = (0.054 + 0.00083 * dt) / 1000.0; // convert to arcsec
-               ymean  = (0.357 + 0.00395 * dt) / 1000.0; // convert to arcsec
-               upcoef = 0.032;
-            }
-            else
-            { // 2003 and 2010
-                  // mean sums are different until 2010 and after 2010 (in
-                  // milliarcsec)
-               if (ttag.year() > 2010)
-               {
-                  xmean = 23.513 + 7.6141 * dt;
-                  ymean = 358.891 - 0.6287 * dt;
-               }
-               else
-               {
-                  xmean =
-                     55.974 + (1.8243 + (0.18413 + 0.007024 * dt) * dt) * dt;
-                  ymean =
-                     346.346 + (1.7896 - (0.10729 + 0.000908 * dt) * dt) * dt;
-               }
-               xmean /= 1000.0; // convert to arcsec
-               ymean /= 1000.0; // convert to arcsec
-                  //  is this 33 a typo in Tech Note 36? other years are 32
-               upcoef = 0.033;
-            }
-            m1 = (xp - xmean);  // arcsec
-            m2 = -(yp - ymean); // arcsec
-         }
+         SolidEarthTidesData::poleWobble(ttag, xp, yp, iers, m1, m2, upcoef);
          LOG(DEBUG7) << " poletide means " << iers << fixed << setprecision(15)
                      << " " << m1 << " " << m2;
 
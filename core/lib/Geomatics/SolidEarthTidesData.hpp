@@ -0,0 +1,116 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file SolidEarthTidesData.hpp
+    Tables and pieces of the IERS solid Earth tide and pole tide models that
+    are shared by computeSolidEarthTides(), computePolarTides() and class
+    BatchTides. This is internal to those implementations and is not part of
+    the public interface; the definitions are in SolidEarthTides.cpp. */
+
+//------------------------------------------------------------------------------------
+#ifndef SOLID_EARTH_TIDES_DATA_INCLUDE
+#define SOLID_EARTH_TIDES_DATA_INCLUDE
+
+//------------------------------------------------------------------------------------
+// GNSSTk
+#include "EphTime.hpp"
+#include "IERSConvention.hpp"
+
+namespace gnsstk
+{
+   namespace SolidEarthTidesData
+   {
+         /// Radius of the Earth (m), from the solid.f example program
+      extern const double REarth;
+
+         /// Nominal degree 3 Love and Shida numbers, IERS(1996) pg 60
+      extern const double Love3, Shida3;
+
+         /** Frequency dependence of Love and Shida numbers from the diurnal
+          * band, IERS(1996) eq. (15) pg 63. Each of the 31 rows is the
+          * multipliers of s, h, p, N' and ps, then the in phase and out of
+          * phase corrections (mm) to the radial and to the transverse
+          * displacement. */
+      extern const double step2diurnalData[9 * 31];
+
+         /** Frequency dependence of Love and Shida numbers from the long
+          * period band, IERS(1996) eq. (16) pg 64; 5 rows laid out as in
+          * step2diurnalData. */
+      extern const double step2longData[9 * 5];
+
+         /**
+          Compute the nominal degree 2 Love and Shida numbers, IERS(1996) pg
+          60, with their latitude dependence.
+          @param sinlat sine of the geocentric latitude of the site.
+          @param iers IERS convention to use.
+          @param Love output degree 2 Love number h2.
+          @param Shida output degree 2 Shida number l2.
+         */
+      void nominalLoveShida(double sinlat, const IERSConvention& iers,
+                            double& Love, double& Shida);
+
+         /**
+          Compute the arguments (degrees, modulo 360) of the frequency
+          dependent corrections of step 2, IERS(1996) eqs. (15) and (16).
+          @param ttag time of interest; converted to TT.
+          @param tau,s,h,p,zns,ps output arguments in degrees.
+          @throw Exception if the time system conversion fails.
+         */
+      void tideArguments(const EphTime& ttag, double& tau, double& s,
+                         double& h, double& p, double& zns, double& ps);
+
+         /**
+          Compute the wobble parameters m1 and m2 (arcsec), the offsets of
+          the pole from the mean pole, and the coefficient of the radial
+          pole tide, for the given IERS convention. IERS(1996) ch. 7 pg 67,
+          IERS(2003) ch. 7 pg 83-84 and IERS(2010) ch. 7 pg 114-116.
+          @param ttag time of interest.
+          @param xp,yp polar motion angles in arcsec.
+          @param iers IERS convention to use.
+          @param m1,m2 output wobble parameters in arcsec.
+          @param upcoef output coefficient of the radial displacement.
+         */
+      void poleWobble(const EphTime& ttag, double xp, double yp,
+                      const IERSConvention& iers, double& m1, double& m2,
+                      double& upcoef);
+
+   } // end namespace SolidEarthTidesData
+
+} // end namespace gnsstk
+
+#endif // SOLID_EARTH_TIDES_DATA_INCLUDE
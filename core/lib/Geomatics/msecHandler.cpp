@@ -84,7 +84,7 @@ namespace gnsstk
    void msecHandler::reset()
    {
       // don't reset dt
-      prevttag = currttag = CommonTime::BEGINNING_OF_TIME;
+      prevttag = currttag = lastttag = CommonTime::BEGINNING_OF_TIME;
       curr                = vector<map<SatID, double>>(N);
       past                = vector<map<SatID, double>>(N);
       ave                 = vector<double>(N, 0.0);
@@ -357,7 +357,6 @@ namespace gnsstk
    {
       size_t i, j;
       int ii, in, nadj;
-      static CommonTime lastttag(CommonTime::BEGINNING_OF_TIME);
       const static double mstol(0.2);
 
       if (prevttag != CommonTime::BEGINNING_OF_TIME)
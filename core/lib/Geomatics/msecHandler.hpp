@@ -75,6 +75,7 @@ namespace gnsstk
          obstypes;                     ///< obstypes to monitor (L1 L2 C1 C2 P1 P2)
       std::vector<double> wavelengths; ///< wavelengths of obstypes - 0 for code
       CommonTime prevttag, currttag;   ///< for tracking timetags internally
+      CommonTime lastttag;             ///< time of the last adjust found
       // keep the following parallel
       std::vector<std::map<SatID, double>> curr,
          past;                         ///< storing data internally
@@ -0,0 +1,722 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file FixedMatrix.hpp
+ * Matrix with dimensions fixed at compile time and inline storage,
+ * with its decompositions and inverses.
+ */
+
+#ifndef GNSSTK_FIXEDMATRIX_HPP
+#define GNSSTK_FIXEDMATRIX_HPP
+
+#include "Matrix.hpp"
+#include "FixedVector.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup MathGroup
+      //@{
+
+      /**
+       * An R by C matrix whose storage is a member array (row major),
+       * so that creating, copying and returning one never touches the
+       * heap.  Every temporary in an expression of Matrix<T> objects
+       * is a heap allocation, which dominates the cost of the 3x3
+       * to 8x8 problems found in rotations, frame transformations
+       * and small least squares problems; FixedMatrix is meant for
+       * those.
+       *
+       * FixedMatrix derives from RefMatrixBase, so it works with
+       * every function and operator written for ConstMatrixBase
+       * (those return a Matrix<T>), and converts to and from
+       * Matrix<T>.  The operators, decompositions and inverses in
+       * this file take and return fixed types when all operands are
+       * fixed, and the dimensions are checked by the compiler.
+       *
+       * @code
+       * FixedMatrix<double,3,3> R(rotation<double>(angle, 3));
+       * FixedVector<double,3> x(array), y;
+       * y = R * x;                        // no allocation
+       * FixedMatrix<double,3,3> Ri(inverseLUD(R));
+       * Matrix<double> M(Ri);             // to the dynamic type
+       * @endcode
+       */
+   template <class T, size_t R, size_t C>
+   class FixedMatrix : public RefMatrixBase<T, FixedMatrix<T,R,C> >
+   {
+   public:
+         /// STL value_type
+      typedef T value_type;
+         /// STL reference type
+      typedef T& reference;
+         /// STL const reference type
+      typedef const T& const_reference;
+         /// STL iterator type (row major)
+      typedef T* iterator;
+         /// STL const iterator type (row major)
+      typedef const T* const_iterator;
+
+         /// Default constructor; the elements are not initialized.
+      FixedMatrix()
+      {}
+         /// Set every element to the given value.
+      explicit FixedMatrix(const T initialValue)
+      { this->assignFrom(initialValue); }
+         /// Copy R*C elements of an array, in row major order.
+      explicit FixedMatrix(const T* array)
+      { this->assignFrom(array); }
+         /** Copy any R by C matrix (e.g. Matrix<T>).
+          * @throw MatrixException if the dimensions do not match. */
+      template <class BaseClass>
+      FixedMatrix(const ConstMatrixBase<T, BaseClass>& mat)
+      {
+         checkDimensions(mat.rows(), mat.cols());
+         this->assignFrom(mat);
+      }
+
+         /** Copy any R by C matrix.
+          * @throw MatrixException if the dimensions do not match. */
+      template <class BaseClass>
+      FixedMatrix& operator=(const ConstMatrixBase<T, BaseClass>& mat)
+      {
+         checkDimensions(mat.rows(), mat.cols());
+         return this->assignFrom(mat);
+      }
+         /// Set every element to the given value.
+      FixedMatrix& operator=(const T t)
+      { return this->assignFrom(t); }
+
+         /// STL begin, row major
+      iterator begin() { return m; }
+         /// STL const begin, row major
+      const_iterator begin() const { return m; }
+         /// STL end
+      iterator end() { return m + R*C; }
+         /// STL const end
+      const_iterator end() const { return m + R*C; }
+         /// STL size
+      size_t size() const { return R*C; }
+         /// STL empty
+      bool empty() const { return R*C == 0; }
+         /// The number of rows in the matrix
+      size_t rows() const { return R; }
+         /// The number of columns in the matrix
+      size_t cols() const { return C; }
+
+         /// Non-const matrix operator(row,col)
+      T& operator() (size_t rowNum, size_t colNum)
+      { return m[rowNum*C + colNum]; }
+         /// Const matrix operator(row,col)
+      T operator() (size_t rowNum, size_t colNum) const
+      { return m[rowNum*C + colNum]; }
+
+         /// Swap two rows.
+      FixedMatrix& swapRows(size_t ra, size_t rb)
+      {
+         for (size_t j = 0; j < C; j++)
+            std::swap(m[ra*C + j], m[rb*C + j]);
+         return *this;
+      }
+         /// Swap two columns.
+      FixedMatrix& swapCols(size_t ca, size_t cb)
+      {
+         for (size_t i = 0; i < R; i++)
+            std::swap(m[i*C + ca], m[i*C + cb]);
+         return *this;
+      }
+
+   private:
+         /// @throw MatrixException unless rows == R and cols == C
+      static void checkDimensions(size_t rows, size_t cols)
+      {
+         if (rows != R || cols != C)
+         {
+            MatrixException e("FixedMatrix dimensions do not match source");
+            GNSSTK_THROW(e);
+         }
+      }
+
+         /// The elements, in row major order.
+      T m[R*C];
+   };
+
+      /// Row by column product of two fixed matrices.
+   template <class T, size_t R, size_t K, size_t C>
+   inline FixedMatrix<T,R,C> operator*(const FixedMatrix<T,R,K>& l,
+                                       const FixedMatrix<T,K,C>& r)
+   {
+      FixedMatrix<T,R,C> toReturn;
+      for (size_t i = 0; i < R; i++)
+      {
+         for (size_t j = 0; j < C; j++)
+         {
+            T sum(0);
+            for (size_t k = 0; k < K; k++)
+               sum += l(i,k) * r(k,j);
+            toReturn(i,j) = sum;
+         }
+      }
+      return toReturn;
+   }
+
+      /// Product of a fixed matrix and a fixed (column) vector.
+   template <class T, size_t R, size_t C>
+   inline FixedVector<T,R> operator*(const FixedMatrix<T,R,C>& l,
+                                     const FixedVector<T,C>& r)
+   {
+      FixedVector<T,R> toReturn;
+      for (size_t i = 0; i < R; i++)
+      {
+         T sum(0);
+         for (size_t j = 0; j < C; j++)
+            sum += l(i,j) * r[j];
+         toReturn[i] = sum;
+      }
+      return toReturn;
+   }
+
+      /// Product of a fixed (row) vector and a fixed matrix.
+   template <class T, size_t R, size_t C>
+   inline FixedVector<T,C> operator*(const FixedVector<T,R>& l,
+                                     const FixedMatrix<T,R,C>& r)
+   {
+      FixedVector<T,C> toReturn;
+      for (size_t j = 0; j < C; j++)
+      {
+         T sum(0);
+         for (size_t i = 0; i < R; i++)
+            sum += l[i] * r(i,j);
+         toReturn[j] = sum;
+      }
+      return toReturn;
+   }
+
+      /// Sum of two fixed matrices.
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T,R,C> operator+(const FixedMatrix<T,R,C>& l,
+                                       const FixedMatrix<T,R,C>& r)
+   {
+      FixedMatrix<T,R,C> toReturn;
+      for (size_t i = 0; i < R; i++)
+         for (size_t j = 0; j < C; j++)
+            toReturn(i,j) = l(i,j) + r(i,j);
+      return toReturn;
+   }
+
+      /// Difference of two fixed matrices.
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T,R,C> operator-(const FixedMatrix<T,R,C>& l,
+                                       const FixedMatrix<T,R,C>& r)
+   {
+      FixedMatrix<T,R,C> toReturn;
+      for (size_t i = 0; i < R; i++)
+         for (size_t j = 0; j < C; j++)
+            toReturn(i,j) = l(i,j) - r(i,j);
+      return toReturn;
+   }
+
+      /// Product of a fixed matrix and a scalar.
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T,R,C> operator*(const FixedMatrix<T,R,C>& l, const T d)
+   {
+      FixedMatrix<T,R,C> toReturn;
+      for (size_t i = 0; i < R; i++)
+         for (size_t j = 0; j < C; j++)
+            toReturn(i,j) = l(i,j) * d;
+      return toReturn;
+   }
+
+      /// Product of a scalar and a fixed matrix.
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T,R,C> operator*(const T d, const FixedMatrix<T,R,C>& r)
+   { return r * d; }
+
+      /// Transpose of a fixed matrix.
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T,C,R> transpose(const FixedMatrix<T,R,C>& m)
+   {
+      FixedMatrix<T,C,R> toReturn;
+      for (size_t i = 0; i < R; i++)
+         for (size_t j = 0; j < C; j++)
+            toReturn(j,i) = m(i,j);
+      return toReturn;
+   }
+
+
+      /**
+       * LU decomposition PA = LU of a fixed square matrix; see
+       * LUDecomp, whose algorithm and members this duplicates
+       * without heap storage.
+       */
+   template <class T, size_t N>
+   class FixedLUDecomp
+   {
+   public:
+      FixedLUDecomp() : parity(1) {}
+
+         /** Does the decomposition.
+          * @throw SingularMatrixException */
+      void operator() (const FixedMatrix<T,N,N>& m)
+      {
+         size_t i,j,k,imax(0);
+         T big,t,d;
+         FixedVector<T,N> V;
+
+         LU = m;
+         parity = 1;
+
+         for(i=0; i<N; i++) {    // get scale of each row
+            big = T(0);
+            for(j=0; j<N; j++) {
+               t = ABS(LU(i,j));
+               if(t > big) big=t;
+            }
+            if(big <= T(0)) {    // m is singular
+               SingularMatrixException e("singular matrix!");
+               GNSSTK_THROW(e);
+            }
+            V(i) = T(1)/big;
+         }
+
+         for(j=0; j<N; j++) {    // loop over columns
+            for(i=0; i<j; i++) {
+               t = LU(i,j);
+               for(k=0; k<i; k++) t -= LU(i,k)*LU(k,j);
+               LU(i,j) = t;
+            }
+            big = T(0);          // find largest pivot
+            for(i=j; i<N; i++) {
+               t = LU(i,j);
+               for(k=0; k<j; k++) t -= LU(i,k)*LU(k,j);
+               LU(i,j) = t;
+               d = V(i)*ABS(t);
+               if(d >= big) {
+                  big = d;
+                  imax = i;
+               }
+            }
+            if(j != imax) {
+               LU.swapRows(imax,j);
+               V(imax) = V(j);
+               parity = -parity;
+            }
+            Pivot(j) = imax;
+
+            t = LU(j,j);
+            if(t == T(0)) {      // m is singular
+               SingularMatrixException e("singular matrix!");
+               GNSSTK_THROW(e);
+            }
+            if(j != N-1) {
+               d = T(1)/t;
+               for(i=j+1; i<N; i++) LU(i,j) *= d;
+            }
+         }
+      }
+
+         /** Compute inverse(m)*v, where *this is LUD(m), via back
+          * substitution; the solution overwrites v.
+          * @throw MatrixException */
+      template <class BaseClass>
+      void backSub(RefVectorBase<T, BaseClass>& v) const
+      {
+         if(v.size() != N) {
+            MatrixException e("Vector size does not match dimension of LUDecomp");
+            GNSSTK_THROW(e);
+         }
+
+         bool first=true;
+         size_t i,j,ii(0);
+         T sum;
+
+            // un-pivot
+         for(i=0; i<N; i++) {
+            sum = v(Pivot(i));
+            v(Pivot(i)) = v(i);
+            if(first && sum != T(0)) {
+               ii = i;
+               first = false;
+            }
+            else for(j=ii; j<i; j++) sum -= LU(i,j)*v(j);
+            v(i) = sum;
+         }
+            // back substitution
+         for(i=N-1; ; i--) {
+            sum = v(i);
+            for(j=i+1; j<N; j++) sum -= LU(i,j)*v(j);
+            v(i) = sum / LU(i,i);
+            if(i == 0) break;       // b/c i is unsigned
+         }
+      }
+
+         /// compute determinant from LUD
+      T det() const
+      {
+         T d(static_cast<T>(parity));
+         for(size_t i=0; i<N; i++) d *= LU(i,i);
+         return d;
+      }
+
+         /// The matrix in LU-decomposed form: L and U together;
+         /// all diagonal elements of L are implied 1.
+      FixedMatrix<T,N,N> LU;
+         /// The pivot array
+      FixedVector<size_t,N> Pivot;
+         /// Parity
+      int parity;
+   };
+
+
+      /**
+       * Cholesky decomposition of a fixed square, positive definite
+       * matrix M = L*transpose(L) = U*transpose(U); see Cholesky,
+       * whose algorithm and members this duplicates without heap
+       * storage.
+       */
+   template <class T, size_t N>
+   class FixedCholesky
+   {
+   public:
+      FixedCholesky() {}
+
+         /** Does the decomposition.
+          * @throw MatrixException if m is not positive definite */
+      void operator() (const FixedMatrix<T,N,N>& m)
+      {
+         size_t i,j,k;
+         T d;
+         FixedMatrix<T,N,N> P(m);
+         U = T(0);
+
+         for(j=N-1; ; j--) {
+            if(P(j,j) <= T(0)) {
+               MatrixException e("Cholesky fails - eigenvalue <= 0");
+               GNSSTK_THROW(e);
+            }
+            U(j,j) = SQRT(P(j,j));
+            d = T(1)/U(j,j);
+            if(j > 0) {
+               for(k=0; k<j; k++) U(k,j)=d*P(k,j);
+               for(k=0; k<j; k++)
+                  for(i=0; i<=k; i++)
+                     P(i,k) -= U(k,j)*U(i,j);
+            }
+            if(j==0) break;      // since j is unsigned
+         }
+
+         P = m;
+         L = T(0);
+         for(j=0; j<N; j++) {
+            if(P(j,j) <= T(0)) {
+               MatrixException e("Cholesky fails - eigenvalue <= 0");
+               GNSSTK_THROW(e);
+            }
+            L(j,j) = SQRT(P(j,j));
+            d = T(1)/L(j,j);
+            for(k=j+1; k<N; k++) L(k,j)=d*P(k,j);
+            for(k=j+1; k<N; k++)
+               for(i=k; i<N; i++)
+                  P(i,k) -= L(i,j)*L(k,j);
+         }
+      }
+
+         /** Solve A*x=b where A = L*transpose(L) is the decomposed
+          * matrix; x is returned as b.
+          * @throw MatrixException */
+      template <class BaseClass>
+      void backSub(RefVectorBase<T, BaseClass>& b) const
+      {
+         if (b.size() != N)
+         {
+            MatrixException e("Vector size does not match dimension of Cholesky");
+            GNSSTK_THROW(e);
+         }
+         size_t i,j;
+         FixedVector<T,N> y;
+         y(0) = b(0)/L(0,0);
+         for(i=1; i<N; i++) {
+            y(i) = b(i);
+            for(j=0; j<i; j++) y(i)-=L(i,j)*y(j);
+            y(i) /= L(i,i);
+         }
+            // b is now x
+         for(i=N-1; ; i--) {
+            b(i) = y(i);
+            for(j=i+1; j<N; j++) b(i)-=L(j,i)*b(j);
+            b(i) /= L(i,i);
+            if(i==0) break;
+         }
+      }
+
+         /// Lower triangular and Upper triangular Cholesky decompositions
+      FixedMatrix<T,N,N> L, U;
+   };
+
+
+      /**
+       * Singular value decomposition A = U*S*transpose(V) of a fixed
+       * R by C matrix, R >= C, where U is R by C with orthonormal
+       * columns, S holds the C singular values and V is C by C and
+       * orthogonal; see SVD for the definitions.  This uses one-sided
+       * (Hestenes) Jacobi rotations, which are simple, accurate to
+       * full precision for small matrices and need no heap storage.
+       */
+   template <class T, size_t R, size_t C>
+   class FixedSVD
+   {
+   public:
+      FixedSVD() {}
+
+         /** Does the decomposition; singular values are sorted in
+          * descending order.
+          * @return false if the rotations did not converge. */
+      bool operator() (const FixedMatrix<T,R,C>& mat)
+      {
+         static_assert(R >= C, "FixedSVD requires rows >= columns");
+         const T eps(T(8)*std::numeric_limits<T>::epsilon());
+         size_t i,j,k,sweep;
+         bool rotated(true);
+
+         U = mat;
+         V = T(0);
+         for(i=0; i<C; i++) V(i,i) = T(1);
+
+         for(sweep=0; rotated && sweep<iterationMax; sweep++) {
+            rotated = false;
+            for(j=0; j+1<C; j++) {
+               for(k=j+1; k<C; k++) {
+                  T alpha(0), beta(0), gamma(0);
+                  for(i=0; i<R; i++) {
+                     alpha += U(i,j)*U(i,j);
+                     beta += U(i,k)*U(i,k);
+                     gamma += U(i,j)*U(i,k);
+                  }
+                  if(ABS(gamma) <= eps*SQRT(alpha*beta))
+                     continue;
+                  rotated = true;
+                  T zeta((beta-alpha)/(T(2)*gamma));
+                  T t((zeta >= T(0) ? T(1) : T(-1)) /
+                      (ABS(zeta) + SQRT(T(1)+zeta*zeta)));
+                  T c(T(1)/SQRT(T(1)+t*t)), s(c*t);
+                  for(i=0; i<R; i++) {
+                     T uj(U(i,j));
+                     U(i,j) = c*uj - s*U(i,k);
+                     U(i,k) = s*uj + c*U(i,k);
+                  }
+                  for(i=0; i<C; i++) {
+                     T vj(V(i,j));
+                     V(i,j) = c*vj - s*V(i,k);
+                     V(i,k) = s*vj + c*V(i,k);
+                  }
+               }
+            }
+         }
+
+            // singular values are the column norms; normalize U
+         for(j=0; j<C; j++) {
+            T sum(0);
+            for(i=0; i<R; i++) sum += U(i,j)*U(i,j);
+            S(j) = SQRT(sum);
+            if(S(j) > T(0))
+               for(i=0; i<R; i++) U(i,j) /= S(j);
+         }
+         sort();
+
+         return !rotated;
+      }
+
+         /** Solve A*x=b for x, where A [RxC] has been decomposed and
+          * b has length R; x (length C) is returned.  Like
+          * SVD::backSub, 1/0 is replaced by 0 for zero singular
+          * values. */
+      FixedVector<T,C> backSub(const FixedVector<T,R>& b) const
+      {
+         FixedVector<T,C> y(transpose(U) * b);
+         for(size_t j=0; j<C; j++)
+            y(j) = (S(j) == T(0) ? T(0) : y(j)/S(j));
+         return V * y;
+      }
+
+         /// compute determinant (of a square matrix, up to sign) from SVD
+      T det() const
+      {
+         T d(1);
+         for(size_t i=0; i<C; i++) d *= S(i);
+         return d;
+      }
+
+         /// Matrix U
+      FixedMatrix<T,R,C> U;
+         /// Vector of singular values
+      FixedVector<T,C> S;
+         /// Matrix V (not transpose(V))
+      FixedMatrix<T,C,C> V;
+
+   private:
+         /// sort singular values in descending order, with U and V
+      void sort()
+      {
+         for(size_t i=1; i<C; i++) {
+            for(size_t j=i; j>0 && S(j-1) < S(j); j--) {
+               std::swap(S(j-1), S(j));
+               U.swapCols(j-1, j);
+               V.swapCols(j-1, j);
+            }
+         }
+      }
+
+         /// maximum number of Jacobi sweeps
+      static const size_t iterationMax = 30;
+   };
+
+
+      /**
+       * Inverts a fixed square matrix by LU decomposition.
+       * @throw SingularMatrixException
+       */
+   template <class T, size_t N>
+   inline FixedMatrix<T,N,N> inverseLUD(const FixedMatrix<T,N,N>& m)
+   {
+      FixedMatrix<T,N,N> inv;
+      FixedVector<T,N> V;
+      FixedLUDecomp<T,N> LU;
+      LU(m);
+      for(size_t j=0; j<N; j++) {    // loop over columns
+         V = T(0);
+         V(j) = T(1);
+         LU.backSub(V);
+         for(size_t i=0; i<N; i++) inv(i,j)=V(i);
+      }
+      return inv;
+   }
+
+      /**
+       * Inverts a fixed square matrix by LU decomposition, and
+       * returns the determinant as well.
+       * @throw SingularMatrixException
+       */
+   template <class T, size_t N>
+   inline FixedMatrix<T,N,N> inverseLUD(const FixedMatrix<T,N,N>& m,
+                                        T& determ)
+   {
+      FixedMatrix<T,N,N> inv;
+      FixedVector<T,N> V;
+      FixedLUDecomp<T,N> LU;
+      LU(m);
+      determ = LU.det();
+      for(size_t j=0; j<N; j++) {
+         V = T(0);
+         V(j) = T(1);
+         LU.backSub(V);
+         for(size_t i=0; i<N; i++) inv(i,j)=V(i);
+      }
+      return inv;
+   }
+
+      /**
+       * Inverts a fixed square matrix; for the fixed types this is
+       * inverseLUD(), which is more stable than the Gauss-Jordan
+       * elimination used by inverse() on Matrix<T>.
+       * @throw SingularMatrixException
+       */
+   template <class T, size_t N>
+   inline FixedMatrix<T,N,N> inverse(const FixedMatrix<T,N,N>& m)
+   { return inverseLUD(m); }
+
+      /**
+       * Inverts a fixed square, symmetric, positive definite matrix
+       * using its Cholesky decomposition, m^-1 = inverse(L)^T *
+       * inverse(L).
+       * @throw MatrixException if m is not positive definite
+       */
+   template <class T, size_t N>
+   inline FixedMatrix<T,N,N> inverseChol(const FixedMatrix<T,N,N>& m)
+   {
+      size_t i,j,k;
+      FixedCholesky<T,N> CH;
+      CH(m);
+      FixedMatrix<T,N,N> LI(T(0));
+      for(i=0; i<N; i++) {
+         LI(i,i) = T(1) / CH.L(i,i);
+         for(j=0; j<i; j++) {
+            T sum(0);
+            for(k=j; k<i; k++) sum += CH.L(i,k)*LI(k,j);
+            LI(i,j) = -sum*LI(i,i);
+         }
+      }
+      return transpose(LI) * LI;
+   }
+
+      /**
+       * Inverts a fixed square matrix by SVD, editing the singular
+       * values using tolerance tol, as inverseSVD() does for
+       * Matrix<T>.
+       * @throw MatrixException on input of the zero matrix
+       */
+   template <class T, size_t N>
+   inline FixedMatrix<T,N,N> inverseSVD(const FixedMatrix<T,N,N>& m,
+                                        const T tol=T(1.e-8))
+   {
+      size_t i,j,k;
+      FixedSVD<T,N,N> svd;
+      svd(m);
+      if(svd.S(0) == T(0)) {
+         MatrixException e("Input is the zero matrix");
+         GNSSTK_THROW(e);
+      }
+         // edit singular values
+      for(i=1; i<N; i++) if(svd.S(i) < tol*svd.S(0)) svd.S(i)=T(0);
+         // inverse = V * inverse(S) * transpose(U)
+      FixedMatrix<T,N,N> inv;
+      for(i=0; i<N; i++) {
+         for(j=0; j<N; j++) {
+            T sum(0);
+            for(k=0; k<N; k++)
+               if(svd.S(k) != T(0)) sum += svd.V(i,k)*svd.U(j,k)/svd.S(k);
+            inv(i,j) = sum;
+         }
+      }
+      return inv;
+   }
+
+      //@}
+
+}  // namespace
+
+#endif
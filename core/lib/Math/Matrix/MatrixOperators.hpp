@@ -44,6 +44,7 @@
 #ifndef GNSSTK_MATRIX_OPERATORS_HPP
 #define GNSSTK_MATRIX_OPERATORS_HPP
 
+#include <algorithm>
 #include <limits>
 #include "MiscMath.hpp"
 #include "MatrixFunctors.hpp"
@@ -1029,6 +1030,315 @@ namespace gnsstk
       return temp -= d;
    }
 
+      /* Fused kernels for the products that build normal equations.
+       * Chains such as transpose(A)*W*A or A*B+C written with the
+       * operators above allocate a Matrix for every intermediate
+       * result; these evaluate the whole expression in one pass, into
+       * the returned Matrix only, and exploit the symmetry of the
+       * result where there is one.  Matrix is stored by column, so the
+       * loops run down columns, and the rows of A are taken in blocks
+       * of FUSED_BLOCK so that the block of every column stays in
+       * cache while all the pairs of columns are formed. */
+
+      /// Rows of A per block in the AtA()/AtWA() kernels.
+   const size_t FUSED_BLOCK = 64;
+
+      /**
+       * Compute transpose(A)*A, which is symmetric, in one pass.
+       */
+   template <class T, class BaseClass>
+   inline Matrix<T> AtA(const ConstMatrixBase<T, BaseClass>& A)
+   {
+      const size_t n = A.rows(), m = A.cols();
+      Matrix<T> N(m, m, T(0));
+      size_t i, j, k, i0, i1;
+      for (i0 = 0; i0 < n; i0 = i1)
+      {
+         i1 = std::min(n, i0 + FUSED_BLOCK);
+         for (k = 0; k < m; k++)
+            for (j = 0; j <= k; j++)
+            {
+               T sum(0);
+               for (i = i0; i < i1; i++)
+                  sum += A(i,j) * A(i,k);
+               N(j,k) += sum;
+            }
+      }
+      for (k = 0; k < m; k++)
+         for (j = 0; j < k; j++)
+            N(k,j) = N(j,k);
+
+      return N;
+   }
+
+      /**
+       * Compute transpose(A)*diag(w)*A, which is symmetric, in one
+       * pass; w holds the diagonal of a diagonal weight matrix.
+       * @throw MatrixException if the dimensions are incompatible
+       */
+   template <class T, class BaseClass1, class BaseClass2>
+   inline Matrix<T> AtWA(const ConstMatrixBase<T, BaseClass1>& A,
+                         const ConstVectorBase<T, BaseClass2>& w)
+   {
+      const size_t n = A.rows(), m = A.cols();
+      if (w.size() != n)
+      {
+         MatrixException e("Incompatible dimensions for AtWA(Matrix, Vector)");
+         GNSSTK_THROW(e);
+      }
+
+      Matrix<T> N(m, m, T(0));
+      size_t i, j, k, i0, i1;
+      for (i0 = 0; i0 < n; i0 = i1)
+      {
+         i1 = std::min(n, i0 + FUSED_BLOCK);
+         for (k = 0; k < m; k++)
+            for (j = 0; j <= k; j++)
+            {
+               T sum(0);
+               for (i = i0; i < i1; i++)
+                  sum += A(i,j) * w[i] * A(i,k);
+               N(j,k) += sum;
+            }
+      }
+      for (k = 0; k < m; k++)
+         for (j = 0; j < k; j++)
+            N(k,j) = N(j,k);
+
+      return N;
+   }
+
+      /**
+       * Compute transpose(A)*W*A in one pass, W being a full (n x n)
+       * weight matrix.  Each column of W*A is formed in turn in a
+       * single scratch Vector, rather than forming transpose(A) and
+       * two Matrix products.
+       * @throw MatrixException if the dimensions are incompatible
+       */
+   template <class T, class BaseClass1, class BaseClass2>
+   inline Matrix<T> AtWA(const ConstMatrixBase<T, BaseClass1>& A,
+                         const ConstMatrixBase<T, BaseClass2>& W)
+   {
+      const size_t n = A.rows(), m = A.cols();
+      if (W.rows() != n || W.cols() != n)
+      {
+         MatrixException e("Incompatible dimensions for AtWA(Matrix, Matrix)");
+         GNSSTK_THROW(e);
+      }
+
+      Matrix<T> N(m, m);
+      Vector<T> WA(n);
+      size_t i, j, k, l;
+      for (k = 0; k < m; k++)
+      {
+            // column k of W*A
+         WA = T(0);
+         for (l = 0; l < n; l++)
+         {
+            const T a(A(l,k));
+            if (a == T(0))
+               continue;
+            for (i = 0; i < n; i++)
+               WA[i] += W(i,l) * a;
+         }
+         for (j = 0; j < m; j++)
+         {
+            T sum(0);
+            for (i = 0; i < n; i++)
+               sum += A(i,j) * WA[i];
+            N(j,k) = sum;
+         }
+      }
+
+      return N;
+   }
+
+      /**
+       * Compute A*transpose(A), which is symmetric, in one pass.
+       */
+   template <class T, class BaseClass>
+   inline Matrix<T> AAt(const ConstMatrixBase<T, BaseClass>& A)
+   {
+      const size_t m = A.rows(), n = A.cols();
+      Matrix<T> N(m, m, T(0));
+      size_t i, j, k;
+         // sum of the outer products of the columns of A
+      for (k = 0; k < n; k++)
+         for (j = 0; j < m; j++)
+         {
+            const T a(A(j,k));
+            if (a == T(0))
+               continue;
+            for (i = 0; i <= j; i++)
+               N(i,j) += A(i,k) * a;
+         }
+      for (j = 0; j < m; j++)
+         for (i = 0; i < j; i++)
+            N(j,i) = N(i,j);
+
+      return N;
+   }
+
+      /**
+       * Compute transpose(A)*b in one pass.
+       * @throw MatrixException if the dimensions are incompatible
+       */
+   template <class T, class BaseClass1, class BaseClass2>
+   inline Vector<T> Atb(const ConstMatrixBase<T, BaseClass1>& A,
+                        const ConstVectorBase<T, BaseClass2>& b)
+   {
+      const size_t n = A.rows(), m = A.cols();
+      if (b.size() != n)
+      {
+         MatrixException e("Incompatible dimensions for Atb()");
+         GNSSTK_THROW(e);
+      }
+
+      Vector<T> toReturn(m);
+      size_t i, j;
+      for (j = 0; j < m; j++)
+      {
+         T sum(0);
+         for (i = 0; i < n; i++)
+            sum += A(i,j) * b[i];
+         toReturn[j] = sum;
+      }
+
+      return toReturn;
+   }
+
+      /**
+       * Compute transpose(A)*diag(w)*b in one pass; w holds the
+       * diagonal of a diagonal weight matrix.
+       * @throw MatrixException if the dimensions are incompatible
+       */
+   template <class T, class BaseClass1, class BaseClass2, class BaseClass3>
+   inline Vector<T> AtWb(const ConstMatrixBase<T, BaseClass1>& A,
+                         const ConstVectorBase<T, BaseClass2>& w,
+                         const ConstVectorBase<T, BaseClass3>& b)
+   {
+      const size_t n = A.rows(), m = A.cols();
+      if (w.size() != n || b.size() != n)
+      {
+         MatrixException e("Incompatible dimensions for AtWb(Matrix, Vector)");
+         GNSSTK_THROW(e);
+      }
+
+      Vector<T> toReturn(m);
+      size_t i, j;
+      for (j = 0; j < m; j++)
+      {
+         T sum(0);
+         for (i = 0; i < n; i++)
+            sum += A(i,j) * w[i] * b[i];
+         toReturn[j] = sum;
+      }
+
+      return toReturn;
+   }
+
+      /**
+       * Compute transpose(A)*W*b, W being a full (n x n) weight
+       * matrix; W*b is formed in a single scratch Vector.
+       * @throw MatrixException if the dimensions are incompatible
+       */
+   template <class T, class BaseClass1, class BaseClass2, class BaseClass3>
+   inline Vector<T> AtWb(const ConstMatrixBase<T, BaseClass1>& A,
+                         const ConstMatrixBase<T, BaseClass2>& W,
+                         const ConstVectorBase<T, BaseClass3>& b)
+   {
+      const size_t n = A.rows(), m = A.cols();
+      if (W.rows() != n || W.cols() != n || b.size() != n)
+      {
+         MatrixException e("Incompatible dimensions for AtWb(Matrix, Matrix)");
+         GNSSTK_THROW(e);
+      }
+
+      Vector<T> Wb(n, T(0));
+      size_t i, j;
+      for (j = 0; j < n; j++)
+         for (i = 0; i < n; i++)
+            Wb[i] += W(i,j) * b[j];
+
+      return Atb(A, Wb);
+   }
+
+      /**
+       * Compute A*B+C in one pass, without forming A*B.
+       * @throw MatrixException if the dimensions are incompatible
+       */
+   template <class T, class BaseClass1, class BaseClass2, class BaseClass3>
+   inline Matrix<T> multiplyAdd(const ConstMatrixBase<T, BaseClass1>& A,
+                                const ConstMatrixBase<T, BaseClass2>& B,
+                                const ConstMatrixBase<T, BaseClass3>& C)
+   {
+      if (A.cols() != B.rows() || C.rows() != A.rows() ||
+          C.cols() != B.cols())
+      {
+         MatrixException e("Incompatible dimensions for multiplyAdd()");
+         GNSSTK_THROW(e);
+      }
+
+      Matrix<T> toReturn(C);
+      size_t i, j, k;
+         // column j of the result accumulates the columns of A
+      for (j = 0; j < B.cols(); j++)
+         for (k = 0; k < A.cols(); k++)
+         {
+            const T b(B(k,j));
+            if (b == T(0))
+               continue;
+            for (i = 0; i < A.rows(); i++)
+               toReturn(i,j) += A(i,k) * b;
+         }
+
+      return toReturn;
+   }
+
+      /**
+       * Compute A*B*transpose(A), as in the propagation of a
+       * covariance B, in one pass.  Each column of B*transpose(A) is
+       * formed in turn in a single scratch Vector.
+       * @throw MatrixException if the dimensions are incompatible
+       */
+   template <class T, class BaseClass1, class BaseClass2>
+   inline Matrix<T> ABAt(const ConstMatrixBase<T, BaseClass1>& A,
+                         const ConstMatrixBase<T, BaseClass2>& B)
+   {
+      const size_t m = A.rows(), n = A.cols();
+      if (B.rows() != n || B.cols() != n)
+      {
+         MatrixException e("Incompatible dimensions for ABAt()");
+         GNSSTK_THROW(e);
+      }
+
+      Matrix<T> toReturn(m, m);
+      Vector<T> BAt(n);
+      size_t i, j, k, l;
+      for (j = 0; j < m; j++)
+      {
+            // column j of B*transpose(A)
+         BAt = T(0);
+         for (l = 0; l < n; l++)
+         {
+            const T a(A(j,l));
+            if (a == T(0))
+               continue;
+            for (k = 0; k < n; k++)
+               BAt[k] += B(k,l) * a;
+         }
+         for (i = 0; i < m; i++)
+         {
+            T sum(0);
+            for (k = 0; k < n; k++)
+               sum += A(i,k) * BAt[k];
+            toReturn(i,j) = sum;
+         }
+      }
+
+      return toReturn;
+   }
+
       //@}
 
 }  // namespace
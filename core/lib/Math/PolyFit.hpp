@@ -140,11 +140,8 @@ namespace gnsstk
             for(size_t i=0; i<n_; i++) { P(j,i)=tt; tt *= t(j); }
          }
          Npts += m;
-         Matrix<T> PTP,PT;
-         PT = transpose(P);
-         PTP = PT*P;
-         InfMatrix += PTP;
-         InfData += PT*D;
+         InfMatrix += AtA(P);
+         InfData += Atb(P,D);
          Inverted = false;
       }
 
@@ -164,11 +161,8 @@ namespace gnsstk
             for(size_t i=0; i<n_; i++) { P(j,i)=tt; tt *= t[j]; }
          }
          Npts += m;
-         Matrix<T> PTP,PT;
-         PT = transpose(P);
-         PTP = PT*P;
-         InfMatrix += PTP;
-         InfData += PT*D;
+         InfMatrix += AtA(P);
+         InfData += Atb(P,D);
          Inverted = false;
       }
 
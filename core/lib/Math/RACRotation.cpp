@@ -42,6 +42,7 @@
 
 // gnsstk
 #include "RACRotation.hpp"
+#include "FixedVector.hpp"
 
 namespace gnsstk
 {
@@ -128,12 +129,19 @@ gnsstk::Vector<double> RACRotation::convertToRAC( const gnsstk::Vector<double>&
 
 gnsstk::Triple RACRotation::convertToRAC( const gnsstk::Triple& inVec )
 {
-   gnsstk::Vector<double> v(3);
+      // fixed-size temporaries, as this is called for every position
+      // and velocity converted
+   gnsstk::FixedVector<double,3> v, vOut;
    v[0] = inVec[0];
    v[1] = inVec[1];
    v[2] = inVec[2];
 
-   gnsstk::Vector<double> vOut = convertToRAC( v );
+   for (size_t i = 0; i < 3; i++)
+   {
+      vOut[i] = 0;
+      for (size_t j = 0; j < 3; j++)
+         vOut[i] += (*this)(i,j) * v[j];
+   }
    gnsstk::Triple outVec( vOut[0], vOut[1], vOut[2] );
    return(outVec);
 }
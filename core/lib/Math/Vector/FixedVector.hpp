@@ -0,0 +1,223 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file FixedVector.hpp
+ * Vector with a length fixed at compile time and inline storage.
+ */
+
+#ifndef GNSSTK_FIXEDVECTOR_HPP
+#define GNSSTK_FIXEDVECTOR_HPP
+
+#include "Vector.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup MathGroup
+      //@{
+
+      /**
+       * A vector of N elements whose storage is a member array, so
+       * that creating, copying and returning one never touches the
+       * heap.  It is meant for the small state and position vectors
+       * used in inner loops, where the cost of Vector<T>'s
+       * allocation dominates the arithmetic.
+       *
+       * FixedVector derives from RefVectorBase, so it works with
+       * every function and operator written for ConstVectorBase
+       * (those return a Vector<T>), converts to and from Vector<T>,
+       * and has its own operators (below) that return FixedVector
+       * when both operands are fixed.
+       *
+       * @code
+       * FixedVector<double,3> a(1.0), b;
+       * b = 2.0 * a + a;                 // no allocation
+       * Vector<double> v(b);             // to the dynamic type
+       * @endcode
+       */
+   template <class T, size_t N>
+   class FixedVector : public RefVectorBase<T, FixedVector<T,N> >
+   {
+   public:
+         /// STL value type
+      typedef T value_type;
+         /// STL reference type
+      typedef T& reference;
+         /// STL const reference type
+      typedef const T& const_reference;
+         /// STL iterator type
+      typedef T* iterator;
+         /// STL const iterator type
+      typedef const T* const_iterator;
+
+         /// Default constructor; the elements are not initialized.
+      FixedVector()
+      {}
+         /// Set every element to the given value.
+      explicit FixedVector(const T initialValue)
+      { this->assignFrom(initialValue); }
+         /// Copy the first N elements of an array.
+      explicit FixedVector(const T* array)
+      { this->assignFrom(array); }
+         /** Copy any vector (e.g. Vector<T>) of length N.
+          * @throw VectorException if the length is not N. */
+      template <class E>
+      FixedVector(const ConstVectorBase<T, E>& r)
+      {
+         if (r.size() != N)
+         {
+            VectorException e("FixedVector length does not match source");
+            GNSSTK_THROW(e);
+         }
+         this->assignFrom(r);
+      }
+
+         /// Copy any vector of length N.
+         /// @throw VectorException if the length is not N.
+      template <class E>
+      FixedVector& operator=(const ConstVectorBase<T, E>& r)
+      {
+         if (r.size() != N)
+         {
+            VectorException e("FixedVector length does not match source");
+            GNSSTK_THROW(e);
+         }
+         return this->assignFrom(r);
+      }
+         /// Set every element to the given value.
+      FixedVector& operator=(const T t)
+      { return this->assignFrom(t); }
+
+         /// STL iterator begin
+      iterator begin() { return v; }
+         /// STL const iterator begin
+      const_iterator begin() const { return v; }
+         /// STL iterator end
+      iterator end() { return v + N; }
+         /// STL const iterator end
+      const_iterator end() const { return v + N; }
+         /// STL size
+      size_t size() const { return N; }
+         /// STL empty
+      bool empty() const { return N == 0; }
+
+         /// Non-const operator []
+      T& operator[] (size_t i)
+      { return v[i]; }
+         /// Const operator []
+      T operator[] (size_t i) const
+      { return v[i]; }
+         /// Non-const operator ()
+      T& operator() (size_t i)
+      { return v[i]; }
+         /// Const operator ()
+      T operator() (size_t i) const
+      { return v[i]; }
+
+   private:
+         /// The elements.
+      T v[N];
+   };
+
+      /// Sum of two fixed vectors.
+   template <class T, size_t N>
+   inline FixedVector<T,N> operator+(const FixedVector<T,N>& l,
+                                     const FixedVector<T,N>& r)
+   {
+      FixedVector<T,N> toReturn;
+      for (size_t i = 0; i < N; i++)
+         toReturn[i] = l[i] + r[i];
+      return toReturn;
+   }
+
+      /// Difference of two fixed vectors.
+   template <class T, size_t N>
+   inline FixedVector<T,N> operator-(const FixedVector<T,N>& l,
+                                     const FixedVector<T,N>& r)
+   {
+      FixedVector<T,N> toReturn;
+      for (size_t i = 0; i < N; i++)
+         toReturn[i] = l[i] - r[i];
+      return toReturn;
+   }
+
+      /// Product of a fixed vector and a scalar.
+   template <class T, size_t N>
+   inline FixedVector<T,N> operator*(const FixedVector<T,N>& l, const T d)
+   {
+      FixedVector<T,N> toReturn;
+      for (size_t i = 0; i < N; i++)
+         toReturn[i] = l[i] * d;
+      return toReturn;
+   }
+
+      /// Product of a scalar and a fixed vector.
+   template <class T, size_t N>
+   inline FixedVector<T,N> operator*(const T d, const FixedVector<T,N>& r)
+   { return r * d; }
+
+      /// Quotient of a fixed vector and a scalar.
+   template <class T, size_t N>
+   inline FixedVector<T,N> operator/(const FixedVector<T,N>& l, const T d)
+   {
+      FixedVector<T,N> toReturn;
+      for (size_t i = 0; i < N; i++)
+         toReturn[i] = l[i] / d;
+      return toReturn;
+   }
+
+      /// Dot product of two fixed vectors.
+   template <class T, size_t N>
+   inline T dot(const FixedVector<T,N>& l, const FixedVector<T,N>& r)
+   {
+      T sum(0);
+      for (size_t i = 0; i < N; i++)
+         sum += l[i] * r[i];
+      return sum;
+   }
+
+      /// Euclidean norm of a fixed vector.
+   template <class T, size_t N>
+   inline T norm(const FixedVector<T,N>& v)
+   { return SQRT(dot(v, v)); }
+
+      //@}
+
+}  // namespace
+
+#endif
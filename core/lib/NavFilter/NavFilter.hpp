@@ -44,6 +44,7 @@
 #include <list>
 #include "ObsID.hpp"
 #include "NavFilterKey.hpp"
+#include "NavFilterAllocator.hpp"
 
 namespace gnsstk
 {
@@ -55,7 +56,11 @@ namespace gnsstk
    class NavFilter
    {
    public:
-      typedef std::list<NavFilterKey*> NavMsgList;
+         /** List of messages passed between filters.  The nodes are
+          * recycled by NavFilterAllocator so that steady-state
+          * filtering does not touch the heap. */
+      typedef std::list<NavFilterKey*,
+                        NavFilterAllocator<NavFilterKey*> > NavMsgList;
 
       NavFilter();
 
@@ -0,0 +1,173 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#ifndef NAVFILTERALLOCATOR_HPP
+#define NAVFILTERALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+
+namespace gnsstk
+{
+      /// @ingroup NavFilter
+      //@{
+
+      /** Allocator for the containers used to pass NavFilterKey
+       * pointers between filters (NavFilter::NavMsgList and the
+       * per-epoch maps of the cross-source filters).
+       *
+       * Single-element allocations, i.e. list and map nodes, are
+       * recycled through a per-thread free list for each node type
+       * rather than being returned to the heap.  Once a filter
+       * chain has processed a few epochs, the nodes released by one
+       * epoch are reused by the next and no further heap
+       * allocations are made.
+       *
+       * All instances are interchangeable, so containers using this
+       * allocator may be swapped and spliced freely, and nodes may
+       * be released by a different thread than the one that
+       * allocated them.  Each thread's free list is limited to
+       * maxFree nodes and is released when the thread exits. */
+   template <class T>
+   class NavFilterAllocator
+   {
+   public:
+      typedef T value_type;
+
+         /// Maximum number of nodes of one type kept per thread.
+      static const std::size_t maxFree = 65536;
+
+      NavFilterAllocator() noexcept
+      {}
+
+      template <class U>
+      NavFilterAllocator(const NavFilterAllocator<U>&) noexcept
+      {}
+
+         /// Get storage for n objects, reusing a free node if n is 1.
+      T* allocate(std::size_t n)
+      {
+         if (n == 1)
+         {
+            FreeList& fl(freeList());
+            if (fl.head != nullptr)
+            {
+               FreeNode *node = fl.head;
+               fl.head = node->next;
+               fl.count--;
+               return reinterpret_cast<T*>(node);
+            }
+         }
+         return static_cast<T*>(::operator new(n * sizeof(T)));
+      }
+
+         /// Release storage, keeping single nodes for reuse.
+      void deallocate(T* p, std::size_t n) noexcept
+      {
+         static_assert(sizeof(T) >= sizeof(void*),
+                       "NavFilterAllocator node too small");
+         if (n == 1)
+         {
+            FreeList& fl(freeList());
+            if (!fl.reaped && (fl.count < maxFree))
+            {
+               FreeNode *node = reinterpret_cast<FreeNode*>(p);
+               node->next = fl.head;
+               fl.head = node;
+               fl.count++;
+               return;
+            }
+         }
+         ::operator delete(p);
+      }
+
+   private:
+         /// Overlay for storage on the free list.
+      struct FreeNode
+      {
+         FreeNode *next;
+      };
+         /** Per-thread free list.  This is trivially destructible
+          * so it remains usable by containers destroyed after the
+          * thread's Reaper. */
+      struct FreeList
+      {
+         FreeNode *head;
+         std::size_t count;
+         bool reaped;
+      };
+         /// Returns a thread's free nodes to the heap when it exits.
+      struct Reaper
+      {
+         ~Reaper()
+         {
+            FreeList& fl(freeList());
+            fl.reaped = true;
+            while (fl.head != nullptr)
+            {
+               FreeNode *node = fl.head;
+               fl.head = node->next;
+               ::operator delete(node);
+            }
+            fl.count = 0;
+         }
+      };
+
+      static FreeList& freeList()
+      {
+         static thread_local FreeList fl = { nullptr, 0, false };
+         static thread_local Reaper reaper;
+         return fl;
+      }
+   };
+
+   template <class T, class U>
+   inline bool operator==(const NavFilterAllocator<T>&,
+                          const NavFilterAllocator<U>&) noexcept
+   { return true; }
+
+   template <class T, class U>
+   inline bool operator!=(const NavFilterAllocator<T>&,
+                          const NavFilterAllocator<U>&) noexcept
+   { return false; }
+
+      //@}
+
+} // namespace gnsstk
+
+#endif // NAVFILTERALLOCATOR_HPP
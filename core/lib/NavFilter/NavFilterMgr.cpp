@@ -36,12 +36,23 @@
 //
 //==============================================================================
 
+#include <chrono>
+#include <iomanip>
 #include "NavFilterMgr.hpp"
 
 namespace gnsstk
 {
+   NavFilterMgr::FilterStats ::
+   FilterStats()
+         : filter(nullptr), calls(0), input(0), accepted(0), rejected(0),
+           seconds(0)
+   {
+   }
+
+
    NavFilterMgr ::
    NavFilterMgr()
+         : timing(false)
    {
    }
 
@@ -50,75 +61,125 @@ namespace gnsstk
    addFilter(NavFilter* filt)
    {
       filters.push_back(filt);
+      stats.push_back(FilterStats());
+      stats.back().filter = filt;
    }
 
 
    NavFilter::NavMsgList NavFilterMgr ::
    validate(NavFilterKey* msgBits)
    {
-      NavFilter::NavMsgList rv, newrv;
-      rv.push_back(msgBits);
+      NavFilter::NavMsgList rv;
+      validate(msgBits, rv);
+      return rv;
+   }
+
+
+   void NavFilterMgr ::
+   validate(NavFilterKey* msgBits, NavFilter::NavMsgList& msgBitsOut)
+   {
+      stageIn.clear();
+      stageIn.push_back(msgBits);
       rejected.clear();
-      for (FilterList::iterator i = filters.begin(); i != filters.end(); i++)
+      for (size_t i = 0; i < stats.size(); i++)
       {
-         if (rv.empty())
+         if (stageIn.empty())
             break;
-         (*i)->rejected.clear();
-         newrv.clear();
-         (*i)->validate(rv, newrv);
-         if (!(*i)->rejected.empty())
-            rejected.insert(*i);
-         rv = newrv;
+         runValidate(i, stageIn, stageOut);
+            // The output of this filter is the input of the next.
+         stageIn.swap(stageOut);
       }
-      return rv;
+      msgBitsOut.splice(msgBitsOut.end(), stageIn);
    }
 
 
-   NavFilter::NavMsgList NavFilterMgr ::
-   finalize()
+   void NavFilterMgr ::
+   finalizeInto(NavFilter::NavMsgList& msgBitsOut)
    {
-         // final and intermediate return values
-      NavFilter::NavMsgList rv, rv1, rv2;
-         // current and next filter
-      FilterList::iterator fliCur, fliNxt;
       rejected.clear();
+      finalizeRejected.clear();
          // touch ALL filters
-      for (fliCur = filters.begin(); fliCur != filters.end(); fliCur++)
+      for (size_t cur = 0; cur < stats.size(); cur++)
       {
             // finalize the data in the current filter
-         (*fliCur)->rejected.clear();
-         rv2.clear();
-         (*fliCur)->finalize(rv2);
+         FilterStats& fs(stats[cur]);
+         std::chrono::steady_clock::time_point t0;
+         fs.filter->rejected.clear();
+         stageIn.clear();
+         if (timing)
+            t0 = std::chrono::steady_clock::now();
+         fs.filter->finalize(stageIn);
+         if (timing)
+         {
+            fs.seconds += std::chrono::duration<double>(
+               std::chrono::steady_clock::now() - t0).count();
+         }
+         fs.calls++;
+         fs.accepted += stageIn.size();
+         fs.rejected += fs.filter->rejected.size();
+         if (!fs.filter->rejected.empty())
+            rejected.insert(fs.filter);
+         finalizeRejected.insert(finalizeRejected.end(),
+                                 fs.filter->rejected.begin(),
+                                 fs.filter->rejected.end());
 
-            // If the filter returned some data, we need to push it
-            // into the next filter using validate.
-         if (!rv2.empty())
+            // If the filter returned some data, cascade it through
+            // the remaining filters using validate.
+         for (size_t nxt = cur+1; (nxt < stats.size()) && !stageIn.empty();
+              nxt++)
          {
-            fliNxt = fliCur;
-            fliNxt++;
-               // cascade the data through the end.
-            rv1 = rv2;
-            while ((fliNxt != filters.end()) && !rv1.empty())
-            {
-               (*fliNxt)->rejected.clear();
-               rv2.clear();
-               (*fliNxt)->validate(rv1, rv2);
-               rv1 = rv2;
-               fliNxt++;
-            }
-               // If the filter cascade got some data that passed all
-               // filters, add it to the final return value.
-            if (!rv1.empty())
-            {
-               std::copy(rv1.begin(), rv1.end(),
-                         std::back_insert_iterator<NavFilter::NavMsgList>(rv));
-            }
+            runValidate(nxt, stageIn, stageOut);
+            stageIn.swap(stageOut);
+               // Keep these before the filter is used again.
+            NavFilter* filt = stats[nxt].filter;
+            finalizeRejected.insert(finalizeRejected.end(),
+                                    filt->rejected.begin(),
+                                    filt->rejected.end());
          }
+            // Whatever got through all the filters goes in the
+            // final return value.
+         msgBitsOut.splice(msgBitsOut.end(), stageIn);
       }
+   }
+
+
+   NavFilter::NavMsgList NavFilterMgr ::
+   finalize()
+   {
+      NavFilter::NavMsgList rv;
+      finalizeInto(rv);
       return rv;
    }
 
 
+   void NavFilterMgr ::
+   runValidate(size_t idx, NavFilter::NavMsgList& msgBitsIn,
+               NavFilter::NavMsgList& msgBitsOut)
+   {
+      FilterStats& fs(stats[idx]);
+      std::chrono::steady_clock::time_point t0;
+      fs.filter->rejected.clear();
+      msgBitsOut.clear();
+      fs.calls++;
+      fs.input += msgBitsIn.size();
+      if (timing)
+      {
+         t0 = std::chrono::steady_clock::now();
+         fs.filter->validate(msgBitsIn, msgBitsOut);
+         fs.seconds += std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - t0).count();
+      }
+      else
+      {
+         fs.filter->validate(msgBitsIn, msgBitsOut);
+      }
+      fs.accepted += msgBitsOut.size();
+      fs.rejected += fs.filter->rejected.size();
+      if (!fs.filter->rejected.empty())
+         rejected.insert(fs.filter);
+   }
+
+
    unsigned NavFilterMgr ::
    processingDepth()
       const noexcept
@@ -131,4 +192,40 @@ namespace gnsstk
       }
       return rv;
    }
+
+
+   void NavFilterMgr ::
+   resetStats()
+   {
+      for (size_t i = 0; i < stats.size(); i++)
+      {
+         NavFilter *filt = stats[i].filter;
+         stats[i] = FilterStats();
+         stats[i].filter = filt;
+      }
+   }
+
+
+   void NavFilterMgr ::
+   dumpStats(std::ostream& s)
+      const
+   {
+      std::ios::fmtflags oldFlags = s.flags();
+      std::streamsize oldPrecision = s.precision();
+      s << std::left << std::setw(16) << "Filter" << std::right
+        << std::setw(12) << "Calls" << std::setw(12) << "Input"
+        << std::setw(12) << "Accepted" << std::setw(12) << "Rejected"
+        << std::setw(12) << "Seconds" << std::endl;
+      for (size_t i = 0; i < stats.size(); i++)
+      {
+         const FilterStats& fs(stats[i]);
+         s << std::left << std::setw(16) << fs.filter->filterName()
+           << std::right << std::setw(12) << fs.calls
+           << std::setw(12) << fs.input << std::setw(12) << fs.accepted
+           << std::setw(12) << fs.rejected << std::setw(12) << std::fixed
+           << std::setprecision(6) << fs.seconds << std::endl;
+      }
+      s.flags(oldFlags);
+      s.precision(oldPrecision);
+   }
 }
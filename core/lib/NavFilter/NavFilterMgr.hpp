@@ -41,6 +41,8 @@
 
 #include <list>
 #include <set>
+#include <vector>
+#include <iostream>
 #include "NavFilter.hpp"
 
 namespace gnsstk
@@ -65,6 +67,20 @@ namespace gnsstk
        * NavFilterMgr::addFilter().  Data is processed and returned
        * using NavFilterMgr::validate().
        *
+       * For continuous processing of live data,
+       * NavFilterMgr::validate(NavFilterKey*,NavFilter::NavMsgList&)
+       * and NavFilterMgr::finalizeInto(), which append to a
+       * caller-supplied list, avoid constructing a new list for each
+       * message.  Together with NavFilterAllocator,
+       * which recycles the list and map nodes used by the filters,
+       * this keeps the filter chain free of per-message heap
+       * allocation once it has warmed up.  The manager also keeps
+       * per-filter counts of messages accepted and rejected, and
+       * optionally the time spent in each filter (see
+       * NavFilterMgr::getStats()).  ShardedNavFilterMgr runs a
+       * separate filter chain per group of satellites on each of
+       * several threads for high-volume multi-receiver input.
+       *
        * Data is added to the NavFilterMgr using child classes of
        * NavFilterKey.  These child classes will have data members
        * pointing to pre-existing storage of the navigation messages
@@ -175,6 +191,27 @@ namespace gnsstk
          /// A set of unique filter pointers.
       typedef std::set<NavFilter*> FilterSet;
 
+         /// Counters kept for each filter added via addFilter().
+      struct FilterStats
+      {
+         FilterStats();
+            /// The filter the counters apply to.
+         NavFilter *filter;
+            /// Number of NavFilter::validate() and finalize() calls.
+         unsigned long calls;
+            /// Number of messages given to NavFilter::validate().
+         unsigned long input;
+            /// Number of messages output by the filter.
+         unsigned long accepted;
+            /// Number of messages rejected by the filter.
+         unsigned long rejected;
+            /** Wall-clock time spent in the filter in seconds.  Only
+             * accumulated when timing is enabled with setTiming(). */
+         double seconds;
+      };
+         /// Counters for each filter, in the order of addFilter().
+      typedef std::vector<FilterStats> FilterStatsList;
+
          /// Do-nothing default constructor.
       NavFilterMgr();
 
@@ -201,6 +238,18 @@ namespace gnsstk
           *   configured filters. */
       NavFilter::NavMsgList validate(NavFilterKey* msgBits);
 
+         /** Validate a single navigation message, appending the
+          * results to an existing list.  This is the same as
+          * validate(NavFilterKey*) but lets the caller reuse the
+          * output list (e.g. by clearing it after each call) when
+          * processing a continuous stream of data.
+          * @param[in] msgBits The navigation message to
+          *   validate/filter.
+          * @param[in,out] msgBitsOut Any messages that have
+          *   successfully passed all configured filters are appended
+          *   to this list. */
+      void validate(NavFilterKey* msgBits, NavFilter::NavMsgList& msgBitsOut);
+
          /** Flush the stored data for all known filters.  This method
           * should be called by the user after all data has been added
           * to the filter manager via validate().
@@ -208,6 +257,13 @@ namespace gnsstk
           *   filters. */
       virtual NavFilter::NavMsgList finalize();
 
+         /** Flush the stored data for all known filters, appending
+          * the remaining messages successfully passing the filters
+          * to msgBitsOut.  This is not an overload of finalize() so
+          * that a child class overriding one does not hide the other.
+          * @param[in,out] msgBitsOut The list to append results to. */
+      virtual void finalizeInto(NavFilter::NavMsgList& msgBitsOut);
+
          /** Gets the effective buffer size in epochs required for
           * maintaining subframe data, given the filters that have
           * been added using addFilter().  This is the sum of
@@ -224,6 +280,26 @@ namespace gnsstk
           */
       unsigned processingDepth() const noexcept;
 
+         /** Enable or disable timing of the individual filters.
+          * Timing is off by default as it costs two clock reads per
+          * filter per message.
+          * @param[in] enable If true, FilterStats::seconds will be
+          *   accumulated by subsequent validate() and finalize()
+          *   calls. */
+      void setTiming(bool enable)
+      { timing = enable; }
+
+         /// Get the per-filter counters, in the order of addFilter().
+      const FilterStatsList& getStats() const
+      { return stats; }
+
+         /// Set all per-filter counters to zero.
+      void resetStats();
+
+         /** Print the per-filter counters, one line per filter.
+          * @param[in,out] s The stream to print to. */
+      void dumpStats(std::ostream& s) const;
+
          /** This set contains any filters with rejected data after a
           * validate() or finalize() call.  The set will be cleared at
           * the beginning of the validate() or finalize() call so that
@@ -232,9 +308,29 @@ namespace gnsstk
           * be accessed via the NavFilter::rejected data member. */
       FilterSet rejected;
 
+         /** Every message rejected during the most recent finalize()
+          * or finalizeInto() call.  A filter's rejected list is
+          * cleared each time that filter is used, and finalizing one
+          * filter passes its output through the filters after it, so
+          * the rejected set alone can miss messages rejected early in
+          * the flush.  This list is cleared at the beginning of the
+          * finalize() or finalizeInto() call. */
+      NavFilter::NavMsgList finalizeRejected;
+
    private:
+         /** Run one filter's validate() on msgBitsIn, updating its
+          * counters and the rejected set. */
+      void runValidate(size_t idx, NavFilter::NavMsgList& msgBitsIn,
+                       NavFilter::NavMsgList& msgBitsOut);
+
          /// The collection of navigation message filters to apply.
       FilterList filters;
+         /// Counters for the filters, in the same order as filters.
+      FilterStatsList stats;
+         /// If true, time spent in each filter is accumulated.
+      bool timing;
+         /// Reused storage for the input and output of each stage.
+      NavFilter::NavMsgList stageIn, stageOut;
    };
 
       //@}
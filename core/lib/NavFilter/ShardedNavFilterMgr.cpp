@@ -0,0 +1,346 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include "ShardedNavFilterMgr.hpp"
+
+namespace gnsstk
+{
+   ShardedNavFilterMgr::Shard ::
+   Shard()
+         : busy(false), finalizeReq(false), stop(false)
+   {
+   }
+
+
+   ShardedNavFilterMgr ::
+   ShardedNavFilterMgr(const ChainFactory& factory, unsigned numShards,
+                       ShardKey key, unsigned batchSize)
+         : shardKey(key), batch(batchSize == 0 ? 1 : batchSize)
+   {
+      if (numShards == 0)
+      {
+         numShards = std::thread::hardware_concurrency();
+         if (numShards == 0)
+            numShards = 1;
+      }
+         // Build all the filter chains before starting any threads
+         // so that an exception from the factory leaves nothing
+         // running.
+      for (unsigned i = 0; i < numShards; i++)
+      {
+         shards.push_back(std::unique_ptr<Shard>(new Shard));
+         Shard& shard(*shards.back());
+         shard.chain = factory();
+         for (unsigned j = 0; j < shard.chain.size(); j++)
+         {
+            shard.mgr.addFilter(shard.chain[j].get());
+         }
+         shard.pending.reserve(batch);
+      }
+      try
+      {
+         for (unsigned i = 0; i < shards.size(); i++)
+         {
+            threads.create(std::bind(&ShardedNavFilterMgr::run,
+                                     shards[i].get()));
+         }
+      }
+      catch (...)
+      {
+            // Destroying threads then joins the workers that did
+            // start.
+         stopShards();
+         throw;
+      }
+   }
+
+
+   ShardedNavFilterMgr ::
+   ~ShardedNavFilterMgr()
+   {
+      stopShards();
+      threads.join();
+   }
+
+
+   void ShardedNavFilterMgr ::
+   stopShards()
+   {
+      for (unsigned i = 0; i < shards.size(); i++)
+      {
+         Shard& shard(*shards[i]);
+         {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.stop = true;
+         }
+         shard.cond.notify_all();
+      }
+   }
+
+
+   unsigned ShardedNavFilterMgr ::
+   getShard(const NavFilterKey* msgBits)
+      const
+   {
+      uint32_t hash = msgBits->prn;
+      if (shardKey == skSignal)
+      {
+         hash = hash * 31 + static_cast<uint32_t>(msgBits->carrier);
+         hash = hash * 31 + static_cast<uint32_t>(msgBits->code);
+      }
+      return hash % shards.size();
+   }
+
+
+   void ShardedNavFilterMgr ::
+   validate(NavFilterKey* msgBits)
+   {
+      Shard& shard(*shards[getShard(msgBits)]);
+      shard.pending.push_back(msgBits);
+      if (shard.pending.size() >= batch)
+         handOff(shard);
+   }
+
+
+   void ShardedNavFilterMgr ::
+   sync(NavFilter::NavMsgList& msgBitsOut,
+        NavFilter::NavMsgList& rejectedOut)
+   {
+         // Get all the shards working before waiting on any of them.
+      for (unsigned i = 0; i < shards.size(); i++)
+      {
+         handOff(*shards[i]);
+      }
+      for (unsigned i = 0; i < shards.size(); i++)
+      {
+         collect(*shards[i], msgBitsOut, rejectedOut);
+      }
+   }
+
+
+   void ShardedNavFilterMgr ::
+   finalize(NavFilter::NavMsgList& msgBitsOut,
+            NavFilter::NavMsgList& rejectedOut)
+   {
+      for (unsigned i = 0; i < shards.size(); i++)
+      {
+         Shard& shard(*shards[i]);
+         handOff(shard);
+         {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.finalizeReq = true;
+         }
+         shard.cond.notify_all();
+      }
+      for (unsigned i = 0; i < shards.size(); i++)
+      {
+         collect(*shards[i], msgBitsOut, rejectedOut);
+      }
+   }
+
+
+   void ShardedNavFilterMgr ::
+   setTiming(bool enable)
+   {
+      for (unsigned i = 0; i < shards.size(); i++)
+      {
+         std::lock_guard<std::mutex> lock(shards[i]->mutex);
+         shards[i]->mgr.setTiming(enable);
+      }
+   }
+
+
+   NavFilterMgr::FilterStatsList ShardedNavFilterMgr ::
+   getStats()
+      const
+   {
+      NavFilterMgr::FilterStatsList rv;
+      for (unsigned i = 0; i < shards.size(); i++)
+      {
+         std::lock_guard<std::mutex> lock(shards[i]->mutex);
+         const NavFilterMgr::FilterStatsList& stats(
+            shards[i]->mgr.getStats());
+         if (i == 0)
+         {
+            rv = stats;
+            continue;
+         }
+         for (unsigned j = 0; j < stats.size(); j++)
+         {
+            rv[j].calls += stats[j].calls;
+            rv[j].input += stats[j].input;
+            rv[j].accepted += stats[j].accepted;
+            rv[j].rejected += stats[j].rejected;
+            rv[j].seconds += stats[j].seconds;
+         }
+      }
+      return rv;
+   }
+
+
+   void ShardedNavFilterMgr ::
+   run(Shard* shard)
+   {
+         // Local buffers so the filters run without holding the lock.
+      std::vector<NavFilterKey*> work, accepted, rejected;
+      NavFilter::NavMsgList out;
+      std::unique_lock<std::mutex> lock(shard->mutex);
+      while (true)
+      {
+         shard->cond.wait(lock, [shard]()
+                          { return (shard->stop || shard->finalizeReq ||
+                                    !shard->queue.empty()); });
+         if (shard->stop)
+            break;
+         work.swap(shard->queue);
+         bool fin = shard->finalizeReq;
+         shard->finalizeReq = false;
+         shard->busy = true;
+         lock.unlock();
+         std::exception_ptr error;
+         try
+         {
+            for (unsigned i = 0; i < work.size(); i++)
+            {
+               shard->mgr.validate(work[i], out);
+               takeRejected(shard->mgr, rejected);
+            }
+            if (fin)
+            {
+               shard->mgr.finalizeInto(out);
+                  // The filters' rejected lists only hold the
+                  // last step of the flush.
+               rejected.insert(rejected.end(),
+                               shard->mgr.finalizeRejected.begin(),
+                               shard->mgr.finalizeRejected.end());
+            }
+         }
+         catch (...)
+         {
+            error = std::current_exception();
+         }
+            // Copy rather than splice so the list nodes are recycled
+            // by this thread.
+         accepted.insert(accepted.end(), out.begin(), out.end());
+         out.clear();
+         work.clear();
+         lock.lock();
+         shard->accepted.insert(shard->accepted.end(), accepted.begin(),
+                                accepted.end());
+         shard->rejected.insert(shard->rejected.end(), rejected.begin(),
+                                rejected.end());
+         if (error && !shard->error)
+            shard->error = error;
+         shard->busy = false;
+         accepted.clear();
+         rejected.clear();
+         shard->cond.notify_all();
+      }
+   }
+
+
+   void ShardedNavFilterMgr ::
+   takeRejected(const NavFilterMgr& mgr, std::vector<NavFilterKey*>& rejected)
+   {
+      NavFilterMgr::FilterSet::const_iterator fsi;
+      for (fsi = mgr.rejected.begin(); fsi != mgr.rejected.end(); fsi++)
+      {
+         rejected.insert(rejected.end(), (*fsi)->rejected.begin(),
+                         (*fsi)->rejected.end());
+      }
+   }
+
+
+   void ShardedNavFilterMgr ::
+   handOff(Shard& shard)
+   {
+      if (shard.pending.empty())
+         return;
+      {
+         std::lock_guard<std::mutex> lock(shard.mutex);
+         if (shard.queue.empty())
+         {
+            shard.queue.swap(shard.pending);
+         }
+         else
+         {
+            shard.queue.insert(shard.queue.end(), shard.pending.begin(),
+                               shard.pending.end());
+            shard.pending.clear();
+         }
+      }
+      shard.cond.notify_all();
+   }
+
+
+   void ShardedNavFilterMgr ::
+   collect(Shard& shard, NavFilter::NavMsgList& msgBitsOut,
+           NavFilter::NavMsgList& rejectedOut)
+   {
+      std::exception_ptr error;
+      {
+         std::unique_lock<std::mutex> lock(shard.mutex);
+         shard.cond.wait(lock, [&shard]()
+                         { return (shard.queue.empty() && !shard.busy &&
+                                   !shard.finalizeReq); });
+         msgBitsOut.insert(msgBitsOut.end(), shard.accepted.begin(),
+                           shard.accepted.end());
+         rejectedOut.insert(rejectedOut.end(), shard.rejected.begin(),
+                            shard.rejected.end());
+         shard.accepted.clear();
+         shard.rejected.clear();
+         error.swap(shard.error);
+      }
+      if (error)
+      {
+         try
+         {
+            std::rethrow_exception(error);
+         }
+         catch (Exception& exc)
+         {
+            GNSSTK_RETHROW(exc);
+         }
+         catch (std::exception& exc)
+         {
+            Exception e(exc.what());
+            GNSSTK_THROW(e);
+         }
+      }
+   }
+}
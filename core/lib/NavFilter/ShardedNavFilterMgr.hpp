@@ -0,0 +1,244 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#ifndef SHARDEDNAVFILTERMGR_HPP
+#define SHARDEDNAVFILTERMGR_HPP
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "NavFilterMgr.hpp"
+#include "ThreadGroup.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup NavFilter
+      //@{
+
+      /** Run NavFilterMgr filter chains for many independent
+       * navigation message sources on multiple threads.
+       *
+       * Messages passed to validate() are partitioned into shards
+       * by satellite (and optionally by signal).  Each shard has
+       * its own worker thread and its own filter chain, created by
+       * the ChainFactory given to the constructor, so filters never
+       * see calls from more than one thread and need no locking.
+       * All messages from a given satellite go to the same shard
+       * when sharding by skPRN, so cross-source filters such as
+       * LNavCrossSourceFilter still see every source for a PRN.
+       *
+       * Messages are queued in batches and processed
+       * asynchronously.  Call sync() to wait for all queued
+       * messages to be processed and to collect the results, and
+       * finalize() after the last message.  Each shard processes
+       * its messages in the order they were passed to validate(),
+       * and sync() and finalize() return each shard's results in
+       * shard order, so the output for a given input sequence and
+       * number of shards is deterministic.
+       *
+       * Since the filters' rejected lists are cleared by every
+       * NavFilterMgr::validate() call, rejected messages are
+       * collected per shard and returned by sync() and finalize()
+       * so the caller can release their storage.
+       *
+       * @code
+       * ShardedNavFilterMgr mgr(
+       *    []() {
+       *       return ShardedNavFilterMgr::FilterChain {
+       *          std::make_shared<LNavParityFilter>(),
+       *          std::make_shared<LNavCrossSourceFilter>() };
+       *    }, 4);
+       * for (...)
+       * {
+       *    mgr.validate(&data[i]);
+       *    if (endOfEpoch)
+       *       mgr.sync(good, bad);
+       * }
+       * mgr.finalize(good, bad);
+       * @endcode
+       */
+   class ShardedNavFilterMgr
+   {
+   public:
+         /// The filters of one shard, in the order they are applied.
+      typedef std::vector<std::shared_ptr<NavFilter> > FilterChain;
+         /** Function that creates a new filter chain.  It is called
+          * once per shard, from the constructor. */
+      typedef std::function<FilterChain()> ChainFactory;
+
+         /// How messages are assigned to shards.
+      enum ShardKey
+      {
+         skPRN,   ///< By NavFilterKey::prn (required for cross-source).
+         skSignal ///< By NavFilterKey::prn, carrier and code.
+      };
+
+         /** Create the shards and start their worker threads.
+          * @param[in] factory Creates the filter chain for each shard.
+          * @param[in] numShards The number of shards (and threads).
+          *   If 0, std::thread::hardware_concurrency() is used.
+          * @param[in] key How to assign messages to shards.
+          * @param[in] batchSize The number of messages queued for a
+          *   shard before they are handed to its thread. */
+      ShardedNavFilterMgr(const ChainFactory& factory,
+                          unsigned numShards = 0,
+                          ShardKey key = skPRN,
+                          unsigned batchSize = 64);
+
+         /** Stop the worker threads.  Any unprocessed messages are
+          * discarded; call finalize() first to get them. */
+      ~ShardedNavFilterMgr();
+
+         /** Queue a navigation message for filtering.
+          * @param[in] msgBits The message to filter, which must
+          *   remain valid until it is returned by sync() or
+          *   finalize(). */
+      void validate(NavFilterKey* msgBits);
+
+         /** Wait for all queued messages to be processed.
+          * @param[in,out] msgBitsOut Messages that passed all filters
+          *   since the last sync() are appended here.
+          * @param[in,out] rejectedOut Messages rejected by any
+          *   filter since the last sync() are appended here.
+          * @throw Exception if a filter threw an exception in a
+          *   worker thread (std::exceptions are converted).  The
+          *   rest of the batch the failing message was in is not
+          *   processed, and results from later shards are left
+          *   for the next sync(). */
+      void sync(NavFilter::NavMsgList& msgBitsOut,
+                NavFilter::NavMsgList& rejectedOut);
+
+         /** Process all queued messages, then flush the filters of
+          * every shard (see NavFilterMgr::finalize()).
+          * @param[in,out] msgBitsOut Remaining messages that passed
+          *   all filters are appended here.
+          * @param[in,out] rejectedOut Remaining rejected messages
+          *   are appended here.
+          * @throw Exception as for sync(). */
+      void finalize(NavFilter::NavMsgList& msgBitsOut,
+                    NavFilter::NavMsgList& rejectedOut);
+
+         /// Get the number of shards/worker threads.
+      unsigned getNumShards() const
+      { return shards.size(); }
+
+         /** Get the shard a message will be processed by.
+          * @param[in] msgBits The message to look up.
+          * @return an index in the range [0,getNumShards()). */
+      unsigned getShard(const NavFilterKey* msgBits) const;
+
+         /** Enable or disable timing of the filters in all shards.
+          * Only call this when no messages are queued, i.e. before
+          * the first validate() or right after sync(). */
+      void setTiming(bool enable);
+
+         /** Get the per-filter counters summed over all shards, in
+          * filter chain order.  The filter member is that of the
+          * first shard.  Only call this right after sync() or
+          * finalize(). */
+      NavFilterMgr::FilterStatsList getStats() const;
+
+   private:
+         /// State of a single shard and its worker thread.
+      struct Shard
+      {
+         Shard();
+            /// The filter manager, used only by the worker thread.
+         NavFilterMgr mgr;
+            /// Owns the filters added to mgr.
+         FilterChain chain;
+            /// Messages queued by validate() but not yet handed off.
+         std::vector<NavFilterKey*> pending;
+            /// Protects everything below.
+         std::mutex mutex;
+            /// Signals the worker of new work and the caller of idle.
+         std::condition_variable cond;
+            /// Messages handed to the worker thread.
+         std::vector<NavFilterKey*> queue;
+            /// Messages accepted by the filters.
+         std::vector<NavFilterKey*> accepted;
+            /// Messages rejected by the filters.
+         std::vector<NavFilterKey*> rejected;
+            /// True while the worker is processing a batch.
+         bool busy;
+            /// Set by finalize() to have the worker flush the filters.
+         bool finalizeReq;
+            /// Set by the destructor to stop the worker.
+         bool stop;
+            /// Exception thrown by a filter, rethrown by sync().
+         std::exception_ptr error;
+      };
+
+         /// Worker thread main loop.
+      static void run(Shard* shard);
+
+         /** Append the messages rejected by the last validate() call
+          * of mgr to rejected. */
+      static void takeRejected(const NavFilterMgr& mgr,
+                               std::vector<NavFilterKey*>& rejected);
+
+         /// Tell all the worker threads to stop.
+      void stopShards();
+
+         /// Hand a shard's pending messages to its worker thread.
+      void handOff(Shard& shard);
+
+         /// Wait for a shard to go idle and collect its results.
+      void collect(Shard& shard, NavFilter::NavMsgList& msgBitsOut,
+                   NavFilter::NavMsgList& rejectedOut);
+
+         /// The shards, which are not movable.
+      std::vector<std::unique_ptr<Shard> > shards;
+         /// How messages are assigned to shards.
+      ShardKey shardKey;
+         /// Number of messages to queue before handing them off.
+      unsigned batch;
+         /** The worker threads, one per shard.  Declared after
+          * shards so that the threads are joined before the shards
+          * are destroyed. */
+      ThreadGroup threads;
+   };
+
+      //@}
+}
+
+#endif // SHARDEDNAVFILTERMGR_HPP
@@ -300,6 +300,17 @@ namespace gnsstk
    }
 
 
+   bool BDSD2NavEph ::
+   getEllipsoidParams(double& gm, double& angVel) const
+   {
+      if ((signal.sat.id >= MIN_MEO_BDS) && (signal.sat.id <= MAX_MEO_BDS))
+      {
+         return OrbitDataBDS::getEllipsoidParams(gm, angVel);
+      }
+      return false;
+   }
+
+
    bool BDSD2NavEph ::
    validate() const
    {
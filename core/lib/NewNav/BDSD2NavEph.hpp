@@ -73,6 +73,12 @@ namespace gnsstk
       bool getXvt(const CommonTime& when, Xvt& xvt,
                   const ObsID& = ObsID()) override;
 
+         /** Get the ellipsoid parameters for batch evaluation.
+          * @note GEO satellites use a different algorithm and are
+          *   not batch evaluated.
+          * @copydetails OrbitDataKepler::getEllipsoidParams */
+      bool getEllipsoidParams(double& gm, double& angVel) const override;
+
          /** Checks the contents of this message against known
           * validity rules as defined in the appropriate ICD.
           * @todo implement some checking.
@@ -55,7 +55,13 @@ namespace gnsstk
        * @note, The CCIR became the ITU-R (International
        * Telecommunication Union Radiocommunication Sector) in 1992,
        * but the data files from which this code was generated are
-       * named ccir, so we keep that name for consistency. */
+       * named ccir, so we keep that name for consistency.
+       *
+       * The coefficient tables are immutable and shared.  A CCIR
+       * object holds the interpolated coefficients for the most
+       * recent fourier() call, making it an evaluation context that
+       * must not be shared between threads without synchronization;
+       * use one object per thread instead. */
    class CCIR
    {
    public:
@@ -152,7 +158,7 @@ namespace gnsstk
           * @param[in] ord The order for the data to be retrieved
           *   (second axis of grid).
           * @return The coefficient grid value at the requested coordinates. */
-      double ccirF2(unsigned month, int cond, int deg, int ord);
+      static double ccirF2(unsigned month, int cond, int deg, int ord);
          /** Get a CCIR grid point for transmission factor coefficients.
           * @param[in] month The month of the data being retrieved.
           * @param[in] cond The solar conditions, low activity=0, high
@@ -162,7 +168,7 @@ namespace gnsstk
           * @param[in] ord The order for the data to be retrieved
           *   (second axis of grid).
           * @return The coefficient grid value at the requested coordinates. */
-      double ccirFm3(unsigned month, int cond, int deg, int ord);
+      static double ccirFm3(unsigned month, int cond, int deg, int ord);
          /** Get month-specific grid data.  Method name uses 10+month
           * number to match naming of data files and library code,
           * e.g. ccir11F2 is F2 layer coefficients for January.
@@ -174,30 +180,30 @@ namespace gnsstk
           *   (second axis of grid).
           * @return The coefficient grid value at the requested coordinates. */
          //@{
-      double ccir11F2(int cond, int deg, int ord);
-      double ccir11Fm3(int cond, int deg, int ord);
-      double ccir12F2(int cond, int deg, int ord);
-      double ccir12Fm3(int cond, int deg, int ord);
-      double ccir13F2(int cond, int deg, int ord);
-      double ccir13Fm3(int cond, int deg, int ord);
-      double ccir14F2(int cond, int deg, int ord);
-      double ccir14Fm3(int cond, int deg, int ord);
-      double ccir15F2(int cond, int deg, int ord);
-      double ccir15Fm3(int cond, int deg, int ord);
-      double ccir16F2(int cond, int deg, int ord);
-      double ccir16Fm3(int cond, int deg, int ord);
-      double ccir17F2(int cond, int deg, int ord);
-      double ccir17Fm3(int cond, int deg, int ord);
-      double ccir18F2(int cond, int deg, int ord);
-      double ccir18Fm3(int cond, int deg, int ord);
-      double ccir19F2(int cond, int deg, int ord);
-      double ccir19Fm3(int cond, int deg, int ord);
-      double ccir20F2(int cond, int deg, int ord);
-      double ccir20Fm3(int cond, int deg, int ord);
-      double ccir21F2(int cond, int deg, int ord);
-      double ccir21Fm3(int cond, int deg, int ord);
-      double ccir22F2(int cond, int deg, int ord);
-      double ccir22Fm3(int cond, int deg, int ord);
+      static double ccir11F2(int cond, int deg, int ord);
+      static double ccir11Fm3(int cond, int deg, int ord);
+      static double ccir12F2(int cond, int deg, int ord);
+      static double ccir12Fm3(int cond, int deg, int ord);
+      static double ccir13F2(int cond, int deg, int ord);
+      static double ccir13Fm3(int cond, int deg, int ord);
+      static double ccir14F2(int cond, int deg, int ord);
+      static double ccir14Fm3(int cond, int deg, int ord);
+      static double ccir15F2(int cond, int deg, int ord);
+      static double ccir15Fm3(int cond, int deg, int ord);
+      static double ccir16F2(int cond, int deg, int ord);
+      static double ccir16Fm3(int cond, int deg, int ord);
+      static double ccir17F2(int cond, int deg, int ord);
+      static double ccir17Fm3(int cond, int deg, int ord);
+      static double ccir18F2(int cond, int deg, int ord);
+      static double ccir18Fm3(int cond, int deg, int ord);
+      static double ccir19F2(int cond, int deg, int ord);
+      static double ccir19Fm3(int cond, int deg, int ord);
+      static double ccir20F2(int cond, int deg, int ord);
+      static double ccir20Fm3(int cond, int deg, int ord);
+      static double ccir21F2(int cond, int deg, int ord);
+      static double ccir21Fm3(int cond, int deg, int ord);
+      static double ccir22F2(int cond, int deg, int ord);
+      static double ccir22Fm3(int cond, int deg, int ord);
          //@}
 
          /** Month of the interpolated data in cacheF2 so we know when
@@ -0,0 +1,283 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+#ifndef GNSSTK_FROZENNAVINDEX_HPP
+#define GNSSTK_FROZENNAVINDEX_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "NavData.hpp"
+#include "NavMessageID.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup NavFactory
+      //@{
+
+      /** Packed, integer-comparable form of a CommonTime used as a
+       * search key in FrozenNavIndex.  The time system is not part
+       * of the key, it is tracked per satellite by FrozenNavIndex. */
+   class FrozenNavTime
+   {
+   public:
+         /// Milliseconds per day, for packing the day into msec.
+      static const int64_t MS_PER_DAY = 86400000;
+         /// Initialize to the start of day 0.
+      FrozenNavTime()
+            : msec(0), fsod(0.0)
+      {}
+         /// Pack the internal representation of a CommonTime.
+      FrozenNavTime(const CommonTime& t)
+      {
+         long day, msod;
+         t.getInternal(day, msod, fsod);
+         msec = static_cast<int64_t>(day) * MS_PER_DAY + msod;
+      }
+      bool operator<(const FrozenNavTime& right) const
+      { return (msec < right.msec) || ((msec == right.msec) &&
+                                       (fsod < right.fsod)); }
+      bool operator>(const FrozenNavTime& right) const
+      { return right < *this; }
+         /// Difference in seconds, as CommonTime::operator-() would.
+      double operator-(const FrozenNavTime& right) const
+      { return (msec - right.msec) * 0.001 + (fsod - right.fsod); }
+
+      int64_t msec; ///< Milliseconds since day 0.
+      double fsod;  ///< Fraction of a millisecond, in seconds.
+   };
+
+
+      /// Extract the value stored in a FrozenNavIndex from a NavMap entry.
+   inline NavDataPtr frozenNavValue(const NavDataPtr& ndp)
+   { return ndp; }
+      /// Extract the value stored in a FrozenNavIndex from a NavNearMap entry.
+   inline std::vector<NavDataPtr> frozenNavValue(const NavDataPtrList& ndpl)
+   { return std::vector<NavDataPtr>(ndpl.begin(), ndpl.end()); }
+
+
+      /** Read-only, contiguous copy of a NavMessageMap or
+       * NavNearMessageMap used by NavDataFactoryWithStore when the
+       * store has been frozen.  Each NavSatelliteID's time-ordered
+       * data is kept in a pair of sorted arrays (packed time keys
+       * and values), and the satellites are bucketed in a hash table
+       * by message type and subject satellite, so a search is one
+       * hash look-up followed by a binary search.
+       * @note The index is a snapshot of the source map, so it must
+       *   be rebuilt (or discarded) whenever the map changes.
+       * @param Value NavDataPtr for User searches, or
+       *   std::vector<NavDataPtr> for Nearest searches. */
+   template <class Value>
+   class FrozenNavIndex
+   {
+   public:
+         /// Time-sorted data for a single NavSatelliteID.
+      class SatData
+      {
+      public:
+         SatData()
+               : timeSys(TimeSystem::Any), mixedTS(false)
+         {}
+            /** Return true if a search time in time system ts can be
+             * compared with the keys of this satellite's data without
+             * CommonTime throwing an exception. */
+         bool compatible(TimeSystem ts) const
+         {
+            return (!mixedTS && ((ts == TimeSystem::Any) ||
+                                 (timeSys == TimeSystem::Any) ||
+                                 (ts == timeSys)));
+         }
+            /** Get the index of the first key that is not less than
+             * when (i.e. std::lower_bound). */
+         size_t lowerBound(const FrozenNavTime& when) const
+         {
+            return std::lower_bound(times.begin(), times.end(), when)
+               - times.begin();
+         }
+         NavSatelliteID sat;            ///< Key from the source map.
+         TimeSystem timeSys;            ///< Time system of the keys.
+         bool mixedTS;                  ///< True if keys' systems differ.
+         std::vector<FrozenNavTime> times; ///< Sorted time keys.
+         std::vector<Value> values;     ///< Values corresponding to times.
+      };
+
+         /// Discard all indexed data.
+      void clear()
+      {
+         byType.clear();
+         bySat.clear();
+         wildSats.clear();
+      }
+
+         /** Build the index from a three-level message map.
+          * @param[in] mm The NavMessageMap or NavNearMessageMap to index.
+          */
+      template <class MsgMap>
+      void build(const MsgMap& mm)
+      {
+         clear();
+         byType.resize(static_cast<size_t>(NavMessageType::Last));
+         wildSats.resize(byType.size());
+         for (const auto& mti : mm)
+         {
+            size_t t = static_cast<size_t>(mti.first);
+            std::vector<SatData>& sats(byType[t]);
+            sats.reserve(mti.second.size());
+            for (const auto& sati : mti.second)
+            {
+               unsigned idx = sats.size();
+               sats.push_back(SatData());
+               SatData& sd(sats.back());
+               sd.sat = sati.first;
+               sd.times.reserve(sati.second.size());
+               sd.values.reserve(sati.second.size());
+               bool first = true;
+               for (const auto& ti : sati.second)
+               {
+                  TimeSystem ts = ti.first.getTimeSystem();
+                  if (first)
+                  {
+                     sd.timeSys = ts;
+                     first = false;
+                  }
+                  else if (ts != sd.timeSys)
+                  {
+                     sd.mixedTS = true;
+                  }
+                  sd.times.push_back(FrozenNavTime(ti.first));
+                  sd.values.push_back(frozenNavValue(ti.second));
+               }
+               if (sd.sat.sat.wildId || sd.sat.sat.wildSys)
+               {
+                  wildSats[t].push_back(idx);
+               }
+               else
+               {
+                  bySat[hashKey(mti.first, sd.sat.sat)].push_back(idx);
+               }
+            }
+               // Stored satellites with a wildcard subject can match
+               // any subject satellite, so add them to every bucket,
+               // keeping the original map order.
+            if (!wildSats[t].empty())
+            {
+               for (auto& bi : bySat)
+               {
+                  if ((bi.first >> 48) != t)
+                     continue;
+                  bi.second.insert(bi.second.end(), wildSats[t].begin(),
+                                   wildSats[t].end());
+                  std::sort(bi.second.begin(), bi.second.end());
+               }
+            }
+         }
+      }
+
+         /** Call func for each SatData that matches nmid, in the
+          * order the source map would have been iterated, until func
+          * returns false.
+          * @param[in] nmid The message ID to match.  If it is not a
+          *   wildcard, only the first match is visited, as
+          *   std::map::find() would.
+          * @param[in] func A callable taking const SatData& and
+          *   returning false to stop iterating. */
+      template <class Func>
+      void forEachMatch(const NavMessageID& nmid, Func func) const
+      {
+         size_t t = static_cast<size_t>(nmid.messageType);
+         if (t >= byType.size())
+            return;
+         const std::vector<SatData>& sats(byType[t]);
+         bool wild = nmid.isWild();
+         const NavSatelliteID& nsid(nmid);
+         if (nmid.sat.wildId || nmid.sat.wildSys)
+         {
+               // subject satellite is a wildcard, linear search
+            for (const auto& sd : sats)
+            {
+               if ((sd.sat == nsid) && !func(sd))
+                  return;
+            }
+            return;
+         }
+         const std::vector<unsigned> *bucket = &wildSats[t];
+         auto bi = bySat.find(hashKey(nmid.messageType, nmid.sat));
+         if (bi != bySat.end())
+         {
+            bucket = &bi->second;
+         }
+         for (unsigned idx : *bucket)
+         {
+            const SatData& sd(sats[idx]);
+            if (wild)
+            {
+               if ((sd.sat == nsid) && !func(sd))
+                  return;
+            }
+            else if (!(sd.sat < nsid) && !(nsid < sd.sat))
+            {
+                  // equivalent keys, as for std::map::find
+               func(sd);
+               return;
+            }
+         }
+      }
+
+   private:
+         /// Compute the hash table key for a message type and subject.
+      static uint64_t hashKey(NavMessageType nmt, const SatID& sat)
+      {
+         return ((static_cast<uint64_t>(nmt) << 48) |
+                 ((static_cast<uint64_t>(sat.system) & 0xffff) << 32) |
+                 (static_cast<uint64_t>(sat.id) & 0xffffffff));
+      }
+
+         /// Satellite data, indexed by NavMessageType.
+      std::vector<std::vector<SatData> > byType;
+         /// Indices into byType[type] for each type+subject satellite.
+      std::unordered_map<uint64_t, std::vector<unsigned> > bySat;
+         /// Indices of stored data with a wildcard subject satellite.
+      std::vector<std::vector<unsigned> > wildSats;
+   };
+
+      //@}
+
+}
+
+#endif // GNSSTK_FROZENNAVINDEX_HPP
@@ -51,6 +51,9 @@ namespace gnsstk
    const double GLOCNavEph::we = 7.2921151467e-5;
 
 
+   double GLOCNavEph::defaultFitAccuracy = 0.0;
+
+
    GLOCNavEph ::
    GLOCNavEph()
          : N4(-1), NT(-1), Mj(GLOCSatType::Unknown), PS(-1), tb(-1),
@@ -63,7 +66,8 @@ namespace gnsstk
            taucdot(std::numeric_limits<double>::quiet_NaN()),
            tauDelta(std::numeric_limits<double>::quiet_NaN()),
            tauGPS(std::numeric_limits<double>::quiet_NaN()),
-           step(60.0)
+           step(60.0),
+           fitAccuracy(defaultFitAccuracy)
    {
       signal.messageType = NavMessageType::Ephemeris;
          // 3x 3 second strings.
@@ -128,7 +132,8 @@ namespace gnsstk
       }
       CommonTime workEpoch(Toe);
       double tolerance(1e-9);
-      bool done(false);
+         // No integration is needed if the orbit fit can be used.
+      bool done(getFitState(when, initialState, accel));
       while (!done)
       {
             // If we are about to overstep, change the stepsize appropriately
@@ -192,6 +197,48 @@ namespace gnsstk
    }
 
 
+   bool GLOCNavEph ::
+   getFitState(const CommonTime& when, Vector<double>& state,
+               const Vector<double>& accel)
+   {
+      if (fitAccuracy <= 0.0)
+      {
+         return false;
+      }
+         // Only fit the interval where getXvt() uses the
+         // simplified model.
+      double halfSpan = 900.0;
+      GLOOrbitFit::Params params = {{ pos[0], pos[1], pos[2],
+                                      vel[0], vel[1], vel[2],
+                                      acc[0], acc[1], acc[2],
+                                      step, halfSpan, fitAccuracy }};
+      std::shared_ptr<const GLOOrbitFit> fit(std::atomic_load(&orbitFit));
+      if (!fit || (fit->getEpoch() != Toe) || (fit->params != params))
+      {
+            // First use, or the ephemeris has been changed since.
+            // Concurrent callers may each compute a fit, but the
+            // results are identical.
+         std::shared_ptr<GLOOrbitFit> newFit(std::make_shared<GLOOrbitFit>());
+         newFit->params = params;
+         newFit->compute(Toe, state, step, halfSpan, fitAccuracy,
+            [this,&accel](Vector<double>& st, double h)
+            {
+                  // long-term corrections aren't used by the
+                  // simplified model
+               Vector<double> k1, k2, k3, k4, lt(3, 0.0);
+               k1 = derivative(st, accel, lt, true);
+               k2 = derivative(st + k1*h/2.0, accel, lt, true);
+               k3 = derivative(st + k2*h/2.0, accel, lt, true);
+               k4 = derivative(st + k3*h, accel, lt, true);
+               st = st + (k1/6.0 + k2/3.0 + k3/3.0 + k4/6.0) * h;
+            });
+         fit = newFit;
+         std::atomic_store(&orbitFit, fit);
+      }
+      return fit->eval(when, state);
+   }
+
+
    CommonTime GLOCNavEph ::
    getUserTime() const
    {
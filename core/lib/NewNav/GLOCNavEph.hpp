@@ -39,10 +39,12 @@
 #ifndef GNSSTK_GLOCNAVEPH_HPP
 #define GNSSTK_GLOCNAVEPH_HPP
 
+#include <memory>
 #include "GLOCNavData.hpp"
 #include "GLOCSatType.hpp"
 #include "GLOCRegime.hpp"
 #include "GLOCNavLTDMP.hpp"
+#include "GLOOrbitFit.hpp"
 #include "gnsstk_export.h"
 
 namespace gnsstk
@@ -164,8 +166,30 @@ namespace gnsstk
           * @note The default value is suggested in ICD-GLONASS-CDMA
           *   General Edition Appendix J. */
       double step;
+         /** If greater than 0, getXvt() evaluates a Chebyshev fit of
+          * the integrated orbit (see GLOOrbitFit) for times within
+          * 15 minutes of Toe, where the simplified model is used,
+          * rather than integrating for every call.  The fit is
+          * computed on first use and must agree with the Runge-Kutta
+          * integration using \a step to within this many meters in
+          * position and m/s in velocity, otherwise integration is
+          * used as usual. */
+      double fitAccuracy;
+         /** The value of fitAccuracy for newly constructed objects.
+          * Defaults to 0, i.e. the fit is disabled. */
+      GNSSTK_EXPORT static double defaultFitAccuracy;
 
    private:
+         /** Get the state vector at a time using the orbit fit,
+          * computing the fit first if necessary.
+          * @param[in] when The time at which to compute the state.
+          * @param[in,out] state On input, the state vector at Toe.
+          *   On successful output, the state vector at \a when.
+          * @param[in] accel The luni-solar acceleration at Toe (m/s**2).
+          * @return true if \a state was computed using the fit. */
+      bool getFitState(const CommonTime& when, Vector<double>& state,
+                       const Vector<double>& accel);
+
          /** Function implementing the derivative of GLONASS orbital model.
           * @see ICD GLONASS CDMA General Description Appendix J.2.1.
           * @param[in] inState The input state vector consisting of
@@ -181,6 +205,8 @@ namespace gnsstk
                                 const Vector<double>& accel,
                                 const Vector<double>& lt,
                                 bool simplified) const;
+         /// The orbit fit, shared between threads once computed.
+      std::shared_ptr<const GLOOrbitFit> orbitFit;
    };
 
       //@}
@@ -46,6 +46,9 @@ using namespace std;
 
 namespace gnsstk
 {
+   double GLOFNavEph::defaultFitAccuracy = 0.0;
+
+
    GLOFNavEph ::
    GLOFNavEph()
          : clkBias(std::numeric_limits<double>::quiet_NaN()),
@@ -60,7 +63,8 @@ namespace gnsstk
            accIndex(-1),
            dayCount(-1),
               // recommended by ICD, good balance of performance and accuracy
-           step(60.0)
+           step(60.0),
+           fitAccuracy(defaultFitAccuracy)
    {
       signal.messageType = NavMessageType::Ephemeris;
       msgLenSec = 8.0;
@@ -120,7 +124,8 @@ namespace gnsstk
       }
       CommonTime workEpoch(Toe);
       double tolerance(1e-9);
-      bool done(false);
+         // No integration is needed if the orbit fit can be used.
+      bool done(getFitState(when, initialState, accel));
       while (!done)
       {
             // If we are about to overstep, change the stepsize appropriately
@@ -173,6 +178,46 @@ namespace gnsstk
    }
 
 
+   bool GLOFNavEph ::
+   getFitState(const CommonTime& when, Vector<double>& state,
+               const Vector<double>& accel)
+   {
+      if (fitAccuracy <= 0.0)
+      {
+         return false;
+      }
+         // Same interval as fixFit(), on both sides of Toe.
+      unsigned kludge = (((interval > 0) && (interval <= 60)) ? interval : 30);
+      double halfSpan = kludge*30.0 + 30.0;
+      GLOOrbitFit::Params params = {{ pos[0], pos[1], pos[2],
+                                      vel[0], vel[1], vel[2],
+                                      acc[0], acc[1], acc[2],
+                                      step, halfSpan, fitAccuracy }};
+      std::shared_ptr<const GLOOrbitFit> fit(std::atomic_load(&orbitFit));
+      if (!fit || (fit->getEpoch() != Toe) || (fit->params != params))
+      {
+            // First use, or the ephemeris has been changed since.
+            // Concurrent callers may each compute a fit, but the
+            // results are identical.
+         std::shared_ptr<GLOOrbitFit> newFit(std::make_shared<GLOOrbitFit>());
+         newFit->params = params;
+         newFit->compute(Toe, state, step, halfSpan, fitAccuracy,
+            [this,&accel](Vector<double>& st, double h)
+            {
+               Vector<double> k1, k2, k3, k4;
+               k1 = derivative(st, accel);
+               k2 = derivative(st + k1*h/2.0, accel);
+               k3 = derivative(st + k2*h/2.0, accel);
+               k4 = derivative(st + k3*h, accel);
+               st = st + (k1/6.0 + k2/3.0 + k3/3.0 + k4/6.0) * h;
+            });
+         fit = newFit;
+         std::atomic_store(&orbitFit, fit);
+      }
+      return fit->eval(when, state);
+   }
+
+
    CommonTime GLOFNavEph ::
    getUserTime() const
    {
@@ -39,7 +39,10 @@
 #ifndef GNSSTK_GLOFNAVEPH_HPP
 #define GNSSTK_GLOFNAVEPH_HPP
 
+#include <memory>
 #include "GLOFNavData.hpp"
+#include "GLOOrbitFit.hpp"
+#include "gnsstk_export.h"
 
 namespace gnsstk
 {
@@ -129,11 +132,34 @@ namespace gnsstk
       CommonTime Toe;     ///< Orbit epoch (t_b).
          /// Integration step for Runge-Kutta algorithm (1 second by default)
       double step;
+         /** If greater than 0, getXvt() evaluates a Chebyshev fit of
+          * the integrated orbit (see GLOOrbitFit) for times within
+          * half of \a interval (plus 30 seconds) of Toe rather than
+          * integrating for every call.  The fit is computed on first
+          * use and must agree with the Runge-Kutta integration using
+          * \a step to within this many meters in position and m/s in
+          * velocity, otherwise integration is used as usual. */
+      double fitAccuracy;
+         /** The value of fitAccuracy for newly constructed objects.
+          * Defaults to 0, i.e. the fit is disabled. */
+      GNSSTK_EXPORT static double defaultFitAccuracy;
 
    private:
+         /** Get the state vector at a time using the orbit fit,
+          * computing the fit first if necessary.
+          * @param[in] when The time at which to compute the state.
+          * @param[in,out] state On input, the state vector at Toe.
+          *   On successful output, the state vector at \a when.
+          * @param[in] accel The luni-solar acceleration at Toe (m/s**2).
+          * @return true if \a state was computed using the fit. */
+      bool getFitState(const CommonTime& when, Vector<double>& state,
+                       const Vector<double>& accel);
+
          /// Function implementing the derivative of GLONASS orbital model.
       Vector<double> derivative(const Vector<double>& inState,
                                 const Vector<double>& accel) const;
+         /// The orbit fit, shared between threads once computed.
+      std::shared_ptr<const GLOOrbitFit> orbitFit;
    };
 
       //@}
@@ -0,0 +1,244 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+#include <algorithm>
+#include <cmath>
+#include "GLOOrbitFit.hpp"
+#include "GNSSconstants.hpp"
+
+using namespace std;
+
+namespace gnsstk
+{
+   const unsigned GLOOrbitFit::numCoeff;
+   const unsigned GLOOrbitFit::maxSegments;
+
+
+   GLOOrbitFit ::
+   GLOOrbitFit()
+         : params(),
+           halfSpan(0.0),
+           numSegments(0)
+   {
+   }
+
+
+   bool GLOOrbitFit ::
+   compute(const CommonTime& ep, const Vector<double>& init, double step,
+           double span, double accuracy, const StepFunc& stepper)
+   {
+      epoch = ep;
+      halfSpan = span;
+      numSegments = 0;
+      coeff.clear();
+      if ((halfSpan <= 0.0) || (step <= 0.0) || (init.size() != 6))
+      {
+         return false;
+      }
+      std::vector<double> offsets;
+      std::vector<Vector<double> > states;
+      std::vector<double> c;
+      Vector<double> fitState(6);
+      for (unsigned segs = 1; segs <= maxSegments; segs *= 2)
+      {
+         double half = halfSpan / segs;
+         offsets.clear();
+            // Chebyshev nodes used to compute the coefficients...
+         for (unsigned s = 0; s < segs; s++)
+         {
+            double mid = -halfSpan + (2*s+1) * half;
+            for (unsigned k = 0; k < numCoeff; k++)
+            {
+               offsets.push_back(mid + half * ::cos(PI*(k+0.5)/numCoeff));
+            }
+         }
+            // ...and the extrema of the first omitted term, which
+            // includes the segment end points, for checking the fit.
+         size_t numNodes = offsets.size();
+         for (unsigned s = 0; s < segs; s++)
+         {
+            double mid = -halfSpan + (2*s+1) * half;
+            for (unsigned k = 0; k <= numCoeff; k++)
+            {
+               offsets.push_back(mid + half * ::cos(PI*k/numCoeff));
+            }
+         }
+         integrate(offsets, init, step, stepper, states);
+         c.assign(segs * 6 * numCoeff, 0.0);
+         for (unsigned s = 0; s < segs; s++)
+         {
+            for (unsigned i = 0; i < 6; i++)
+            {
+               double *ci = &c[(s*6 + i) * numCoeff];
+               for (unsigned j = 0; j < numCoeff; j++)
+               {
+                  double sum = 0.0;
+                  for (unsigned k = 0; k < numCoeff; k++)
+                  {
+                     sum += states[s*numCoeff+k](i) *
+                        ::cos(PI*j*(k+0.5)/numCoeff);
+                  }
+                  ci[j] = sum * 2.0 / numCoeff;
+               }
+               ci[0] /= 2.0;
+            }
+         }
+         bool good = true;
+         for (unsigned s = 0; good && (s < segs); s++)
+         {
+            for (unsigned k = 0; good && (k <= numCoeff); k++)
+            {
+               const Vector<double>& ref(
+                  states[numNodes + s*(numCoeff+1) + k]);
+               evalSegment(&c[s*6*numCoeff], ::cos(PI*k/numCoeff),
+                           fitState);
+               for (unsigned i = 0; i < 6; i++)
+               {
+                  if (std::fabs(fitState(i) - ref(i)) > accuracy)
+                  {
+                     good = false;
+                     break;
+                  }
+               }
+            }
+         }
+         if (good)
+         {
+            numSegments = segs;
+            coeff.swap(c);
+            return true;
+         }
+      }
+      return false;
+   }
+
+
+   bool GLOOrbitFit ::
+   eval(const CommonTime& when, Vector<double>& state) const
+   {
+      if (numSegments == 0)
+      {
+         return false;
+      }
+      double dt = when - epoch;
+      if (std::fabs(dt) > halfSpan)
+      {
+         return false;
+      }
+      double half = halfSpan / numSegments;
+      unsigned s = static_cast<unsigned>((dt + halfSpan) / (2.0 * half));
+      s = std::min(s, numSegments-1);
+      double x = (dt - (-halfSpan + (2*s+1) * half)) / half;
+      if (state.size() != 6)
+      {
+         state.resize(6);
+      }
+      evalSegment(&coeff[s*6*numCoeff], x, state);
+      return true;
+   }
+
+
+   void GLOOrbitFit ::
+   integrate(const std::vector<double>& offsets, const Vector<double>& init,
+             double step, const StepFunc& stepper,
+             std::vector<Vector<double> >& states)
+   {
+      states.assign(offsets.size(), init);
+         // Visit the offsets on each side of the epoch in order of
+         // increasing distance, so the integration is done once.
+      std::vector<size_t> order(offsets.size());
+      for (size_t i = 0; i < order.size(); i++)
+      {
+         order[i] = i;
+      }
+      std::sort(order.begin(), order.end(),
+                [&offsets](size_t a, size_t b)
+                { return std::fabs(offsets[a]) < std::fabs(offsets[b]); });
+      for (double dir : {1.0, -1.0})
+      {
+         Vector<double> gridState(init), partial;
+         double gridTime = 0.0;
+         for (size_t idx : order)
+         {
+            double target = offsets[idx] * dir;
+            if (target <= 0.0)
+            {
+                  // other side or exactly at the epoch
+               continue;
+            }
+               // Full steps as long as they don't overstep...
+            while (gridTime + step <= target)
+            {
+               stepper(gridState, step * dir);
+               gridTime += step;
+            }
+               // ...then a partial step to the target, matching the
+               // ephemeris getXvt() methods.
+            if (target - gridTime < 1e-9)
+            {
+               states[idx] = gridState;
+            }
+            else
+            {
+               partial = gridState;
+               stepper(partial, (target - gridTime) * dir);
+               states[idx] = partial;
+            }
+         }
+      }
+   }
+
+
+   void GLOOrbitFit ::
+   evalSegment(const double *c, double x, Vector<double>& state)
+   {
+         // Clenshaw recurrence for each state component.
+      for (unsigned i = 0; i < 6; i++, c += numCoeff)
+      {
+         double b1 = 0.0, b2 = 0.0;
+         for (unsigned j = numCoeff-1; j > 0; j--)
+         {
+            double tmp = 2.0 * x * b1 - b2 + c[j];
+            b2 = b1;
+            b1 = tmp;
+         }
+         state(i) = x * b1 - b2 + c[0];
+      }
+   }
+
+}
@@ -0,0 +1,162 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+#ifndef GNSSTK_GLOORBITFIT_HPP
+#define GNSSTK_GLOORBITFIT_HPP
+
+#include <array>
+#include <functional>
+#include <vector>
+#include "CommonTime.hpp"
+#include "Vector.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup NavFactory
+      //@{
+
+      /** Piecewise Chebyshev approximation of a GLONASS orbit that
+       * has been numerically integrated from the broadcast state.
+       * GLONASS ephemerides are evaluated by integrating the
+       * equations of motion from t_b to the time of interest, which
+       * costs a number of Runge-Kutta steps for every position
+       * computed.  This class integrates the orbit once over an
+       * interval around t_b, fits Chebyshev series to the
+       * resulting position and velocity, and verifies the fit
+       * against the integrator before allowing it to be used.
+       * Objects are immutable once computed so they may be shared
+       * between threads. */
+   class GLOOrbitFit
+   {
+   public:
+         /** Advance a state vector [x, x', y, y', z, z'] (m, m/s) by
+          * a single integration step of h seconds. */
+      using StepFunc = std::function<void(Vector<double>& state, double h)>;
+         /** Parameters identifying the ephemeris a fit was computed
+          * from, cf. params.  Fixed size so that the check made on
+          * every getXvt() call doesn't allocate. */
+      using Params = std::array<double, 12>;
+
+         /// Number of Chebyshev coefficients in each series.
+      static const unsigned numCoeff = 12;
+         /// Maximum number of segments the interval will be split into.
+      static const unsigned maxSegments = 16;
+
+         /// Initialize to an empty (unusable) fit.
+      GLOOrbitFit();
+
+         /** Integrate the orbit and compute the fit.  The states at
+          * the fit and check points are computed exactly as a call
+          * to the ephemeris' getXvt() would compute them, i.e. by
+          * taking steps of \a step seconds away from t_b followed by
+          * a single partial step to the time of interest.  The
+          * interval is split into more segments until the fit
+          * agrees with the integrator to within \a accuracy.
+          * @param[in] epoch The reference time t_b of \a init.
+          * @param[in] init The state vector at \a epoch.
+          * @param[in] step The nominal integration step in seconds.
+          * @param[in] halfSpan The fit covers the times within
+          *   halfSpan seconds of \a epoch.
+          * @param[in] accuracy The maximum allowed difference
+          *   between the fit and the integrator in position (m) and
+          *   in velocity (m/s).
+          * @param[in] stepper The single step integrator.
+          * @return true if the accuracy requirement was met, which
+          *   is also the value subsequently returned by isValid(). */
+      bool compute(const CommonTime& epoch, const Vector<double>& init,
+                   double step, double halfSpan, double accuracy,
+                   const StepFunc& stepper);
+
+         /** Evaluate the fit.
+          * @param[in] when The time at which to compute the state.
+          * @param[out] state The state vector [x, x', y, y', z, z']
+          *   in m and m/s.
+          * @return false if the fit is not valid or \a when is
+          *   outside the fit interval, in which case \a state is
+          *   unchanged. */
+      bool eval(const CommonTime& when, Vector<double>& state) const;
+
+         /// @return The reference time the fit was computed for.
+      const CommonTime& getEpoch() const
+      { return epoch; }
+
+         /// @return true if the fit was successfully computed.
+      bool isValid() const
+      { return numSegments > 0; }
+
+         /** Parameters identifying the ephemeris the fit was computed
+          * from.  The owner sets and compares these to determine
+          * whether the fit needs to be recomputed. */
+      Params params;
+
+   private:
+         /** Compute the states at the given offsets from the epoch.
+          * @param[in] offsets The time offsets in seconds.
+          * @param[in] init The state vector at offset 0.
+          * @param[in] step The nominal integration step in seconds.
+          * @param[in] stepper The single step integrator.
+          * @param[out] states The states at each offset, in the same
+          *   order as offsets. */
+      static void integrate(const std::vector<double>& offsets,
+                            const Vector<double>& init, double step,
+                            const StepFunc& stepper,
+                            std::vector<Vector<double> >& states);
+
+         /** Evaluate the series of a single segment.
+          * @param[in] c The first coefficient of the segment.
+          * @param[in] x The normalized time within the segment [-1,1].
+          * @param[out] state The evaluated state vector. */
+      static void evalSegment(const double *c, double x,
+                              Vector<double>& state);
+
+         /// The reference time t_b.
+      CommonTime epoch;
+         /// The fit interval is [-halfSpan,+halfSpan] seconds from epoch.
+      double halfSpan;
+         /// The number of equal length segments, 0 if not valid.
+      unsigned numSegments;
+         /** Coefficients, numCoeff for each of the 6 state
+          * components, for each segment in order. */
+      std::vector<double> coeff;
+   };
+
+      //@}
+
+}
+
+#endif // GNSSTK_GLOORBITFIT_HPP
@@ -36,12 +36,66 @@
 //                            release, distribution is unlimited.
 //
 //==============================================================================
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
 #include "MultiFormatNavDataFactory.hpp"
 #include "BasicTimeSystemConverter.hpp"
 #include "NDFUniqConstIterator.hpp"
+#include "ThreadGroup.hpp"
 
 namespace gnsstk
 {
+      /** Collect the data decoded from a file so it can be added to
+       * a store later, used by addDataSources(). */
+   class NavDataCollector : public NavDataFactoryCallback
+   {
+   public:
+      bool process(const NavDataPtr& navOut) override
+      {
+         navList.push_back(navOut);
+         return true;
+      }
+         /// The decoded data, in the order produced by the factory.
+      NavDataPtrList navList;
+   };
+
+
+      /// The results of one factory's attempt to parse a file.
+   class NavDataStagedLoad
+   {
+   public:
+      NavDataStagedLoad(NavDataFactoryWithStoreFile *f)
+            : fact(f), success(false)
+      {}
+         /// The factory that parsed the file.
+      NavDataFactoryWithStoreFile *fact;
+         /// The data decoded by fact.
+      NavDataCollector collector;
+         /// The return value of fact->process().
+      bool success;
+   };
+
+
+      /// The staged results of parsing one file.
+   class NavDataStagedFile
+   {
+   public:
+      NavDataStagedFile()
+            : done(false)
+      {}
+         /** Each factory tried, in order, up to and including the
+          * first that succeeded. */
+      std::list<NavDataStagedLoad> loads;
+         /// Any exception thrown while parsing.
+      std::exception_ptr error;
+         /// Set when the file has been parsed.
+      bool done;
+   };
+
+
    MultiFormatNavDataFactory ::
    MultiFormatNavDataFactory()
    {
@@ -89,6 +143,35 @@ namespace gnsstk
    }
 
 
+   bool MultiFormatNavDataFactory ::
+   findSpan(const NavMessageID& nmid, const CommonTime& when,
+            NavDataPtr& navOut, SVHealth xmitHealth, NavValidityType valid,
+            NavSearchOrder order, CommonTime& validFrom, CommonTime& validTo)
+   {
+      validFrom = validTo = when;
+      std::set<NavDataFactory*> uniques;
+      for (auto& fi : *myFactories)
+      {
+         if ((fi.first == nmid) && (uniques.count(fi.second.get()) == 0))
+         {
+            if (uniques.empty())
+            {
+               if (fi.second->findSpan(nmid, when, navOut, xmitHealth, valid,
+                                       order, validFrom, validTo))
+                  return true;
+            }
+            else if (fi.second->find(nmid, when, navOut, xmitHealth, valid,
+                                     order))
+            {
+               return true;
+            }
+            uniques.insert(fi.second.get());
+         }
+      }
+      return false;
+   }
+
+
    bool MultiFormatNavDataFactory ::
    getOffset(TimeSystem fromSys, TimeSystem toSys,
              const CommonTime& when, NavDataPtr& offset,
@@ -148,6 +231,36 @@ namespace gnsstk
    }
 
 
+   void MultiFormatNavDataFactory ::
+   freeze()
+   {
+      for (auto& fi : NDFUniqIterator<NavDataFactoryMap>(*myFactories))
+      {
+         NavDataFactoryWithStore *ndfws =
+            dynamic_cast<NavDataFactoryWithStore*>(fi.second.get());
+         if (ndfws != nullptr)
+         {
+            ndfws->freeze();
+         }
+      }
+   }
+
+
+   void MultiFormatNavDataFactory ::
+   thaw()
+   {
+      for (auto& fi : NDFUniqIterator<NavDataFactoryMap>(*myFactories))
+      {
+         NavDataFactoryWithStore *ndfws =
+            dynamic_cast<NavDataFactoryWithStore*>(fi.second.get());
+         if (ndfws != nullptr)
+         {
+            ndfws->thaw();
+         }
+      }
+   }
+
+
    CommonTime MultiFormatNavDataFactory ::
    getInitialTime() const
    {
@@ -458,6 +571,151 @@ namespace gnsstk
    }
 
 
+   bool MultiFormatNavDataFactory ::
+   addDataSources(const std::vector<std::string>& sources, unsigned threads)
+   {
+      bool rv = true;
+      if (threads == 0)
+      {
+         threads = std::thread::hardware_concurrency();
+      }
+      threads = std::min<size_t>(std::max(threads, 1U), sources.size());
+      if (threads <= 1)
+      {
+         for (const auto& source : sources)
+         {
+            rv &= addDataSource(source);
+         }
+         return rv;
+      }
+      std::vector<NavDataFactoryWithStoreFile*> facts;
+      for (auto& fi : NDFUniqIterator<NavDataFactoryMap>(*myFactories))
+      {
+         NavDataFactoryWithStoreFile *fact =
+            dynamic_cast<NavDataFactoryWithStoreFile*>(fi.second.get());
+         if (fact != nullptr)
+         {
+            facts.push_back(fact);
+         }
+      }
+      std::vector<NavDataStagedFile> staged(sources.size());
+      std::atomic<size_t> nextFile(0);
+      std::mutex stagedMutex;
+      std::condition_variable stagedCond;
+         // Parse files in parallel without touching the stores,
+         // which is the time-consuming part.
+      auto parser = [&]()
+      {
+         size_t i;
+         while ((i = nextFile++) < sources.size())
+         {
+            std::list<NavDataStagedLoad> loads;
+            std::exception_ptr error;
+            try
+            {
+               for (auto fact : facts)
+               {
+                  loads.emplace_back(fact);
+                  NavDataStagedLoad& load(loads.back());
+                  if ((load.success = fact->process(sources[i],
+                                                    load.collector)))
+                  {
+                     break;
+                  }
+               }
+            }
+            catch (...)
+            {
+               error = std::current_exception();
+            }
+            {
+               std::lock_guard<std::mutex> guard(stagedMutex);
+               staged[i].loads.swap(loads);
+               staged[i].error = error;
+               staged[i].done = true;
+            }
+            stagedCond.notify_all();
+         }
+      };
+         // The group joins the workers on every path out of here.
+      ThreadGroup workers;
+      std::exception_ptr error;
+      try
+      {
+         for (unsigned t = 0; t < threads; t++)
+         {
+            workers.create(parser);
+         }
+      }
+      catch (...)
+      {
+         error = std::current_exception();
+      }
+         // Add the staged data to the stores in file order while
+         // the workers continue parsing later files.
+      for (size_t i = 0; (i < sources.size()) && !error; i++)
+      {
+         std::list<NavDataStagedLoad> loads;
+         {
+            std::unique_lock<std::mutex> guard(stagedMutex);
+            stagedCond.wait(guard, [&]{ return staged[i].done; });
+            loads.swap(staged[i].loads);
+            error = staged[i].error;
+         }
+         try
+         {
+            bool loaded = false;
+            size_t tried = 0;
+            for (auto& load : loads)
+            {
+               tried++;
+                  // Serial loading adds data to the store as it's
+                  // decoded, so even a failed attempt leaves its
+                  // data behind.
+               bool added = true;
+               for (const auto& ndp : load.collector.navList)
+               {
+                  if (!(added = load.fact->addNavData(ndp)))
+                     break;
+               }
+               if (load.success && added)
+               {
+                  loaded = true;
+                  break;
+               }
+               if (!added)
+               {
+                     // The store rejected the data, which in serial
+                     // loading causes the factory to fail and the
+                     // next one to be tried, so do exactly that.
+                  for (size_t f = tried; !loaded && (f < facts.size()); f++)
+                  {
+                     loaded = facts[f]->addDataSource(sources[i]);
+                  }
+                  break;
+               }
+            }
+            if (!error)
+            {
+               rv &= loaded;
+            }
+         }
+         catch (...)
+         {
+            error = std::current_exception();
+         }
+      }
+         // Stop the workers early if an error occurred.
+      nextFile = sources.size();
+      workers.join();
+      if (error)
+      {
+         std::rethrow_exception(error);
+      }
+      return rv;
+   }
+
+
    bool MultiFormatNavDataFactory ::
    process(const std::string& filename,
            NavDataFactoryCallback& cb)
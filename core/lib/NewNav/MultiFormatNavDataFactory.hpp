@@ -70,6 +70,12 @@ namespace gnsstk
        * @warning Instantiating more than one of this class at any
        *   time will likely have unexpected results due to the shared
        *   (static) data stored internally.  DON'T DO IT.
+       * @note The search, load and edit methods are thread-safe to
+       *   the extent that the child factories are (see
+       *   NavDataFactoryWithStore), as this class has no store of
+       *   its own.  addFactory() and the filter and control
+       *   settings modify the shared factory map and must not be
+       *   called while other threads are using the factory.
        */
    class MultiFormatNavDataFactory : public NavDataFactoryWithStoreFile
    {
@@ -100,6 +106,15 @@ namespace gnsstk
                 NavDataPtr& navOut, SVHealth xmitHealth, NavValidityType valid,
                 NavSearchOrder order) override;
 
+         /** @copydoc NavDataFactory::findSpan()
+          * @note A non-empty span is only returned when the first
+          *   factory searched yields the result, as data that
+          *   appears in earlier factories takes precedence. */
+      bool findSpan(const NavMessageID& nmid, const CommonTime& when,
+                    NavDataPtr& navOut, SVHealth xmitHealth,
+                    NavValidityType valid, NavSearchOrder order,
+                    CommonTime& validFrom, CommonTime& validTo) override;
+
          /// @copydoc NavDataFactory::getOffset()
       bool getOffset(TimeSystem fromSys, TimeSystem toSys,
                      const CommonTime& when, NavDataPtr& offset,
@@ -139,6 +154,12 @@ namespace gnsstk
          /// Remove all data from the internal store.
       void clear() override;
 
+         /// Freeze the store of each factory in factories.
+      void freeze() override;
+
+         /// Discard the frozen index of each factory in factories.
+      void thaw() override;
+
          /** Determine the earliest time for which this object can successfully
           * determine the Xvt for any object.
           * @note In the case that data from multiple systems is
@@ -292,6 +313,34 @@ namespace gnsstk
           *   factories succeeded. */
       bool addDataSource(const std::string& source) override;
 
+         /** Load multiple files, parsing them in parallel.  Each
+          * file is parsed by a worker thread into a private staging
+          * list, trying the available factories in the same order
+          * as addDataSource().  The staged data are then added to
+          * the factories' stores in the order the files are given,
+          * so the resulting stores, including which duplicate
+          * messages are kept, are the same as calling
+          * addDataSource() for each file in turn.
+          * @note Time system consistency checks that depend on
+          *   previously loaded files (e.g. SP3) are made while
+          *   parsing, so when files with conflicting time systems
+          *   are given, which of them is rejected may vary.
+          *   Likewise, loading a RINEX clock file switches
+          *   SP3NavDataFactory to RINEX clock data while parsing,
+          *   so SP3 clock data from files parsed before the switch
+          *   may be retained.  Call
+          *   SP3NavDataFactory::useRinexClockData() before loading
+          *   a mix of SP3 and RINEX clock files.
+          * @param[in] sources The paths of the files to load.
+          * @param[in] threads The number of parsing threads to use.
+          *   If 0, std::thread::hardware_concurrency() is used.  If
+          *   1, the files are loaded serially via addDataSource().
+          * @return true if every file was loaded successfully, false
+          *   if any of the files could not be loaded by any of the
+          *   available factories. */
+      bool addDataSources(const std::vector<std::string>& sources,
+                          unsigned threads = 0);
+
          /// @copydoc NavDataFactoryWithStoreFile::process(const std::string&,NavDataFactoryCallback&)
       bool process(const std::string& filename,
                    NavDataFactoryCallback& cb) override;
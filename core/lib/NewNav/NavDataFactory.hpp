@@ -93,6 +93,37 @@ namespace gnsstk
                         NavDataPtr& navOut, SVHealth xmitHealth,
                         NavValidityType valid, NavSearchOrder order) = 0;
 
+         /** Search for navigation data as find() does, and also
+          * determine the span of time [validFrom,validTo) over which
+          * the same search would yield the same navOut, assuming the
+          * store doesn't change.  This is used by NavLibrary to avoid
+          * repeating searches for sequential epochs.  The default
+          * implementation returns an empty span (validFrom ==
+          * validTo), meaning the result must not be reused.
+          * @param[in] nmid Specify the message type, satellite and
+          *   codes to match.
+          * @param[in] when The time of interest to search for data.
+          * @param[out] navOut The resulting navigation message.
+          * @param[in] xmitHealth The desired health status of the
+          *   transmitting satellite.
+          * @param[in] valid Specify whether to search only for valid
+          *   or invalid messages, or both.
+          * @param[in] order Specify whether to search by receiver
+          *   behavior or by nearest to when in time.
+          * @param[out] validFrom The earliest time for which navOut
+          *   would be the result of this search.
+          * @param[out] validTo The earliest time after validFrom for
+          *   which navOut would NOT be the result of this search.
+          * @return true if successful.  If false, navData will be untouched. */
+      virtual bool findSpan(const NavMessageID& nmid, const CommonTime& when,
+                            NavDataPtr& navOut, SVHealth xmitHealth,
+                            NavValidityType valid, NavSearchOrder order,
+                            CommonTime& validFrom, CommonTime& validTo)
+      {
+         validFrom = validTo = when;
+         return find(nmid, when, navOut, xmitHealth, valid, order);
+      }
+
          /** Get the offset, in seconds, to apply to times when
           * converting them from fromSys to toSys.
           * @pre If xmithHealth is set to anything other than "Any",
@@ -51,8 +51,12 @@ static const std::string dts("%Y/%03j/%02H:%02M:%02S %P");
 
 namespace gnsstk
 {
+   std::atomic<unsigned long> NavDataFactoryWithStore::changeCount(0);
+
+
    NavDataFactoryWithStore ::
    NavDataFactoryWithStore()
+         : frozen(false)
    {
          // We are NOT using END_OF_TIME or BEGINNING_OF_TIME here
          // because of issues with static initialization order.  As
@@ -69,6 +73,7 @@ namespace gnsstk
         NavDataPtr& navOut, SVHealth xmitHealth, NavValidityType valid,
         NavSearchOrder order)
    {
+      ReadWriteLock::ReadGuard guard(storeLock);
       bool rv = false;
       switch (order)
       {
@@ -127,6 +132,12 @@ namespace gnsstk
       typedef std::list<FindMatches> MatchList;
 
       DEBUGTRACE("nmid=" << nmid << "  when=" << gnsstk::printTime(when,dts));
+      bool frv = false;
+      if (frozen &&
+          findUserFrozen(nmid, when, navData, xmitHealth, valid, frv))
+      {
+         return frv;
+      }
 
          // dig through the maps of maps, matching keys with nmid along the way
       auto dataIt = data.find(nmid.messageType);
@@ -327,6 +338,12 @@ namespace gnsstk
       };
       typedef std::list<FindMatches> MatchList;
 
+      bool frv = false;
+      if (frozen &&
+          findNearestFrozen(nmid, when, navData, xmitHealth, valid, frv))
+      {
+         return frv;
+      }
          // dig through the maps of maps, matching keys with nmid along the way
       auto dataIt = nearestData.find(nmid.messageType);
       if (dataIt == nearestData.end())
@@ -435,6 +452,325 @@ namespace gnsstk
    }
 
 
+   void NavDataFactoryWithStore ::
+   freeze()
+   {
+      ReadWriteLock::WriteGuard guard(storeLock);
+      frozenData.build(data);
+      frozenNearest.build(nearestData);
+      frozen = true;
+   }
+
+
+   void NavDataFactoryWithStore ::
+   thaw()
+   {
+      ReadWriteLock::WriteGuard guard(storeLock);
+      discardFrozen();
+   }
+
+
+   void NavDataFactoryWithStore ::
+   discardFrozen()
+   {
+      if (frozen)
+      {
+         frozen = false;
+         frozenData.clear();
+         frozenNearest.clear();
+      }
+   }
+
+
+   void NavDataFactoryWithStore ::
+   storeChanged()
+   {
+      ++changeCount;
+      discardFrozen();
+   }
+
+
+   bool NavDataFactoryWithStore ::
+   findSpan(const NavMessageID& nmid, const CommonTime& when,
+            NavDataPtr& navOut, SVHealth xmitHealth, NavValidityType valid,
+            NavSearchOrder order, CommonTime& validFrom, CommonTime& validTo)
+   {
+      DEBUGTRACE_FUNCTION();
+      ReadWriteLock::ReadGuard guard(storeLock);
+      validFrom = validTo = when;
+      if (!find(nmid, when, navOut, xmitHealth, valid, order))
+      {
+         return false;
+      }
+      if (order != NavSearchOrder::User)
+      {
+         return true;
+      }
+      auto dataIt = data.find(nmid.messageType);
+      if (dataIt == data.end())
+      {
+         return true;
+      }
+         // The result of findUser() can only change when data with a
+         // user time in (userTime,when] appears in any of the maps
+         // matching nmid, or the fit interval no longer includes
+         // the time of interest.  If such data already exists, it
+         // was rejected for some reason and we don't try to figure
+         // out whether that will remain the case.
+      CommonTime userTime(navOut->getUserTime());
+      CommonTime from(userTime), to(CommonTime::END_OF_TIME);
+      bool found = false;
+      for (const auto& sati : dataIt->second)
+      {
+         if (sati.first != nmid)
+            continue;
+         auto nmi = sati.second.upper_bound(when);
+         if ((nmi != sati.second.end()) && (nmi->first < to))
+         {
+            to = nmi->first;
+         }
+         if (nmi != sati.second.begin())
+         {
+            auto prev = std::prev(nmi);
+            if (prev->first > userTime)
+            {
+               return true;
+            }
+            if (prev->second == navOut)
+            {
+               found = true;
+            }
+         }
+      }
+      if (!found)
+      {
+            // result didn't come directly from the store
+         return true;
+      }
+      NavFit *nf = dynamic_cast<NavFit*>(navOut.get());
+      if (nf != nullptr)
+      {
+         if (nf->beginFit > from)
+            from = nf->beginFit;
+         if (nf->endFit < to)
+            to = nf->endFit;
+      }
+      if ((from <= when) && (when < to))
+      {
+         validFrom = from;
+         validTo = to;
+      }
+      return true;
+   }
+
+
+   bool NavDataFactoryWithStore ::
+   findUserFrozen(const NavMessageID& nmid, const CommonTime& when,
+                  NavDataPtr& navData, SVHealth xmitHealth,
+                  NavValidityType valid, bool& rv)
+   {
+      DEBUGTRACE_FUNCTION();
+         // Same algorithm as findUser, using array indices in place
+         // of NavMap iterators, with npos in place of end().
+      using SatData = FrozenNavIndex<NavDataPtr>::SatData;
+      static const size_t npos = static_cast<size_t>(-1);
+      class FindMatches
+      {
+      public:
+         FindMatches(const SatData *theSat, size_t theIdx)
+               : sat(theSat), finished(false), idx(theIdx)
+         {}
+         const SatData *sat;
+         bool finished;
+         size_t idx;
+      };
+      std::vector<FindMatches> itList;
+      FrozenNavTime whenKey(when);
+      TimeSystem whenTS = when.getTimeSystem();
+      TimeSystem matchTS = TimeSystem::Any;
+      bool usable = true;
+      frozenData.forEachMatch(
+         nmid,
+         [&](const SatData& sd)
+         {
+               // The map search would throw or behave differently
+               // when comparing times in different time systems, so
+               // let it do that.
+            if (!sd.compatible(whenTS) || !sd.compatible(matchTS))
+            {
+               usable = false;
+               return false;
+            }
+            if (sd.timeSys != TimeSystem::Any)
+            {
+               matchTS = sd.timeSys;
+            }
+            size_t idx = sd.lowerBound(whenKey);
+            if (idx == sd.times.size())
+            {
+               idx--;
+            }
+            while ((idx != npos) && (sd.times[idx] > whenKey))
+            {
+               idx = (idx == 0 ? npos : idx-1);
+            }
+            if (idx != npos)
+            {
+               itList.push_back(FindMatches(&sd, idx));
+            }
+            return true;
+         });
+      if (!usable)
+      {
+         return false;
+      }
+      FrozenNavTime mostRecent;
+      bool haveRecent = false;
+      bool done = itList.empty();
+      rv = false;
+      while (!done)
+      {
+         for (auto& imi : itList)
+         {
+            done = true; // default to being done.  Gets reset to false below.
+            if (imi.finished)
+            {
+                  // no need to process this iterator any further
+               continue;
+            }
+            else if ((imi.idx != npos) && haveRecent &&
+                     (imi.sat->times[imi.idx] < mostRecent))
+            {
+                  // Data is less recent than the most recent good data, so stop
+                  // processing this iterator.
+               imi.finished = true;
+            }
+            else if ((imi.idx != npos) &&
+                     ((imi.sat->times[imi.idx] > whenKey) ||
+                      !validityCheck(imi.sat->values[imi.idx], valid,
+                                     xmitHealth, when)))
+            {
+               imi.idx = (imi.idx == 0 ? npos : imi.idx-1);
+               done = false;
+            }
+            else if (imi.idx == npos)
+            {
+                  // give up.
+               imi.finished = true;
+            }
+            else
+            {
+               if (!haveRecent || (imi.sat->times[imi.idx] > mostRecent))
+               {
+                  mostRecent = imi.sat->times[imi.idx];
+                  haveRecent = true;
+                  navData = imi.sat->values[imi.idx];
+               }
+               imi.finished = true;
+               rv = true;
+            }
+         }
+      }
+      return true;
+   }
+
+
+   bool NavDataFactoryWithStore ::
+   findNearestFrozen(const NavMessageID& nmid, const CommonTime& when,
+                     NavDataPtr& navData, SVHealth xmitHealth,
+                     NavValidityType valid, bool& rv)
+   {
+      DEBUGTRACE_FUNCTION();
+         // Same algorithm as findNearest, using array indices in
+         // place of NavNearMap iterators, with npos in place of end().
+      using SatData = FrozenNavIndex<std::vector<NavDataPtr> >::SatData;
+      static const size_t npos = static_cast<size_t>(-1);
+      class FindMatches
+      {
+      public:
+         FindMatches(const SatData *theSat, size_t theIdx)
+               : sat(theSat),
+                 idxGT(theIdx == theSat->times.size() ? npos : theIdx),
+                 idxLT(theIdx == 0 ? npos : theIdx-1)
+         {}
+         const SatData *sat;
+         size_t idxGT, idxLT;
+      };
+      std::vector<FindMatches> itList;
+      FrozenNavTime whenKey(when);
+      TimeSystem whenTS = when.getTimeSystem();
+      bool usable = true;
+      frozenNearest.forEachMatch(
+         nmid,
+         [&](const SatData& sd)
+         {
+            if (!sd.compatible(whenTS))
+            {
+               usable = false;
+               return false;
+            }
+            itList.push_back(FindMatches(&sd, sd.lowerBound(whenKey)));
+            return true;
+         });
+      if (!usable)
+      {
+         return false;
+      }
+      rv = false;
+      bool done = itList.empty();
+      while (!done)
+      {
+         for (auto& imi : itList)
+         {
+            done = true; // default to being done.  Gets reset to false below.
+            if ((imi.idxGT == npos) && (imi.idxLT == npos))
+            {
+                  // nothing more to do, we've reached the end of both
+                  // directions
+               break;
+            }
+            if ((imi.idxGT != npos) &&
+                ((imi.idxLT == npos) ||
+                 (fabs(imi.sat->times[imi.idxGT] - whenKey) <
+                  fabs(imi.sat->times[imi.idxLT] - whenKey))))
+            {
+                  // time for idxGT is nearer to time of interest, try it first.
+               for (const auto& ndpli : imi.sat->values[imi.idxGT])
+               {
+                  if (validityCheck(ndpli, valid, xmitHealth, when))
+                  {
+                     navData = ndpli;
+                     rv = true;
+                     return true;
+                  }
+               }
+               done = false;
+               if (++imi.idxGT == imi.sat->times.size())
+               {
+                  imi.idxGT = npos;
+               }
+            }
+            else
+            {
+                  // time for idxLT is nearer to time of interest, try it first.
+               for (const auto& ndpli : imi.sat->values[imi.idxLT])
+               {
+                  if (validityCheck(ndpli, valid, xmitHealth, when))
+                  {
+                     navData = ndpli;
+                     rv = true;
+                     return true;
+                  }
+               }
+               done = false;
+               imi.idxLT = (imi.idxLT == 0 ? npos : imi.idxLT-1);
+            }
+         }
+      }
+      return true;
+   }
+
+
    bool NavDataFactoryWithStore ::
    getOffset(TimeSystem fromSys, TimeSystem toSys,
              const CommonTime& when, NavDataPtr& offset,
@@ -443,6 +779,7 @@ namespace gnsstk
       DEBUGTRACE_FUNCTION();
       DEBUGTRACE("class: " << getClassName());
       DEBUGTRACE(printTime(when,"looking for "+dts));
+      ReadWriteLock::ReadGuard guard(storeLock);
       bool rv = false;
          // Only search for forward key and let the TimeOffset classes
          // and factories handle the reverse offset.
@@ -555,6 +892,8 @@ namespace gnsstk
    void NavDataFactoryWithStore ::
    edit(const CommonTime& fromTime, const CommonTime& toTime)
    {
+      ReadWriteLock::WriteGuard guard(storeLock);
+      storeChanged();
          // edit transmit time storage
       for (auto mti = data.begin(); mti != data.end();)
       {
@@ -684,6 +1023,8 @@ namespace gnsstk
    edit(const CommonTime& fromTime, const CommonTime& toTime,
         const NavSatelliteID& satID)
    {
+      ReadWriteLock::WriteGuard guard(storeLock);
+      storeChanged();
          // edit transmit time storage
       for (auto mti = data.begin(); mti != data.end();)
       {
@@ -839,6 +1180,8 @@ namespace gnsstk
    void NavDataFactoryWithStore ::
    clear()
    {
+      ReadWriteLock::WriteGuard guard(storeLock);
+      storeChanged();
       data.clear();
       nearestData.clear();
       offsetData.clear();
@@ -853,6 +1196,7 @@ namespace gnsstk
    {
       DEBUGTRACE_FUNCTION();
       DEBUGTRACE("class: " << getClassName());
+      ReadWriteLock::WriteGuard guard(storeLock);
       NavFit *nf = nullptr;
       OrbitData *odp = nullptr;
       TimeOffsetData *todp = nullptr;
@@ -937,6 +1281,10 @@ namespace gnsstk
             return false;
       }
          // always add to navMap/navNearMap
+      if (&navMap == &data)
+      {
+         storeChanged();
+      }
       navMap[nd->signal.messageType][nd->signal][nd->getUserTime()] = nd;
       navNearMap[nd->signal.messageType][nd->signal][nd->getNearTime()]
          .push_back(nd);
@@ -1004,6 +1352,7 @@ namespace gnsstk
    size_t NavDataFactoryWithStore ::
    size() const
    {
+      ReadWriteLock::ReadGuard guard(storeLock);
       size_t rv = 0;
       for (const auto& mti : data)
       {
@@ -1023,6 +1372,7 @@ namespace gnsstk
    {
       DEBUGTRACE_FUNCTION();
       DEBUGTRACE("class: " << getClassName());
+      ReadWriteLock::ReadGuard guard(storeLock);
       size_t rv = 0;
          // Make a copy of the key that can be modified so that values
          // that are otherwise not wildcards e.g. SatelliteSystem can
@@ -1129,6 +1479,7 @@ namespace gnsstk
    size_t NavDataFactoryWithStore ::
    numSignals() const
    {
+      ReadWriteLock::ReadGuard guard(storeLock);
       std::set<NavSignalID> uniques;
       for (const auto& mti : data)
       {
@@ -1144,6 +1495,7 @@ namespace gnsstk
    size_t NavDataFactoryWithStore ::
    numSatellites() const
    {
+      ReadWriteLock::ReadGuard guard(storeLock);
       std::set<NavSatelliteID> uniques;
       for (const auto& mti : data)
       {
@@ -1318,6 +1670,7 @@ namespace gnsstk
 
    CommonTime NavDataFactoryWithStore :: getFirstTime(const SatID& sat) const
    {
+      ReadWriteLock::ReadGuard guard(storeLock);
       auto i = firstLastMap.find(sat);
       if (i != firstLastMap.end())
          return i->second.first;
@@ -1327,6 +1680,7 @@ namespace gnsstk
 
    CommonTime NavDataFactoryWithStore :: getLastTime(const SatID& sat) const
    {
+      ReadWriteLock::ReadGuard guard(storeLock);
       auto i = firstLastMap.find(sat);
       if (i != firstLastMap.end())
          return i->second.second;
@@ -1352,6 +1706,7 @@ namespace gnsstk
       NavMessageType nmt, const CommonTime& fromTime, const CommonTime& toTime)
       const
    {
+      ReadWriteLock::ReadGuard guard(storeLock);
       NavSatelliteIDSet rv;
       auto nmmi = data.find(nmt);
       if (nmmi != data.end())
@@ -1373,6 +1728,7 @@ namespace gnsstk
    getIndexSet(const CommonTime& fromTime,
                const CommonTime& toTime) const
    {
+      ReadWriteLock::ReadGuard guard(storeLock);
       std::set<SatID> rv;
       for (const auto& nmmi : data)
       {
@@ -1394,6 +1750,7 @@ namespace gnsstk
                const CommonTime& fromTime,
                const CommonTime& toTime) const
    {
+      ReadWriteLock::ReadGuard guard(storeLock);
       std::set<SatID> rv;
       auto nmmi = data.find(nmt);
       if (nmmi != data.end())
@@ -1415,6 +1772,7 @@ namespace gnsstk
       const CommonTime& fromTime, const CommonTime& toTime)
       const
    {
+      ReadWriteLock::ReadGuard guard(storeLock);
       NavMessageIDSet rv;
       for (const auto& nmmi : data)
       {
@@ -1434,6 +1792,7 @@ namespace gnsstk
    const NavMap* NavDataFactoryWithStore ::
    getNavMap(const NavMessageID& nmid) const
    {
+      ReadWriteLock::ReadGuard guard(storeLock);
       auto nmmi = data.find(nmid.messageType);
       if (nmmi != data.end())
       {
@@ -1453,6 +1812,7 @@ namespace gnsstk
       DEBUGTRACE_FUNCTION();
       DEBUGTRACE("class: " << getClassName());
       DEBUGTRACE("data.size() = " << data.size());
+      ReadWriteLock::ReadGuard guard(storeLock);
       for (const auto& nmmi : data)
       {
          for (const auto& nsami : nmmi.second)
@@ -39,9 +39,12 @@
 #ifndef GNSSTK_NAVDATAFACTORYWITHSTORE_HPP
 #define GNSSTK_NAVDATAFACTORYWITHSTORE_HPP
 
+#include <atomic>
 #include "NavDataFactory.hpp"
 #include "TimeOffsetData.hpp"
 #include "StdNavTimeOffset.hpp"
+#include "FrozenNavIndex.hpp"
+#include "ReadWriteLock.hpp"
 
 namespace gnsstk
 {
@@ -59,7 +62,23 @@ namespace gnsstk
        *   overwrite the health status from an LNAV message for L1 and
        *   vice versa.  Since it's possible for the health bits to be
        *   different, we probably need to decide if we need to do
-       *   something about this issue and if so, what. */
+       *   something about this issue and if so, what.
+       *
+       * @section NDFWSThreads Thread Safety
+       * The store is protected by a reader/writer lock, so once a
+       * factory has been configured (validity and type filters,
+       * control settings), the search methods (find(), findSpan(),
+       * getOffset(), the counting and availability methods) may be
+       * called from any number of threads concurrently, including
+       * while other threads load data or call addNavData(), edit(),
+       * clear(), freeze() or thaw().  Each nav message is added
+       * atomically, so a concurrent search sees the store either
+       * before or after any given message was added.  Search
+       * results are shared pointers, so data returned by find()
+       * remains valid after being removed from the store.
+       * The references returned by getNavMessageMap() and related
+       * methods are not protected and must not be used while the
+       * store is being modified. */
    class NavDataFactoryWithStore : public NavDataFactory
    {
    public:
@@ -104,6 +123,16 @@ namespace gnsstk
                 NavDataPtr& navOut, SVHealth xmitHealth, NavValidityType valid,
                 NavSearchOrder order) override;
 
+         /** @copydoc NavDataFactory::findSpan()
+          * @note The span is only determined for User searches that
+          *   return data from the store (i.e. not interpolated or
+          *   otherwise computed).  Nearest searches always yield an
+          *   empty span. */
+      bool findSpan(const NavMessageID& nmid, const CommonTime& when,
+                    NavDataPtr& navOut, SVHealth xmitHealth,
+                    NavValidityType valid, NavSearchOrder order,
+                    CommonTime& validFrom, CommonTime& validTo) override;
+
          /// @copydoc NavDataFactory::getOffset()
       bool getOffset(TimeSystem fromSys, TimeSystem toSys,
                      const CommonTime& when, NavDataPtr& offset,
@@ -164,14 +193,20 @@ namespace gnsstk
           * @return The initial time, or CommonTime::END_OF_TIME if no
           *   data is available. */
       CommonTime getInitialTime() const override
-      { return initialTime; }
+      {
+         ReadWriteLock::ReadGuard guard(storeLock);
+         return initialTime;
+      }
 
          /** Determine the latest time for which this object can successfully
           * determine the Xvt for any object.
           * @return The initial time, or CommonTime::BEGINNING_OF_TIME if no
           *   data is available. */
       CommonTime getFinalTime() const override
-      { return finalTime; }
+      {
+         ReadWriteLock::ReadGuard guard(storeLock);
+         return finalTime;
+      }
 
          /** Determine the timestamp of the oldest record in this
           * store for the given satellite.
@@ -353,6 +388,35 @@ namespace gnsstk
           * @return The resulting NavMap if available or nullptr if not. */
       const NavMap* getNavMap(const NavMessageID& nmid) const;
 
+         /** Build a compact, read-only search index of the loaded
+          * data, used by find() in place of the map-of-maps search.
+          * This is intended to be called once all data has been
+          * loaded, when find() will be called many more times than
+          * the store is modified.  Any subsequent change to the store
+          * (addNavData(), edit(), clear() or loading more data)
+          * discards the index, reverting to the map search until
+          * freeze() is called again.
+          * @note Searches with a time system that cannot be compared
+          *   against the stored data fall back to the map search so
+          *   that the same exceptions are thrown. */
+      virtual void freeze();
+
+         /// Discard the index created by freeze(), if any.
+      virtual void thaw();
+
+         /// Return true if freeze() has been called since the last change.
+      bool isFrozen() const
+      {
+         ReadWriteLock::ReadGuard guard(storeLock);
+         return frozen;
+      }
+
+         /** Return a counter that is incremented every time the
+          * contents of any NavDataFactoryWithStore change.  This is
+          * used to invalidate search results cached by NavLibrary. */
+      static unsigned long getChangeCount()
+      { return changeCount; }
+
    protected:
          /** Search the store to find the navigation message that meets
           * the specified criteria using User-oriented data.
@@ -452,6 +516,31 @@ namespace gnsstk
           * @post initialTime and/or finalTime may be updated. */
       bool updateInitialFinal(const CommonTime& begin, const CommonTime& end);
 
+         /** Record that the contents of data, nearestData or
+          * offsetData have changed, discarding the frozen index and
+          * anything derived from the store. */
+      void storeChanged();
+
+         /** Discard the frozen index, if any, without locking.
+          * @pre storeLock is held exclusively. */
+      void discardFrozen();
+
+         /** Implement findUser() using the frozen index.
+          * @param[out] rv The result of the search, as findUser().
+          * @return false if the frozen index can't be used for this
+          *   search and the map search must be used instead. */
+      bool findUserFrozen(const NavMessageID& nmid, const CommonTime& when,
+                          NavDataPtr& navData, SVHealth xmitHealth,
+                          NavValidityType valid, bool& rv);
+
+         /** Implement findNearest() using the frozen index.
+          * @param[out] rv The result of the search, as findNearest().
+          * @return false if the frozen index can't be used for this
+          *   search and the map search must be used instead. */
+      bool findNearestFrozen(const NavMessageID& nmid, const CommonTime& when,
+                             NavDataPtr& navData, SVHealth xmitHealth,
+                             NavValidityType valid, bool& rv);
+
          /// Internal storage of navigation data for User searches
       NavMessageMap data;
          /// Internal storage of navigation data for Nearest searches
@@ -465,6 +554,16 @@ namespace gnsstk
       CommonTime finalTime;
          /// Map subject satellite ID to time stamp pair (oldest,newest).
       std::map<SatID,std::pair<CommonTime,CommonTime> > firstLastMap;
+         /// True if frozenData and frozenNearest are up to date.
+      bool frozen;
+         /// Frozen copy of data, built by freeze().
+      FrozenNavIndex<NavDataPtr> frozenData;
+         /// Frozen copy of nearestData, built by freeze().
+      FrozenNavIndex<std::vector<NavDataPtr> > frozenNearest;
+         /** Serializes changes to the store against searches.
+          * Public methods take the lock, protected methods assume
+          * the caller holds it. */
+      mutable ReadWriteLock storeLock;
 
          /// Grant access to MultiFormatNavDataFactory for various functions.
       friend class MultiFormatNavDataFactory;
@@ -492,6 +591,8 @@ namespace gnsstk
 
       TOUSatMap touBySV;  ///< Each satellite's uniquely transmitted time offset
       TOUSigMap touBySig; ///< Each signal's uniquely transmitted time offset
+         /// Incremented by storeChanged().
+      static std::atomic<unsigned long> changeCount;
    };
 
       //@}
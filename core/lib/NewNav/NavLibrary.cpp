@@ -38,16 +38,81 @@
 //==============================================================================
 #include "NavLibrary.hpp"
 #include "OrbitData.hpp"
+#include "OrbitDataKepler.hpp"
 #include "NavHealthData.hpp"
 #include "TimeOffsetData.hpp"
 #include "NDFUniqConstIterator.hpp"
 #include "NDFUniqIterator.hpp"
+#include "NavDataFactoryWithStore.hpp"
 #include "IonoNavData.hpp"
 #include "InterSigCorr.hpp"
 #include "DebugTrace.hpp"
 
 namespace gnsstk
 {
+      /// Source of NavLibrary::xvtCacheID values, never reused.
+   static std::atomic<unsigned long> nextXvtCacheID(1);
+
+      /** Return true if the two NavMessageID objects are identical,
+       * including wildcards, as opposed to operator==, which treats
+       * wildcards as matching anything. */
+   static bool sameNMID(const NavMessageID& left, const NavMessageID& right)
+   {
+      return ((left.messageType == right.messageType) &&
+              (left.system == right.system) &&
+              (left.sat.id == right.sat.id) &&
+              (left.sat.wildId == right.sat.wildId) &&
+              (left.sat.system == right.sat.system) &&
+              (left.sat.wildSys == right.sat.wildSys) &&
+              (left.xmitSat.id == right.xmitSat.id) &&
+              (left.xmitSat.wildId == right.xmitSat.wildId) &&
+              (left.xmitSat.system == right.xmitSat.system) &&
+              (left.xmitSat.wildSys == right.xmitSat.wildSys) &&
+              (left.obs.type == right.obs.type) &&
+              (left.obs.band == right.obs.band) &&
+              (left.obs.code == right.obs.code) &&
+              (left.obs.xmitAnt == right.obs.xmitAnt) &&
+              (left.obs.freqOffs == right.obs.freqOffs) &&
+              (left.obs.freqOffsWild == right.obs.freqOffsWild) &&
+              (left.obs.getMcodeBits() == right.obs.getMcodeBits()) &&
+              (left.obs.getMcodeMask() == right.obs.getMcodeMask()) &&
+              (left.nav == right.nav));
+   }
+
+
+   NavLibrary ::
+   NavLibrary()
+         : xvtCacheEnabled(false),
+           xvtCacheable(true),
+           xvtCacheID(nextXvtCacheID++)
+   {
+   }
+
+
+   NavLibrary ::
+   NavLibrary(const NavLibrary& right)
+         : factories(right.factories),
+           xvtCacheEnabled(right.xvtCacheEnabled),
+           xvtCacheable(right.xvtCacheable),
+           xvtCacheID(nextXvtCacheID++)
+   {
+   }
+
+
+   NavLibrary& NavLibrary ::
+   operator=(const NavLibrary& right)
+   {
+      if (this != &right)
+      {
+         factories = right.factories;
+         xvtCacheEnabled = right.xvtCacheEnabled;
+         xvtCacheable = right.xvtCacheable;
+         xvtCacheID = nextXvtCacheID++;
+      }
+      return *this;
+   }
+
+
    bool NavLibrary ::
    getXvt(const NavSatelliteID& sat, const CommonTime& when, Xvt& xvt,
           bool useAlm, SVHealth xmitHealth, NavValidityType valid,
@@ -69,7 +134,7 @@ namespace gnsstk
       NavMessageID nmid(sat, useAlm ? NavMessageType::Almanac :
                         NavMessageType::Ephemeris);
       NavDataPtr ndp;
-      if (!find(nmid, when, ndp, xmitHealth, valid, order))
+      if (!findXvt(nmid, when, ndp, xmitHealth, valid, order))
          return false;
       OrbitData *orb = dynamic_cast<OrbitData*>(ndp.get());
       return orb->getXvt(when, xvt, oid);
@@ -95,19 +160,48 @@ namespace gnsstk
       DEBUGTRACE_FUNCTION();
       NavMessageID nmid(sat, NavMessageType::Ephemeris);
       NavDataPtr ndp;
-      if (!find(nmid, when, ndp, xmitHealth, valid, order))
+      if (!findXvtAny(nmid, when, ndp, xmitHealth, valid, order))
       {
-         NavMessageID nmida(sat, NavMessageType::Almanac);
-         if (!find(nmida, when, ndp, xmitHealth, valid, order))
-         {
-            return false;
-         }
+         return false;
       }
       OrbitData *orb = dynamic_cast<OrbitData*>(ndp.get());
       return orb->getXvt(when, xvt, oid);
    }
 
 
+   bool NavLibrary ::
+   getXvtBatch(const std::vector<NavSatelliteID>& sats, const CommonTime& when,
+               XvtBatch& xvt, SVHealth xmitHealth, NavValidityType valid,
+               NavSearchOrder order)
+   {
+      DEBUGTRACE_FUNCTION();
+      std::vector<NavDataPtr> orbits(sats.size());
+      std::vector<CommonTime> times(sats.size(), when);
+      for (size_t i = 0; i < sats.size(); i++)
+      {
+         NavMessageID nmid(sats[i], NavMessageType::Ephemeris);
+         findXvtAny(nmid, when, orbits[i], xmitHealth, valid, order);
+      }
+      return OrbitDataKepler::getXvtBatch(orbits, times, xvt);
+   }
+
+
+   bool NavLibrary ::
+   getXvtBatch(const NavSatelliteID& sat, const std::vector<CommonTime>& when,
+               XvtBatch& xvt, SVHealth xmitHealth, NavValidityType valid,
+               NavSearchOrder order)
+   {
+      DEBUGTRACE_FUNCTION();
+      std::vector<NavDataPtr> orbits(when.size());
+      NavMessageID nmid(sat, NavMessageType::Ephemeris);
+      for (size_t i = 0; i < when.size(); i++)
+      {
+         findXvtAny(nmid, when[i], orbits[i], xmitHealth, valid, order);
+      }
+      return OrbitDataKepler::getXvtBatch(orbits, when, xvt);
+   }
+
+
    bool NavLibrary ::
    getHealth(const NavSatelliteID& sat, const CommonTime& when,
              SVHealth& healthOut, SVHealth xmitHealth, NavValidityType valid,
@@ -545,6 +639,125 @@ namespace gnsstk
    }
 
 
+   bool NavLibrary ::
+   findXvtAny(const NavMessageID& nmid, const CommonTime& when,
+              NavDataPtr& navOut, SVHealth xmitHealth, NavValidityType valid,
+              NavSearchOrder order)
+   {
+      NavMessageID nmide(nmid, NavMessageType::Ephemeris);
+      if (findXvt(nmide, when, navOut, xmitHealth, valid, order))
+      {
+         return true;
+      }
+      NavMessageID nmida(nmid, NavMessageType::Almanac);
+      return findXvt(nmida, when, navOut, xmitHealth, valid, order);
+   }
+
+
+   bool NavLibrary ::
+   findXvt(const NavMessageID& nmid, const CommonTime& when,
+           NavDataPtr& navOut, SVHealth xmitHealth, NavValidityType valid,
+           NavSearchOrder order)
+   {
+      DEBUGTRACE_FUNCTION();
+      if (!xvtCacheEnabled || !xvtCacheable ||
+          (order != NavSearchOrder::User) || nmid.sat.isWild())
+      {
+         return find(nmid, when, navOut, xmitHealth, valid, order);
+      }
+      unsigned long changes = NavDataFactoryWithStore::getChangeCount();
+      XvtCacheKey key(nmid.sat, nmid.messageType);
+      XvtCacheMap& cache(threadXvtCache(xvtCacheID));
+      {
+         const XvtCacheEntry& entry(cache[key]);
+         if (entry.navData && (entry.changeCount == changes) &&
+             (entry.xmitHealth == xmitHealth) && (entry.valid == valid) &&
+             sameNMID(entry.nmid, nmid) &&
+             (entry.validFrom <= when) && (when < entry.validTo))
+         {
+            navOut = entry.navData;
+            return true;
+         }
+      }
+         // Same as find(), except that the result can only be reused
+         // if it came from the first factory searched, as otherwise
+         // data in an earlier factory could take precedence at
+         // other times.
+      CommonTime validFrom, validTo;
+      std::set<NavDataFactory*> uniques;
+      for (auto& fi : factories)
+      {
+         if ((fi.first == nmid) && (uniques.count(fi.second.get()) == 0))
+         {
+            bool rv;
+            if (uniques.empty())
+            {
+               rv = fi.second->findSpan(nmid, when, navOut, xmitHealth,
+                                        valid, order, validFrom, validTo);
+            }
+            else
+            {
+               rv = fi.second->find(nmid, when, navOut, xmitHealth, valid,
+                                    order);
+               validFrom = validTo = when;
+            }
+            if (rv)
+            {
+               if (validFrom < validTo)
+               {
+                  XvtCacheEntry& entry(cache[key]);
+                  entry.nmid = nmid;
+                  entry.xmitHealth = xmitHealth;
+                  entry.valid = valid;
+                  entry.navData = navOut;
+                  entry.validFrom = validFrom;
+                  entry.validTo = validTo;
+                  entry.changeCount = changes;
+               }
+               return true;
+            }
+            uniques.insert(fi.second.get());
+         }
+      }
+      return false;
+   }
+
+
+   NavLibrary::XvtCacheMap& NavLibrary ::
+   threadXvtCache(unsigned long id)
+   {
+         // Most recently used first.
+      static thread_local std::list<std::pair<unsigned long, XvtCacheMap> >
+         slots;
+      for (auto i = slots.begin(); i != slots.end(); i++)
+      {
+         if (i->first == id)
+         {
+            if (i != slots.begin())
+            {
+               slots.splice(slots.begin(), slots, i);
+            }
+            return slots.front().second;
+         }
+      }
+      if (slots.size() >= XVT_CACHE_SLOTS)
+      {
+         slots.pop_back();
+      }
+      slots.emplace_front(id, XvtCacheMap());
+      return slots.front().second;
+   }
+
+
+   void NavLibrary ::
+   setXvtCache(bool enable)
+   {
+      xvtCacheEnabled = enable;
+         // Discard the caches of every thread.
+      xvtCacheID = nextXvtCacheID++;
+   }
+
+
    void NavLibrary ::
    setValidityFilter(NavValidityType nvt)
    {
@@ -593,6 +806,12 @@ namespace gnsstk
    addFactory(NavDataFactoryPtr& fact)
    {
       DEBUGTRACE_FUNCTION();
+      if (dynamic_cast<NavDataFactoryWithStore*>(fact.get()) == nullptr)
+      {
+            // can't tell when this factory's data changes.
+         xvtCacheable = false;
+      }
+      xvtCacheID = nextXvtCacheID++;
          // Yes, we do add multiple copies of the NavDataFactoryPtr to
          // the map, it's a convenience.
       for (const auto& si : fact->supportedSignals)
@@ -660,6 +879,38 @@ namespace gnsstk
    }
 
 
+   void NavLibrary ::
+   freeze()
+   {
+      DEBUGTRACE_FUNCTION();
+      for (auto& fi : NDFUniqIterator<NavDataFactoryMap>(factories))
+      {
+         NavDataFactoryWithStore *ndfws =
+            dynamic_cast<NavDataFactoryWithStore*>(fi.second.get());
+         if (ndfws != nullptr)
+         {
+            ndfws->freeze();
+         }
+      }
+   }
+
+
+   void NavLibrary ::
+   thaw()
+   {
+      DEBUGTRACE_FUNCTION();
+      for (auto& fi : NDFUniqIterator<NavDataFactoryMap>(factories))
+      {
+         NavDataFactoryWithStore *ndfws =
+            dynamic_cast<NavDataFactoryWithStore*>(fi.second.get());
+         if (ndfws != nullptr)
+         {
+            ndfws->thaw();
+         }
+      }
+   }
+
+
    CommonTime NavLibrary ::
    getInitialTime() const
    {
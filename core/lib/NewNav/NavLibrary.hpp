@@ -39,8 +39,11 @@
 #ifndef GNSSTK_NAVLIBRARY_HPP
 #define GNSSTK_NAVLIBRARY_HPP
 
+#include <atomic>
+#include <list>
 #include "NavDataFactory.hpp"
 #include "Xvt.hpp"
+#include "XvtBatch.hpp"
 #include "SVHealth.hpp"
 #include "Position.hpp"
 
@@ -914,10 +917,38 @@ namespace gnsstk
        * if (navLib.getXvt(sat,when,xvt))
        *    doSomething(xvt);
        * \endcode
+       *
+       * Thread safety: Once the factories have been added and
+       * configured (addFactory(), setValidityFilter(),
+       * setTypeFilter() and so on), the query methods find(),
+       * getXvt(), getHealth(), getOffset(), getIonoCorr() and
+       * getISC() may be called on a single NavLibrary from any
+       * number of threads concurrently.  Loading more data into the
+       * factories, edit() and clear() may also be done concurrently
+       * with queries for factories derived from
+       * NavDataFactoryWithStore, which serialize changes to their
+       * stores against searches.  The stores' locks prefer searches
+       * (see ReadWriteLock), so a change waits until no search is in
+       * progress, and may wait indefinitely if searches never pause.
+       * The getXvt() cache, when enabled, is kept separately for
+       * each thread, in thread-local storage, so that cache hits
+       * take no lock.
        */
    class NavLibrary
    {
    public:
+         /// Initialize internal data, with the Xvt search cache disabled.
+      NavLibrary();
+
+         /** Copy the factories and settings of \a right.  The copy
+          * gets its own getXvt() cache ID, so it never uses results
+          * cached by \a right. */
+      NavLibrary(const NavLibrary& right);
+
+         /** Copy the factories and settings of \a right, discarding
+          * this library's getXvt() caches. */
+      NavLibrary& operator=(const NavLibrary& right);
+
          /** Get the position and velocity of a satellite at a
           * specific time, searching either almanac or ephemeris, as
           * dictated by \a useAlm.
@@ -1017,6 +1048,61 @@ namespace gnsstk
                   NavValidityType valid = NavValidityType::ValidOnly,
                   NavSearchOrder order = NavSearchOrder::User);
 
+         /** Get the positions and velocities of a set of satellites
+          * at a single time, searching first for a matching
+          * ephemeris, and if that fails, then attempting to search
+          * for a matching almanac.  The results are the same as
+          * calling getXvt(sats[i],when,xvt,xmitHealth,valid,order)
+          * for each satellite, but Keplerian orbits are evaluated
+          * together using OrbitDataKepler::getXvtBatch().
+          * @param[in] sats Satellites to get the position/velocity for.
+          * @param[in] when The time that the positions should be
+          *   computed for.
+          * @param[out] xvt The computed positions and velocities,
+          *   where element i is for sats[i].  Elements for which no
+          *   nav data was found are marked as not valid.
+          * @param[in] xmitHealth The desired health status of the
+          *   transmitting satellite.
+          * @param[in] valid Specify whether to search only for valid
+          *   or invalid messages, or both.
+          * @param[in] order Specify whether to search by receiver
+          *   behavior or by nearest to when in time.
+          * @return true if successful for all satellites. */
+      bool getXvtBatch(const std::vector<NavSatelliteID>& sats,
+                       const CommonTime& when, XvtBatch& xvt,
+                       SVHealth xmitHealth = SVHealth::Any,
+                       NavValidityType valid = NavValidityType::ValidOnly,
+                       NavSearchOrder order = NavSearchOrder::User);
+
+         /** Get the position and velocity of a satellite at a series
+          * of times, searching first for a matching ephemeris, and if
+          * that fails, then attempting to search for a matching
+          * almanac.  The results are the same as calling
+          * getXvt(sat,when[i],xvt,xmitHealth,valid,order) for each
+          * time, but Keplerian orbits are evaluated together using
+          * OrbitDataKepler::getXvtBatch().
+          * @note The nav data is searched for at each time.  Enable
+          *   the getXvt() cache with setXvtCache() to avoid repeating
+          *   the search for times that use the same nav data.
+          * @param[in] sat Satellite to get the position/velocity for.
+          * @param[in] when The times that the positions should be
+          *   computed for.
+          * @param[out] xvt The computed positions and velocities,
+          *   where element i is for when[i].  Elements for which no
+          *   nav data was found are marked as not valid.
+          * @param[in] xmitHealth The desired health status of the
+          *   transmitting satellite.
+          * @param[in] valid Specify whether to search only for valid
+          *   or invalid messages, or both.
+          * @param[in] order Specify whether to search by receiver
+          *   behavior or by nearest to when in time.
+          * @return true if successful for all times. */
+      bool getXvtBatch(const NavSatelliteID& sat,
+                       const std::vector<CommonTime>& when, XvtBatch& xvt,
+                       SVHealth xmitHealth = SVHealth::Any,
+                       NavValidityType valid = NavValidityType::ValidOnly,
+                       NavSearchOrder order = NavSearchOrder::User);
+
          /** Get the health status of a satellite at a specific time.
           * @param[in] sat Satellite to get the health status for.
           * @param[in] when The time that the health should be retrieved.
@@ -1221,6 +1307,24 @@ namespace gnsstk
                 NavDataPtr& navOut, SVHealth xmitHealth, NavValidityType valid,
                 NavSearchOrder order);
 
+         /** Enable or disable caching of the orbit data last used
+          * by getXvt() for each satellite.  When enabled, getXvt()
+          * calls for the same satellite and search parameters reuse
+          * the previous result as long as the time of interest
+          * remains in the span of time over which the factory
+          * search would yield the same result, which is typically
+          * the case for hours when processing sequential epochs.
+          * The results are identical either way.
+          * @note Only User searches for a specific (non-wildcard)
+          *   subject satellite are cached, and only when every
+          *   factory is derived from NavDataFactoryWithStore.
+          * @param[in] enable Set to true to enable the cache. */
+      void setXvtCache(bool enable);
+
+         /// Return true if the getXvt() cache is enabled.
+      bool getXvtCache() const
+      { return xvtCacheEnabled; }
+
          /** Set the factories' handling of valid and invalid
           * navigation data.  This should be called before any find()
           * calls.
@@ -1297,6 +1401,15 @@ namespace gnsstk
          /// Remove all data from the library's factories.
       void clear();
 
+         /** Freeze the stores of the library's factories once all
+          * data has been loaded, to speed up searches.
+          * @see NavDataFactoryWithStore::freeze() */
+      void freeze();
+
+         /** Discard any search index created by freeze().
+          * @see NavDataFactoryWithStore::thaw() */
+      void thaw();
+
          /** Determine the earliest time for which this object can successfully
           * determine the Xvt for any object.
           * @return The initial time, or CommonTime::END_OF_TIME if no
@@ -1430,9 +1543,60 @@ namespace gnsstk
       std::string getFactoryFormats() const;
 
    protected:
+         /** Search for orbit data for getXvt(), trying almanac data
+          * if no ephemeris is found.  Arguments are the same as
+          * find(), except the message type of nmid is ignored. */
+      bool findXvtAny(const NavMessageID& nmid, const CommonTime& when,
+                      NavDataPtr& navOut, SVHealth xmitHealth,
+                      NavValidityType valid, NavSearchOrder order);
+
+         /** Search for orbit data for getXvt(), using and updating
+          * the cache if enabled.  Arguments are the same as find().
+          * @see setXvtCache() */
+      bool findXvt(const NavMessageID& nmid, const CommonTime& when,
+                   NavDataPtr& navOut, SVHealth xmitHealth,
+                   NavValidityType valid, NavSearchOrder order);
+
          /** Known nav data factories, organized by signal to make
           * searches simpler and/or quicker. */
       NavDataFactoryMap factories;
+
+   private:
+         /// Orbit data last used by getXvt() for one satellite.
+      class XvtCacheEntry
+      {
+      public:
+         NavMessageID nmid;          ///< The search key.
+         SVHealth xmitHealth;        ///< Search transmit health.
+         NavValidityType valid;      ///< Search validity.
+         NavDataPtr navData;         ///< The search result.
+         CommonTime validFrom;       ///< Start of span navData is good for.
+         CommonTime validTo;         ///< End of span navData is good for.
+         unsigned long changeCount;  ///< Store change count at search.
+      };
+         /// Subject satellite and message type, for looking up XvtCacheEntry.
+      using XvtCacheKey = std::pair<SatID, NavMessageType>;
+         /// Cached orbit data of one library for one thread.
+      using XvtCacheMap = std::map<XvtCacheKey, XvtCacheEntry>;
+
+         /** Get the calling thread's cache for the given cache ID.
+          * Each thread keeps the caches of the few IDs it used most
+          * recently, and drops the least recently used when it needs
+          * another; all of them are freed when the thread exits. */
+      static XvtCacheMap& threadXvtCache(unsigned long id);
+
+         /// Number of cache IDs each thread keeps, cf. threadXvtCache().
+      static const size_t XVT_CACHE_SLOTS = 4;
+
+         /// True if setXvtCache(true) was called.
+      bool xvtCacheEnabled;
+         /// True if all factories support NavDataFactory::findSpan().
+      bool xvtCacheable;
+         /** Identifies the getXvt() caches of this library in each
+          * thread.  It is unique over all libraries and is replaced
+          * whenever the caches must be discarded, so a stale cache is
+          * never matched. */
+      std::atomic<unsigned long> xvtCacheID;
    };
 
       //@}
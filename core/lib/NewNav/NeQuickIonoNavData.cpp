@@ -37,6 +37,7 @@
 //
 //==============================================================================
 #include <cmath>
+#include <memory>
 #include <string.h>
 #include "NeQuickIonoNavData.hpp"
 #include "TimeString.hpp"
@@ -117,6 +118,18 @@ enum NeQuickIonoNavDataConsts
 
 namespace gnsstk
 {
+      /** Get the CCIR evaluation context for the calling thread.
+       * Keeping one per thread lets concurrent getTEC() calls share
+       * a NeQuickIonoNavData object while each thread still reuses
+       * its interpolated coefficients for consecutive calls at the
+       * same epoch. */
+   static CCIR& threadCCIR()
+   {
+      thread_local CCIR ccir;
+      return ccir;
+   }
+
+
    NeQuickIonoNavData ::
    NeQuickIonoNavData()
          : ai{0,0,0},
@@ -202,6 +215,23 @@ namespace gnsstk
    }
 
 
+   std::vector<double> NeQuickIonoNavData ::
+   getIonoCorr(const CommonTime& when,
+               const Position& rxgeo,
+               const std::vector<Position>& svgeo,
+               CarrierBand band) const
+   {
+      DEBUGTRACE_FUNCTION();
+      std::vector<double> rv(getTEC(when, rxgeo, svgeo));
+      double f = getFrequency(band);
+      for (unsigned i = 0; i < rv.size(); i++)
+      {
+         rv[i] = rv[i] * TECU_SCALE_FACTOR * 40.3/(f*f);                // eq.1
+      }
+      return rv;
+   }
+
+
    double NeQuickIonoNavData ::
    getTEC(const CommonTime& when,
           const Position& rxgeo,
@@ -209,11 +239,35 @@ namespace gnsstk
       const
    {
       DEBUGTRACE_FUNCTION();
-         // Get the time in civil units for later math
-      CivilTime civ(when);
-         // Obtain receiver modified dip latitude
-      MODIP modip;
-      CCIR ccir;
+      EpochParameters ep(*this, when, rxgeo);
+      return getTEC(ep, rxgeo, svgeo);
+   }
+
+
+   std::vector<double> NeQuickIonoNavData ::
+   getTEC(const CommonTime& when,
+          const Position& rxgeo,
+          const std::vector<Position>& svgeo)
+      const
+   {
+      DEBUGTRACE_FUNCTION();
+      EpochParameters ep(*this, when, rxgeo);
+      std::vector<double> rv(svgeo.size());
+      for (unsigned i = 0; i < svgeo.size(); i++)
+      {
+         rv[i] = getTEC(ep, rxgeo, svgeo[i]);
+      }
+      return rv;
+   }
+
+
+   double NeQuickIonoNavData ::
+   getTEC(const EpochParameters& ep,
+          const Position& rxgeo,
+          const Position& svgeo)
+      const
+   {
+      DEBUGTRACE_FUNCTION();
          // pre-determine in a somewhat clumsy, but probably faster
          // method than elevation() if the satellite is directly above
          // the station.
@@ -223,10 +277,8 @@ namespace gnsstk
           (fabs(svgeo.longitude()-rxgeo.longitude()) < ABOVE_ELEV_EPSILON));
       Position Pp(rxgeo.getRayPerigee(svgeo));
       IntegrationParameters ip(rxgeo, svgeo, Pp, vertical);
-      DEBUGTRACE("computing azu");
-      double modip_u = modip.stModip(rxgeo);
-      double azu = getEffIonoLevel(modip_u);
-      DEBUGTRACE("azu = " << azu);
+      double modip_u = ep.modip_u;
+      DEBUGTRACE("azu = " << ep.azu);
       DEBUGTRACE("vertical=" << vertical);
       DEBUGTRACE("rxgeo.geodeticLatitude()=" << rxgeo.geodeticLatitude());
       DEBUGTRACE("rxgeo.longitude()=" << rxgeo.longitude());
@@ -249,6 +301,16 @@ namespace gnsstk
       DEBUGTRACE("# a_sfu[0]=" << scientific << ai[0]);
       DEBUGTRACE("# a_sfu[1]=" << scientific << ai[1]);
       DEBUGTRACE("# a_sfu[2]=" << scientific << ai[2]);
+         // Every point on a vertical ray shares the receiver's
+         // latitude and longitude, so the profile parameters are
+         // only computed once.
+      std::unique_ptr<ModelParameters> vertProfile;
+      if (vertical)
+      {
+         Position top(rxgeo.geocentricLatitude(), rxgeo.longitude(), 0,
+                      Position::Geodetic, &elModel);
+         vertProfile.reset(new ModelParameters(modip_u, top, ep));
+      }
       double rv = 0;
          // must have at least two slant heights to make an interval...
       if (ip.integHeights.size() > 1)
@@ -257,8 +319,8 @@ namespace gnsstk
          {
             rv += integrateGaussKronrod(ip.integHeights[i-1],
                                         ip.integHeights[i],
-                                        rxgeo, svgeo, modip, modip_u, ccir, civ,
-                                        azu, ip.intThresh[i-1], vertical);
+                                        rxgeo, svgeo, ep, vertProfile.get(),
+                                        ip.intThresh[i-1]);
          }
       }
          // scale as per eq.151 and eq.202
@@ -291,16 +353,15 @@ namespace gnsstk
 
    double NeQuickIonoNavData ::
    getSED(double dist, const Position& rxgeo, const Position& svgeo,
-          const MODIP& modip, CCIR& ccirData, const CivilTime& when,
-          double azu)
+          const EpochParameters& ep)
       const
    {
       DEBUGTRACE_FUNCTION();
       DEBUGTRACE("height_km=" << setprecision(15) << dist);
       Position current(rxgeo.getRayPosition(dist * 1000.0, svgeo));
-      double modip_u = modip.stModip(current);
+      double modip_u = ep.modip.stModip(current);
       DEBUGTRACE("constructing SED iono");
-      ModelParameters iono(modip_u, current, azu, ccirData, when);
+      ModelParameters iono(modip_u, current, ep);
       double electronDensity = iono.electronDensity(current);
       DEBUGTRACE("electron density=" << setprecision(15) << scientific
                  << electronDensity);
@@ -309,9 +370,8 @@ namespace gnsstk
 
 
    double NeQuickIonoNavData ::
-   getVED(double dist, const Position& rxgeo, const Position& svgeo,
-          double modip_u, CCIR& ccirData, const CivilTime& when,
-          double azu)
+   getVED(double dist, const Position& rxgeo,
+          const ModelParameters& vertProfile)
       const
    {
       DEBUGTRACE_FUNCTION();
@@ -319,9 +379,7 @@ namespace gnsstk
          // remember that dist is a height for VED, and that it's in km
       Position current(rxgeo.geocentricLatitude(), rxgeo.longitude(), dist*1000,
                        Position::Geodetic, &elModel);
-      DEBUGTRACE("constructing VED iono");
-      ModelParameters iono(modip_u, current, azu, ccirData, when);
-      double electronDensity = iono.electronDensity(current);
+      double electronDensity = vertProfile.electronDensity(current);
       return electronDensity;
    }
 
@@ -341,6 +399,25 @@ namespace gnsstk
    }
 
 
+   NeQuickIonoNavData::EpochParameters ::
+   EpochParameters(const NeQuickIonoNavData& nav,
+                   const CommonTime& when, const Position& rxgeo)
+         : civ(when),
+           utHour(civ.getUTHour()),
+           solarDecl(ModelParameters::solarDeclination(civ)),
+           ccir(threadCCIR())
+   {
+      DEBUGTRACE_FUNCTION();
+      DEBUGTRACE("computing azu");
+      modip_u = modip.stModip(rxgeo);
+      azu = nav.getEffIonoLevel(modip_u);
+      azr = ModelParameters::effSunSpots(azu);
+         // The Fourier coefficients depend only on the epoch and
+         // the receiver's effective sunspot number.
+      threadCCIR().fourier(civ, azr);
+   }
+
+
    NeQuickIonoNavData::ModelParameters ::
    ModelParameters(double modip_u, const Position& pos, double az,
                    CCIR& ccirData, const CivilTime& when)
@@ -349,12 +426,43 @@ namespace gnsstk
            ccir(ccirData)
    {
       DEBUGTRACE_FUNCTION();
-      int seas;
       DEBUGTRACE("pos = " << pos);
       DEBUGTRACE("solar_12_month_running_mean_of_2800_MHZ_noise_flux=" << az);
          // get the effective sunspot number
-      fAzr = sqrt(167273+(az-DEFAULT_IONO_LEVEL)*1123.6)-408.99;        // eq.19
-      switch (when.month)
+      fAzr = effSunSpots(az);
+         // Compute the fourier time series for foF2 and M(3000)F2
+      ccirData.fourier(when, fAzr);
+      profile(modip_u, pos, az, when.month);
+   }
+
+
+   NeQuickIonoNavData::ModelParameters ::
+   ModelParameters(double modip_u, const Position& pos,
+                   const EpochParameters& ep)
+         : ccir(ep.ccir),
+           fAzr(ep.azr),
+           ffoF1(0.0), // default to 0, see eq.37
+           fXeff(effSolarZenithAngle(pos, ep.utHour, ep.solarDecl))
+   {
+      DEBUGTRACE_FUNCTION();
+      DEBUGTRACE("pos = " << pos);
+      profile(modip_u, pos, ep.azu, ep.civ.month);
+   }
+
+
+   double NeQuickIonoNavData::ModelParameters ::
+   effSunSpots(double az)
+   {
+      return sqrt(167273+(az-DEFAULT_IONO_LEVEL)*1123.6)-408.99;        // eq.19
+   }
+
+
+   void NeQuickIonoNavData::ModelParameters ::
+   profile(double modip_u, const Position& pos, double az, unsigned month)
+   {
+      DEBUGTRACE_FUNCTION();
+      int seas;
+      switch (month)
       {
          case 1:
          case 2:
@@ -416,21 +524,19 @@ namespace gnsstk
       DEBUGTRACE("seas=" << seas);
       DEBUGTRACE("ee=" << scientific << ee);
       DEBUGTRACE("seasp=" << seasp);
-         // Compute the fourier time series for foF2 and M(3000)F2
-      ccir.fourier(when, fAzr);
       legendre(modip_u, pos);
       fNmF2 = FREQ2NE_D * ffoF2 * ffoF2;                                //eq.77
          // Compute peak electron density height for each layer
       height();
          // Compute thickness parameters for each layer
       thickness();
-      exosphereAdjust(when.month);
+      exosphereAdjust(month);
       peakAmplitudes();
    }
 
 
    NeQuickIonoNavData::ModelParameters ::
-   ModelParameters(CCIR& ccirData)
+   ModelParameters(const CCIR& ccirData)
          : ccir(ccirData),
            fAzr(std::numeric_limits<double>::quiet_NaN()),
            ffoE(std::numeric_limits<double>::quiet_NaN()),
@@ -480,13 +586,21 @@ namespace gnsstk
 
    Angle NeQuickIonoNavData::ModelParameters ::
    solarZenithAngle(const Position& pos, const CivilTime& when)
+   {
+      DEBUGTRACE_FUNCTION();
+         // leave the UTC check up to solarDeclination
+      return solarZenithAngle(pos, when.getUTHour(), solarDeclination(when));
+   }
+
+
+   Angle NeQuickIonoNavData::ModelParameters ::
+   solarZenithAngle(const Position& pos, double utHour,
+                    const AngleReduced& deltaSun)
    {
       DEBUGTRACE_FUNCTION();
       double phiRad = pos.geodeticLatitude() * DEG2RAD;
       double lambda = pos.longitude();
-      AngleReduced deltaSun = solarDeclination(when);
-         // leave the UTC check up to solarDeclination
-      double lt = when.getUTHour() + (lambda / 15.0);                   //eq.4
+      double lt = utHour + (lambda / 15.0);                             //eq.4
          // X is really chi.
       double cosX=sin(phiRad) * sin(deltaSun) +                         //eq.26
          cos(phiRad) * cos(deltaSun) * cos(PI/12*(12-lt));
@@ -496,11 +610,21 @@ namespace gnsstk
 
    Angle NeQuickIonoNavData::ModelParameters ::
    effSolarZenithAngle(const Position& pos, const CivilTime& when)
+   {
+      DEBUGTRACE_FUNCTION();
+      return effSolarZenithAngle(pos, when.getUTHour(),
+                                 solarDeclination(when));
+   }
+
+
+   Angle NeQuickIonoNavData::ModelParameters ::
+   effSolarZenithAngle(const Position& pos, double utHour,
+                       const AngleReduced& deltaSun)
    {
       DEBUGTRACE_FUNCTION();
          // x is really chi.
       static const double x0 = 86.23292796211615;                       //eq.28
-      Angle x = solarZenithAngle(pos, when);
+      Angle x = solarZenithAngle(pos, utHour, deltaSun);
       double exp2 = neExp(12*(x.deg()-x0));                             //eq.29
       return Angle((x.deg()+(90-0.24*neExp(20-0.2*x.deg()))*exp2) / (1+exp2),
                    AngleType::Deg);
@@ -730,6 +854,7 @@ namespace gnsstk
 
    double NeQuickIonoNavData::ModelParameters ::
    electronDensity(const Position& pos)
+      const
    {
       DEBUGTRACE_FUNCTION();
       double rv = 0;
@@ -749,6 +874,7 @@ namespace gnsstk
 
    double NeQuickIonoNavData::ModelParameters ::
    electronDensityTop(const Position& pos)
+      const
    {
       DEBUGTRACE_FUNCTION();
       static constexpr double g = 0.125;                                //eq.122
@@ -772,6 +898,7 @@ namespace gnsstk
 
    double NeQuickIonoNavData::ModelParameters ::
    electronDensityBottom(const Position& pos)
+      const
    {
       DEBUGTRACE_FUNCTION();
       double h = pos.height() / 1000.0; // height in km
@@ -920,9 +1047,9 @@ namespace gnsstk
    double NeQuickIonoNavData ::
    integrateGaussKronrod(double heightPt1, double heightPt2,
                          const Position& rxgeo, const Position& svgeo,
-                         const MODIP& modip, double modipSta, CCIR& ccirData,
-                         const CivilTime& when, double azu, double tolerance,
-                         bool vertical, unsigned recursionLevel)
+                         const EpochParameters& ep,
+                         const ModelParameters* vertProfile,
+                         double tolerance, unsigned recursionLevel)
       const
    {
       DEBUGTRACE_FUNCTION();
@@ -997,13 +1124,13 @@ namespace gnsstk
          double x = h2 * xi[i] + hh;
          double y = 0;
          DEBUGTRACE("i=" << i << "  x=" << x);
-         if (vertical)
+         if (vertProfile)
          {
-            y = getVED(x, rxgeo, svgeo, modipSta, ccirData, when, azu);
+            y = getVED(x, rxgeo, *vertProfile);
          }
          else
          {
-            y = getSED(x, rxgeo, svgeo, modip, ccirData, when, azu);
+            y = getSED(x, rxgeo, svgeo, ep);
          }
          DEBUGTRACE("GKI ED = " << scientific << y);
             // Accumulate on to the k15 total
@@ -1035,12 +1162,12 @@ namespace gnsstk
             // Result is not within tolerance.  Split portion into
             // equal halves and recurse.
          rv = integrateGaussKronrod(heightPt1, heightPt1 + h2, rxgeo, svgeo,
-                                    modip, modipSta, ccirData, when, azu,
-                                    tolerance, vertical, recursionLevel+1);
+                                    ep, vertProfile, tolerance,
+                                    recursionLevel+1);
          DEBUGTRACE("pResult(4) = " << scientific << rv);
          rv += integrateGaussKronrod(heightPt1 + h2, heightPt2, rxgeo, svgeo,
-                                     modip, modipSta, ccirData, when, azu,
-                                     tolerance, vertical, recursionLevel+1);
+                                     ep, vertProfile, tolerance,
+                                     recursionLevel+1);
          DEBUGTRACE("pResult(5) = " << scientific << rv);
       }
       return rv;
@@ -74,6 +74,13 @@ namespace gnsstk
        *     useful name could be found.
        *   * No, I don't know why A1=F2 amplitude, etc.
        *
+       * The model evaluation methods (getTEC(), getIonoCorr()) may
+       * be called concurrently on a shared object, e.g. from a
+       * NavLibrary serving several per-station worker threads, as
+       * long as the object itself isn't being modified.  The
+       * interpolated CCIR coefficients are kept per thread so each
+       * thread retains its own cache between calls.
+       *
        * References:
        * \cite galileo:iono
        * \cite itur:iono
@@ -119,6 +126,38 @@ namespace gnsstk
                     const Position& rxgeo,
                     const Position& svgeo) const;
 
+         /** Get the ionospheric corrections in meters for a set of
+          * satellites observed by one receiver at one epoch.  The
+          * model parameters that depend only on the epoch and the
+          * receiver are computed once and shared by all rays.
+          * @param[in] when The time of the observation to correct.
+          * @param[in] rxgeo The receiver's geodetic position.
+          * @param[in] svgeo The observed satellites' geodetic positions.
+          * @param[in] band The carrier band of the signals being corrected.
+          * @return The ionospheric delay, in meters, on band, for
+          *   each element of svgeo in the same order. */
+      std::vector<double> getIonoCorr(const CommonTime& when,
+                                      const Position& rxgeo,
+                                      const std::vector<Position>& svgeo,
+                                      CarrierBand band) const;
+
+         /** Get the total electron content between rxgeo and each of
+          * svgeo at the given time.  This produces the same results
+          * as calling getTEC() for each satellite, but the
+          * per-epoch and per-receiver model parameters (solar
+          * declination, effective ionization level, CCIR Fourier
+          * coefficients) are computed once, and vertical rays
+          * evaluate their profile parameters once rather than at
+          * every integration node.
+          * @param[in] when The time when the RF signals were received.
+          * @param[in] rxgeo The position of the GNSS receiver's antenna.
+          * @param[in] svgeo The positions of the transmitting satellites.
+          * @return The total electron content in TEC units for each
+          *   element of svgeo in the same order. */
+      std::vector<double> getTEC(const CommonTime& when,
+                                 const Position& rxgeo,
+                                 const std::vector<Position>& svgeo) const;
+
          /** a<sub>i</sub> terms of NeQuick model in solar flux units,
           * solar flux units/degree, solar flux
           * units/degree<sup>2</sup>.  Refer to Galileo-OS-SIS-ICD. */
@@ -150,6 +189,35 @@ namespace gnsstk
           * @return The effective ionization level Az in solar flux units. */
       double getEffIonoLevel(double modip_u) const;
 
+         /** Aggregate the model inputs that are shared by every ray
+          * from a single receiver at a single epoch. */
+      class EpochParameters
+      {
+      public:
+            /** Compute the per-epoch and per-receiver parameters.
+             * @param[in] nav The NeQuick data providing the a<sub>i</sub>
+             *   coefficients.
+             * @param[in] when The time when the RF signal was received.
+             * @param[in] rxgeo The position of the GNSS receiver's antenna.
+             * @post ccir refers to the calling thread's CCIR
+             *   object, which holds the Fourier coefficients for
+             *   when and azr.  The object is only valid on the
+             *   constructing thread, until the next EpochParameters
+             *   is constructed there. */
+         EpochParameters(const NeQuickIonoNavData& nav,
+                         const CommonTime& when, const Position& rxgeo);
+
+         CivilTime civ;          ///< Time of the observation in civil units.
+         double utHour;          ///< UT hour of civ.
+         AngleReduced solarDecl; ///< Solar declination at civ.
+         MODIP modip;            ///< Modified dip latitude lookup.
+         double modip_u;         ///< Modified dip latitude of the receiver.
+         double azu;             ///< Effective ionization level at receiver.
+         double azr;             ///< Effective sunspot number from azu.
+            /// Calling thread's iono model data, Fourier coefficients set.
+         const CCIR& ccir;
+      };
+
          /// Aggregate the model parameters as defined in section 2.5.5
       class ModelParameters
       {
@@ -167,6 +235,22 @@ namespace gnsstk
          ModelParameters(double modip_u, const Position& pos, double az,
                          CCIR& ccirData, const CivilTime& when);
 
+            /** Compute the various NeQuickG model parameters using
+             * precomputed per-epoch data.
+             * @param[in] modip_u Modified dip latitude in degrees.
+             * @param[in] pos The geodetic position of the observer.
+             * @param[in] ep The per-epoch parameters, whose ccir
+             *   already holds the Fourier coefficients for the epoch.
+             * @post fAzr, ffoE, fNmE, ffoF1, fNmF1, fNmF2 are set. */
+         ModelParameters(double modip_u, const Position& pos,
+                         const EpochParameters& ep);
+
+            /** Compute the effective sunspot number.
+             * @param[in] az The effective ionization level in solar
+             *   flux units.
+             * @return Azr, the effective sunspot number. */
+         static double effSunSpots(double az);
+
             /** Compute the sine and cosine of the solar
              * declination. (sec 2.5.4.6)
              * @param[in] when The time at which to compute the solar
@@ -181,6 +265,15 @@ namespace gnsstk
          static Angle solarZenithAngle(const Position& pos,
                                        const CivilTime& when);
 
+            /** Compute the solar zenith angle from a precomputed
+             * solar declination.
+             * @param[in] pos The geodetic position of the observer.
+             * @param[in] utHour The UT hour of the observation.
+             * @param[in] deltaSun The solar declination at utHour.
+             * @return The solar zenith angle. */
+         static Angle solarZenithAngle(const Position& pos, double utHour,
+                                       const AngleReduced& deltaSun);
+
             /** Compute the effective solar zenith angle.
              * @param[in] pos The geodetic position of the observer.
              * @param[in] when The time at which to compute the solar zenith.
@@ -188,6 +281,28 @@ namespace gnsstk
          static Angle effSolarZenithAngle(const Position& pos,
                                           const CivilTime& when);
 
+            /** Compute the effective solar zenith angle from a
+             * precomputed solar declination.
+             * @param[in] pos The geodetic position of the observer.
+             * @param[in] utHour The UT hour of the observation.
+             * @param[in] deltaSun The solar declination at utHour.
+             * @return The effective solar zenith angle. */
+         static Angle effSolarZenithAngle(const Position& pos, double utHour,
+                                          const AngleReduced& deltaSun);
+
+            /** Compute the parameters that follow from fXeff and fAzr.
+             * @param[in] modip_u Modified dip latitude in degrees.
+             * @param[in] pos The geodetic position of the observer.
+             * @param[in] az The effective ionization level in solar
+             *   flux units.
+             * @param[in] month Month 1-12 for ionospheric model.
+             * @pre fXeff, fAzr must be set and ccir must hold the
+             *   Fourier coefficients for the epoch.
+             * @post ffoE, fNmE, ffoF1, fNmF1, fNmF2 and the derived
+             *   height, thickness and amplitude parameters are set. */
+         void profile(double modip_u, const Position& pos, double az,
+                      unsigned month);
+
             /** Compute foF2 and M(3000)F2 by Legendre calculation.
              * @param[in] modip_u Modified dip latitude in degrees.
              * @param[in] pos The geodetic position of the observer.
@@ -245,22 +360,22 @@ namespace gnsstk
              *   fB2bot, fA must be set.
              * @param[in] pos The position at which to compute electron density.
              * @return The electron density in TECU. */
-         double electronDensity(const Position& pos);
+         double electronDensity(const Position& pos) const;
 
             /** Compute the topside electron density.
              * @pre fhmF2, fH0, fNmF2 must be set.
              * @param[in] pos The position at which to compute electron density.
              * @return The electron density in TECU. */
-         double electronDensityTop(const Position& pos);
+         double electronDensityTop(const Position& pos) const;
 
             /** Compute the bottomside electron density.
              * @pre fBEtop, fhmF1, fB1top, fB1bot, fhmF2, fB2bot, fA
              *   must be set.
              * @param[in] pos The position at which to compute electron density.
              * @return The electron density in TECU. */
-         double electronDensityBottom(const Position& pos);
+         double electronDensityBottom(const Position& pos) const;
 
-         CCIR &ccir;      ///< Reference to iono model data.
+         const CCIR &ccir; ///< Reference to iono model data.
          double fAzr;     ///< Effective sunspot number.
          double ffoE;     ///< E layer critical frequency in MHz.
          double fNmE;     ///< E layer maximum electron density in el m**-2.
@@ -282,7 +397,7 @@ namespace gnsstk
 
       private:
             /// Constructor for testing only.
-         ModelParameters(CCIR& ccirData);
+         ModelParameters(const CCIR& ccirData);
 
          friend class ::NeQuickIonoNavData_T;
       };
@@ -317,22 +432,26 @@ namespace gnsstk
          std::vector<double> intThresh;
       };
 
+         /** Get the total electron content between the receiver
+          * described by ep and svgeo.
+          * @param[in] ep The per-epoch and per-receiver parameters.
+          * @param[in] rxgeo The position of the GNSS receiver's antenna.
+          * @param[in] svgeo The position of the transmitting satellite.
+          * @return The total electron content in TEC units. */
+      double getTEC(const EpochParameters& ep, const Position& rxgeo,
+                    const Position& svgeo) const;
+
          /** Get the electron density at a distance along a path where
           * svgeo is not directly overhead rxgeo.
           * @param[in] dist The height above the ellipsoid in km at
           *   which to get the electron density.
           * @param[in] rxgeo The position of the GNSS receiver's antenna.
           * @param[in] svgeo The position of the transmitting satellite.
-          * @param[in] modip A pre-constructed MODIP object to use.
-          * @param[in] ccirData A pre-constructed CCIR object to use.
-          * @param[in] when The time when the RF signal was received.
-          * @param[in] azu Effective ionization level, in solar flux
-          *   units, at the modified dip latitude of the receiver.
+          * @param[in] ep The per-epoch and per-receiver parameters.
           * @return The electron density in TECU.
           */
       double getSED(double dist, const Position& rxgeo, const Position& svgeo,
-                    const MODIP& modip, CCIR& ccirData, const CivilTime& when,
-                    double azu)
+                    const EpochParameters& ep)
          const;
 
          /** Get the electron density at a distance along a path where
@@ -340,17 +459,13 @@ namespace gnsstk
           * @param[in] dist The height above the ellipsoid in km at
           *   which to get the electron density.
           * @param[in] rxgeo The position of the GNSS receiver's antenna.
-          * @param[in] svgeo The position of the transmitting satellite.
-          * @param[in] modip_u The modified dip latitude in degrees for rxgeo.
-          * @param[in] ccirData A pre-constructed CCIR object to use.
-          * @param[in] when The time when the RF signal was received.
-          * @param[in] azu Effective ionization level, in solar flux
-          *   units, at the modified dip latitude of the receiver.
+          * @param[in] vertProfile The model parameters at the
+          *   receiver's latitude and longitude, which apply to every
+          *   point on a vertical ray.
           * @return The electron density in TECU.
           */
-      double getVED(double dist, const Position& rxgeo, const Position& svgeo,
-                    double modip_u, CCIR& ccirData, const CivilTime& when,
-                    double azu)
+      double getVED(double dist, const Position& rxgeo,
+                    const ModelParameters& vertProfile)
          const;
 
          /** Perform Gauss-Kronrod integration of the TEC along the
@@ -361,27 +476,22 @@ namespace gnsstk
           *   which integration should end.
           * @param[in] rxgeo The position of the GNSS receiver's antenna.
           * @param[in] svgeo The position of the transmitting satellite.
-          * @param[in] modip A pre-constructed MODIP object to use.
-          * @param[in] modipSta The modified dip latitude in degrees for rxgeo.
-          * @param[in] ccirData A pre-constructed CCIR object to use.
-          * @param[in] when The time when the RF signal was received.
-          * @param[in] azu Effective ionization level, in solar flux
-          *   units, at the modified dip latitude of the receiver.
+          * @param[in] ep The per-epoch and per-receiver parameters.
+          * @param[in] vertProfile If not null, svgeo is directly
+          *   overhead rxgeo, integration is simplified and these
+          *   model parameters are used at every integration point.
           * @param[in] tolerance If the delta between K15 and G7
           *   integration results is less than this number,
           *   integration will complete.
-          * @param[in] vertical If true, svgeo is directly overhead
-          *   rxgeo and integration is simplified.
           * @param[in] recursionLevel integrateGaussKronrod will
           *   recurse if the results are not within tolerance, up to
           *   RecursionMax (defined in cpp file) times.
           * @return The integrated TEC. */
       double integrateGaussKronrod(double heightPt1, double heightPt2,
                                    const Position& rxgeo, const Position& svgeo,
-                                   const MODIP& modip, double modipSta,
-                                   CCIR& ccirData,
-                                   const CivilTime& when, double azu,
-                                   double tolerance, bool vertical,
+                                   const EpochParameters& ep,
+                                   const ModelParameters* vertProfile,
+                                   double tolerance,
                                    unsigned recursionLevel = 0)
          const;
 
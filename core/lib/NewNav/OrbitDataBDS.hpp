@@ -77,6 +77,15 @@ namespace gnsstk
          CGCS2000Ellipsoid ell;
          return OrbitDataKepler::svRelativity(when, ell);
       }
+
+         /// @copydoc OrbitDataKepler::getEllipsoidParams
+      bool getEllipsoidParams(double& gm, double& angVel) const override
+      {
+         CGCS2000Ellipsoid ell;
+         gm = ell.gm();
+         angVel = ell.angVelocity();
+         return true;
+      }
    };
 } // namespace gnsstk
 
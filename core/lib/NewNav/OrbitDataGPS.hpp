@@ -77,6 +77,15 @@ namespace gnsstk
          GPSEllipsoid ell;
          return OrbitDataKepler::svRelativity(when, ell);
       }
+
+         /// @copydoc OrbitDataKepler::getEllipsoidParams
+      bool getEllipsoidParams(double& gm, double& angVel) const override
+      {
+         GPSEllipsoid ell;
+         gm = ell.gm();
+         angVel = ell.angVelocity();
+         return true;
+      }
    };
 } // namespace gnsstk
 
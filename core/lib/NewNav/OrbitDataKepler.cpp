@@ -37,6 +37,7 @@
 //
 //==============================================================================
 #include <math.h> // trig functions
+#include <algorithm>
 #include "OrbitDataKepler.hpp"
 #include "GPSWeekSecond.hpp"
 #include "GPSEllipsoid.hpp"
@@ -46,6 +47,193 @@ using namespace std;
 
 namespace gnsstk
 {
+      /** Orbital elements and times for a block of batch Xvt
+       * computations, stored as arrays so that the computations in
+       * compute() can be vectorized.  Each lane is one
+       * (orbit, time) pair. */
+   class KeplerBlock
+   {
+   public:
+         /// Number of lanes in a block.
+      static const size_t size = 64;
+
+         /** Copy the parameters for one lane.
+          * @param[in] i The lane to set.
+          * @param[in] orb The orbital elements to use.
+          * @param[in] when The time to compute the Xvt for.
+          * @param[in] toeSOW The GPS seconds of week of orb.Toe.
+          * @param[in] gm The ellipsoid's EllipsoidModel::gm().
+          * @param[in] angVel The ellipsoid's EllipsoidModel::angVelocity(). */
+      void set(size_t i, const OrbitDataKepler& orb, const CommonTime& when,
+               double toeSOW, double gm, double angVel);
+
+         /** Compute the Xvt for lanes [0,n) and store lane i in
+          * element index[i] of xvt.  This duplicates the arithmetic
+          * of OrbitDataKepler::getXvt(), svRelativity(),
+          * svClockBias() and svClockDrift() exactly.  Health, frame
+          * and valid are not set. */
+      void compute(size_t n, XvtBatch& xvt, const size_t *index);
+
+      double elapte[size], elaptc[size], ToeSOW[size];
+      double sqrtgm[size], angVel[size];
+      double M0[size], dn[size], dndot[size], ecc[size], A[size];
+      double Ahalf[size], Adot[size], OMEGA0[size], i0[size], w[size];
+      double OMEGAdot[size], idot[size];
+      double Cuc[size], Cus[size], Crc[size], Crs[size], Cic[size], Cis[size];
+      double af0[size], af1[size], af2[size];
+   };
+
+
+   const size_t KeplerBlock::size;
+
+
+   void KeplerBlock ::
+   set(size_t i, const OrbitDataKepler& orb, const CommonTime& when,
+       double toeSOW, double gm, double angVelocity)
+   {
+      elapte[i] = when - orb.Toe;
+      elaptc[i] = when - orb.Toc;
+      ToeSOW[i] = toeSOW;
+      sqrtgm[i] = SQRT(gm);
+      angVel[i] = angVelocity;
+      M0[i] = orb.M0;
+      dn[i] = orb.dn;
+      dndot[i] = orb.dndot;
+      ecc[i] = orb.ecc;
+      A[i] = orb.A;
+      Ahalf[i] = orb.Ahalf;
+      Adot[i] = orb.Adot;
+      OMEGA0[i] = orb.OMEGA0;
+      i0[i] = orb.i0;
+      w[i] = orb.w;
+      OMEGAdot[i] = orb.OMEGAdot;
+      idot[i] = orb.idot;
+      Cuc[i] = orb.Cuc;
+      Cus[i] = orb.Cus;
+      Crc[i] = orb.Crc;
+      Crs[i] = orb.Crs;
+      Cic[i] = orb.Cic;
+      Cis[i] = orb.Cis;
+      af0[i] = orb.af0;
+      af1[i] = orb.af1;
+      af2[i] = orb.af2;
+   }
+
+
+   void KeplerBlock ::
+   compute(size_t n, XvtBatch& xvt, const size_t *index)
+   {
+      double twoPI = 2.0e0 * PI;
+      double Ak[size], amm[size], meana[size], ea[size];
+      double ammR[size], meanaR[size], eaR[size];
+      bool active[size], activeR[size];
+      bool anyActive = false, anyActiveR = false;
+         // Mean motion and mean anomaly.  svRelativity() doesn't
+         // use dndot, so it needs its own eccentric anomaly when
+         // dndot is non-zero.
+      for (size_t i = 0; i < n; i++)
+      {
+         Ak[i] = A[i] + Adot[i] * elapte[i];
+         double dnA = dn[i] + 0.5 * dndot[i] * elapte[i];
+         amm[i] = (sqrtgm[i] / (A[i]*Ahalf[i])) + dnA;
+         meana[i] = fmod(M0[i] + elapte[i] * amm[i], twoPI);
+         ea[i] = meana[i] + ecc[i] * ::sin(meana[i]);
+         active[i] = true;
+         activeR[i] = (dndot[i] != 0.0);
+         anyActiveR |= activeR[i];
+         ammR[i] = (sqrtgm[i] / (A[i]*Ahalf[i])) + dn[i];
+         meanaR[i] = fmod(M0[i] + elapte[i] * ammR[i], twoPI);
+         eaR[i] = meanaR[i] + ecc[i] * ::sin(meanaR[i]);
+      }
+         // Solve Kepler's equation for all lanes at once, each lane
+         // stopping under the same conditions as getXvt().
+      for (int iter = 0; iter < 20; iter++)
+      {
+         anyActive = false;
+         for (size_t i = 0; i < n; i++)
+         {
+            double F = meana[i] - (ea[i] - ecc[i] * ::sin(ea[i]));
+            double G = 1.0 - ecc[i] * ::cos(ea[i]);
+            double delea = F/G;
+            ea[i] = active[i] ? ea[i] + delea : ea[i];
+            active[i] = active[i] && (fabs(delea) > 1.0e-11);
+            anyActive |= active[i];
+         }
+         if (!anyActive)
+            break;
+      }
+      for (int iter = 0; anyActiveR && (iter < 20); iter++)
+      {
+         anyActiveR = false;
+         for (size_t i = 0; i < n; i++)
+         {
+            double F = meanaR[i] - (eaR[i] - ecc[i] * ::sin(eaR[i]));
+            double G = 1.0 - ecc[i] * ::cos(eaR[i]);
+            double delea = F/G;
+            eaR[i] = activeR[i] ? eaR[i] + delea : eaR[i];
+            activeR[i] = activeR[i] && (fabs(delea) > 1.0e-11);
+            anyActiveR |= activeR[i];
+         }
+      }
+      for (size_t i = 0; i < n; i++)
+      {
+            // clock corrections
+         double eaRel = (dndot[i] != 0.0) ? eaR[i] : ea[i];
+         xvt.relcorr[index[i]] = REL_CONST * ecc[i] * SQRT(Ak[i]) * ::sin(eaRel);
+         xvt.clkbias[index[i]] = af0[i] + elaptc[i] * (af1[i] + elaptc[i] * af2[i]);
+         xvt.clkdrift[index[i]] = af1[i] + elaptc[i] * af2[i];
+            // true anomaly
+         double lecc = ecc[i];
+         double q = SQRT(1.0e0 - lecc*lecc);
+         double sinea = ::sin(ea[i]);
+         double cosea = ::cos(ea[i]);
+         double G = 1.0e0 - lecc * cosea;
+         double truea = atan2(q * sinea, cosea - lecc);
+            // argument of latitude and 2nd harmonic corrections
+         double alat = truea + w[i];
+         double talat = 2.0e0 * alat;
+         double c2al = ::cos(talat);
+         double s2al = ::sin(talat);
+         double du = c2al * Cuc[i] + s2al * Cus[i];
+         double dr = c2al * Crc[i] + s2al * Crs[i];
+         double di = c2al * Cic[i] + s2al * Cis[i];
+         double U = alat + du;
+         double R = Ak[i]*G + dr;
+         double AINC = i0[i] + idot[i] * elapte[i] + di;
+         double ANLON = OMEGA0[i] + (OMEGAdot[i] - angVel[i]) *
+            elapte[i] - angVel[i] * ToeSOW[i];
+            // in plane location
+         double cosu = ::cos(U);
+         double sinu = ::sin(U);
+         double xip = R * cosu;
+         double yip = R * sinu;
+            // rotation to earth fixed
+         double can = ::cos(ANLON);
+         double san = ::sin(ANLON);
+         double cinc = ::cos(AINC);
+         double sinc = ::sin(AINC);
+         xvt.x[index[i]] = xip*can - yip*cinc*san;
+         xvt.y[index[i]] = xip*san + yip*cinc*can;
+         xvt.z[index[i]] = yip*sinc;
+            // velocity
+         double dek = amm[i] / G;
+         double dlk = amm[i] * q / (G*G);
+         double div = idot[i] - 2.0e0 * dlk * (Cic[i] * s2al - Cis[i] * c2al);
+         double domk = OMEGAdot[i] - angVel[i];
+         double duv = dlk*(1.e0+ 2.e0 * (Cus[i]*c2al - Cuc[i]*s2al));
+         double drv = Ak[i] * lecc * dek * sinea - 2.e0 * dlk *
+            (Crc[i] * s2al - Crs[i] * c2al) + Adot[i] * G;
+         double dxp = drv*cosu - R*sinu*duv;
+         double dyp = drv*sinu + R*cosu*duv;
+         xvt.vx[index[i]] = dxp*can - xip*san*domk - dyp*cinc*san
+            + yip*(sinc*san*div - cinc*can*domk);
+         xvt.vy[index[i]] = dxp*san + xip*can*domk + dyp*cinc*can
+            - yip*(sinc*can*div + cinc*san*domk);
+         xvt.vz[index[i]] = dyp*sinc + yip*cinc*div;
+      }
+   }
+
+
    OrbitDataKepler ::
    OrbitDataKepler()
          : Cuc(0.0), Cus(0.0), Crc(0.0), Crs(0.0), Cic(0.0), Cis(0.0), M0(0.0),
@@ -330,6 +518,106 @@ namespace gnsstk
    }
 
 
+   bool OrbitDataKepler ::
+   getXvtBatch(const std::vector<CommonTime>& when, XvtBatch& xvt)
+   {
+      xvt.resize(when.size());
+      bool rv = true;
+      double gm, angVel;
+      if (!getEllipsoidParams(gm, angVel))
+      {
+         Xvt one;
+         for (size_t i = 0; i < when.size(); i++)
+         {
+            bool ok = getXvt(when[i], one);
+            xvt.setXvt(i, one, ok);
+            rv &= ok;
+         }
+         return rv;
+      }
+      GPSWeekSecond gpsws(Toe);
+      Xvt::HealthStatus xvtHealth = toXvtHealth(health);
+      KeplerBlock block;
+      size_t index[KeplerBlock::size];
+      for (size_t start = 0; start < when.size(); start += KeplerBlock::size)
+      {
+         size_t n = std::min(KeplerBlock::size, when.size() - start);
+         for (size_t i = 0; i < n; i++)
+         {
+            block.set(i, *this, when[start+i], gpsws.sow, gm, angVel);
+            index[i] = start + i;
+         }
+         block.compute(n, xvt, index);
+      }
+      for (size_t i = 0; i < when.size(); i++)
+      {
+         xvt.health[i] = xvtHealth;
+         xvt.frame[i] = frame;
+         xvt.valid[i] = 1;
+      }
+      return rv;
+   }
+
+
+   bool OrbitDataKepler ::
+   getXvtBatch(const std::vector<NavDataPtr>& orbits,
+               const std::vector<CommonTime>& when, XvtBatch& xvt)
+   {
+      if (orbits.size() != when.size())
+      {
+         GNSSTK_THROW(Exception("orbits and when must be the same size"));
+      }
+      xvt.resize(orbits.size());
+      bool rv = true;
+      KeplerBlock block;
+         // The lanes in block, and the index of the result each is for.
+      size_t n = 0;
+      size_t index[KeplerBlock::size];
+         // Setup for the most recently used orbit.
+      const NavData *lastOrbit = nullptr;
+      OrbitDataKepler *kep = nullptr;
+      bool batchable = false;
+      double toeSOW = 0.0, gm = 0.0, angVel = 0.0;
+      Xvt one;
+      for (size_t i = 0; i < orbits.size(); i++)
+      {
+         if (orbits[i].get() != lastOrbit)
+         {
+            lastOrbit = orbits[i].get();
+            kep = dynamic_cast<OrbitDataKepler*>(orbits[i].get());
+            batchable = ((kep != nullptr) &&
+                         kep->getEllipsoidParams(gm, angVel));
+            if (batchable)
+            {
+               toeSOW = GPSWeekSecond(kep->Toe).sow;
+            }
+         }
+         if (batchable)
+         {
+            block.set(n, *kep, when[i], toeSOW, gm, angVel);
+            xvt.health[i] = toXvtHealth(kep->health);
+            xvt.frame[i] = kep->frame;
+            xvt.valid[i] = 1;
+            index[n++] = i;
+            if (n == KeplerBlock::size)
+            {
+               block.compute(n, xvt, index);
+               n = 0;
+            }
+         }
+         else
+         {
+            OrbitData *orb = dynamic_cast<OrbitData*>(orbits[i].get());
+            bool ok = ((orb != nullptr) && orb->getXvt(when[i], one));
+            xvt.setXvt(i, one, ok);
+            rv &= ok;
+         }
+      }
+      block.compute(n, xvt, index);
+      return rv;
+   }
+
+
    double OrbitDataKepler ::
    svRelativity(const CommonTime& when, const EllipsoidModel& ell) const
    {
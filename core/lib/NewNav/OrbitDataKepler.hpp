@@ -42,6 +42,7 @@
 #include "OrbitData.hpp"
 #include "NavFit.hpp"
 #include "SVHealth.hpp"
+#include "XvtBatch.hpp"
 
 namespace gnsstk
 {
@@ -149,6 +150,46 @@ namespace gnsstk
                                   const EllipsoidModel& ell)
          const;
 
+         /** Get the ellipsoid parameters used by getXvt(when,xvt,oid).
+          * Child classes whose getXvt() is implemented by calling
+          * getXvt(when,ell,xvt,oid) override this to enable batch
+          * evaluation in getXvtBatch().
+          * @param[out] gm The value of EllipsoidModel::gm().
+          * @param[out] angVel The value of EllipsoidModel::angVelocity().
+          * @return false if getXvt() does not use the standard
+          *   Keplerian computation, in which case getXvtBatch() calls
+          *   getXvt() for each time instead. */
+      virtual bool getEllipsoidParams(double& gm, double& angVel) const
+      { return false; }
+
+         /** Compute the satellite's position, velocity and clock at
+          * a series of times.  The results are the same as calling
+          * getXvt(when[i],xvt) for each i, but the setup common to
+          * all of the times is done once and the Keplerian
+          * computations are done on arrays of times in a form the
+          * compiler can vectorize.
+          * @param[in] when The times at which to compute the xvt.
+          * @param[out] xvt The results, resized to when.size().
+          * @return true if successful for all times. */
+      bool getXvtBatch(const std::vector<CommonTime>& when, XvtBatch& xvt);
+
+         /** Compute the position, velocity and clock of a set of
+          * satellites and/or times.  Element i of the results is
+          * computed by orbits[i] at when[i].  Consecutive elements
+          * that refer to the same orbit share the common setup.
+          * Elements whose orbit is not OrbitDataKepler, or does not
+          * support batch evaluation, are computed using their own
+          * getXvt() method.
+          * @param[in] orbits The OrbitData objects to use.  Null
+          *   pointers result in an invalid element.
+          * @param[in] when The times at which to compute the xvt.
+          * @param[out] xvt The results, resized to orbits.size().
+          * @return true if successful for all elements.
+          * @throw Exception if orbits and when differ in size. */
+      static bool getXvtBatch(const std::vector<NavDataPtr>& orbits,
+                              const std::vector<CommonTime>& when,
+                              XvtBatch& xvt);
+
          /** Returns true if this two objects are
           *   1. same concrete type, and
           *   2. same data contents.
@@ -36,6 +36,7 @@
 //                            release, distribution is unlimited.
 //
 //==============================================================================
+#include <algorithm>
 #include <iterator>
 #include "SP3NavDataFactory.hpp"
 #include "SP3Stream.hpp"
@@ -99,6 +100,7 @@ namespace gnsstk
            halfOrderClk(5),
            halfOrderPos(5)
    {
+      setInterpWeights();
       supportedSignals.insert(NavSignalID(SatelliteSystem::BeiDou,
                                           CarrierBand::B1,
                                           TrackingCode::B1I,
@@ -240,6 +242,9 @@ namespace gnsstk
         NavSearchOrder order)
    {
       DEBUGTRACE_FUNCTION();
+         // findGeneric() builds a new object rather than modifying
+         // the store, so a shared lock is sufficient.
+      ReadWriteLock::ReadGuard guard(storeLock);
       bool rv;
       NavMessageID genericID;
       if (nmid.messageType != NavMessageType::Ephemeris)
@@ -595,6 +600,8 @@ namespace gnsstk
          if ((head.timeSystem != TimeSystem::Any) &&
              (head.timeSystem != TimeSystem::Unknown))
          {
+               // files may be processed concurrently
+            ReadWriteLock::WriteGuard guard(storeLock);
                // if store time system has not been set, do so
             if (storeTimeSystem == TimeSystem::Any)
             {
@@ -612,6 +619,13 @@ namespace gnsstk
                return false;
             }
          }
+            // Snapshot the clock source selection, which may be
+            // changed by a RINEX clock file processed concurrently.
+         bool storeSP3clk;
+         {
+            ReadWriteLock::ReadGuard guard(storeLock);
+            storeSP3clk = processClk && useSP3clock;
+         }
 
          while (is)
          {
@@ -632,7 +646,7 @@ namespace gnsstk
                if (!store(processEph, cb, eph))
                   return false;
                DEBUGTRACE("storing clk");
-               if (!store(processClk && useSP3clock, cb, clk))
+               if (!store(storeSP3clk, cb, clk))
                   return false;
             }
                // Don't process time records otherwise we'll end up
@@ -733,31 +747,35 @@ namespace gnsstk
             return true; // ...but the user doesn't want it.
 
             // check/save TimeSystem to storeTimeSystem
-         if(head.timeSystem != TimeSystem::Any &&
-            head.timeSystem != TimeSystem::Unknown)
          {
-               // if store time system has not been set, do so
-            if(storeTimeSystem == TimeSystem::Any)
+               // files may be processed concurrently
+            ReadWriteLock::WriteGuard guard(storeLock);
+            if(head.timeSystem != TimeSystem::Any &&
+               head.timeSystem != TimeSystem::Unknown)
             {
-                  /// @note store TimeSystem must be consistent.
-               storeTimeSystem = head.timeSystem;
+                  // if store time system has not been set, do so
+               if(storeTimeSystem == TimeSystem::Any)
+               {
+                     /// @note store TimeSystem must be consistent.
+                  storeTimeSystem = head.timeSystem;
+               }
+               else if (storeTimeSystem != head.timeSystem)
+               {
+                     // Don't load a RINEX clock file with a differing time system
+                  cerr << "Time system mismatch in SP3/RINEX clock data "
+                       << gnsstk::StringUtils::asString(storeTimeSystem)
+                       << " (store) != "
+                       << gnsstk::StringUtils::asString(head.timeSystem)
+                       << " (file)" << endl;
+                  return false;
+               }
             }
-            else if (storeTimeSystem != head.timeSystem)
+            else
             {
-                  // Don't load a RINEX clock file with a differing time system
-               cerr << "Time system mismatch in SP3/RINEX clock data "
-                    << gnsstk::StringUtils::asString(storeTimeSystem)
-                    << " (store) != "
-                    << gnsstk::StringUtils::asString(head.timeSystem)
-                    << " (file)" << endl;
-               return false;
+               head.timeSystem = TimeSystem::GPS;
+               storeTimeSystem = head.timeSystem;
             }
          }
-         else
-         {
-            head.timeSystem = TimeSystem::GPS;
-            storeTimeSystem = head.timeSystem;
-         }
 
             // Valid RINEX clock data with appropriate time system, go
             // ahead and switch to using RINEX clock instead of SP3
@@ -1001,6 +1019,216 @@ namespace gnsstk
    }
 
 
+      /** A contiguous table of SP3 records used for a single
+       * interpolation, along with the barycentric Lagrange
+       * coefficients for evaluating the interpolating polynomial and
+       * its derivative at one time.  The coefficients are shared by
+       * every column of the table, and storage for the usual
+       * interpolation orders is on the stack, so interpolation does
+       * not allocate.
+       * @see Berrut and Trefethen, "Barycentric Lagrange
+       *   Interpolation", SIAM Review 46(3), 2004. */
+   class SP3InterpTable
+   {
+   public:
+         /// Tables with up to this many nodes don't use the heap.
+      static const unsigned maxStackNodes = 20;
+         /// The maximum number of data columns in a table.
+      static const unsigned maxColumns = 18;
+
+         /** Set up storage for a table.
+          * @param[in] n The number of interpolation nodes.
+          * @param[in] ncol The number of data columns (<= maxColumns). */
+      SP3InterpTable(unsigned n, unsigned ncol);
+
+         /** Compute the barycentric weights for n equally spaced
+          * nodes with unit spacing.
+          * @param[in] n The number of nodes.
+          * @param[out] w The n weights. */
+      static void regular(unsigned n, std::vector<double>& w);
+
+         /** Compute the interpolation coefficients for time x.
+          * @pre tdata has been filled in.
+          * @param[in] x The time to interpolate to, in seconds
+          *   relative to the same epoch as tdata.
+          * @param[in] bary The weights from regular() for npts
+          *   nodes, used when the nodes in tdata are equally
+          *   spaced. */
+      void setPoint(double x, const std::vector<double>& bary);
+
+         /// Get a pointer to the first element of data column k.
+      double* col(unsigned k)
+      { return data + k*npts; }
+
+         /// Get the value of data column k interpolated to setPoint().
+      double value(unsigned k) const;
+
+         /** Get the derivative with respect to time of data column k
+          * interpolated to setPoint(). */
+      double deriv(unsigned k) const;
+
+      unsigned npts; ///< Number of interpolation nodes.
+      double *tdata; ///< Node times in seconds, npts long.
+      double *data;  ///< Data columns, each npts long.
+      double *wts;   ///< Barycentric weights for tdata.
+      double *coef;  ///< Coefficients for the interpolated value.
+      double *dcoef; ///< Coefficients for the interpolated derivative.
+      double *recip; ///< Scratch space for setPoint().
+
+   private:
+         /// Storage used when npts <= maxStackNodes.
+      double stackBuf[maxStackNodes * (maxColumns+6)];
+         /// Storage used when npts > maxStackNodes.
+      std::vector<double> heapBuf;
+   };
+
+
+   SP3InterpTable ::
+   SP3InterpTable(unsigned n, unsigned ncol)
+         : npts(n)
+   {
+      double *buf = stackBuf;
+      if (n > maxStackNodes)
+      {
+         heapBuf.resize(n * (ncol+6));
+         buf = heapBuf.data();
+      }
+      tdata = buf;
+      data = tdata + n;
+      wts = data + n*ncol;
+      coef = wts + n;
+      dcoef = coef + n;
+      recip = dcoef + n;
+   }
+
+
+   void SP3InterpTable ::
+   regular(unsigned n, std::vector<double>& w)
+   {
+         // w[j] = 1/prod(k!=j)(j-k) = (-1)^(n-1-j) / (j! (n-1-j)!)
+      w.resize(n);
+      if (n == 0)
+         return;
+      double fact = 1.0;
+      for (unsigned k = 2; k < n; k++)
+      {
+         fact *= k;
+      }
+      w[0] = (((n-1) % 2) ? -1.0 : 1.0) / fact;
+      for (unsigned j = 0; j+1 < n; j++)
+      {
+         w[j+1] = -w[j] * (n-1-j) / (j+1);
+      }
+   }
+
+
+   void SP3InterpTable ::
+   setPoint(double x, const std::vector<double>& bary)
+   {
+      unsigned i, j;
+         // Time differences are scaled by the first node spacing to
+         // keep the products well within range.
+      double h = tdata[1] - tdata[0];
+      bool isRegular = (bary.size() == npts);
+      for (j = 0; isRegular && (j < npts); j++)
+      {
+         isRegular = (tdata[j] == tdata[0] + j*h);
+      }
+      if (isRegular)
+      {
+         std::copy(bary.begin(), bary.end(), wts);
+      }
+      else
+      {
+         for (j = 0; j < npts; j++)
+         {
+            double prod = 1.0;
+            for (i = 0; i < npts; i++)
+            {
+               if (i != j)
+                  prod *= (tdata[j] - tdata[i]) / h;
+            }
+            wts[j] = 1.0 / prod;
+         }
+      }
+      for (j = 0; j < npts; j++)
+      {
+         if (x == tdata[j])
+            break;
+      }
+      if (j < npts)
+      {
+            // x is a node, use the node value and the corresponding
+            // row of the differentiation matrix.
+         double sum = 0.0;
+         for (i = 0; i < npts; i++)
+         {
+            coef[i] = 0.0;
+            if (i != j)
+            {
+               dcoef[i] = (wts[i] / wts[j]) / ((tdata[j] - tdata[i]) / h);
+               sum += dcoef[i];
+            }
+         }
+         coef[j] = 1.0;
+         dcoef[j] = -sum;
+      }
+      else
+      {
+            // L_i(x) = l(x) w_i / (x-t_i), l(x) = prod(x-t_k)
+            // L_i'(x) = L_i(x) * sum(k!=i) 1/(x-t_k)
+         double ell = 1.0;
+         for (i = 0; i < npts; i++)
+         {
+            double diff = (x - tdata[i]) / h;
+            ell *= diff;
+            recip[i] = 1.0 / diff;
+         }
+         for (i = 0; i < npts; i++)
+         {
+            coef[i] = ell * wts[i] * recip[i];
+            double sum = 0.0;
+            for (j = 0; j < npts; j++)
+            {
+               if (j != i)
+                  sum += recip[j];
+            }
+            dcoef[i] = coef[i] * sum;
+         }
+      }
+      for (i = 0; i < npts; i++)
+      {
+         dcoef[i] /= h;
+      }
+   }
+
+
+   double SP3InterpTable ::
+   value(unsigned k) const
+   {
+      const double *y = data + k*npts;
+      double rv = 0.0;
+      for (unsigned i = 0; i < npts; i++)
+      {
+         rv += coef[i] * y[i];
+      }
+      return rv;
+   }
+
+
+   double SP3InterpTable ::
+   deriv(unsigned k) const
+   {
+      const double *y = data + k*npts;
+      double rv = 0.0;
+      for (unsigned i = 0; i < npts; i++)
+      {
+         rv += dcoef[i] * y[i];
+      }
+      return rv;
+   }
+
+
       // This method is roughly equivalent to the deprecated
       // PositionSatStore::getValue().
    void SP3NavDataFactory ::
@@ -1010,9 +1238,11 @@ namespace gnsstk
       DEBUGTRACE_FUNCTION();
       DEBUGTRACE("start interpolating ephemeris, distance = "
                  << std::distance(ti1,ti3));
-      std::vector<double> tdata(2*halfOrderPos);
-      std::vector<std::vector<double>> posData(3), posSigData(3), velData(3),
-         velSigData(3), accData(3), accSigData(3);
+         // The table columns are x,y,z of position (0-2), velocity
+         // (3-5) and acceleration (6-8), followed by the
+         // corresponding sigmas (9-17).  Each column holds the data
+         // for the 2*halfOrderPos records used in the fit.
+      SP3InterpTable tab(2*halfOrderPos, 18);
       CommonTime firstTime(ti1->second->timeStamp);
          // This flag is only used to decide whether to compute sigmas
          // or use existing ones.  It is expected that for exact time
@@ -1020,150 +1250,89 @@ namespace gnsstk
          // in.
       bool isExact = false;
       unsigned idx = 0;
-         // posData etc are 2D arrays, where the first dimension
-         // is positional, x=0,y=1,z=2 and the 2nd dimension is
-         // the data index for the fit.
-      for (unsigned i = 0; i < 3; i++)
-      {
-         posData[i].resize(2*halfOrderPos);
-         posSigData[i].resize(2*halfOrderPos);
-         velData[i].resize(2*halfOrderPos);
-         velSigData[i].resize(2*halfOrderPos);
-         accData[i].resize(2*halfOrderPos);
-         accSigData[i].resize(2*halfOrderPos);
-      }
-      DEBUGTRACE("resized");
       bool haveVel = false, haveAcc = false;
       NavMap::iterator ti2;
       for (ti2 = ti1, idx=0; ti2 != ti3; ++ti2, ++idx)
       {
-         DEBUGTRACE("idx=" << idx);
-         tdata[idx] = ti2->second->timeStamp - firstTime;
+         tab.tdata[idx] = ti2->second->timeStamp - firstTime;
          if ((idx == halfOrderPos) && (ti2->second->timeStamp == when))
             isExact = true;
          OrbitDataSP3 *nav = dynamic_cast<OrbitDataSP3*>(
             ti2->second.get());
-         DEBUGTRACE("nav=" << nav);
-         // ti2->second->dump(cerr, DumpDetail::Full);
          for (unsigned i = 0; i < 3; i++)
          {
-            DEBUGTRACE("i=" << i);
-            DEBUGTRACE(posData.size() << " " << velData.size() << " "
-                       << accData.size());
-            DEBUGTRACE(nav->pos.size() << " " << nav->vel.size() << " "
-                       << nav->acc.size());
-            posData[i][idx] = nav->pos[i];
-            velData[i][idx] = nav->vel[i];
-            accData[i][idx] = nav->acc[i];
-            posSigData[i][idx] = nav->posSig[i];
-            velSigData[i][idx] = nav->velSig[i];
-            accSigData[i][idx] = nav->accSig[i];
+            tab.col(i)[idx] = nav->pos[i];
+            tab.col(i+3)[idx] = nav->vel[i];
+            tab.col(i+6)[idx] = nav->acc[i];
+            tab.col(i+9)[idx] = nav->posSig[i];
+            tab.col(i+12)[idx] = nav->velSig[i];
+            tab.col(i+15)[idx] = nav->accSig[i];
             haveVel |= (nav->vel[i] != 0.0);
             haveAcc |= (nav->acc[i] != 0.0);
          }
       }
-      double dt = when - firstTime, err;
+      double dt = when - firstTime;
+      unsigned Nhi = halfOrderPos, Nlow = halfOrderPos-1;
       OrbitDataSP3 *osp3 = dynamic_cast<OrbitDataSP3*>(navData.get());
       DEBUGTRACE(printTime(when, "when=%Y/%02m/%02d %02H:%02M:%02S"));
       DEBUGTRACE(printTime(firstTime, "firstTime=%Y/%02m/%02d %02H:%02M:%02S"));
       DEBUGTRACE(setprecision(20) << "  dt=" << dt);
       if (DebugTrace::enabled)
       {
-         for (unsigned i = 0; i < tdata.size(); i++)
+         for (unsigned i = 0; i < tab.npts; i++)
          {
-            DEBUGTRACE("i=" << i << " times=" << tdata[i]);
-            DEBUGTRACE("P=" << posData[0][i] << " " << posData[1][i] << " "
-                       << posData[2][i]);
-            DEBUGTRACE("V=" << velData[0][i] << " " << velData[1][i] << " "
-                       << velData[2][i]);
-            DEBUGTRACE("A=" << accData[0][i] << " " << accData[1][i] << " "
-                       << accData[2][i]);
+            DEBUGTRACE("i=" << i << " times=" << tab.tdata[i]);
+            DEBUGTRACE("P=" << tab.col(0)[i] << " " << tab.col(1)[i] << " "
+                       << tab.col(2)[i]);
+            DEBUGTRACE("V=" << tab.col(3)[i] << " " << tab.col(4)[i] << " "
+                       << tab.col(5)[i]);
+            DEBUGTRACE("A=" << tab.col(6)[i] << " " << tab.col(7)[i] << " "
+                       << tab.col(8)[i]);
          }
       }
       DEBUGTRACE("haveVelocity=" << haveVel << "  haveAcceleration="
                  << haveAcc);
+      tab.setPoint(dt, baryPos);
          // Interpolate XYZ position/velocity/acceleration.
       for (unsigned i = 0; i < 3; i++)
       {
+         osp3->pos[i] = tab.value(i);
          if (haveVel && haveAcc)
          {
-            osp3->pos[i] = LagrangeInterpolation(tdata,posData[i],dt,err);
-            osp3->vel[i] = LagrangeInterpolation(tdata,velData[i],dt,err);
-            osp3->acc[i] = LagrangeInterpolation(tdata,accData[i],dt,err);
-            unsigned Nhi = halfOrderPos, Nlow=halfOrderPos-1;
-            DEBUGTRACE("!isExact sigP[" << i << "][" << Nhi << "] = "
-                       << posSigData[i][Nhi]);
-            DEBUGTRACE("         sigP[" << i << "][" << Nlow << "] = "
-                       << posSigData[i][Nlow]);
-            DEBUGTRACE("         sigV[" << i << "][" << Nhi << "] = "
-                       << velSigData[i][Nhi]);
-            DEBUGTRACE("         sigV[" << i << "][" << Nlow << "] = "
-                       << velSigData[i][Nlow]);
-            DEBUGTRACE("         sigA[" << i << "][" << Nhi << "] = "
-                       << accSigData[i][Nhi]);
-            DEBUGTRACE("         sigA[" << i << "][" << Nlow << "] = "
-                       << accSigData[i][Nlow]);
+            osp3->vel[i] = tab.value(i+3);
+            osp3->acc[i] = tab.value(i+6);
             if (!isExact)
             {
-               osp3->posSig[i] = RSS(posSigData[i][halfOrderPos-1],
-                                     posSigData[i][halfOrderPos]);
-               osp3->velSig[i] = RSS(velSigData[i][halfOrderPos-1],
-                                     velSigData[i][halfOrderPos]);
-               osp3->accSig[i] = RSS(accSigData[i][halfOrderPos-1],
-                                     accSigData[i][halfOrderPos]);
-               DEBUGTRACE("1 RSS(posSigData[" << i << "][" << (halfOrderPos-1)
-                          << "],posSigData[" << i << "][" << halfOrderPos
-                          << "]) = " << osp3->posSig[i]);
+               osp3->posSig[i] = RSS(tab.col(i+9)[Nlow], tab.col(i+9)[Nhi]);
+               osp3->velSig[i] = RSS(tab.col(i+12)[Nlow],tab.col(i+12)[Nhi]);
+               osp3->accSig[i] = RSS(tab.col(i+15)[Nlow],tab.col(i+15)[Nhi]);
             }
          }
          else if (haveVel && !haveAcc)
          {
-            osp3->pos[i] = LagrangeInterpolation(tdata,posData[i],dt,err);
-            LagrangeInterpolation(tdata, velData[i], dt, osp3->vel[i],
-                                  osp3->acc[i]);
-            osp3->acc[i] *= 0.1;
-            unsigned Nhi = halfOrderPos, Nlow=halfOrderPos-1;
-            DEBUGTRACE("!isExact sigP[" << i << "][" << Nhi << "] = "
-                       << posSigData[i][Nhi]);
-            DEBUGTRACE("         sigP[" << i << "][" << Nlow << "] = "
-                       << posSigData[i][Nlow]);
-            DEBUGTRACE("         sigV[" << i << "][" << Nhi << "] = "
-                       << velSigData[i][Nhi]);
-            DEBUGTRACE("         sigV[" << i << "][" << Nlow << "] = "
-                       << velSigData[i][Nlow]);
-            DEBUGTRACE("         sigA[" << i << "][" << Nhi << "] = "
-                       << accSigData[i][Nhi]);
-            DEBUGTRACE("         sigA[" << i << "][" << Nlow << "] = "
-                       << accSigData[i][Nlow]);
+            osp3->vel[i] = tab.value(i+3);
+            osp3->acc[i] = tab.deriv(i+3) * 0.1;
             if (!isExact)
             {
-               osp3->posSig[i] = RSS(posSigData[i][halfOrderPos-1],
-                                     posSigData[i][halfOrderPos]);
-               osp3->velSig[i] = RSS(velSigData[i][halfOrderPos-1],
-                                     velSigData[i][halfOrderPos]);
+               osp3->posSig[i] = RSS(tab.col(i+9)[Nlow], tab.col(i+9)[Nhi]);
+               osp3->velSig[i] = RSS(tab.col(i+12)[Nlow],tab.col(i+12)[Nhi]);
             }
-            DEBUGTRACE("2 RSS(posSigData[" << i << "][" << (halfOrderPos-1)
-                       << "],posSigData[" << i << "][" << halfOrderPos
-                       << "]) = " << osp3->posSig[i]);
          }
          else
          {
                // have position, must derive velocity and acceleration
-            LagrangeInterpolation(tdata, posData[i], dt, osp3->pos[i],
-                                  osp3->vel[i]);
-            osp3->vel[i] *= 10000.; // km/sec to dm/sec
+            osp3->vel[i] = tab.deriv(i) * 10000.; // km/sec to dm/sec
                // PositionSatStore doesn't derive
                // acceleration in this case, near as I can
                // tell.
             if (!isExact)
             {
-               osp3->posSig[i] = RSS(posSigData[i][halfOrderPos-1],
-                                     posSigData[i][halfOrderPos]);
+               osp3->posSig[i] = RSS(tab.col(i+9)[Nlow], tab.col(i+9)[Nhi]);
             }
-            DEBUGTRACE("3 RSS(posSigData[" << i << "][" << (halfOrderPos-1)
-                       << "],posSigData[" << i << "][" << halfOrderPos
-                       << "]) = " << osp3->posSig[i]);
          }
+         DEBUGTRACE("sigP[" << i << "] = " << osp3->posSig[i]
+                    << "  sigV[" << i << "] = " << osp3->velSig[i]
+                    << "  sigA[" << i << "] = " << osp3->accSig[i]);
       } // for (unsigned i = 0; i < 3; i++)
       if (DebugTrace::enabled)
       {
@@ -1185,10 +1354,13 @@ namespace gnsstk
       DEBUGTRACE("start interpolating clock, distance = "
                  << std::distance(ti1,ti3));
       unsigned Nhi = halfOrderClk, Nlow = halfOrderClk-1;
-      std::vector<double> tdata(2*halfOrderClk),
-         biasData(2*halfOrderClk), biasSigData(2*halfOrderClk),
-         driftData(2*halfOrderClk), driftSigData(2*halfOrderClk),
-         drRateData(2*halfOrderClk), drRateSigData(2*halfOrderClk);
+         // The table columns are bias, drift and drift rate (0-2),
+         // followed by the corresponding sigmas (3-5).
+      SP3InterpTable tab(2*halfOrderClk, 6);
+      const double *tdata = tab.tdata;
+      const double *biasData = tab.col(0), *driftData = tab.col(1),
+         *drRateData = tab.col(2), *biasSigData = tab.col(3),
+         *driftSigData = tab.col(4), *drRateSigData = tab.col(5);
       CommonTime firstTime(ti1->second->timeStamp);
          // This flag is only used to decide whether to compute sigmas
          // or use existing ones.  It is expected that for exact time
@@ -1201,26 +1373,29 @@ namespace gnsstk
       for (ti2 = ti1, idx=0; ti2 != ti3; ++ti2, ++idx)
       {
          DEBUGTRACE("idx=" << idx);
-         tdata[idx] = ti2->second->timeStamp - firstTime;
+         tab.tdata[idx] = ti2->second->timeStamp - firstTime;
          if ((idx == halfOrderClk) && (ti2->second->timeStamp == when))
             isExact = true;
          OrbitDataSP3 *nav = dynamic_cast<OrbitDataSP3*>(
             ti2->second.get());
          DEBUGTRACE("nav=" << nav);
-         // ti2->second->dump(cerr, DumpDetail::Full);
-         biasData[idx] = nav->clkBias;
-         driftData[idx] = nav->clkDrift;
-         drRateData[idx] = nav->clkDrRate;
-         biasSigData[idx] = nav->biasSig;
-         driftSigData[idx] = nav->driftSig;
-         drRateSigData[idx] = nav->drRateSig;
+         tab.col(0)[idx] = nav->clkBias;
+         tab.col(1)[idx] = nav->clkDrift;
+         tab.col(2)[idx] = nav->clkDrRate;
+         tab.col(3)[idx] = nav->biasSig;
+         tab.col(4)[idx] = nav->driftSig;
+         tab.col(5)[idx] = nav->drRateSig;
          haveDrift |= (nav->clkDrift != 0.0);
          haveDriftRate |= (nav->clkDrRate != 0.0);
       }
-      double dt = when - firstTime, err, slope,
+      double dt = when - firstTime, slope,
          slopedt = tdata[Nhi]-tdata[Nlow];
       OrbitDataSP3 *osp3 = dynamic_cast<OrbitDataSP3*>(navData.get());
       DEBUGTRACE(setprecision(20) << "  dt=" << dt);
+      if (interpType == ClkInterpType::Lagrange)
+      {
+         tab.setPoint(dt, baryClk);
+      }
       gnsstk::InvalidRequest unkType(
          "Clock interpolation type " +
          StringUtils::asString(static_cast<int>(interpType)) +
@@ -1230,8 +1405,8 @@ namespace gnsstk
          switch (interpType)
          {
             case ClkInterpType::Lagrange:
-               osp3->clkBias = LagrangeInterpolation(tdata,biasData,dt,err);
-               osp3->clkDrift = LagrangeInterpolation(tdata,driftData,dt,err);
+               osp3->clkBias = tab.value(0);
+               osp3->clkDrift = tab.value(1);
                break;
             case ClkInterpType::Linear:
                slope = (biasData[Nhi]-biasData[Nlow]) / slopedt;
@@ -1259,8 +1434,8 @@ namespace gnsstk
          switch (interpType)
          {
             case ClkInterpType::Lagrange:
-               LagrangeInterpolation(tdata, biasData, dt, osp3->clkBias,
-                                     osp3->clkDrift);
+               osp3->clkBias = tab.value(0);
+               osp3->clkDrift = tab.deriv(0);
                break;
             case ClkInterpType::Linear:
                slope = (biasData[Nhi]-biasData[Nlow]) / slopedt;
@@ -1290,7 +1465,7 @@ namespace gnsstk
          switch (interpType)
          {
             case ClkInterpType::Lagrange:
-               osp3->clkDrRate = LagrangeInterpolation(tdata,drRateData,dt,err);
+               osp3->clkDrRate = tab.value(2);
                break;
             case ClkInterpType::Linear:
                slope = (drRateData[Nhi]-drRateData[Nlow]) / slopedt;
@@ -1312,7 +1487,7 @@ namespace gnsstk
          switch (interpType)
          {
             case ClkInterpType::Lagrange:
-               LagrangeInterpolation(tdata,driftData,dt,err,osp3->clkDrRate);
+               osp3->clkDrRate = tab.deriv(1);
                break;
             case ClkInterpType::Linear:
                osp3->clkDrRate = (driftData[Nhi]-driftData[Nlow]) / slopedt;
@@ -1383,10 +1558,12 @@ namespace gnsstk
    void SP3NavDataFactory ::
    useRinexClockData(bool useRC)
    {
+      ReadWriteLock::WriteGuard guard(storeLock);
       if (useRC == !useSP3clock)
          return;
       useSP3clock = !useRC;
-      clearClock();
+      storeChanged();
+      data.erase(NavMessageType::Clock);
    }
 
 
@@ -1397,6 +1574,7 @@ namespace gnsstk
          halfOrderClk = (order+1)/2;
       else
          halfOrderClk = 1;
+      setInterpWeights();
    }
 
 
@@ -1405,6 +1583,7 @@ namespace gnsstk
    {
       interpType = ClkInterpType::Lagrange;
       halfOrderClk = 5;
+      setInterpWeights();
    }
 
 
@@ -1413,6 +1592,15 @@ namespace gnsstk
    {
       interpType = ClkInterpType::Linear;
       halfOrderClk = 1;
+      setInterpWeights();
+   }
+
+
+   void SP3NavDataFactory ::
+   setInterpWeights()
+   {
+      SP3InterpTable::regular(2*halfOrderPos, baryPos);
+      SP3InterpTable::regular(2*halfOrderClk, baryClk);
    }
 
 
@@ -1436,6 +1624,7 @@ namespace gnsstk
    nomTimeStep(const NavMessageID& nmid) const
    {
       DEBUGTRACE_FUNCTION();
+      ReadWriteLock::ReadGuard guard(storeLock);
       auto dataIt = data.find(nmid.messageType);
          // map delta time * 100 to a count
       std::map<long,unsigned long> stepCount;
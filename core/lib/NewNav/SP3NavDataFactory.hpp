@@ -165,7 +165,11 @@ namespace gnsstk
          /** Clear the clock dataset only, meaning remove all clock
           * data from the internal store. */
       void clearClock()
-      { data.erase(NavMessageType::Clock); }
+      {
+         ReadWriteLock::WriteGuard guard(storeLock);
+         storeChanged();
+         data.erase(NavMessageType::Clock);
+      }
 
          /** Choose to load the clock data tables from RINEX clock
           * files. This will clear the clock store if the state
@@ -296,7 +300,7 @@ namespace gnsstk
          /** Set the interpolation order for the position table; it is
           * forced to be even. */
       void setPositionInterpOrder(unsigned int order)
-      { halfOrderPos = (order+1)/2; }
+      { halfOrderPos = (order+1)/2; setInterpWeights(); }
 
          /** Get current interpolation order for the clock data
           * (meaningless if the interpolation type is linear). */
@@ -424,6 +428,10 @@ namespace gnsstk
           * @return true if successful, false if the system is unsupported. */
       static bool setSignal(const SatID& sat, NavMessageID& signal);
 
+         /** Recompute baryPos and baryClk to match the current
+          * position and clock interpolation orders. */
+      void setInterpWeights();
+
          /** Compute the nominal timestep of the data for the given signal.
           * @return 0 if the signal is not found, otherwise return the
           *   nominal timestep in seconds. */
@@ -491,6 +499,14 @@ namespace gnsstk
           * interest. */
       unsigned halfOrderClk;
 
+         /** Barycentric Lagrange weights for 2*halfOrderPos equally
+          * spaced nodes, in units of the node spacing.  Used to avoid
+          * recomputing the weights for regular SP3 grids. */
+      std::vector<double> baryPos;
+
+         /// Barycentric Lagrange weights for 2*halfOrderClk nodes.
+      std::vector<double> baryClk;
+
          /** Flag indicating whether the clock store contains data
           * from SP3 (true, the default) or RINEX clock (false)
           * files */
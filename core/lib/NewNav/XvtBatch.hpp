@@ -0,0 +1,101 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+#ifndef GNSSTK_XVTBATCH_HPP
+#define GNSSTK_XVTBATCH_HPP
+
+#include <cstdint>
+#include <vector>
+#include "Xvt.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup NavFactory
+      //@{
+
+      /** Position, velocity and clock data for a batch of satellites
+       * and/or times, stored as a structure of arrays.  This is the
+       * output of the batch getXvt() methods of OrbitDataKepler and
+       * NavLibrary.  Element i of each array holds the value that
+       * Xvt::x[0], Xvt::x[1], etc. would hold for the i'th
+       * computation. */
+   class XvtBatch
+   {
+   public:
+         /// Resize all the arrays to n elements.
+      void resize(size_t n);
+
+         /// @return The number of elements in the batch.
+      size_t size() const
+      { return x.size(); }
+
+         /** Copy a single element of the batch into an Xvt object.
+          * @param[in] i The index of the element to get.
+          * @param[out] xvt The Xvt to store element i in.
+          * @return the value of valid[i]. */
+      bool getXvt(size_t i, Xvt& xvt) const;
+
+         /** Copy an Xvt object into a single element of the batch.
+          * @param[in] i The index of the element to set.
+          * @param[in] xvt The Xvt to store in element i.
+          * @param[in] ok The value to store in valid[i]. */
+      void setXvt(size_t i, const Xvt& xvt, bool ok);
+
+      std::vector<double> x;         ///< ECEF X position (m).
+      std::vector<double> y;         ///< ECEF Y position (m).
+      std::vector<double> z;         ///< ECEF Z position (m).
+      std::vector<double> vx;        ///< ECEF X velocity (m/s).
+      std::vector<double> vy;        ///< ECEF Y velocity (m/s).
+      std::vector<double> vz;        ///< ECEF Z velocity (m/s).
+      std::vector<double> clkbias;   ///< Satellite clock bias (s).
+      std::vector<double> clkdrift;  ///< Satellite clock drift (s/s).
+      std::vector<double> relcorr;   ///< Relativity correction (s).
+         /// Health status of the satellite.
+      std::vector<Xvt::HealthStatus> health;
+         /// Reference frame of the position and velocity.
+      std::vector<ReferenceFrame> frame;
+         /** Non-zero if the element was successfully computed.  The
+          * other arrays are undefined for elements that were not. */
+      std::vector<uint8_t> valid;
+   };
+
+      //@}
+
+}
+
+#endif // GNSSTK_XVTBATCH_HPP
@@ -41,6 +41,7 @@
 /// given data, or a solution including editing via a RAIM algorithm.
 
 #include "MathBase.hpp"
+#include "FixedMatrix.hpp"
 #include "PRSolution.hpp"
 #include "GPSEllipsoid.hpp"
 #include "GlobalTropModel.hpp"
@@ -60,6 +61,29 @@ namespace gnsstk
    ostream& operator<<(ostream& os, const WtdAveStats& was)
       { was.dump(os,was.getMessage()); return os;}
 
+   // -------------------------------------------------------------------------
+   // Invert the (small, dim x dim) normal matrix by SVD in fixed-size storage,
+   // avoiding the heap for the 4 to 8 unknowns of any practical solution.
+   // Throws MatrixException as inverseSVD() does.
+   template <size_t N>
+   static void fixedInverseSVD(Matrix<double>& C)
+   {
+      FixedMatrix<double,N,N> F(C);
+      C = inverseSVD(F);
+   }
+
+   static void normalInverse(Matrix<double>& C)
+   {
+      switch(C.rows()) {
+         case 4: fixedInverseSVD<4>(C); break;
+         case 5: fixedInverseSVD<5>(C); break;
+         case 6: fixedInverseSVD<6>(C); break;
+         case 7: fixedInverseSVD<7>(C); break;
+         case 8: fixedInverseSVD<8>(C); break;
+         default: C = inverseSVD(C); break;
+      }
+   }
+
    // -------------------------------------------------------------------------
    // Prepare for the autonomous solution by computing direction cosines,
    // corrected pseudoranges and satellite system.
@@ -271,8 +295,8 @@ namespace gnsstk
 
          // -----------------------------------------------------------
          // define for computation
-         Vector<double> CRange(Nsvs),dX(dim);
-         Matrix<double> P(Nsvs,dim,0.0),PT,G(dim,Nsvs),PG(Nsvs,Nsvs),Rotation;
+         Vector<double> CRange(Nsvs),dX(dim),PG(Nsvs);
+         Matrix<double> P(Nsvs,dim,0.0),PT,G(dim,Nsvs),Rotation;
          Triple dirCos;
          Xvt SV,RX;
 
@@ -415,12 +439,12 @@ namespace gnsstk
             PT = transpose(P);
 
             // weight matrix = measurement covariance inverse
-            if(invMC.rows() > 0) Covariance = PT * iMC * P;
-            else                 Covariance = PT * P;
+            if(invMC.rows() > 0) Covariance = AtWA(P, iMC);
+            else                 Covariance = AtA(P);
 
             // invert using SVD
             try {
-               Covariance = inverseSVD(Covariance);
+               normalInverse(Covariance);
             }
             catch(MatrixException& sme) { return -2; }
             LOG(DEBUG) << "InvCov (" << Covariance.rows() << "x" << Covariance.cols()
@@ -430,10 +454,13 @@ namespace gnsstk
             if(invMC.rows() > 0) G = Covariance * PT * iMC;
             else                 G = Covariance * PT;
 
-            // PG is used for Slope computation
-            PG = P * G;
-            LOG(DEBUG) << "PG (" << PG.rows() << "x" << PG.cols()
-               << ")\n" << fixed << setprecision(4) << PG;
+            // diagonal of P*G, used for Slope computation
+            for(i=0; i<PG.size(); i++) {
+               PG(i) = 0.0;
+               for(k=0; k<int(dim); k++) PG(i) += P(i,k)*G(k,i);
+            }
+            LOG(DEBUG) << "PG diagonal (" << PG.size() << ") "
+               << fixed << setprecision(4) << PG;
 
             n_iterate++;                        // increment number iterations
 
@@ -479,12 +506,12 @@ namespace gnsstk
          if(iret == 0) for(j=0,i=0; i<Sats.size(); i++) {
             if(Sats[i].id <= 0) continue;
 
-            // NB when one (few) sats have their own clock, PG(j,j) = 1 (nearly 1)
+            // NB when one (few) sats have their own clock, PG(j) = 1 (nearly 1)
             // and slope is inf (large)
-            if(::fabs(1.0-PG(j,j)) < 1.e-8) continue;
+            if(::fabs(1.0-PG(j)) < 1.e-8) continue;
 
             for(int k=0; k<dim; k++) Slopes(j) += G(k,j)*G(k,j); // TD dim=4 here?
-            Slopes(j) = SQRT(Slopes(j)*double(n-dim)/(1.0-PG(j,j)));
+            Slopes(j) = SQRT(Slopes(j)*double(n-dim)/(1.0-PG(j)));
             if(Slopes(j) > MaxSlope) MaxSlope = Slopes(j);
             j++;
          }
@@ -536,6 +563,202 @@ namespace gnsstk
    }  // end PRSolution::RAIMComputeUnweighted()
 
 
+   // -------------------------------------------------------------------------
+   // Subset search for IncrementalRAIM. The all-satellite solution is
+   // linearized once; removing satellite i from a least squares fit with
+   // covariance C, partials P, weights w and post-fit residuals r is then the
+   // rank-one (Sherman-Morrison) downdate
+   //    u = C*p_i,  h = w_i*p_i.u,  dX = -u*w_i*r_i/(1-h),
+   //    r -= P*dX,  C += u*u^T * w_i/(1-h)
+   // which costs O(dim^2 + n*dim), against a full iterated solution per subset.
+   class PRSolution::RAIMSearch
+   {
+   public:
+      /// one subset of satellites to reject
+      struct Subset
+      {
+         /// indexes (into the rows of the all-satellite fit) of rejected sats
+         vector<int> reject;
+         /// predicted RMS residual of the remaining satellites; < 0 if the
+         /// downdate was singular and there is no prediction
+         double RMS;
+         /// sort by predicted RMS, with the singular subsets last
+         bool operator<(const Subset& right) const
+         {
+            if(RMS < 0.0) return false;
+            if(right.RMS < 0.0) return true;
+            return RMS < right.RMS;
+         }
+      };
+
+      RAIMSearch() : n(0), dim(0) {}
+
+      /// Linearize about the all-satellite solution, given its partials
+      /// (n x dim), inverse measurement covariance (n x n, must be diagonal,
+      /// or empty for no weighting), residuals (n) and covariance (dim x dim).
+      /// @return false if the weights are correlated, and no search is possible
+      bool setup(const Matrix<double>& P, const Matrix<double>& iMC,
+                 const Vector<double>& Resids, const Matrix<double>& Cov)
+      {
+         size_t i,j,k;
+         n = P.rows();
+         dim = P.cols();
+         W = vector<double>(n,1.0);
+         if(iMC.rows() > 0) {
+            for(i=0; i<n; i++) {
+               for(j=0; j<n; j++)
+                  if(i != j && iMC(i,j) != 0.0) return false;
+               W[i] = iMC(i,i);
+            }
+         }
+
+         U.resize(dim);
+         DX.resize(dim);
+         Part = vector<double>(n*dim);
+         for(i=0; i<n; i++)
+            for(j=0; j<dim; j++)
+               Part[i*dim+j] = P(i,j);
+
+         // Resids are the residuals before the last (converged) update;
+         // make them the post-fit residuals of the linear problem.
+         vector<double> b(dim,0.0),dX(dim,0.0);
+         for(i=0; i<n; i++)
+            for(j=0; j<dim; j++)
+               b[j] += Part[i*dim+j]*W[i]*Resids(i);
+         for(j=0; j<dim; j++)
+            for(k=0; k<dim; k++)
+               dX[j] += Cov(j,k)*b[k];
+
+         Covs.assign(1, vector<double>(dim*dim));
+         Res.assign(1, vector<double>(n));
+         for(j=0; j<dim; j++)
+            for(k=0; k<dim; k++)
+               Covs[0][j*dim+k] = Cov(j,k);
+         for(i=0; i<n; i++) {
+            Res[0][i] = Resids(i);
+            for(j=0; j<dim; j++)
+               Res[0][i] -= Part[i*dim+j]*dX[j];
+         }
+
+         // visit the satellites in order of decreasing normalized residual,
+         // so the likeliest outliers lead the search
+         vector<double> nres(n,0.0);
+         Order.resize(n);
+         for(i=0; i<n; i++) {
+            Order[i] = i;
+            double h(leverage(0,i));
+            nres[i] = (1.0-h > 1.e-10 ? ::fabs(Res[0][i])*SQRT(W[i]/(1.0-h))
+                                      : 0.0);
+         }
+         stable_sort(Order.begin(), Order.end(),
+                     [&nres](int a, int b) { return nres[a] > nres[b]; });
+
+         return true;
+      }
+
+      /// Fill Subsets with every way of rejecting nrej satellites, each with
+      /// its predicted RMS residual, sorted by increasing predicted RMS.
+      /// Subsets is left empty if too few satellites would remain.
+      void findSubsets(int nrej, vector<Subset>& Subsets)
+      {
+         Subsets.clear();
+         if(nrej <= 0 || n < dim + nrej) return;
+         Covs.resize(nrej+1, vector<double>(dim*dim));
+         Res.resize(nrej+1, vector<double>(n));
+         Path.resize(nrej);
+         Singular.assign(nrej+1, false);
+         descend(0, 0, nrej, Subsets);
+         stable_sort(Subsets.begin(), Subsets.end());
+      }
+
+   private:
+      /// w_i * p_i^T C p_i at the given depth of the search
+      double leverage(int depth, int i) const
+      {
+         const double *p(&Part[i*dim]), *C(&Covs[depth][0]);
+         double h(0.0);
+         for(size_t j=0; j<dim; j++) {
+            double u(0.0);
+            for(size_t k=0; k<dim; k++) u += C[j*dim+k]*p[k];
+            h += p[j]*u;
+         }
+         return W[i]*h;
+      }
+
+      /// Downdate the fit at depth by removing satellite i, giving the fit at
+      /// depth+1. Return false if the remaining geometry is singular.
+      bool downdate(int depth, int i)
+      {
+         const double *p(&Part[i*dim]), *C(&Covs[depth][0]), *r(&Res[depth][0]);
+         double *C1(&Covs[depth+1][0]), *r1(&Res[depth+1][0]);
+         double *u(&U[0]), *dX(&DX[0]), h(0.0);
+         size_t j,k;
+         for(j=0; j<dim; j++) {
+            u[j] = 0.0;
+            for(k=0; k<dim; k++) u[j] += C[j*dim+k]*p[k];
+            h += p[j]*u[j];
+         }
+         h *= W[i];
+         if(1.0-h < 1.e-10) return false;
+
+         const double f(W[i]/(1.0-h));
+         for(j=0; j<dim; j++) {
+            dX[j] = -u[j]*f*r[i];
+            for(k=0; k<dim; k++) C1[j*dim+k] = C[j*dim+k] + u[j]*u[k]*f;
+         }
+         for(j=0; j<n; j++) {
+            r1[j] = r[j];
+            for(k=0; k<dim; k++) r1[j] -= Part[j*dim+k]*dX[k];
+         }
+         return true;
+      }
+
+      /// depth-first enumeration of the subsets, sharing the downdates of
+      /// common prefixes; below a singular downdate no predictions are made.
+      void descend(int depth, size_t first, int nrej, vector<Subset>& Subsets)
+      {
+         if(depth == nrej) {
+            Subset sub;
+            sub.reject = Path;
+            sub.RMS = -1.0;
+            if(!Singular[depth]) {
+               double sum(0.0);
+               const double *r(&Res[depth][0]);
+               for(size_t i=0; i<n; i++) {
+                  if(find(Path.begin(), Path.end(), int(i)) != Path.end())
+                     continue;
+                  sum += r[i]*r[i];
+               }
+               sub.RMS = SQRT(sum/double(n-nrej));
+            }
+            Subsets.push_back(sub);
+            return;
+         }
+
+         for(size_t k=first; k+(nrej-depth) <= n; k++) {
+            Path[depth] = Order[k];
+            Singular[depth+1] = (Singular[depth] || !downdate(depth, Order[k]));
+            descend(depth+1, k+1, nrej, Subsets);
+         }
+      }
+
+      /// number of satellites and of unknowns in the all-satellite fit
+      size_t n, dim;
+      /// partials (row major, n x dim) and weights of the all-satellite fit
+      vector<double> Part, W;
+      /// satellite indexes in order of decreasing normalized residual
+      vector<int> Order;
+      /// covariance (row major) and residuals at each depth of the search
+      vector< vector<double> > Covs, Res;
+      /// satellites rejected along the current path of the search
+      vector<int> Path;
+      /// scratch space for downdate()
+      vector<double> U, DX;
+      /// true at each depth below a singular downdate
+      vector<bool> Singular;
+
+   }; // end class PRSolution::RAIMSearch
+
    // -------------------------------------------------------------------------
    // Compute a solution using RAIM.
    int PRSolution::RAIMCompute(const CommonTime& Tr,
@@ -569,6 +792,7 @@ namespace gnsstk
          Valid = false;
          currTime = Tr;
          TropFlag = SlopeFlag = RMSFlag = false;
+         NSubsets = NFullSolutions = 0;
 
          // ----------------------------------------------------------------
          // fill the SVP matrix, and use it for every solution
@@ -628,17 +852,43 @@ namespace gnsstk
          // stage is the number of satellites to reject.
          int stage(0);
 
+         // IncrementalRAIM: search built from the all-satellite solution, and
+         // the subsets of the current stage in order of predicted RMS.
+         RAIMSearch Search;
+         bool haveSearch(false);
+         vector<RAIMSearch::Subset> Subsets;
+
          do {
             // compute all the combinations of N satellites taken stage at a time
             Combinations Combo(N,stage);
 
+            // or, if possible, only the promising ones, in order
+            size_t isub(0);
+            bool incremental(stage > 0 && haveSearch);
+            if(incremental) {
+               Search.findSubsets(stage, Subsets);
+               NSubsets += Subsets.size();
+               incremental = !Subsets.empty();
+               LOG(DEBUG) << " RAIM: stage " << stage << " predicted "
+                  << Subsets.size() << " subsets";
+            }
+
             // compute a solution for each combination of marked satellites
             do {
                // Mark the satellites for this combination
                Sats = SaveSats;
-               for(i=0; i<GoodIndexes.size(); i++)
-                  if(Combo.isSelected(i))
-                     Sats[GoodIndexes[i]].id = -::abs(Sats[GoodIndexes[i]].id);
+               if(incremental) {
+                  const vector<int>& reject(Subsets[isub].reject);
+                  for(i=0; i<reject.size(); i++)
+                     Sats[GoodIndexes[reject[i]]].id =
+                        -::abs(Sats[GoodIndexes[reject[i]]].id);
+               }
+               else {
+                  for(i=0; i<GoodIndexes.size(); i++)
+                     if(Combo.isSelected(i))
+                        Sats[GoodIndexes[i]].id = -::abs(Sats[GoodIndexes[i]].id);
+                  NSubsets++;
+               }
 
                if(LOGlevel >= ConfigureLOG::Level("DEBUG")) {
                   ostringstream oss;
@@ -661,6 +911,7 @@ namespace gnsstk
                //       -4  no ephemeris
                iret = SimplePRSolution(Tr, Sats, SVP, invMC, pTropModel,
                        MaxNIterations, ConvergenceLimit, Resids, Slopes);
+               NFullSolutions++;
 
                LOG(DEBUG) << " RAIM: SimplePRS returns " << iret;
                if(iret <= 0 && iret > BestIret) BestIret = iret;
@@ -716,7 +967,23 @@ namespace gnsstk
                if(stage==0 && RMSResidual < RMSLimit)
                   break;
 
-            } while(Combo.Next() != -1);  // get the next combinations and repeat
+               // linearize the all-satellite solution for the later stages
+               if(stage==0 && iret==0 && IncrementalRAIM && NSatsReject != 0)
+                  haveSearch = Search.setup(Partials, invMeasCov, Resids,
+                                            Covariance);
+
+               // quit when no remaining subset is predicted to do better
+               if(incremental && BestRMS >= 0.0 && isub+1 < Subsets.size()) {
+                  const double nextRMS(Subsets[isub+1].RMS);
+                  if(nextRMS < 0.0 || nextRMS > (1.0+RAIMPruneTolerance)*BestRMS) {
+                     LOG(DEBUG) << " RAIM: pruned " << Subsets.size()-isub-1
+                        << " subsets";
+                     break;
+                  }
+               }
+
+            } while(incremental ? ++isub < Subsets.size()
+                                : Combo.Next() != -1);  // next combination
 
             // end of the stage
             if(BestRMS > 0.0 && BestRMS < RMSLimit) {          // success
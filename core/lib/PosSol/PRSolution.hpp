@@ -219,6 +219,8 @@ namespace gnsstk
        PRSolution() : RMSLimit(6.5),
                       SlopeLimit(1000.),
                       NSatsReject(-1),
+                      IncrementalRAIM(false),
+                      RAIMPruneTolerance(0.01),
                       MaxNIterations(10),
                       ConvergenceLimit(3.e-7),
                       hasMemory(true),
@@ -228,6 +230,7 @@ namespace gnsstk
          {
             was.reset();
             APSolution = Vector<double>(4,0.0);
+            NSubsets = NFullSolutions = 0;
          }
 
       /// Return the status of solution
@@ -247,6 +250,24 @@ namespace gnsstk
       /// to 0 before calling RAIMCompute().
       int NSatsReject;
 
+      /// If true, RAIMCompute() screens the subsets of each RAIM stage (after the
+      /// first) with rank-one downdates of the all-satellite least squares fit,
+      /// instead of iterating a full solution for every subset. Satellites are
+      /// visited in order of decreasing normalized residual, subsets that cannot
+      /// be solved are pruned, and only the subsets whose predicted RMS residual
+      /// could still beat the best one found are re-solved with
+      /// SimplePRSolution(). This requires a diagonal (or empty) invMC;
+      /// otherwise the exhaustive search is used. Default is false.
+      bool IncrementalRAIM;
+
+      /// Relative tolerance of the IncrementalRAIM pruning. The remaining
+      /// subsets of a stage are skipped once the next predicted RMS residual
+      /// exceeds (1+RAIMPruneTolerance) times the best RMS residual found. The
+      /// predictions come from the linearized all-satellite fit, and differ
+      /// slightly from the iterated solutions; a larger value solves more
+      /// subsets, and 0 trusts the predictions exactly. Default is 0.01.
+      double RAIMPruneTolerance;
+
       /// Maximum number of iterations allowed in the linearized least squares
       /// algorithm.
       int MaxNIterations;
@@ -348,6 +369,14 @@ namespace gnsstk
       /// the number of good satellites used in the final computation
       int Nsvs;
 
+      /// the number of satellite subsets evaluated by the last call to
+      /// RAIMCompute(), whether by a full solution or by a downdate.
+      int NSubsets;
+
+      /// the number of subsets, out of NSubsets, for which RAIMCompute()
+      /// called SimplePRSolution(); equal to NSubsets unless IncrementalRAIM.
+      int NFullSolutions;
+
       /// if true, the returned solution may be degraded because the tropospheric
       /// correction was not applied to one or more satellites; applies after calls to
       /// both SimplePRSolution() and RAIMCompute().
@@ -647,6 +676,10 @@ namespace gnsstk
       /// empty vector used to detect default
       GNSSTK_EXPORT static const Vector<double> PRSNullVector;
 
+      /// Subset search by rank-one downdates, used by RAIMCompute() when
+      /// IncrementalRAIM is set; defined in PRSolution.cpp.
+      class RAIMSearch;
+
    }; // end class PRSolution
 
    //@}
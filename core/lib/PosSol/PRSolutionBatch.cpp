@@ -0,0 +1,587 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file PRSolutionBatch.cpp
+/// Compute RAIM pseudorange solutions for many independent epochs in
+/// parallel, using preallocated workspaces.
+
+#include <thread>
+#include "MiscMath.hpp"
+#include "PRSolutionBatch.hpp"
+#include "ThreadGroup.hpp"
+#include "GPSEllipsoid.hpp"
+#include "GlobalTropModel.hpp"
+#include "Combinations.hpp"
+#include "TimeString.hpp"
+
+using namespace std;
+
+namespace gnsstk
+{
+   // -------------------------------------------------------------------------
+   /// Per-thread storage for PRSolutionBatch. The buffers only grow, so once
+   /// they fit the largest epoch no further allocation takes place.
+   /// Matrices are stored row-major in plain vectors.
+   class PRSolutionBatch::Workspace
+   {
+   public:
+      /// Make sure the buffers fit nsat satellites and dim unknowns.
+      void reserve(size_t nsat, size_t dim)
+      {
+         if(P.size() < nsat*dim) {
+            P.resize(nsat*dim);
+            WP.resize(nsat*dim);
+            G.resize(nsat*dim);
+         }
+         if(weighted && W.size() < nsat*nsat) W.resize(nsat*nsat);
+         if(resid.size() < nsat) resid.resize(nsat);
+         if(slopes.size() < nsat) slopes.resize(nsat);
+         if(cov.size() < dim*dim) {
+            cov.resize(dim*dim);
+            bestCov.resize(dim*dim);
+         }
+         if(sol.size() < dim) {
+            sol.resize(dim);
+            dX.resize(dim);
+            bestSol.resize(dim);
+            chol.resize(dim);
+         }
+      }
+
+      /// trop model owned by this thread
+      shared_ptr<TropModel> trop;
+      /// satellite positions and corrected ranges from PreparePRSolution()
+      Matrix<double> SVP;
+      /// satellites as marked by PreparePRSolution()
+      vector<SatID> saveSats;
+      /// satellites as marked for the current RAIM subset
+      vector<SatID> sats;
+      /// indexes into sats of the satellites currently in use
+      vector<size_t> active;
+      /// for each active satellite, the index of its clock in the solution
+      vector<size_t> clkIndex;
+      /// systems in the current solution, in allowedGNSS order
+      vector<SatelliteSystem> currGNSS;
+      /// true if the epoch has a measurement covariance
+      bool weighted;
+      /// partials (n x dim), W*partials (n x dim), generalized inverse (dim x n)
+      vector<double> P, WP, G;
+      /// inverse measurement covariance for the active satellites (n x n)
+      vector<double> W;
+      /// residuals and slopes, one per active satellite
+      vector<double> resid, slopes;
+      /// covariance (dim x dim), solution, update, Cholesky diagonal
+      vector<double> cov, sol, dX, chol;
+      /// output of simpleSolve()
+      double rms, maxSlope, convergence;
+      int nIterations;
+      bool tropFlag;
+
+      /// the best RAIM solution so far
+      vector<double> bestCov, bestSol;
+      vector<SatID> bestSats;
+      vector<SatelliteSystem> bestGNSS;
+   };
+
+
+   // -------------------------------------------------------------------------
+   /// Replace the symmetric positive definite n x n matrix A (row-major) by
+   /// its inverse, using the Cholesky decomposition A = L*LT.
+   /// @param A matrix to invert, only the lower triangle is read on input.
+   /// @param d workspace of length n.
+   /// @param n dimension.
+   /// @return false if A is singular (not positive definite).
+   static bool choleskyInverse(double *A, double *d, size_t n)
+   {
+      size_t i,j,k;
+      double scale(0.0);
+      for(i=0; i<n; i++)
+         if(A[i*n+i] > scale) scale = A[i*n+i];
+      if(scale <= 0.0) return false;
+
+      // factor: L overwrites the lower triangle, with its diagonal in d
+      for(j=0; j<n; j++) {
+         double s(A[j*n+j]);
+         for(k=0; k<j; k++) s -= A[j*n+k]*A[j*n+k];
+         if(s <= scale * 1.e-14) return false;
+         d[j] = ::sqrt(s);
+         A[j*n+j] = d[j];
+         for(i=j+1; i<n; i++) {
+            s = A[i*n+j];
+            for(k=0; k<j; k++) s -= A[i*n+k]*A[j*n+k];
+            A[i*n+j] = s/d[j];
+         }
+      }
+
+      // invert L in place (lower triangle)
+      for(j=0; j<n; j++) {
+         A[j*n+j] = 1.0/d[j];
+         for(i=j+1; i<n; i++) {
+            double s(0.0);
+            for(k=j; k<i; k++) s -= A[i*n+k]*A[k*n+j];
+            A[i*n+j] = s/d[i];
+         }
+      }
+
+      // inverse(A) = inverse(L)T * inverse(L); fill the upper triangle first
+      // since the lower still holds inverse(L). The diagonal element (i,i) is
+      // no longer needed once row i is reached.
+      for(i=0; i<n; i++) {
+         for(j=i; j<n; j++) {
+            double s(0.0);
+            for(k=j; k<n; k++) s += A[k*n+i]*A[k*n+j];
+            A[i*n+j] = s;
+         }
+      }
+      for(i=0; i<n; i++)
+         for(j=0; j<i; j++)
+            A[i*n+j] = A[j*n+i];
+
+      return true;
+   }
+
+
+   // -------------------------------------------------------------------------
+   PRSolutionBatch::PRSolutionBatch(const PRSolution& cfg,
+                                    const TropFactory& tf,
+                                    unsigned nThreads)
+      : config(cfg), tropFactory(tf), numThreads(nThreads)
+   {
+      if(config.allowedGNSS.size() == 0) {
+         InvalidParameter e("Must define systems vector allowedGNSS before processing");
+         GNSSTK_THROW(e);
+      }
+      if(!tropFactory) {
+         InvalidParameter e("Undefined tropospheric model factory");
+         GNSSTK_THROW(e);
+      }
+      if(numThreads == 0) numThreads = thread::hardware_concurrency();
+      if(numThreads == 0) numThreads = 1;
+      // epochs are independent, so there is no memory between them
+      config.hasMemory = false;
+   }
+
+
+   // -------------------------------------------------------------------------
+   void PRSolutionBatch::solve(const vector<Epoch>& epochs, NavLibrary& eph,
+                               vector<Result>& results, NavSearchOrder order)
+      const
+   {
+      results.resize(epochs.size());
+      size_t nThreads(numThreads < epochs.size() ? numThreads : epochs.size());
+
+      try {
+         // one workspace, and trop model, for each thread
+         vector<Workspace> ws(nThreads > 1 ? nThreads : 1);
+         for(size_t t=0; t<ws.size(); t++)
+            ws[t].trop = tropFactory();
+
+         parallelFor(epochs.size(), unsigned(nThreads),
+                     [&](size_t i, unsigned t) {
+                        solveEpoch(epochs[i], eph, order, ws[t], results[i]);
+                     });
+      }
+      catch(Exception& e) {
+         GNSSTK_RETHROW(e);
+      }
+      catch(std::exception& exc) {
+         Exception e(exc.what());
+         GNSSTK_THROW(e);
+      }
+   }
+
+
+   // -------------------------------------------------------------------------
+   void PRSolutionBatch::solve(const Epoch& epoch, NavLibrary& eph,
+                               Result& result, NavSearchOrder order)
+      const
+   {
+      try {
+         Workspace ws;
+         ws.trop = tropFactory();
+         solveEpoch(epoch, eph, order, ws, result);
+      }
+      catch(Exception& e) { GNSSTK_RETHROW(e); }
+   }
+
+
+   // -------------------------------------------------------------------------
+   // Same algorithm as PRSolution::RAIMCompute(), with the results of the
+   // best subset kept in the workspace rather than in member data.
+   void PRSolutionBatch::solveEpoch(const Epoch& epoch, NavLibrary& eph,
+                                    NavSearchOrder order, Workspace& ws,
+                                    Result& result)
+      const
+   {
+      size_t i;
+      int iret(0),N;
+
+      if(epoch.pseudoranges.size() != epoch.sats.size() ||
+         (epoch.invMC.rows() > 0 &&
+          (epoch.invMC.rows() != epoch.sats.size() ||
+           epoch.invMC.cols() != epoch.sats.size())))
+      {
+         InvalidParameter e("Invalid dimensions at "
+                            + printTime(epoch.time,"%4F %10.3g"));
+         GNSSTK_THROW(e);
+      }
+
+      result = Result();
+      ws.weighted = (epoch.invMC.rows() > 0);
+
+      // fill the SVP matrix, and use it for every solution
+      ws.saveSats = epoch.sats;
+      N = config.PreparePRSolution(epoch.time, ws.saveSats, epoch.pseudoranges,
+                                   eph, ws.SVP, order);
+      result.sats = ws.saveSats;
+      if(N <= 0) {                                 // no ephemeris
+         result.status = -4;
+         return;
+      }
+
+      vector<size_t> GoodIndexes;
+      for(i=0; i<ws.saveSats.size(); i++)
+         if(ws.saveSats[i].id > 0)
+            GoodIndexes.push_back(i);
+
+      // the best solution so far; BestRMS < 0 marks it as unused
+      bool BestTropFlag(false);
+      int BestNIter(0),BestIret(-5);
+      double BestRMS(-1.0),BestSL(0.0),BestConv(0.0);
+      size_t BestDim(0),BestNsat(0);
+
+      // stage is the number of satellites to reject
+      int stage(0);
+      do {
+         Combinations Combo(N,stage);
+         do {
+            // mark the satellites for this combination
+            ws.sats = ws.saveSats;
+            for(i=0; i<GoodIndexes.size(); i++)
+               if(Combo.isSelected(i))
+                  ws.sats[GoodIndexes[i]].id = -::abs(ws.sats[GoodIndexes[i]].id);
+
+            iret = simpleSolve(epoch, ws);
+            if(iret <= 0 && iret > BestIret) BestIret = iret;
+
+            if(iret < 0) {
+               if(iret == -1 || iret == -2) continue;     // try the next combo
+               if(iret == -3) break;                      // too few satellites
+            }
+
+            // save the 'best' solution
+            if(BestRMS < 0.0 || ws.rms < BestRMS) {
+               BestRMS = ws.rms;
+               BestDim = 3 + ws.currGNSS.size();
+               BestNsat = ws.active.size();
+               copy(ws.sol.begin(), ws.sol.begin()+BestDim, ws.bestSol.begin());
+               copy(ws.cov.begin(), ws.cov.begin()+BestDim*BestDim,
+                    ws.bestCov.begin());
+               ws.bestSats = ws.sats;
+               ws.bestGNSS = ws.currGNSS;
+               BestSL = ws.maxSlope;
+               BestConv = ws.convergence;
+               BestNIter = ws.nIterations;
+               BestTropFlag = ws.tropFlag;
+               BestIret = iret;
+            }
+
+            if(stage==0 && ws.rms < config.RMSLimit)
+               break;
+
+         } while(Combo.Next() != -1);
+
+         // end of the stage
+         if(BestRMS > 0.0 && BestRMS < config.RMSLimit) {      // success
+            iret = 0;
+            break;
+         }
+
+         stage++;
+
+         // but not if too many are being rejected
+         if(config.NSatsReject > -1 && stage > config.NSatsReject)
+            break;
+
+         // already broke out of the combo loop
+         if(iret == -3 || iret == -4)
+            break;
+
+      } while(1);
+
+      // copy out the best solution
+      if(iret >= 0) {
+         result.sats = ws.bestSats;
+         result.dataGNSS = ws.bestGNSS;
+         result.solution = Vector<double>(BestDim);
+         result.covariance = Matrix<double>(BestDim,BestDim);
+         for(i=0; i<BestDim; i++) {
+            result.solution(i) = ws.bestSol[i];
+            for(size_t j=0; j<BestDim; j++)
+               result.covariance(i,j) = ws.bestCov[i*BestDim+j];
+         }
+         result.convergence = BestConv;
+         result.nIterations = BestNIter;
+         result.rmsResidual = BestRMS;
+         result.maxSlope = BestSL;
+         result.tropFlag = BestTropFlag;
+         result.nsvs = BestNsat;
+         iret = BestIret;
+
+         if(iret == 0) {
+            // DOPs from the unweighted information matrix of the best subset;
+            // the best subset is re-evaluated to get its partials
+            ws.sats = ws.bestSats;
+            if(simpleSolve(epoch, ws) == 0) {
+               size_t n(ws.active.size()), k, l, j;
+               for(k=0; k<BestDim; k++)
+                  for(l=0; l<=k; l++) {
+                     double s(0.0);
+                     for(j=0; j<n; j++) s += ws.P[j*BestDim+k]*ws.P[j*BestDim+l];
+                     ws.cov[k*BestDim+l] = s;
+                  }
+               if(choleskyInverse(&ws.cov[0], &ws.chol[0], BestDim)) {
+                  result.pdop = SQRT(ws.cov[0]+ws.cov[BestDim+1]
+                                     +ws.cov[2*BestDim+2]);
+                  for(k=3; k<BestDim; k++) result.tdop += ws.cov[k*BestDim+k];
+                  result.tdop = SQRT(result.tdop);
+                  result.gdop = RSS(result.pdop,result.tdop);
+               }
+            }
+         }
+      }
+
+      if(iret == 0) {
+         if(BestSL > config.SlopeLimit) {
+            iret = 1; result.slopeFlag = true;
+         }
+         if(BestSL > config.SlopeLimit/2.0 && result.nsvs == 5) {
+            iret = 1; result.slopeFlag = true;
+         }
+         if(BestRMS >= config.RMSLimit) {
+            iret = 1; result.rmsFlag = true;
+         }
+         if(result.tropFlag) iret = 1;
+         result.valid = true;
+      }
+      result.status = iret;
+   }
+
+
+   // -------------------------------------------------------------------------
+   // Same algorithm as PRSolution::SimplePRSolution(), using the workspace.
+   int PRSolutionBatch::simpleSolve(const Epoch& epoch, Workspace& ws) const
+   {
+      size_t i,j,k,l,n;
+      GPSEllipsoid ellip;
+      const vector<SatID>& Sats(ws.sats);
+      const Matrix<double>& SVP(ws.SVP);
+
+      // counts and systems
+      vector<SatelliteSystem> tempGNSS;
+      ws.active.clear();
+      for(i=0; i<Sats.size(); i++) {
+         if(Sats[i].id <= 0) continue;
+         if(vectorindex(config.allowedGNSS, Sats[i].system) == -1) continue;
+         ws.active.push_back(i);
+         if(vectorindex(tempGNSS, Sats[i].system) == -1)
+            tempGNSS.push_back(Sats[i].system);
+      }
+      ws.currGNSS.clear();
+      for(i=0; i<config.allowedGNSS.size(); i++)
+         if(vectorindex(tempGNSS, config.allowedGNSS[i]) != -1)
+            ws.currGNSS.push_back(config.allowedGNSS[i]);
+
+      const size_t dim(3 + ws.currGNSS.size());
+      const size_t nsat(ws.active.size());
+      if(nsat < dim) return -3;
+
+      ws.reserve(nsat, dim);
+      ws.clkIndex.resize(nsat);
+      for(n=0; n<nsat; n++)
+         ws.clkIndex[n] = 3 + vectorindex(ws.currGNSS, Sats[ws.active[n]].system);
+
+      if(ws.weighted) {
+         for(n=0; n<nsat; n++)
+            for(k=0; k<nsat; k++)
+               ws.W[n*nsat+k] = epoch.invMC(ws.active[n],ws.active[k]);
+      }
+
+      double *P(&ws.P[0]), *WP(&ws.WP[0]), *G(&ws.G[0]), *cov(&ws.cov[0]);
+      double *sol(&ws.sol[0]), *dX(&ws.dX[0]), *resid(&ws.resid[0]);
+      for(i=0; i<dim; i++) sol[i] = 0.0;
+
+      GlobalTropModel *gtm(dynamic_cast<GlobalTropModel*>(ws.trop.get()));
+
+      int iret(0), n_iterate(0);
+      int niter_limit(config.MaxNIterations < 2 ? 2 : config.MaxNIterations);
+      double converge(0.0);
+
+      do {
+         ws.tropFlag = false;
+
+         // receiver position for the trop model; test it for reasonableness
+         Position R;
+         bool badRX(false);
+         if(n_iterate > 0) {
+            R.setECEF(sol[0],sol[1],sol[2]);
+            double ht(R.getHeight());
+            badRX = ((gtm && ht > gtm->getHeightLimit()) || ht < -1000.0);
+         }
+
+         // partials and residuals
+         for(n=0; n<nsat; n++) {
+            i = ws.active[n];
+            double rho;
+            if(n_iterate == 0)
+               rho = 0.070;                           // initial guess: 70ms
+            else
+               rho = RSS(SVP(i,0)-sol[0], SVP(i,1)-sol[1], SVP(i,2)-sol[2])
+                     / ellip.c();
+
+            // correct for earth rotation
+            double wt(ellip.angVelocity()*rho), svxyz[3];
+            svxyz[0] =  ::cos(wt)*SVP(i,0) + ::sin(wt)*SVP(i,1);
+            svxyz[1] = -::sin(wt)*SVP(i,0) + ::cos(wt)*SVP(i,1);
+            svxyz[2] = SVP(i,2);
+
+            // geometric range
+            rho = RSS(svxyz[0]-sol[0], svxyz[1]-sol[1], svxyz[2]-sol[2]);
+
+            // corrected pseudorange minus geometric range
+            double crange(SVP(i,3) - rho);
+
+            // trop, but not on the first iteration
+            if(n_iterate > 0) {
+               Position S;
+               S.setECEF(svxyz[0],svxyz[1],svxyz[2]);
+               if(badRX || R.elevation(S) < 0.0)
+                  ws.tropFlag = true;
+               else
+                  crange -= ws.trop->correction(R,S,epoch.time);
+            }
+
+            j = ws.clkIndex[n];
+            resid[n] = crange - sol[j];
+
+            double *row(P + n*dim);
+            for(k=0; k<dim; k++) row[k] = 0.0;
+            row[0] = (sol[0]-svxyz[0])/rho;
+            row[1] = (sol[1]-svxyz[1])/rho;
+            row[2] = (sol[2]-svxyz[2])/rho;
+            row[j] = 1.0;
+         }
+
+         // WP = W*P
+         if(ws.weighted) {
+            for(n=0; n<nsat; n++)
+               for(k=0; k<dim; k++) {
+                  double s(0.0);
+                  for(l=0; l<nsat; l++) s += ws.W[n*nsat+l]*P[l*dim+k];
+                  WP[n*dim+k] = s;
+               }
+         }
+         else
+            WP = P;
+
+         // information matrix PT*W*P (lower triangle) and its inverse
+         for(k=0; k<dim; k++)
+            for(l=0; l<=k; l++) {
+               double s(0.0);
+               for(n=0; n<nsat; n++) s += P[n*dim+k]*WP[n*dim+l];
+               cov[k*dim+l] = s;
+            }
+         if(!choleskyInverse(cov, &ws.chol[0], dim)) return -2;
+
+         // generalized inverse G = Cov * PT * W
+         for(k=0; k<dim; k++)
+            for(n=0; n<nsat; n++) {
+               double s(0.0);
+               for(l=0; l<dim; l++) s += cov[k*dim+l]*WP[n*dim+l];
+               G[k*nsat+n] = s;
+            }
+
+         n_iterate++;
+
+         // solution update
+         converge = 0.0;
+         for(k=0; k<dim; k++) {
+            double s(0.0);
+            for(n=0; n<nsat; n++) s += G[k*nsat+n]*resid[n];
+            dX[k] = s;
+            sol[k] += s;
+            converge += s*s;
+         }
+         converge = ::sqrt(converge);
+
+         if(n_iterate > 1 && converge < config.ConvergenceLimit) {
+            iret = 0;
+            break;
+         }
+         if(n_iterate >= niter_limit || converge > 1.e10) {
+            iret = -1;
+            break;
+         }
+      } while(1);
+
+      // slopes, from the last G and PG = P*G
+      ws.maxSlope = 0.0;
+      if(iret == 0) for(n=0; n<nsat; n++) {
+         double pg(0.0), gg(0.0);
+         for(k=0; k<dim; k++) {
+            pg += P[n*dim+k]*G[k*nsat+n];
+            gg += G[k*nsat+n]*G[k*nsat+n];
+         }
+         ws.slopes[n] = 0.0;
+         if(::fabs(1.0-pg) < 1.e-8) continue;
+         ws.slopes[n] = SQRT(gg*double(nsat-dim)/(1.0-pg));
+         if(ws.slopes[n] > ws.maxSlope) ws.maxSlope = ws.slopes[n];
+      }
+
+      // RMS residual
+      double sum(0.0);
+      for(n=0; n<nsat; n++) sum += resid[n]*resid[n];
+      ws.rms = ::sqrt(sum/double(nsat));
+
+      ws.nIterations = n_iterate;
+      ws.convergence = converge;
+
+      return iret;
+   }
+
+} // namespace gnsstk
@@ -0,0 +1,202 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file PRSolutionBatch.hpp
+/// Compute RAIM pseudorange solutions for many independent epochs in
+/// parallel, using preallocated workspaces.
+
+#ifndef PRS_SOLUTION_BATCH_HPP
+#define PRS_SOLUTION_BATCH_HPP
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include "PRSolution.hpp"
+
+namespace gnsstk
+{
+   /// @ingroup GPSsolutions
+   //@{
+
+   /// PRSolutionBatch computes the same RAIM solution as
+   /// PRSolution::RAIMCompute() for a sequence of independent epochs, such as
+   /// the post-processing of a day of 1 Hz data from a network of stations.
+   ///
+   /// The epochs are distributed over a number of worker threads. Each thread
+   /// owns a workspace whose buffers are sized once for the largest epoch and
+   /// then reused for every iteration, RAIM subset and epoch, so that no
+   /// Matrix or Vector temporaries are allocated while solving. The normal
+   /// equations, whose dimension is only 3 + (number of systems), are solved
+   /// with an in-place Cholesky factorization instead of inverseSVD().
+   ///
+   /// The configuration (allowedGNSS, RMSLimit, SlopeLimit, NSatsReject,
+   /// MaxNIterations, ConvergenceLimit) is taken from a PRSolution object.
+   /// Because the epochs are solved independently and in no particular order,
+   /// the "memory" of PRSolution (hasMemory, APSolution) is not used: every
+   /// epoch starts from the origin, as PRSolution does when hasMemory is
+   /// false.
+   ///
+   /// The NavLibrary is queried concurrently from all the worker threads. Each
+   /// thread gets its own TropModel from the TropFactory given to the
+   /// constructor, since TropModel::correction() is not const.
+   ///
+   /// @code
+   /// PRSolution config;
+   /// config.allowedGNSS.push_back(SatelliteSystem::GPS);
+   /// PRSolutionBatch batch(config,
+   ///    []() { return std::make_shared<GGTropModel>(); });
+   /// std::vector<PRSolutionBatch::Result> results;
+   /// batch.solve(epochs, navLib, results);
+   /// @endcode
+   class PRSolutionBatch
+   {
+   public:
+      /// Input data for one epoch.
+      class Epoch
+      {
+      public:
+         /// Measured time of reception of the data.
+         CommonTime time;
+         /// Satellites observed; as in RAIMCompute(), satellites with a
+         /// non-positive id are ignored.
+         std::vector<SatID> sats;
+         /// Raw pseudoranges in meters, parallel to sats.
+         std::vector<double> pseudoranges;
+         /// Optional inverse measurement covariance (meter^-2), NxN with N the
+         /// length of sats; if empty, the data are not weighted.
+         Matrix<double> invMC;
+      };
+
+      /// Results for one epoch; see the PRSolution members of the same names.
+      class Result
+      {
+      public:
+         Result() : status(-4), valid(false), rmsResidual(0.0), maxSlope(0.0),
+                    convergence(0.0), nIterations(0), nsvs(0), tropFlag(false),
+                    rmsFlag(false), slopeFlag(false), pdop(0.0), tdop(0.0),
+                    gdop(0.0)
+         {}
+         /// Return value, as from PRSolution::RAIMCompute().
+         int status;
+         /// True if the solution is valid (status >= 0).
+         bool valid;
+         /// Satellites with those excluded by RAIM (or lacking ephemeris)
+         /// marked by a negative id.
+         std::vector<SatID> sats;
+         /// Systems whose clocks are in the solution, in allowedGNSS order.
+         std::vector<SatelliteSystem> dataGNSS;
+         /// X,Y,Z (m, ECEF) followed by one clock bias (m) per dataGNSS.
+         Vector<double> solution;
+         /// Covariance of solution (meter^2).
+         Matrix<double> covariance;
+         double rmsResidual;  ///< RMS post-fit residual (m).
+         double maxSlope;     ///< Largest RAIM slope.
+         double convergence;  ///< Final RSS change in the solution (m).
+         int nIterations;     ///< Number of iterations used.
+         int nsvs;            ///< Number of satellites used.
+         bool tropFlag;       ///< Trop correction not applied to some data.
+         bool rmsFlag;        ///< RMS residual exceeds RMSLimit.
+         bool slopeFlag;      ///< Slope exceeds SlopeLimit.
+         double pdop, tdop, gdop; ///< Dilutions of precision.
+      };
+
+      /// Function returning a new TropModel, called once for each thread.
+      typedef std::function<std::shared_ptr<TropModel>()> TropFactory;
+
+      /// Constructor.
+      /// @param config PRSolution whose configuration is copied; allowedGNSS
+      ///               must not be empty.
+      /// @param tropFactory function creating a trop model for each thread.
+      /// @param numThreads number of worker threads; if 0, use
+      ///               std::thread::hardware_concurrency().
+      /// @throw InvalidParameter if allowedGNSS is empty or tropFactory is
+      ///               undefined.
+      PRSolutionBatch(const PRSolution& config, const TropFactory& tropFactory,
+                      unsigned numThreads = 0);
+
+      /// Compute a RAIM solution for every epoch.
+      /// @param epochs input data, one element per epoch.
+      /// @param eph NavLibrary providing the ephemerides; it is queried from
+      ///            several threads at once.
+      /// @param results output, resized to match epochs.
+      /// @param order how NavLibrary searches are performed.
+      /// @throw Exception if an epoch is malformed or any computation throws;
+      ///            the first such exception is rethrown after all the threads
+      ///            have finished.
+      void solve(const std::vector<Epoch>& epochs, NavLibrary& eph,
+                 std::vector<Result>& results,
+                 NavSearchOrder order = NavSearchOrder::User) const;
+
+      /// Compute the RAIM solution for one epoch in the calling thread.
+      /// @param epoch input data.
+      /// @param eph NavLibrary providing the ephemerides.
+      /// @param result output solution for the epoch.
+      /// @param order how NavLibrary searches are performed.
+      void solve(const Epoch& epoch, NavLibrary& eph, Result& result,
+                 NavSearchOrder order = NavSearchOrder::User) const;
+
+      /// @return the number of worker threads used by solve().
+      unsigned getNumThreads() const
+      { return numThreads; }
+
+   private:
+      class Workspace;
+
+      /// Compute the RAIM solution for one epoch using the given workspace.
+      void solveEpoch(const Epoch& epoch, NavLibrary& eph, NavSearchOrder order,
+                      Workspace& ws, Result& result) const;
+
+      /// Equivalent of PRSolution::SimplePRSolution() using only the
+      /// satellites in ws.active; results are left in ws.
+      /// @return 0 ok, -1 failed to converge, -2 singular, -3 too few data.
+      int simpleSolve(const Epoch& epoch, Workspace& ws) const;
+
+      /// Configuration, including allowedGNSS and the RAIM limits.
+      PRSolution config;
+      /// Creates the trop model for each thread.
+      TropFactory tropFactory;
+      /// Number of worker threads.
+      unsigned numThreads;
+
+   }; // end class PRSolutionBatch
+
+   //@}
+
+} // namespace gnsstk
+
+#endif
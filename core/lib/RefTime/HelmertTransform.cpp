@@ -93,7 +93,7 @@ namespace gnsstk
          /** @note small angle approximation is used. */
          /** @note by construction, transpose(rotation) == inverse(rotation)
           * (given small angle approximation). */
-      rotation = Matrix<double>(3,3,0.0);
+      rotation = 0.0;
       rotation(0,0) = 1.0;
       rotation(0,1) = -rz;
       rotation(0,2) = ry;
@@ -107,7 +107,6 @@ namespace gnsstk
       rotation(2,2) = 1.0;
 
          // translation vector
-      translation = Vector<double>(3);
       translation(0) = tx;
       translation(1) = ty;
       translation(2) = tz;
@@ -155,7 +154,7 @@ namespace gnsstk
             // transform
          result = pos;
          result.transformTo(Position::Cartesian);
-         Vector<double> vec(3),res(3);
+         FixedVector<double,3> vec,res;
          vec(0) = result[0];
          vec(1) = result[1];
          vec(2) = result[2];
@@ -170,7 +169,7 @@ namespace gnsstk
             // inverse transform
          result = pos;
          result.transformTo(Position::Cartesian);
-         Vector<double> vec(3),res(3);
+         FixedVector<double,3> vec,res;
          vec(0) = result[0];
          vec(1) = result[1];
          vec(2) = result[2];
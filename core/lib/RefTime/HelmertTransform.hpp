@@ -49,6 +49,7 @@
 #include "Position.hpp"
 #include "Vector.hpp"
 #include "Matrix.hpp"
+#include "FixedMatrix.hpp"
 #include "Xvt.hpp"
 
 namespace gnsstk
@@ -229,8 +230,10 @@ namespace gnsstk
       double scale;              ///< scale factor, dimensionless, 0=no scale
 
          // transform quantities derived from the 7 parameters
-      Matrix<double> rotation;   ///< the transform 3x3 rotation matrix (w/o scale)
-      Vector<double> translation;///< the transform 3-vector in meters
+         /// the transform 3x3 rotation matrix (w/o scale)
+      FixedMatrix<double,3,3> rotation;
+         /// the transform 3-vector in meters
+      FixedVector<double,3> translation;
 
          /// epoch at which transform is first applicable
       CommonTime epoch;
@@ -0,0 +1,216 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file PackedTime.hpp
+/// Compact integer time representation for fast comparison and
+/// differencing, e.g. as the key type of time-ordered stores.
+
+#ifndef GNSSTK_PACKEDTIME_HPP
+#define GNSSTK_PACKEDTIME_HPP
+
+#include <cmath>
+#include <cstdint>
+#include "CommonTime.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup TimeHandling
+      //@{
+
+      /**
+       * A time held as an integer day and integer picoseconds of
+       * day, plus a time system, in 16 bytes.
+       *
+       * CommonTime is the right type for time arithmetic in general,
+       * but each of its comparisons is an out-of-line call that
+       * checks the time systems and compares three mixed-type fields,
+       * which is most of the cost of looking up a
+       * std::map<CommonTime,...>.  PackedTime compares two integers,
+       * inline, and its comparison and difference operators are
+       * constexpr.
+       *
+       * Conversion from CommonTime rounds to the nearest picosecond,
+       * and is implicit so that a store keyed by PackedTime can be
+       * searched with a CommonTime.  Conversion back is explicit,
+       * through toCommonTime().
+       *
+       * @warning The comparison operators compare the time only and
+       * ignore the time system, where CommonTime throws on
+       * comparing incompatible systems.  Use compatible() where
+       * that check is needed.
+       */
+   class PackedTime
+   {
+   public:
+         /// Picoseconds in a second.
+      static constexpr int64_t PS_PER_SEC = 1000000000000LL;
+         /// Picoseconds in a millisecond.
+      static constexpr int64_t PS_PER_MS = 1000000000LL;
+         /// Picoseconds in a day.
+      static constexpr int64_t PS_PER_DAY = PS_PER_SEC * 86400LL;
+
+         /// Default constructor; day 0, time system Unknown.
+      constexpr PackedTime()
+            : psod(0), day(0), timeSystem(TimeSystem::Unknown)
+      {}
+
+         /** Construct from the packed fields, which must be
+          * normalized (0 <= ps < PS_PER_DAY).
+          * @param[in] d Day, as in CommonTime.
+          * @param[in] ps Picoseconds of day.
+          * @param[in] ts Time system. */
+      constexpr PackedTime(long d, int64_t ps,
+                           TimeSystem ts = TimeSystem::Unknown)
+            : psod(ps), day(int32_t(d)), timeSystem(ts)
+      {}
+
+         /// Convert from CommonTime, rounding to the nearest picosecond.
+      PackedTime(const CommonTime& ct)
+      {
+         long d, msod;
+         double fsod;
+         ct.getInternal(d, msod, fsod, timeSystem);
+         day = int32_t(d);
+         psod = msod * PS_PER_MS + std::llround(fsod * double(PS_PER_SEC));
+         normalize();
+      }
+
+         /// Convert to CommonTime.
+      CommonTime toCommonTime() const
+      {
+         CommonTime rv;
+         rv.setInternal(day, long(psod / PS_PER_MS),
+                        double(psod % PS_PER_MS) / double(PS_PER_SEC),
+                        timeSystem);
+         return rv;
+      }
+
+         /// Day, as in CommonTime.
+      constexpr long getDay() const
+      { return day; }
+         /// Picoseconds of day.
+      constexpr int64_t getPicoseconds() const
+      { return psod; }
+         /// Time system.
+      constexpr TimeSystem getTimeSystem() const
+      { return timeSystem; }
+
+         /** Return true if the time systems are the same, or either
+          * is Any, i.e. if CommonTime would allow the comparison. */
+      constexpr bool compatible(const PackedTime& right) const
+      {
+         return (timeSystem == right.timeSystem ||
+                 timeSystem == TimeSystem::Any ||
+                 right.timeSystem == TimeSystem::Any);
+      }
+
+         /// Comparison of the times, ignoring the time systems.
+      constexpr bool operator==(const PackedTime& right) const
+      { return day == right.day && psod == right.psod; }
+         /// Comparison of the times, ignoring the time systems.
+      constexpr bool operator!=(const PackedTime& right) const
+      { return !operator==(right); }
+         /// Comparison of the times, ignoring the time systems.
+      constexpr bool operator<(const PackedTime& right) const
+      { return day < right.day || (day == right.day && psod < right.psod); }
+         /// Comparison of the times, ignoring the time systems.
+      constexpr bool operator>(const PackedTime& right) const
+      { return right.operator<(*this); }
+         /// Comparison of the times, ignoring the time systems.
+      constexpr bool operator<=(const PackedTime& right) const
+      { return !right.operator<(*this); }
+         /// Comparison of the times, ignoring the time systems.
+      constexpr bool operator>=(const PackedTime& right) const
+      { return !operator<(right); }
+
+         /// Difference of the times in seconds, ignoring the time systems.
+      constexpr double operator-(const PackedTime& right) const
+      {
+         return (double(day - right.day) * 86400.0 +
+                 double(psod - right.psod) / double(PS_PER_SEC));
+      }
+
+         /// Add seconds to this time, rounding to the nearest picosecond.
+      PackedTime& operator+=(double seconds)
+      {
+            // whole and fractional seconds separately, so the
+            // picoseconds are not rounded at the scale of a day
+         double whole = std::trunc(seconds);
+         int64_t sec = int64_t(whole);
+         day += int32_t(sec / 86400);
+         psod += ((sec % 86400) * PS_PER_SEC +
+                  std::llround((seconds - whole) * double(PS_PER_SEC)));
+         normalize();
+         return *this;
+      }
+         /// Subtract seconds from this time.
+      PackedTime& operator-=(double seconds)
+      { return operator+=(-seconds); }
+         /// This time plus seconds.
+      PackedTime operator+(double seconds) const
+      { return PackedTime(*this) += seconds; }
+         /// This time minus seconds.
+      PackedTime operator-(double seconds) const
+      { return PackedTime(*this) += -seconds; }
+
+   private:
+         /// Bring psod into [0, PS_PER_DAY), carrying into day.
+      void normalize()
+      {
+         day += int32_t(psod / PS_PER_DAY);
+         psod %= PS_PER_DAY;
+         if (psod < 0)
+         {
+            psod += PS_PER_DAY;
+            day--;
+         }
+      }
+
+         /// Picoseconds of day, 0 <= psod < PS_PER_DAY.
+      int64_t psod;
+         /// Day, as in CommonTime (a 'Julian day').
+      int32_t day;
+         /// Time system.
+      TimeSystem timeSystem;
+   };
+
+      //@}
+
+} // namespace gnsstk
+
+#endif // GNSSTK_PACKEDTIME_HPP
@@ -0,0 +1,186 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+#ifndef GNSSTK_READWRITELOCK_HPP
+#define GNSSTK_READWRITELOCK_HPP
+
+#include <mutex>
+#include <condition_variable>
+
+namespace gnsstk
+{
+      /// @ingroup datastructsgroup
+      //@{
+
+      /** Reader/writer lock allowing any number of threads to read
+       * a shared data structure concurrently while giving a writer
+       * exclusive access.  This fills the role of
+       * std::shared_mutex, which is not available in C++11.
+       *
+       * The lock prefers readers, which is to say that a thread
+       * requesting a shared lock only waits while a writer actually
+       * holds the lock, not while a writer is waiting for it.  This
+       * allows a thread that already holds a shared lock to acquire
+       * it again (e.g. a search method that calls other search
+       * methods) without deadlocking.  The exclusive lock is not
+       * recursive.
+       *
+       * The cost of preferring readers is that a writer waits until
+       * no thread holds a shared lock.  If shared locks overlap
+       * continuously, as with many threads searching in a tight
+       * loop, a writer can wait indefinitely.  Make changes while
+       * readers are known to pause, e.g. between batches of
+       * queries.
+       *
+       * Copying a ReadWriteLock yields a new, unlocked lock so that
+       * classes containing one remain copyable.
+       *
+       * @code{.cpp}
+       *    {
+       *       ReadWriteLock::ReadGuard guard(lock);
+       *       // read-only access to the protected data
+       *    }
+       *    {
+       *       ReadWriteLock::WriteGuard guard(lock);
+       *       // modify the protected data
+       *    }
+       * @endcode
+       */
+   class ReadWriteLock
+   {
+   public:
+         /// Scoped shared (reader) lock.
+      class ReadGuard
+      {
+      public:
+            /// Acquire a shared lock on \a l, released on destruction.
+         ReadGuard(ReadWriteLock& l)
+               : lock(l)
+         { lock.lockShared(); }
+         ~ReadGuard()
+         { lock.unlockShared(); }
+      private:
+         ReadGuard(const ReadGuard&) = delete;
+         ReadGuard& operator=(const ReadGuard&) = delete;
+         ReadWriteLock& lock;
+      };
+
+         /// Scoped exclusive (writer) lock.
+      class WriteGuard
+      {
+      public:
+            /// Acquire an exclusive lock on \a l, released on destruction.
+         WriteGuard(ReadWriteLock& l)
+               : lock(l)
+         { lock.lock(); }
+         ~WriteGuard()
+         { lock.unlock(); }
+      private:
+         WriteGuard(const WriteGuard&) = delete;
+         WriteGuard& operator=(const WriteGuard&) = delete;
+         ReadWriteLock& lock;
+      };
+
+         /// Initialize to the unlocked state.
+      ReadWriteLock()
+            : readers(0), writer(false)
+      {}
+
+         /// Copies are independent, unlocked locks.
+      ReadWriteLock(const ReadWriteLock&)
+            : readers(0), writer(false)
+      {}
+
+         /// Assignment leaves this lock untouched.
+      ReadWriteLock& operator=(const ReadWriteLock&)
+      { return *this; }
+
+         /// Block until no thread holds a lock, then lock exclusively.
+      void lock()
+      {
+         std::unique_lock<std::mutex> guard(mtx);
+         cond.wait(guard, [this]{ return !writer && (readers == 0); });
+         writer = true;
+      }
+
+         /// Release an exclusive lock.
+      void unlock()
+      {
+         {
+            std::lock_guard<std::mutex> guard(mtx);
+            writer = false;
+         }
+         cond.notify_all();
+      }
+
+         /// Block until no writer holds the lock, then lock shared.
+      void lockShared()
+      {
+         std::unique_lock<std::mutex> guard(mtx);
+         cond.wait(guard, [this]{ return !writer; });
+         readers++;
+      }
+
+         /// Release a shared lock.
+      void unlockShared()
+      {
+         bool last;
+         {
+            std::lock_guard<std::mutex> guard(mtx);
+            last = (--readers == 0);
+         }
+         if (last)
+            cond.notify_all();
+      }
+
+   private:
+         /// Protects readers and writer.
+      std::mutex mtx;
+         /// Signaled when the lock becomes available.
+      std::condition_variable cond;
+         /// Number of shared locks currently held.
+      unsigned long readers;
+         /// True if an exclusive lock is currently held.
+      bool writer;
+   };
+
+      //@}
+
+} // namespace gnsstk
+
+#endif // GNSSTK_READWRITELOCK_HPP
@@ -0,0 +1,184 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+#ifndef GNSSTK_THREADGROUP_HPP
+#define GNSSTK_THREADGROUP_HPP
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace gnsstk
+{
+      /// @ingroup datastructsgroup
+      //@{
+
+      /** A set of threads that are joined when the group is
+       * destroyed.  A std::thread that is destroyed while still
+       * joinable calls std::terminate(), so keeping threads in a
+       * ThreadGroup makes sure they are joined on every path,
+       * including when creating a later thread or any other code
+       * between creating and joining them throws.
+       *
+       * The destructor only waits; code that owns the group must
+       * make sure the threads finish, e.g. by telling them to stop
+       * in an exception handler before the group goes out of scope.
+       *
+       * @code{.cpp}
+       *    ThreadGroup group;
+       *    for (unsigned t = 0; t < n; t++)
+       *       group.create(worker);
+       *    // ... work in this thread ...
+       *    group.join();
+       * @endcode
+       */
+   class ThreadGroup
+   {
+   public:
+         /// Initialize an empty group.
+      ThreadGroup()
+      {}
+
+         /// Join all the threads of the group.
+      ~ThreadGroup()
+      { join(); }
+
+         /** Start a new thread of the group running f.
+          * @param[in] f The function for the thread to run.
+          * @throw std::system_error if the thread could not be
+          *   started, in which case the group is unchanged. */
+      template <class Function>
+      void create(Function&& f)
+      {
+            // reserve first so that the thread can't be left
+            // running outside the group by a failed allocation.
+         threads.reserve(threads.size() + 1);
+         threads.emplace_back(std::forward<Function>(f));
+      }
+
+         /// Wait for all the threads of the group to finish.
+      void join()
+      {
+         for (auto& t : threads)
+         {
+            if (t.joinable())
+               t.join();
+         }
+         threads.clear();
+      }
+
+         /// Get the number of threads in the group.
+      size_t size() const
+      { return threads.size(); }
+
+   private:
+      ThreadGroup(const ThreadGroup&) = delete;
+      ThreadGroup& operator=(const ThreadGroup&) = delete;
+         /// The threads of the group.
+      std::vector<std::thread> threads;
+   };
+
+
+      /** Call fn(i, w) for every i in [0,n), spreading the calls
+       * over up to nThreads threads, and return when all calls are
+       * done.  The calls are made in no particular order; w, in
+       * [0,nThreads), identifies the thread making the call, so
+       * that fn can use per-thread workspace.  If nThreads or n is
+       * at most 1, everything is done in the calling thread.
+       *
+       * If a call throws, no further calls are started, and once
+       * all the threads are done the first exception is rethrown
+       * in the calling thread.
+       * @param[in] n The number of calls to make.
+       * @param[in] nThreads The largest number of threads to use.
+       * @param[in] fn The function to call, as fn(size_t, unsigned).
+       * @throw whatever fn throws, or std::system_error if a thread
+       *   could not be started. */
+   template <class Function>
+   void parallelFor(size_t n, unsigned nThreads, Function fn)
+   {
+      std::atomic<size_t> next(0);
+      std::exception_ptr error;
+      std::mutex errorMutex;
+      auto worker = [&](unsigned w)
+      {
+         try
+         {
+            for (size_t i = next++; i < n; i = next++)
+               fn(i, w);
+         }
+         catch (...)
+         {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error)
+               error = std::current_exception();
+            next = n; // stop the other threads early
+         }
+      };
+      if (nThreads > n)
+         nThreads = unsigned(n);
+      if (nThreads <= 1)
+      {
+         worker(0);
+      }
+      else
+      {
+         ThreadGroup group;
+         try
+         {
+            for (unsigned w = 0; w < nThreads; w++)
+               group.create([&worker, w]() { worker(w); });
+         }
+         catch (...)
+         {
+               // the threads already started are joined by group
+            next = n;
+            throw;
+         }
+      }
+      if (error)
+         std::rethrow_exception(error);
+   }
+
+      //@}
+
+} // namespace gnsstk
+
+#endif // GNSSTK_THREADGROUP_HPP
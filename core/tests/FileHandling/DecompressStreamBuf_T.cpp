@@ -0,0 +1,889 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "FFTextStream.hpp"
+#include "GzipStreamBuf.hpp"
+#include "RinexObsStream.hpp"
+#include "RinexObsHeader.hpp"
+#include "RinexObsData.hpp"
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsHeader.hpp"
+#include "Rinex3ObsData.hpp"
+#include "TestUtil.hpp"
+
+/// RINEX 3 observation data.
+static const char *rinex3Obs =
+   "     3.00           OBSERVATION DATA    M                   RINEX VERSION / TYPE\n"
+   "DecompressTest      TEST                20200312 000000 UTC PGM / RUN BY / DATE\n"
+   "TEST                                                        MARKER NAME\n"
+   "TEST                TEST                                    OBSERVER / AGENCY\n"
+   "1                   TEST                1                   REC # / TYPE / VERS\n"
+   "1                   TEST                                    ANT # / TYPE\n"
+   "  1130000.0000 -4830000.0000  3990000.0000                  APPROX POSITION XYZ\n"
+   "        0.0000        0.0000        0.0000                  ANTENNA: DELTA H/E/N\n"
+   "G    4 C1C L1C D1C S1C                                      SYS / # / OBS TYPES\n"
+   "E    2 C1X L1X                                              SYS / # / OBS TYPES\n"
+   "  2020     3    11    12     0    0.0000000     GPS         TIME OF FIRST OBS\n"
+   "                                                            END OF HEADER\n"
+   "> 2020 03 11 12 00  0.0000000  0  4      -0.000123456789\n"
+   "G01  20001234.567 6  20099999.999 7 -20198765.431          45.250\n"
+   "G07  20008641.969 8  20107407.401 5 -20206172.833          45.250\n"
+   "E02  20002469.134 7  20101234.566 8\n"
+   "E09  20011111.103 6  20109876.535 7\n"
+   "> 2020 03 11 12 00 30.0000000  0  4       0.000123457712\n"
+   "G01  20001235.857 6  20100001.289 7 -20198766.721          45.375\n"
+   "G07  20008643.577 8  20107409.009 5 -20206174.441          45.375\n"
+   "E02  20002470.477 7  20101235.909 8\n"
+   "E09  20011112.817 6  20109878.249 7\n"
+   "> 2020 03 11 12 01  0.0000000  0  5\n"
+   "G01  20001239.621 6  20100005.053 7 -20198770.485          45.500\n"
+   "G07  20008647.659 8  20107413.091 5 -20206178.523          45.500\n"
+   "G12  20014821.024 5  20113586.456 6 -20212351.888          45.500\n"
+   "E02  20002474.294 7  20101239.726 8\n"
+   "E09  20011117.005 6  20109882.437 7\n"
+   "> 2020 03 11 12 01 30.0000000  0  5      -0.000123465558\n"
+   "G01  20001245.859 6  20100011.29117 -20198776.723          45.625\n"
+   "G07  20008654.215 8  20107419.64715 -20206185.079          45.625\n"
+   "G12  20014827.845 5  20113593.27716 -20212358.709          45.625\n"
+   "E02  20002480.585 7  20101246.01718\n"
+   "E09  20011123.667 6  20109889.09917\n"
+   ">                              4  1\n"
+   "EVENT NUMBER 4                                              COMMENT\n"
+   "> 2020 03 11 12 02  0.0000000  0  5       0.000123472481\n"
+   "G01  20001254.571 6  20100020.003 7 -20198785.435          45.750\n"
+   "G07  20008663.245 8  20107428.677 5 -20206194.109          45.750\n"
+   "G12  20014837.140 5  20113602.572 6 -20212368.004          45.750\n"
+   "E02  20002489.350 7  20101254.782 8\n"
+   "E09  20011132.803 6  20109898.235 7\n"
+   "> 2020 03 11 12 02 30.0000000  0  4       0.000123481404\n"
+   "G01  20001265.757 6  20100031.189 7 -20198796.621          45.875\n"
+   "G07  20008674.749 8                 -20206205.613\n"
+   "G12  20014848.909 5  20113614.341 6 -20212379.773          45.875\n"
+   "E09  20011144.413 6  20109909.845 7\n"
+   "> 2020 03 11 12 03  0.0000000  0  5      -0.000123492327\n"
+   "G01  20001279.417 6  20100044.849 7 -20198810.281          46.000\n"
+   "G07  20008688.727 8  20107454.159 5 -20206219.591          46.000\n"
+   "G12  20014863.152 5  20113628.584 6 -20212394.016          46.000\n"
+   "E02                  20101279.734 8\n"
+   "E09  20011158.497 6  20109923.929 7\n"
+   "> 2020 03 11 12 03 30.0000000  0  5       0.000123505250\n"
+   "G01  20001295.551 6  20100060.983 7 -20198826.415          46.125\n"
+   "G07  20008705.179 8  20107470.611 5 -20206236.043          46.125\n"
+   "G12  20014879.869 5  20113645.301 6 -20212410.733          46.125\n"
+   "E02  20002530.489 7  20101295.921 8\n"
+   "E09  20011175.055 6  20109940.487 7\n"
+   "> 2020 03 11 12 04  0.0000000  0  5       0.000123520173\n"
+   "G01  20001314.159 6  20100079.591 7 -20198845.023          46.250\n"
+   "G07  20008724.105 8  20107489.537 5 -20206254.969          46.250\n"
+   "G12  20014899.060 5  20113664.492 6 -20212429.924          46.250\n"
+   "E02  20002549.150 7  20101314.582 8\n"
+   "E09  20011194.087 6  20109959.519 7\n";
+
+/// rinex3Obs in compact RINEX 3.0 form.
+static const char *crinex3Obs =
+   "3.0                 COMPACT RINEX FORMAT                    CRINEX VERS   / TYPE\n"
+   "RNX2CRX ver.4.0.7                       12-Mar-20 00:00     CRINEX PROG / DATE\n"
+   "     3.00           OBSERVATION DATA    M                   RINEX VERSION / TYPE\n"
+   "DecompressTest      TEST                20200312 000000 UTC PGM / RUN BY / DATE\n"
+   "TEST                                                        MARKER NAME\n"
+   "TEST                TEST                                    OBSERVER / AGENCY\n"
+   "1                   TEST                1                   REC # / TYPE / VERS\n"
+   "1                   TEST                                    ANT # / TYPE\n"
+   "  1130000.0000 -4830000.0000  3990000.0000                  APPROX POSITION XYZ\n"
+   "        0.0000        0.0000        0.0000                  ANTENNA: DELTA H/E/N\n"
+   "G    4 C1C L1C D1C S1C                                      SYS / # / OBS TYPES\n"
+   "E    2 C1X L1X                                              SYS / # / OBS TYPES\n"
+   "  2020     3    11    12     0    0.0000000     GPS         TIME OF FIRST OBS\n"
+   "                                                            END OF HEADER\n"
+   "> 2020 03 11 12 00  0.0000000  0  4      G01G07E02E09\n"
+   "3&-123456789\n"
+   "3&20001234567 3&20099999999 3&-20198765431 3&45250  6 7\n"
+   "3&20008641969 3&20107407401 3&-20206172833 3&45250  8 5\n"
+   "3&20002469134 3&20101234566  7 8\n"
+   "3&20011111103 3&20109876535  6 7\n"
+   "                   3\n"
+   "246914501\n"
+   "1290 1290 -1290 125\n"
+   "1608 1608 -1608 125\n"
+   "1343 1343\n"
+   "1714 1714\n"
+   "                 1 &              5            G1   2E09\n"
+   "\n"
+   "2474 2474 -2474 0\n"
+   "2474 2474 -2474 0\n"
+   "3&20014821024 3&20113586456 3&-20212351888 3&45500  5 6\n"
+   "2474 2474\n"
+   "2474 2474\n"
+   "                   3\n"
+   "3&-123465558\n"
+   "0 0 0 0   1\n"
+   "0 0 0 0   1\n"
+   "6821 6821 -6821 125   1\n"
+   "0 0   1\n"
+   "0 0   1\n"
+   ">                              4  1\n"
+   "EVENT NUMBER 4                                              COMMENT\n"
+   "> 2020 03 11 12 02  0.0000000  0  5      G01G07G12E02E09\n"
+   "246938039\n"
+   "0 0 0 0   &\n"
+   "0 0 0 0   &\n"
+   "2474 2474 -2474 0   &\n"
+   "0 0   &\n"
+   "0 0   &\n"
+   "                   3              4                 9&&&\n"
+   "-246929116\n"
+   "0 0 0 0\n"
+   "0  0     &\n"
+   "0 0 0 0\n"
+   "0 0\n"
+   "                 3 &              5                 2E09\n"
+   "-53538\n"
+   "0 0 0 0\n"
+   "0 3&20107454159 0 3&46000    5\n"
+   "0 0 0 0\n"
+   " 3&20101279734    8\n"
+   "0 0\n"
+   "                   3\n"
+   "740953962\n"
+   "0 0 0 0\n"
+   "0 16452 0 125\n"
+   "0 0 0 0\n"
+   "3&20002530489 16187  7\n"
+   "0 0\n"
+   "                 4 &\n"
+   "-740953962\n"
+   "0 0 0 0\n"
+   "0 2474 0 0\n"
+   "0 0 0 0\n"
+   "18661 2474\n"
+   "0 0\n";
+
+/// crinex3Obs compressed with gzip.
+static const unsigned char crinex3ObsGz[] =
+{
+   0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xa5, 0x56,
+   0x4b, 0x6f, 0xdb, 0x30, 0x0c, 0xbe, 0xeb, 0x57, 0x10, 0x18, 0x90, 0x9b,
+   0x53, 0x51, 0x2f, 0x4b, 0x3d, 0x14, 0x70, 0x1d, 0x35, 0x0d, 0x56, 0x3b,
+   0x81, 0xed, 0x16, 0xc9, 0x6e, 0xc3, 0x90, 0xe3, 0xb0, 0xa1, 0x1d, 0xf6,
+   0xfb, 0x47, 0x49, 0x4e, 0xe2, 0x34, 0x42, 0x91, 0x62, 0x6c, 0x2d, 0x8b,
+   0x0a, 0xf5, 0x89, 0x8f, 0x8f, 0x4a, 0xe4, 0x9c, 0xc3, 0x7b, 0xa9, 0xd7,
+   0xcd, 0xa6, 0xaa, 0x07, 0xe8, 0x56, 0xad, 0xdf, 0xc2, 0xc3, 0xba, 0x6b,
+   0xaa, 0x01, 0x32, 0x52, 0x27, 0x83, 0x17, 0xdf, 0xf5, 0xa4, 0xdd, 0xc0,
+   0xb0, 0xdb, 0x78, 0xd6, 0xb5, 0x5b, 0x51, 0x77, 0x5b, 0xf8, 0xbb, 0x7f,
+   0x9d, 0xab, 0x39, 0x9f, 0x97, 0x90, 0x17, 0x14, 0x45, 0xf3, 0xfd, 0xb5,
+   0x10, 0x1c, 0x38, 0xbf, 0xe5, 0x7c, 0x0a, 0xb8, 0xe9, 0xd6, 0x4b, 0x82,
+   0x5b, 0x54, 0x83, 0x67, 0x71, 0x5d, 0xce, 0xf9, 0xd4, 0xcb, 0xf5, 0x7d,
+   0xef, 0xbb, 0x97, 0x6a, 0x58, 0xad, 0xdb, 0x60, 0x54, 0x85, 0xb5, 0x26,
+   0x73, 0xc4, 0xc9, 0xbd, 0x60, 0x39, 0xfa, 0xb7, 0xd8, 0xff, 0xf8, 0xf5,
+   0xf3, 0xf7, 0xeb, 0xfe, 0xed, 0x6d, 0xd8, 0xbf, 0xfd, 0x49, 0x86, 0x83,
+   0xef, 0x2f, 0x02, 0x14, 0x5c, 0x70, 0x2e, 0x51, 0x90, 0x7b, 0x41, 0xe0,
+   0x79, 0xa8, 0x61, 0xb3, 0x6c, 0x08, 0xa6, 0x7b, 0x6e, 0xe1, 0x7e, 0x77,
+   0x70, 0x30, 0xb7, 0xf7, 0x5a, 0x69, 0xaa, 0xee, 0xab, 0xef, 0xa0, 0xad,
+   0x9a, 0x3c, 0xce, 0xb5, 0xd8, 0x29, 0x21, 0x84, 0x74, 0x03, 0xd5, 0xd2,
+   0xb7, 0xf5, 0x8e, 0x61, 0xc6, 0x2a, 0x87, 0x96, 0xb3, 0xeb, 0x7c, 0x0d,
+   0x5f, 0xc6, 0x74, 0xd1, 0x2b, 0xe4, 0xef, 0x6a, 0xbc, 0x9c, 0x54, 0xed,
+   0x70, 0xc4, 0xa3, 0x7a, 0x22, 0xca, 0x90, 0xd0, 0x79, 0xcc, 0x6a, 0xa1,
+   0xec, 0x44, 0x03, 0xe9, 0xdc, 0x44, 0xbb, 0x00, 0xda, 0x10, 0x33, 0x88,
+   0x1e, 0xeb, 0x7e, 0x15, 0x6b, 0xbf, 0xdd, 0x7d, 0x63, 0x87, 0xcf, 0xce,
+   0xf7, 0x7c, 0xa4, 0x9d, 0x39, 0xe6, 0xdb, 0xb6, 0xba, 0x85, 0x85, 0x7f,
+   0x22, 0x16, 0x3d, 0xde, 0xf8, 0x9b, 0x96, 0x2d, 0xc3, 0x27, 0x0a, 0x6a,
+   0xac, 0xe1, 0x89, 0x9e, 0x05, 0x3d, 0x3d, 0x3d, 0x57, 0x49, 0xbf, 0xeb,
+   0x29, 0xce, 0x10, 0x2b, 0x55, 0x24, 0xc6, 0xdb, 0x33, 0x1f, 0xc9, 0x44,
+   0x78, 0x5b, 0xc2, 0xdb, 0x7e, 0x8e, 0x1f, 0x39, 0xbc, 0xc4, 0xcc, 0xd4,
+   0x16, 0xb1, 0x82, 0x98, 0xba, 0x29, 0x45, 0x7a, 0x0a, 0xf7, 0x10, 0xf1,
+   0x72, 0xd3, 0x9f, 0x2a, 0xb6, 0x6a, 0x3c, 0xac, 0x1f, 0xe0, 0x61, 0xd5,
+   0x51, 0xe9, 0x08, 0x93, 0xc1, 0x7f, 0x88, 0x6f, 0x17, 0x01, 0xec, 0xd1,
+   0x57, 0x0b, 0xdf, 0xb1, 0xbb, 0xe4, 0x17, 0x97, 0xc1, 0xa3, 0xd8, 0x36,
+   0x67, 0x9e, 0xf0, 0x90, 0xd4, 0xe4, 0x10, 0xc7, 0x25, 0x2f, 0x3d, 0x17,
+   0x9e, 0x3b, 0x26, 0x67, 0x05, 0x0a, 0xa9, 0xb4, 0x29, 0x6d, 0x50, 0xa8,
+   0xe5, 0xf8, 0xa8, 0x43, 0xd4, 0xdc, 0x28, 0xa4, 0xd1, 0x55, 0x81, 0xce,
+   0x96, 0x46, 0x2b, 0x89, 0xa4, 0x2a, 0x2d, 0x34, 0x81, 0x1a, 0x28, 0xc7,
+   0x7d, 0xd6, 0x28, 0x74, 0xc6, 0xc5, 0x7d, 0xc8, 0x4b, 0x15, 0xfe, 0x31,
+   0xed, 0x13, 0xdc, 0x60, 0x29, 0xac, 0x94, 0xa7, 0x7d, 0x16, 0xf4, 0xb8,
+   0x4f, 0x28, 0xe3, 0x50, 0xaa, 0x71, 0x5f, 0x3a, 0xdd, 0x00, 0x94, 0x60,
+   0x93, 0x01, 0x46, 0xe1, 0x72, 0x34, 0x88, 0x2e, 0x48, 0x9d, 0x4e, 0xce,
+   0x64, 0x45, 0xb2, 0x08, 0xa8, 0x34, 0x47, 0x86, 0xc2, 0x71, 0x88, 0x43,
+   0x31, 0x4e, 0x35, 0x43, 0xc3, 0x2d, 0xc4, 0xa1, 0x48, 0xd3, 0xb0, 0x26,
+   0x15, 0xa5, 0x8d, 0x06, 0x86, 0x25, 0x2a, 0x08, 0xc3, 0x25, 0x34, 0xc2,
+   0xec, 0x7c, 0x41, 0x4f, 0x95, 0x65, 0xa0, 0x41, 0x4c, 0x29, 0x9d, 0x5f,
+   0x2a, 0x88, 0x43, 0x11, 0x47, 0x9e, 0x59, 0x49, 0x91, 0x29, 0x2b, 0x90,
+   0xe2, 0x4f, 0x91, 0xa1, 0xd4, 0x94, 0x42, 0x6d, 0xc6, 0x94, 0x51, 0x22,
+   0x34, 0x5a, 0x6b, 0x63, 0xca, 0x74, 0x28, 0xa1, 0x06, 0x73, 0x42, 0x9a,
+   0xcc, 0xb2, 0x49, 0x18, 0x0b, 0x6b, 0xb4, 0xd6, 0x96, 0x11, 0x2d, 0xe2,
+   0x1f, 0x05, 0x71, 0x36, 0x37, 0x74, 0x3e, 0xc4, 0xa1, 0x88, 0x23, 0xe5,
+   0xe2, 0x68, 0x33, 0x7d, 0xdf, 0x7d, 0x4c, 0x44, 0x15, 0x6c, 0xfc, 0x8b,
+   0xa7, 0x7b, 0xa6, 0x7d, 0x6e, 0xee, 0xe9, 0x1e, 0x54, 0x9f, 0x63, 0x32,
+   0x7d, 0xe1, 0x35, 0xb4, 0xfb, 0x92, 0xc3, 0xe2, 0x3d, 0x87, 0xf5, 0x94,
+   0xc3, 0x4b, 0x14, 0x23, 0x8d, 0x43, 0xc9, 0xa5, 0xe5, 0xd2, 0x4d, 0xc2,
+   0x9b, 0x9d, 0xcd, 0x2f, 0x4a, 0x70, 0xb4, 0x98, 0xbe, 0x73, 0xa9, 0xbc,
+   0x88, 0xf5, 0x9d, 0xb8, 0xd9, 0x6c, 0xc6, 0x8a, 0xe0, 0x81, 0x70, 0x88,
+   0xe6, 0x70, 0x2a, 0xe3, 0xe3, 0x75, 0x70, 0x72, 0x24, 0xbc, 0x59, 0xe6,
+   0x80, 0x8f, 0x78, 0x95, 0xbe, 0x0b, 0x43, 0x8c, 0x05, 0xb1, 0x5e, 0xda,
+   0x09, 0xd6, 0xa1, 0xd1, 0xb4, 0x42, 0xed, 0x20, 0xe8, 0xca, 0x8c, 0xb7,
+   0x8e, 0x3e, 0x9a, 0x1d, 0xdb, 0xaa, 0x74, 0xa5, 0x8c, 0xce, 0xdb, 0xbc,
+   0x1b, 0x81, 0x34, 0xd4, 0xb1, 0x4e, 0x4b, 0x67, 0xc4, 0xe4, 0x14, 0x24,
+   0x4e, 0x52, 0x25, 0x62, 0x9f, 0x1c, 0x56, 0xc7, 0xc6, 0xd5, 0x92, 0x2b,
+   0xeb, 0xc8, 0x02, 0x2d, 0xfd, 0xca, 0x28, 0xf3, 0xb8, 0x8a, 0xe2, 0x2f,
+   0x72, 0xc0, 0x63, 0x19, 0xf8, 0x71, 0x09, 0xad, 0x31, 0x98, 0x28, 0x1d,
+   0xd4, 0x7f, 0x28, 0x49, 0x7f, 0xc1, 0x1a, 0x09, 0x00, 0x00
+};
+
+/// RINEX 2 observation data.
+static const char *rinex2Obs =
+   "     2.11           OBSERVATION DATA    G (GPS)             RINEX VERSION / TYPE\n"
+   "DecompressTest      TEST                20200312 000000 UTC PGM / RUN BY / DATE\n"
+   "TEST                                                        MARKER NAME\n"
+   "TEST                TEST                                    OBSERVER / AGENCY\n"
+   "1                   TEST                1                   REC # / TYPE / VERS\n"
+   "1                   TEST                                    ANT # / TYPE\n"
+   "  1130000.0000 -4830000.0000  3990000.0000                  APPROX POSITION XYZ\n"
+   "        0.0000        0.0000        0.0000                  ANTENNA: DELTA H/E/N\n"
+   "     1     1                                                WAVELENGTH FACT L1/2\n"
+   "     6    C1    L1    L2    P2    D1    S1                  # / TYPES OF OBSERV\n"
+   "  2020     3    11    12     0    0.0000000     GPS         TIME OF FIRST OBS\n"
+   "                                                            END OF HEADER\n"
+   " 20  3 11 12  0  0.0000000  0  3G01G07G05                           -0.000123457\n"
+   "  20001234.567 6  20099999.999 7 -20198765.431          45.250       20396.296\n"
+   "     20495.061\n"
+   "  20008641.969 8  20107407.401 5 -20206172.833          45.250       20403.703\n"
+   "     20502.469\n"
+   "  20006172.835 6  20104938.267 7 -20203703.699          45.250       20401.234\n"
+   "     20499.999\n"
+   " 20  3 11 12  0 30.0000000  0  3G01G07G05                            0.000123457\n"
+   "  20001235.857 6  20100001.289 7 -20198766.721          45.375       20396.297\n"
+   "     20495.063\n"
+   "  20008643.577 8  20107409.009 5 -20206174.441          45.375       20403.705\n"
+   "     20502.470\n"
+   "  20006174.337 6  20104939.769 7 -20203705.201          45.375       20401.236\n"
+   "     20500.001\n"
+   " 20  3 11 12  1  0.0000000  0  4G01G07G05G31\n"
+   "  20001239.621 6  20100005.053 7 -20198770.485          45.500       20396.301\n"
+   "     20495.066\n"
+   "  20008647.659 8  20107413.091 5 -20206178.523          45.500       20403.709\n"
+   "     20502.474\n"
+   "  20006178.313 6  20104943.745 7 -20203709.177          45.500       20401.240\n"
+   "     20500.005\n"
+   "  20038279.811 8  20137045.243 5 -20235810.675          45.500       20433.341\n"
+   "     20532.106\n"
+   " 20  3 11 12  1 30.0000000  0 14G01G07G05G10G11G12G13G14G15G16G17G18-0.000123466\n"
+   "                                G19G31\n"
+   "  20001245.859 6  20100011.29117 -20198776.723          45.625       20396.307\n"
+   "     20495.073\n"
+   "  20008654.215 8  20107419.64715 -20206185.079          45.625       20403.715\n"
+   "     20502.481\n"
+   "\n"
+   "     20500.011\n"
+   "  20012358.393 7  20111123.82518 -20209889.257          45.625       20407.420\n"
+   "     20506.185\n"
+   "  20013593.119 8  20112358.55115 -20211123.983          45.625       20408.654\n"
+   "     20507.420\n"
+   "  20014827.845 5  20113593.27716 -20212358.709          45.625       20409.889\n"
+   "     20508.655\n"
+   "  20016062.571 6  20114828.00317 -20213593.435          45.625       20411.124\n"
+   "     20509.889\n"
+   "  20017297.297 7  20116062.72918 -20214828.161          45.625       20412.359\n"
+   "     20511.124\n"
+   "  20018532.023 8  20117297.45515 -20216062.887          45.625       20413.593\n"
+   "     20512.359\n"
+   "  20019766.749 5  20118532.18116 -20217297.613          45.625       20414.828\n"
+   "     20513.593\n"
+   "  20021001.475 6  20119766.90717 -20218532.339          45.625       20416.063\n"
+   "     20514.828\n"
+   "  20022236.201 7  20121001.63318 -20219767.065          45.625       20417.297\n"
+   "     20516.063\n"
+   "  20023470.927 8  20122236.35915 -20221001.791          45.625       20418.532\n"
+   "     20517.298\n"
+   "  20038287.639 8  20137053.07115 -20235818.503          45.625       20433.349\n"
+   "     20532.114\n"
+   "                            4  1\n"
+   "EVENT NUMBER 4                                              COMMENT\n"
+   " 20  3 11 12  2  0.0000000  0  4G01G07G05G31                         0.000123472\n"
+   "  20001254.571 6  20100020.003 7 -20198785.435          45.750       20396.316\n"
+   "     20495.081\n"
+   "  20008663.245 8  20107428.677 5 -20206194.109          45.750       20403.724\n"
+   "     20502.490\n"
+   "  20006193.687 6  20104959.119 7 -20203724.551          45.750       20401.255\n"
+   "     20500.020\n"
+   "  20038297.941 8  20137063.373 5 -20235828.805          45.750       20433.359\n"
+   "     20532.125\n"
+   " 20  3 11 12  2 30.0000000  0  4G01G07G05G31                         0.000123481\n"
+   "  20001265.757 6  20100031.189 7 -20198796.621          45.875       20396.327\n"
+   "     20495.092\n"
+   "  20008674.749 8                 -20206205.613                       20403.736\n"
+   "     20502.501\n"
+   "  20006205.085 6  20104970.517 7 -20203735.949          45.875       20401.266\n"
+   "     20500.032\n"
+   "  20038310.717 8  20137076.149 5 -20235841.581          45.875       20433.372\n"
+   "     20532.137\n"
+   " 20  3 11 12  3  0.0000000  0 14G01G07G05G10G11G12G13G14G15G16G17G18-0.000123493\n"
+   "                                G19G31\n"
+   "  20001279.417 6  20100044.849 7 -20198810.281          46.000       20396.341\n"
+   "     20495.106\n"
+   "  20008688.727 8  20107454.159 5 -20206219.591          46.000       20403.750\n"
+   "     20502.515\n"
+   "  20006218.957 6  20104984.389 7 -20203749.821          46.000       20401.280\n"
+   "     20500.046\n"
+   "  20012393.382 7  20111158.814 8 -20209924.246          46.000       20407.455\n"
+   "     20506.220\n"
+   "  20013628.267 8  20112393.699 5 -20211159.131          46.000       20408.689\n"
+   "     20507.455\n"
+   "  20014863.152 5  20113628.584 6 -20212394.016          46.000       20409.924\n"
+   "     20508.690\n"
+   "  20016098.037 6  20114863.469 7 -20213628.901          46.000       20411.159\n"
+   "     20509.925\n"
+   "  20017332.922 7  20116098.354 8 -20214863.786          46.000       20412.394\n"
+   "     20511.160\n"
+   "  20018567.807 8  20117333.239 5 -20216098.671          46.000       20413.629\n"
+   "     20512.394\n"
+   "  20019802.692 5  20118568.124 6 -20217333.556          46.000       20414.864\n"
+   "     20513.629\n"
+   "  20021037.577 6  20119803.009 7 -20218568.441          46.000       20416.099\n"
+   "     20514.864\n"
+   "  20022272.462 7  20121037.894 8 -20219803.326          46.000       20417.334\n"
+   "     20516.099\n"
+   "  20023507.347 8  20122272.779 5 -20221038.211          46.000       20418.569\n"
+   "     20517.334\n"
+   "  20038325.967 8  20137091.399 5 -20235856.831          46.000       20433.387\n"
+   "     20532.153\n"
+   " 20  3 11 12  3 30.0000000  0  4G01G07G05G31                         0.000123505\n"
+   "  20001295.551 6  20100060.983 7 -20198826.415          46.125       20396.357\n"
+   "     20495.122\n"
+   "  20008705.179 8  20107470.611 5 -20206236.043          46.125       20403.766\n"
+   "     20502.532\n"
+   "  20006235.303 6  20105000.735 7 -20203766.167          46.125       20401.297\n"
+   "     20500.062\n"
+   "  20038343.691 8  20137109.123 5 -20235874.555          46.125       20433.405\n"
+   "     20532.170\n";
+
+/// rinex2Obs in compact RINEX 1.0 form, compressed with compress.
+static const unsigned char crinex2ObsZ[] =
+{
+   0x1f, 0x9d, 0x90, 0x31, 0x5c, 0xc0, 0x00, 0x41, 0xb0, 0xa0, 0xc1, 0x83,
+   0x04, 0x87, 0x3c, 0x69, 0x02, 0x25, 0xc8, 0x10, 0x2a, 0x20, 0xa4, 0x24,
+   0x71, 0x52, 0x04, 0x0b, 0x08, 0x23, 0x4f, 0xa4, 0x34, 0x09, 0x02, 0x11,
+   0xa1, 0x47, 0x84, 0x43, 0x24, 0x52, 0xb4, 0x68, 0xa5, 0x88, 0x94, 0x29,
+   0x05, 0x5f, 0x80, 0xa0, 0x92, 0x05, 0x4a, 0x11, 0x05, 0x52, 0x9c, 0x60,
+   0x91, 0x11, 0xd2, 0xa2, 0x9d, 0x32, 0x72, 0x5c, 0xd0, 0x10, 0xe8, 0xe2,
+   0xc6, 0xc7, 0x9f, 0x08, 0x63, 0xc8, 0x68, 0xd1, 0x24, 0x8c, 0x9c, 0x16,
+   0x32, 0x06, 0xc2, 0x80, 0xa1, 0x63, 0xe9, 0xc1, 0x90, 0x13, 0x2b, 0x82,
+   0x80, 0x22, 0xe5, 0xc9, 0x11, 0x10, 0x2a, 0x89, 0x70, 0x7c, 0x79, 0x50,
+   0x86, 0x8b, 0x18, 0x31, 0x80, 0x82, 0x78, 0x22, 0x64, 0x8a, 0x49, 0x2b,
+   0x1c, 0x93, 0x3c, 0x71, 0x02, 0x42, 0x2b, 0x95, 0x20, 0x06, 0xaf, 0xa2,
+   0x38, 0x02, 0x65, 0x4a, 0x0a, 0xb1, 0x04, 0x45, 0x4a, 0x2d, 0x79, 0x52,
+   0x2d, 0x5b, 0x95, 0x2c, 0x5d, 0x2a, 0x20, 0x52, 0x66, 0xcc, 0x9b, 0x36,
+   0x70, 0xe4, 0x94, 0x99, 0x33, 0x87, 0xca, 0x62, 0x3a, 0x08, 0xa9, 0x14,
+   0x99, 0xd2, 0x11, 0x2f, 0xc1, 0xa4, 0x49, 0x61, 0xcc, 0x10, 0x0a, 0x62,
+   0xa9, 0xe7, 0x81, 0x55, 0xa8, 0x0c, 0x99, 0x7a, 0xa4, 0x09, 0xd6, 0x88,
+   0x55, 0xd8, 0x0a, 0xc9, 0x72, 0xda, 0xed, 0x4b, 0xc9, 0x94, 0x2d, 0xcb,
+   0x9e, 0x2d, 0x7b, 0xa3, 0x94, 0x25, 0x26, 0x41, 0x38, 0x09, 0xd2, 0xe4,
+   0xf5, 0xe4, 0xca, 0x96, 0x61, 0x03, 0xa7, 0x4d, 0x9b, 0xac, 0x59, 0x29,
+   0x7c, 0x4f, 0x07, 0x39, 0x52, 0xc4, 0xc9, 0x90, 0x2c, 0x0a, 0xc2, 0x12,
+   0x5f, 0xf9, 0x9b, 0xb6, 0x74, 0xe2, 0x52, 0x8a, 0x8c, 0x1e, 0x71, 0x3a,
+   0x70, 0x91, 0xd3, 0x7c, 0xa7, 0x44, 0x9f, 0x4e, 0x3d, 0x36, 0x79, 0xda,
+   0x41, 0x9c, 0x40, 0xe4, 0x0e, 0xb8, 0x25, 0x57, 0x10, 0x60, 0x67, 0x7c,
+   0x16, 0xe8, 0x19, 0x44, 0x0b, 0x1a, 0x38, 0xe4, 0x7b, 0xa6, 0xef, 0x14,
+   0xc4, 0x8c, 0x1c, 0x39, 0xcc, 0xf7, 0xd9, 0x74, 0x41, 0x40, 0x41, 0xd5,
+   0x13, 0x16, 0x41, 0xf1, 0xc4, 0x14, 0x49, 0x50, 0xe1, 0x17, 0x08, 0x58,
+   0x64, 0xa1, 0x85, 0x02, 0x1f, 0xc1, 0xc0, 0xdf, 0x40, 0x1e, 0x59, 0x38,
+   0x60, 0x86, 0x17, 0x12, 0xa8, 0x5e, 0x73, 0xbb, 0xe9, 0xd0, 0x56, 0x11,
+   0x4c, 0xbc, 0x05, 0x02, 0x12, 0x2f, 0x14, 0xf1, 0x82, 0x13, 0x14, 0x1a,
+   0x74, 0x1d, 0x41, 0x2f, 0x9e, 0x27, 0x63, 0x41, 0x57, 0x04, 0x51, 0x12,
+   0x13, 0xcd, 0x1d, 0x41, 0x05, 0x12, 0x17, 0x39, 0x04, 0x11, 0x13, 0x31,
+   0xbc, 0x20, 0x43, 0x8b, 0x05, 0xd9, 0x60, 0xd0, 0x10, 0x2f, 0x02, 0x69,
+   0x10, 0x13, 0x32, 0x18, 0x04, 0x45, 0x93, 0x05, 0x11, 0xf1, 0xe2, 0x14,
+   0x31, 0x5a, 0xc6, 0xde, 0x4a, 0xee, 0xa1, 0xf4, 0x84, 0x11, 0x63, 0x95,
+   0x75, 0x56, 0x8b, 0x98, 0x61, 0x58, 0xd0, 0x0c, 0x2e, 0xbe, 0xc8, 0x99,
+   0x41, 0x62, 0x76, 0x76, 0x61, 0x7d, 0x71, 0xd5, 0xf5, 0x93, 0x83, 0xbd,
+   0x8d, 0xc5, 0xa5, 0x11, 0x49, 0x9c, 0x04, 0x91, 0x71, 0x44, 0xce, 0xa8,
+   0x27, 0x5e, 0xcd, 0x11, 0x21, 0xe7, 0x89, 0x45, 0x04, 0x41, 0x84, 0x49,
+   0x0a, 0x98, 0x90, 0x14, 0x41, 0x64, 0x82, 0x05, 0x1f, 0x94, 0x18, 0x6a,
+   0xf8, 0x59, 0x7f, 0x18, 0xce, 0x70, 0x04, 0x0c, 0x31, 0x4c, 0x7a, 0xc3,
+   0xa4, 0x35, 0x28, 0x30, 0x83, 0x09, 0x2d, 0x08, 0x35, 0x03, 0x0d, 0x35,
+   0xdc, 0xa0, 0xa9, 0xa1, 0x9e, 0x79, 0x0a, 0xaa, 0x0d, 0x3e, 0x6d, 0x9a,
+   0x19, 0x80, 0xac, 0xb2, 0xea, 0x1f, 0xa7, 0x49, 0xc5, 0x90, 0x03, 0x0e,
+   0x37, 0xd8, 0x50, 0x03, 0x0d, 0x9b, 0xbd, 0x0a, 0xaa, 0x0c, 0x35, 0x0c,
+   0xa4, 0xaa, 0x66, 0x39, 0xd8, 0x20, 0x43, 0xb0, 0xaf, 0x26, 0x45, 0x43,
+   0x0e, 0xbd, 0xda, 0x20, 0x9d, 0x91, 0xa2, 0xfe, 0xba, 0x14, 0x0e, 0x36,
+   0xd0, 0x20, 0xab, 0x0d, 0x39, 0x14, 0x4b, 0x29, 0x0c, 0x37, 0xd0, 0x80,
+   0xad, 0xb6, 0x61, 0x6d, 0x8a, 0x14, 0x0c, 0x49, 0x29, 0x7b, 0x83, 0x0c,
+   0xf9, 0x91, 0xb9, 0xe9, 0xae, 0xbd, 0x5a, 0xab, 0xed, 0x0c, 0x37, 0x68,
+   0x66, 0x6d, 0xaf, 0x32, 0xd0, 0x40, 0x2d, 0x41, 0x38, 0x80, 0x90, 0xa9,
+   0xb3, 0x30, 0x88, 0x4b, 0xee, 0x0c, 0x35, 0x58, 0x1b, 0x03, 0x0c, 0xc7,
+   0xce, 0x80, 0x83, 0x0c, 0xa8, 0xbe, 0xfa, 0x6d, 0x52, 0xec, 0x6a, 0x46,
+   0x6d, 0xb5, 0xe7, 0xd6, 0xc0, 0xab, 0xaf, 0xa4, 0x72, 0x2b, 0xc3, 0xa7,
+   0xea, 0xb6, 0x5a, 0x2d, 0x08, 0xcc, 0xe6, 0x89, 0xd7, 0x0c, 0x0a, 0xc4,
+   0x4b, 0x6d, 0x0c, 0x34, 0x44, 0x37, 0xec, 0x40, 0x42, 0x05, 0x68, 0x5f,
+   0xc9, 0x24, 0xf3, 0x0a, 0x1f, 0x08, 0x43, 0xc6, 0x60, 0x03, 0x0c, 0xf5,
+   0xba, 0x0c, 0xf3, 0xc9, 0x2f, 0xc7, 0xac, 0x72, 0x93, 0x31, 0x44, 0x07,
+   0x2f, 0x7c, 0x3b, 0x77, 0xba, 0xb3, 0x50, 0xfd, 0x36, 0x39, 0xa4, 0x6c,
+   0x61, 0x99, 0x20, 0x1b, 0x0d, 0x3f, 0x1d, 0xb1, 0x99, 0x02, 0x1d, 0xd3,
+   0x90, 0x2d, 0xcb, 0x4e, 0x23, 0x8d, 0x54, 0xd4, 0x9d, 0xf9, 0x07, 0x5f,
+   0xd3, 0x4f, 0xc7, 0xfb, 0xf4, 0xd4, 0x4f, 0x0f, 0xd4, 0x24, 0xc7, 0x5a,
+   0x23, 0x1d, 0xb6, 0x7d, 0x63, 0x7b, 0xcd, 0xf2, 0xa8, 0x99, 0x09, 0x2c,
+   0xc3, 0x0d, 0xb3, 0x2a, 0xfa, 0x6b, 0x0c, 0x09, 0xef, 0x8a, 0xab, 0xc1,
+   0x98, 0xf1, 0x8b, 0xc3, 0xbf, 0xa8, 0xf6, 0xdb, 0x70, 0xaf, 0x10, 0x1b,
+   0x3b, 0xc3, 0xdf, 0xd2, 0xbe, 0x3b, 0x83, 0x0c, 0x78, 0xd3, 0x6b, 0xaf,
+   0xc6, 0x62, 0x91, 0x89, 0x57, 0x95, 0x07, 0xfd, 0x7b, 0x04, 0x58, 0x8f,
+   0xcb, 0xf0, 0xb8, 0xa4, 0x20, 0x3f, 0x5e, 0xc3, 0xe3, 0x36, 0x3c, 0x7e,
+   0x69, 0x0c, 0x38, 0x3c, 0x9e, 0x83, 0xd2, 0x39, 0x7b, 0x6b, 0xaa, 0x0d,
+   0x36, 0x28, 0xa0, 0x54, 0xd5, 0x03, 0x75, 0x6a, 0x35, 0x8c, 0xa6, 0xa3,
+   0xee, 0xba, 0x98, 0x39, 0x1f, 0x84, 0xa1, 0xd1, 0x26, 0xa0, 0xbd, 0x94,
+   0xa7, 0x35, 0xe4, 0x97, 0x83, 0xb9, 0xa4, 0x82, 0x05, 0xd6, 0xc4, 0x03,
+   0xeb, 0x0d, 0x2b, 0xb8, 0x30, 0xcc, 0x8a, 0x43, 0x0e, 0xbc, 0xa6, 0x6a,
+   0xc2, 0xa9, 0x2a, 0xff, 0xaa, 0x6d, 0xb6, 0x87, 0xfe, 0x9a, 0x2c, 0xe7,
+   0xfd, 0x82, 0x70, 0x03, 0xe7, 0xb6, 0x53, 0xca, 0xef, 0xee, 0x60, 0x31,
+   0xdc, 0x3b, 0xee, 0x38, 0xd4, 0x50, 0x43, 0xb7, 0xc3, 0x13, 0xfe, 0xfb,
+   0x7f, 0xf9, 0xe9, 0x5a, 0x83, 0xb0, 0xc2, 0x1b, 0x0b, 0xb3, 0xad, 0x48,
+   0x4b, 0xbf, 0xed, 0xa1, 0x20, 0xdc, 0x7d, 0x2f, 0xa9, 0x94, 0xe2, 0xb7,
+   0x36, 0x0e, 0xa0, 0xfa, 0x0b, 0x77, 0x0d, 0xbb, 0x5b, 0x9b, 0xf2, 0x0e,
+   0x06, 0xbe, 0x76, 0x79, 0x8f, 0x79, 0xed, 0x03, 0x58, 0xf1, 0x70, 0x70,
+   0xbc, 0x77, 0xbd, 0x4f, 0x7c, 0x04, 0x19, 0x5f, 0xe9, 0x9c, 0x25, 0x33,
+   0xf6, 0x5d, 0xcf, 0x7f, 0xfa, 0xc3, 0xc1, 0x52, 0x78, 0x47, 0xc0, 0xed,
+   0x7d, 0x8a, 0x5f, 0xea, 0x63, 0x9f, 0xba, 0x7c, 0x17, 0x2f, 0x07, 0x1a,
+   0xef, 0x62, 0xe2, 0xca, 0x5e, 0x0c, 0xc6, 0x95, 0x03, 0x16, 0x2a, 0x2f,
+   0x56, 0x15, 0x5c, 0xdb, 0xb0, 0xe8, 0x06, 0x2e, 0x90, 0x0d, 0xec, 0x6e,
+   0xca, 0x0a, 0x61, 0xf3, 0x22, 0x86, 0x3b, 0xef, 0x25, 0x65, 0x7c, 0xbf,
+   0x43, 0x9a, 0xf5, 0xb0, 0x47, 0xc1, 0xf0, 0x0d, 0x0e, 0x5c, 0xbc, 0x83,
+   0xa1, 0x0b, 0x41, 0x25, 0x3c, 0x02, 0xbe, 0x4c, 0x58, 0x0c, 0x54, 0x1e,
+   0x02, 0x47, 0xe8, 0xc1, 0x77, 0xf5, 0x90, 0x5e, 0x31, 0xb8, 0x5f, 0x66,
+   0x64, 0x55, 0x2b, 0x54, 0x1d, 0xcb, 0x7f, 0x46, 0x24, 0xdc, 0xdd, 0x68,
+   0x48, 0x38, 0x17, 0x2a, 0x8b, 0x77, 0x53, 0x74, 0x9e, 0x0d, 0xc9, 0x65,
+   0xc5, 0x2a, 0xda, 0xcb, 0x65, 0xd9, 0x23, 0xdc, 0xed, 0x9c, 0x96, 0xc0,
+   0xee, 0x75, 0x31, 0x40, 0x03, 0xc4, 0x0c, 0xf5, 0x06, 0xf7, 0xb7, 0x03,
+   0xae, 0x6f, 0x87, 0xc6, 0xaa, 0x60, 0x12, 0x61, 0x30, 0xbe, 0x0c, 0x12,
+   0x24, 0x85, 0xce, 0x92, 0x81, 0x22, 0x67, 0x20, 0x2c, 0x4a, 0xf9, 0x4b,
+   0x8e, 0x94, 0xb2, 0xc1, 0xdf, 0xc8, 0xc8, 0x45, 0x54, 0xe5, 0x4b, 0x78,
+   0x69, 0xe4, 0xa1, 0x0b, 0xad, 0xf8, 0x44, 0xc5, 0x5d, 0x0f, 0x07, 0x71,
+   0xfc, 0x94, 0x01, 0xd7, 0xf6, 0xc8, 0x45, 0x4a, 0x12, 0x80, 0x64, 0x84,
+   0xe4, 0x0a, 0x73, 0x40, 0xbe, 0x4c, 0x06, 0x32, 0x8c, 0x56, 0x64, 0x61,
+   0xbd, 0xea, 0x97, 0x45, 0x05, 0xdc, 0xe0, 0x86, 0xd6, 0xc3, 0x65, 0x0b,
+   0x6e, 0xc9, 0x46, 0xa0, 0xd5, 0xef, 0x97, 0xac, 0x33, 0xda, 0x9e, 0x08,
+   0x22, 0xc4, 0x9c, 0x15, 0xa1, 0x24, 0xea, 0xd1, 0x4d, 0x15, 0x9a, 0x20,
+   0x84, 0xdc, 0x08, 0x71, 0x98, 0xe4, 0x51, 0x48, 0x13, 0x7a, 0xa3, 0x9e,
+   0x42, 0xd1, 0x2f, 0x51, 0x61, 0x39, 0x13, 0xa3, 0xd6, 0x04, 0x29, 0x62,
+   0x4e, 0xaa, 0x52, 0xd8, 0xc2, 0x14, 0xe8, 0x9a, 0x46, 0x2d, 0x81, 0xb5,
+   0xee, 0x74, 0x24, 0xb3, 0x8f, 0xe2, 0x40, 0x50, 0x3b, 0x74, 0x56, 0x2d,
+   0x2c, 0xaa, 0x23, 0x48, 0xed, 0xf0, 0xa5, 0xac, 0xdd, 0xd9, 0x80, 0x56,
+   0xfe, 0x02, 0x18, 0xb2, 0x58, 0x29, 0x2b, 0x32, 0x6a, 0x66, 0x5c, 0x4c,
+   0x6c, 0x65, 0xa8, 0xd2, 0xe5, 0x3c, 0x4a, 0xf1, 0xaa, 0x5f, 0xcb, 0xb2,
+   0x1e, 0xd6, 0xc4, 0x46, 0x35, 0xae, 0x21, 0xcd, 0x6c, 0xeb, 0xac, 0x1d,
+   0x6d, 0x38, 0x36, 0x35, 0x6a, 0x0d, 0xeb, 0x9c, 0xae, 0x53, 0xdd, 0x90,
+   0x1a, 0x45, 0x90, 0xd3, 0x15, 0xa4, 0x76, 0xf1, 0x99, 0x15, 0x7c, 0xe0,
+   0x26, 0xd2, 0x4e, 0x91, 0xd4, 0x66, 0x08, 0x0d, 0x0b, 0x0c, 0x30, 0x7a,
+   0x3a, 0x78, 0x0e, 0xcd, 0x32, 0x64, 0x12, 0xa6, 0x58, 0x18, 0xe7, 0x22,
+   0x18, 0x3c, 0xae, 0x52, 0x42, 0x99, 0xdc, 0xe3, 0x68, 0x60, 0x39, 0xcc,
+   0x69, 0xee, 0x71, 0x9d, 0x93, 0xd5, 0x38, 0x5b, 0x70, 0x2b, 0x96, 0xbe,
+   0xb3, 0x33, 0xad, 0x7b, 0xdb, 0xb6, 0x6e, 0x95, 0xc5, 0x6a, 0x41, 0x4c,
+   0x5e, 0xf5, 0x51, 0xdd, 0x8b, 0x32, 0x35, 0xb6, 0xb1, 0x39, 0xb4, 0x6a,
+   0x64, 0xea, 0x94, 0x0a, 0x27, 0xb6, 0x3b, 0xb5, 0xf9, 0x0f, 0x2c, 0xb9,
+   0xbb, 0x5b, 0xfc, 0xca, 0x57, 0x3c, 0xe4, 0xd1, 0xc0, 0x63, 0xba, 0x7a,
+   0x99, 0x53, 0x0a, 0x9a, 0x2d, 0x08, 0xca, 0x4f, 0x58, 0xf4, 0xf3, 0x09,
+   0x28, 0x29, 0xc8, 0x48, 0x72, 0x11, 0xec, 0x85, 0x94, 0xf2, 0x94, 0x3d,
+   0x01, 0x44, 0x49, 0xb0, 0xb2, 0x32, 0x57, 0xe7, 0x52, 0x6b, 0xdf, 0x14,
+   0x08, 0xad, 0x06, 0xca, 0xaf, 0xad, 0xd5, 0xab, 0x97, 0x16, 0xe7, 0x08,
+   0xad, 0xcd, 0x38, 0xcc, 0x7f, 0x75, 0x0d, 0x1f, 0xff, 0x28, 0xc9, 0x55,
+   0x6e, 0x19, 0x29, 0xb0, 0xf5, 0x29, 0x28, 0x80, 0x4a, 0x28, 0x3f, 0x68,
+   0x99, 0xcc, 0x5e, 0x18, 0x53, 0xe1, 0xcb, 0x66, 0xf5, 0x4f, 0x0c, 0x36,
+   0x56, 0x5e, 0xde, 0xeb, 0x20, 0x14, 0x03, 0xd4, 0x4a, 0xc1, 0x8e, 0xd0,
+   0xaf, 0x26, 0x44, 0x5e, 0xf5, 0x32, 0x46, 0xc1, 0x1b, 0xfc, 0x6d, 0x58,
+   0x8a, 0xf4, 0xdf, 0x68, 0xf3, 0x73, 0x2b, 0x4a, 0xe2, 0x47, 0x92, 0xb7,
+   0xbc, 0xec, 0xf2, 0x5c, 0xab, 0xc6, 0xca, 0x5a, 0x11, 0x2c, 0x2f, 0x23,
+   0x88, 0x5c, 0x55, 0x18, 0x3e, 0x54, 0x69, 0x10, 0xaf, 0x60, 0xb1, 0xed,
+   0x6d, 0xff, 0x43, 0xc9, 0xdd, 0xa2, 0xaa, 0xb5, 0x99, 0xe5, 0x61, 0x5d,
+   0x7d, 0x48, 0x48, 0xbd, 0x0a, 0x51, 0xb1, 0x2a, 0x24, 0x2d, 0xc1, 0x90,
+   0x07, 0xc6, 0xf5, 0xdd, 0x8d, 0xb3, 0xe5, 0x5b, 0xe1, 0xdf, 0xf8, 0xb5,
+   0xbe, 0xb4, 0x66, 0x37, 0x90, 0xbf, 0x1d, 0xeb, 0x0f, 0xe1, 0x26, 0xac,
+   0x8b, 0xf5, 0x6b, 0x82, 0xf8, 0x93, 0x23, 0xbb, 0x42, 0x05, 0x5d, 0x59,
+   0x69, 0x50, 0x3f, 0xa9, 0xd5, 0x63, 0x73, 0xf9, 0x17, 0x38, 0xcc, 0xae,
+   0x95, 0x87, 0xa3, 0xe5, 0x6e, 0x21, 0xa1, 0x25, 0x44, 0xda, 0xe6, 0x57,
+   0x91, 0x00, 0x15, 0xd6, 0x23, 0xff, 0xc5, 0xae, 0xe3, 0x8d, 0x95, 0x80,
+   0xa4, 0xbd, 0xad, 0x70, 0xa1, 0x7a, 0xe0, 0x40, 0x4a, 0x57, 0xbe, 0xdd,
+   0x4d, 0xb0, 0x72, 0xeb, 0x17, 0xca, 0x5e, 0xd9, 0xd6, 0x69, 0xa5, 0x94,
+   0xe1, 0x0d, 0xd8, 0x96, 0x4a, 0x0a, 0x0f, 0xcc, 0x6d, 0xc3, 0x7d, 0x2f,
+   0xc0, 0xa8, 0x37, 0x2f, 0xe9, 0xa9, 0x97, 0x62, 0xbf, 0xcc, 0x94, 0x3b,
+   0x53, 0xd7, 0x2d, 0xc4, 0x01, 0x65, 0x9d, 0x40, 0x91, 0xe9, 0x47, 0x36,
+   0x63, 0x82, 0x22, 0x1b, 0xf9, 0xc8, 0x48, 0x4e, 0xb2, 0x92, 0x8b, 0x6c,
+   0x4b, 0x6d, 0x21, 0x4b, 0xc7, 0xaf, 0x3b, 0xd9, 0xc9, 0x5a, 0xe7, 0xb2,
+   0x5d, 0xbd, 0x53, 0x65, 0x4a, 0x31, 0x2a, 0x3a, 0xb5, 0xbc, 0xb2, 0x16,
+   0x70, 0x0c
+};
+
+
+/** Test the reading of compressed files through FFTextStream,
+ * using DecompressStreamBuf and its children. */
+class DecompressStreamBuf_T
+{
+public:
+      /// Read compact RINEX 3.0.
+   unsigned crx3Test();
+      /// Read gzip compressed compact RINEX 3.0.
+   unsigned gzipTest();
+      /// Read compress (.Z) compressed compact RINEX 1.0.
+   unsigned lzwTest();
+      /// Make sure errors in compressed data are reported.
+   unsigned errorTest();
+      /// Make sure close removes the decompression layers.
+   unsigned closeTest();
+
+      /// Write data to a file in the test temp directory.
+   static std::string writeFile(const std::string& name, const char *data,
+                                std::size_t size);
+      /// Write text to a file in the test temp directory.
+   static std::string writeFile(const std::string& name, const char *text)
+   { return writeFile(name, text, std::string(text).size()); }
+      /// Read every line of a file with FFTextStream.
+   static std::vector<std::string> readLines(const std::string& fn,
+                                             bool& compressed);
+      /// Split text into lines.
+   static std::vector<std::string> splitLines(const std::string& text);
+      /// Compare the lines read from a file with the expected text.
+   static void compareLines(gnsstk::TestUtil& testFramework,
+                            const std::string& fn, const char *text);
+      /// Format all the observations of a RINEX 3 record.
+   static std::string obsString(const gnsstk::Rinex3ObsData& rod);
+      /// Format all the observations of a RINEX 2 record.
+   static std::string obsString(const gnsstk::RinexObsData& rod);
+};
+
+
+std::string DecompressStreamBuf_T ::
+writeFile(const std::string& name, const char *data, std::size_t size)
+{
+   std::string fn = gnsstk::getPathTestTemp() + gnsstk::getFileSep() + name;
+   std::ofstream os(fn.c_str(), std::ios::out | std::ios::binary);
+   os.write(data, size);
+   return fn;
+}
+
+
+std::vector<std::string> DecompressStreamBuf_T ::
+readLines(const std::string& fn, bool& compressed)
+{
+   std::vector<std::string> rv;
+   gnsstk::FFTextStream strm(fn.c_str(), std::ios::in);
+   compressed = strm.isCompressed();
+   std::string line;
+   try
+   {
+      while (true)
+      {
+         strm.formattedGetLine(line, true);
+         rv.push_back(line);
+      }
+   }
+   catch (gnsstk::EndOfFile&)
+   {
+   }
+   return rv;
+}
+
+
+std::vector<std::string> DecompressStreamBuf_T ::
+splitLines(const std::string& text)
+{
+   std::vector<std::string> rv;
+   std::istringstream iss(text);
+   std::string line;
+   while (std::getline(iss, line))
+   {
+      rv.push_back(line);
+   }
+   return rv;
+}
+
+
+void DecompressStreamBuf_T ::
+compareLines(gnsstk::TestUtil& testFramework, const std::string& fn,
+             const char *text)
+{
+   bool compressed = false;
+   std::vector<std::string> exp = splitLines(text);
+   std::vector<std::string> got = readLines(fn, compressed);
+   TUASSERT(compressed);
+   TUASSERTE(std::size_t, exp.size(), got.size());
+   for (std::size_t i = 0; (i < exp.size()) && (i < got.size()); i++)
+   {
+      TUASSERTE(std::string, exp[i], got[i]);
+   }
+}
+
+
+std::string DecompressStreamBuf_T ::
+obsString(const gnsstk::Rinex3ObsData& rod)
+{
+   std::string rv;
+   for (const auto& sati : rod.obs)
+   {
+      rv += sati.first.toString();
+      for (const auto& datum : sati.second)
+      {
+         rv += datum.asString();
+      }
+      rv += "\n";
+   }
+   return rv;
+}
+
+
+std::string DecompressStreamBuf_T ::
+obsString(const gnsstk::RinexObsData& rod)
+{
+   std::string rv;
+   for (const auto& sati : rod.obs)
+   {
+      rv += gnsstk::RinexSatID(sati.first).toString();
+      for (const auto& obsi : sati.second)
+      {
+         rv += obsi.first.type + obsi.second.asString();
+      }
+      rv += "\n";
+   }
+   return rv;
+}
+
+
+unsigned DecompressStreamBuf_T ::
+crx3Test()
+{
+   TUDEF("HatanakaStreamBuf", "fill");
+   std::string crxfn = writeFile("DecompressStreamBuf_T.crx", crinex3Obs);
+   std::string rnxfn = writeFile("DecompressStreamBuf_T.rnx", rinex3Obs);
+   compareLines(testFramework, crxfn, rinex3Obs);
+   bool compressed = true;
+   readLines(rnxfn, compressed);
+   TUASSERT(!compressed);
+      // Read the records too.
+   TUCSM("operator>>");
+   gnsstk::Rinex3ObsStream crx(crxfn.c_str()), rnx(rnxfn.c_str());
+   gnsstk::Rinex3ObsHeader crxHdr, rnxHdr;
+   gnsstk::Rinex3ObsData crxData, rnxData;
+   crx.exceptions(std::fstream::failbit);
+   rnx.exceptions(std::fstream::failbit);
+   TUCATCH(crx >> crxHdr);
+   TUCATCH(rnx >> rnxHdr);
+   unsigned count = 0;
+   while (rnx >> rnxData)
+   {
+      TUASSERT(static_cast<bool>(crx >> crxData));
+      TUASSERTE(gnsstk::CommonTime, rnxData.time, crxData.time);
+      TUASSERTE(short, rnxData.epochFlag, crxData.epochFlag);
+      TUASSERTE(short, rnxData.numSVs, crxData.numSVs);
+      TUASSERTFE(rnxData.clockOffset, crxData.clockOffset);
+      TUASSERTE(std::string, obsString(rnxData), obsString(crxData));
+      TUASSERTE(unsigned, rnx.lineNumber, crx.lineNumber);
+      count++;
+   }
+   TUASSERTE(unsigned, 10, count);
+   TUASSERT(!(crx >> crxData));
+   TURETURN();
+}
+
+
+unsigned DecompressStreamBuf_T ::
+gzipTest()
+{
+   TUDEF("GzipStreamBuf", "fill");
+   std::string fn = writeFile("DecompressStreamBuf_T.crx.gz",
+                              (const char*)crinex3ObsGz,
+                              sizeof(crinex3ObsGz));
+   if (!gnsstk::GzipStreamBuf::available())
+   {
+         // Built without zlib, so the file can't be opened.
+      gnsstk::FFTextStream strm(fn.c_str(), std::ios::in);
+      TUASSERT(!strm);
+      TURETURN();
+   }
+   compareLines(testFramework, fn, rinex3Obs);
+   TURETURN();
+}
+
+
+unsigned DecompressStreamBuf_T ::
+lzwTest()
+{
+   TUDEF("LZWStreamBuf", "fill");
+   std::string zfn = writeFile("DecompressStreamBuf_T.crx.Z",
+                               (const char*)crinex2ObsZ,
+                               sizeof(crinex2ObsZ));
+   std::string rnxfn = writeFile("DecompressStreamBuf_T.11o", rinex2Obs);
+   compareLines(testFramework, zfn, rinex2Obs);
+   TUCSM("operator>>");
+   gnsstk::RinexObsStream crx(zfn.c_str()), rnx(rnxfn.c_str());
+   gnsstk::RinexObsHeader crxHdr, rnxHdr;
+   gnsstk::RinexObsData crxData, rnxData;
+   crx.exceptions(std::fstream::failbit);
+   rnx.exceptions(std::fstream::failbit);
+   TUCATCH(crx >> crxHdr);
+   TUCATCH(rnx >> rnxHdr);
+   unsigned count = 0;
+   while (rnx >> rnxData)
+   {
+      TUASSERT(static_cast<bool>(crx >> crxData));
+      TUASSERTE(gnsstk::CommonTime, rnxData.time, crxData.time);
+      TUASSERTE(short, rnxData.epochFlag, crxData.epochFlag);
+      TUASSERTE(short, rnxData.numSvs, crxData.numSvs);
+      TUASSERTFE(rnxData.clockOffset, crxData.clockOffset);
+      TUASSERTE(std::string, obsString(rnxData), obsString(crxData));
+      count++;
+   }
+      // RinexObsData skips the event record.
+   TUASSERTE(unsigned, 8, count);
+   TURETURN();
+}
+
+
+unsigned DecompressStreamBuf_T ::
+errorTest()
+{
+   TUDEF("FFTextStream", "formattedGetLine");
+      // Break the arc of the first GPS satellite in the second epoch.
+   std::string bad(crinex3Obs);
+   std::string::size_type pos = bad.find("\n1290 1290 -1290 125\n");
+   TUASSERT(pos != std::string::npos);
+   bad.replace(pos+1, 4, "12x0");
+   std::string fn = writeFile("DecompressStreamBuf_T_bad.crx", bad.c_str());
+   gnsstk::Rinex3ObsStream strm(fn.c_str());
+   gnsstk::Rinex3ObsHeader hdr;
+   gnsstk::Rinex3ObsData data;
+   strm.exceptions(std::fstream::failbit);
+   TUCATCH(strm >> hdr);
+   TUCATCH(strm >> data);
+   try
+   {
+      strm >> data;
+      TUFAIL("Expected an exception");
+   }
+   catch (gnsstk::Exception& exc)
+   {
+      std::string text = exc.what();
+      TUASSERT(text.find("Invalid compact RINEX data: 12x0") !=
+               std::string::npos);
+         // The error is reported at the start of the epoch
+         // containing the bad data.
+      TUASSERT(text.find("Near file line 18") != std::string::npos);
+   }
+   if (gnsstk::GzipStreamBuf::available())
+   {
+      fn = writeFile("DecompressStreamBuf_T_short.crx.gz",
+                     (const char*)crinex3ObsGz, 3*sizeof(crinex3ObsGz)/4);
+      gnsstk::FFTextStream tstrm(fn.c_str(), std::ios::in);
+      std::string line;
+      unsigned count = 0;
+      try
+      {
+         while (true)
+         {
+            tstrm.formattedGetLine(line, true);
+            count++;
+         }
+      }
+      catch (gnsstk::EndOfFile&)
+      {
+         TUFAIL("Truncated file read without error");
+      }
+      catch (gnsstk::Exception& exc)
+      {
+         TUASSERT(exc.what().find("Truncated gzip data") !=
+                  std::string::npos);
+      }
+         // Whatever could be decompressed was read first.
+      TUASSERT(count > 12);
+   }
+   TURETURN();
+}
+
+
+unsigned DecompressStreamBuf_T ::
+closeTest()
+{
+   TUDEF("FFTextStream", "close");
+   std::string crxfn = writeFile("DecompressStreamBuf_T_close.crx",
+                                 crinex3Obs);
+   std::string rnxfn = writeFile("DecompressStreamBuf_T_close.rnx",
+                                 rinex3Obs);
+   std::vector<std::string> exp = splitLines(rinex3Obs);
+   std::string line;
+   gnsstk::FFTextStream strm(crxfn.c_str(), std::ios::in);
+   TUASSERT(strm.isCompressed());
+   TUCATCH(strm.formattedGetLine(line));
+   TUASSERTE(std::string, exp[0], line);
+   strm.close();
+   TUASSERT(!strm.is_open());
+   TUASSERT(!strm.isCompressed());
+      // Nothing that was already decompressed may still be read.
+   TUTHROW(strm.formattedGetLine(line));
+      // Reopen a file without going through FFTextStream::open.
+   strm.clear();
+   strm.std::fstream::open(rnxfn.c_str(), std::ios::in);
+   TUASSERT(strm.is_open());
+   TUASSERT(!strm.isCompressed());
+   TUCATCH(strm.formattedGetLine(line));
+   TUASSERTE(std::string, exp[0], line);
+   TUCATCH(strm.formattedGetLine(line));
+   TUASSERTE(std::string, exp[1], line);
+   strm.close();
+      // Reopen a compressed file after close.
+   strm.clear();
+   strm.open(crxfn.c_str(), std::ios::in);
+   TUASSERT(strm.isCompressed());
+   TUCATCH(strm.formattedGetLine(line));
+   TUASSERTE(std::string, exp[0], line);
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   DecompressStreamBuf_T testClass;
+
+   errorTotal += testClass.crx3Test();
+   errorTotal += testClass.gzipTest();
+   errorTotal += testClass.lzwTest();
+   errorTotal += testClass.errorTest();
+   errorTotal += testClass.closeTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
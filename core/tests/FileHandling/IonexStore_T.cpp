@@ -0,0 +1,106 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+#include <sstream>
+#include "IonexStore.hpp"
+#include "CivilTime.hpp"
+#include "TestUtil.hpp"
+
+
+class IonexStore_T
+{
+public:
+      /// Make sure times in an incompatible time system are rejected.
+   unsigned timeSystemTest();
+};
+
+
+unsigned IonexStore_T ::
+timeSystemTest()
+{
+   TUDEF("IonexStore", "addMap");
+   gnsstk::IonexStore store;
+   gnsstk::IonexData iod;
+   gnsstk::CommonTime t0 =
+      gnsstk::CivilTime(2015,7,19,0,0,0,gnsstk::TimeSystem::GPS);
+   gnsstk::CommonTime t1(t0), tu(t0), ta(t0);
+   t1 += 7200;
+   tu += 3600;
+   tu.setTimeSystem(gnsstk::TimeSystem::UTC);
+   ta += 3600;
+   ta.setTimeSystem(gnsstk::TimeSystem::Any);
+   iod.type = gnsstk::IonexData::TEC;
+   iod.time = t0;
+   TUCATCH(store.addMap(iod));
+   iod.time = t1;
+   TUCATCH(store.addMap(iod));
+   iod.time = tu;
+   TUTHROW(store.addMap(iod));
+      // The map in the wrong time system must not have been added.
+   std::ostringstream s;
+   store.dump(s, 0);
+   TUASSERT(s.str().find("# 2 epochs") != std::string::npos);
+   TUASSERTE(gnsstk::CommonTime, t0, store.getInitialTime());
+   TUASSERTE(gnsstk::CommonTime, t1, store.getFinalTime());
+      // TimeSystem::Any is compatible with everything.
+   iod.time = ta;
+   TUCATCH(store.addMap(iod));
+   s.str("");
+   store.dump(s, 0);
+   TUASSERT(s.str().find("# 3 epochs") != std::string::npos);
+   TUCSM("getIonexValue");
+   gnsstk::Position rx(30.0, -97.0, 6371000.0, gnsstk::Position::Geocentric);
+   TUTHROW(store.getIonexValue(tu, rx));
+   TUCSM("findDCB");
+   TUTHROW(store.findDCB(gnsstk::SatID(1, gnsstk::SatelliteSystem::GPS), tu));
+   TURETURN();
+}
+
+
+int main()
+{
+   IonexStore_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.timeSystemTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
@@ -40,6 +40,8 @@
 #include "Rinex3ObsHeader.hpp"
 #include "Rinex3ObsData.hpp"
 #include "TestUtil.hpp"
+#include <cstring>
+#include <fstream>
 #include <iostream>
 #include <string>
 
@@ -66,6 +68,9 @@ public:
    unsigned ionoDelayTest();
       /// Make sure reusing a stream object doesn't break.
    unsigned reopenTest();
+      /** Make sure the fastRead mode of Rinex3ObsStream produces the
+       * same records as the default reader. */
+   unsigned fastReadTest();
       /// generic filling of generic data.
    void setObs(gnsstk::TestUtil& testFramework, const std::string& system,
                gnsstk::Rinex3ObsHeader& hdr, gnsstk::Rinex3ObsData& rod);
@@ -624,6 +629,107 @@ reopenTest()
 }
 
 
+unsigned Rinex3ObsOther_T ::
+fastReadTest()
+{
+   TUDEF("Rinex3ObsData", "reallyGetRecord (fastRead)");
+   std::string fn = gnsstk::getPathTestTemp() + gnsstk::getFileSep() +
+      "rinex3ObsTest_fastRead.out";
+   double cv = gnsstk::Rinex3ObsBase::currentVersion;
+      // Write a header with the usual writer...
+   {
+      gnsstk::Rinex3ObsStream strm(fn, std::ios::out | std::ios::trunc);
+      gnsstk::Rinex3ObsHeader hdr;
+      strm.exceptions(std::fstream::failbit);
+      hdr.mapObsTypes["G"].push_back(gnsstk::RinexObsID("GC1C", cv));
+      hdr.mapObsTypes["G"].push_back(gnsstk::RinexObsID("GL1C", cv));
+      hdr.mapObsTypes["G"].push_back(gnsstk::RinexObsID("GD1C", cv));
+      hdr.mapObsTypes["G"].push_back(gnsstk::RinexObsID("GS1C", cv));
+      hdr.mapObsTypes["E"].push_back(gnsstk::RinexObsID("EC1X", cv));
+      hdr.mapObsTypes["E"].push_back(gnsstk::RinexObsID("EL1X", cv));
+      hdr.date = "20200512 181734 UTC";
+      hdr.preserveDate = true;
+      hdr.version = cv;
+      hdr.firstObs = gnsstk::CivilTime(2020,3,11,12,0,0,
+                                      gnsstk::TimeSystem::GPS);
+      hdr.valid |= gnsstk::Rinex3ObsHeader::validVersion;
+      hdr.valid |= gnsstk::Rinex3ObsHeader::validRunBy;
+      hdr.valid |= gnsstk::Rinex3ObsHeader::validMarkerName;
+      hdr.valid |= gnsstk::Rinex3ObsHeader::validObserver;
+      hdr.valid |= gnsstk::Rinex3ObsHeader::validReceiver;
+      hdr.valid |= gnsstk::Rinex3ObsHeader::validAntennaType;
+      hdr.valid |= gnsstk::Rinex3ObsHeader::validAntennaPosition;
+      hdr.valid |= gnsstk::Rinex3ObsHeader::validAntennaDeltaHEN;
+      hdr.valid |= gnsstk::Rinex3ObsHeader::validFirstTime;
+      hdr.valid |= gnsstk::Rinex3ObsHeader::validSystemNumObs;
+      hdr.valid |= gnsstk::Rinex3ObsHeader::validSystemPhaseShift;
+      hdr.validEoH = true;
+      TUCATCH(strm << hdr);
+   }
+      // ...then append hand-formatted records to exercise odd
+      // fields: negative zero, blank data/LLI/SSI, exponents,
+      // embedded blanks, short lines and changing satellite lists,
+      // with an event record in the middle.
+   {
+      std::ofstream os(fn.c_str(), std::ios::app);
+      os << "> 2020 03 11 12 00  0.0000000  0  3       0.000123456789\n"
+         << "G01  20000000.123 7 105000000.456 6     -1234.567 4        45.250  \n"
+         << "G07  -0.000           12345678901.5          1.25E+03    12 3 4.5   \n"
+         << "E02  21000000.125 5\n"
+         << "> 2020 03 11 12 00  1.0000000  0  2\n"
+         << "G07  20000100.000       105000010.000 11000.000      4.000 1     31.0 \n"
+         << "E09  19000000.000 3  99999999.99       \n"
+         << "> 2020 03 11 12 00  2.0000000  4  1\n"
+         << "this is an event comment                                    COMMENT\n"
+         << "> 2020 03 11 12 00  3.0000000  0  3\n"
+         << "E02         1.000 1        -2.000   \n"
+         << "G01       .5           5.      \n"
+         << "G32  1234567890123.4   -.125         0.0005           0.001 9\n";
+   }
+   gnsstk::Rinex3ObsStream slow(fn.c_str()), fast(fn.c_str());
+   fast.fastRead = true;
+   gnsstk::Rinex3ObsData slowData, fastData;
+   unsigned records = 0;
+   while (true)
+   {
+      bool slowOK = static_cast<bool>(slow >> slowData);
+      bool fastOK = static_cast<bool>(fast >> fastData);
+      TUASSERTE(bool, slowOK, fastOK);
+      if (!slowOK || !fastOK)
+         break;
+      records++;
+      TUASSERTE(gnsstk::CommonTime, slowData.time, fastData.time);
+      TUASSERTE(short, slowData.epochFlag, fastData.epochFlag);
+      TUASSERTE(short, slowData.numSVs, fastData.numSVs);
+      TUASSERTE(double, slowData.clockOffset, fastData.clockOffset);
+      TUASSERTE(size_t, slowData.obs.size(), fastData.obs.size());
+      TUASSERTE(size_t, slowData.auxHeader.commentList.size(),
+                fastData.auxHeader.commentList.size());
+      auto si = slowData.obs.begin();
+      auto fi = fastData.obs.begin();
+      for (; si != slowData.obs.end() && fi != fastData.obs.end(); ++si, ++fi)
+      {
+         TUASSERTE(gnsstk::RinexSatID, si->first, fi->first);
+         TUASSERTE(size_t, si->second.size(), fi->second.size());
+         for (size_t i = 0; i < si->second.size() && i < fi->second.size();
+              i++)
+         {
+            const gnsstk::RinexDatum &sd(si->second[i]), &fd(fi->second[i]);
+               // compare bit patterns so that -0 vs 0 is caught
+            TUASSERTE(int, 0, memcmp(&sd.data, &fd.data, sizeof(double)));
+            TUASSERTE(bool, sd.dataBlank, fd.dataBlank);
+            TUASSERTE(short, sd.lli, fd.lli);
+            TUASSERTE(bool, sd.lliBlank, fd.lliBlank);
+            TUASSERTE(short, sd.ssi, fd.ssi);
+            TUASSERTE(bool, sd.ssiBlank, fd.ssiBlank);
+         }
+      }
+   }
+   TUASSERTE(unsigned, 4, records);
+   TURETURN();
+}
+
+
 int main()
 {
    unsigned errorTotal = 0;
@@ -634,6 +740,7 @@ int main()
    errorTotal += testClass.ionoDelayTest();
    errorTotal += testClass.obsIDVersionTest();
    errorTotal += testClass.reopenTest();
+   errorTotal += testClass.fastReadTest();
    cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
    return errorTotal;
 }
@@ -0,0 +1,284 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "RinexObsStream.hpp"
+#include "RinexObsHeader.hpp"
+#include "RinexObsData.hpp"
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsHeader.hpp"
+#include "Rinex3ObsData.hpp"
+#include "CivilTime.hpp"
+#include "TimeString.hpp"
+#include "TestUtil.hpp"
+
+/** Make sure that separate RINEX observation streams can be read
+ * concurrently.  Each file contains event records without an epoch
+ * time, which take their time from the previous record in the same
+ * stream. */
+class RinexParallel_T
+{
+public:
+   RinexParallel_T();
+      /// Read several RINEX 2 files in parallel with RinexObsStream.
+   unsigned obs2Test();
+      /// Read several RINEX 2 files in parallel with Rinex3ObsStream.
+   unsigned obs3Test();
+
+      /// Number of files (and threads) to use.
+   static const unsigned numFiles = 8;
+      /// Number of epochs to write in each file.
+   static const unsigned numEpochs = 200;
+
+      /// Write a RINEX 2.11 obs file whose epochs start at hour.
+   static void writeFile(const std::string& fn, int hour);
+      /// Summarize every record of a file using RinexObsStream.
+   static void read2(const std::string& fn, std::string& result);
+      /// Summarize every record of a file using Rinex3ObsStream.
+   static void read3(const std::string& fn, std::string& result);
+
+   std::vector<std::string> fileNames;
+};
+
+
+/// Format a RINEX header line with its label in column 61.
+static std::string hline(const std::string& content, const std::string& label)
+{
+   std::string rv(content);
+   rv.resize(60, ' ');
+   return rv + label + "\n";
+}
+
+
+RinexParallel_T ::
+RinexParallel_T()
+{
+   for (unsigned i = 0; i < numFiles; i++)
+   {
+      std::ostringstream ss;
+      ss << gnsstk::getPathTestTemp() << gnsstk::getFileSep()
+         << "RinexParallel_T_" << i << ".11o";
+      fileNames.push_back(ss.str());
+      writeFile(ss.str(), i);
+   }
+}
+
+
+void RinexParallel_T ::
+writeFile(const std::string& fn, int hour)
+{
+   std::ofstream os(fn.c_str());
+   char buf[81];
+   std::snprintf(buf, sizeof(buf), "%9.2f%11s%-20s%-20s", 2.11, "",
+                 "OBSERVATION DATA", "G (GPS)");
+   os << hline(buf, "RINEX VERSION / TYPE")
+      << hline("RinexParallel_T     TEST                20200312 000000 UTC",
+               "PGM / RUN BY / DATE")
+      << hline("TEST", "MARKER NAME")
+      << hline("TEST                TEST", "OBSERVER / AGENCY")
+      << hline("1                   TEST                1",
+               "REC # / TYPE / VERS")
+      << hline("1                   TEST", "ANT # / TYPE")
+      << hline("  1130000.0000 -4830000.0000  3990000.0000",
+               "APPROX POSITION XYZ")
+      << hline("        0.0000        0.0000        0.0000",
+               "ANTENNA: DELTA H/E/N")
+      << hline("     1     1", "WAVELENGTH FACT L1/2")
+      << hline("     2    C1    L1", "# / TYPES OF OBSERV");
+   std::snprintf(buf, sizeof(buf), "%6d%6d%6d%6d%6d%13.7f     GPS",
+                 2020, 3, 11, hour, 0, 0.);
+   os << hline(buf, "TIME OF FIRST OBS")
+      << hline("", "END OF HEADER");
+   for (unsigned epoch = 0; epoch < numEpochs; epoch++)
+   {
+      int minute = epoch / 60;
+      double second = epoch % 60;
+      std::snprintf(buf, sizeof(buf), " %2d %2d %2d %2d %2d%11.7f  0  2G%02dG%02d",
+                    20, 3, 11, hour, minute, second, hour+1, hour+10);
+      os << buf << "\n";
+      for (int sv = 0; sv < 2; sv++)
+      {
+         std::snprintf(buf, sizeof(buf), "%14.3f  %14.3f  ",
+                       2.0e7 + hour*1000. + epoch + sv,
+                       1.05e8 + hour*1000. + epoch + sv);
+         os << buf << "\n";
+      }
+         // An event record with no epoch time uses the time of
+         // the previous record.
+      if ((epoch % 10) == 9)
+      {
+         os << std::string(26, ' ') << "  4  1\n"
+            << hline("EVENT", "COMMENT");
+      }
+   }
+}
+
+
+void RinexParallel_T ::
+read2(const std::string& fn, std::string& result)
+{
+   std::ostringstream ss;
+   gnsstk::RinexObsStream strm(fn.c_str(), std::ios::in);
+   gnsstk::RinexObsHeader hdr;
+   gnsstk::RinexObsData rod;
+   strm >> hdr;
+   while (strm >> rod)
+   {
+      ss << gnsstk::printTime(rod.time, "%Y %02m %02d %02H:%02M:%04.1f") << " "
+         << rod.epochFlag << " " << rod.numSvs;
+      for (const auto& sati : rod.obs)
+      {
+         for (const auto& obsi : sati.second)
+         {
+            ss << " " << std::fixed << obsi.second.data;
+         }
+      }
+      ss << "\n";
+   }
+   result = ss.str();
+}
+
+
+void RinexParallel_T ::
+read3(const std::string& fn, std::string& result)
+{
+   std::ostringstream ss;
+   gnsstk::Rinex3ObsStream strm(fn.c_str(), std::ios::in);
+   gnsstk::Rinex3ObsHeader hdr;
+   gnsstk::Rinex3ObsData rod;
+   strm >> hdr;
+   while (strm >> rod)
+   {
+      ss << gnsstk::printTime(rod.time, "%Y %02m %02d %02H:%02M:%04.1f") << " "
+         << rod.epochFlag << " " << rod.numSVs;
+      for (const auto& sati : rod.obs)
+      {
+         for (const auto& datum : sati.second)
+         {
+            ss << " " << std::fixed << datum.data;
+         }
+      }
+      ss << "\n";
+   }
+   result = ss.str();
+}
+
+
+unsigned RinexParallel_T ::
+obs2Test()
+{
+   TUDEF("RinexObsData", "reallyGetRecord (parallel)");
+   std::vector<std::string> serial(numFiles), parallel(numFiles);
+   for (unsigned i = 0; i < numFiles; i++)
+   {
+      read2(fileNames[i], serial[i]);
+   }
+   std::vector<std::thread> threads;
+   for (unsigned i = 0; i < numFiles; i++)
+   {
+      threads.push_back(std::thread(read2, std::cref(fileNames[i]),
+                                    std::ref(parallel[i])));
+   }
+   for (auto& t : threads)
+   {
+      t.join();
+   }
+   for (unsigned i = 0; i < numFiles; i++)
+   {
+            // RinexObsData skips event records that have no epoch time.
+      TUASSERTE(size_t, numEpochs,
+                std::count(serial[i].begin(), serial[i].end(), '\n'));
+      TUASSERTE(std::string, serial[i], parallel[i]);
+   }
+   TURETURN();
+}
+
+
+unsigned RinexParallel_T ::
+obs3Test()
+{
+   TUDEF("Rinex3ObsData", "reallyGetRecordVer2 (parallel)");
+   std::vector<std::string> serial(numFiles), parallel(numFiles);
+   for (unsigned i = 0; i < numFiles; i++)
+   {
+      read3(fileNames[i], serial[i]);
+   }
+   std::vector<std::thread> threads;
+   for (unsigned i = 0; i < numFiles; i++)
+   {
+      threads.push_back(std::thread(read3, std::cref(fileNames[i]),
+                                    std::ref(parallel[i])));
+   }
+   for (auto& t : threads)
+   {
+      t.join();
+   }
+   for (unsigned i = 0; i < numFiles; i++)
+   {
+         // observation records plus event records
+      TUASSERTE(size_t, numEpochs + numEpochs/10,
+                std::count(serial[i].begin(), serial[i].end(), '\n'));
+      TUASSERTE(std::string, serial[i], parallel[i]);
+   }
+      // Spot check that an event record got the time of the epoch
+      // before it and not one from some other file.
+   std::ostringstream exp;
+   exp << "2020 03 11 0" << (numFiles-1) << ":00:09.0 4 1\n";
+   TUASSERT(parallel[numFiles-1].find(exp.str()) != std::string::npos);
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   RinexParallel_T testClass;
+
+   errorTotal += testClass.obs2Test();
+   errorTotal += testClass.obs3Test();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,184 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <vector>
+#include "GlobalTropModel.hpp"
+#include "Position.hpp"
+#include "TestUtil.hpp"
+
+class GlobalTropModel_T
+{
+public:
+      /** Compare SiteContext to GlobalTropModel at several sites and
+       * days, one satellite at a time and in batch. */
+   unsigned siteContextTest();
+      /// Check the site context validity checks.
+   unsigned siteContextErrorTest();
+      /** Check that repeated setParameters() with an unchanged position
+       * keeps the model valid and the results unchanged. */
+   unsigned setParametersTest();
+};
+
+
+unsigned GlobalTropModel_T ::
+siteContextTest()
+{
+   TUDEF("GlobalTropModel::SiteContext", "correction");
+      // height, latitude, longitude, in both hemispheres
+   const double sites[][3] = { { 100.0, 30.27, -97.74 },
+                               { 1800.0, -33.9, 18.4 },
+                               { 5.0, 0.0, 0.0 },
+                               { 3000.0, 78.2, 15.6 } };
+   const int days[] = { 1, 90, 200, 365 };
+   std::vector<double> elev;
+   for (double el = -5.0; el <= 90.0; el += 0.37)
+      elev.push_back(el);
+   for (unsigned s = 0; s < 4; s++)
+   {
+      gnsstk::GlobalTropModel gtm;
+      gtm.setReceiverHeight(sites[s][0]);
+      gtm.setReceiverLatitude(sites[s][1]);
+      gtm.setReceiverLongitude(sites[s][2]);
+      gtm.setHumidity(40.0);
+      gnsstk::GlobalTropModel::SiteContext site(sites[s][0], sites[s][1],
+                                                sites[s][2]);
+      site.setHumidity(40.0);
+      for (unsigned d = 0; d < 4; d++)
+      {
+         gtm.setDayOfYear(days[d]);
+         site.setDayOfYear(days[d]);
+         double P, T, U, sP, sT, sU;
+         gtm.getGPT(P, T, U);
+         site.getGPT(sP, sT, sU);
+         TUASSERTFEPS(P, sP, 1e-9);
+         TUASSERTFEPS(T, sT, 1e-9);
+         TUASSERTFEPS(U, sU, 1e-9);
+         TUASSERTFEPS(gtm.dry_zenith_delay(), site.dry_zenith_delay(), 1e-12);
+         TUASSERTFEPS(gtm.wet_zenith_delay(), site.wet_zenith_delay(), 1e-12);
+         std::vector<double> delay;
+         site.correction(elev, delay);
+         TUASSERTE(size_t, elev.size(), delay.size());
+         for (size_t i = 0; i < elev.size(); i++)
+         {
+            TUASSERTFEPS(gtm.dry_mapping_function(elev[i]),
+                         site.dry_mapping_function(elev[i]), 1e-12);
+            TUASSERTFEPS(gtm.wet_mapping_function(elev[i]),
+                         site.wet_mapping_function(elev[i]), 1e-12);
+            TUASSERTFEPS(gtm.correction(elev[i]), site.correction(elev[i]),
+                         1e-12);
+            TUASSERTFE(site.correction(elev[i]), delay[i]);
+         }
+         TUASSERTFE(0.0, delay[0]);
+      }
+   }
+
+      // from positions and times, as correction(RX,SV,time)
+   testFramework.changeSourceMethod("SiteContext(Position)");
+   gnsstk::Position rx(-740289.9, -5457071.7, 3207245.6);
+   gnsstk::Position sv(-740289.9 + 2.e7, -5457071.7 - 1.e7, 3207245.6 + 1.e7);
+   gnsstk::CommonTime when(gnsstk::CommonTime::BEGINNING_OF_TIME);
+   when.set(58849, 3600.0, gnsstk::TimeSystem::GPS);
+   gnsstk::GlobalTropModel gtm;
+   gnsstk::GlobalTropModel::SiteContext site(rx);
+   site.setTime(when);
+   std::vector<double> one(1, rx.elevationGeodetic(sv)), delay;
+   site.correction(one, delay);
+   TUASSERTFEPS(gtm.correction(rx, sv, when), delay[0], 1e-12);
+   TURETURN();
+}
+
+
+unsigned GlobalTropModel_T ::
+siteContextErrorTest()
+{
+   TUDEF("GlobalTropModel::SiteContext", "testValidity");
+   gnsstk::GlobalTropModel::SiteContext site(100.0, 45.0, 10.0);
+   std::vector<double> elev(3, 30.0), delay;
+   TUTHROW(site.correction(30.0));
+   TUTHROW(site.correction(elev, delay));
+   TUTHROW(site.dry_zenith_delay());
+   TUTHROW(site.setHumidity(101.0));
+   site.setDayOfYear(100);
+   TUASSERT(site.correction(30.0) > 0.0);
+   TUTHROW(gnsstk::GlobalTropModel::SiteContext(50000.0, 45.0, 10.0));
+   TURETURN();
+}
+
+
+unsigned GlobalTropModel_T ::
+setParametersTest()
+{
+   TUDEF("GlobalTropModel", "setParameters");
+   gnsstk::Position rx(-740289.9, -5457071.7, 3207245.6);
+   gnsstk::CommonTime when(gnsstk::CommonTime::BEGINNING_OF_TIME);
+   when.set(58849, 3600.0, gnsstk::TimeSystem::GPS);
+   gnsstk::GlobalTropModel gtm;
+   gtm.setParameters(when, rx);
+   double c = gtm.correction(20.0);
+   gtm.setParameters(when, rx);
+   TUASSERTFE(c, gtm.correction(20.0));
+      // a change of day only, then back
+   gtm.setDayOfYear(180);
+   TUASSERT(gtm.correction(20.0) != c);
+   gtm.setParameters(when, rx);
+   TUASSERTFE(c, gtm.correction(20.0));
+      // latitude zero is valid from the start
+   gnsstk::GlobalTropModel zero;
+   zero.setReceiverHeight(0.0);
+   zero.setReceiverLatitude(0.0);
+   zero.setReceiverLongitude(0.0);
+   zero.setDayOfYear(0);
+   TUASSERT(zero.correction(20.0) > 0.0);
+   TURETURN();
+}
+
+
+int main(int argc, char *argv[])
+{
+   GlobalTropModel_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.siteContextTest();
+   errorTotal += testClass.siteContextErrorTest();
+   errorTotal += testClass.setParametersTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
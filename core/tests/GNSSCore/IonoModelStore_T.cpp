@@ -167,6 +167,19 @@ int IonoModelStoreTest :: testAdd()
    TUASSERT( true == store->addIonoModel(t3, validModel2) );
    TUASSERTE( size_t, 4, store->size() );
    TUASSERT( t1 == store->getInitialTime() );
+   TUASSERT( t4 == store->getFinalTime() );
+      // Post: { (t1,m1), (t2,m2), (t3,m2), (t4,m1) }
+
+      // Attempt to add models in an incompatible time system, in
+      // the middle, before and after the stored ones - should fail
+   const gnsstk::YDSTime tGPS1(2021, 123, 600.0, gnsstk::TimeSystem::GPS);
+   const gnsstk::YDSTime tGPS2(2021, 122, 0.0, gnsstk::TimeSystem::GPS);
+   const gnsstk::YDSTime tGPS3(2021, 125, 0.0, gnsstk::TimeSystem::GPS);
+   TUASSERT( false == store->addIonoModel(tGPS1, validModel1) );
+   TUASSERT( false == store->addIonoModel(tGPS2, validModel2) );
+   TUASSERT( false == store->addIonoModel(tGPS3, validModel2) );
+   TUASSERTE( size_t, 4, store->size() );
+   TUASSERT( t1 == store->getInitialTime() );
    TUASSERT( t4 == store->getFinalTime() );
       // Post: { (t1,m1), (t2,m2), (t3,m2), (t4,m1) }
 
@@ -65,6 +65,8 @@ public:
    unsigned equalityTest();
    unsigned ancillaryMethods();
    unsigned addDataVecTest();
+   unsigned fieldTest();
+   unsigned exactSizeTest();
 
    double eps;
 };
@@ -863,6 +865,120 @@ addDataVecTest()
 }
 
 
+unsigned PackedNavBits_T ::
+fieldTest()
+{
+   TUDEF("PackedNavBits", "PNBField");
+   typedef PNBField<0,28> Field1;
+   typedef PNBField<28,32> Field2;
+   typedef PNBField<60,16> Field3;
+   typedef PNBField<76,18> Field4;
+   typedef PNBField<94,24> Field5;
+   typedef PNBField<100,20> FieldPastEnd;
+      // The first two fields fill 60 bits, which puts the third field
+      // (bits 60-75) across the first 64-bit storage word boundary.
+   PackedNavBits uut;
+   uut.addUnsignedLong(0x5a5a5a5, 28, 1);
+   uut.addUnsignedLong(0x12345678, 32, 1);
+   uut.addLong(-12345, 16, 1);
+   uut.addUnsignedLong(0x3ffff, 18, 1);
+   uut.addSignedDouble(-1.25, 24, -20);
+   uut.trimsize();
+   TUASSERTE(size_t, 118, uut.getNumBits());
+   TUASSERTE(unsigned long, 0x5a5a5a5,
+             uut.asUnsignedLong<Field1>(1));
+   TUASSERTE(unsigned long, 0x12345678,
+             uut.asUnsignedLong<Field2>(1));
+   TUASSERTE(long, -12345, uut.asLong<Field3>(1));
+   TUASSERTE(long, -24690, uut.asLong<Field3>(2));
+   TUASSERTE(unsigned long, 0x3ffff, uut.asUnsignedLong<Field4>(1));
+   TUASSERTFE(-1.25, uut.asSignedDouble<Field5>(-20));
+   TUASSERTFE(uut.asUnsignedDouble(76,18,-3),
+              uut.asUnsignedDouble<Field4>(-3));
+   TUASSERTFE(uut.asDoubleSemiCircles(94,24,-20),
+              uut.asDoubleSemiCircles<Field5>(-20));
+      // The MSB of a wide read must match the single bit read at
+      // every position and width.
+   for (unsigned start = 0; start < 54; start++)
+   {
+      for (unsigned num = 1; num <= 64 && start+num <= 118; num++)
+      {
+         TUASSERTE(uint64_t,
+                   uut.asUnsignedLong(start, 1, 1) & 1,
+                   (uut.asUnsignedLong(start, num, 1) >> (num-1)) & 1);
+      }
+   }
+   TUCSM("getBits");
+   std::vector<bool> bits = uut.getBits();
+   TUASSERTE(size_t, 118, bits.size());
+   for (unsigned i = 0; i < bits.size(); i++)
+   {
+      TUASSERTE(bool, uut.asBool(i), bits[i]);
+   }
+   TUASSERTE(bool, true, bits[28+3]);
+   TUASSERTE(bool, false, bits[28+4]);
+   TUCSM("PNBField");
+   TUTHROW(uut.asUnsignedLong<FieldPastEnd>(1));
+   TUCSM("addBitset");
+   PackedNavBits bs;
+   bs.addUnsignedLong(5, 3, 1);
+   bs.addBitset(std::bitset<70>(0x2d));
+   bs.trimsize();
+   TUASSERTE(size_t, 73, bs.getNumBits());
+   TUASSERTE(unsigned long, 5, bs.asUnsignedLong(0, 3, 1));
+   TUASSERTE(unsigned long, 0, bs.asUnsignedLong(3, 60, 1));
+   TUASSERTE(unsigned long, 0x2d, bs.asUnsignedLong(63, 10, 1));
+   TUCSM("invert");
+   bs.invert();
+   TUASSERTE(unsigned long, 2, bs.asUnsignedLong(0, 3, 1));
+   TUASSERTE(unsigned long, 0x3d2, bs.asUnsignedLong(63, 10, 1));
+      // Bits past the end must have been left clear by invert, or
+      // the comparisons below would see them.
+   PackedNavBits bs2;
+   bs2.addUnsignedLong(2, 3, 1);
+   bs2.addUnsignedLong(0x0fffffffffffffffUL, 60, 1);
+   bs2.addUnsignedLong(0x3d2, 10, 1);
+   bs2.trimsize();
+   TUASSERT(bs.matchBits(bs2));
+   TUASSERT(!(bs < bs2));
+   TUASSERT(!(bs2 < bs));
+   TURETURN();
+}
+
+
+unsigned PackedNavBits_T ::
+exactSizeTest()
+{
+   TUDEF("PackedNavBits", "PackedNavBits(const PackedNavBits&)");
+   typedef PNBField<270,30> LastWord;
+      // A 300-bit LNAV subframe, which is not a multiple of 64 bits.
+      // The copy holds exactly as many storage words as it needs, so
+      // reading the last field would read past them without the
+      // guard word.
+   PackedNavBits orig;
+   for (unsigned long i = 0; i < 10; i++)
+   {
+      orig.addUnsignedLong(0x2aaaaaa0 + i, 30, 1);
+   }
+   orig.trimsize();
+   PackedNavBits uut(orig);
+   TUASSERTE(size_t, 300, uut.getNumBits());
+   TUASSERTE(unsigned long, 0x2aaaaaa9, uut.asUnsignedLong(270, 30, 1));
+   TUASSERTE(unsigned long, 0x2aaaaaa9, uut.asUnsignedLong<LastWord>(1));
+   TUASSERTE(unsigned long, 0x29, uut.asUnsignedLong(294, 6, 1));
+   TUASSERTE(unsigned long, 1, uut.asUnsignedLong(299, 1, 1));
+   TUASSERT(uut.matchBits(orig));
+   TUCSM("PackedNavBits(numBits)");
+   PackedNavBits filled(SatID(1, SatelliteSystem::GPS), ObsID(),
+                        NavID(), "", CommonTime::BEGINNING_OF_TIME, 300,
+                        true);
+   TUASSERTE(size_t, 300, filled.getNumBits());
+   TUASSERTE(unsigned long, 0x3fffffff, filled.asUnsignedLong<LastWord>(1));
+   TUASSERTE(unsigned long, 0xfffffffffUL, filled.asUnsignedLong(264, 36, 1));
+   TURETURN();
+}
+
+
 int main()
 {
    unsigned errorTotal = 0;
@@ -874,6 +990,8 @@ int main()
    errorTotal += testClass.equalityTest();
    errorTotal += testClass.ancillaryMethods();
    errorTotal += testClass.addDataVecTest();
+   errorTotal += testClass.fieldTest();
+   errorTotal += testClass.exactSizeTest();
 
    cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
 
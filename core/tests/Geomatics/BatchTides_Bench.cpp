@@ -0,0 +1,139 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file BatchTides_Bench.cpp Benchmark the solid Earth and pole tides of
+ * a network computed one site at a time, with computeSolidEarthTides()
+ * and computePolarTides(), against BatchTides, serially and threaded.
+ * The Sun and Moon positions are given, as they would be by SolarSystem.
+ * Usage: BatchTides_Bench [sites [epochs [threads]]].  Defaults to 500
+ * sites at 120 epochs of 30 seconds, and one thread per core. */
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "BatchTides.hpp"
+#include "SolidEarthTides.hpp"
+
+/// Time f(), in seconds.
+template <class F>
+static double timeIt(F f)
+{
+   auto t0 = std::chrono::steady_clock::now();
+   f();
+   auto t1 = std::chrono::steady_clock::now();
+   return std::chrono::duration<double>(t1 - t0).count();
+}
+
+int main(int argc, char *argv[])
+{
+   unsigned numSites = (argc > 1 ? std::atoi(argv[1]) : 500);
+   unsigned numEpochs = (argc > 2 ? std::atoi(argv[2]) : 120);
+   unsigned numThreads = (argc > 3 ? std::atoi(argv[3]) : 0);
+
+   gnsstk::BatchTides tides(gnsstk::IERSConvention::IERS2010, 81.30056,
+                            332946.050894783285912, numThreads);
+   tides.doOcean = false;
+   std::vector<gnsstk::Position> sites;
+   for (unsigned j = 0; j < numSites; j++)
+   {
+      gnsstk::Position p(-80.0 + 160.0 * j / numSites,
+                         std::fmod(137.5 * j, 360.0), 100.0,
+                         gnsstk::Position::Geodetic);
+      p.transformTo(gnsstk::Position::Cartesian);
+      sites.push_back(p);
+      tides.addSite(p);
+   }
+   std::vector<gnsstk::EphTime> times;
+   std::vector<gnsstk::Position> suns, moons;
+   for (unsigned i = 0; i < numEpochs; i++)
+   {
+      double d = 7000.0 + i * 30.0 / 86400.0, gst = 6.300388 * d;
+      times.push_back(gnsstk::EphTime(51544.5 + d, gnsstk::TimeSystem::UTC));
+      suns.push_back(gnsstk::Position(1.496e11 * std::cos(0.017202*d - gst),
+                                      1.496e11 * std::sin(0.017202*d - gst),
+                                      5.e10 * std::sin(0.017202*d)));
+      moons.push_back(gnsstk::Position(3.844e8 * std::cos(0.229971*d - gst),
+                                       3.844e8 * std::sin(0.229971*d - gst),
+                                       1.4e8 * std::sin(0.229971*d)));
+   }
+   std::cout << numSites << " sites, " << numEpochs << " epochs, "
+             << tides.getNumThreads() << " threads" << std::endl;
+
+   double sum = 0.0, maxerr = 0.0;
+   std::vector<gnsstk::Triple> last(numSites);
+   double tSingle = timeIt([&]() {
+      for (unsigned i = 0; i < numEpochs; i++)
+         for (unsigned j = 0; j < numSites; j++)
+         {
+            last[j] = gnsstk::computeSolidEarthTides(sites[j], times[i],
+                                                     suns[i], moons[i]) +
+               gnsstk::computePolarTides(sites[j], times[i], 0.1, 0.3);
+            sum += last[j][2];
+         }});
+
+   std::vector<gnsstk::BatchTides::EpochState> states;
+   std::vector<gnsstk::Triple> disp;
+   double tBatch = timeIt([&]() {
+      for (unsigned i = 0; i < numEpochs; i++)
+      {
+         states.push_back(tides.epochState(times[i], suns[i], moons[i],
+                                           0.1, 0.3));
+         tides.compute(states.back(), disp);
+         sum += disp[0][2];
+      }});
+   for (unsigned j = 0; j < numSites; j++)
+      for (int k = 0; k < 3; k++)
+         maxerr = std::max(maxerr, std::fabs(disp[j][k] - last[j][k]));
+
+   std::vector<std::vector<gnsstk::Triple> > all;
+   double tThreads = timeIt([&]() {
+      tides.compute(states, all);
+      sum += all[0][0][2];
+   });
+
+   std::cout << "  one site at a time " << tSingle << " s" << std::endl
+             << "  batch, serial      " << tBatch << " s (speedup "
+             << (tSingle / tBatch) << "x, largest difference " << maxerr
+             << " m)" << std::endl
+             << "  batch, threaded    " << tThreads << " s (speedup "
+             << (tSingle / tThreads) << "x, states not included) (" << sum
+             << ")" << std::endl;
+   return 0;
+}
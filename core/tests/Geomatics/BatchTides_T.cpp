@@ -0,0 +1,334 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file BatchTides_T.cpp  Test the batch tide displacement service
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include "BatchTides.hpp"
+#include "SolidEarthTides.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+
+class BatchTides_T
+{
+public:
+   BatchTides_T();
+
+      /** Compare the solid Earth and pole tides to
+       * computeSolidEarthTides() and computePolarTides() for each IERS
+       * convention, at sites spread over the globe. */
+   unsigned solidPolarTest();
+      /** Compare ocean loading to OceanLoadTides::computeDisplacement(),
+       * by name and by handle, using a synthetic BLQ file. */
+   unsigned oceanTest();
+      /** Check that the threaded driver reproduces compute() at each
+       * epoch, and that the total is the sum of the parts. */
+   unsigned computeTest();
+
+      /// Write a BLQ file with made-up coefficients for the ocean sites.
+   void writeBLQ();
+      /// Position of the Sun or Moon at a time, made up but realistic.
+   gnsstk::Position body(double mjd, bool sun);
+
+      /// site positions, ECEF m
+   vector<gnsstk::Position> sites;
+      /// names of the ocean loading sites, parallel to the first sites
+   vector<string> oceanNames;
+      /// BLQ file name
+   string blqFile;
+};
+
+
+BatchTides_T ::
+BatchTides_T()
+{
+   double llh[][3] = {{30.3,  -97.7, 200.},  {64.1, -21.9, 50.},
+                      {-33.9, 151.2,  40.},  {0.2,   36.8, 1700.},
+                      {89.5,   10.0, 100.},  {-77.8, 166.7, 30.},
+                      {57.4,   11.9,  45.}};
+   for (size_t i = 0; i < sizeof(llh) / sizeof(llh[0]); i++)
+   {
+      gnsstk::Position p(llh[i][0], llh[i][1], llh[i][2],
+                         gnsstk::Position::Geodetic);
+      p.transformTo(gnsstk::Position::Cartesian);
+      sites.push_back(p);
+   }
+   oceanNames.push_back("AUST");
+   oceanNames.push_back("REYK");
+   oceanNames.push_back("SYDN");
+   blqFile = gnsstk::getPathTestTemp() + gnsstk::getFileSep() +
+             "BatchTides_T.blq";
+}
+
+
+void BatchTides_T ::
+writeBLQ()
+{
+   ofstream ofs(blqFile.c_str());
+   ofs << "$$ Ocean loading displacement, made up for BatchTides_T\n"
+       << "$$ Columns: M2 S2 N2 K2 K1 O1 P1 Q1 MF MM SSA\n";
+   ofs << fixed;
+   for (size_t k = 0; k < oceanNames.size(); k++)
+   {
+      ofs << "  " << oceanNames[k] << "\n"
+          << "$$ computed by hand, lon/lat: " << sites[k].getLongitude()
+          << " " << sites[k].getGeodeticLatitude() << " 0.0\n";
+         // amplitudes (m) of Up, West, South, then phases (deg)
+      for (int row = 0; row < 6; row++)
+      {
+         ofs << " ";
+         for (int i = 0; i < 11; i++)
+         {
+            double x = ::sin(1.3 * i + 2.1 * row + 0.7 * k);
+            if (row < 3)
+               ofs << " " << setprecision(5) << 0.005 + 0.004 * x / (row + 1);
+            else
+               ofs << " " << setprecision(1) << 170.0 * x;
+         }
+         ofs << "\n";
+      }
+   }
+}
+
+
+gnsstk::Position BatchTides_T ::
+body(double mjd, bool sun)
+{
+      // circular orbits in the ecliptic, seen from a rotating Earth
+   double d(mjd - 51544.5);
+   double R(sun ? 1.496e11 : 3.844e8);
+   double lon(sun ? 0.017202 * d : 0.229971 * d);
+   double eps(23.44 * gnsstk::DEG_TO_RAD), gst(6.300388 * d);
+   double x(R * ::cos(lon)), y(R * ::sin(lon) * ::cos(eps)),
+      z(R * ::sin(lon) * ::sin(eps));
+   return gnsstk::Position(x * ::cos(gst) + y * ::sin(gst),
+                           -x * ::sin(gst) + y * ::cos(gst), z);
+}
+
+
+unsigned BatchTides_T ::
+solidPolarTest()
+{
+   TUDEF("BatchTides", "solidTide");
+   gnsstk::IERSConvention convs[] = {gnsstk::IERSConvention::IERS1996,
+                                     gnsstk::IERSConvention::IERS2003,
+                                     gnsstk::IERSConvention::IERS2010};
+   for (int c = 0; c < 3; c++)
+   {
+      gnsstk::BatchTides tides(convs[c]);
+      for (size_t j = 0; j < sites.size(); j++)
+         TUASSERTE(int, int(j), tides.addSite(sites[j]));
+         // two days, straddling the change of mean pole model in 2010
+      for (int i = 0; i < 40; i++)
+      {
+         double mjd(55196.3 + i * 0.0517);
+         gnsstk::EphTime t(mjd, gnsstk::TimeSystem::UTC);
+         gnsstk::Position Sun(body(mjd, true)), Moon(body(mjd, false));
+         double xp(0.1 + 0.01 * i), yp(0.35 - 0.005 * i);
+         gnsstk::BatchTides::EpochState st(
+            tides.epochState(t, Sun, Moon, xp, yp));
+         for (size_t j = 0; j < sites.size(); j++)
+         {
+            gnsstk::Triple exp = gnsstk::computeSolidEarthTides(
+               sites[j], t, Sun, Moon, 81.30056, 332946.050894783285912,
+               convs[c]);
+            gnsstk::Triple got = tides.solidTide(st, j);
+            testFramework.changeSourceMethod("solidTide");
+            for (int k = 0; k < 3; k++)
+               TUASSERTFEPS(exp[k], got[k], 1.e-12);
+
+            exp = gnsstk::computePolarTides(sites[j], t, xp, yp, convs[c]);
+            got = tides.polarTide(st, j);
+            testFramework.changeSourceMethod("polarTide");
+            for (int k = 0; k < 3; k++)
+               TUASSERTFEPS(exp[k], got[k], 1.e-14);
+         }
+      }
+   }
+   TURETURN();
+}
+
+
+unsigned BatchTides_T ::
+oceanTest()
+{
+   TUDEF("BatchTides", "oceanLoad");
+   writeBLQ();
+   gnsstk::OceanLoadTides olt;
+   vector<string> names(oceanNames);
+   TUASSERTE(int, 3, olt.initializeSites(names, blqFile));
+   TUASSERTE(size_t, 0, names.size());
+
+   testFramework.changeSourceMethod("siteHandle");
+   TUASSERTE(int, 0, olt.siteHandle("AUST"));
+   TUASSERTE(int, 2, olt.siteHandle("SYDN"));
+   TUTHROW(olt.siteHandle("NONE"));
+      // re-reading a site keeps its handle
+   names.assign(1, "SYDN");
+   TUASSERTE(int, 1, olt.initializeSites(names, blqFile));
+   TUASSERTE(int, 2, olt.siteHandle("SYDN"));
+
+   gnsstk::BatchTides tides;
+   TUTHROW(tides.addSite(sites[0], "AUST"));
+   tides.setOceanLoadTides(&olt);
+   TUTHROW(tides.addSite(sites[0], "NONE"));
+   for (size_t j = 0; j < oceanNames.size(); j++)
+      tides.addSite(sites[j], oceanNames[j]);
+   tides.addSite(sites[3]);
+
+   for (int i = 0; i < 10; i++)
+   {
+      double mjd(58849.1 + i * 0.1234);
+      gnsstk::EphTime t(mjd, gnsstk::TimeSystem::UTC);
+      gnsstk::BatchTides::EpochState st(
+         tides.epochState(t, body(mjd, true), body(mjd, false), 0.0, 0.0));
+      gnsstk::OceanLoadTides::EpochArguments args(
+         gnsstk::OceanLoadTides::epochArguments(t));
+      for (size_t j = 0; j < oceanNames.size(); j++)
+      {
+         gnsstk::Triple neu = olt.computeDisplacement(oceanNames[j], t);
+         gnsstk::Triple byHandle =
+            olt.computeDisplacement(olt.siteHandle(oceanNames[j]), args);
+         testFramework.changeSourceMethod("computeDisplacement");
+         for (int k = 0; k < 3; k++)
+            TUASSERTE(double, neu[k], byHandle[k]);
+         TUASSERT(neu.mag() > 1.e-3);
+
+            // rotate NEU to ECEF with the geodetic frame of the site
+         double lat(sites[j].getGeodeticLatitude() * gnsstk::DEG_TO_RAD);
+         double lon(sites[j].getLongitude() * gnsstk::DEG_TO_RAD);
+         double sa(::sin(lat)), ca(::cos(lat)), so(::sin(lon)), co(::cos(lon));
+         gnsstk::Triple exp(-sa * co * neu[0] - so * neu[1] + ca * co * neu[2],
+                            -sa * so * neu[0] + co * neu[1] + ca * so * neu[2],
+                            ca * neu[0] + sa * neu[2]);
+         gnsstk::Triple got = tides.oceanLoad(st, j);
+         testFramework.changeSourceMethod("oceanLoad");
+         for (int k = 0; k < 3; k++)
+            TUASSERTFEPS(exp[k], got[k], 1.e-15);
+      }
+         // no ocean loading for the last site
+      TUASSERTFE(0.0, tides.oceanLoad(st, 3).mag());
+   }
+   TUTHROW(olt.computeDisplacement(3, gnsstk::OceanLoadTides::epochArguments(
+                                         gnsstk::EphTime(58849.1,
+                                            gnsstk::TimeSystem::UTC))));
+   TURETURN();
+}
+
+
+unsigned BatchTides_T ::
+computeTest()
+{
+   TUDEF("BatchTides", "compute");
+   gnsstk::OceanLoadTides olt;
+   vector<string> names(oceanNames);
+   olt.initializeSites(names, blqFile);
+   gnsstk::BatchTides tides(gnsstk::IERSConvention::IERS2010, 81.30056,
+                            332946.050894783285912, 4);
+   TUASSERTE(unsigned, 4, tides.getNumThreads());
+   tides.setOceanLoadTides(&olt);
+   for (size_t j = 0; j < sites.size(); j++)
+      tides.addSite(sites[j], j < oceanNames.size() ? oceanNames[j] : "");
+   TUASSERTE(size_t, sites.size(), tides.size());
+
+   vector<gnsstk::BatchTides::EpochState> states;
+   for (int i = 0; i < 37; i++)
+   {
+      double mjd(58849.0 + i * 30.0 / 86400.0);
+      gnsstk::EphTime t(mjd, gnsstk::TimeSystem::UTC);
+      states.push_back(tides.epochState(t, body(mjd, true), body(mjd, false),
+                                        0.12, 0.34));
+   }
+
+   vector<vector<gnsstk::Triple>> disp;
+   tides.compute(states, disp);
+   TUASSERTE(size_t, states.size(), disp.size());
+   for (size_t i = 0; i < states.size(); i++)
+   {
+      vector<gnsstk::Triple> one;
+      tides.compute(states[i], one);
+      TUASSERTE(size_t, sites.size(), disp[i].size());
+      for (size_t j = 0; j < sites.size(); j++)
+      {
+         gnsstk::Triple sum = tides.solidTide(states[i], j) +
+                              tides.oceanLoad(states[i], j) +
+                              tides.polarTide(states[i], j);
+         for (int k = 0; k < 3; k++)
+         {
+            TUASSERTE(double, one[j][k], disp[i][j][k]);
+            TUASSERTFEPS(sum[k], disp[i][j][k], 1.e-15);
+         }
+      }
+   }
+
+      // components may be turned off
+   tides.doSolid = tides.doPolar = false;
+   vector<gnsstk::Triple> one;
+   tides.compute(states[0], one);
+   for (size_t j = 0; j < sites.size(); j++)
+   {
+      gnsstk::Triple exp = tides.oceanLoad(states[0], j);
+      for (int k = 0; k < 3; k++)
+         TUASSERTFE(exp[k], one[j][k]);
+   }
+
+      // no epochs
+   states.clear();
+   tides.compute(states, disp);
+   TUASSERTE(size_t, 0, disp.size());
+   TURETURN();
+}
+
+
+int main(int argc, char *argv[])
+{
+   BatchTides_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.solidPolarTest();
+   errorTotal += testClass.oceanTest();
+   errorTotal += testClass.computeTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,165 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file CompiledAntenna_Bench.cpp Benchmark the receiver and satellite
+ * phase center variations of all satellites in view, computed with
+ * AntexData, against the compiled antennas of AntennaStore.  The antennas
+ * are synthetic, with the grids of typical ANTEX records.
+ * Usage: CompiledAntenna_Bench [satellites [epochs]].  Defaults to 40
+ * satellites at 2880 epochs. */
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "AntennaStore.hpp"
+#include "StringUtils.hpp"
+
+/// Time f(), in seconds.
+template <class F>
+static double timeIt(F f)
+{
+   auto t0 = std::chrono::steady_clock::now();
+   f();
+   auto t1 = std::chrono::steady_clock::now();
+   return std::chrono::duration<double>(t1 - t0).count();
+}
+
+/// Make an antenna with the grid of a typical ANTEX record.
+static gnsstk::AntexData makeAntenna(bool receiver, int prn)
+{
+   gnsstk::AntexData ant;
+   ant.valid = gnsstk::AntexData::allValid13;
+   ant.isRxAntenna = receiver;
+   ant.type = (receiver ? "TESTANT         NONE" : "BLOCK TEST");
+   ant.serialNo = "G" + gnsstk::StringUtils::asString(prn);
+   ant.systemChar = 'G';
+   ant.PRN = prn;
+   ant.azimDelta = (receiver ? 5.0 : 0.0);
+   ant.zenRange[0] = 0.0;
+   ant.zenRange[1] = (receiver ? 90.0 : 17.0);
+   ant.zenRange[2] = (receiver ? 5.0 : 1.0);
+   gnsstk::AntexData::antennaPCOandPCVData& data = ant.freqPCVmap["G01"];
+   data.hasAzimuth = receiver;
+   for (int i = 0; i < 3; i++)
+      data.PCOvalue[i] = 0.0;
+   for (double zen = ant.zenRange[0]; zen <= ant.zenRange[1];
+        zen += ant.zenRange[2])
+   {
+      data.PCVvalue[-1.0][zen] = 3.0 * std::sin(zen * 0.07) + 0.01 * prn;
+      for (double az = 0.0; receiver && az <= 360.0; az += ant.azimDelta)
+         data.PCVvalue[az][zen] = std::cos(az * 0.0174533) * zen / 90.0;
+   }
+   return ant;
+}
+
+int main(int argc, char *argv[])
+{
+   int numSats = (argc > 1 ? std::atoi(argv[1]) : 40);
+   unsigned numEpochs = (argc > 2 ? std::atoi(argv[2]) : 2880);
+
+   gnsstk::AntennaStore store;
+   gnsstk::AntexData rxAnt(makeAntenna(true, 0));
+   std::vector<gnsstk::AntexData> svAnts;
+   store.addAntenna(rxAnt.name(), rxAnt);
+   for (int prn = 1; prn <= numSats; prn++)
+   {
+      svAnts.push_back(makeAntenna(false, prn));
+      store.addAntenna(svAnts.back().name(), svAnts.back());
+   }
+
+      // handles, once, outside the processing loop
+   int L1 = gnsstk::CompiledAntenna::frequencyCode("G01");
+   int rx = store.getAntennaHandle(rxAnt.name());
+   std::vector<int> handles, codes(2 * numSats, L1);
+   for (int prn = 1; prn <= numSats; prn++)
+   {
+      handles.push_back(rx);
+      handles.push_back(store.getSatelliteAntennaHandle('G', prn));
+   }
+
+   std::vector<std::vector<double> > azim(numEpochs), angle(numEpochs);
+   for (unsigned i = 0; i < numEpochs; i++)
+   {
+      for (int j = 0; j < numSats; j++)
+      {
+         double az = std::fmod(97.3 * j + 0.01 * i, 360.0);
+         double el = 5.0 + std::fmod(13.7 * j + 0.003 * i, 85.0);
+         azim[i].push_back(az);
+         azim[i].push_back(az + 180.0);
+         angle[i].push_back(el);
+         angle[i].push_back(13.9 * std::cos(el * 0.0174533));
+      }
+   }
+   std::cout << numSats << " satellites, " << numEpochs << " epochs"
+             << std::endl;
+
+   double sum = 0.0, maxerr = 0.0;
+   std::vector<double> last(2 * numSats), pcv;
+   double tAntex = timeIt([&]() {
+      for (unsigned i = 0; i < numEpochs; i++)
+         for (int j = 0; j < numSats; j++)
+         {
+               // as a program would, through the store
+            gnsstk::AntexData sv;
+            std::string name;
+            store.getSatelliteAntenna('G', j + 1, name, sv);
+            last[2*j] = rxAnt.getPhaseCenterVariation("G01", azim[i][2*j],
+                                                      angle[i][2*j]);
+            last[2*j+1] = sv.getPhaseCenterVariation("G01", azim[i][2*j+1],
+                                                     angle[i][2*j+1]);
+            sum += last[2*j] + last[2*j+1];
+         }});
+
+   double tCompiled = timeIt([&]() {
+      for (unsigned i = 0; i < numEpochs; i++)
+      {
+         store.getPhaseCenterVariations(handles, codes, azim[i], angle[i],
+                                        pcv);
+         sum += pcv[0];
+      }});
+   for (size_t k = 0; k < pcv.size(); k++)
+      maxerr = std::max(maxerr, std::fabs(pcv[k] - last[k]));
+
+   std::cout << "  AntexData       " << tAntex << " s" << std::endl
+             << "  CompiledAntenna " << tCompiled << " s (speedup "
+             << (tAntex / tCompiled) << "x, largest difference " << maxerr
+             << " mm) (" << sum << ")" << std::endl;
+   return 0;
+}
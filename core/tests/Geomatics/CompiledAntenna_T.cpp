@@ -0,0 +1,310 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <cmath>
+#include "AntennaStore.hpp"
+#include "CompiledAntenna.hpp"
+#include "GNSSconstants.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+
+class CompiledAntenna_T
+{
+public:
+   CompiledAntenna_T();
+
+      /// Check the frequency codes of ANTEX frequency strings.
+   unsigned frequencyCodeTest();
+      /// Compare to AntexData for a receiver antenna with azimuth dependence.
+   unsigned receiverTest();
+      /// Compare to AntexData for a satellite antenna without it.
+   unsigned satelliteTest();
+      /// Check the vector functions and the handles of AntennaStore.
+   unsigned batchTest();
+
+      /// Make an antenna with a smooth synthetic PCV pattern.
+   static gnsstk::AntexData makeAntenna(bool receiver);
+
+      /// Test antennas.
+   gnsstk::AntexData rxAnt, svAnt;
+};
+
+
+CompiledAntenna_T ::
+CompiledAntenna_T()
+      : rxAnt(makeAntenna(true)), svAnt(makeAntenna(false))
+{
+}
+
+
+gnsstk::AntexData CompiledAntenna_T ::
+makeAntenna(bool receiver)
+{
+   gnsstk::AntexData ant;
+   ant.valid = gnsstk::AntexData::allValid13;
+   ant.isRxAntenna = receiver;
+   if (receiver)
+   {
+      ant.type = "TESTANT         NONE";
+      ant.azimDelta = 5.0;
+      ant.zenRange[0] = 0.0;
+      ant.zenRange[1] = 90.0;
+      ant.zenRange[2] = 5.0;
+   }
+   else
+   {
+      ant.type = "BLOCK IIF";
+      ant.serialNo = "G05";
+      ant.systemChar = 'G';
+      ant.PRN = 5;
+      ant.SVN = 62;
+      ant.azimDelta = 0.0;
+      ant.zenRange[0] = 0.0;
+      ant.zenRange[1] = 17.0;
+      ant.zenRange[2] = 1.0;
+   }
+   const char *freqs[] = { "G01", "G02", "E05" };
+   for (int f = 0; f < 3; f++)
+   {
+      gnsstk::AntexData::antennaPCOandPCVData& data =
+         ant.freqPCVmap[freqs[f]];
+      data.PCOvalue[0] = 1.1 + f;
+      data.PCOvalue[1] = -0.7 * f;
+      data.PCOvalue[2] = (receiver ? 60.0 : 1500.0) + 10.0 * f;
+      data.hasAzimuth = (ant.azimDelta > 0.0);
+      for (double zen = ant.zenRange[0]; zen <= ant.zenRange[1];
+           zen += ant.zenRange[2])
+      {
+            // as in ANTEX files, the NOAZI row is always present
+         double noazi = (3.0 + f) * ::sin(zen * 0.07);
+         data.PCVvalue[-1.0][zen] = noazi;
+         if (data.hasAzimuth)
+         {
+            for (double az = 0.0; az <= 360.0; az += ant.azimDelta)
+            {
+               data.PCVvalue[az][zen] =
+                  noazi + 1.5 * ::cos(az * gnsstk::DEG_TO_RAD) * zen / 90.0;
+            }
+         }
+      }
+   }
+   return ant;
+}
+
+
+unsigned CompiledAntenna_T ::
+frequencyCodeTest()
+{
+   TUDEF("CompiledAntenna", "frequencyCode");
+   TUASSERTE(int, 1, gnsstk::CompiledAntenna::frequencyCode("G01"));
+   TUASSERTE(int, 1, gnsstk::CompiledAntenna::frequencyCode(" 01"));
+   TUASSERTE(int, 2 * 16 + 5, gnsstk::CompiledAntenna::frequencyCode("E05"));
+   TUASSERTE(int, 6 * 16 + 9, gnsstk::CompiledAntenna::frequencyCode("I09"));
+   TUASSERTE(int, -1, gnsstk::CompiledAntenna::frequencyCode("X01"));
+   TUASSERTE(int, -1, gnsstk::CompiledAntenna::frequencyCode("G16"));
+   TUASSERTE(int, -1, gnsstk::CompiledAntenna::frequencyCode("G1a"));
+   TUASSERTE(int, -1, gnsstk::CompiledAntenna::frequencyCode("G"));
+   TURETURN();
+}
+
+
+unsigned CompiledAntenna_T ::
+receiverTest()
+{
+   TUDEF("CompiledAntenna", "getPhaseCenterVariation");
+   gnsstk::CompiledAntenna cant(rxAnt);
+   TUASSERTE(string, rxAnt.name(), cant.name());
+   TUASSERT(cant.isReceiver());
+   const char *freqs[] = { "G01", "G02", "E05" };
+   for (int f = 0; f < 3; f++)
+   {
+      int code = gnsstk::CompiledAntenna::frequencyCode(freqs[f]);
+      TUASSERT(cant.hasFrequency(code));
+      TUASSERTE(gnsstk::Triple, rxAnt.getPhaseCenterOffset(freqs[f]),
+                cant.getPhaseCenterOffset(code));
+         // off the grid, on it, and outside 0 to 360 in azimuth
+      for (double az = -400.0; az <= 400.0; az += 2.5 + 0.01 * f)
+      {
+         for (double el = 0.0; el <= 90.0; el += 2.5)
+         {
+            TUASSERTFEPS(rxAnt.getPhaseCenterVariation(freqs[f], az, el),
+                         cant.getPhaseCenterVariation(code, az, el), 1e-12);
+            TUASSERTFEPS(rxAnt.getTotalPhaseCenterOffset(freqs[f], az, el),
+                         cant.getTotalPhaseCenterOffset(code, az, el), 1e-12);
+         }
+      }
+   }
+   TUASSERT(!cant.hasFrequency(gnsstk::CompiledAntenna::frequencyCode("R01")));
+   TUASSERT(!cant.hasFrequency(-1));
+   TUASSERT(!cant.hasFrequency(gnsstk::CompiledAntenna::NUM_FREQ_CODES));
+   TUTHROW(cant.getPhaseCenterVariation(17, 0.0, 10.0));
+   TUTHROW(cant.getPhaseCenterVariation(1, 0.0, 90.5));
+   TUTHROW(cant.getPhaseCenterVariation(1, 0.0, -0.5));
+   TUTHROW(gnsstk::CompiledAntenna(gnsstk::AntexData()));
+   TURETURN();
+}
+
+
+unsigned CompiledAntenna_T ::
+satelliteTest()
+{
+   TUDEF("CompiledAntenna", "getPhaseCenterVariation");
+   gnsstk::CompiledAntenna cant(svAnt);
+   TUASSERT(!cant.isReceiver());
+   const char *freqs[] = { "G01", "G02", "E05" };
+   for (int f = 0; f < 3; f++)
+   {
+      int code = gnsstk::CompiledAntenna::frequencyCode(freqs[f]);
+         // nadir angles beyond the grid take the value at its edge
+      for (double az = -100.0; az <= 400.0; az += 37.0)
+      {
+         for (double nadir = 0.0; nadir <= 20.0; nadir += 0.25)
+         {
+            TUASSERTFEPS(svAnt.getPhaseCenterVariation(freqs[f], az, nadir),
+                         cant.getPhaseCenterVariation(code, az, nadir), 1e-12);
+            TUASSERTFEPS(svAnt.getTotalPhaseCenterOffset(freqs[f], az, nadir),
+                         cant.getTotalPhaseCenterOffset(code, az, nadir),
+                         1e-12);
+         }
+      }
+   }
+   TURETURN();
+}
+
+
+unsigned CompiledAntenna_T ::
+batchTest()
+{
+   TUDEF("CompiledAntenna", "getPhaseCenterVariations");
+   gnsstk::CompiledAntenna cant(rxAnt);
+   int code = gnsstk::CompiledAntenna::frequencyCode("G02");
+   vector<double> az, el, pcv, total;
+   for (int i = 0; i < 40; i++)
+   {
+      az.push_back(-50.0 + 11.3 * i);
+      el.push_back(2.2 * i);
+   }
+   cant.getPhaseCenterVariations(code, az, el, pcv);
+   cant.getTotalPhaseCenterOffsets(code, az, el, total);
+   TUASSERTE(size_t, az.size(), pcv.size());
+   TUASSERTE(size_t, az.size(), total.size());
+   for (size_t i = 0; i < az.size(); i++)
+   {
+      TUASSERTFE(cant.getPhaseCenterVariation(code, az[i], el[i]), pcv[i]);
+      TUASSERTFE(cant.getTotalPhaseCenterOffset(code, az[i], el[i]),
+                 total[i]);
+   }
+   el.push_back(10.0);
+   TUTHROW(cant.getPhaseCenterVariations(code, az, el, pcv));
+   el.pop_back();
+   el[3] = 95.0;
+   TUTHROW(cant.getPhaseCenterVariations(code, az, el, pcv));
+
+      // handles in the store, for satellites of all systems at one epoch
+   testFramework.changeSourceMethod("AntennaStore handles");
+   gnsstk::AntennaStore store;
+   store.addAntenna(rxAnt.name(), rxAnt);
+   store.addAntenna(svAnt.name(), svAnt);
+   int rx = store.getAntennaHandle(rxAnt.name());
+   int sv = store.getSatelliteAntennaHandle('G', 5);
+   TUASSERT(rx >= 0);
+   TUASSERT(sv >= 0);
+   TUASSERT(rx != sv);
+   TUASSERTE(int, rx, store.getAntennaHandle(rxAnt.name()));
+   TUASSERTE(int, sv, store.getSatelliteAntennaHandle('G', 62, false));
+   TUASSERTE(int, -1, store.getAntennaHandle("NOSUCHANT"));
+   TUASSERTE(int, -1, store.getSatelliteAntennaHandle('G', 6));
+   TUASSERTE(int, -1, store.getSatelliteAntennaHandle('R', 5));
+   TUASSERTE(string, svAnt.name(), store.getCompiledAntenna(sv).name());
+   TUTHROW(store.getCompiledAntenna(-1));
+   TUTHROW(store.getCompiledAntenna(2));
+
+   vector<int> handles, codes;
+   vector<double> angle;
+   for (int i = 0; i < 12; i++)
+   {
+      handles.push_back(i % 3 ? sv : rx);
+      codes.push_back(gnsstk::CompiledAntenna::frequencyCode(i % 2 ? "G01"
+                                                                   : "E05"));
+      angle.push_back(i % 3 ? 1.3 * i : 7.0 * i);
+   }
+   TUTHROW(store.getPhaseCenterVariations(handles, codes, az, angle, pcv));
+   az.resize(handles.size());
+   store.getPhaseCenterVariations(handles, codes, az, angle, pcv);
+   TUASSERTE(size_t, handles.size(), pcv.size());
+   for (size_t i = 0; i < handles.size(); i++)
+   {
+      const gnsstk::AntexData& ant = (handles[i] == rx ? rxAnt : svAnt);
+      TUASSERTFEPS(ant.getPhaseCenterVariation(i % 2 ? "G01" : "E05", az[i],
+                                               angle[i]),
+                   pcv[i], 1e-12);
+   }
+
+      // replacing an antenna keeps its handle and updates the data
+   gnsstk::AntexData changed(svAnt);
+   changed.freqPCVmap["G01"].PCVvalue[-1.0][4.0] += 1.0;
+   store.addAntenna(svAnt.name(), changed);
+   TUASSERTE(int, sv, store.getSatelliteAntennaHandle('G', 5));
+   TUASSERTFEPS(svAnt.getPhaseCenterVariation("G01", 0.0, 4.0) + 1.0,
+                store.getCompiledAntenna(sv).getPhaseCenterVariation(
+                   gnsstk::CompiledAntenna::frequencyCode("G01"), 0.0, 4.0),
+                1e-12);
+
+   store.clear();
+   TUASSERTE(int, -1, store.getAntennaHandle(rxAnt.name()));
+   TUTHROW(store.getCompiledAntenna(rx));
+   TURETURN();
+}
+
+
+int main(int argc, char *argv[])
+{
+   CompiledAntenna_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.frequencyCodeTest();
+   errorTotal += testClass.receiverTest();
+   errorTotal += testClass.satelliteTest();
+   errorTotal += testClass.batchTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
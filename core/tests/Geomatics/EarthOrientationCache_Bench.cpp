@@ -0,0 +1,108 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file EarthOrientationCache_Bench.cpp Benchmark the ECEF-to-inertial
+ * rotation of EarthOrientation against EarthOrientationCache, as used
+ * by an orbit integrator: one rotation per step over a span of days.
+ * Usage: EarthOrientationCache_Bench [steps [stepsize]].  Defaults to
+ * 2880 steps of 30 seconds (one day). */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include "EarthOrientationCache.hpp"
+
+/// Time f(), in seconds.
+template <class F>
+static double timeIt(F f)
+{
+   auto t0 = std::chrono::steady_clock::now();
+   f();
+   auto t1 = std::chrono::steady_clock::now();
+   return std::chrono::duration<double>(t1 - t0).count();
+}
+
+int main(int argc, char *argv[])
+{
+   unsigned numSteps = (argc > 1 ? std::atoi(argv[1]) : 2880);
+   double stepSize = (argc > 2 ? std::atof(argv[2]) : 30.0);
+   gnsstk::IERSConvention convs[3] = { gnsstk::IERSConvention::IERS1996,
+                                       gnsstk::IERSConvention::IERS2003,
+                                       gnsstk::IERSConvention::IERS2010 };
+   std::cout << numSteps << " steps of " << stepSize << " s" << std::endl;
+
+   for (int i = 0; i < 3; i++)
+   {
+      gnsstk::EarthOrientation eo;
+      eo.xp = 0.123;
+      eo.yp = 0.345;
+      eo.UT1mUTC = -0.234;
+      eo.convention = convs[i];
+      gnsstk::EarthOrientationCache cache(convs[i]);
+      double sum = 0.0, maxerr = 0.0;
+      gnsstk::Matrix<double> exact;
+      gnsstk::FixedMatrix<double,3,3> fast;
+
+      double tExact = timeIt([&]() {
+         gnsstk::EphTime t(58849.0, gnsstk::TimeSystem::UTC);
+         for (unsigned k = 0; k < numSteps; k++, t += stepSize)
+         {
+            exact = eo.ECEFtoInertial(t);
+            sum += exact(0,1);
+         }});
+      double tCache = timeIt([&]() {
+         gnsstk::EphTime t(58849.0, gnsstk::TimeSystem::UTC);
+         for (unsigned k = 0; k < numSteps; k++, t += stepSize)
+         {
+            fast = cache.ECEFtoInertial(t, eo);
+            sum += fast(0,1);
+         }});
+      for (size_t r = 0; r < 3; r++)
+         for (size_t c = 0; c < 3; c++)
+            maxerr = std::max(maxerr, std::fabs(exact(r,c) - fast(r,c)));
+
+      std::cout << "  " << convs[i]
+                << ": exact " << tExact << " s, cache " << tCache
+                << " s (speedup " << (tExact / tCache) << "x, "
+                << cache.size() << " grid points, last error " << maxerr
+                << " rad) (" << sum << ")" << std::endl;
+   }
+   return 0;
+}
@@ -0,0 +1,210 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file EarthOrientationCache_T.cpp  Test the gridded ECEF-to-inertial rotation
+
+#include <cmath>
+#include "EarthOrientationCache.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+
+class EarthOrientationCache_T
+{
+public:
+      /** Compare the cached rotation to EarthOrientation::ECEFtoInertial()
+       * for each IERS convention, at epochs spread over several days. */
+   unsigned ECEFtoInertialTest();
+      /** Check that ECEFtoJ2000() is the frame bias times
+       * ECEFtoInertial(), and is only available in IERS2010. */
+   unsigned ECEFtoJ2000Test();
+      /// Check the constructor arguments and the convention of the EOPs.
+   unsigned constructorTest();
+
+      /** Return the largest element of the difference between the
+       * cached and the exact rotations over many epochs. */
+   double maxError(gnsstk::IERSConvention conv, double spacing, int order,
+                   bool reduced);
+};
+
+
+double EarthOrientationCache_T ::
+maxError(gnsstk::IERSConvention conv, double spacing, int order, bool reduced)
+{
+   gnsstk::EarthOrientation eo;
+   eo.xp = 0.123;
+   eo.yp = 0.345;
+   eo.UT1mUTC = -0.234;
+   eo.convention = conv;
+   gnsstk::EarthOrientationCache cache(conv, spacing, order);
+   double maxerr(0.0);
+      // ten days, at steps that are not commensurate with the grid
+   for (int i = 0; i < 200; i++)
+   {
+      gnsstk::EphTime t(58849.0 + i * 0.0501234, gnsstk::TimeSystem::UTC);
+      gnsstk::Matrix<double> exact(eo.ECEFtoInertial(t, reduced));
+      gnsstk::FixedMatrix<double,3,3> fast(cache.ECEFtoInertial(t, eo,
+                                                                reduced));
+      for (size_t r = 0; r < 3; r++)
+         for (size_t c = 0; c < 3; c++)
+            maxerr = std::max(maxerr, ::fabs(exact(r,c) - fast(r,c)));
+   }
+   return maxerr;
+}
+
+
+unsigned EarthOrientationCache_T ::
+ECEFtoInertialTest()
+{
+   TUDEF("EarthOrientationCache", "ECEFtoInertial");
+   gnsstk::IERSConvention convs[3] = { gnsstk::IERSConvention::IERS1996,
+                                       gnsstk::IERSConvention::IERS2003,
+                                       gnsstk::IERSConvention::IERS2010 };
+   for (int i = 0; i < 3; i++)
+   {
+         // defaults
+      TUASSERT(maxError(convs[i], 21600.0, 6, false) < 1.e-13);
+         // coarse grid
+      TUASSERT(maxError(convs[i], 86400.0, 6, false) < 2.e-10);
+         // more points are more accurate
+      TUASSERT(maxError(convs[i], 86400.0, 8, false) <
+               maxError(convs[i], 86400.0, 4, false));
+   }
+   TUASSERT(maxError(gnsstk::IERSConvention::IERS1996, 21600.0, 6, true) <
+            1.e-13);
+
+      // only the grid points that are needed are computed, and kept
+   gnsstk::EarthOrientationCache cache;
+   gnsstk::EphTime t(58849.3, gnsstk::TimeSystem::UTC);
+   gnsstk::FixedMatrix<double,3,3> Q(cache.precessionNutation(t));
+   TUASSERTE(size_t, 6, cache.size());
+   t += 60.0;
+   cache.precessionNutation(t);
+   TUASSERTE(size_t, 6, cache.size());
+   t += 86400.0;
+   cache.precessionNutation(t);
+   TUASSERTE(size_t, 10, cache.size());
+   cache.clear();
+   TUASSERTE(size_t, 0, cache.size());
+      // Q is a rotation
+   gnsstk::FixedMatrix<double,3,3> QQt(Q * transpose(Q));
+   for (size_t r = 0; r < 3; r++)
+      for (size_t c = 0; c < 3; c++)
+         TUASSERTFEPS((r == c ? 1.0 : 0.0), QQt(r,c), 1.e-14);
+   TURETURN();
+}
+
+
+unsigned EarthOrientationCache_T ::
+ECEFtoJ2000Test()
+{
+   TUDEF("EarthOrientationCache", "ECEFtoJ2000");
+      // frame bias matrix rb from the SOFA test of iauBp00
+   const double rb[3][3] =
+      { {  0.9999999999999942498, -0.7078279744199196626e-7,
+           0.8056217146976134152e-7 },
+        {  0.7078279477857337206e-7, 0.9999999999999969484,
+           0.3306041454222136517e-7 },
+        { -0.8056217380986972157e-7, -0.3306040883980552500e-7,
+           0.9999999999999962084 } };
+   gnsstk::EarthOrientation eo;
+   eo.xp = 0.123;
+   eo.yp = 0.345;
+   eo.UT1mUTC = -0.234;
+   eo.convention = gnsstk::IERSConvention::IERS2010;
+   gnsstk::EarthOrientationCache cache;
+   for (int i = 0; i < 5; i++)
+   {
+      gnsstk::EphTime t(58849.0 + i * 1.234, gnsstk::TimeSystem::UTC);
+      gnsstk::FixedMatrix<double,3,3> toJ2000(cache.ECEFtoJ2000(t, eo));
+         // B = ECEFtoJ2000 * transpose(ECEFtoInertial)
+      gnsstk::FixedMatrix<double,3,3> B(
+         toJ2000 * transpose(cache.ECEFtoInertial(t, eo)));
+      for (size_t r = 0; r < 3; r++)
+         for (size_t c = 0; c < 3; c++)
+            TUASSERTFEPS(rb[r][c], B(r,c), 1.e-15);
+   }
+   gnsstk::EarthOrientationCache cache2003(
+      gnsstk::IERSConvention::IERS2003);
+   eo.convention = gnsstk::IERSConvention::IERS2003;
+   gnsstk::EphTime t(58849.0, gnsstk::TimeSystem::UTC);
+   TUTHROW(cache2003.ECEFtoJ2000(t, eo));
+   TURETURN();
+}
+
+
+unsigned EarthOrientationCache_T ::
+constructorTest()
+{
+   TUDEF("EarthOrientationCache", "EarthOrientationCache");
+   TUTHROW(gnsstk::EarthOrientationCache(gnsstk::IERSConvention::Unknown));
+   TUTHROW(gnsstk::EarthOrientationCache(gnsstk::IERSConvention::IERS2010,
+                                         0.0));
+   TUTHROW(gnsstk::EarthOrientationCache(gnsstk::IERSConvention::IERS2010,
+                                         3600.0, 1));
+   TUTHROW(gnsstk::EarthOrientationCache(
+              gnsstk::IERSConvention::IERS2010, 3600.0,
+              gnsstk::EarthOrientationCache::MAX_ORDER + 1));
+   gnsstk::EarthOrientationCache cache(gnsstk::IERSConvention::IERS2003,
+                                       3600.0, 6);
+   TUASSERTE(gnsstk::IERSConvention, gnsstk::IERSConvention::IERS2003,
+             cache.getConvention());
+   TUASSERTFE(3600.0, cache.getSpacing());
+   TUASSERTE(int, 6, cache.getOrder());
+   gnsstk::EarthOrientation eo;
+   eo.convention = gnsstk::IERSConvention::IERS2010;
+   gnsstk::EphTime t(58849.0, gnsstk::TimeSystem::UTC);
+   TUTHROW(cache.ECEFtoInertial(t, eo));
+   TURETURN();
+}
+
+
+int main(int argc, char *argv[])
+{
+   EarthOrientationCache_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.constructorTest();
+   errorTotal += testClass.ECEFtoInertialTest();
+   errorTotal += testClass.ECEFtoJ2000Test();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
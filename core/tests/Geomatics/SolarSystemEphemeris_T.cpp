@@ -0,0 +1,276 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include "SolarSystemEphemeris.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+
+class SolarSystemEphemeris_T
+{
+public:
+   SolarSystemEphemeris_T();
+
+      /** Compare positions and velocities computed from a mapped file
+       * with those computed by reading the same file. */
+   unsigned mappedTest();
+      /// Check that a file with a gap is refused by the mapped mode.
+   unsigned gapTest();
+      /** Check that a time is not looked up in a record that does not
+       * contain it, when a record in the middle of a mapped file is not
+       * at its place on the grid. */
+   unsigned shiftTest();
+
+      /** Write a small synthetic ephemeris in JPL ASCII format and
+       * convert it to a binary file.
+       * @param[in] skip index of a record to leave out, or -1 for none.
+       * @return the name of the binary file. */
+   string makeFile(const string& name, int skip);
+
+      /// JD of the first record.
+   double startJD;
+      /// Days per record.
+   double interval;
+      /// Number of records.
+   int nrec;
+};
+
+
+SolarSystemEphemeris_T ::
+SolarSystemEphemeris_T()
+      : startJD(2451536.5), interval(32.0), nrec(20)
+{
+}
+
+
+string SolarSystemEphemeris_T ::
+makeFile(const string& name, int skip)
+{
+   string base = gnsstk::getPathTestTemp() + gnsstk::getFileSep() + name;
+      // ten coefficients per component for all bodies, with two sets
+      // for the moon and the sun
+   int offset[13], ncoeff[13], nsets[13], Ncoeff = 2;
+   for (int i = 0; i < 13; i++)
+   {
+      offset[i] = Ncoeff + 1;
+      ncoeff[i] = 10;
+      nsets[i] = (i == 9 || i == 10 ? 2 : 1);
+      Ncoeff += ncoeff[i] * nsets[i] * (i == 11 ? 2 : 3);
+   }
+
+   ofstream hdr((base + ".hdr").c_str());
+   hdr << "KSIZE= 0000    NCOEFF= " << Ncoeff << endl << endl
+       << "GROUP   1010" << endl << endl
+       << "JPL Planetary Ephemeris DE999/LE999" << endl
+       << "Start Epoch: JED=  2451536.5" << endl
+       << "Final Epoch: JED=  2452176.5" << endl << endl
+       << "GROUP   1030" << endl << endl
+       << fixed << setprecision(1) << startJD << " "
+       << startJD + nrec * interval << " " << interval << endl << endl
+       << "GROUP   1040" << endl << endl
+       << "4" << endl << "  DENUM  AU     EMRAT  CLIGHT" << endl << endl
+       << "GROUP   1041" << endl << endl
+       << "4" << endl
+       << "  0.999000000000000000D+03  0.149597870700000000D+09" << endl
+       << "  0.813005690741906200D+02  0.299792458000000000D+06" << endl
+       << endl << "GROUP   1050" << endl << endl;
+   for (int i = 0; i < 13; i++)
+      hdr << " " << offset[i];
+   hdr << endl;
+   for (int i = 0; i < 13; i++)
+      hdr << " " << ncoeff[i];
+   hdr << endl;
+   for (int i = 0; i < 13; i++)
+      hdr << " " << nsets[i];
+   hdr << endl << endl << "GROUP   1070" << endl << endl;
+   hdr.close();
+
+   ofstream dat((base + ".asc").c_str());
+   dat << scientific << setprecision(17);
+   for (int k = 0, r = 1; k < nrec; k++)
+   {
+      if (k == skip)
+         continue;
+      vector<double> c(Ncoeff);
+      c[0] = startJD + k * interval;
+      c[1] = c[0] + interval;
+      for (int i = 2; i < Ncoeff; i++)
+         c[i] = 1.e6 * ::sin(0.37 * i + 1.3 * k) / (1 + (i - 2) % 10);
+      while (c.size() % 3)
+         c.push_back(0.0);
+      dat << r++ << " " << Ncoeff << endl;
+      for (size_t i = 0; i < c.size(); i += 3)
+         dat << " " << c[i] << " " << c[i+1] << " " << c[i+2] << endl;
+   }
+   dat.close();
+
+   gnsstk::SolarSystemEphemeris eph;
+   eph.readASCIIheader(base + ".hdr");
+   vector<string> files(1, base + ".asc");
+   eph.readASCIIdata(files);
+   eph.writeBinaryFile(base + ".bin");
+   remove((base + ".hdr").c_str());
+   remove((base + ".asc").c_str());
+   return base + ".bin";
+}
+
+
+unsigned SolarSystemEphemeris_T ::
+mappedTest()
+{
+   TUDEF("SolarSystemEphemeris", "initializeWithMappedFile");
+   string file = makeFile("SolarSystemEphemeris_T", -1);
+   gnsstk::SolarSystemEphemeris read, mapped;
+   TUASSERTE(int, 0, read.initializeWithBinaryFile(file));
+   TUASSERTE(int, 0, mapped.initializeWithMappedFile(file));
+   TUASSERTE(int, 999, mapped.EphNumber());
+   TUASSERTFE(read.startTimeMJD(), mapped.startTimeMJD());
+   TUASSERTFE(read.endTimeMJD(), mapped.endTimeMJD());
+   TUASSERTFE(read.AU(), mapped.AU());
+
+      // times in random order, including the record boundaries and
+      // both ends of the file
+   double start = startJD - gnsstk::MJD_TO_JD;
+   vector<double> times;
+   for (int k = 0; k <= nrec; k++)
+      times.push_back(start + k * interval);
+   for (int k = 0; k < 200; k++)
+      times.push_back(start + ::fmod(k * 97.123, nrec * interval));
+   typedef gnsstk::SolarSystemEphemeris SSE;
+   for (size_t t = 0; t < times.size(); t++)
+   {
+      for (int target = SSE::idMercury; target <= SSE::idLibrations; target++)
+      {
+         SSE::Planet center = (target % 2 ? SSE::idEarth : SSE::idSun);
+         double pvr[6], pvm[6];
+         read.relativeInertialPositionVelocity(times[t], SSE::Planet(target),
+                                               center, pvr);
+         mapped.relativeInertialPositionVelocity(times[t],
+                                                 SSE::Planet(target),
+                                                 center, pvm);
+         for (int i = 0; i < 6; i++)
+         {
+            TUASSERTFE(pvr[i], pvm[i]);
+         }
+      }
+   }
+
+   double pv[6];
+   TUTHROW(mapped.relativeInertialPositionVelocity(start - 1., SSE::idMars,
+                                                   SSE::idSun, pv));
+   TUTHROW(mapped.relativeInertialPositionVelocity(
+              start + nrec * interval + 1., SSE::idMars, SSE::idSun, pv));
+   remove(file.c_str());
+   TURETURN();
+}
+
+
+unsigned SolarSystemEphemeris_T ::
+gapTest()
+{
+   TUDEF("SolarSystemEphemeris", "initializeWithMappedFile");
+   string file = makeFile("SolarSystemEphemeris_gap_T", nrec / 2);
+   gnsstk::SolarSystemEphemeris mapped;
+   TUTHROW(mapped.initializeWithMappedFile(file));
+   TUTHROW(mapped.initializeWithMappedFile(file + ".missing"));
+   remove(file.c_str());
+   TURETURN();
+}
+
+
+unsigned SolarSystemEphemeris_T ::
+shiftTest()
+{
+   TUDEF("SolarSystemEphemeris", "initializeWithMappedFile");
+   string file = makeFile("SolarSystemEphemeris_shift_T", -1);
+      // move record k half a day earlier, leaving the ends in place
+   int k = nrec / 2;
+   double jd[2] = { startJD + k * interval, startJD + (k + 1) * interval };
+   string data;
+   {
+      ifstream in(file.c_str(), ios::binary);
+      ostringstream oss;
+      oss << in.rdbuf();
+      data = oss.str();
+   }
+   size_t pos = data.find(string((const char *)jd, sizeof(jd)));
+   TUASSERT(pos != string::npos);
+   jd[0] -= 0.5;
+   jd[1] -= 0.5;
+   data.replace(pos, sizeof(jd), string((const char *)jd, sizeof(jd)));
+   {
+      ofstream out(file.c_str(), ios::binary | ios::trunc);
+      out << data;
+   }
+
+   typedef gnsstk::SolarSystemEphemeris SSE;
+   gnsstk::SolarSystemEphemeris mapped;
+   TUASSERTE(int, 0, mapped.initializeWithMappedFile(file));
+   double start = startJD - gnsstk::MJD_TO_JD, pv[6];
+      // inside both the moved record and its place on the grid
+   TUCATCH(mapped.relativeInertialPositionVelocity(
+              start + k * interval + 10., SSE::idMars, SSE::idSun, pv));
+      // in the half day left uncovered by the moved record; its index
+      // on the grid is k, and record k+1 starts after it
+   TUTHROW(mapped.relativeInertialPositionVelocity(
+              start + (k + 1) * interval - 0.2, SSE::idMars, SSE::idSun,
+              pv));
+   remove(file.c_str());
+   TURETURN();
+}
+
+
+int main(int argc, char *argv[])
+{
+   SolarSystemEphemeris_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.mappedTest();
+   errorTotal += testClass.gapTest();
+   errorTotal += testClass.shiftTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,323 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <iostream>
+
+#include "FixedMatrix.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+
+   // macros can't take template arguments containing commas
+typedef gnsstk::FixedMatrix<double,3,3> FixedMatrix33;
+typedef gnsstk::FixedVector<double,3> FixedVector3;
+
+class FixedMatrix_T
+{
+public:
+   FixedMatrix_T();
+
+      /// Conversions between fixed and dynamic types.
+   unsigned conversionTest();
+      /// Arithmetic operators, compared to Matrix<T> and Vector<T>.
+   unsigned operatorTest();
+      /// LU, Cholesky and SVD decompositions, compared to Matrix<T>.
+   unsigned decompTest();
+      /// All the inverses, compared to Matrix<T>.
+   unsigned inverseTest();
+
+      /// a symmetric positive definite 4x4 (a normal matrix)
+   double a44[16];
+      /// a general 3x3
+   double a33[9];
+      /// an overdetermined 6x4
+   double a64[24];
+};
+
+
+FixedMatrix_T ::
+FixedMatrix_T()
+{
+   double s[16] = { 8.0, 1.0, -2.0, 0.5,
+                    1.0, 6.0, 0.3, -1.0,
+                    -2.0, 0.3, 5.0, 0.7,
+                    0.5, -1.0, 0.7, 4.0 };
+   double g[9] = { 0.2, -3.0, 1.0,
+                   4.0, 0.5, -2.0,
+                   1.5, 2.0, 3.0 };
+   double p[24] = { 0.3, -0.6, 0.74, 1.0,
+                    -0.8, 0.1, 0.59, 1.0,
+                    0.45, 0.7, 0.55, 1.0,
+                    0.05, -0.2, 0.98, 1.0,
+                    -0.4, -0.5, 0.77, 1.0,
+                    0.6, 0.3, 0.74, 1.0 };
+   std::copy(s, s+16, a44);
+   std::copy(g, g+9, a33);
+   std::copy(p, p+24, a64);
+}
+
+
+unsigned FixedMatrix_T ::
+conversionTest()
+{
+   TUDEF("FixedMatrix", "FixedMatrix");
+   gnsstk::FixedMatrix<double,3,3> f(a33);
+   gnsstk::Matrix<double> m(3,3);
+   m = a33;
+   TUASSERTE(size_t, 3, f.rows());
+   TUASSERTE(size_t, 3, f.cols());
+   TUASSERTE(size_t, 9, f.size());
+   for (size_t i = 0; i < 3; i++)
+      for (size_t j = 0; j < 3; j++)
+         TUASSERTE(double, m(i,j), f(i,j));
+      // dynamic from fixed and fixed from dynamic
+   gnsstk::Matrix<double> m2(f);
+   TUASSERTFEPS(m, m2, 0.0);
+   gnsstk::FixedMatrix<double,3,3> f2(m);
+   TUASSERTFEPS(m, gnsstk::Matrix<double>(f2), 0.0);
+   f2 = 0.0;
+   f2 = m;
+   TUASSERTFEPS(m, gnsstk::Matrix<double>(f2), 0.0);
+      // the dimensions must agree
+   gnsstk::Matrix<double> m43(4,3,1.0);
+   TUTHROW(FixedMatrix33 bad(m43));
+   TUTHROW(f2 = m43);
+      // vectors
+   gnsstk::Vector<double> v(3);
+   v[0] = 1.0; v[1] = -2.0; v[2] = 0.5;
+   gnsstk::FixedVector<double,3> fv(v);
+   TUASSERTE(size_t, 3, fv.size());
+   TUASSERTFEPS(v, gnsstk::Vector<double>(fv), 0.0);
+   gnsstk::Vector<double> v4(4, 1.0);
+   TUTHROW(FixedVector3 bad(v4));
+   TUTHROW(fv = v4);
+      // no heap storage
+   TUASSERTE(size_t, 3*sizeof(double), sizeof(FixedVector3));
+   TURETURN();
+}
+
+
+unsigned FixedMatrix_T ::
+operatorTest()
+{
+   TUDEF("FixedMatrix", "operator*");
+   const double eps = 1e-13;
+   gnsstk::FixedMatrix<double,6,4> fp(a64);
+   gnsstk::FixedMatrix<double,4,4> fs(a44);
+   gnsstk::Matrix<double> mp(fp), ms(fs);
+   gnsstk::FixedVector<double,6> fy;
+   for (size_t i = 0; i < 6; i++)
+      fy[i] = 0.1 * i - 0.2;
+   gnsstk::Vector<double> my(fy);
+      // the fixed operators return fixed types...
+   gnsstk::FixedMatrix<double,4,4> fptp = transpose(fp) * fp;
+   gnsstk::FixedVector<double,4> fpty = transpose(fp) * fy;
+   gnsstk::FixedVector<double,4> fytp = fy * fp;
+   gnsstk::FixedMatrix<double,4,4> fsum = fs + fptp * 2.0 - 0.5 * fs;
+      // ...with the same values as the dynamic ones
+   TUASSERTFEPS(gnsstk::Matrix<double>(transpose(mp) * mp),
+                gnsstk::Matrix<double>(fptp), eps);
+   TUASSERTFEPS(gnsstk::Vector<double>(transpose(mp) * my),
+                gnsstk::Vector<double>(fpty), eps);
+   TUASSERTFEPS(gnsstk::Vector<double>(my * mp),
+                gnsstk::Vector<double>(fytp), eps);
+   TUASSERTFEPS(gnsstk::Matrix<double>(ms + (transpose(mp) * mp) * 2.0
+                                       - 0.5 * ms),
+                gnsstk::Matrix<double>(fsum), eps);
+      // mixing fixed and dynamic operands falls back to dynamic
+   gnsstk::Matrix<double> mixed(fp * ms);
+   TUASSERTFEPS(mp * ms, mixed, eps);
+      // vector operators
+   gnsstk::FixedVector<double,4> fa(fpty), fb(fytp);
+   TUASSERTFEPS(dot(gnsstk::Vector<double>(fa), gnsstk::Vector<double>(fb)),
+                dot(fa, fb), eps);
+   TUASSERTFEPS(norm(gnsstk::Vector<double>(fa)), norm(fa), eps);
+   TUASSERTFEPS(gnsstk::Vector<double>(fa) * 3.0 - gnsstk::Vector<double>(fb),
+                gnsstk::Vector<double>(3.0 * fa - fb), eps);
+   TUASSERTFEPS(gnsstk::Vector<double>(fa) / 4.0,
+                gnsstk::Vector<double>(fa / 4.0), eps);
+   TURETURN();
+}
+
+
+unsigned FixedMatrix_T ::
+decompTest()
+{
+   TUDEF("FixedMatrix", "decompositions");
+   const double eps = 1e-12;
+   gnsstk::FixedMatrix<double,4,4> fs(a44);
+   gnsstk::FixedMatrix<double,3,3> fg(a33);
+   gnsstk::FixedMatrix<double,6,4> fp(a64);
+   gnsstk::Matrix<double> ms(fs), mg(fg);
+
+      // LU
+   testFramework.changeSourceMethod("FixedLUDecomp");
+   gnsstk::FixedLUDecomp<double,3> flu;
+   gnsstk::LUDecomp<double> mlu;
+   flu(fg);
+   mlu(mg);
+   TUASSERTFEPS(mlu.LU, gnsstk::Matrix<double>(flu.LU), eps);
+   TUASSERTFEPS(mlu.det(), flu.det(), eps);
+   gnsstk::FixedVector<double,3> fb(1.0);
+   gnsstk::Vector<double> mb(3, 1.0);
+   flu.backSub(fb);
+   mlu.backSub(mb);
+   TUASSERTFEPS(mb, gnsstk::Vector<double>(fb), eps);
+   gnsstk::FixedMatrix<double,3,3> zero(0.0);
+   TUTHROW(flu(zero));
+
+      // Cholesky
+   testFramework.changeSourceMethod("FixedCholesky");
+   gnsstk::FixedCholesky<double,4> fch;
+   gnsstk::Cholesky<double> mch;
+   fch(fs);
+   mch(ms);
+   TUASSERTFEPS(mch.L, gnsstk::Matrix<double>(fch.L), eps);
+   TUASSERTFEPS(mch.U, gnsstk::Matrix<double>(fch.U), eps);
+   TUASSERTFEPS(ms, gnsstk::Matrix<double>(fch.L * transpose(fch.L)), eps);
+   gnsstk::FixedVector<double,4> fb4(2.0);
+   gnsstk::Vector<double> mb4(4, 2.0);
+   fch.backSub(fb4);
+   mch.backSub(mb4);
+   TUASSERTFEPS(mb4, gnsstk::Vector<double>(fb4), eps);
+   TUTHROW(fch(-1.0 * fs));
+
+      // SVD, square and overdetermined
+   testFramework.changeSourceMethod("FixedSVD");
+   gnsstk::FixedSVD<double,3,3> fsvd;
+   gnsstk::SVD<double> msvd;
+   TUASSERT(fsvd(fg));
+   msvd(mg);
+   msvd.sort(true);
+   for (size_t i = 0; i < 3; i++)
+   {
+      TUASSERTFEPS(msvd.S(i), fsvd.S(i), eps);
+   }
+   gnsstk::FixedMatrix<double,3,3> fS(0.0);
+   for (size_t i = 0; i < 3; i++)
+      fS(i,i) = fsvd.S(i);
+   TUASSERTFEPS(mg, gnsstk::Matrix<double>(fsvd.U * fS * transpose(fsvd.V)),
+                eps);
+   TUASSERTFEPS(ABS(msvd.det()), ABS(fsvd.det()), eps);
+
+   gnsstk::FixedSVD<double,6,4> fsvd64;
+   TUASSERT(fsvd64(fp));
+   gnsstk::FixedMatrix<double,4,4> fS4(0.0);
+   for (size_t i = 0; i < 4; i++)
+   {
+      fS4(i,i) = fsvd64.S(i);
+      if (i > 0)
+      {
+         TUASSERT(fsvd64.S(i-1) >= fsvd64.S(i));
+      }
+   }
+   TUASSERTFEPS(gnsstk::Matrix<double>(fp),
+                gnsstk::Matrix<double>(fsvd64.U * fS4 * transpose(fsvd64.V)),
+                eps);
+      // least squares solution by SVD matches the normal equations
+   gnsstk::FixedVector<double,6> y;
+   for (size_t i = 0; i < 6; i++)
+      y[i] = 1.0 + 0.3 * i;
+   gnsstk::FixedVector<double,4> xsvd(fsvd64.backSub(y));
+   gnsstk::FixedVector<double,4> xne(inverseLUD(transpose(fp) * fp) *
+                                     (transpose(fp) * y));
+   TUASSERTFEPS(gnsstk::Vector<double>(xne), gnsstk::Vector<double>(xsvd),
+                1e-10);
+   TURETURN();
+}
+
+
+unsigned FixedMatrix_T ::
+inverseTest()
+{
+   TUDEF("FixedMatrix", "inverse");
+   const double eps = 1e-12;
+   gnsstk::FixedMatrix<double,4,4> fs(a44);
+   gnsstk::FixedMatrix<double,3,3> fg(a33);
+   gnsstk::Matrix<double> ms(fs), mg(fg);
+   gnsstk::Matrix<double> I3(gnsstk::ident<double>(3)), I4(gnsstk::ident<double>(4));
+
+   testFramework.changeSourceMethod("inverse");
+   gnsstk::FixedMatrix<double,3,3> fgi(inverse(fg));
+   TUASSERTFEPS(gnsstk::inverse(mg), gnsstk::Matrix<double>(fgi), eps);
+   TUASSERTFEPS(I3, gnsstk::Matrix<double>(fg * fgi), eps);
+
+   testFramework.changeSourceMethod("inverseLUD");
+   double fdet, mdet;
+   gnsstk::FixedMatrix<double,3,3> fgl(inverseLUD(fg, fdet));
+   gnsstk::Matrix<double> mgl(gnsstk::inverseLUD(mg, mdet));
+   TUASSERTFEPS(mgl, gnsstk::Matrix<double>(fgl), eps);
+   TUASSERTFEPS(mdet, fdet, eps);
+
+   testFramework.changeSourceMethod("inverseChol");
+   gnsstk::FixedMatrix<double,4,4> fsc(inverseChol(fs));
+   TUASSERTFEPS(gnsstk::inverseChol(ms), gnsstk::Matrix<double>(fsc), eps);
+   TUASSERTFEPS(I4, gnsstk::Matrix<double>(fs * fsc), eps);
+
+   testFramework.changeSourceMethod("inverseSVD");
+   gnsstk::FixedMatrix<double,4,4> fss(inverseSVD(fs));
+   TUASSERTFEPS(gnsstk::inverseSVD(ms), gnsstk::Matrix<double>(fss), eps);
+      // a singular matrix gets the same generalized inverse
+   double sing[9] = { 1.0, 2.0, 3.0,
+                      2.0, 4.0, 6.0,
+                      1.0, 0.0, 1.0 };
+   gnsstk::FixedMatrix<double,3,3> fsing(sing);
+   gnsstk::Matrix<double> msing(fsing);
+   TUASSERTFEPS(gnsstk::inverseSVD(msing),
+                gnsstk::Matrix<double>(inverseSVD(fsing)), eps);
+   TUTHROW(inverseLUD(fsing));
+   TUTHROW(inverseSVD(FixedMatrix33(0.0)));
+   TURETURN();
+}
+
+
+int main()
+{
+   FixedMatrix_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.conversionTest();
+   errorTotal += testClass.operatorTest();
+   errorTotal += testClass.decompTest();
+   errorTotal += testClass.inverseTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
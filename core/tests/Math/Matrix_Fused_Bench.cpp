@@ -0,0 +1,129 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file Matrix_Fused_Bench.cpp Benchmark the fused normal equation
+ * kernels in MatrixOperators.hpp (AtA, AtWA, Atb, multiplyAdd)
+ * against the equivalent chains of Matrix operators, for partials of
+ * n rows and 4, 8 and 40 columns.  Usage: Matrix_Fused_Bench [n
+ * [repeats]].  Defaults to 200 rows and 200 repeats. */
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include "Matrix.hpp"
+
+/// Time repeats calls of f, in seconds per call.
+template <class F>
+static double timeIt(unsigned repeats, F f)
+{
+   auto t0 = std::chrono::steady_clock::now();
+   for (unsigned r = 0; r < repeats; r++)
+      f();
+   auto t1 = std::chrono::steady_clock::now();
+   return std::chrono::duration<double>(t1 - t0).count() / repeats;
+}
+
+/// Print one line of results.
+static void report(const char *what, double tOps, double tFused,
+                   double check)
+{
+   std::cout << "    " << what << ": operators " << tOps * 1e6
+             << " us, fused " << tFused * 1e6 << " us, speedup "
+             << (tOps / tFused) << "x  (max diff " << check << ")"
+             << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+   size_t n = (argc > 1 ? std::atoi(argv[1]) : 200);
+   unsigned repeats = (argc > 2 ? std::atoi(argv[2]) : 200);
+   size_t ms[3] = { 4, 8, 40 };
+   double sink = 0.0;
+
+   for (unsigned s = 0; s < 3; s++)
+   {
+      size_t m = ms[s];
+      gnsstk::Matrix<double> A(n, m), W(n, n, 0.0), Info(m, m, 0.0),
+         N1, N2;
+      gnsstk::Vector<double> w(n), b(n), v1, v2;
+      for (size_t i = 0; i < n; i++)
+      {
+         for (size_t j = 0; j < m; j++)
+            A(i,j) = std::sin(1.3*i + 0.7*j*j);
+         w(i) = W(i,i) = 1.0 + 0.5 * std::cos(0.9*i);
+         b(i) = std::cos(0.3*i);
+      }
+      for (size_t j = 0; j < m; j++)
+         Info(j,j) = 1.0;
+      std::cout << "A is " << n << "x" << m << std::endl;
+
+      double tOps = timeIt(repeats, [&]() {
+         N1 = transpose(A) * A; sink += N1(0,0); });
+      double tFused = timeIt(repeats, [&]() {
+         N2 = gnsstk::AtA(A); sink += N2(0,0); });
+      report("AtA           ", tOps, tFused, gnsstk::maxabs(N1 - N2));
+
+      tOps = timeIt(repeats, [&]() {
+         N1 = transpose(A) * W * A + Info; sink += N1(0,0); });
+      tFused = timeIt(repeats, [&]() {
+         N2 = Info; N2 += gnsstk::AtWA(A, w); sink += N2(0,0); });
+      report("AtWA + Info   ", tOps, tFused, gnsstk::maxabs(N1 - N2));
+
+      tOps = timeIt(repeats, [&]() {
+         N1 = transpose(A) * W * A; sink += N1(0,0); });
+      tFused = timeIt(repeats, [&]() {
+         N2 = gnsstk::AtWA(A, W); sink += N2(0,0); });
+      report("AtWA (full W) ", tOps, tFused, gnsstk::maxabs(N1 - N2));
+
+      tOps = timeIt(repeats, [&]() {
+         v1 = transpose(A) * W * b; sink += v1(0); });
+      tFused = timeIt(repeats, [&]() {
+         v2 = gnsstk::AtWb(A, w, b); sink += v2(0); });
+      report("AtWb          ", tOps, tFused, gnsstk::maxabs(v1 - v2));
+
+      gnsstk::Matrix<double> At(transpose(A));
+      tOps = timeIt(repeats, [&]() {
+         N1 = At * A + Info; sink += N1(0,0); });
+      tFused = timeIt(repeats, [&]() {
+         N2 = gnsstk::multiplyAdd(At, A, Info); sink += N2(0,0); });
+      report("A*B+C         ", tOps, tFused, gnsstk::maxabs(N1 - N2));
+   }
+   std::cout << "(" << sink << ")" << std::endl;
+   return 0;
+}
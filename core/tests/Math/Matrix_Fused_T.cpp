@@ -0,0 +1,196 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <cmath>
+#include <iostream>
+
+#include "Matrix.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+
+class Matrix_Fused_T
+{
+public:
+      /// Make an r x c matrix of deterministic, well scaled values.
+   static gnsstk::Matrix<double> makeMatrix(size_t r, size_t c, double seed);
+      /// Make a vector of deterministic positive values (weights).
+   static gnsstk::Vector<double> makeWeights(size_t n, double seed);
+
+      /// AtA(), AtWA() and AAt() compared to the operator chains.
+   unsigned normalTest();
+      /// Atb() and AtWb() compared to the operator chains.
+   unsigned rhsTest();
+      /// multiplyAdd() and ABAt() compared to the operator chains.
+   unsigned productTest();
+      /// Dimension errors.
+   unsigned exceptionTest();
+};
+
+
+gnsstk::Matrix<double> Matrix_Fused_T ::
+makeMatrix(size_t r, size_t c, double seed)
+{
+   gnsstk::Matrix<double> m(r, c);
+   for (size_t i = 0; i < r; i++)
+      for (size_t j = 0; j < c; j++)
+         m(i,j) = std::sin(seed + 1.3*i + 0.7*j*j) + (i == j ? 2.0 : 0.0);
+   return m;
+}
+
+
+gnsstk::Vector<double> Matrix_Fused_T ::
+makeWeights(size_t n, double seed)
+{
+   gnsstk::Vector<double> w(n);
+   for (size_t i = 0; i < n; i++)
+      w(i) = 1.0 + 0.5 * std::cos(seed + 0.9*i);
+   return w;
+}
+
+
+unsigned Matrix_Fused_T ::
+normalTest()
+{
+   TUDEF("MatrixOperators", "AtWA");
+      // the common shapes, with n spanning several row blocks
+   size_t n = 150, ms[3] = { 4, 8, 40 };
+   for (unsigned s = 0; s < 3; s++)
+   {
+      size_t m = ms[s];
+      gnsstk::Matrix<double> A(makeMatrix(n, m, 0.1*s)), At(transpose(A));
+      gnsstk::Vector<double> w(makeWeights(n, 0.3*s));
+      gnsstk::Matrix<double> W(n, n, 0.0), Wfull(makeMatrix(n, n, 2.0));
+      for (size_t i = 0; i < n; i++)
+         W(i,i) = w(i);
+      double eps = 1e-12 * n;
+
+      gnsstk::Matrix<double> N(gnsstk::AtA(A));
+      TUASSERTE(size_t, m, N.rows());
+      TUASSERTE(size_t, m, N.cols());
+      TUASSERTFEPS(At * A, N, eps);
+      TUASSERTFEPS(transpose(N), N, 0.0);
+      TUASSERTFEPS(At * W * A, gnsstk::AtWA(A, w), eps);
+      TUASSERTFEPS(At * W * A, gnsstk::AtWA(A, W), eps);
+      TUASSERTFEPS(At * Wfull * A, gnsstk::AtWA(A, Wfull), eps);
+      TUASSERTFEPS(A * At, gnsstk::AAt(A), eps);
+   }
+      // no data gives a zero normal matrix
+   gnsstk::Matrix<double> empty(0, 4);
+   TUASSERTFEPS(gnsstk::Matrix<double>(4, 4, 0.0), gnsstk::AtA(empty), 0.0);
+   TURETURN();
+}
+
+
+unsigned Matrix_Fused_T ::
+rhsTest()
+{
+   TUDEF("MatrixOperators", "AtWb");
+   size_t n = 150, ms[3] = { 4, 8, 40 };
+   for (unsigned s = 0; s < 3; s++)
+   {
+      size_t m = ms[s];
+      gnsstk::Matrix<double> A(makeMatrix(n, m, 0.2*s)), At(transpose(A));
+      gnsstk::Vector<double> w(makeWeights(n, 0.4*s)),
+         b(makeWeights(n, 1.0+s));
+      gnsstk::Matrix<double> W(n, n, 0.0), Wfull(makeMatrix(n, n, 3.0));
+      for (size_t i = 0; i < n; i++)
+         W(i,i) = w(i);
+      double eps = 1e-12 * n;
+
+      TUASSERTFEPS(At * b, gnsstk::Atb(A, b), eps);
+      TUASSERTFEPS(At * W * b, gnsstk::AtWb(A, w, b), eps);
+      TUASSERTFEPS(At * Wfull * b, gnsstk::AtWb(A, Wfull, b), eps);
+   }
+   TURETURN();
+}
+
+
+unsigned Matrix_Fused_T ::
+productTest()
+{
+   TUDEF("MatrixOperators", "multiplyAdd");
+   gnsstk::Matrix<double> A(makeMatrix(7, 5, 0.5)), B(makeMatrix(5, 9, 1.5)),
+      C(makeMatrix(7, 9, 2.5)), P(makeMatrix(5, 5, 3.5));
+   TUASSERTFEPS(A * B + C, gnsstk::multiplyAdd(A, B, C), 1e-12);
+   TUCSM("ABAt");
+   TUASSERTFEPS(A * P * transpose(A), gnsstk::ABAt(A, P), 1e-12);
+      // a symmetric B gives a symmetric result
+   P = gnsstk::AtA(P);
+   gnsstk::Matrix<double> Q(gnsstk::ABAt(A, P));
+   TUASSERTFEPS(transpose(Q), Q, 1e-12);
+   TURETURN();
+}
+
+
+unsigned Matrix_Fused_T ::
+exceptionTest()
+{
+   TUDEF("MatrixOperators", "AtWA");
+   gnsstk::Matrix<double> A(makeMatrix(6, 3, 0.0)), W5(5, 5, 1.0),
+      B(makeMatrix(4, 2, 0.0)), C(makeMatrix(6, 2, 0.0));
+   gnsstk::Vector<double> w5(5, 1.0), b6(6, 1.0);
+   TUTHROW(gnsstk::AtWA(A, w5));
+   TUTHROW(gnsstk::AtWA(A, W5));
+   TUCSM("AtWb");
+   TUTHROW(gnsstk::Atb(A, w5));
+   TUTHROW(gnsstk::AtWb(A, w5, b6));
+   TUTHROW(gnsstk::AtWb(A, W5, b6));
+   TUCSM("multiplyAdd");
+   TUTHROW(gnsstk::multiplyAdd(A, B, C));
+   TUCSM("ABAt");
+   TUTHROW(gnsstk::ABAt(A, W5));
+   TURETURN();
+}
+
+
+int main()
+{
+   Matrix_Fused_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.normalTest();
+   errorTotal += testClass.rhsTest();
+   errorTotal += testClass.productTest();
+   errorTotal += testClass.exceptionTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,203 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+/** @file NavFilterMgr_Bench.cpp Benchmark GPS LNAV filtering
+ * throughput of a single NavFilterMgr against ShardedNavFilterMgr
+ * with increasing numbers of threads.  Synthetic subframes with
+ * valid parity are generated for 32 PRNs as seen by each receiver,
+ * with an occasional corrupted copy for the filters to reject.  The
+ * filter chain is parity, empty subframe, TLM/HOW and cross-source
+ * voting.  Usage: NavFilterMgr_Bench [receivers [epochs [threads]]].
+ * Defaults to 100 receivers, 100 epochs (10 minutes) and up to 4
+ * threads. */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include "ShardedNavFilterMgr.hpp"
+#include "LNavFilterData.hpp"
+#include "LNavParityFilter.hpp"
+#include "LNavEmptyFilter.hpp"
+#include "LNavTLMHOWFilter.hpp"
+#include "LNavCrossSourceFilter.hpp"
+#include "EngNav.hpp"
+#include "GPSWeekSecond.hpp"
+
+/// Create the filter chain being benchmarked.
+static gnsstk::ShardedNavFilterMgr::FilterChain makeChain()
+{
+   return gnsstk::ShardedNavFilterMgr::FilterChain {
+      std::make_shared<gnsstk::LNavParityFilter>(),
+      std::make_shared<gnsstk::LNavEmptyFilter>(),
+      std::make_shared<gnsstk::LNavTLMHOWFilter>(),
+      std::make_shared<gnsstk::LNavCrossSourceFilter>() };
+}
+
+/** Encode a subframe from 24-bit data words, computing parity.
+ * @param[in] data The 24 data bits of each word, right-aligned.
+ * @param[out] sf The encoded 30-bit words. */
+static void encode(const uint32_t data[10], uint32_t sf[10])
+{
+   uint32_t prev = 0;
+   for (unsigned i = 0; i < 10; i++)
+   {
+      uint32_t d = data[i] << 6;
+         // data bits are inverted when D30* is set
+      if (prev & 1)
+         d ^= 0x3fffffc0;
+      sf[i] = gnsstk::EngNav::fixParity(d, prev, (i == 1) || (i == 9));
+      prev = sf[i];
+   }
+}
+
+int main(int argc, char *argv[])
+{
+   unsigned numRx = (argc > 1 ? std::atoi(argv[1]) : 100);
+   unsigned numEpoch = (argc > 2 ? std::atoi(argv[2]) : 100);
+   unsigned maxThreads = (argc > 3 ? std::atoi(argv[3]) : 4);
+   const unsigned numPRN = 32;
+   unsigned long numMsg = (unsigned long)numRx * numPRN * numEpoch;
+   std::vector<uint32_t> words(numMsg * 10);
+   std::vector<gnsstk::LNavFilterData> msgs(numMsg);
+   gnsstk::CommonTime start = gnsstk::GPSWeekSecond(2100, 0);
+   unsigned long idx = 0;
+   for (unsigned epoch = 0; epoch < numEpoch; epoch++)
+   {
+      unsigned long tow = (epoch + 1) * 4; // 6-second TOW count
+      uint32_t sfid = (epoch % 5) + 1;
+      for (unsigned prn = 1; prn <= numPRN; prn++)
+      {
+         uint32_t data[10], sf[10];
+         data[1] = (tow << 7) | (sfid << 2);
+         for (unsigned w = 2; w < 10; w++)
+         {
+            data[w] = (prn * 0x10101 + epoch * 0x3579 + w * 0x2468) &
+               0xfffffc;
+         }
+            // Pick a TLM message that leaves D30 clear so the HOW
+            // is upright, as LNavTLMHOWFilter expects uncooked data
+            // to be.
+         for (uint32_t tlm = prn; ; tlm++)
+         {
+            data[0] = (0x8b << 16) | ((tlm & 0x3fff) << 2);
+            encode(data, sf);
+            if ((sf[0] & 1) == 0)
+               break;
+         }
+         for (unsigned rx = 0; rx < numRx; rx++, idx++)
+         {
+            uint32_t *msgWords = &words[idx * 10];
+            std::copy(sf, sf + 10, msgWords);
+               // occasional bit error
+            if ((idx % 97) == 0)
+               msgWords[idx % 10] ^= 0x1000;
+            gnsstk::LNavFilterData& fd(msgs[idx]);
+            fd.sf = msgWords;
+            fd.prn = prn;
+            fd.carrier = gnsstk::CarrierBand::L1;
+            fd.code = gnsstk::TrackingCode::CA;
+            fd.rxID = std::to_string(rx);
+            fd.timeStamp = start + tow * 1.5;
+         }
+      }
+   }
+   unsigned long perEpoch = (unsigned long)numRx * numPRN;
+   std::cout << "LNAV filtering: " << numRx << " receivers, " << numPRN
+             << " PRNs, " << numEpoch << " epochs, " << numMsg
+             << " subframes" << std::endl;
+
+   gnsstk::ShardedNavFilterMgr::FilterChain chain(makeChain());
+   gnsstk::NavFilterMgr mgr;
+   for (unsigned i = 0; i < chain.size(); i++)
+   {
+      mgr.addFilter(chain[i].get());
+   }
+   gnsstk::NavFilter::NavMsgList good, bad;
+   unsigned long numGood = 0, numBad = 0;
+   auto t0 = std::chrono::steady_clock::now();
+   for (unsigned long i = 0; i < numMsg; i++)
+   {
+      mgr.validate(&msgs[i], good);
+      gnsstk::NavFilterMgr::FilterSet::const_iterator fsi;
+      for (fsi = mgr.rejected.begin(); fsi != mgr.rejected.end(); fsi++)
+      {
+         numBad += (*fsi)->rejected.size();
+      }
+      if (((i+1) % perEpoch) == 0)
+      {
+         numGood += good.size();
+         good.clear();
+      }
+   }
+   mgr.finalizeInto(good);
+   for (gnsstk::NavFilter* filt : mgr.rejected)
+   {
+      numBad += filt->rejected.size();
+   }
+   numGood += good.size();
+   good.clear();
+   auto t1 = std::chrono::steady_clock::now();
+   double tBase = std::chrono::duration<double>(t1 - t0).count();
+   std::cout << "  NavFilterMgr:            " << tBase << " s ("
+             << (numMsg / tBase) << " msg/s, " << numGood << " good, "
+             << numBad << " rejected)" << std::endl;
+
+   for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+   {
+      gnsstk::ShardedNavFilterMgr smgr(makeChain, threads);
+      t0 = std::chrono::steady_clock::now();
+      for (unsigned long i = 0; i < numMsg; i++)
+      {
+         smgr.validate(&msgs[i]);
+         if (((i+1) % perEpoch) == 0)
+         {
+            smgr.sync(good, bad);
+         }
+      }
+      smgr.finalize(good, bad);
+      t1 = std::chrono::steady_clock::now();
+      double tShard = std::chrono::duration<double>(t1 - t0).count();
+      std::cout << "  ShardedNavFilterMgr(" << threads << "): "
+                << tShard << " s (" << (numMsg / tShard) << " msg/s, "
+                << good.size() << " good, " << bad.size()
+                << " rejected)  speedup " << (tBase / tShard) << "x"
+                << std::endl;
+      good.clear();
+      bad.clear();
+   }
+   return 0;
+}
@@ -131,6 +131,46 @@ public:
    NavMsgList cache;
 };
 
+// reject odd values
+class BunkFilter3 : public NavFilter
+{
+public:
+   BunkFilter3() {}
+   virtual void validate(NavMsgList& msgBitsIn, NavMsgList& msgBitsOut)
+   {
+      NavMsgList::iterator nmli;
+      for (nmli = msgBitsIn.begin(); nmli != msgBitsIn.end(); nmli++)
+      {
+         BunkFilterData *fd = dynamic_cast<BunkFilterData*>(*nmli);
+         if (*(fd->data) & 1)
+            reject(*nmli);
+         else
+            accept(*nmli, msgBitsOut);
+      }
+   }
+   virtual void finalize(NavMsgList& msgBitsOut)
+   {}
+   virtual unsigned processingDepth() const noexcept
+   { return 0; }
+   virtual std::string filterName() const noexcept
+   { return "Bunk3"; }
+};
+
+// manager overriding only finalize(), which must not hide finalizeInto()
+class CountFinalizeMgr : public NavFilterMgr
+{
+public:
+   CountFinalizeMgr()
+         : count(0)
+   {}
+   virtual NavFilter::NavMsgList finalize()
+   {
+      count++;
+      return NavFilterMgr::finalize();
+   }
+   unsigned count;
+};
+
 class NavFilterMgr_T
 {
 public:
@@ -168,6 +208,8 @@ public:
    unsigned testBunk1();
       /// test a filter with behavior like multiple input epochs
    unsigned testBunk2();
+      /// test the streaming validate/finalize and filter statistics
+   unsigned testStream();
 
    string inputFileLNAV;
    string inputFileBunk;
@@ -797,6 +839,81 @@ testBunk2()
 }
 
 
+unsigned NavFilterMgr_T ::
+testStream()
+{
+   TUDEF("NavFilterMgr", "validate");
+   NavFilterMgr mgr;
+   BunkFilter3 filt3;
+   BunkFilter2 filt2;
+   std::vector<uint32_t> values(20);
+   std::vector<BunkFilterData> data(20);
+   for (unsigned i = 0; i < data.size(); i++)
+   {
+      values[i] = 0xabcd00 + i;
+      data[i].data = &values[i];
+   }
+   mgr.addFilter(&filt3);
+   mgr.addFilter(&filt2);
+   mgr.setTiming(true);
+      // reuse the output list, keeping a copy of the results
+   gnsstk::NavFilter::NavMsgList out, all;
+   for (unsigned i = 0; i < data.size(); i++)
+   {
+      out.clear();
+      mgr.validate(&data[i], out);
+         // odd values are rejected by filt3
+      TUASSERTE(bool, (i & 1) != 0, mgr.rejected.count(&filt3) == 1);
+      all.insert(all.end(), out.begin(), out.end());
+   }
+      // filt2 holds on to 4 messages until finalize
+   TUASSERTE(size_t, 6, all.size());
+   testFramework.changeSourceMethod("finalizeInto");
+   mgr.finalizeInto(all);
+   TUASSERTE(size_t, 10, all.size());
+   unsigned expValue = values[0];
+   for (gnsstk::NavFilter::NavMsgList::const_iterator nmli = all.begin();
+        nmli != all.end(); nmli++)
+   {
+      BunkFilterData *fd = dynamic_cast<BunkFilterData*>(*nmli);
+      TUASSERTE(unsigned, expValue, *(fd->data));
+      expValue += 2;
+   }
+   testFramework.changeSourceMethod("getStats");
+   const NavFilterMgr::FilterStatsList& stats(mgr.getStats());
+   TUASSERTE(size_t, 2, stats.size());
+   TUASSERTE(NavFilter*, &filt3, stats[0].filter);
+   TUASSERTE(unsigned long, 21, stats[0].calls);
+   TUASSERTE(unsigned long, 20, stats[0].input);
+   TUASSERTE(unsigned long, 10, stats[0].accepted);
+   TUASSERTE(unsigned long, 10, stats[0].rejected);
+   TUASSERT(stats[0].seconds >= 0);
+   TUASSERTE(NavFilter*, &filt2, stats[1].filter);
+   TUASSERTE(unsigned long, 11, stats[1].calls);
+   TUASSERTE(unsigned long, 10, stats[1].input);
+   TUASSERTE(unsigned long, 10, stats[1].accepted);
+   TUASSERTE(unsigned long, 0, stats[1].rejected);
+   testFramework.changeSourceMethod("resetStats");
+   mgr.resetStats();
+   TUASSERTE(NavFilter*, &filt2, stats[1].filter);
+   TUASSERTE(unsigned long, 0, stats[1].calls);
+   TUASSERTE(unsigned long, 0, stats[1].accepted);
+   testFramework.changeSourceMethod("finalizeInto");
+   CountFinalizeMgr cmgr;
+   BunkFilter2 cfilt;
+   cmgr.addFilter(&cfilt);
+   out.clear();
+   cmgr.validate(&data[0], out);
+   TUASSERT(out.empty());
+   cmgr.finalizeInto(out);
+   TUASSERTE(size_t, 1, out.size());
+   TUASSERTE(unsigned, 0, cmgr.count);
+   TUASSERT(cmgr.finalize().empty());
+   TUASSERTE(unsigned, 1, cmgr.count);
+   TURETURN();
+}
+
+
 int main()
 {
    unsigned errorTotal = 0;
@@ -814,6 +931,7 @@ int main()
    errorTotal += testClass.testProcessingDepths();
    errorTotal += testClass.testBunk1();
    errorTotal += testClass.testBunk2();
+   errorTotal += testClass.testStream();
 
    cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
 
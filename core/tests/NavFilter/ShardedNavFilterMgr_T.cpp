@@ -0,0 +1,391 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <map>
+#include <set>
+#include "ShardedNavFilterMgr.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+// message data for testing, a single value
+class ShardTestData : public NavFilterKey
+{
+public:
+   ShardTestData()
+         : value(0)
+   {}
+   unsigned value;
+};
+
+// reject values divisible by 7
+class ShardRejectFilter : public NavFilter
+{
+public:
+   virtual void validate(NavMsgList& msgBitsIn, NavMsgList& msgBitsOut)
+   {
+      NavMsgList::iterator nmli;
+      for (nmli = msgBitsIn.begin(); nmli != msgBitsIn.end(); nmli++)
+      {
+         ShardTestData *fd = dynamic_cast<ShardTestData*>(*nmli);
+         prns.insert(fd->prn);
+         if (fd->value == 999999)
+         {
+            Exception exc("bad value");
+            GNSSTK_THROW(exc);
+         }
+         if ((fd->value % 7) == 0)
+            reject(*nmli);
+         else
+            accept(*nmli, msgBitsOut);
+      }
+   }
+   virtual void finalize(NavMsgList& msgBitsOut)
+   {}
+   virtual unsigned processingDepth() const noexcept
+   { return 0; }
+   virtual std::string filterName() const noexcept
+   { return "Reject7"; }
+      /// every PRN this filter has seen
+   std::set<uint32_t> prns;
+};
+
+// hold on to the last 3 messages
+class ShardCacheFilter : public NavFilter
+{
+public:
+   virtual void validate(NavMsgList& msgBitsIn, NavMsgList& msgBitsOut)
+   {
+      cache.insert(cache.end(), msgBitsIn.begin(), msgBitsIn.end());
+      while (cache.size() > 3)
+      {
+         msgBitsOut.push_back(cache.front());
+         cache.pop_front();
+      }
+   }
+   virtual void finalize(NavMsgList& msgBitsOut)
+   {
+      msgBitsOut.splice(msgBitsOut.end(), cache);
+   }
+   virtual unsigned processingDepth() const noexcept
+   { return 3; }
+   virtual std::string filterName() const noexcept
+   { return "Cache3"; }
+   NavMsgList cache;
+};
+
+class ShardedNavFilterMgr_T
+{
+public:
+   ShardedNavFilterMgr_T();
+      /// Compare the sharded results against NavFilterMgr.
+   unsigned resultsTest();
+      /** Make sure messages rejected while the cache filter's
+       * finalize() output passes through the reject filter are
+       * returned. */
+   unsigned cacheFirstTest();
+      /// Make sure exceptions in worker threads reach the caller.
+   unsigned exceptionTest();
+
+      /// Values of the messages in list, grouped by PRN.
+   typedef map<uint32_t, vector<unsigned> > PRNValues;
+   static PRNValues byPRN(const NavFilter::NavMsgList& list);
+      /// Values of the messages in list.
+   static vector<unsigned> values(const NavFilter::NavMsgList& list);
+
+   vector<ShardTestData> data;
+   static const unsigned numPRN = 32, numRx = 3, numEpoch = 50;
+};
+
+
+ShardedNavFilterMgr_T ::
+ShardedNavFilterMgr_T()
+      : data(numPRN * numRx * numEpoch)
+{
+   unsigned idx = 0;
+   for (unsigned epoch = 0; epoch < numEpoch; epoch++)
+   {
+      for (unsigned prn = 1; prn <= numPRN; prn++)
+      {
+         for (unsigned rx = 0; rx < numRx; rx++, idx++)
+         {
+            data[idx].prn = prn;
+            data[idx].carrier = CarrierBand::L1;
+            data[idx].code = (rx == 0 ? TrackingCode::CA : TrackingCode::Y);
+            data[idx].value = idx;
+         }
+      }
+   }
+}
+
+
+ShardedNavFilterMgr_T::PRNValues ShardedNavFilterMgr_T ::
+byPRN(const NavFilter::NavMsgList& list)
+{
+   PRNValues rv;
+   NavFilter::NavMsgList::const_iterator nmli;
+   for (nmli = list.begin(); nmli != list.end(); nmli++)
+   {
+      ShardTestData *fd = dynamic_cast<ShardTestData*>(*nmli);
+      rv[fd->prn].push_back(fd->value);
+   }
+   return rv;
+}
+
+
+vector<unsigned> ShardedNavFilterMgr_T ::
+values(const NavFilter::NavMsgList& list)
+{
+   vector<unsigned> rv;
+   NavFilter::NavMsgList::const_iterator nmli;
+   for (nmli = list.begin(); nmli != list.end(); nmli++)
+   {
+      rv.push_back(dynamic_cast<ShardTestData*>(*nmli)->value);
+   }
+   return rv;
+}
+
+
+unsigned ShardedNavFilterMgr_T ::
+resultsTest()
+{
+   TUDEF("ShardedNavFilterMgr", "validate");
+      // reference results using a single filter chain per PRN
+   map<uint32_t, ShardRejectFilter> refReject;
+   map<uint32_t, ShardCacheFilter> refCache;
+   map<uint32_t, NavFilterMgr> refMgr;
+   NavFilter::NavMsgList refGood, refBad;
+   for (unsigned i = 0; i < data.size(); i++)
+   {
+      uint32_t prn = data[i].prn;
+      if (refMgr.find(prn) == refMgr.end())
+      {
+         refMgr[prn].addFilter(&refReject[prn]);
+         refMgr[prn].addFilter(&refCache[prn]);
+      }
+      refMgr[prn].validate(&data[i], refGood);
+      refBad.insert(refBad.end(), refReject[prn].rejected.begin(),
+                    refReject[prn].rejected.end());
+   }
+   for (auto& mi : refMgr)
+   {
+      mi.second.finalizeInto(refGood);
+   }
+   PRNValues refGoodPRN(byPRN(refGood)), refBadPRN(byPRN(refBad));
+
+   vector<unsigned> firstGood;
+   for (unsigned numShards = 1; numShards <= 4; numShards++)
+   {
+      for (unsigned pass = 0; pass < 2; pass++)
+      {
+         vector<ShardRejectFilter*> rejectFilters;
+         ShardedNavFilterMgr uut(
+            [&rejectFilters]()
+            {
+               std::shared_ptr<ShardRejectFilter> rf =
+                  std::make_shared<ShardRejectFilter>();
+               rejectFilters.push_back(rf.get());
+               return ShardedNavFilterMgr::FilterChain {
+                  rf, std::make_shared<ShardCacheFilter>() };
+            }, numShards, ShardedNavFilterMgr::skPRN, 16);
+         TUASSERTE(unsigned, numShards, uut.getNumShards());
+         NavFilter::NavMsgList good, bad;
+         for (unsigned i = 0; i < data.size(); i++)
+         {
+            uut.validate(&data[i]);
+               // sync once per epoch
+            if (((i+1) % (numPRN*numRx)) == 0)
+               uut.sync(good, bad);
+         }
+         uut.finalize(good, bad);
+         TUASSERTE(size_t, refGood.size(), good.size());
+         TUASSERTE(size_t, refBad.size(), bad.size());
+            // the order within each PRN must match the serial results
+         TUASSERT(refGoodPRN == byPRN(good));
+         TUASSERT(refBadPRN == byPRN(bad));
+            // the complete output must be repeatable
+         if (pass == 0)
+            firstGood = values(good);
+         else
+            TUASSERT(firstGood == values(good));
+            // each PRN must only have been seen by one shard
+         TUASSERTE(size_t, numShards, rejectFilters.size());
+         set<uint32_t> seen;
+         size_t total = 0;
+         for (unsigned j = 0; j < rejectFilters.size(); j++)
+         {
+            seen.insert(rejectFilters[j]->prns.begin(),
+                        rejectFilters[j]->prns.end());
+            total += rejectFilters[j]->prns.size();
+         }
+         TUASSERTE(size_t, numPRN, seen.size());
+         TUASSERTE(size_t, numPRN, total);
+            // stats are summed over the shards
+         testFramework.changeSourceMethod("getStats");
+         NavFilterMgr::FilterStatsList stats(uut.getStats());
+         TUASSERTE(size_t, 2, stats.size());
+         TUASSERTE(unsigned long, data.size(), stats[0].input);
+         TUASSERTE(unsigned long, refBad.size(), stats[0].rejected);
+         TUASSERTE(unsigned long, refGood.size(), stats[1].accepted);
+         testFramework.changeSourceMethod("validate");
+      }
+   }
+
+      // sharding by signal splits a PRN's sources across shards
+      // but keeps each signal in order
+   testFramework.changeSourceMethod("skSignal");
+   ShardedNavFilterMgr sigMgr(
+      []()
+      {
+         return ShardedNavFilterMgr::FilterChain {
+            std::make_shared<ShardRejectFilter>() };
+      }, 3, ShardedNavFilterMgr::skSignal);
+   NavFilter::NavMsgList good, bad;
+   for (unsigned i = 0; i < data.size(); i++)
+   {
+      sigMgr.validate(&data[i]);
+   }
+   sigMgr.finalize(good, bad);
+   TUASSERTE(size_t, refGood.size(), good.size());
+   TUASSERTE(size_t, refBad.size(), bad.size());
+   TUASSERT(sigMgr.getShard(&data[0]) != sigMgr.getShard(&data[1]));
+   TUASSERTE(unsigned, sigMgr.getShard(&data[1]),
+             sigMgr.getShard(&data[2]));
+   TURETURN();
+}
+
+
+unsigned ShardedNavFilterMgr_T ::
+cacheFirstTest()
+{
+   TUDEF("ShardedNavFilterMgr", "finalize");
+   unsigned expBad = 0;
+   for (unsigned i = 0; i < data.size(); i++)
+   {
+      if ((data[i].value % 7) == 0)
+         expBad++;
+   }
+      // reference results using a single filter chain per PRN
+   map<uint32_t, ShardCacheFilter> refCache;
+   map<uint32_t, ShardRejectFilter> refReject;
+   map<uint32_t, NavFilterMgr> refMgr;
+   NavFilter::NavMsgList refGood, refBad;
+   for (unsigned i = 0; i < data.size(); i++)
+   {
+      uint32_t prn = data[i].prn;
+      if (refMgr.find(prn) == refMgr.end())
+      {
+         refMgr[prn].addFilter(&refCache[prn]);
+         refMgr[prn].addFilter(&refReject[prn]);
+      }
+      refMgr[prn].validate(&data[i], refGood);
+      refBad.insert(refBad.end(), refReject[prn].rejected.begin(),
+                    refReject[prn].rejected.end());
+   }
+   for (auto& mi : refMgr)
+   {
+      mi.second.finalizeInto(refGood);
+      refBad.insert(refBad.end(), mi.second.finalizeRejected.begin(),
+                    mi.second.finalizeRejected.end());
+   }
+   TUASSERTE(size_t, expBad, refBad.size());
+   TUASSERTE(size_t, data.size() - expBad, refGood.size());
+   for (unsigned numShards = 1; numShards <= 3; numShards++)
+   {
+      ShardedNavFilterMgr uut(
+         []()
+         {
+            return ShardedNavFilterMgr::FilterChain {
+               std::make_shared<ShardCacheFilter>(),
+               std::make_shared<ShardRejectFilter>() };
+         }, numShards, ShardedNavFilterMgr::skPRN, 16);
+      NavFilter::NavMsgList good, bad;
+      for (unsigned i = 0; i < data.size(); i++)
+      {
+         uut.validate(&data[i]);
+      }
+      uut.sync(good, bad);
+      uut.finalize(good, bad);
+      TUASSERTE(size_t, refGood.size(), good.size());
+      TUASSERTE(size_t, refBad.size(), bad.size());
+      TUASSERT(byPRN(refGood) == byPRN(good));
+      TUASSERT(byPRN(refBad) == byPRN(bad));
+   }
+   TURETURN();
+}
+
+
+unsigned ShardedNavFilterMgr_T ::
+exceptionTest()
+{
+   TUDEF("ShardedNavFilterMgr", "sync");
+   ShardedNavFilterMgr uut(
+      []()
+      {
+         return ShardedNavFilterMgr::FilterChain {
+            std::make_shared<ShardRejectFilter>() };
+      }, 2);
+   ShardTestData bad;
+   bad.prn = 5;
+   bad.value = 999999;
+   NavFilter::NavMsgList good, rejected;
+   uut.validate(&data[1]);
+   uut.validate(&bad);
+   TUTHROW(uut.sync(good, rejected));
+      // the error is only reported once and processing continues
+   uut.validate(&data[2]);
+   TUCATCH(uut.sync(good, rejected));
+   TUASSERTE(size_t, 2, good.size());
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   ShardedNavFilterMgr_T testClass;
+
+   errorTotal += testClass.resultsTest();
+   errorTotal += testClass.cacheFirstTest();
+   errorTotal += testClass.exceptionTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal; // Return the total number of errors
+}
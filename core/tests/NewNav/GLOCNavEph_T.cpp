@@ -79,6 +79,8 @@ public:
    unsigned getXvtLTTest();
    unsigned getUserTimeTest();
    unsigned fixFitTest();
+      /// Compare getXvt() using the orbit fit against integration.
+   unsigned orbitFitTest();
    unsigned haveLTDMPTest();
 };
 
@@ -113,6 +115,7 @@ constructorTest()
    TUASSERTE(int, 1, std::isnan(uut.tauDelta));
    TUASSERTE(int, 1, std::isnan(uut.tauGPS));
    TUASSERTFE(60.0, uut.step);
+   TUASSERTFE(0.0, uut.fitAccuracy);
    TURETURN();
 }
 
@@ -337,6 +340,53 @@ haveLTDMPTest()
 }
 
 
+unsigned GLOCNavEph_T ::
+orbitFitTest()
+{
+   TUDEF("GLOCNavEph", "getXvt(fit)");
+   gnsstk::GLOCNavEph uut;
+   uut.pos[0] = 7003.008789;
+   uut.vel[0] = 0.7835417;
+   uut.acc[0] = 0;
+   uut.pos[1] = -12206.626953;
+   uut.vel[1] = 2.8042530;
+   uut.acc[1] = 1.7e-9;
+   uut.pos[2] = 21280.765625;
+   uut.vel[2] = 1.3525150;
+   uut.acc[2] = -5.41e-9;
+   uut.clkBias = 5e-5;
+   uut.freqBias = 1e-12;
+   uut.Toe = gnsstk::YDSTime(2012, 251, 11700);
+   gnsstk::GLOCNavEph fitted(uut);
+   fitted.fitAccuracy = 1e-3;
+   gnsstk::Xvt exp, got;
+      // The fit must agree with the integrator to within fitAccuracy
+      // everywhere in the fit interval.
+   for (double dt = -900; dt <= 900; dt += 30)
+   {
+      TUASSERTE(bool, true, uut.getXvt(uut.Toe + dt, exp));
+      TUASSERTE(bool, true, fitted.getXvt(uut.Toe + dt, got));
+      for (unsigned i = 0; i < 3; i++)
+      {
+         TUASSERTFEPS(exp.x[i], got.x[i], 1e-3);
+         TUASSERTFEPS(exp.v[i], got.v[i], 1e-3);
+      }
+      TUASSERTFE(exp.clkbias, got.clkbias);
+   }
+      // Changing the ephemeris must not use the stale fit.
+   uut.pos[0] += 1.0;
+   fitted.pos[0] += 1.0;
+   TUASSERTE(bool, true, uut.getXvt(uut.Toe + 500, exp));
+   TUASSERTE(bool, true, fitted.getXvt(uut.Toe + 500, got));
+   for (unsigned i = 0; i < 3; i++)
+   {
+      TUASSERTFEPS(exp.x[i], got.x[i], 1e-3);
+      TUASSERTFEPS(exp.v[i], got.v[i], 1e-3);
+   }
+   TURETURN();
+}
+
+
 int main()
 {
    GLOCNavEph_T testClass;
@@ -350,6 +400,7 @@ int main()
    errorTotal += testClass.getXvtLTTest();
    errorTotal += testClass.getUserTimeTest();
    errorTotal += testClass.fixFitTest();
+   errorTotal += testClass.orbitFitTest();
    errorTotal += testClass.haveLTDMPTest();
 
    std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
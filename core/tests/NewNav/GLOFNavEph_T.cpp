@@ -60,6 +60,8 @@ public:
    unsigned getXvtTest();
    unsigned getUserTimeTest();
    unsigned fixFitTest();
+      /// Compare getXvt() using the orbit fit against integration.
+   unsigned orbitFitTest();
 };
 
 
@@ -101,6 +103,7 @@ constructorTest()
    TUASSERTE(unsigned, -1, uut.dayCount);
    TUASSERTE(gnsstk::CommonTime, exp, uut.Toe);
    TUASSERTFE(60.0, uut.step);
+   TUASSERTFE(0.0, uut.fitAccuracy);
    TURETURN();
 }
 
@@ -240,6 +243,62 @@ fixFitTest()
 }
 
 
+unsigned GLOFNavEph_T ::
+orbitFitTest()
+{
+   TUDEF("GLOFNavEph", "getXvt(fit)");
+   gnsstk::GLOFNavEph uut;
+   uut.pos[0] = 15553.6342773;
+   uut.pos[1] = -19901.1298828;
+   uut.pos[2] = 3553.3354492200001;
+   uut.vel[0] = -0.41938495636000001;
+   uut.vel[1] = 0.32419204711900002;
+   uut.vel[2] = 3.5266609191899998;
+   uut.acc[0] = 0;
+   uut.acc[1] = -9.3132257461499999e-10;
+   uut.acc[2] = -1.86264514923e-09;
+   uut.clkBias = 5.0653703510800001e-05;
+   uut.freqBias = 1.8189894035500001e-12;
+   uut.interval = 30;
+   uut.Toe = gnsstk::CivilTime(2006, 10, 1, 0, 15, 0, gnsstk::TimeSystem::GLO);
+   gnsstk::GLOFNavEph fitted(uut);
+   fitted.fitAccuracy = 1e-3;
+   gnsstk::Xvt exp, got;
+      // The fit must agree with the integrator to within fitAccuracy
+      // everywhere in the fit interval.
+   for (double dt = -930; dt <= 930; dt += 30)
+   {
+      TUASSERTE(bool, true, uut.getXvt(uut.Toe + dt, exp));
+      TUASSERTE(bool, true, fitted.getXvt(uut.Toe + dt, got));
+      for (unsigned i = 0; i < 3; i++)
+      {
+         TUASSERTFEPS(exp.x[i], got.x[i], 1e-3);
+         TUASSERTFEPS(exp.v[i], got.v[i], 1e-3);
+      }
+      TUASSERTFE(exp.clkbias, got.clkbias);
+   }
+      // Outside the fit interval, integration is used.
+   TUASSERTE(bool, true, uut.getXvt(uut.Toe + 930 + 60, exp));
+   TUASSERTE(bool, true, fitted.getXvt(uut.Toe + 930 + 60, got));
+   for (unsigned i = 0; i < 3; i++)
+   {
+      TUASSERTFE(exp.x[i], got.x[i]);
+      TUASSERTFE(exp.v[i], got.v[i]);
+   }
+      // Changing the ephemeris must not use the stale fit.
+   uut.pos[0] += 1.0;
+   fitted.pos[0] += 1.0;
+   TUASSERTE(bool, true, uut.getXvt(uut.Toe + 500, exp));
+   TUASSERTE(bool, true, fitted.getXvt(uut.Toe + 500, got));
+   for (unsigned i = 0; i < 3; i++)
+   {
+      TUASSERTFEPS(exp.x[i], got.x[i], 1e-3);
+      TUASSERTFEPS(exp.v[i], got.v[i], 1e-3);
+   }
+   TURETURN();
+}
+
+
 int main()
 {
    GLOFNavEph_T testClass;
@@ -250,6 +309,7 @@ int main()
    errorTotal += testClass.getXvtTest();
    errorTotal += testClass.getUserTimeTest();
    errorTotal += testClass.fixFitTest();
+   errorTotal += testClass.orbitFitTest();
 
    std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
              << std::endl;
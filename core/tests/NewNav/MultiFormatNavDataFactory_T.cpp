@@ -44,6 +44,8 @@
 #include "GPSLNavHealth.hpp"
 #include "OrbitDataSP3.hpp"
 #include "DebugTrace.hpp"
+#include "SP3Stream.hpp"
+#include "GPSWeekSecond.hpp"
 
 namespace gnsstk
 {
@@ -142,6 +144,19 @@ public:
       /// Exercise loadIntoMap by loading data with different options in place.
    unsigned loadIntoMapTest();
    unsigned getFactoryTest();
+      /// Make sure parallel loading matches serial loading.
+   unsigned addDataSourcesTest();
+
+      /** Write a small SP3c file containing GPS PRNs 1-4 at 15
+       * minute intervals.  The positions and clocks are a function
+       * of the file index so that overlapping files are
+       * distinguishable.
+       * @param[in] fname The path of the file to write.
+       * @param[in] start The time of the first epoch.
+       * @param[in] numEpochs The number of epochs to write.
+       * @param[in] fileIdx The index of the file. */
+   void writeSP3(const std::string& fname, const gnsstk::CommonTime& start,
+                 int numEpochs, int fileIdx);
 };
 
 
@@ -647,6 +662,146 @@ getFactoryTest()
 }
 
 
+void MultiFormatNavDataFactory_T ::
+writeSP3(const std::string& fname, const gnsstk::CommonTime& start,
+         int numEpochs, int fileIdx)
+{
+   gnsstk::SP3Stream strm(fname.c_str(), std::ios::out);
+   strm.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+   gnsstk::SP3Header& head(strm.header);
+   head.version = gnsstk::SP3Header::SP3c;
+   head.containsVelocity = false;
+   head.time = start;
+   head.epochInterval = 900;
+   head.numberOfEpochs = numEpochs;
+   head.dataUsed = "ORBIT";
+   head.coordSystem = "IGS08";
+   head.orbitType = "FIT";
+   head.agency = "TEST";
+   head.system = gnsstk::SP3SatID(1, gnsstk::SatelliteSystem::GPS);
+   head.timeSystem = gnsstk::TimeSystem::GPS;
+   head.basePV = 1.25;
+   head.baseClk = 1.025;
+   for (int prn = 1; prn <= 4; prn++)
+   {
+      head.satList[gnsstk::SP3SatID(prn, gnsstk::SatelliteSystem::GPS)] = 0;
+   }
+   strm << head;
+   for (int epoch = 0; epoch < numEpochs; epoch++)
+   {
+      gnsstk::SP3Data rec;
+      rec.RecType = '*';
+      rec.time = start + epoch * 900.0;
+      strm << rec;
+      double sod = static_cast<gnsstk::GPSWeekSecond>(rec.time).sow;
+      for (int prn = 1; prn <= 4; prn++)
+      {
+         rec.RecType = 'P';
+         rec.sat = gnsstk::SatID(prn, gnsstk::SatelliteSystem::GPS);
+         rec.x[0] = 20000 + 1000*prn + sod / 100.0;
+         rec.x[1] = -10000 + 500*prn - sod / 50.0;
+         rec.x[2] = 15000 + fileIdx;
+         rec.clk = 10*prn + 0.01*fileIdx;
+         for (int i = 0; i < 4; i++)
+         {
+            rec.sig[i] = 0;
+         }
+         strm << rec;
+      }
+   }
+   strm.close();
+}
+
+
+unsigned MultiFormatNavDataFactory_T ::
+addDataSourcesTest()
+{
+   TUDEF("MultiFormatNavDataFactory", "addDataSources");
+   std::string tpath = gnsstk::getPathTestTemp() + gnsstk::getFileSep();
+   gnsstk::CommonTime start = gnsstk::GPSWeekSecond(2100, 86400);
+   std::vector<std::string> files;
+      // Files of 6 hours each that overlap by one epoch, so the
+      // order in which they're added determines the stored data.
+   for (int i = 0; i < 6; i++)
+   {
+      std::string fname = tpath + "MultiFormatNavDataFactory_T_" +
+         gnsstk::StringUtils::asString(i) + ".sp3";
+      writeSP3(fname, start + i * 21600.0, 25, i);
+      files.push_back(fname);
+   }
+      // and one that can't be loaded
+   files.insert(files.begin() + 3, tpath + "MultiFormatNavDataFactory_T_X");
+   gnsstk::MultiFormatNavDataFactory uut;
+   std::vector<gnsstk::NavMessageID> nmids;
+   for (int prn = 1; prn <= 4; prn++)
+   {
+      gnsstk::NavMessageID nmid;
+      nmid.sat = gnsstk::SatID(prn, gnsstk::SatelliteSystem::GPS);
+      gnsstk::SP3NavDataFactory::transNavMsgID(nmid, nmid);
+      nmid.messageType = gnsstk::NavMessageType::Ephemeris;
+      nmids.push_back(nmid);
+      nmid.messageType = gnsstk::NavMessageType::Clock;
+      nmids.push_back(nmid);
+   }
+      // Look up data at every epoch and in between epochs.
+   auto query = [&](std::vector<gnsstk::OrbitDataSP3>& results)
+   {
+      for (double offs = 0; offs <= 6 * 21600; offs += 1800)
+      {
+         for (const auto& nmid : nmids)
+         {
+            gnsstk::NavDataPtr ndp;
+            if (uut.find(nmid, start + offs, ndp, gnsstk::SVHealth::Any,
+                         gnsstk::NavValidityType::ValidOnly,
+                         gnsstk::NavSearchOrder::User))
+            {
+               results.push_back(
+                  *dynamic_cast<gnsstk::OrbitDataSP3*>(ndp.get()));
+            }
+         }
+      }
+   };
+   std::vector<gnsstk::OrbitDataSP3> serial, parallel;
+   uut.clear();
+   bool rv = true;
+   for (const auto& fname : files)
+   {
+      rv &= uut.addDataSource(fname);
+   }
+   TUASSERTE(bool, false, rv);
+   size_t serialSize = uut.size();
+   query(serial);
+   TUASSERT(serial.size() > 0);
+   for (unsigned threads : {2, 4})
+   {
+      uut.clear();
+      TUASSERTE(bool, false, uut.addDataSources(files, threads));
+      TUASSERTE(size_t, serialSize, uut.size());
+      parallel.clear();
+      query(parallel);
+      TUASSERTE(size_t, serial.size(), parallel.size());
+      for (size_t i = 0; (i < serial.size()) && (i < parallel.size()); i++)
+      {
+         TUASSERTE(gnsstk::CommonTime, serial[i].timeStamp,
+                   parallel[i].timeStamp);
+         TUASSERTE(gnsstk::Triple, serial[i].pos, parallel[i].pos);
+         TUASSERTFE(serial[i].clkBias, parallel[i].clkBias);
+      }
+   }
+      // every file loads successfully
+   files.erase(files.begin() + 3);
+   uut.clear();
+   TUASSERTE(bool, true, uut.addDataSources(files, 3));
+   TUASSERTE(size_t, serialSize, uut.size());
+   uut.clear();
+   for (const auto& fname : files)
+   {
+      remove(fname.c_str());
+   }
+   TURETURN();
+}
+
+
 int main()
 {
    MultiFormatNavDataFactory_T testClass;
@@ -665,6 +820,7 @@ int main()
    errorTotal += testClass.addTypeFilterTest();
    errorTotal += testClass.loadIntoMapTest();
    errorTotal += testClass.getFactoryTest();
+   errorTotal += testClass.addDataSourcesTest();
 
    std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
              << std::endl;
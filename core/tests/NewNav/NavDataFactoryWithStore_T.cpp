@@ -161,6 +161,8 @@ public:
    unsigned isPresentTest();
    unsigned countTest();
    unsigned getFirstLastTimeTest();
+      /// Make sure find() gives the same results after freeze().
+   unsigned freezeTest();
 
       /// Fill fact with test data
    void fillFactory(gnsstk::TestUtil& testFramework, TestClass& fact);
@@ -2141,6 +2143,105 @@ getFirstLastTimeTest()
 }
 
 
+unsigned NavDataFactoryWithStore_T ::
+freezeTest()
+{
+   TUDEF("NavDataFactoryWithStore", "freeze");
+   TestClass uut, frozen;
+   using SS = gnsstk::SatelliteSystem;
+   using CB = gnsstk::CarrierBand;
+   using TC = gnsstk::TrackingCode;
+   using NT = gnsstk::NavType;
+   using SH = gnsstk::SVHealth;
+   using MT = gnsstk::NavMessageType;
+   using VT = gnsstk::NavValidityType;
+   using SO = gnsstk::NavSearchOrder;
+   gnsstk::CommonTime refct = gnsstk::GPSWeekSecond(2101, 0);
+   for (TestClass *fact : {&uut, &frozen})
+   {
+      for (unsigned i = 0; i < 120; i++)
+      {
+         SH hea = (i >= 57 ? SH::Unhealthy : SH::Healthy);
+         for (MT nmt : {MT::Health, MT::Ephemeris})
+         {
+            addData(testFramework, *fact, refct + (30*i), 1, 1, SS::GPS,
+                    CB::L1, TC::CA, NT::GPSLNAV, hea, nmt);
+            addData(testFramework, *fact, refct + (30*i), 1, 1, SS::GPS,
+                    CB::L2, TC::Y, NT::GPSLNAV, hea, nmt);
+            addData(testFramework, *fact, refct + (30*i), 2, 2, SS::GPS,
+                    CB::L1, TC::CA, NT::GPSLNAV, SH::Healthy, nmt);
+            addData(testFramework, *fact, refct + (30*i), 3, 3, SS::GPS,
+                    CB::L2, TC::Y, NT::GPSLNAV, SH::Healthy, nmt);
+         }
+      }
+   }
+   TUASSERT(!frozen.isFrozen());
+   frozen.freeze();
+   TUASSERT(frozen.isFrozen());
+   gnsstk::NavMessageID wildSat(
+      gnsstk::NavSatelliteID(1, SS::GPS, CB::Any, TC::Any, NT::Any),
+      MT::Ephemeris);
+   wildSat.sat.makeWild();
+   std::vector<gnsstk::NavMessageID> nmids = {
+      gnsstk::NavMessageID(
+         gnsstk::NavSatelliteID(1, SS::GPS, CB::L1, TC::CA, NT::GPSLNAV),
+         MT::Ephemeris),
+      gnsstk::NavMessageID(
+         gnsstk::NavSatelliteID(1, 1, SS::GPS, CB::L2, TC::Y, NT::GPSLNAV),
+         MT::Ephemeris),
+      gnsstk::NavMessageID(
+         gnsstk::NavSatelliteID(1, SS::GPS, CB::Any, TC::Any, NT::Any),
+         MT::Ephemeris),
+      gnsstk::NavMessageID(
+         gnsstk::NavSatelliteID(3, SS::GPS, CB::L1, TC::CA, NT::GPSLNAV),
+         MT::Ephemeris),
+      gnsstk::NavMessageID(
+         gnsstk::NavSatelliteID(2, SS::GPS, CB::Any, TC::Any, NT::Any),
+         MT::Health),
+      gnsstk::NavMessageID(
+         gnsstk::NavSatelliteID(5, SS::GPS, CB::Any, TC::Any, NT::Any),
+         MT::Ephemeris),
+      wildSat
+   };
+   for (const auto& nmid : nmids)
+   {
+      for (double offs = -60; offs < 3900; offs += 37)
+      {
+         gnsstk::CommonTime when(refct + offs);
+         for (SO order : {SO::User, SO::Nearest})
+         {
+            for (SH hea : {SH::Any, SH::Healthy})
+            {
+               for (VT valid : {VT::ValidOnly, VT::Any})
+               {
+                  gnsstk::NavDataPtr expNav, gotNav;
+                  bool exp = uut.find(nmid, when, expNav, hea, valid, order);
+                  bool got = frozen.find(nmid, when, gotNav, hea, valid,
+                                         order);
+                  TUASSERTE(bool, exp, got);
+                  if (exp && got)
+                  {
+                     TUASSERTE(gnsstk::CommonTime, expNav->timeStamp,
+                               gotNav->timeStamp);
+                     TUASSERTE(gnsstk::NavMessageID, expNav->signal,
+                               gotNav->signal);
+                  }
+               }
+            }
+         }
+      }
+   }
+      // changing the store should discard the index
+   addData(testFramework, frozen, refct + 3600, 1, 1);
+   TUASSERT(!frozen.isFrozen());
+   frozen.freeze();
+   TUASSERT(frozen.isFrozen());
+   frozen.clear();
+   TUASSERT(!frozen.isFrozen());
+   TURETURN();
+}
+
+
 int main()
 {
    NavDataFactoryWithStore_T testClass;
@@ -2161,6 +2262,7 @@ int main()
    errorTotal += testClass.isPresentTest();
    errorTotal += testClass.countTest();
    errorTotal += testClass.getFirstLastTimeTest();
+   errorTotal += testClass.freezeTest();
 
    std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
              << std::endl;
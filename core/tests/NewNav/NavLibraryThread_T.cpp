@@ -0,0 +1,465 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+#include <atomic>
+#include <thread>
+#include "NavLibrary.hpp"
+#include "NavDataFactoryWithStore.hpp"
+#include "TestUtil.hpp"
+#include "GPSLNavEph.hpp"
+#include "GPSLNavHealth.hpp"
+#include "GPSLNavTimeOffset.hpp"
+#include "GPSWeekSecond.hpp"
+
+/// Fake factory holding generated GPS LNav data.
+class TestFactory : public gnsstk::NavDataFactoryWithStore
+{
+public:
+   TestFactory()
+   {
+      supportedSignals.insert(gnsstk::NavSignalID(gnsstk::SatelliteSystem::GPS,
+                                                 gnsstk::CarrierBand::L1,
+                                                 gnsstk::TrackingCode::CA,
+                                                 gnsstk::NavType::GPSLNAV));
+   }
+   bool addDataSource(const std::string& source) override
+   { return false; }
+   std::string getFactoryFormats() const override
+   { return "BUNK"; }
+};
+
+
+/// Results of all the queries for one satellite at one time.
+class QueryResult
+{
+public:
+   QueryResult()
+         : xvtOK(false), healthOK(false), offsetOK(false), x0(0.),
+           clkbias(0.), health(gnsstk::SVHealth::Unknown), offset(0.)
+   {}
+   bool operator==(const QueryResult& right) const
+   {
+      return ((xvtOK == right.xvtOK) && (healthOK == right.healthOK) &&
+              (offsetOK == right.offsetOK) && (x0 == right.x0) &&
+              (clkbias == right.clkbias) && (health == right.health) &&
+              (offset == right.offset));
+   }
+   bool xvtOK, healthOK, offsetOK;
+   double x0, clkbias;
+   gnsstk::SVHealth health;
+   double offset;
+};
+
+
+class NavLibraryThread_T
+{
+public:
+   NavLibraryThread_T();
+
+      /** Query one NavLibrary from several threads while another
+       * thread modifies the store, making sure every query gives
+       * the same answer as a single-threaded query. */
+   unsigned concurrentTest();
+      /** Query more libraries than each thread caches, from many
+       * short-lived threads, making sure the getXvt() caches of
+       * different libraries, and of destroyed ones, are never
+       * mixed up. */
+   unsigned cacheLibrariesTest();
+
+      /// Make the data for one satellite at one transmit time.
+   static void makeData(unsigned long prn, const gnsstk::CommonTime& xmit,
+                        bool healthy, gnsstk::NavDataPtrList& navOut);
+      /// Run all the queries for one satellite at one time.
+   static QueryResult query(gnsstk::NavLibrary& navLib,
+                            const gnsstk::NavSatelliteID& sat,
+                            const gnsstk::CommonTime& when);
+
+      /// First epoch of generated data.
+   gnsstk::CommonTime start;
+      /// Satellites queried by all threads.
+   std::vector<gnsstk::NavSatelliteID> sats;
+      /// Times queried by all threads.
+   std::vector<gnsstk::CommonTime> times;
+};
+
+
+NavLibraryThread_T ::
+NavLibraryThread_T()
+      : start(gnsstk::GPSWeekSecond(2101, 0))
+{
+   for (unsigned long prn = 1; prn <= 8; prn++)
+   {
+      sats.push_back(gnsstk::NavSatelliteID(
+                        gnsstk::SatID(prn, gnsstk::SatelliteSystem::GPS)));
+   }
+   for (double offs = -300; offs < 13*3600; offs += 300)
+   {
+      times.push_back(start + offs);
+   }
+}
+
+
+void NavLibraryThread_T ::
+makeData(unsigned long prn, const gnsstk::CommonTime& xmit, bool healthy,
+         gnsstk::NavDataPtrList& navOut)
+{
+   gnsstk::NavMessageID nmid(
+      gnsstk::NavSatelliteID(prn, prn, gnsstk::SatelliteSystem::GPS,
+                             gnsstk::CarrierBand::L1, gnsstk::TrackingCode::CA,
+                             gnsstk::NavType::GPSLNAV),
+      gnsstk::NavMessageType::Ephemeris);
+   std::shared_ptr<gnsstk::GPSLNavEph> eph =
+      std::make_shared<gnsstk::GPSLNavEph>();
+   eph->signal = nmid;
+   eph->timeStamp = xmit;
+   eph->xmitTime = xmit;
+   eph->xmit2 = xmit + 6;
+   eph->xmit3 = xmit + 12;
+   eph->Toe = xmit + 7200;
+   eph->Toc = eph->Toe;
+   eph->health = gnsstk::SVHealth::Healthy;
+   eph->M0 = .218771233916e+01 + prn;
+   eph->ecc = .422249664553e-02;
+   eph->Ahalf = .515360180473e+04;
+   eph->A = eph->Ahalf * eph->Ahalf;
+   eph->OMEGA0 = -.189462874179e+01 + prn;
+   eph->i0 = .946122987969e+00;
+   eph->w = .374892043461e+00;
+   eph->OMEGAdot = -.823034282681e-08;
+   eph->af0 = -.216379296035e-03 * prn;
+   eph->fixFit();
+   navOut.push_back(eph);
+   std::shared_ptr<gnsstk::GPSLNavHealth> hea =
+      std::make_shared<gnsstk::GPSLNavHealth>();
+   hea->signal = nmid;
+   hea->signal.messageType = gnsstk::NavMessageType::Health;
+   hea->timeStamp = xmit;
+   hea->svHealth = (healthy ? 0 : 1);
+   navOut.push_back(hea);
+   std::shared_ptr<gnsstk::GPSLNavTimeOffset> to =
+      std::make_shared<gnsstk::GPSLNavTimeOffset>();
+   to->signal = nmid;
+   to->signal.messageType = gnsstk::NavMessageType::TimeOffset;
+   to->timeStamp = xmit;
+   to->deltatLS = 18;
+   to->a0 = 1e-9 * prn;
+   to->refTime = xmit;
+   navOut.push_back(to);
+}
+
+
+QueryResult NavLibraryThread_T ::
+query(gnsstk::NavLibrary& navLib, const gnsstk::NavSatelliteID& sat,
+      const gnsstk::CommonTime& when)
+{
+   QueryResult rv;
+   gnsstk::Xvt xvt;
+   rv.xvtOK = navLib.getXvt(sat, when, xvt);
+   if (rv.xvtOK)
+   {
+      rv.x0 = xvt.x[0];
+      rv.clkbias = xvt.clkbias;
+   }
+   rv.healthOK = navLib.getHealth(sat, when, rv.health,
+                                  gnsstk::SVHealth::Any);
+   rv.offsetOK = navLib.getOffset(gnsstk::TimeSystem::GPS,
+                                  gnsstk::TimeSystem::UTC, when, rv.offset);
+   return rv;
+}
+
+
+unsigned NavLibraryThread_T ::
+concurrentTest()
+{
+   TUDEF("NavLibrary", "threads");
+   const unsigned numReaders = 8;
+   const unsigned passes = 10;
+      // PRN whose data is repeatedly removed and restored while
+      // the other threads are searching.
+   const unsigned long editPRN = 8;
+   gnsstk::NavLibrary navLib;
+   gnsstk::NavDataFactoryPtr ndfp(std::make_shared<TestFactory>());
+   TestFactory *fact = dynamic_cast<TestFactory*>(ndfp.get());
+   gnsstk::NavDataPtrList editData;
+   for (unsigned k = 0; k < 7; k++)
+   {
+      for (unsigned long prn = 1; prn <= 8; prn++)
+      {
+         gnsstk::NavDataPtrList navOut;
+            // make some of the satellites unhealthy some of the time
+         makeData(prn, start + k*7200.0, ((prn + k) % 3) != 0, navOut);
+         for (const auto& ndp : navOut)
+         {
+            TUASSERT(fact->addNavData(ndp));
+         }
+         if (prn == editPRN)
+         {
+            editData.splice(editData.end(), navOut);
+         }
+      }
+   }
+   TUCATCH(navLib.addFactory(ndfp));
+      // Single-threaded results to compare against.
+   std::vector<std::vector<QueryResult> > expected(sats.size());
+   for (unsigned s = 0; s < sats.size(); s++)
+   {
+      for (const auto& when : times)
+      {
+         expected[s].push_back(query(navLib, sats[s], when));
+      }
+   }
+      // Make sure the test data actually exercises all the queries.
+   TUASSERT(expected[0][10].xvtOK);
+   TUASSERT(expected[0][10].healthOK);
+   TUASSERT(expected[0][10].offsetOK);
+   TUASSERT(!expected[0][0].xvtOK);
+   navLib.setXvtCache(true);
+   std::atomic<unsigned long> mismatches(0), exceptions(0), queries(0);
+   std::atomic<bool> done(false);
+   std::vector<std::thread> readers;
+   for (unsigned t = 0; t < numReaders; t++)
+   {
+      readers.push_back(std::thread([&,t]()
+      {
+         try
+         {
+            for (unsigned pass = 0; pass < passes; pass++)
+            {
+                  // Each thread starts at a different time so the
+                  // threads' searches interleave differently.
+               for (unsigned i = 0; i < times.size(); i++)
+               {
+                  unsigned ti = (i + t * 17) % times.size();
+                  for (unsigned s = 0; s < sats.size(); s++)
+                  {
+                     QueryResult got = query(navLib, sats[s], times[ti]);
+                     queries++;
+                        // The edited satellite's data may be partially
+                        // present, so there's no single right answer.
+                     if ((sats[s].sat.id != editPRN) &&
+                         !(got == expected[s][ti]))
+                     {
+                        mismatches++;
+                     }
+                  }
+               }
+            }
+         }
+         catch (...)
+         {
+            exceptions++;
+         }
+      }));
+   }
+      // Remove and restore one satellite's data, and freeze and thaw
+      // the store, until the readers finish.
+   unsigned long edits = 0;
+   std::thread writer([&]()
+   {
+      try
+      {
+         gnsstk::NavSatelliteID editSat(
+            gnsstk::SatID(editPRN, gnsstk::SatelliteSystem::GPS));
+         while (!done)
+         {
+            fact->edit(gnsstk::CommonTime::BEGINNING_OF_TIME,
+                       gnsstk::CommonTime::END_OF_TIME, editSat);
+            for (const auto& ndp : editData)
+            {
+               fact->addNavData(ndp);
+            }
+            if ((edits % 4) == 0)
+               navLib.freeze();
+            else if ((edits % 4) == 2)
+               navLib.thaw();
+            edits++;
+            std::this_thread::yield();
+         }
+      }
+      catch (...)
+      {
+         exceptions++;
+      }
+   });
+   for (auto& rt : readers)
+   {
+      rt.join();
+   }
+   done = true;
+   writer.join();
+   TUASSERTE(unsigned long, numReaders * passes * times.size() * sats.size(),
+             queries);
+   TUASSERTE(unsigned long, 0, mismatches);
+   TUASSERTE(unsigned long, 0, exceptions);
+   TUASSERT(edits > 0);
+      // Now that nothing is changing, the edited satellite's data
+      // should be fully restored.
+   for (unsigned s = 0; s < sats.size(); s++)
+   {
+      for (unsigned ti = 0; ti < times.size(); ti++)
+      {
+         if (!(query(navLib, sats[s], times[ti]) == expected[s][ti]))
+            mismatches++;
+      }
+   }
+   TUASSERTE(unsigned long, 0, mismatches);
+   TURETURN();
+}
+
+
+unsigned NavLibraryThread_T ::
+cacheLibrariesTest()
+{
+   TUDEF("NavLibrary", "setXvtCache");
+   const unsigned numLibs = 6;
+   const unsigned numThreads = 20;
+      // Library k only has data for satellite k, so a result from
+      // another library's cache would be seen.
+   std::vector<std::unique_ptr<gnsstk::NavLibrary> > libs;
+   for (unsigned k = 0; k < numLibs; k++)
+   {
+      libs.push_back(std::unique_ptr<gnsstk::NavLibrary>(
+                        new gnsstk::NavLibrary));
+      gnsstk::NavDataFactoryPtr ndfp(std::make_shared<TestFactory>());
+      TestFactory *fact = dynamic_cast<TestFactory*>(ndfp.get());
+      for (unsigned e = 0; e < 7; e++)
+      {
+         gnsstk::NavDataPtrList navOut;
+         makeData(k+1, start + e*7200.0, true, navOut);
+         for (const auto& ndp : navOut)
+         {
+            fact->addNavData(ndp);
+         }
+      }
+      libs[k]->addFactory(ndfp);
+   }
+      // Uncached results to compare against.
+   std::vector<std::vector<std::vector<QueryResult> > > expected(numLibs);
+   for (unsigned k = 0; k < numLibs; k++)
+   {
+      expected[k].resize(sats.size());
+      for (unsigned s = 0; s < sats.size(); s++)
+      {
+         for (const auto& when : times)
+         {
+            expected[k][s].push_back(query(*libs[k], sats[s], when));
+         }
+      }
+      libs[k]->setXvtCache(true);
+   }
+   TUASSERT(expected[1][1][10].xvtOK);
+   TUASSERT(!expected[1][0][10].xvtOK);
+   std::atomic<unsigned long> mismatches(0), exceptions(0);
+   auto pass = [&]()
+   {
+      try
+      {
+         for (unsigned ti = 0; ti < times.size(); ti++)
+         {
+            for (unsigned k = 0; k < numLibs; k++)
+            {
+               for (unsigned s = 0; s < sats.size(); s++)
+               {
+                  if (!(query(*libs[k], sats[s], times[ti]) ==
+                        expected[k][s][ti]))
+                  {
+                     mismatches++;
+                  }
+               }
+            }
+         }
+      }
+      catch (...)
+      {
+         exceptions++;
+      }
+   };
+   pass();
+      // Many short-lived threads, a few at a time.
+   for (unsigned t = 0; t < numThreads; t += 4)
+   {
+      std::vector<std::thread> threads;
+      for (unsigned i = 0; i < 4; i++)
+      {
+         threads.push_back(std::thread(pass));
+      }
+      for (auto& th : threads)
+      {
+         th.join();
+      }
+   }
+   TUASSERTE(unsigned long, 0, mismatches);
+   TUASSERTE(unsigned long, 0, exceptions);
+      // A new library, possibly at the address of a destroyed one,
+      // must not see the destroyed library's cached data.
+   gnsstk::Xvt xvt;
+   TUASSERT(libs[0]->getXvt(sats[0], times[10], xvt));
+   libs[0].reset();
+   libs[0].reset(new gnsstk::NavLibrary);
+   gnsstk::NavDataFactoryPtr empty(std::make_shared<TestFactory>());
+   libs[0]->addFactory(empty);
+   libs[0]->setXvtCache(true);
+   TUASSERT(!libs[0]->getXvt(sats[0], times[10], xvt));
+      // Copies have their own caches.
+   TUCSM("NavLibrary(const NavLibrary&)");
+   gnsstk::NavLibrary copy(*libs[1]);
+   TUASSERT(query(copy, sats[1], times[10]) == expected[1][1][10]);
+   TUASSERT(!copy.getXvt(sats[0], times[10], xvt));
+   TUCSM("operator=");
+   copy = *libs[0];
+   TUASSERT(!copy.getXvt(sats[1], times[10], xvt));
+   copy = *libs[2];
+   TUASSERT(query(copy, sats[2], times[10]) == expected[2][2][10]);
+   TUASSERT(!copy.getXvt(sats[1], times[10], xvt));
+   TURETURN();
+}
+
+
+int main()
+{
+   NavLibraryThread_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.concurrentTest();
+   errorTotal += testClass.cacheLibrariesTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
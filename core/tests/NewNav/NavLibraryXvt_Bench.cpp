@@ -0,0 +1,174 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+/** @file NavLibraryXvt_Bench.cpp Benchmark NavLibrary::getXvt() for
+ * sequential epochs, with and without the Xvt cache and frozen
+ * store.  Usage: NavLibraryXvt_Bench [hours [satellites [rate]]]
+ * where rate is the number of epochs per second.  Defaults to a 24
+ * hour, 32 satellite, 1 Hz sweep. */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include "NavLibrary.hpp"
+#include "NavDataFactoryWithStore.hpp"
+#include "GPSLNavEph.hpp"
+#include "GPSWeekSecond.hpp"
+
+/// Minimal factory to hold generated nav data.
+class BenchFactory : public gnsstk::NavDataFactoryWithStore
+{
+public:
+   BenchFactory()
+   {
+      supportedSignals.insert(gnsstk::NavSignalID(gnsstk::SatelliteSystem::GPS,
+                                                 gnsstk::CarrierBand::L1,
+                                                 gnsstk::TrackingCode::CA,
+                                                 gnsstk::NavType::GPSLNAV));
+   }
+   bool addDataSource(const std::string& source) override
+   { return false; }
+   std::string getFactoryFormats() const override
+   { return "BENCH"; }
+};
+
+
+/// Make a GPS LNav ephemeris with plausible orbital elements.
+static gnsstk::NavDataPtr makeEph(unsigned long prn,
+                                  const gnsstk::CommonTime& xmit)
+{
+   std::shared_ptr<gnsstk::GPSLNavEph> eph =
+      std::make_shared<gnsstk::GPSLNavEph>();
+   eph->signal = gnsstk::NavMessageID(
+      gnsstk::NavSatelliteID(prn, prn, gnsstk::SatelliteSystem::GPS,
+                             gnsstk::CarrierBand::L1, gnsstk::TrackingCode::CA,
+                             gnsstk::NavType::GPSLNAV),
+      gnsstk::NavMessageType::Ephemeris);
+   eph->timeStamp = xmit;
+   eph->xmitTime = xmit;
+   eph->xmit2 = xmit + 6;
+   eph->xmit3 = xmit + 12;
+   eph->Toe = xmit + 7200;
+   eph->Toc = eph->Toe;
+   eph->health = gnsstk::SVHealth::Healthy;
+   eph->M0 = 0.2 * prn;
+   eph->ecc = .422249664553e-02;
+   eph->Ahalf = .515360180473e+04;
+   eph->A = eph->Ahalf * eph->Ahalf;
+   eph->OMEGA0 = 0.7 * prn;
+   eph->i0 = .946122987969e+00;
+   eph->w = .374892043461e+00;
+   eph->OMEGAdot = -.823034282681e-08;
+   eph->af0 = -.216379296035e-03;
+   eph->fixFit();
+   return eph;
+}
+
+
+/** Run getXvt() for every satellite at every epoch.
+ * @return The elapsed time in seconds. */
+static double sweep(gnsstk::NavLibrary& navLib,
+                    const std::vector<gnsstk::NavSatelliteID>& sats,
+                    const gnsstk::CommonTime& start, double hours,
+                    double rate, unsigned long& found)
+{
+   gnsstk::Xvt xvt;
+   unsigned long epochs = static_cast<unsigned long>(hours * 3600.0 * rate);
+   found = 0;
+   auto t0 = std::chrono::steady_clock::now();
+   for (unsigned long i = 0; i < epochs; i++)
+   {
+      gnsstk::CommonTime when(start + (i / rate));
+      for (const auto& sat : sats)
+      {
+         if (navLib.getXvt(sat, when, xvt))
+            found++;
+      }
+   }
+   auto t1 = std::chrono::steady_clock::now();
+   return std::chrono::duration<double>(t1 - t0).count();
+}
+
+
+int main(int argc, char *argv[])
+{
+   double hours = (argc > 1 ? std::atof(argv[1]) : 24.0);
+   unsigned long numSats = (argc > 2 ? std::atol(argv[2]) : 32);
+   double rate = (argc > 3 ? std::atof(argv[3]) : 1.0);
+   gnsstk::CommonTime start = gnsstk::GPSWeekSecond(2101, 0);
+   gnsstk::NavDataFactoryPtr ndfp(std::make_shared<BenchFactory>());
+   BenchFactory *fact = dynamic_cast<BenchFactory*>(ndfp.get());
+      // ephemerides every two hours, covering the sweep
+   for (double offs = -7200; offs < hours * 3600.0; offs += 7200)
+   {
+      for (unsigned long prn = 1; prn <= numSats; prn++)
+      {
+         fact->addNavData(makeEph(prn, start + offs));
+      }
+   }
+   std::vector<gnsstk::NavSatelliteID> sats;
+   for (unsigned long prn = 1; prn <= numSats; prn++)
+   {
+      sats.push_back(gnsstk::NavSatelliteID(
+                        gnsstk::SatID(prn, gnsstk::SatelliteSystem::GPS)));
+   }
+   gnsstk::NavLibrary navLib;
+   navLib.addFactory(ndfp);
+   unsigned long found;
+   unsigned long calls = static_cast<unsigned long>(hours * 3600.0 * rate) *
+      numSats;
+   std::cout << "getXvt() sweep: " << hours << " h, " << numSats
+             << " satellites, " << rate << " Hz, " << calls << " calls"
+             << std::endl;
+   double tBase = sweep(navLib, sats, start, hours, rate, found);
+   std::cout << "  no cache:      " << tBase << " s ("
+             << (tBase * 1e6 / calls) << " us/call, " << found << " found)"
+             << std::endl;
+   navLib.setXvtCache(true);
+   double tCache = sweep(navLib, sats, start, hours, rate, found);
+   std::cout << "  Xvt cache:     " << tCache << " s ("
+             << (tCache * 1e6 / calls) << " us/call, " << found << " found)"
+             << "  speedup " << (tBase / tCache) << "x" << std::endl;
+   navLib.setXvtCache(false);
+   navLib.freeze();
+   double tFrozen = sweep(navLib, sats, start, hours, rate, found);
+   std::cout << "  frozen store:  " << tFrozen << " s ("
+             << (tFrozen * 1e6 / calls) << " us/call, " << found << " found)"
+             << "  speedup " << (tBase / tFrozen) << "x" << std::endl;
+   return 0;
+}
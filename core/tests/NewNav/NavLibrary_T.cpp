@@ -43,6 +43,7 @@
 #include "GPSLNavHealth.hpp"
 #include "GPSLNavTimeOffset.hpp"
 #include "TimeString.hpp"
+#include "GPSWeekSecond.hpp"
 
 namespace gnsstk
 {
@@ -117,6 +118,50 @@ public:
    { return "BUNK"; }
 };
 
+/** Make a GPS LNav ephemeris with plausible orbital elements.
+ * @param[in] prn The subject and transmitting satellite.
+ * @param[in] xmit The transmit time of the first subframe.
+ * @return The new ephemeris. */
+static gnsstk::NavDataPtr makeEph(unsigned long prn,
+                                  const gnsstk::CommonTime& xmit)
+{
+   std::shared_ptr<gnsstk::GPSLNavEph> eph =
+      std::make_shared<gnsstk::GPSLNavEph>();
+   eph->signal = gnsstk::NavMessageID(
+      gnsstk::NavSatelliteID(prn, prn, gnsstk::SatelliteSystem::GPS,
+                             gnsstk::CarrierBand::L1, gnsstk::TrackingCode::CA,
+                             gnsstk::NavType::GPSLNAV),
+      gnsstk::NavMessageType::Ephemeris);
+   eph->timeStamp = xmit;
+   eph->xmitTime = xmit;
+   eph->xmit2 = xmit + 6;
+   eph->xmit3 = xmit + 12;
+   eph->Toe = xmit + 7200;
+   eph->Toc = eph->Toe;
+   eph->health = gnsstk::SVHealth::Healthy;
+   eph->Cuc = .200793147087e-05;
+   eph->Cus = .823289155960e-05;
+   eph->Crc = .214593750000e+03;
+   eph->Crs = .369375000000e+02;
+   eph->Cic = -.175088644028e-06;
+   eph->Cis = .335276126862e-07;
+   eph->M0 = .218771233916e+01 + prn;
+   eph->dn = .511592738462e-08;
+   eph->ecc = .422249664553e-02;
+   eph->Ahalf = .515360180473e+04;
+   eph->A = eph->Ahalf * eph->Ahalf;
+   eph->OMEGA0 = -.189462874179e+01 + prn;
+   eph->i0 = .946122987969e+00;
+   eph->w = .374892043461e+00;
+   eph->OMEGAdot = -.823034282681e-08;
+   eph->idot = .492877673191e-09;
+   eph->af0 = -.216379296035e-03;
+   eph->af1 = .432009983342e-11;
+   eph->fixFit();
+   return eph;
+}
+
+
 class RinexTestFactory : public gnsstk::RinexNavDataFactory
 {
 public:
@@ -157,6 +202,10 @@ public:
    unsigned isPresentTest();
    unsigned getIonoCorrTest();
    unsigned getISCTest();
+      /** Make sure getXvt() returns the same results with the Xvt
+       * cache enabled as without. */
+   unsigned xvtCacheTest();
+   unsigned getXvtBatchTest();
 
    gnsstk::CivilTime civ;
    gnsstk::CommonTime ct;
@@ -667,6 +716,152 @@ getISCTest()
 }
 
 
+unsigned NavLibrary_T ::
+xvtCacheTest()
+{
+   TUDEF("NavLibrary", "setXvtCache");
+   gnsstk::NavLibrary uut, ref;
+   gnsstk::NavDataFactoryPtr ndfp(std::make_shared<TestFactory>());
+   TestFactory *fact = dynamic_cast<TestFactory*>(ndfp.get());
+   gnsstk::CommonTime start = gnsstk::GPSWeekSecond(2101, 0);
+   for (unsigned k = 0; k < 12; k++)
+   {
+      for (unsigned long prn = 1; prn <= 4; prn++)
+      {
+            // leave a gap to make sure we don't extrapolate
+         if ((prn == 3) && (k == 5))
+            continue;
+         TUASSERT(fact->addNavData(makeEph(prn, start + k*7200.0)));
+      }
+   }
+   TUCATCH(uut.addFactory(ndfp));
+   TUCATCH(ref.addFactory(ndfp));
+   TUASSERTE(bool, false, uut.getXvtCache());
+   uut.setXvtCache(true);
+   TUASSERTE(bool, true, uut.getXvtCache());
+   std::vector<gnsstk::NavSatelliteID> sats;
+   for (unsigned long prn = 1; prn <= 5; prn++)
+   {
+      sats.push_back(gnsstk::NavSatelliteID(
+                        prn, prn, gnsstk::SatelliteSystem::GPS,
+                        gnsstk::CarrierBand::L1, gnsstk::TrackingCode::CA,
+                        gnsstk::NavType::GPSLNAV));
+      sats.push_back(gnsstk::NavSatelliteID(
+                        gnsstk::SatID(prn, gnsstk::SatelliteSystem::GPS)));
+   }
+   for (unsigned pass = 0; pass < 2; pass++)
+   {
+      for (double offs = -300; offs < 26*3600; offs += 300)
+      {
+         if ((pass == 1) && (offs == 12*3600))
+         {
+               // changing the store must invalidate the cache
+            TUASSERT(fact->addNavData(makeEph(3, start + 5*7200.0)));
+         }
+         gnsstk::CommonTime when(start + offs);
+         for (const auto& sat : sats)
+         {
+            gnsstk::Xvt expXvt, gotXvt;
+            bool exp = ref.getXvt(sat, when, expXvt);
+            bool got = uut.getXvt(sat, when, gotXvt);
+            TUASSERTE(bool, exp, got);
+            if (exp && got)
+            {
+               TUASSERTFE(expXvt.x[0], gotXvt.x[0]);
+               TUASSERTFE(expXvt.v[2], gotXvt.v[2]);
+               TUASSERTFE(expXvt.clkbias, gotXvt.clkbias);
+            }
+         }
+      }
+   }
+   TURETURN();
+}
+
+
+unsigned NavLibrary_T ::
+getXvtBatchTest()
+{
+   TUDEF("NavLibrary", "getXvtBatch");
+   gnsstk::NavLibrary uut;
+   gnsstk::NavDataFactoryPtr ndfp(std::make_shared<TestFactory>());
+   TestFactory *fact = dynamic_cast<TestFactory*>(ndfp.get());
+   gnsstk::CommonTime start = gnsstk::GPSWeekSecond(2101, 0);
+   for (unsigned k = 0; k < 12; k++)
+   {
+      for (unsigned long prn = 1; prn <= 4; prn++)
+      {
+            // leave a gap to get some failures
+         if ((prn == 3) && (k == 5))
+            continue;
+         TUASSERT(fact->addNavData(makeEph(prn, start + k*7200.0)));
+      }
+   }
+   TUCATCH(uut.addFactory(ndfp));
+   uut.setXvtCache(true);
+   std::vector<gnsstk::NavSatelliteID> sats;
+   for (unsigned long prn = 1; prn <= 5; prn++)
+   {
+      sats.push_back(gnsstk::NavSatelliteID(
+                        gnsstk::SatID(prn, gnsstk::SatelliteSystem::GPS)));
+   }
+   std::vector<gnsstk::CommonTime> times;
+   for (double offs = -300; offs < 26*3600; offs += 300)
+   {
+      times.push_back(start + offs);
+   }
+   gnsstk::XvtBatch batch;
+   gnsstk::Xvt expXvt, gotXvt;
+   unsigned mismatches = 0;
+      // all satellites at one time
+   for (const auto& when : times)
+   {
+      bool expAll = true;
+      bool gotAll = uut.getXvtBatch(sats, when, batch);
+      for (size_t i = 0; i < sats.size(); i++)
+      {
+         bool exp = uut.getXvt(sats[i], when, expXvt);
+         bool got = batch.getXvt(i, gotXvt);
+         expAll &= exp;
+         mismatches += (exp != got);
+         if (exp && got)
+         {
+            mismatches += ((expXvt.x[0] != gotXvt.x[0]) ||
+                           (expXvt.v[2] != gotXvt.v[2]) ||
+                           (expXvt.clkbias != gotXvt.clkbias) ||
+                           (expXvt.relcorr != gotXvt.relcorr));
+         }
+      }
+      mismatches += (expAll != gotAll);
+   }
+   TUASSERTE(unsigned, 0, mismatches);
+      // one satellite over a time grid
+   for (const auto& sat : sats)
+   {
+      bool expAll = true;
+      bool gotAll = uut.getXvtBatch(sat, times, batch);
+      TUASSERTE(size_t, times.size(), batch.size());
+      mismatches = 0;
+      for (size_t i = 0; i < times.size(); i++)
+      {
+         bool exp = uut.getXvt(sat, times[i], expXvt);
+         bool got = batch.getXvt(i, gotXvt);
+         expAll &= exp;
+         mismatches += (exp != got);
+         if (exp && got)
+         {
+            mismatches += ((expXvt.x[0] != gotXvt.x[0]) ||
+                           (expXvt.v[2] != gotXvt.v[2]) ||
+                           (expXvt.clkbias != gotXvt.clkbias) ||
+                           (expXvt.relcorr != gotXvt.relcorr));
+         }
+      }
+      TUASSERTE(unsigned, 0, mismatches);
+      TUASSERTE(bool, expAll, gotAll);
+   }
+   TURETURN();
+}
+
+
 int main()
 {
    NavLibrary_T testClass;
@@ -685,6 +880,8 @@ int main()
    errorTotal += testClass.isPresentTest();
    errorTotal += testClass.getIonoCorrTest();
    errorTotal += testClass.getISCTest();
+   errorTotal += testClass.xvtCacheTest();
+   errorTotal += testClass.getXvtBatchTest();
       /// @todo test edit(), clear()
    std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
              << std::endl;
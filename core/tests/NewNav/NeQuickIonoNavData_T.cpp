@@ -37,6 +37,7 @@
 //
 //==============================================================================
 
+#include <thread>
 #include "TestUtil.hpp"
 #include "NeQuickIonoNavData.hpp"
 #include "MODIP.hpp"
@@ -87,6 +88,10 @@ public:
    unsigned getTECTest();
       /// Test NeQuickIonoNavData::getIonoCorr
    unsigned getIonoCorrTest();
+      /// Test the batch NeQuickIonoNavData::getTEC and getIonoCorr
+   unsigned getTECBatchTest();
+      /// Test concurrent getTEC calls on a shared object.
+   unsigned getTECThreadTest();
 
       /// Hold input/truth data for legendreTest
    class TestData
@@ -921,6 +926,129 @@ getIonoCorrTest()
 }
 
 
+unsigned NeQuickIonoNavData_T ::
+getTECBatchTest()
+{
+   TUDEF("NeQuickIonoNavData", "getTEC");
+   unsigned numTests = sizeof(testDataTEC)/sizeof(testDataTEC[0]);
+   gnsstk::NeQuickIonoNavData uut;
+   const double factorL1 = getFactor(gnsstk::CarrierBand::L1);
+   unsigned testNum = 0;
+   while (testNum < numTests)
+   {
+         // The Annex E vectors list several satellites for each
+         // station and epoch, so batch those together.
+      const TestDataTEC& first(testDataTEC[testNum]);
+      std::vector<gnsstk::Position> sats;
+      unsigned end = testNum;
+      while ((end < numTests) &&
+             (testDataTEC[end].coefficients == first.coefficients) &&
+             (testDataTEC[end].ct == first.ct) &&
+             (testDataTEC[end].station == first.station))
+      {
+         sats.push_back(testDataTEC[end].satellite);
+         end++;
+      }
+      uut.ai[0] = first.coefficients[0];
+      uut.ai[1] = first.coefficients[1];
+      uut.ai[2] = first.coefficients[2];
+      std::vector<double> tec, corr;
+      TUCATCH(tec = uut.getTEC(first.ct, first.station, sats));
+      TUCATCH(corr = uut.getIonoCorr(first.ct, first.station, sats,
+                                     gnsstk::CarrierBand::L1));
+      TUASSERTE(size_t, sats.size(), tec.size());
+      TUASSERTE(size_t, sats.size(), corr.size());
+      for (unsigned i = 0; (i < tec.size()) && (i < corr.size()); i++)
+      {
+         const TestDataTEC& td(testDataTEC[testNum+i]);
+         TUASSERTFEPS(td.expTEC, tec[i], docEps);
+         TUASSERTFEPS(td.expTEC * factorL1 * 1e16, corr[i], docEps);
+            // batch and single-ray evaluation must agree exactly
+         TUASSERTFE(uut.getTEC(td.ct, td.station, td.satellite), tec[i]);
+      }
+      testNum = end;
+   }
+      // A vertical ray evaluates its profile once; make sure that
+      // agrees with a ray that is just far enough off vertical to be
+      // integrated as a slant ray.
+   const TestDataTEC& td(testDataTEC[0]);
+   uut.ai[0] = td.coefficients[0];
+   uut.ai[1] = td.coefficients[1];
+   uut.ai[2] = td.coefficients[2];
+   std::vector<gnsstk::Position> sats;
+   sats.push_back(gnsstk::Position(td.station.geodeticLatitude(),
+                                   td.station.longitude(), 20200000.0,
+                                   gnsstk::Position::Geodetic, &galEll));
+   sats.push_back(gnsstk::Position(td.station.geodeticLatitude()+1e-4,
+                                   td.station.longitude(), 20200000.0,
+                                   gnsstk::Position::Geodetic, &galEll));
+   std::vector<double> tec;
+   TUCATCH(tec = uut.getTEC(td.ct, td.station, sats));
+   TUASSERTE(size_t, 2, tec.size());
+   if (tec.size() == 2)
+   {
+      TUASSERTFEPS(tec[1], tec[0], docEps);
+      TUASSERTFE(uut.getTEC(td.ct, td.station, sats[0]), tec[0]);
+   }
+   TURETURN();
+}
+
+
+unsigned NeQuickIonoNavData_T ::
+getTECThreadTest()
+{
+   TUDEF("NeQuickIonoNavData", "getTEC");
+   unsigned numTests = sizeof(testDataTEC)/sizeof(testDataTEC[0]);
+   gnsstk::NeQuickIonoNavData uut;
+   uut.ai[0] = highSolarCoeff[0];
+   uut.ai[1] = highSolarCoeff[1];
+   uut.ai[2] = highSolarCoeff[2];
+   std::vector<unsigned> idx;
+   std::vector<double> expTEC;
+   for (unsigned testNum = 0; testNum < numTests; testNum++)
+   {
+      const TestDataTEC& td(testDataTEC[testNum]);
+      if (td.coefficients == highSolarCoeff)
+      {
+         idx.push_back(testNum);
+         expTEC.push_back(uut.getTEC(td.ct, td.station, td.satellite));
+      }
+   }
+   TUASSERT(!idx.empty());
+      // Each thread starts at a different offset so that the threads
+      // are working on different epochs at the same time.
+   const unsigned numThreads = 4;
+   std::vector<std::vector<double> > got(numThreads,
+                                         std::vector<double>(idx.size()));
+   std::vector<std::thread> threads;
+   for (unsigned t = 0; t < numThreads; t++)
+   {
+      threads.push_back(std::thread(
+         [&uut, &idx, &got, t, numThreads]()
+         {
+            for (unsigned i = 0; i < idx.size(); i++)
+            {
+               unsigned j = (i + t * idx.size() / numThreads) % idx.size();
+               const TestDataTEC& td(testDataTEC[idx[j]]);
+               got[t][j] = uut.getTEC(td.ct, td.station, td.satellite);
+            }
+         }));
+   }
+   for (unsigned t = 0; t < numThreads; t++)
+   {
+      threads[t].join();
+   }
+   for (unsigned t = 0; t < numThreads; t++)
+   {
+      for (unsigned i = 0; i < idx.size(); i++)
+      {
+         TUASSERTFE(expTEC[i], got[t][i]);
+      }
+   }
+   TURETURN();
+}
+
+
 int main(int argc, char *argv[])
 {
    NeQuickIonoNavData_T testClass;
@@ -937,6 +1065,8 @@ int main(int argc, char *argv[])
    errorTotal += testClass.thicknessTest();
    errorTotal += testClass.getTECTest();
    errorTotal += testClass.getIonoCorrTest();
+   errorTotal += testClass.getTECBatchTest();
+   errorTotal += testClass.getTECThreadTest();
 
    std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
              << std::endl;
@@ -72,6 +72,36 @@ public:
 };
 
 
+/// Test class using the standard Keplerian getXvt, like OrbitDataGPS.
+class BatchTestClass : public TestClass
+{
+public:
+   BatchTestClass()
+         : batch(true)
+   {}
+   bool getXvt(const gnsstk::CommonTime& when, gnsstk::Xvt& xvt,
+               const gnsstk::ObsID& oid = gnsstk::ObsID()) override
+   {
+      gnsstk::GPSEllipsoid ell;
+      return OrbitDataKepler::getXvt(when,ell,xvt,oid);
+   }
+   double svRelativity(const gnsstk::CommonTime& when) const override
+   {
+      gnsstk::GPSEllipsoid ell;
+      return OrbitDataKepler::svRelativity(when,ell);
+   }
+   bool getEllipsoidParams(double& gm, double& angVel) const override
+   {
+      gnsstk::GPSEllipsoid ell;
+      gm = ell.gm();
+      angVel = ell.angVelocity();
+      return batch;
+   }
+      /// Value returned by getEllipsoidParams, false to test fallback.
+   bool batch;
+};
+
+
 class OrbitDataKepler_T
 {
 public:
@@ -82,6 +112,13 @@ public:
    unsigned svClockBiasTest();
    unsigned svClockDriftTest();
    unsigned isSameDataTest();
+   unsigned getXvtBatchTest();
+
+      /** Count the differences between an element of a batch
+       * result and an Xvt.
+       * @return 0 if xvt matches element i of batch exactly. */
+   unsigned countDiffs(const gnsstk::XvtBatch& batch, size_t i,
+                       const gnsstk::Xvt& xvt);
 
       /// Set the fields in TestClass/OrbitDataKepler for testing
    void fillTestClass(TestClass& uut);
@@ -245,6 +282,97 @@ isSameDataTest()
 }
 
 
+unsigned OrbitDataKepler_T ::
+countDiffs(const gnsstk::XvtBatch& batch, size_t i, const gnsstk::Xvt& xvt)
+{
+   gnsstk::Xvt got;
+   unsigned rv = (batch.getXvt(i, got) ? 0 : 1);
+   for (unsigned j = 0; j < 3; j++)
+   {
+      rv += (got.x[j] != xvt.x[j]);
+      rv += (got.v[j] != xvt.v[j]);
+   }
+   rv += (got.clkbias != xvt.clkbias);
+   rv += (got.clkdrift != xvt.clkdrift);
+   rv += (got.relcorr != xvt.relcorr);
+   rv += (got.health != xvt.health);
+   rv += (got.frame != xvt.frame);
+   return rv;
+}
+
+
+unsigned OrbitDataKepler_T ::
+getXvtBatchTest()
+{
+   TUDEF("OrbitDataKepler", "getXvtBatch");
+   auto uut1 = std::make_shared<BatchTestClass>();
+   auto uut2 = std::make_shared<BatchTestClass>();
+   auto uut3 = std::make_shared<BatchTestClass>();
+   fillTestClass(*uut1);
+   fillTestClass(*uut2);
+   fillTestClass(*uut3);
+      // exercise the terms that are 0 in LNAV, in particular
+      // dndot, which changes the relativity computation.
+   uut2->dndot = 1e-13;
+   uut2->Adot = 0.01;
+   uut2->af2 = 1e-18;
+   uut2->M0 += 1.0;
+   uut2->health = gnsstk::SVHealth::Unhealthy;
+      // not batchable
+   uut3->batch = false;
+   uut3->M0 -= 1.0;
+   std::vector<gnsstk::CommonTime> when;
+      // more than one block of times
+   for (double offs = -7200; offs <= 7200; offs += 100)
+   {
+      when.push_back(ct + offs);
+   }
+   gnsstk::XvtBatch batch;
+   gnsstk::Xvt xvt;
+   for (auto uut : {uut1, uut2, uut3})
+   {
+      TUASSERTE(bool, true, uut->getXvtBatch(when, batch));
+      TUASSERTE(size_t, when.size(), batch.size());
+      unsigned diffs = 0;
+      for (size_t i = 0; i < when.size(); i++)
+      {
+         uut->getXvt(when[i], xvt);
+         diffs += countDiffs(batch, i, xvt);
+      }
+      TUASSERTE(unsigned, 0, diffs);
+   }
+      // mixed orbits, including missing data
+   std::vector<gnsstk::NavDataPtr> orbits;
+   std::vector<gnsstk::CommonTime> times;
+   gnsstk::NavDataPtr uuts[] = { uut1, uut2, uut3, nullptr };
+   for (size_t i = 0; i < when.size(); i++)
+   {
+      orbits.push_back(uuts[(i / 3) % 4]);
+      times.push_back(when[i]);
+   }
+   TUASSERTE(bool, false,
+             gnsstk::OrbitDataKepler::getXvtBatch(orbits, times, batch));
+   TUASSERTE(size_t, when.size(), batch.size());
+   unsigned diffs = 0, invalid = 0;
+   for (size_t i = 0; i < when.size(); i++)
+   {
+      BatchTestClass *bt = dynamic_cast<BatchTestClass*>(orbits[i].get());
+      if (bt == nullptr)
+      {
+         invalid += (batch.valid[i] == 0);
+         continue;
+      }
+      bt->getXvt(times[i], xvt);
+      diffs += countDiffs(batch, i, xvt);
+   }
+   TUASSERTE(unsigned, 0, diffs);
+   TUASSERTE(unsigned, 36, invalid);
+   times.pop_back();
+   TUTHROW(gnsstk::OrbitDataKepler::getXvtBatch(orbits, times, batch));
+   TURETURN();
+}
+
+
 int main()
 {
    OrbitDataKepler_T testClass;
@@ -255,6 +383,7 @@ int main()
    errorTotal += testClass.svClockBiasTest();
    errorTotal += testClass.svClockDriftTest();
    errorTotal += testClass.isSameDataTest();
+   errorTotal += testClass.getXvtBatchTest();
 
    std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
              << std::endl;
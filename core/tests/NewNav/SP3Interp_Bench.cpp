@@ -0,0 +1,228 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+/** @file SP3Interp_Bench.cpp Benchmark the per-epoch cost of
+ * SP3NavDataFactory interpolation against the previous
+ * implementation, which gathered the records into freshly allocated
+ * vectors and ran the general MiscMath LagrangeInterpolation() on
+ * each component.  Usage: SP3Interp_Bench [hours [satellites [rate]]]
+ * where rate is the number of epochs per second.  Defaults to a 24
+ * hour, 32 satellite, 0.1 Hz sweep over 15 minute SP3 data. */
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include "SP3NavDataFactory.hpp"
+#include "OrbitDataSP3.hpp"
+#include "GPSWeekSecond.hpp"
+#include "MiscMath.hpp"
+
+/// Expose the SP3 store so the legacy interpolation can walk it.
+class BenchFactory : public gnsstk::SP3NavDataFactory
+{
+public:
+   gnsstk::NavMessageMap& getData()
+   { return data; }
+};
+
+
+/// Angular rate of the generated orbits.
+static const double orbitRate = 2.0 * gnsstk::PI / 43080.0;
+
+
+/** The interpolation as it was done before precomputed weights:
+ * gather 10 records centered on when into vectors and interpolate
+ * position, derived velocity, clock bias and derived drift.
+ * @return false if there is not enough data. */
+static bool legacyInterp(gnsstk::NavMap& ephMap, gnsstk::NavMap& clkMap,
+                         const gnsstk::CommonTime& when,
+                         gnsstk::NavDataPtr& navOut)
+{
+   const unsigned halfOrder = 5, n = 2*halfOrder;
+   auto ti2 = ephMap.upper_bound(when);
+   auto ci2 = clkMap.upper_bound(when);
+   auto ti1 = ti2, ci1 = ci2;
+   for (unsigned i = 0; i < halfOrder; i++)
+   {
+      if (ti1 == ephMap.begin())
+         return false;
+      --ti1;
+      --ci1;
+   }
+   navOut = std::make_shared<gnsstk::OrbitDataSP3>(
+      *dynamic_cast<gnsstk::OrbitDataSP3*>(ti1->second.get()));
+   gnsstk::OrbitDataSP3 *osp3 =
+      dynamic_cast<gnsstk::OrbitDataSP3*>(navOut.get());
+   std::vector<double> tdata(n), biasData(n);
+   std::vector<std::vector<double>> posData(3);
+   for (unsigned i = 0; i < 3; i++)
+   {
+      posData[i].resize(n);
+   }
+   gnsstk::CommonTime firstTime(ti1->second->timeStamp);
+   unsigned idx = 0;
+   for (auto ti = ti1, ci = ci1; idx < n; ++ti, ++ci, ++idx)
+   {
+      if (ti == ephMap.end())
+         return false;
+      tdata[idx] = ti->second->timeStamp - firstTime;
+      gnsstk::OrbitDataSP3 *nav =
+         dynamic_cast<gnsstk::OrbitDataSP3*>(ti->second.get());
+      gnsstk::OrbitDataSP3 *clk =
+         dynamic_cast<gnsstk::OrbitDataSP3*>(ci->second.get());
+      for (unsigned i = 0; i < 3; i++)
+      {
+         posData[i][idx] = nav->pos[i];
+      }
+      biasData[idx] = clk->clkBias;
+   }
+   double dt = when - firstTime;
+   for (unsigned i = 0; i < 3; i++)
+   {
+      gnsstk::LagrangeInterpolation(tdata, posData[i], dt, osp3->pos[i],
+                                    osp3->vel[i]);
+      osp3->vel[i] *= 10000.;
+   }
+   gnsstk::LagrangeInterpolation(tdata, biasData, dt, osp3->clkBias,
+                                 osp3->clkDrift);
+   return true;
+}
+
+
+int main(int argc, char *argv[])
+{
+   double hours = (argc > 1 ? std::atof(argv[1]) : 24.0);
+   unsigned long numSats = (argc > 2 ? std::atol(argv[2]) : 32);
+   double rate = (argc > 3 ? std::atof(argv[3]) : 0.1);
+   gnsstk::CommonTime start = gnsstk::GPSWeekSecond(2101, 0);
+   BenchFactory fact;
+   std::vector<gnsstk::NavMessageID> nmids;
+      // 15 minute records, with enough margin for 10 point fits
+   for (unsigned long prn = 1; prn <= numSats; prn++)
+   {
+      gnsstk::NavSatelliteID sat(prn, prn, gnsstk::SatelliteSystem::GPS,
+                                 gnsstk::CarrierBand::L1,
+                                 gnsstk::TrackingCode::CA,
+                                 gnsstk::NavType::GPSLNAV);
+      nmids.push_back(gnsstk::NavMessageID(
+                         sat, gnsstk::NavMessageType::Ephemeris));
+      for (double t = -5*900.0; t < hours*3600.0 + 6*900.0; t += 900.0)
+      {
+         gnsstk::NavDataPtr eph = std::make_shared<gnsstk::OrbitDataSP3>();
+         gnsstk::NavDataPtr clk = std::make_shared<gnsstk::OrbitDataSP3>();
+         gnsstk::OrbitDataSP3 *ephp =
+            dynamic_cast<gnsstk::OrbitDataSP3*>(eph.get());
+         gnsstk::OrbitDataSP3 *clkp =
+            dynamic_cast<gnsstk::OrbitDataSP3*>(clk.get());
+         ephp->signal = nmids.back();
+         clkp->signal = gnsstk::NavMessageID(
+            sat, gnsstk::NavMessageType::Clock);
+         ephp->timeStamp = clkp->timeStamp = start + t;
+         for (unsigned i = 0; i < 3; i++)
+         {
+            ephp->pos[i] = 26560.0 * ::cos(orbitRate*t + prn + i);
+         }
+         clkp->clkBias = 100.0 + prn + 1e-3*t;
+         fact.addNavData(eph);
+         fact.addNavData(clk);
+      }
+   }
+   unsigned long epochs = static_cast<unsigned long>(hours * 3600.0 * rate);
+   unsigned long calls = epochs * numSats, found;
+   std::cout << "SP3 interpolation: " << hours << " h, " << numSats
+             << " satellites, " << rate << " Hz, " << calls << " calls"
+             << std::endl;
+   gnsstk::NavDataPtr navOut;
+   gnsstk::NavMessageMap& data(fact.getData());
+   gnsstk::NavSatMap& ephSats(data[gnsstk::NavMessageType::Ephemeris]);
+   gnsstk::NavSatMap& clkSats(data[gnsstk::NavMessageType::Clock]);
+      // Keep one result per call for comparison.
+   std::vector<double> legacyPos(calls), legacyVel(calls);
+   found = 0;
+   auto t0 = std::chrono::steady_clock::now();
+   for (unsigned long i = 0, k = 0; i < epochs; i++)
+   {
+      gnsstk::CommonTime when(start + (i / rate) + 0.5);
+      for (unsigned long s = 0; s < numSats; s++, k++)
+      {
+         if (legacyInterp(ephSats[nmids[s]], clkSats[nmids[s]], when, navOut))
+         {
+            found++;
+            gnsstk::OrbitDataSP3 *osp3 =
+               dynamic_cast<gnsstk::OrbitDataSP3*>(navOut.get());
+            legacyPos[k] = osp3->pos[0];
+            legacyVel[k] = osp3->vel[0];
+         }
+      }
+   }
+   auto t1 = std::chrono::steady_clock::now();
+   double tBase = std::chrono::duration<double>(t1 - t0).count();
+   std::cout << "  vector/MiscMath: " << tBase << " s ("
+             << (tBase * 1e6 / calls) << " us/call, " << found << " found)"
+             << std::endl;
+   double maxPos = 0, maxVel = 0;
+   found = 0;
+   t0 = std::chrono::steady_clock::now();
+   for (unsigned long i = 0, k = 0; i < epochs; i++)
+   {
+      gnsstk::CommonTime when(start + (i / rate) + 0.5);
+      for (unsigned long s = 0; s < numSats; s++, k++)
+      {
+         navOut.reset();
+         if (fact.find(nmids[s], when, navOut, gnsstk::SVHealth::Any,
+                       gnsstk::NavValidityType::ValidOnly,
+                       gnsstk::NavSearchOrder::User))
+         {
+            found++;
+            gnsstk::OrbitDataSP3 *osp3 =
+               dynamic_cast<gnsstk::OrbitDataSP3*>(navOut.get());
+            maxPos = std::max(maxPos, std::abs(osp3->pos[0]-legacyPos[k]));
+            maxVel = std::max(maxVel, std::abs(osp3->vel[0]-legacyVel[k]));
+         }
+      }
+   }
+   t1 = std::chrono::steady_clock::now();
+   double tNew = std::chrono::duration<double>(t1 - t0).count();
+   std::cout << "  find():          " << tNew << " s ("
+             << (tNew * 1e6 / calls) << " us/call, " << found << " found)"
+             << "  speedup " << (tBase / tNew) << "x" << std::endl;
+   std::cout << "  max difference:  " << maxPos << " km, " << maxVel
+             << " dm/s" << std::endl;
+   return 0;
+}
@@ -41,6 +41,7 @@
 #include "OrbitDataSP3.hpp"
 #include "CivilTime.hpp"
 #include "GPSWeekSecond.hpp"
+#include "MiscMath.hpp"
 
 namespace gnsstk
 {
@@ -107,6 +108,9 @@ public:
    unsigned gapTest();
       /// Test nomTimeStep via the friendlier wrapper methods.
    unsigned nomTimeStepTest();
+      /** Compare interpolated results against the general Lagrange
+       * interpolation in MiscMath for regular and irregular grids. */
+   unsigned interpolateTest();
       /** Exercise loadIntoMap by loading mixed source data.
        * @param[in] badPos Set the rejectBadPosFlag to this value.
        * @param[in] badClk Set the rejectBadClkFlag to this value.
@@ -1371,6 +1375,119 @@ nomTimeStepTest()
 }
 
 
+unsigned SP3NavDataFactory_T ::
+interpolateTest()
+{
+   TUDEF("SP3NavDataFactory", "interpolateEph");
+   TestClass uut;
+   gnsstk::CommonTime t0 = gnsstk::GPSWeekSecond(2100, 0.0);
+      // 20 epochs at 900s, except for one out of place epoch that
+      // makes for an irregular grid.
+   std::vector<double> times;
+   for (unsigned i = 0; i < 20; i++)
+   {
+      times.push_back(i*900.0 + (i == 14 ? 60.0 : 0.0));
+   }
+   const double w = 2.0 * gnsstk::PI / 43080.0;
+      // PRN 1 has position only, PRN 2 has position and velocity.
+   for (int prn = 1; prn <= 2; prn++)
+   {
+      gnsstk::NavSatelliteID sat(prn, prn, gnsstk::SatelliteSystem::GPS,
+                                 gnsstk::CarrierBand::L1,
+                                 gnsstk::TrackingCode::CA,
+                                 gnsstk::NavType::GPSLNAV);
+      for (double t : times)
+      {
+         gnsstk::NavDataPtr eph = std::make_shared<gnsstk::OrbitDataSP3>();
+         gnsstk::NavDataPtr clk = std::make_shared<gnsstk::OrbitDataSP3>();
+         gnsstk::OrbitDataSP3 *ephp =
+            dynamic_cast<gnsstk::OrbitDataSP3*>(eph.get());
+         gnsstk::OrbitDataSP3 *clkp =
+            dynamic_cast<gnsstk::OrbitDataSP3*>(clk.get());
+         ephp->signal = gnsstk::NavMessageID(
+            sat, gnsstk::NavMessageType::Ephemeris);
+         clkp->signal = gnsstk::NavMessageID(
+            sat, gnsstk::NavMessageType::Clock);
+         ephp->timeStamp = clkp->timeStamp = t0 + t;
+         for (unsigned i = 0; i < 3; i++)
+         {
+            ephp->pos[i] = 26560.0 * ::cos(w*t + i);
+            ephp->posSig[i] = 0.01;
+            if (prn == 2)
+               ephp->vel[i] = -265600000.0 * w * ::sin(w*t + i);
+         }
+         clkp->clkBias = 100.0 + 1e-3*t + 1e-8*t*t;
+         clkp->biasSig = 0.1;
+         TUASSERT(uut.addNavData(eph));
+         TUASSERT(uut.addNavData(clk));
+      }
+   }
+      // Query times relative to t0: between regular nodes, exactly
+      // on a node, and with the irregular node in the fit.
+   std::vector<double> queries { 4*900.0+123.5, 7*900.0, 11*900.0+450.0,
+                                 14*900.0+60.0 };
+   for (double q : queries)
+   {
+      unsigned k = 0;
+      while ((k+1 < times.size()) && (times[k+1] <= q))
+         k++;
+         // Exact matches shift the interpolation interval left by one.
+      unsigned first = (times[k] == q ? k-5 : k-4);
+      std::vector<double> tdata, yPos[3], yVel[3], yClk;
+      for (unsigned j = first; j < first+10; j++)
+      {
+         double t = times[j];
+         tdata.push_back(t - times[first]);
+         for (unsigned i = 0; i < 3; i++)
+         {
+            yPos[i].push_back(26560.0 * ::cos(w*t + i));
+            yVel[i].push_back(-265600000.0 * w * ::sin(w*t + i));
+         }
+         yClk.push_back(100.0 + 1e-3*t + 1e-8*t*t);
+      }
+      double dt = q - times[first], err, y, dydt;
+      for (int prn = 1; prn <= 2; prn++)
+      {
+         gnsstk::NavMessageID nmid(
+            gnsstk::NavSatelliteID(prn, prn, gnsstk::SatelliteSystem::GPS,
+                                   gnsstk::CarrierBand::L1,
+                                   gnsstk::TrackingCode::CA,
+                                   gnsstk::NavType::GPSLNAV),
+            gnsstk::NavMessageType::Ephemeris);
+         gnsstk::NavDataPtr navOut;
+         TUASSERT(uut.find(nmid, t0+q, navOut, gnsstk::SVHealth::Any,
+                           gnsstk::NavValidityType::ValidOnly,
+                           gnsstk::NavSearchOrder::User));
+         gnsstk::OrbitDataSP3 *uutp =
+            dynamic_cast<gnsstk::OrbitDataSP3*>(navOut.get());
+         TUASSERT(uutp != nullptr);
+         if (uutp == nullptr)
+            continue;
+         for (unsigned i = 0; i < 3; i++)
+         {
+            TUASSERTFEPS(gnsstk::LagrangeInterpolation(tdata,yPos[i],dt,err),
+                         uutp->pos[i], 1e-8);
+            if (prn == 1)
+            {
+               gnsstk::LagrangeInterpolation(tdata, yPos[i], dt, y, dydt);
+               TUASSERTFEPS(dydt*10000.0, uutp->vel[i], 1e-6);
+            }
+            else
+            {
+               gnsstk::LagrangeInterpolation(tdata, yVel[i], dt, y, dydt);
+               TUASSERTFEPS(y, uutp->vel[i], 1e-6);
+               TUASSERTFEPS(dydt*0.1, uutp->acc[i], 1e-9);
+            }
+         }
+         gnsstk::LagrangeInterpolation(tdata, yClk, dt, y, dydt);
+         TUASSERTFEPS(y, uutp->clkBias, 1e-9);
+         TUASSERTFEPS(dydt, uutp->clkDrift, 1e-12);
+      }
+   }
+   TURETURN();
+}
+
+
 int main()
 {
    SP3NavDataFactory_T testClass;
@@ -1400,6 +1517,7 @@ int main()
    errorTotal += testClass.addRinexClockTest();
    errorTotal += testClass.gapTest();
    errorTotal += testClass.nomTimeStepTest();
+   errorTotal += testClass.interpolateTest();
 
    std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
              << std::endl;
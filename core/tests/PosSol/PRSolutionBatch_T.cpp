@@ -0,0 +1,342 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <cmath>
+#include "PRSolutionBatch.hpp"
+#include "NavDataFactoryWithStore.hpp"
+#include "GPSLNavEph.hpp"
+#include "GPSLNavHealth.hpp"
+#include "GPSWeekSecond.hpp"
+#include "GPSEllipsoid.hpp"
+#include "Position.hpp"
+#include "TestUtil.hpp"
+
+/// Fake factory holding generated GPS LNav data.
+class TestFactory : public gnsstk::NavDataFactoryWithStore
+{
+public:
+   TestFactory()
+   {
+      supportedSignals.insert(gnsstk::NavSignalID(gnsstk::SatelliteSystem::GPS,
+                                                 gnsstk::CarrierBand::L1,
+                                                 gnsstk::TrackingCode::CA,
+                                                 gnsstk::NavType::GPSLNAV));
+   }
+   bool addDataSource(const std::string& source) override
+   { return false; }
+   std::string getFactoryFormats() const override
+   { return "BUNK"; }
+};
+
+
+class PRSolutionBatch_T
+{
+public:
+   PRSolutionBatch_T();
+
+      /** Compare the batch solutions to PRSolution::RAIMCompute for
+       * clean data, data with a bad pseudorange and weighted data. */
+   unsigned solveTest();
+      /// Make sure bad input is reported from the worker threads.
+   unsigned exceptionTest();
+
+      /// Make the ephemeris and health data for one satellite.
+   void makeData(unsigned long prn, gnsstk::NavDataPtrList& navOut);
+      /** Compute the pseudorange that PRSolution's model expects
+       * for a satellite, by iterating on the transmit time.
+       * @return false if the satellite is below the mask angle. */
+   bool makePR(const gnsstk::SatID& sat, const gnsstk::CommonTime& when,
+               double& pr);
+
+      /// Ephemeris epoch.
+   gnsstk::CommonTime start;
+      /// True receiver position (ECEF, m).
+   gnsstk::Position rxPos;
+      /// True receiver clock bias (m).
+   double rxClk;
+      /// Ephemeris source for all tests.
+   gnsstk::NavLibrary navLib;
+      /// Input data, one element per epoch.
+   std::vector<gnsstk::PRSolutionBatch::Epoch> epochs;
+};
+
+
+PRSolutionBatch_T ::
+PRSolutionBatch_T()
+      : start(gnsstk::GPSWeekSecond(2101, 0)),
+        rxClk(123.456)
+{
+   rxPos.setECEF(-740289.9, -5457071.7, 3207245.6);
+   gnsstk::NavDataFactoryPtr ndfp(std::make_shared<TestFactory>());
+   TestFactory *fact = dynamic_cast<TestFactory*>(ndfp.get());
+   for (unsigned long prn = 1; prn <= 24; prn++)
+   {
+      gnsstk::NavDataPtrList navOut;
+      makeData(prn, navOut);
+      for (const auto& ndp : navOut)
+      {
+         fact->addNavData(ndp);
+      }
+   }
+   navLib.addFactory(ndfp);
+      // 1-minute epochs, every fourth one with a 300 m blunder on
+      // the first satellite in view.
+   for (unsigned k = 0; k < 40; k++)
+   {
+      gnsstk::PRSolutionBatch::Epoch epoch;
+      epoch.time = start + 3600.0 + 60.0 * k;
+      for (unsigned long prn = 1; prn <= 24; prn++)
+      {
+         gnsstk::SatID sat(prn, gnsstk::SatelliteSystem::GPS);
+         double pr;
+         if (makePR(sat, epoch.time, pr))
+         {
+            epoch.sats.push_back(sat);
+            epoch.pseudoranges.push_back(pr);
+         }
+      }
+      if ((k % 4) == 1)
+      {
+         epoch.pseudoranges[0] += 300.0;
+      }
+      epochs.push_back(epoch);
+   }
+}
+
+
+void PRSolutionBatch_T ::
+makeData(unsigned long prn, gnsstk::NavDataPtrList& navOut)
+{
+   gnsstk::NavMessageID nmid(
+      gnsstk::NavSatelliteID(prn, prn, gnsstk::SatelliteSystem::GPS,
+                             gnsstk::CarrierBand::L1, gnsstk::TrackingCode::CA,
+                             gnsstk::NavType::GPSLNAV),
+      gnsstk::NavMessageType::Ephemeris);
+   std::shared_ptr<gnsstk::GPSLNavEph> eph =
+      std::make_shared<gnsstk::GPSLNavEph>();
+      // six planes of four satellites
+   unsigned plane = (prn-1) % 6, slot = (prn-1) / 6;
+   eph->signal = nmid;
+   eph->timeStamp = start;
+   eph->xmitTime = start;
+   eph->xmit2 = start + 6;
+   eph->xmit3 = start + 12;
+   eph->Toe = start + 7200;
+   eph->Toc = eph->Toe;
+   eph->health = gnsstk::SVHealth::Healthy;
+   eph->M0 = slot * gnsstk::PI / 2.0 + plane * 0.5;
+   eph->ecc = .422249664553e-02;
+   eph->Ahalf = .515360180473e+04;
+   eph->A = eph->Ahalf * eph->Ahalf;
+   eph->OMEGA0 = plane * gnsstk::PI / 3.0;
+   eph->i0 = .946122987969e+00;
+   eph->w = .374892043461e+00;
+   eph->OMEGAdot = -.823034282681e-08;
+   eph->af0 = 1.e-5 * prn;
+   eph->fixFit();
+   navOut.push_back(eph);
+   std::shared_ptr<gnsstk::GPSLNavHealth> hea =
+      std::make_shared<gnsstk::GPSLNavHealth>();
+   hea->signal = nmid;
+   hea->signal.messageType = gnsstk::NavMessageType::Health;
+   hea->timeStamp = start;
+   hea->svHealth = 0;
+   navOut.push_back(hea);
+}
+
+
+bool PRSolutionBatch_T ::
+makePR(const gnsstk::SatID& sat, const gnsstk::CommonTime& when, double& pr)
+{
+   gnsstk::GPSEllipsoid ellip;
+   gnsstk::NavSatelliteID nsid(sat);
+   gnsstk::Xvt xvt;
+   double svxyz[3];
+   pr = 0.070 * ellip.c() + rxClk;
+   for (unsigned iter = 0; iter < 6; iter++)
+   {
+         // same transmit time sequence as PRSolution::PreparePRSolution
+      gnsstk::CommonTime tx = when - pr / ellip.c();
+      if (!navLib.getXvt(nsid, tx, xvt, false, gnsstk::SVHealth::Healthy))
+         return false;
+      tx -= xvt.clkbias + xvt.relcorr;
+      if (!navLib.getXvt(nsid, tx, xvt, false, gnsstk::SVHealth::Healthy))
+         return false;
+      double dt = gnsstk::RSS(xvt.x[0]-rxPos.X(), xvt.x[1]-rxPos.Y(),
+                              xvt.x[2]-rxPos.Z()) / ellip.c();
+      double wt = ellip.angVelocity() * dt;
+      svxyz[0] =  ::cos(wt)*xvt.x[0] + ::sin(wt)*xvt.x[1];
+      svxyz[1] = -::sin(wt)*xvt.x[0] + ::cos(wt)*xvt.x[1];
+      svxyz[2] = xvt.x[2];
+      double rho = gnsstk::RSS(svxyz[0]-rxPos.X(), svxyz[1]-rxPos.Y(),
+                               svxyz[2]-rxPos.Z());
+      pr = rho + rxClk - ellip.c() * (xvt.clkbias + xvt.relcorr);
+   }
+   gnsstk::Position svPos;
+   svPos.setECEF(svxyz[0], svxyz[1], svxyz[2]);
+   return (rxPos.elevation(svPos) > 10.0);
+}
+
+
+unsigned PRSolutionBatch_T ::
+solveTest()
+{
+   TUDEF("PRSolutionBatch", "solve");
+   gnsstk::PRSolution prs;
+   prs.allowedGNSS.push_back(gnsstk::SatelliteSystem::GPS);
+   prs.hasMemory = false;
+   gnsstk::PRSolutionBatch::TropFactory tf =
+      []() { return std::make_shared<gnsstk::ZeroTropModel>(); };
+   gnsstk::ZeroTropModel ztm;
+   std::vector<gnsstk::PRSolutionBatch::Result> results, results4;
+   for (unsigned weighted = 0; weighted < 2; weighted++)
+   {
+      if (weighted)
+      {
+            // weight the first satellite in view less than the others
+         for (auto& epoch : epochs)
+         {
+            size_t n = epoch.sats.size();
+            epoch.invMC = gnsstk::Matrix<double>(n, n, 0.0);
+            for (size_t i = 0; i < n; i++)
+               epoch.invMC(i,i) = (i == 0 ? 0.25 : 1.0);
+         }
+      }
+      gnsstk::PRSolutionBatch batch1(prs, tf, 1);
+      gnsstk::PRSolutionBatch batch4(prs, tf, 4);
+      TUASSERTE(unsigned, 4, batch4.getNumThreads());
+      TUCATCH(batch1.solve(epochs, navLib, results));
+      TUCATCH(batch4.solve(epochs, navLib, results4));
+      TUASSERTE(size_t, epochs.size(), results.size());
+      TUASSERTE(size_t, epochs.size(), results4.size());
+      unsigned excluded = 0;
+      for (unsigned k = 0; k < epochs.size() && k < results.size(); k++)
+      {
+         const gnsstk::PRSolutionBatch::Result& res(results[k]);
+         std::vector<gnsstk::SatID> sats(epochs[k].sats);
+         int iret = prs.RAIMCompute(epochs[k].time, sats,
+                                    epochs[k].pseudoranges, epochs[k].invMC,
+                                    navLib, &ztm);
+         TUASSERTE(int, iret, res.status);
+         TUASSERTE(bool, prs.isValid(), res.valid);
+         TUASSERT(sats == res.sats);
+         TUASSERTE(int, prs.Nsvs, res.nsvs);
+         TUASSERTE(int, prs.NIterations, res.nIterations);
+         TUASSERTE(bool, prs.RMSFlag, res.rmsFlag);
+         TUASSERTE(bool, prs.SlopeFlag, res.slopeFlag);
+         TUASSERTE(bool, prs.TropFlag, res.tropFlag);
+         TUASSERTFEPS(prs.RMSResidual, res.rmsResidual, 1e-6);
+            // slopes can be large, so compare them to relative precision
+         TUASSERTFEPS(prs.MaxSlope, res.maxSlope, 1e-7 * prs.MaxSlope);
+         TUASSERTFEPS(prs.PDOP, res.pdop, 1e-9);
+         TUASSERTFEPS(prs.GDOP, res.gdop, 1e-9);
+         TUASSERTE(size_t, prs.Solution.size(), res.solution.size());
+         TUASSERTE(size_t, prs.Covariance.rows(), res.covariance.rows());
+         for (size_t i = 0; i < res.solution.size(); i++)
+         {
+            TUASSERTFEPS(prs.Solution(i), res.solution(i), 1e-6);
+            for (size_t j = 0; j < res.covariance.cols(); j++)
+            {
+               TUASSERTFEPS(prs.Covariance(i,j), res.covariance(i,j), 1e-9);
+            }
+         }
+            // the solution should be the truth, with the blunder excluded
+         TUASSERT(res.valid);
+         if (res.solution.size() >= 4)
+         {
+            TUASSERTFEPS(rxPos.X(), res.solution(0), 1e-3);
+            TUASSERTFEPS(rxPos.Y(), res.solution(1), 1e-3);
+            TUASSERTFEPS(rxPos.Z(), res.solution(2), 1e-3);
+            TUASSERTFEPS(rxClk, res.solution(3), 1e-3);
+         }
+         TUASSERTE(bool, (k % 4) == 1, res.sats[0].id < 0);
+         if (res.sats[0].id < 0)
+            excluded++;
+            // the thread count must not change the results
+         if (k < results4.size())
+         {
+            const gnsstk::PRSolutionBatch::Result& res4(results4[k]);
+            TUASSERTE(int, res.status, res4.status);
+            TUASSERT(res.sats == res4.sats);
+            TUASSERTE(size_t, res.solution.size(), res4.solution.size());
+            for (size_t i = 0; i < res.solution.size(); i++)
+            {
+               TUASSERTE(double, res.solution(i), res4.solution(i));
+            }
+         }
+      }
+      TUASSERTE(unsigned, epochs.size() / 4, excluded);
+   }
+   TURETURN();
+}
+
+
+unsigned PRSolutionBatch_T ::
+exceptionTest()
+{
+   TUDEF("PRSolutionBatch", "solve");
+   gnsstk::PRSolution prs;
+   gnsstk::PRSolutionBatch::TropFactory tf =
+      []() { return std::make_shared<gnsstk::ZeroTropModel>(); };
+      // allowedGNSS is required
+   TUTHROW(gnsstk::PRSolutionBatch(prs, tf, 2));
+   prs.allowedGNSS.push_back(gnsstk::SatelliteSystem::GPS);
+   TUTHROW(gnsstk::PRSolutionBatch(prs,
+                                   gnsstk::PRSolutionBatch::TropFactory()));
+   gnsstk::PRSolutionBatch batch(prs, tf, 2);
+   std::vector<gnsstk::PRSolutionBatch::Epoch> bad(epochs);
+   bad[7].pseudoranges.pop_back();
+   std::vector<gnsstk::PRSolutionBatch::Result> results;
+   TUTHROW(batch.solve(bad, navLib, results));
+   TURETURN();
+}
+
+
+int main(int argc, char *argv[])
+{
+   PRSolutionBatch_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.solveTest();
+   errorTotal += testClass.exceptionTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
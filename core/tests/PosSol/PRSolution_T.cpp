@@ -0,0 +1,315 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <cmath>
+#include <chrono>
+#include "PRSolution.hpp"
+#include "NavDataFactoryWithStore.hpp"
+#include "GPSLNavEph.hpp"
+#include "GPSLNavHealth.hpp"
+#include "GPSWeekSecond.hpp"
+#include "GPSEllipsoid.hpp"
+#include "Position.hpp"
+#include "TestUtil.hpp"
+
+/// Fake factory holding generated GPS LNav data.
+class TestFactory : public gnsstk::NavDataFactoryWithStore
+{
+public:
+   TestFactory()
+   {
+      supportedSignals.insert(gnsstk::NavSignalID(gnsstk::SatelliteSystem::GPS,
+                                                 gnsstk::CarrierBand::L1,
+                                                 gnsstk::TrackingCode::CA,
+                                                 gnsstk::NavType::GPSLNAV));
+   }
+   bool addDataSource(const std::string& source) override
+   { return false; }
+   std::string getFactoryFormats() const override
+   { return "BUNK"; }
+};
+
+
+class PRSolution_T
+{
+public:
+   PRSolution_T();
+
+      /** Compare IncrementalRAIM to the exhaustive subset search,
+       * rejecting zero, one and two satellites out of about 40. */
+   unsigned incrementalRAIMTest();
+
+      /// Make the ephemeris and health data for one satellite.
+   void makeData(unsigned long prn, gnsstk::NavDataPtrList& navOut);
+      /** Compute the pseudorange that PRSolution's model expects
+       * for a satellite, by iterating on the transmit time.
+       * @return false if the satellite is below 5 degrees elevation. */
+   bool makePR(const gnsstk::SatID& sat, const gnsstk::CommonTime& when,
+               double& pr);
+
+      /// Ephemeris epoch.
+   gnsstk::CommonTime start;
+      /// True receiver position (ECEF, m).
+   gnsstk::Position rxPos;
+      /// True receiver clock bias (m).
+   double rxClk;
+      /// Ephemeris source for all tests.
+   gnsstk::NavLibrary navLib;
+};
+
+
+PRSolution_T ::
+PRSolution_T()
+      : start(gnsstk::GPSWeekSecond(2101, 0)),
+        rxClk(-87.654)
+{
+   rxPos.setECEF(-740289.9, -5457071.7, 3207245.6);
+   gnsstk::NavDataFactoryPtr ndfp(std::make_shared<TestFactory>());
+   TestFactory *fact = dynamic_cast<TestFactory*>(ndfp.get());
+      // a dense constellation, so that about 40 satellites are in view
+   for (unsigned long prn = 1; prn <= 120; prn++)
+   {
+      gnsstk::NavDataPtrList navOut;
+      makeData(prn, navOut);
+      for (const auto& ndp : navOut)
+      {
+         fact->addNavData(ndp);
+      }
+   }
+   navLib.addFactory(ndfp);
+}
+
+
+void PRSolution_T ::
+makeData(unsigned long prn, gnsstk::NavDataPtrList& navOut)
+{
+   gnsstk::NavMessageID nmid(
+      gnsstk::NavSatelliteID(prn, prn, gnsstk::SatelliteSystem::GPS,
+                             gnsstk::CarrierBand::L1, gnsstk::TrackingCode::CA,
+                             gnsstk::NavType::GPSLNAV),
+      gnsstk::NavMessageType::Ephemeris);
+   std::shared_ptr<gnsstk::GPSLNavEph> eph =
+      std::make_shared<gnsstk::GPSLNavEph>();
+      // twelve planes of ten satellites
+   unsigned plane = (prn-1) % 12, slot = (prn-1) / 12;
+   eph->signal = nmid;
+   eph->timeStamp = start;
+   eph->xmitTime = start;
+   eph->xmit2 = start + 6;
+   eph->xmit3 = start + 12;
+   eph->Toe = start + 7200;
+   eph->Toc = eph->Toe;
+   eph->health = gnsstk::SVHealth::Healthy;
+   eph->M0 = slot * gnsstk::PI / 5.0 + plane * 0.2;
+   eph->ecc = .422249664553e-02;
+   eph->Ahalf = .515360180473e+04;
+   eph->A = eph->Ahalf * eph->Ahalf;
+   eph->OMEGA0 = plane * gnsstk::PI / 6.0;
+   eph->i0 = .946122987969e+00;
+   eph->w = .374892043461e+00;
+   eph->OMEGAdot = -.823034282681e-08;
+   eph->af0 = 1.e-5 * prn;
+   eph->fixFit();
+   navOut.push_back(eph);
+   std::shared_ptr<gnsstk::GPSLNavHealth> hea =
+      std::make_shared<gnsstk::GPSLNavHealth>();
+   hea->signal = nmid;
+   hea->signal.messageType = gnsstk::NavMessageType::Health;
+   hea->timeStamp = start;
+   hea->svHealth = 0;
+   navOut.push_back(hea);
+}
+
+
+bool PRSolution_T ::
+makePR(const gnsstk::SatID& sat, const gnsstk::CommonTime& when, double& pr)
+{
+   gnsstk::GPSEllipsoid ellip;
+   gnsstk::NavSatelliteID nsid(sat);
+   gnsstk::Xvt xvt;
+   double svxyz[3];
+   pr = 0.070 * ellip.c() + rxClk;
+   for (unsigned iter = 0; iter < 6; iter++)
+   {
+         // same transmit time sequence as PRSolution::PreparePRSolution
+      gnsstk::CommonTime tx = when - pr / ellip.c();
+      if (!navLib.getXvt(nsid, tx, xvt, false, gnsstk::SVHealth::Healthy))
+         return false;
+      tx -= xvt.clkbias + xvt.relcorr;
+      if (!navLib.getXvt(nsid, tx, xvt, false, gnsstk::SVHealth::Healthy))
+         return false;
+      double dt = gnsstk::RSS(xvt.x[0]-rxPos.X(), xvt.x[1]-rxPos.Y(),
+                              xvt.x[2]-rxPos.Z()) / ellip.c();
+      double wt = ellip.angVelocity() * dt;
+      svxyz[0] =  ::cos(wt)*xvt.x[0] + ::sin(wt)*xvt.x[1];
+      svxyz[1] = -::sin(wt)*xvt.x[0] + ::cos(wt)*xvt.x[1];
+      svxyz[2] = xvt.x[2];
+      double rho = gnsstk::RSS(svxyz[0]-rxPos.X(), svxyz[1]-rxPos.Y(),
+                               svxyz[2]-rxPos.Z());
+      pr = rho + rxClk - ellip.c() * (xvt.clkbias + xvt.relcorr);
+   }
+   gnsstk::Position svPos;
+   svPos.setECEF(svxyz[0], svxyz[1], svxyz[2]);
+   return (rxPos.elevation(svPos) > 5.0);
+}
+
+
+unsigned PRSolution_T ::
+incrementalRAIMTest()
+{
+   TUDEF("PRSolution", "RAIMCompute");
+   gnsstk::PRSolution fresh;
+   TUASSERTE(int, 0, fresh.NSubsets);
+   TUASSERTE(int, 0, fresh.NFullSolutions);
+   TUASSERTFE(0.01, fresh.RAIMPruneTolerance);
+   gnsstk::ZeroTropModel ztm;
+   gnsstk::CommonTime when(start + 3600.0);
+   std::vector<gnsstk::SatID> allSats;
+   std::vector<double> truePR;
+   for (unsigned long prn = 1; prn <= 120; prn++)
+   {
+      gnsstk::SatID sat(prn, gnsstk::SatelliteSystem::GPS);
+      double pr;
+      if (makePR(sat, when, pr))
+      {
+         allSats.push_back(sat);
+            // add a little deterministic noise
+         truePR.push_back(pr + 0.5 * std::sin(1.7 * prn));
+      }
+   }
+   TUASSERT(allSats.size() >= 36);
+   size_t n = allSats.size();
+      // blunders: none, one, and two satellites
+   std::vector< std::vector<size_t> > bad(3);
+   bad[1].push_back(n/3);
+   bad[2].push_back(n/5);
+   bad[2].push_back(2*n/3);
+   for (unsigned weighted = 0; weighted < 2; weighted++)
+   {
+      gnsstk::Matrix<double> invMC;
+      if (weighted)
+      {
+         invMC = gnsstk::Matrix<double>(n, n, 0.0);
+         for (size_t i = 0; i < n; i++)
+            invMC(i,i) = 1.0 / (1.0 + 0.1 * (i % 4));
+      }
+      for (unsigned nbad = 0; nbad < bad.size(); nbad++)
+      {
+         std::vector<double> prs(truePR);
+         for (size_t i = 0; i < bad[nbad].size(); i++)
+            prs[bad[nbad][i]] += 250.0 + 100.0 * i;
+         gnsstk::PRSolution full, incr;
+         full.allowedGNSS.push_back(gnsstk::SatelliteSystem::GPS);
+         full.hasMemory = false;
+         full.NSatsReject = 2;
+         incr = full;
+         incr.IncrementalRAIM = true;
+         std::vector<gnsstk::SatID> fullSats(allSats), incrSats(allSats);
+         auto t0 = std::chrono::steady_clock::now();
+         int fullRet = full.RAIMCompute(when, fullSats, prs, invMC, navLib,
+                                        &ztm);
+         auto t1 = std::chrono::steady_clock::now();
+         int incrRet = incr.RAIMCompute(when, incrSats, prs, invMC, navLib,
+                                        &ztm);
+         auto t2 = std::chrono::steady_clock::now();
+         TUASSERTE(int, 0, fullRet);
+         TUASSERTE(int, fullRet, incrRet);
+         TUASSERT(fullSats == incrSats);
+         TUASSERTE(int, int(n - nbad), incr.Nsvs);
+         for (size_t i = 0; i < bad[nbad].size(); i++)
+         {
+            TUASSERT(incrSats[bad[nbad][i]].id < 0);
+         }
+         TUASSERTE(size_t, full.Solution.size(), incr.Solution.size());
+         for (size_t i = 0; i < incr.Solution.size(); i++)
+         {
+            TUASSERTFEPS(full.Solution(i), incr.Solution(i), 1e-9);
+         }
+         TUASSERTFEPS(full.RMSResidual, incr.RMSResidual, 1e-9);
+         TUASSERTFEPS(full.PDOP, incr.PDOP, 1e-9);
+         TUASSERTFEPS(rxPos.X(), incr.Solution(0), 2.);
+         TUASSERTFEPS(rxPos.Y(), incr.Solution(1), 2.);
+         TUASSERTFEPS(rxPos.Z(), incr.Solution(2), 2.);
+            // every subset of each stage is evaluated, either way...
+         int nsub = 1;
+         if (nbad > 0)
+            nsub += n;
+         if (nbad > 1)
+            nsub += n*(n-1)/2;
+         TUASSERTE(int, nsub, full.NSubsets);
+         TUASSERTE(int, nsub, full.NFullSolutions);
+         TUASSERTE(int, nsub, incr.NSubsets);
+            // ...but few need a full solution
+         TUASSERT(incr.NFullSolutions <= 1 + 2 * int(nbad));
+         if (nbad == 1)
+         {
+               // without pruning every subset is solved, with the
+               // same result
+            gnsstk::PRSolution noPrune(incr);
+            noPrune.RAIMPruneTolerance = 1e9;
+            std::vector<gnsstk::SatID> npSats(allSats);
+            TUASSERTE(int, 0, noPrune.RAIMCompute(when, npSats, prs, invMC,
+                                                  navLib, &ztm));
+            TUASSERT(npSats == incrSats);
+            TUASSERTE(int, nsub, noPrune.NFullSolutions);
+            TUASSERTFEPS(incr.RMSResidual, noPrune.RMSResidual, 1e-9);
+         }
+         if (nbad == 2)
+         {
+               // both searches take well under a second, but the
+               // incremental one should be much faster
+            TUASSERT((t2-t1) * 5 < (t1-t0));
+         }
+      }
+   }
+   TURETURN();
+}
+
+
+int main(int argc, char *argv[])
+{
+   PRSolution_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.incrementalRAIMTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,125 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file PackedTime_Bench.cpp Benchmark time-keyed map lookups and
+ * time differencing with CommonTime against PackedTime.  The map
+ * holds one entry per interval, as the stores do, and is searched
+ * with upper_bound() for the entry in effect at each query time.
+ * Usage: PackedTime_Bench [entries [queries]].  Defaults to 10000
+ * entries and 1000000 queries. */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <vector>
+#include "PackedTime.hpp"
+#include "CivilTime.hpp"
+
+/// Time f(), in seconds.
+template <class F>
+static double timeIt(F f)
+{
+   auto t0 = std::chrono::steady_clock::now();
+   f();
+   auto t1 = std::chrono::steady_clock::now();
+   return std::chrono::duration<double>(t1 - t0).count();
+}
+
+int main(int argc, char *argv[])
+{
+   unsigned numEntries = (argc > 1 ? std::atoi(argv[1]) : 10000);
+   unsigned numQueries = (argc > 2 ? std::atoi(argv[2]) : 1000000);
+   gnsstk::CommonTime t0 = gnsstk::CivilTime(2021, 1, 1, 0, 0, 0.0,
+                                             gnsstk::TimeSystem::GPS);
+   std::map<gnsstk::CommonTime, unsigned> ctMap;
+   std::map<gnsstk::PackedTime, unsigned> ptMap;
+   for (unsigned i = 0; i < numEntries; i++)
+   {
+      gnsstk::CommonTime t(t0 + 900.0 * i);
+      ctMap[t] = i;
+      ptMap[t] = i;
+   }
+   std::vector<gnsstk::CommonTime> ctQuery;
+   std::vector<gnsstk::PackedTime> ptQuery;
+   for (unsigned i = 0; i < numQueries; i++)
+   {
+      gnsstk::CommonTime t(t0 + (i * 7919UL % (numEntries * 900UL)) + 0.5);
+      ctQuery.push_back(t);
+      ptQuery.push_back(t);
+   }
+   std::cout << "Map of " << numEntries << " times, " << numQueries
+             << " queries" << std::endl;
+
+   unsigned long sum = 0;
+   double tCT = timeIt([&]() {
+      for (const gnsstk::CommonTime& t : ctQuery)
+         sum += (--ctMap.upper_bound(t))->second; });
+   double tPT = timeIt([&]() {
+      for (const gnsstk::PackedTime& t : ptQuery)
+         sum += (--ptMap.upper_bound(t))->second; });
+   double tConv = timeIt([&]() {
+      for (const gnsstk::CommonTime& t : ctQuery)
+         sum += (--ptMap.upper_bound(t))->second; });
+   std::cout << "  upper_bound: CommonTime " << tCT << " s, PackedTime "
+             << tPT << " s (speedup " << (tCT / tPT)
+             << "x), PackedTime from CommonTime " << tConv << " s (speedup "
+             << (tCT / tConv) << "x)" << std::endl;
+
+   double dsum = 0.0;
+   tCT = timeIt([&]() {
+      for (unsigned i = 1; i < numQueries; i++)
+         dsum += ctQuery[i] - ctQuery[i-1]; });
+   tPT = timeIt([&]() {
+      for (unsigned i = 1; i < numQueries; i++)
+         dsum += ptQuery[i] - ptQuery[i-1]; });
+   std::cout << "  difference:  CommonTime " << tCT << " s, PackedTime "
+             << tPT << " s (speedup " << (tCT / tPT) << "x)" << std::endl;
+
+   tCT = timeIt([&]() {
+      for (unsigned i = 0; i < numQueries; i++)
+         ctQuery[i] += 0.25; });
+   tPT = timeIt([&]() {
+      for (unsigned i = 0; i < numQueries; i++)
+         ptQuery[i] += 0.25; });
+   std::cout << "  += seconds:  CommonTime " << tCT << " s, PackedTime "
+             << tPT << " s (speedup " << (tCT / tPT) << "x)" << std::endl;
+
+   std::cout << "(" << sum << " " << dsum << ")" << std::endl;
+   return 0;
+}
@@ -0,0 +1,210 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <iostream>
+#include <cmath>
+#include "PackedTime.hpp"
+#include "CivilTime.hpp"
+#include "TestUtil.hpp"
+
+using namespace gnsstk;
+using namespace std;
+
+   // comparison and difference are usable in constant expressions
+static_assert(PackedTime(10, 5) < PackedTime(11, 0), "constexpr operator<");
+static_assert(PackedTime(10, 5) - PackedTime(10, 0) == 5e-12,
+              "constexpr operator-");
+
+class PackedTime_T
+{
+public:
+      /// Make a set of times, unsorted, with some ties and near-ties.
+   PackedTime_T();
+
+      /// Round trip conversions to and from CommonTime.
+   unsigned conversionTest();
+      /// Comparisons agree with CommonTime.
+   unsigned compareTest();
+      /// Differences and adding seconds agree with CommonTime.
+   unsigned arithmeticTest();
+      /// compatible() follows CommonTime's time system rules.
+   unsigned timeSystemTest();
+
+   vector<CommonTime> times;
+};
+
+
+PackedTime_T ::
+PackedTime_T()
+{
+   CommonTime t0 = CivilTime(2021, 3, 14, 23, 59, 58.25, TimeSystem::GPS);
+   times.push_back(t0);
+   for (int i = 1; i < 40; i++)
+   {
+      times.push_back(t0 + (i % 7) * 0.37 + (i % 5) * 86400.0 -
+                      (i % 3) * 1.0e-6);
+   }
+   times.push_back(t0);                              // tie
+   times.push_back(t0 + 1.0e-9);                     // nanosecond apart
+   times.push_back(CommonTime::BEGINNING_OF_TIME);
+   times.push_back(CommonTime::END_OF_TIME);
+   for (CommonTime& t : times)
+      t.setTimeSystem(TimeSystem::GPS);
+}
+
+
+unsigned PackedTime_T ::
+conversionTest()
+{
+   TUDEF("PackedTime", "PackedTime(CommonTime)");
+   for (const CommonTime& ct : times)
+   {
+      PackedTime pt(ct);
+      CommonTime back(pt.toCommonTime());
+      TUASSERTE(TimeSystem, ct.getTimeSystem(), pt.getTimeSystem());
+      TUASSERTE(TimeSystem, ct.getTimeSystem(), back.getTimeSystem());
+      TUASSERTE(long, ct.getDays(), back.getDays());
+      TUASSERTFEPS(0.0, back - ct, 1e-12);
+         // and back again is exact
+      TUASSERT(PackedTime(back) == pt);
+      TUASSERT(pt.getPicoseconds() >= 0);
+      TUASSERT(pt.getPicoseconds() < PackedTime::PS_PER_DAY);
+   }
+      // rounding up to the next day
+   CommonTime ct;
+   ct.setInternal(2459000, 86399999, 0.001 - 1e-16, TimeSystem::UTC);
+   PackedTime pt(ct);
+   TUASSERTE(long, 2459001, pt.getDay());
+   TUASSERTE(int64_t, 0, pt.getPicoseconds());
+   TURETURN();
+}
+
+
+unsigned PackedTime_T ::
+compareTest()
+{
+   TUDEF("PackedTime", "operator<");
+   for (const CommonTime& a : times)
+   {
+      for (const CommonTime& b : times)
+      {
+         PackedTime pa(a), pb(b);
+         TUASSERTE(bool, a < b, pa < pb);
+         TUASSERTE(bool, a > b, pa > pb);
+         TUASSERTE(bool, a <= b, pa <= pb);
+         TUASSERTE(bool, a >= b, pa >= pb);
+         TUASSERTE(bool, a == b, pa == pb);
+         TUASSERTE(bool, a != b, pa != pb);
+      }
+   }
+      // a CommonTime can be used directly as a key
+   map<PackedTime, int> store;
+   for (unsigned i = 0; i < times.size(); i++)
+      store[times[i]] = i;
+   TUASSERTE(size_t, times.size()-1, store.size());   // one tie
+   TUASSERTE(int, 40, store.find(times[0])->second);
+   TUASSERTE(int, 41, store.upper_bound(times[0])->second);
+   TUASSERTE(int, times.size()-1, store.rbegin()->second);
+   TURETURN();
+}
+
+
+unsigned PackedTime_T ::
+arithmeticTest()
+{
+   TUDEF("PackedTime", "operator-");
+   for (unsigned i = 0; i + 1 < times.size() - 2; i++)
+   {
+      PackedTime pa(times[i]), pb(times[i+1]);
+      TUASSERTFEPS(times[i] - times[i+1], pa - pb, 1e-9);
+   }
+   TUCSM("operator+=");
+   double secs[] = { 0.0, 1.5e-12, 0.125, 3600.0, 86399.75, 86400.0,
+                     -0.125, -86400.5, 7 * 86400.0 + 12.5, -1.0e-6 };
+   for (const CommonTime& ct : times)
+   {
+      if (ct == CommonTime::BEGINNING_OF_TIME ||
+          ct == CommonTime::END_OF_TIME)
+         continue;
+      for (double s : secs)
+      {
+         PackedTime pt(ct);
+         pt += s;
+         TUASSERTFEPS(s, pt - PackedTime(ct), 1e-9);
+         TUASSERTFEPS(0.0, pt.toCommonTime() - (ct + s), 1e-9);
+         TUASSERT(pt.getPicoseconds() >= 0);
+         TUASSERT(pt.getPicoseconds() < PackedTime::PS_PER_DAY);
+         TUASSERT((PackedTime(ct) + s) == pt);
+         TUASSERT((pt - s) == PackedTime(ct));
+      }
+   }
+   TURETURN();
+}
+
+
+unsigned PackedTime_T ::
+timeSystemTest()
+{
+   TUDEF("PackedTime", "compatible");
+   PackedTime gps(2459000, 0, TimeSystem::GPS),
+      glo(2459000, 0, TimeSystem::GLO),
+      any(2459000, 0, TimeSystem::Any);
+   TUASSERT(gps.compatible(gps));
+   TUASSERT(!gps.compatible(glo));
+   TUASSERT(gps.compatible(any));
+   TUASSERT(any.compatible(glo));
+      // comparisons ignore the time system
+   TUASSERT(gps == glo);
+   TURETURN();
+}
+
+
+int main()
+{
+   PackedTime_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.conversionTest();
+   errorTotal += testClass.compareTest();
+   errorTotal += testClass.arithmeticTest();
+   errorTotal += testClass.timeSystemTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,144 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include "ThreadGroup.hpp"
+#include "TestUtil.hpp"
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+class ThreadGroup_T
+{
+public:
+      /// Check that the threads of a group are joined.
+   unsigned groupTest();
+      /** Check that parallelFor makes every call exactly once and
+       * rethrows the exception of a failed call. */
+   unsigned parallelForTest();
+};
+
+
+unsigned ThreadGroup_T ::
+groupTest()
+{
+   TUDEF("ThreadGroup", "ThreadGroup");
+   std::atomic<unsigned> count(0);
+   {
+      gnsstk::ThreadGroup group;
+      for (unsigned t = 0; t < 4; t++)
+         group.create([&count]() { count++; });
+      TUASSERTE(size_t, 4, group.size());
+   }
+      // the destructor joined all the threads
+   TUASSERTE(unsigned, 4, count);
+   gnsstk::ThreadGroup group;
+   group.create([&count]() { count++; });
+   group.join();
+   TUASSERTE(size_t, 0, group.size());
+   TUASSERTE(unsigned, 5, count);
+   TURETURN();
+}
+
+
+unsigned ThreadGroup_T ::
+parallelForTest()
+{
+   TUDEF("ThreadGroup", "parallelFor");
+   const size_t n = 1000;
+   for (unsigned nThreads = 0; nThreads <= 4; nThreads++)
+   {
+      std::vector<unsigned> calls(n, 0);
+      std::vector<std::atomic<unsigned> > workers(4);
+      for (auto& w : workers)
+         w = 0;
+      gnsstk::parallelFor(n, nThreads,
+                          [&](size_t i, unsigned w)
+                          {
+                             calls[i]++;
+                             workers.at(w)++;
+                          });
+      bool once = true;
+      for (size_t i = 0; i < n; i++)
+         once &= (calls[i] == 1);
+      TUASSERT(once);
+      unsigned total = 0;
+      for (unsigned w = 0; w < 4; w++)
+      {
+            // worker numbers are below the number of threads
+         if (w >= nThreads && w > 0)
+            TUASSERTE(unsigned, 0, workers[w]);
+         total += workers[w];
+      }
+      TUASSERTE(unsigned, n, total);
+   }
+      // nothing to do
+   gnsstk::parallelFor(0, 4, [](size_t, unsigned) { throw 1; });
+   TUPASS("empty range");
+      // the exception of a failed call is rethrown
+   try
+   {
+      gnsstk::parallelFor(n, 4,
+                          [](size_t i, unsigned)
+                          {
+                             if (i == 10)
+                                throw std::runtime_error("call 10");
+                          });
+      TUFAIL("no exception");
+   }
+   catch (std::runtime_error& e)
+   {
+      TUASSERTE(std::string, "call 10", e.what());
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   ThreadGroup_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.groupTest();
+   errorTotal += testClass.parallelForTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}